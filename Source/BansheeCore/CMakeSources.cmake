@@ -1,3 +1,20 @@
+set(BS_BANSHEECORE_SRC_ANIMATION
+	"Source/BsAnimationCurve.cpp"
+	"Source/BsAnimationClip.cpp"
+	"Source/BsSkeleton.cpp"
+	"Source/BsSkinnedMesh.cpp"
+	"Source/BsAnimationUtility.cpp"
+)
+
+set(BS_BANSHEECORE_INC_ANIMATION
+	"Include/BsAnimationCurve.h"
+	"Include/BsAnimationClip.h"
+	"Include/BsAnimationClipRTTI.h"
+	"Include/BsSkeleton.h"
+	"Include/BsSkinnedMesh.h"
+	"Include/BsAnimationUtility.h"
+)
+
 set(BS_BANSHEECORE_INC_COMPONENTS
 	"Include/BsCBoxCollider.h"
 	"Include/BsCCollider.h"
@@ -154,6 +171,7 @@ set(BS_BANSHEECORE_INC_RENDERAPI
 	"Include/BsRenderAPIFactory.h"
 	"Include/BsRenderAPICapabilities.h"
 	"Include/BsViewport.h"
+	"Include/BsPipelineState.h"
 )
 
 set(BS_BANSHEECORE_SRC_CORETHREAD
@@ -425,6 +443,7 @@ set(BS_BANSHEECORE_SRC_RENDERAPI
 	"Source/BsRenderAPIManager.cpp"
 	"Source/BsRenderAPICapabilities.cpp"
 	"Source/BsViewport.cpp"
+	"Source/BsPipelineState.cpp"
 )
 
 set(BS_BANSHEECORE_SRC_NOFILTER
@@ -501,8 +520,12 @@ source_group("Source Files\\RenderAPI" FILES ${BS_BANSHEECORE_SRC_RENDERAPI})
 source_group("Source Files" FILES ${BS_BANSHEECORE_SRC_NOFILTER})
 source_group("Source Files\\Physics" FILES ${BS_BANSHEECORE_SRC_PHYSICS})
 source_group("Source Files\\Scene" FILES ${BS_BANSHEECORE_SRC_SCENE})
+source_group("Header Files\\Animation" FILES ${BS_BANSHEECORE_INC_ANIMATION})
+source_group("Source Files\\Animation" FILES ${BS_BANSHEECORE_SRC_ANIMATION})
 
 set(BS_BANSHEECORE_SRC
+	${BS_BANSHEECORE_SRC_ANIMATION}
+	${BS_BANSHEECORE_INC_ANIMATION}
 	${BS_BANSHEECORE_INC_COMPONENTS}
 	${BS_BANSHEECORE_INC_PHYSICS}
 	${BS_BANSHEECORE_INC_CORETHREAD}
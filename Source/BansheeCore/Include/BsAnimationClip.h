@@ -0,0 +1,160 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "BsResource.h"
+#include "BsAnimationCurve.h"
+#include "BsVector3.h"
+#include "BsQuaternion.h"
+
+namespace BansheeEngine
+{
+	/** @addtogroup Animation
+	 *  @{
+	 */
+
+	/** Animation curves animating the local transform of a single bone. */
+	struct BoneAnimationCurves
+	{
+		String name; /**< Name of the bone animated by the curves. */
+		AnimationCurve position[3]; /**< Curves for the x, y and z components of the bone position. */
+		AnimationCurve rotation[4]; /**< Curves for the x, y, z and w components of the bone rotation quaternion. */
+		AnimationCurve scale[3]; /**< Curves for the x, y and z components of the bone scale. */
+	};
+
+	/** Local transform of a single bone, sampled from an animation clip. */
+	struct BoneTransform
+	{
+		Vector3 position = Vector3::ZERO;
+		Quaternion rotation = Quaternion::IDENTITY;
+		Vector3 scale = Vector3::ONE;
+	};
+
+	/**
+	 * Determines how to sample an animation clip for a single animated object, and receives the sampled bone transforms.
+	 * Keep the same state around for as long as the object is animated, as key lookups from previous evaluations are
+	 * cached in it, making sequential evaluations faster.
+	 *
+	 * @see		AnimationClip::evaluate
+	 */
+	struct AnimationClipState
+	{
+		SPtr<AnimationClip> clip; /**< Clip to sample. */
+		float time = 0.0f; /**< Time to sample the clip at, in seconds. */
+		bool loop = true; /**< Determines should the clip wrap around when time goes past its end. Otherwise it is clamped. */
+
+		/** Sampled transforms, one for each bone in the clip, in the same order as the clip's bones. */
+		Vector<BoneTransform> bones;
+
+		/** Index of the last key used by each of the clip's curves. Managed by the clip. */
+		Vector<UINT32> keyCache;
+	};
+
+	/** Compressed representation of a single animation curve, as stored in an animation clip. */
+	struct CompressedCurve
+	{
+		UINT32 firstKey; /**< Index of the curve's first key in the clip's list of keys. */
+		UINT32 numKeys; /**< Number of keys in the curve. Always at least one. */
+		float valueMin; /**< Value of a key with quantized value of zero. */
+		float valueScale; /**< Difference in value between two neighbouring quantized values. */
+		float tangentScale; /**< Difference in tangent between two neighbouring quantized tangents. */
+	};
+
+	/**
+	 * Keyframe quantized to 16-bit integers, as stored in an animation clip. Time is quantized over the length of the
+	 * clip, and value and tangents over their range in the curve.
+	 */
+	struct CompressedKeyframe
+	{
+		UINT16 time;
+		UINT16 value;
+		INT16 inTangent;
+		INT16 outTangent;
+	};
+
+	/**
+	 * Animation clip containing animation curves for a set of bones. Curves are stored in a compressed format, using
+	 * 16-bit quantized keyframes.
+	 *
+	 * Clips are sampled through evaluate(), which evaluates multiple curves at once using SIMD instructions, and can
+	 * evaluate a large number of animated objects in parallel.
+	 */
+	class BS_CORE_EXPORT AnimationClip : public Resource
+	{
+	public:
+		/** Returns the number of bones animated by the clip. */
+		UINT32 getNumBones() const { return (UINT32)mBoneNames.size(); }
+
+		/** Returns the name of the bone at the specified index. */
+		const String& getBoneName(UINT32 idx) const { return mBoneNames[idx]; }
+
+		/** Returns the time of the first key in the clip, in seconds. */
+		float getStart() const { return mStart; }
+
+		/** Returns the time between the first and the last key in the clip, in seconds. */
+		float getLength() const { return mLength; }
+
+		/**
+		 * Samples the clip referenced by the provided state at the time specified by the state, and outputs the bone
+		 * transforms in the state. Does nothing if the state doesn't reference a clip.
+		 */
+		static void evaluate(AnimationClipState& state);
+
+		/**
+		 * Samples clips for multiple animated objects at once. Objects are evaluated in parallel, if the task scheduler
+		 * is running.
+		 *
+		 * @see		evaluate(AnimationClipState&)
+		 */
+		static void evaluate(AnimationClipState* states, UINT32 count);
+
+		/**
+		 * Creates an animation clip from a set of animation curves. Curves with no keys will output a default value
+		 * (zero position, identity rotation, and unit scale).
+		 *
+		 * @param[in]	bones	Animation curves for each bone animated by the clip.
+		 */
+		static HAnimationClip create(const Vector<BoneAnimationCurves>& bones);
+
+	public: // ***** INTERNAL ******
+		/** @name Internal
+		 *  @{
+		 */
+
+		/** Creates a new AnimationClip without a resource handle. Use create() for normal use. */
+		static SPtr<AnimationClip> _createPtr(const Vector<BoneAnimationCurves>& bones);
+
+		/** @} */
+	private:
+		AnimationClip();
+		AnimationClip(const Vector<BoneAnimationCurves>& bones);
+
+		/** Creates an empty and uninitialized animation clip. Used during deserialization. */
+		static SPtr<AnimationClip> createEmpty();
+
+		/** Evaluates all curves of the clip at the provided time and writes them into @p output, one value per curve. */
+		void evaluateCurves(float time, bool loop, UINT32* keyCache, float* output) const;
+
+		Vector<String> mBoneNames;
+		Vector<CompressedCurve> mCurves;
+		Vector<CompressedKeyframe> mKeys;
+		float mStart;
+		float mLength;
+
+		/************************************************************************/
+		/* 								SERIALIZATION                      		*/
+		/************************************************************************/
+	public:
+		friend class AnimationClipRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+	};
+
+	/** @} */
+
+	/** @cond SPECIALIZATIONS */
+	BS_ALLOW_MEMCPY_SERIALIZATION(CompressedCurve);
+	BS_ALLOW_MEMCPY_SERIALIZATION(CompressedKeyframe);
+	/** @endcond */
+}
@@ -0,0 +1,57 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "BsRTTIType.h"
+#include "BsAnimationClip.h"
+
+namespace BansheeEngine
+{
+	/** @cond RTTI */
+	/** @addtogroup RTTI-Impl-Core
+	 *  @{
+	 */
+
+	class BS_CORE_EXPORT AnimationClipRTTI : public RTTIType <AnimationClip, Resource, AnimationClipRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN(mBoneNames, 0)
+			BS_RTTI_MEMBER_PLAIN(mCurves, 1)
+			BS_RTTI_MEMBER_PLAIN(mKeys, 2)
+			BS_RTTI_MEMBER_PLAIN(mStart, 3)
+			BS_RTTI_MEMBER_PLAIN(mLength, 4)
+		BS_END_RTTI_MEMBERS
+
+	public:
+		AnimationClipRTTI()
+			:mInitMembers(this)
+		{ }
+
+		void onDeserializationEnded(IReflectable* obj) override
+		{
+			AnimationClip* clip = static_cast<AnimationClip*>(obj);
+			clip->initialize();
+		}
+
+		const String& getRTTIName() override
+		{
+			static String name = "AnimationClip";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_AnimationClip;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return AnimationClip::createEmpty();
+		}
+	};
+
+	/** @} */
+	/** @endcond */
+}
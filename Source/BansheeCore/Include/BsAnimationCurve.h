@@ -0,0 +1,82 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+
+namespace BansheeEngine
+{
+	/** @addtogroup Animation
+	 *  @{
+	 */
+
+	/** Animation keyframe, represented as an endpoint of a cubic hermite spline. */
+	struct Keyframe
+	{
+		float value; /**< Value of the key. */
+		float inTangent; /**< Input tangent (going from the previous key to this one) of the key, in units per second. */
+		float outTangent; /**< Output tangent (going from this key to next one) of the key, in units per second. */
+		float time; /**< Position of the key along the animation spline, in seconds. */
+	};
+
+	/**
+	 * Animation spline represented by a set of keyframes, each representing an endpoint of a cubic hermite curve. The
+	 * spline can be evaluated at any time.
+	 *
+	 * This is the uncompressed representation of a curve, used for building and editing animations. Animation clips
+	 * store their curves in a compressed format.
+	 *
+	 * @see		AnimationClip
+	 */
+	class BS_CORE_EXPORT AnimationCurve
+	{
+	public:
+		AnimationCurve() { }
+
+		/**
+		 * Creates a new animation curve.
+		 *
+		 * @param[in]	keyframes	Keyframes to initialize the curve with. Must be sorted by time.
+		 */
+		AnimationCurve(const Vector<Keyframe>& keyframes);
+
+		/**
+		 * Evaluates the animation curve at the specified time.
+		 *
+		 * @param[in]	time	Time to evaluate the curve at, in seconds.
+		 * @param[in]	loop	If true the curve will loop when it goes past the end or beginning. Otherwise the curve
+		 *						value will be clamped.
+		 * @return				Interpolated value from the curve at provided time. Zero if the curve has no keyframes.
+		 */
+		float evaluate(float time, bool loop = true) const;
+
+		/** Returns a list of all keyframes in the curve. */
+		const Vector<Keyframe>& getKeyFrames() const { return mKeyframes; }
+
+		/** Returns the time of the first keyframe in the curve, in seconds. */
+		float getStart() const { return mStart; }
+
+		/** Returns the time of the last keyframe in the curve, in seconds. */
+		float getEnd() const { return mEnd; }
+
+		/** Returns the time between the first and last keyframe in the curve, in seconds. */
+		float getLength() const { return mEnd - mStart; }
+
+		/**
+		 * Evaluates a cubic hermite curve segment between two keyframes.
+		 *
+		 * @param[in]	lhs		Keyframe at the start of the segment.
+		 * @param[in]	rhs		Keyframe at the end of the segment.
+		 * @param[in]	time	Time to evaluate the segment at, in seconds. Must be in range [lhs.time, rhs.time].
+		 * @return				Interpolated value.
+		 */
+		static float evaluate(const Keyframe& lhs, const Keyframe& rhs, float time);
+
+	private:
+		Vector<Keyframe> mKeyframes;
+		float mStart = 0.0f;
+		float mEnd = 0.0f;
+	};
+
+	/** @} */
+}
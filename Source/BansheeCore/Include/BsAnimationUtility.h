@@ -0,0 +1,32 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "BsAnimationCurve.h"
+
+namespace BansheeEngine
+{
+	/** @addtogroup Animation
+	 *  @{
+	 */
+
+	/** Helper class for dealing with animations, animation clips and curves. */
+	class BS_CORE_EXPORT AnimationUtility
+	{
+	public:
+		/**
+		 * Converts a set of curves containing rotation in euler angles (in degrees) into a set of curves containing the
+		 * x, y, z and w components of a rotation quaternion. Output keys are placed at the same times as the input keys.
+		 * Sign of each output quaternion is chosen so it is closest to the previous one, ensuring the curves interpolate
+		 * along the shortest path.
+		 *
+		 * @param[in]	eulerCurves		Curves for the x, y and z euler angles. All curves must have keys at the same
+		 *								times, otherwise no output is generated.
+		 * @param[out]	quatCurves		Curves for the x, y, z and w quaternion components.
+		 */
+		static void eulerToQuaternionCurves(const AnimationCurve(&eulerCurves)[3], AnimationCurve(&quatCurves)[4]);
+	};
+
+	/** @} */
+}
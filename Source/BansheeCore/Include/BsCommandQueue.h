@@ -63,6 +63,94 @@ namespace BansheeEngine
 		Lock mLock;
 	};
 
+	template<class Signature>
+	class CommandCallback;
+
+	/**
+	 * Callable executed by a queued command. Works like std::function, except the callable and any data it captures are
+	 * allocated in the core thread queue memory category (see CoreThreadAlloc), and it can only be moved.
+	 */
+	template<class Ret, class... Args>
+	class CommandCallback<Ret(Args...)>
+	{
+	public:
+		CommandCallback()
+			:mCallable(nullptr)
+		{ }
+
+		/** Stores a copy of @p func, which can be any callable object accepting @p Args. */
+		template<class F, class = typename std::enable_if<
+			!std::is_same<typename std::decay<F>::type, CommandCallback>::value>::type>
+		CommandCallback(F&& func)
+			:mCallable(bs_new<Callable<typename std::decay<F>::type>, CoreThreadAlloc>(std::forward<F>(func)))
+		{ }
+
+		CommandCallback(CommandCallback&& other)
+			:mCallable(other.mCallable)
+		{
+			other.mCallable = nullptr;
+		}
+
+		~CommandCallback()
+		{
+			if (mCallable != nullptr)
+				bs_delete<CallableBase, CoreThreadAlloc>(mCallable);
+		}
+
+		CommandCallback& operator=(CommandCallback&& rhs)
+		{
+			if (this != &rhs)
+			{
+				if (mCallable != nullptr)
+					bs_delete<CallableBase, CoreThreadAlloc>(mCallable);
+
+				mCallable = rhs.mCallable;
+				rhs.mCallable = nullptr;
+			}
+
+			return *this;
+		}
+
+		/** Executes the stored callable. */
+		Ret operator()(Args... args) const
+		{
+			return mCallable->invoke(std::forward<Args>(args)...);
+		}
+
+		/** Checks if a callable is stored. */
+		explicit operator bool() const { return mCallable != nullptr; }
+
+	private:
+		CommandCallback(const CommandCallback&) = delete;
+		CommandCallback& operator=(const CommandCallback&) = delete;
+
+		/** Interface used for executing and destroying the stored callable, regardless of its type. */
+		struct CallableBase
+		{
+			virtual ~CallableBase() { }
+			virtual Ret invoke(Args... args) = 0;
+		};
+
+		/** Stores a callable of a specific type. */
+		template<class F>
+		struct Callable : CallableBase
+		{
+			template<class T>
+			Callable(T&& func)
+				:func(std::forward<T>(func))
+			{ }
+
+			Ret invoke(Args... args) override
+			{
+				return func(std::forward<Args>(args)...);
+			}
+
+			F func;
+		};
+
+		CallableBase* mCallable;
+	};
+
 	/**
 	 * Represents a single queued command in the command list. Contains all the data for executing the command and checking 
 	 * up on the command status.
@@ -70,37 +158,37 @@ namespace BansheeEngine
 	struct QueuedCommand
 	{
 #if BS_DEBUG_MODE
-		QueuedCommand(std::function<void(AsyncOp&)> _callback, UINT32 _debugId, const SPtr<AsyncOpSyncData>& asyncOpSyncData,
+		QueuedCommand(CommandCallback<void(AsyncOp&)> _callback, UINT32 _debugId, const SPtr<AsyncOpSyncData>& asyncOpSyncData,
 			bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
-			: debugId(_debugId), callbackWithReturnValue(_callback), asyncOp(asyncOpSyncData), returnsValue(true)
+			: debugId(_debugId), callbackWithReturnValue(std::move(_callback)), asyncOp(asyncOpSyncData), returnsValue(true)
 			, callbackId(_callbackId), notifyWhenComplete(_notifyWhenComplete)
 		{ }
 
-		QueuedCommand(std::function<void()> _callback, UINT32 _debugId, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
-			:debugId(_debugId), callback(_callback), asyncOp(AsyncOpEmpty()), returnsValue(false), callbackId(_callbackId)
+		QueuedCommand(CommandCallback<void()> _callback, UINT32 _debugId, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
+			:debugId(_debugId), callback(std::move(_callback)), asyncOp(AsyncOpEmpty()), returnsValue(false), callbackId(_callbackId)
 			, notifyWhenComplete(_notifyWhenComplete)
 		{ }
 
 		UINT32 debugId;
 #else
-		QueuedCommand(std::function<void(AsyncOp&)> _callback, const SPtr<AsyncOpSyncData>& asyncOpSyncData, 
+		QueuedCommand(CommandCallback<void(AsyncOp&)> _callback, const SPtr<AsyncOpSyncData>& asyncOpSyncData, 
 			bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
-			:callbackWithReturnValue(_callback), returnsValue(true), notifyWhenComplete(_notifyWhenComplete), 
+			:callbackWithReturnValue(std::move(_callback)), returnsValue(true), notifyWhenComplete(_notifyWhenComplete), 
 			callbackId(_callbackId), asyncOp(asyncOpSyncData)
 		{ }
 
-		QueuedCommand(std::function<void()> _callback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
-			:callback(_callback), returnsValue(false), notifyWhenComplete(_notifyWhenComplete), callbackId(_callbackId), asyncOp(AsyncOpEmpty())
+		QueuedCommand(CommandCallback<void()> _callback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
+			:callback(std::move(_callback)), returnsValue(false), notifyWhenComplete(_notifyWhenComplete), callbackId(_callbackId), asyncOp(AsyncOpEmpty())
 		{ }
 #endif
 
 		~QueuedCommand()
 		{ }
 
-		QueuedCommand(const QueuedCommand& source)
+		QueuedCommand(QueuedCommand&& source)
 		{
-			callback = source.callback;
-			callbackWithReturnValue = source.callbackWithReturnValue;
+			callback = std::move(source.callback);
+			callbackWithReturnValue = std::move(source.callbackWithReturnValue);
 			asyncOp = source.asyncOp;
 			returnsValue = source.returnsValue;
 			callbackId = source.callbackId;
@@ -111,10 +199,10 @@ namespace BansheeEngine
 #endif
 		}
 
-		QueuedCommand& operator=(const QueuedCommand& rhs)
+		QueuedCommand& operator=(QueuedCommand&& rhs)
 		{
-			callback = rhs.callback;
-			callbackWithReturnValue = rhs.callbackWithReturnValue;
+			callback = std::move(rhs.callback);
+			callbackWithReturnValue = std::move(rhs.callbackWithReturnValue);
 			asyncOp = rhs.asyncOp;
 			returnsValue = rhs.returnsValue;
 			callbackId = rhs.callbackId;
@@ -127,14 +215,20 @@ namespace BansheeEngine
 			return *this;
 		}
 
-		std::function<void()> callback;
-		std::function<void(AsyncOp&)> callbackWithReturnValue;
+		CommandCallback<void()> callback;
+		CommandCallback<void(AsyncOp&)> callbackWithReturnValue;
 		AsyncOp asyncOp;
 		bool returnsValue;
 		UINT32 callbackId;
 		bool notifyWhenComplete;
 	};
 
+	/** 
+	 * Queue of commands waiting for execution. Its memory, along with the command callbacks, is counted in the core 
+	 * thread queue memory category.
+	 */
+	typedef Queue<QueuedCommand, StdAlloc<QueuedCommand, CoreThreadAlloc>> QueuedCommandList;
+
 	/** Manages a list of commands that can be queued for later execution on the core thread. */
 	class BS_CORE_EXPORT CommandQueueBase
 	{
@@ -162,10 +256,10 @@ namespace BansheeEngine
 		 * @param[in]	notifyCallback  	Callback that will be called if a command that has @p notifyOnComplete flag set.
 		 * 									The callback will receive @p callbackId of the command.
 		 */
-		void playbackWithNotify(Queue<QueuedCommand>* commands, std::function<void(UINT32)> notifyCallback);
+		void playbackWithNotify(QueuedCommandList* commands, std::function<void(UINT32)> notifyCallback);
 
 		/** Executes all provided commands one by one in order. To get the commands you should call flush(). */
-		void playback(Queue<QueuedCommand>* commands);
+		void playback(QueuedCommandList* commands);
 
 		/**
 		 * Allows you to set a breakpoint that will trigger when the specified command is executed.		
@@ -200,7 +294,8 @@ namespace BansheeEngine
 		 * Callback method also needs to call AsyncOp::markAsResolved once it is done processing. (If it doesn't it will 
 		 * still be called automatically, but the return value will default to nullptr)
 		 */
-		AsyncOp queueReturn(std::function<void(AsyncOp&)> commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0);
+		AsyncOp queueReturn(CommandCallback<void(AsyncOp&)> commandCallback, bool _notifyWhenComplete = false, 
+			UINT32 _callbackId = 0);
 
 		/**
 		 * Queue up a new command to execute. Make sure the provided function has all of its parameters properly bound. 
@@ -213,13 +308,13 @@ namespace BansheeEngine
 		 * @param[in]	_callbackId		   	(optional) Identifier for the callback so you can then later find
 		 * 									it if needed.
 		 */
-		void queue(std::function<void()> commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0);
+		void queue(CommandCallback<void()> commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0);
 
 		/**
 		 * Returns a copy of all queued commands and makes room for new ones. Must be called from the thread that created 
 		 * the command queue. Returned commands must be passed to playback() method.
 		 */
-		Queue<QueuedCommand>* flush();
+		QueuedCommandList* flush();
 
 		/** Cancels all currently queued commands. */
 		void cancelAll();
@@ -235,8 +330,8 @@ namespace BansheeEngine
 		void throwInvalidThreadException(const String& message) const;
 
 	private:
-		Queue<QueuedCommand>* mCommands;
-		Stack<Queue<QueuedCommand>*> mEmptyCommandQueues; /**< List of empty queues for reuse. */
+		QueuedCommandList* mCommands;
+		Stack<QueuedCommandList*> mEmptyCommandQueues; /**< List of empty queues for reuse. */
 
 		SPtr<AsyncOpSyncData> mAsyncOpSyncData;
 		ThreadId mMyThreadId;
@@ -299,7 +394,8 @@ namespace BansheeEngine
 		{ }
 
 		/** @copydoc CommandQueueBase::queueReturn */
-		AsyncOp queueReturn(std::function<void(AsyncOp&)> commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
+		AsyncOp queueReturn(CommandCallback<void(AsyncOp&)> commandCallback, bool _notifyWhenComplete = false, 
+			UINT32 _callbackId = 0)
 		{
 #if BS_DEBUG_MODE
 #if BS_THREAD_SUPPORT != 0
@@ -309,14 +405,15 @@ namespace BansheeEngine
 #endif
 
 			this->lock();
-			AsyncOp asyncOp = CommandQueueBase::queueReturn(commandCallback, _notifyWhenComplete, _callbackId);
+			AsyncOp asyncOp = CommandQueueBase::queueReturn(std::move(commandCallback), _notifyWhenComplete, 
+				_callbackId);
 			this->unlock();
 
 			return asyncOp;
 		}
 
 		/** @copydoc CommandQueueBase::queue */
-		void queue(std::function<void()> commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
+		void queue(CommandCallback<void()> commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
 		{
 #if BS_DEBUG_MODE
 #if BS_THREAD_SUPPORT != 0
@@ -326,12 +423,12 @@ namespace BansheeEngine
 #endif
 
 			this->lock();
-			CommandQueueBase::queue(commandCallback, _notifyWhenComplete, _callbackId);
+			CommandQueueBase::queue(std::move(commandCallback), _notifyWhenComplete, _callbackId);
 			this->unlock();
 		}
 
 		/** @copydoc CommandQueueBase::flush */
-		BansheeEngine::Queue<QueuedCommand>* flush()
+		QueuedCommandList* flush()
 		{
 #if BS_DEBUG_MODE
 #if BS_THREAD_SUPPORT != 0
@@ -341,7 +438,7 @@ namespace BansheeEngine
 #endif
 
 			this->lock();
-			BansheeEngine::Queue<QueuedCommand>* commands = CommandQueueBase::flush();
+			QueuedCommandList* commands = CommandQueueBase::flush();
 			this->unlock();
 
 			return commands;
@@ -32,6 +32,14 @@ namespace BansheeEngine
 		 */
 		virtual void update() { }
 
+		/**
+		 * Called at a fixed rate on all components, zero or multiple times per frame depending on the frame rate. Called
+		 * before update(). Use Time::getFixedFrameDelta() as the time step.
+		 * 			
+		 * @note	Internal method.
+		 */
+		virtual void fixedUpdate() { }
+
 		/**
 		 * Calculates bounds of the visible contents represented by this component (for example a mesh for Renderable).
 		 * 
@@ -27,6 +27,31 @@ namespace BansheeEngine
 		Vector<String> importers; /**< A list of importer plugins to load. */
 	};
 
+	/** 
+	 * Contains timing information about recently executed frames, as measured by the main loop. All values are smoothed
+	 * over multiple frames and are in milliseconds.
+	 */
+	struct FrameTimingStats
+	{
+		FrameTimingStats()
+			: simFrameTime(0.0f), coreFrameTime(0.0f), simWaitTime(0.0f), frameStartDelay(0.0f), frameInterval(0.0f)
+			, frameIntervalDeviation(0.0f), inputLatency(0.0f)
+		{ }
+
+		float simFrameTime; /**< Time the simulation thread spent executing a frame, excluding any waits. */
+		float coreFrameTime; /**< Time the core thread spent executing a frame. */
+		float simWaitTime; /**< Time the simulation thread spent waiting on the core thread to finish a frame. */
+		float frameStartDelay; /**< Delay applied to the start of a frame, if adaptive frame start is enabled. */
+		float frameInterval; /**< Time between the starts of two consecutive frames. */
+		float frameIntervalDeviation; /**< Average deviation of the frame interval, lower values mean smoother pacing. */
+
+		/** 
+		 * Time between the start of a frame (when input is sampled) and the moment the core thread finishes rendering
+		 * and presenting it. 
+		 */
+		float inputLatency;
+	};
+
 	/**
 	 * Represents the primary entry point for the core systems. Handles start-up, shutdown, primary loop and allows you to
 	 * load and unload plugins.
@@ -53,6 +78,45 @@ namespace BansheeEngine
 			/** Changes the maximum FPS the application is allowed to run in. Zero means unlimited. */
 			void setFPSLimit(UINT32 limit);
 
+			/**
+			 * Sets the maximum number of frames the simulation thread is allowed to queue for rendering, before it has to 
+			 * wait for the core thread to finish one. Higher values improve throughput when the simulation and core 
+			 * thread workloads vary between frames, at the cost of higher input latency. Must be in range
+			 * [1, MAX_FRAMES_IN_FLIGHT]. Default is 1.
+			 */
+			void setMaxFramesInFlight(UINT32 count);
+
+			/**
+			 * Enables or disables adaptive frame start. When enabled the start of each simulation frame is delayed by the
+			 * amount of time the simulation thread is expected to wait for the core thread, as measured in previous 
+			 * frames. This way input is sampled as late as possible, lowering input latency without affecting throughput.
+			 * Only has an effect when the maximum number of frames in flight is 1.
+			 */
+			void setAdaptiveFrameStart(bool enabled) { mAdaptiveFrameStart = enabled; }
+
+			/**
+			 * Determines how long (in microseconds) the frame limiter is allowed to busy-wait at the end of a wait, in 
+			 * order to compensate for the imprecision of the OS timer. By default this is zero and the limiter relies 
+			 * purely on Platform::sleepPrecise(), which uses high resolution waits where available, and only spins for
+			 * the last couple of milliseconds where not. Increase it if precise frame pacing is more important than power
+			 * usage.
+			 */
+			void setFrameLimiterSpinTime(UINT32 time) { mFrameLimiterSpinTime = time; }
+
+			/**
+			 * Enables or disables rendering. When disabled the main loop still runs the simulation (including fixed 
+			 * updates and physics) but no objects are rendered. Useful for servers and headless tools, normally combined
+			 * with a low FPS limit.
+			 */
+			void setRenderingEnabled(bool enabled) { mRenderingEnabled = enabled; }
+
+			/**
+			 * Returns frame pacing and latency information about recently executed frames.
+			 *
+			 * @note	Thread safe.
+			 */
+			FrameTimingStats getFrameTimingStats() const;
+
 			/**
 			 * Issues a request for the application to close. Application may choose to ignore the request depending on the
 			 * circumstances and the implementation.
@@ -101,9 +165,29 @@ namespace BansheeEngine
 		/**	Returns a handler that is used for resolving shader include file paths. */
 		virtual SPtr<IShaderIncludeHandler> getShaderIncludeHandler() const;
 
+	public:
+		/** Maximum number of frames the simulation thread can queue ahead of the core thread. */
+		static const UINT32 MAX_FRAMES_IN_FLIGHT = 2;
+
 	private:
-		/**	Called when the frame finishes rendering. */
-		void frameRenderingFinishedCallback();
+		/** 
+		 * Called when the frame finishes rendering. 
+		 *
+		 * @param[in]	frameStartTime	Time at which the simulation thread started the frame, in microseconds.
+		 */
+		void frameRenderingFinishedCallback(UINT64 frameStartTime);
+
+		/** 
+		 * Blocks the calling thread until the specified time (in microseconds) is reached. Returns the current time. The
+		 * thread sleeps for the majority of the wait and only busy-waits for the last mFrameLimiterSpinTime microseconds.
+		 */
+		UINT64 waitUntil(UINT64 time);
+
+		/** 
+		 * Updates frame timing statistics and the adaptive frame start delay, using timings measured on the simulation 
+		 * thread. All times are in microseconds.
+		 */
+		void updateFrameTiming(UINT64 frameStartTime, UINT64 simEndTime, UINT64 waitEndTime);
 
 		/**	Called by the core thread to begin profiling. */
 		void beginCoreProfiling();
@@ -119,16 +203,27 @@ namespace BansheeEngine
 
 		UINT64 mFrameStep; // Microseconds
 		UINT64 mLastFrameTime; // Microseconds
+		UINT32 mFrameLimiterSpinTime; // Microseconds
+		bool mRenderingEnabled;
 
 		DynLib* mRendererPlugin;
 
 		Map<DynLib*, UpdatePluginFunc> mPluginUpdateFunctions;
 
-		bool mIsFrameRenderingFinished;
+		UINT32 mNumFramesInFlight;
+		UINT32 mMaxFramesInFlight;
 		Mutex mFrameRenderingFinishedMutex;
 		Signal mFrameRenderingFinishedCondition;
 		ThreadId mSimThreadId;
 
+		bool mAdaptiveFrameStart;
+		UINT64 mFrameStartDelay; // Microseconds
+		UINT64 mLastFrameStartTime; // Microseconds
+		UINT64 mCoreFrameStartTime; // Microseconds, core thread only
+
+		FrameTimingStats mFrameTimingStats;
+		mutable Mutex mFrameTimingMutex;
+
 		volatile bool mRunMainLoop;
 	};
 
@@ -13,6 +13,10 @@
  *  @{
  */
 
+/** @defgroup Animation Animation
+ *	Animation clips, skeletal and blend shape animation.
+ */
+
 /** @defgroup Audio Audio
  *	Audio clips, 3D sound and music reproduction.
  */
@@ -294,6 +298,7 @@ namespace BansheeEngine
 	class ShaderCore;
 	class ViewportCore;
 	class PassCore;
+	class PipelineStateCore;
 	class PassParametersCore;
 	class TechniqueCore;
 	class MaterialCore;
@@ -363,6 +368,10 @@ namespace BansheeEngine
 	class PhysicsMaterial;
 	class PhysicsMesh;
 	class AudioClip;
+	class AnimationClip;
+	struct AnimationClipState;
+	class Skeleton;
+	class SkinnedMesh;
 	struct CollisionData;
 	// Scene
 	class SceneObject;
@@ -492,7 +501,8 @@ namespace BansheeEngine
 		TID_FPhysicsMesh = 1109,
 		TID_ShaderImportOptions = 1110,
 		TID_AudioClip = 1111,
-		TID_AudioClipImportOptions = 1112
+		TID_AudioClipImportOptions = 1112,
+		TID_AnimationClip = 1113
 	};
 }
 
@@ -520,6 +530,7 @@ namespace BansheeEngine
 	typedef ResourceHandle<PhysicsMaterial> HPhysicsMaterial;
 	typedef ResourceHandle<PhysicsMesh> HPhysicsMesh;
 	typedef ResourceHandle<AudioClip> HAudioClip;
+	typedef ResourceHandle<AnimationClip> HAnimationClip;
 
 	/** @} */
 }
@@ -594,6 +605,8 @@ namespace BansheeEngine
 		static void onThreadEnded(const String& name)
 		{
 			MemStack::endThread();
+			SmallObjectAlloc::endThread();
+			MemoryCounter::endThread();
 		}
 	};
 
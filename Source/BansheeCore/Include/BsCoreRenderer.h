@@ -35,6 +35,7 @@ namespace BansheeEngine
 	static StringID RPS_WorldDeterminantSign = "WorldDeterminantSign";
 	static StringID RPS_Diffuse = "Diffuse";
 	static StringID RPS_ViewDir = "ViewDir";
+	static StringID RPS_InstanceData = "InstanceData";
 
 	/**	Set of options that can be used for controlling the renderer. */	
 	struct BS_CORE_EXPORT CoreRendererOptions
@@ -38,9 +38,21 @@ namespace BansheeEngine
 		/** Called every frame. Calls update methods on all scene objects and their components. */
 		virtual void _update();
 
+		/** 
+		 * Called zero or multiple times per frame, before _update(), at a fixed time step. Calls fixed update methods on 
+		 * all scene objects and their components. 
+		 */
+		virtual void _fixedUpdate();
+
 		/** Updates dirty transforms on any core objects that may be tied with scene objects. */
 		virtual void _updateCoreObjectTransforms() { }
 
+		/**
+		 * Notifies the manager that the transform or active state of a scene object with registered core objects has
+		 * changed. The object will be processed on the next call to _updateCoreObjectTransforms().
+		 */
+		void _notifyCoreObjectsDirty(const HSceneObject& so) { mDirtySceneObjects.push_back(so); }
+
 	protected:
 		friend class SceneObject;
 
@@ -59,6 +71,7 @@ namespace BansheeEngine
 
 	protected:
 		HSceneObject mRootNode;
+		Vector<HSceneObject> mDirtySceneObjects;
 	};
 
 	/**
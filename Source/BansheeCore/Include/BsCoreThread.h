@@ -93,7 +93,7 @@ public:
 	 * 	
 	 * @see		CommandQueue::queueReturn()
 	 */
-	AsyncOp queueReturnCommand(std::function<void(AsyncOp&)> commandCallback, bool blockUntilComplete = false);
+	AsyncOp queueReturnCommand(CommandCallback<void(AsyncOp&)> commandCallback, bool blockUntilComplete = false);
 
 	/**
 	 * Queues a new command that will be added to the global command queue.You are allowed to call this from any thread,
@@ -106,7 +106,7 @@ public:
 	 *
 	 * @see		CommandQueue::queue()
 	 */
-	void queueCommand(std::function<void()> commandCallback, bool blockUntilComplete = false);
+	void queueCommand(CommandCallback<void()> commandCallback, bool blockUntilComplete = false);
 
 	/**
 	 * Called once every frame.
@@ -123,11 +123,11 @@ public:
 	 */
 	FrameAlloc* getFrameAlloc() const;
 private:
-	static const int NUM_FRAME_ALLOCS = 2;
+	static const int NUM_FRAME_ALLOCS = 3;
 
 	/**
-	 * Double buffered frame allocators. Means sim thread cannot be more than 1 frame ahead of core thread (If that changes
-	 * you should be able to easily add more).
+	 * Frame allocators that are cycled every frame. There must be one more allocator than the maximum number of frames 
+	 * the sim thread is allowed to queue ahead of the core thread (see CoreApplication::MAX_FRAMES_IN_FLIGHT).
 	 */
 	FrameAlloc* mFrameAllocs[NUM_FRAME_ALLOCS];
 	UINT32 mActiveFrameAlloc;
@@ -25,6 +25,16 @@ namespace BansheeEngine
 		/** Writes all of the specified data to the buffer. Data size must be the same size as the buffer. */
 		virtual void writeToGPU(const UINT8* data) = 0;
 
+		/**
+		 * Writes a range of the specified data to the buffer. By default the entire buffer is uploaded, but implementations
+		 * that support partial updates will only upload the requested range.
+		 *
+		 * @param[in]	data	Data for the entire buffer. Must be the same size as the buffer.
+		 * @param[in]	offset	Offset in bytes to the first byte to upload.
+		 * @param[in]	size	Number of bytes to upload.
+		 */
+		virtual void writeRangeToGPU(const UINT8* data, UINT32 offset, UINT32 size) { writeToGPU(data); }
+
 		/**
 		 * Copies data from the internal buffer to a pre-allocated array. Be aware this generally isn't a very fast 
 		 * operation as reading from the GPU will most definitely involve a CPU-GPU sync point.
@@ -33,11 +43,12 @@ namespace BansheeEngine
 		 */
 		virtual void readFromGPU(UINT8* data) const = 0;
 
-		/** Flushes any cached data into the actual GPU buffer. */
+		/** Flushes any cached data into the actual GPU buffer. Only the range modified since the last flush is uploaded. */
 		void flushToGPU();
 
 		/**
-		 * Write some data to the specified offset in the buffer. 
+		 * Write some data to the specified offset in the buffer. Writes that don't change the buffer contents don't mark
+		 * the buffer as dirty.
 		 *
 		 * @note	All values are in bytes. Actual hardware buffer update is delayed until rendering.
 		 */
@@ -70,8 +81,12 @@ namespace BansheeEngine
 		GpuParamBlockUsage mUsage;
 		UINT32 mSize;
 
+		/** Extends the range of data that needs to be uploaded on next flush with the provided range. */
+		void markDirty(UINT32 offset, UINT32 size);
+
 		UINT8* mCachedData;
-		bool mGPUBufferDirty;
+		UINT32 mDirtyStart;
+		UINT32 mDirtyEnd;
 	};
 
 	/**
@@ -87,6 +102,9 @@ namespace BansheeEngine
 		/** @copydoc GpuParamBlockBufferCore::writeToGPU */
 		void writeToGPU(const UINT8* data) override;
 
+		/** @copydoc GpuParamBlockBufferCore::writeRangeToGPU */
+		void writeRangeToGPU(const UINT8* data, UINT32 offset, UINT32 size) override;
+
 		/** @copydoc GpuParamBlockBufferCore::readFromGPU */
 		void readFromGPU(UINT8* data) const override;
 
@@ -40,6 +40,45 @@ namespace BansheeEngine
 
 		/** @copydoc GpuProgramManager::createEmpty */
 		virtual SPtr<GpuProgramCore> create(GpuProgramType type) = 0;
+
+		/**
+		 * Returns a string identifying the compiler (and its options) used for compiling programs created by this
+		 * factory. Compiled program binaries stored in the program cache are only reused as long as this string remains
+		 * the same. Factories whose programs cannot be loaded from binaries return an empty string, in which case the
+		 * programs are always compiled from source.
+		 */
+		virtual String getBinaryVersion() const { return ""; }
+
+		/**
+		 * Compiles the provided source into a program binary, without creating the program. Only called if 
+		 * getBinaryVersion() returns a non-empty string.
+		 *
+		 * @param[in]	source				Source code to compile the shader from.
+		 * @param[in]	entryPoint			Name of the entry point function, for example "main".
+		 * @param[in]	gptype				Type of the program, for example vertex or fragment.
+		 * @param[in]	profile				Program profile specifying supported feature-set. Must match the type.
+		 * @param[in]	requiresAdjacency	If true then adjacency information will be provided when rendering using this 
+		 *									program.
+		 * @param[out]	output				Compiled program binary.
+		 * @return							True if the program was successfully compiled.
+		 *
+		 * @note	Must be thread safe, as it may be called from worker threads.
+		 */
+		virtual bool compileBinary(const String& source, const String& entryPoint, GpuProgramType gptype,
+			GpuProgramProfile profile, bool requiresAdjacency, Vector<UINT8>& output) { return false; }
+	};
+
+	/** Contains statistics about GPU programs compiled by GpuProgramCoreManager. */
+	struct GpuProgramCacheStats
+	{
+		GpuProgramCacheStats()
+			:numHits(0), numMisses(0), compileTimeUs(0), loadTimeUs(0)
+		{ }
+
+		UINT32 numHits; /**< Number of programs created from a cached or precompiled binary. */
+		UINT32 numMisses; /**< Number of programs that had to be compiled from source, including precompiled ones. */
+		UINT64 compileTimeUs; /**< Total time spent compiling programs from source, in microseconds. */
+		UINT64 loadTimeUs; /**< Total time spent creating programs loaded from the cache, in microseconds. */
 	};
 
 	/**
@@ -117,6 +156,101 @@ namespace BansheeEngine
 		SPtr<GpuProgramCore> create(const String& source, const String& entryPoint, const String& language, 
 			GpuProgramType gptype, GpuProgramProfile profile, bool requiresAdjacency = false);
 
+		/**
+		 * Sets a folder in which compiled program binaries will be stored. Programs whose binaries are found in the 
+		 * folder will be loaded directly instead of being compiled from source. Set to an empty path to disable the 
+		 * program cache (default).
+		 *
+		 * @note	Thread safe.
+		 */
+		void setCacheFolder(const Path& folder);
+
+		/** 
+		 * Returns the folder in which compiled program binaries are stored. Empty if the program cache is disabled. 
+		 *
+		 * @note	Thread safe.
+		 */
+		Path getCacheFolder() const;
+
+		/**
+		 * Compiles a GPU program into a binary, without creating the program. Once the program is created with the same
+		 * parameters it will use the compiled binary instead of compiling the source again. This allows many programs to
+		 * be compiled in parallel, while their creation still happens on the core thread. The binary is kept in memory 
+		 * until the program is created, and is also stored in the cache folder if one is set.
+		 *
+		 * Calling this is only useful if the program will actually be created afterwards. Each call that returns true 
+		 * must be paired with a call to releasePrecompiled() once the program has been created (or once it is known it
+		 * won't be), otherwise the binary will remain in memory.
+		 *
+		 * @return	True if a binary is available for the program. False if the program failed to compile, or if 
+		 *			programs in the provided language cannot be created from binaries.
+		 *
+		 * @note	Thread safe.
+		 * @see		create
+		 */
+		bool precompile(const String& source, const String& entryPoint, const String& language, GpuProgramType gptype,
+			GpuProgramProfile profile, bool requiresAdjacency = false);
+
+		/** 
+		 * Releases a binary kept in memory by a previous call to precompile() with the same parameters. Programs created
+		 * afterwards will load the binary from the cache folder, or compile it from source if the cache is disabled.
+		 *
+		 * @note	Thread safe.
+		 */
+		void releasePrecompiled(const String& source, const String& entryPoint, const String& language, 
+			GpuProgramType gptype, GpuProgramProfile profile, bool requiresAdjacency = false);
+
+		/** Deletes all program binaries stored in the cache folder. */
+		void clearCache();
+
+		/** 
+		 * Returns statistics about programs compiled or loaded from the cache since start-up. 
+		 *
+		 * @note	Thread safe.
+		 */
+		GpuProgramCacheStats getCacheStats() const;
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/**
+		 * Attempts to find a compiled binary of the provided program in the program cache. Returns false if the
+		 * program cache is disabled, if the binary cannot be found, or if programs of the provided language cannot be
+		 * loaded from binaries.
+		 *
+		 * @param[in]	language	Language the program's source is written in.
+		 * @param[in]	program		Program to find the binary for. Binary is identified by the program's source, entry
+		 *							point, type, profile and the version of the compiler used by the language's factory.
+		 * @param[out]	output		Compiled program binary, if found.
+		 * @param[out]	compiled	True if the binary was compiled by precompile() specifically for this program, in 
+		 *							which case the program should be counted as compiled rather than loaded from the 
+		 *							cache. Only the first program created from a precompiled binary is considered 
+		 *							compiled.
+		 */
+		bool _findCachedBinary(const String& language, const GpuProgramCore& program, Vector<UINT8>& output, 
+			bool& compiled);
+
+		/**
+		 * Stores the compiled binary of the provided program in the program cache. Does nothing if the program cache is
+		 * disabled or if programs of the provided language cannot be loaded from binaries.
+		 *
+		 * @see	_findCachedBinary
+		 */
+		void _cacheBinary(const String& language, const GpuProgramCore& program, const UINT8* data, UINT32 size);
+
+		/**
+		 * Notifies the manager a program has been created. Used for keeping track of program cache statistics.
+		 *
+		 * @param[in]	time		Time it took to create the program, in microseconds.
+		 * @param[in]	fromCache	True if the program was loaded from a binary in the program cache, false if it had
+		 *							to be compiled from source (including programs created from a binary compiled by
+		 *							precompile(), whose compile time is already accounted for).
+		 */
+		void _notifyProgramCreated(UINT64 time, bool fromCache);
+
+		/** @} */
+
 	protected:
 		friend class GpuProgram;
 
@@ -131,11 +265,50 @@ namespace BansheeEngine
 		/** Attempts to find a factory for the specified language. Returns null if it cannot find one. */
 		GpuProgramFactory* getFactory(const String& language);
 
+		/** 
+		 * Returns a key uniquely identifying a compiled program binary, and a hash of the program source. Returns zero if
+		 * programs in the provided language cannot be created from binaries.
+		 */
+		UINT64 getCacheKey(const String& language, const String& source, const String& entryPoint, 
+			GpuProgramType gptype, GpuProgramProfile profile, bool requiresAdjacency, UINT64& sourceHash);
+
+		/** Returns a path to the cache file for the program binary with the provided key. Empty if the cache is disabled. */
+		Path getCachePath(UINT64 key) const;
+
+		/** 
+		 * Reads a program binary from a cache file. Returns false if the file doesn't exist, or doesn't match the 
+		 * provided source. 
+		 */
+		static bool readCacheFile(const Path& path, UINT64 sourceHash, UINT32 sourceSize, Vector<UINT8>& output);
+
+		/** Writes a program binary to a cache file, overwriting any existing file. */
+		static void writeCacheFile(const Path& path, UINT64 sourceHash, UINT32 sourceSize, const UINT8* data, 
+			UINT32 size);
+
+		/** Generates a 64-bit FNV-1a hash of the provided data, continuing from an existing hash value. */
+		static UINT64 hash(const void* data, UINT32 size, UINT64 hash);
+
+		static const UINT32 CACHE_FILE_MAGIC;
+		static const UINT32 CACHE_FILE_VERSION;
+
 	protected:
+		/** Binary compiled through precompile(), waiting for its program to be created. */
+		struct PrecompiledBinary
+		{
+			Vector<UINT8> data;
+			UINT32 refCount = 0;
+			bool isCounted = false; /**< True once a program created from the binary was counted as compiled. */
+		};
+
 		typedef Map<String, GpuProgramFactory*> FactoryMap;
 
 		FactoryMap mFactories;
 		GpuProgramFactory* mNullFactory; /**< Factory for dealing with GPU programs that can't be created. */
+
+		Path mCacheFolder;
+		GpuProgramCacheStats mCacheStats;
+		UnorderedMap<UINT64, PrecompiledBinary> mPrecompiledBinaries;
+		mutable Mutex mCacheMutex;
 	};
 
 	/** @} */
@@ -82,6 +82,18 @@ namespace BansheeEngine
 		 */
 		virtual UINT32 getInternalBufferSize() const = 0;
 
+		/**
+		 * Allocates memory for the internal buffer. Override to count the buffer in a different memory category.
+		 *
+		 * @note	
+		 * Classes that override this method (and freeBuffer()) must call freeInternalBuffer() from their destructor, as
+		 * the overridden freeBuffer() can no longer be called by the time the base class destructor runs.
+		 */
+		virtual UINT8* allocateBuffer(UINT32 size) { return (UINT8*)bs_alloc(size); }
+
+		/** Frees memory allocated by allocateBuffer(). */
+		virtual void freeBuffer(UINT8* data) { bs_free(data); }
+
 	private:
 		UINT8* mData;
 		bool mOwnsData;
@@ -85,6 +85,16 @@ namespace BansheeEngine
 		 */
 		void readData(MeshData& dest);
 
+		/** Returns the usage flags the mesh was created with. Combination of one or more MeshUsage flags. */
+		int getUsage() const { return mUsage; }
+
+		/**
+		 * Returns a counter that is incremented whenever the mesh contents are updated through writeSubresource().
+		 * Allows data derived from the mesh contents to be rebuilt when the mesh changes. Writes performed directly on
+		 * the core thread are not counted.
+		 */
+		UINT32 getContentVersion() const { return mContentVersion; }
+
 		/** Retrieves a core implementation of a mesh usable only from the core thread. */
 		SPtr<MeshCore> getCore() const;
 
@@ -128,6 +138,7 @@ namespace BansheeEngine
 		SPtr<VertexDataDesc> mVertexDesc;
 		int mUsage;
 		IndexType mIndexType;
+		UINT32 mContentVersion;
 
 		/************************************************************************/
 		/* 								SERIALIZATION                      		*/
@@ -244,6 +244,12 @@ namespace BansheeEngine
 		/**	Returns the size of the internal buffer in bytes. */
 		UINT32 getInternalBufferSize() const override;
 
+		/** @copydoc GpuResourceData::allocateBuffer */
+		UINT8* allocateBuffer(UINT32 size) override { return (UINT8*)bs_alloc<MeshAlloc>(size); }
+
+		/** @copydoc GpuResourceData::freeBuffer */
+		void freeBuffer(UINT8* data) override { bs_free<MeshAlloc>(data); }
+
 	private:
 		/**	Returns a pointer to the start of the index buffer. */
 		UINT8* getIndexData() const { return getData(); }
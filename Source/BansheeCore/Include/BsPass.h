@@ -149,6 +149,12 @@ namespace BansheeEngine
     public:
 		virtual ~PassCore() { }
 
+		/**
+		 * Returns a pipeline state object containing all GPU programs (except the compute program) and render states used
+		 * by this pass. Created on first use.
+		 */
+		const SPtr<PipelineStateCore>& getPipelineState() const;
+
 		/**	Creates a new empty pass. */
 		static SPtr<PassCore> create(const PASS_DESC_CORE& desc);
 
@@ -161,6 +167,8 @@ namespace BansheeEngine
 
 		/** @copydoc CoreObjectCore::syncToCore */
 		void syncToCore(const CoreSyncData& data) override;
+
+		mutable SPtr<PipelineStateCore> mPipelineState;
     };
 
 	/** @} */
@@ -0,0 +1,103 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+
+namespace BansheeEngine
+{
+	/** @addtogroup RenderAPI-Internal
+	 *  @{
+	 */
+
+	/** Descriptor structure used for initializing a pipeline state object. */
+	struct BS_CORE_EXPORT PIPELINE_STATE_CORE_DESC
+	{
+		PIPELINE_STATE_CORE_DESC()
+			:stencilRefValue(0)
+		{ }
+
+		bool operator==(const PIPELINE_STATE_CORE_DESC& rhs) const;
+
+		SPtr<BlendStateCore> blendState;
+		SPtr<RasterizerStateCore> rasterizerState;
+		SPtr<DepthStencilStateCore> depthStencilState;
+		UINT32 stencilRefValue;
+
+		SPtr<GpuProgramCore> vertexProgram;
+		SPtr<GpuProgramCore> fragmentProgram;
+		SPtr<GpuProgramCore> geometryProgram;
+		SPtr<GpuProgramCore> hullProgram;
+		SPtr<GpuProgramCore> domainProgram;
+	};
+
+	/**
+	 * Describes the complete state of the graphics pipeline (all GPU programs and fixed function states) that can be bound
+	 * with a single call. States are cached by the RenderStateCoreManager so two objects created from equivalent
+	 * descriptors will be the same object, allowing the render API to skip redundant binds by comparing only the state
+	 * identifier.
+	 *
+	 * @note	Core thread only. Compute programs are not part of the pipeline state and must be bound separately.
+	 */
+	class BS_CORE_EXPORT PipelineStateCore
+	{
+	public:
+		virtual ~PipelineStateCore() { }
+
+		/** Returns the blend state. Never null. */
+		const SPtr<BlendStateCore>& getBlendState() const { return mData.blendState; }
+
+		/** Returns the rasterizer state. Never null. */
+		const SPtr<RasterizerStateCore>& getRasterizerState() const { return mData.rasterizerState; }
+
+		/** Returns the depth-stencil state. Never null. */
+		const SPtr<DepthStencilStateCore>& getDepthStencilState() const { return mData.depthStencilState; }
+
+		/** Returns the reference value used for stencil operations. */
+		UINT32 getStencilRefValue() const { return mData.stencilRefValue; }
+
+		/** Returns the vertex program, or null if none. */
+		const SPtr<GpuProgramCore>& getVertexProgram() const { return mData.vertexProgram; }
+
+		/** Returns the fragment program, or null if none. */
+		const SPtr<GpuProgramCore>& getFragmentProgram() const { return mData.fragmentProgram; }
+
+		/** Returns the geometry program, or null if none. */
+		const SPtr<GpuProgramCore>& getGeometryProgram() const { return mData.geometryProgram; }
+
+		/** Returns the hull program, or null if none. */
+		const SPtr<GpuProgramCore>& getHullProgram() const { return mData.hullProgram; }
+
+		/** Returns the domain program, or null if none. */
+		const SPtr<GpuProgramCore>& getDomainProgram() const { return mData.domainProgram; }
+
+		/**
+		 * Returns an identifier that uniquely identifies this pipeline state among all pipeline states currently in
+		 * existence. Never zero.
+		 */
+		UINT64 getId() const { return mId; }
+
+		/** Returns a 64-bit hash generated from the pipeline state contents. */
+		UINT64 getHash() const { return mHash; }
+
+		/**
+		 * Creates a new pipeline state object, or returns an existing one if an equivalent state already exists. Null
+		 * render states in the descriptor are replaced with the default states.
+		 */
+		static SPtr<PipelineStateCore> create(const PIPELINE_STATE_CORE_DESC& desc);
+
+		/** Generates a 64-bit hash from the provided pipeline state descriptor. */
+		static UINT64 generateHash(const PIPELINE_STATE_CORE_DESC& desc);
+
+	protected:
+		friend class RenderStateCoreManager;
+
+		PipelineStateCore(const PIPELINE_STATE_CORE_DESC& desc, UINT64 hash, UINT64 id);
+
+		PIPELINE_STATE_CORE_DESC mData;
+		UINT64 mHash;
+		UINT64 mId;
+	};
+
+	/** @} */
+}
@@ -170,7 +170,7 @@ namespace BansheeEngine
 	{
     public:
     	PixelData() {}
-		~PixelData() {}
+		~PixelData() { freeInternalBuffer(); }
 
 		/**
 		 * Constructs a new object with an internal buffer capable of holding "extents" volume of pixels, where each pixel 
@@ -361,6 +361,12 @@ namespace BansheeEngine
 		/**	Returns the needed size of the internal buffer, in bytes. */
 		UINT32 getInternalBufferSize() const override;
 
+		/** @copydoc GpuResourceData::allocateBuffer */
+		UINT8* allocateBuffer(UINT32 size) override { return (UINT8*)bs_alloc<TextureAlloc>(size); }
+
+		/** @copydoc GpuResourceData::freeBuffer */
+		void freeBuffer(UINT8* data) override { bs_free<TextureAlloc>(data); }
+
 	private:
 		PixelVolume mExtents;
         PixelFormat mFormat;
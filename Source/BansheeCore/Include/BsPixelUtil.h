@@ -193,16 +193,38 @@ namespace BansheeEngine
 		/**
 		 * Converts pixels from one format to another. Provided pixel data objects must have previously allocated buffers
 		 * of adequate size and their sizes must match.
+		 *
+		 * Conversions between common uncompressed formats (8-bit per channel formats, and 8-bit formats to/from 
+		 * PF_FLOAT32_RGBA and PF_FLOAT16_RGBA) use specialized SIMD converters. Large images are converted on multiple
+		 * threads if the task scheduler is running.
 		 */
         static void bulkPixelConversion(const PixelData& src, PixelData& dst);
 
-		/** Compresses the provided data using the specified compression options.  */
+		/** 
+		 * Compresses the provided data using the specified compression options. Large images are split into bands that
+		 * are compressed on multiple threads, if the task scheduler is running.
+		 */
 		static void compress(const PixelData& src, PixelData& dst, const CompressionOptions& options);
 
+		/**
+		 * Compresses multiple images at once (e.g. faces of a cube map, or levels of a mip-map chain), using the specified
+		 * compression options. Images are compressed in parallel, if the task scheduler is running.
+		 *
+		 * @param[in]	src		Images to compress.
+		 * @param[in]	dst		Buffers to output the compressed images to. Must have the same number of entries as 
+		 *						@p src, each with an allocated buffer of adequate size.
+		 * @param[in]	options	Options controlling the compression of all the images.
+		 */
+		static void compress(const Vector<SPtr<PixelData>>& src, const Vector<SPtr<PixelData>>& dst, 
+			const CompressionOptions& options);
+
 		/**
 		 * Generates mip-maps from the provided source data using the specified compression options. Returned list includes
 		 * the base level.
 		 *
+		 * Non floating point images with power of two sizes are processed by NVTT. Other images are filtered by a built-in
+		 * SIMD filter, which processes large images on multiple threads if the task scheduler is running.
+		 *
 		 * @return	A list of calculated mip-map data. First entry is the largest mip and other follow in order from 
 		 *			largest to smallest.
 		 */
@@ -224,6 +246,26 @@ namespace BansheeEngine
 		 * @param[in]	bpp		Number of bits per pixel of the pixels in the buffer.
 		 */
         static void applyGamma(UINT8* buffer, float gamma, UINT32 size, UINT8 bpp);
+
+		/** Converts a color channel value from sRGB (gamma) space to linear space. */
+		static float SRGBToLinear(float value);
+
+		/** Converts a color channel value from linear space to sRGB (gamma) space. */
+		static float linearToSRGB(float value);
+
+		/** 
+		 * Converts the color channels of the provided pixels from sRGB (gamma) space to linear space, in place. Alpha
+		 * is left as is. Compressed and depth formats are not supported.
+		 *
+		 * @note	Formats with 8 bits per channel lose precision in dark areas when stored in linear space.
+		 */
+		static void SRGBToLinear(PixelData& data);
+
+		/** 
+		 * Converts the color channels of the provided pixels from linear space to sRGB (gamma) space, in place. Alpha
+		 * is left as is. Compressed and depth formats are not supported.
+		 */
+		static void linearToSRGB(PixelData& data);
     };
 
 	/** @} */
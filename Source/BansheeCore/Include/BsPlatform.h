@@ -313,6 +313,16 @@ namespace BansheeEngine
 		 */
 		static void sleep(UINT32 duration);
 
+		/** 
+		 * Causes the current thread to pause execution for the specified amount of time, using a high resolution timer 
+		 * where the OS supports one. Unlike sleep() this doesn't depend on the system timer granularity, so it can be 
+		 * used for waits shorter than a few milliseconds without having to busy-wait. If no high resolution timer is
+		 * available the last couple of milliseconds of the wait are busy-waited instead.
+		 *
+		 * @param[in]	duration	Duration in microseconds.
+		 */
+		static void sleepPrecise(UINT64 duration);
+
 		/**
 		 * Creates a drop target that you can use for tracking OS drag and drop operations performed over a certain area 
 		 * on the specified window.
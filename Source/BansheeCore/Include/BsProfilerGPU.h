@@ -19,6 +19,8 @@ namespace BansheeEngine
 		float timeMs; /**< Time in milliseconds it took to execute the sampled block. */
 
 		UINT32 numDrawCalls; /**< Number of draw calls that happened. */
+		UINT32 numInstancedDrawCalls; /**< Number of draw calls that rendered more than one object instance. */
+		UINT32 numInstances; /**< Number of object instances rendered using instanced draw calls. */
 		UINT32 numRenderTargetChanges; /**< How many times was render target changed. */
 		UINT32 numPresents; /**< How many times did a buffer swap happen on a double buffered render target. */
 		UINT32 numClears; /**< How many times was render target cleared. */
@@ -37,6 +39,9 @@ namespace BansheeEngine
 		UINT32 numIndexBufferBinds; /**< How many times was an index buffer bound. */
 		UINT32 numGpuParamBufferBinds; /**< How many times was an GPU parameter buffer bound. */
 		UINT32 numGpuProgramBinds; /**< How many times was a GPU program bound. */
+		UINT32 numGpuParamBytesUploaded; /**< How many bytes of GPU parameter buffer data were uploaded. */
+		UINT32 numPipelineStateChanges; /**< How many times was a pipeline state object bound. */
+		UINT32 numRedundantPipelineStateBinds; /**< How many pipeline state binds were skipped as redundant. */
 
 		UINT32 numResourceWrites; /**< How many times were GPU resources written to. */
 		UINT32 numResourceReads; /**< How many times were GPU resources read from. */
@@ -16,6 +16,9 @@ namespace BansheeEngine
 	struct ProfilerReport
 	{
 		CPUProfilerReport cpuReport;
+
+		/** Allocation statistics of each memory category. Only present in sim thread reports. */
+		ProfilerVector<MemoryCategoryStats> memoryReport;
 	};
 
 	/**	Type of thread used by the profiler. */
@@ -60,7 +63,20 @@ namespace BansheeEngine
 		 */
 		const ProfilerReport& getReport(ProfiledThread thread, UINT32 idx = 0) const;
 
+		/**
+		 * Saves a human readable report of memory allocated in each memory category to the specified file. If allocation
+		 * tracking and callstack sampling are enabled (see MemoryCounter::setTrackingEnabled()), the report also lists 
+		 * the callstacks of sampled allocations that weren't freed yet, making it useful for finding leaks in long 
+		 * running tests.
+		 *
+		 * @note	Thread safe.
+		 */
+		void saveMemoryReport(const Path& path) const;
+
 	private:
+		/** Retrieves allocation statistics of all memory categories. */
+		static void getMemoryReport(ProfilerVector<MemoryCategoryStats>& output);
+
 		static const UINT32 NUM_SAVED_FRAMES;
 		ProfilerReport* mSavedSimReports;
 		UINT32 mNextSimReportIdx;
@@ -378,6 +378,16 @@ namespace BansheeEngine
 		 */
 		virtual void setDepthStencilState(const SPtr<DepthStencilStateCore>& depthStencilState, UINT32 stencilRefValue) = 0;
 
+		/**
+		 * Binds all GPU programs and render states contained in a pipeline state object. If the same pipeline state is
+		 * already bound, and no individual programs or states were bound since, the call does nothing.
+		 *
+		 * @param[in]	pipelineState	Pipeline state to bind. Program stages not used by the state will be unbound.
+		 *
+		 * @note	Compute program binding is unaffected by this call.
+		 */
+		void setPipelineState(const SPtr<PipelineStateCore>& pipelineState);
+
 		/**
 		 * Binds a texture to the pipeline for the specified GPU program type at the specified slot. If the slot matches 
 		 * the one configured in the GPU program the program will be able to access this texture on the GPU.
@@ -409,6 +419,20 @@ namespace BansheeEngine
 		virtual void setLoadStoreTexture(GpuProgramType gptype, UINT16 texUnit, bool enabled,
 			const SPtr<TextureCore>& texPtr, const TextureSurface& surface) = 0;
 
+		/**
+		 * Binds a buffer to the pipeline for the specified GPU program type at the specified slot, allowing the GPU program
+		 * to read from the buffer. The entire buffer is made visible to the program.
+		 *
+		 * @param[in]	gptype			Determines to which GPU program slot to bind the buffer.
+		 * @param[in]	unit			Slot index to bind the buffer to.
+		 * @param[in]	buffer			Buffer to bind, or null to unbind.
+		 * @param[in]	loadStore		If true the buffer will be bound for random load/store access, allowing the GPU
+		 *								program to write to it. Only supported for fragment and compute programs, and only
+		 *								for buffers created with random GPU write enabled.
+		 */
+		virtual void setBuffer(GpuProgramType gptype, UINT16 unit, const SPtr<GpuBufferCore>& buffer, 
+			bool loadStore = false) = 0;
+
 		/**
 		 * Signals that rendering for a specific viewport has started. Any draw calls need to be called between beginFrame()
 		 * and endFrame(). 
@@ -708,6 +732,8 @@ namespace BansheeEngine
 		bool mHullProgramBound;
 		bool mComputeProgramBound;
 
+		UINT64 mActivePipelineStateId;
+
 		PlaneList mClipPlanes;
 		bool mClipPlanesDirty;
 
@@ -8,6 +8,7 @@
 #include "BsRasterizerState.h"
 #include "BsDepthStencilState.h"
 #include "BsSamplerState.h"
+#include "BsPipelineState.h"
 
 namespace BansheeEngine
 {
@@ -131,6 +132,12 @@ namespace BansheeEngine
 		/** @copydoc RenderStateManager::createBlendState */
 		SPtr<BlendStateCore> createBlendState(const BLEND_STATE_DESC& desc) const;
 
+		/**
+		 * Creates a new pipeline state object, or returns a cached one if an equivalent state was already created. Null
+		 * render states in the descriptor are replaced with the default states.
+		 */
+		SPtr<PipelineStateCore> createPipelineState(const PIPELINE_STATE_CORE_DESC& desc) const;
+
 		/** Creates an uninitialized sampler state. Requires manual initialization after creation. */
 		SPtr<SamplerStateCore> _createSamplerState(const SAMPLER_STATE_DESC& desc) const;
 
@@ -232,9 +239,12 @@ namespace BansheeEngine
 		mutable UnorderedMap<RASTERIZER_STATE_DESC, CachedRasterizerState> mCachedRasterizerStates;
 		mutable UnorderedMap<DEPTH_STENCIL_STATE_DESC, CachedDepthStencilState> mCachedDepthStencilStates;
 
+		mutable UnorderedMap<UINT64, std::weak_ptr<PipelineStateCore>> mCachedPipelineStates;
+
 		mutable UINT32 mNextBlendStateId;
 		mutable UINT32 mNextRasterizerStateId;
 		mutable UINT32 mNextDepthStencilStateId;
+		mutable UINT64 mNextPipelineStateId;
 
 		mutable Mutex mMutex;
 	};
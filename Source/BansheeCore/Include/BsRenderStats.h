@@ -27,13 +27,16 @@ namespace BansheeEngine
 	struct BS_CORE_EXPORT RenderStatsData
 	{
 		RenderStatsData()
-		: numDrawCalls(0), numComputeCalls(0), numRenderTargetChanges(0), numPresents(0), numClears(0),
-		  numVertices(0), numPrimitives(0), numBlendStateChanges(0), numRasterizerStateChanges(0), 
-		  numDepthStencilStateChanges(0), numTextureBinds(0), numSamplerBinds(0), numVertexBufferBinds(0), 
-		  numIndexBufferBinds(0), numGpuParamBufferBinds(0), numGpuProgramBinds(0)
+		: numDrawCalls(0), numInstancedDrawCalls(0), numInstances(0), numComputeCalls(0), numRenderTargetChanges(0), 
+		  numPresents(0), numClears(0), numVertices(0), numPrimitives(0), numBlendStateChanges(0), 
+		  numRasterizerStateChanges(0), numDepthStencilStateChanges(0), numTextureBinds(0), numSamplerBinds(0), 
+		  numVertexBufferBinds(0), numIndexBufferBinds(0), numGpuParamBufferBinds(0), numGpuProgramBinds(0),
+		  numGpuParamBytesUploaded(0), numPipelineStateChanges(0), numRedundantPipelineStateBinds(0)
 		{ }
 
 		UINT64 numDrawCalls;
+		UINT64 numInstancedDrawCalls;
+		UINT64 numInstances;
 		UINT64 numComputeCalls;
 		UINT64 numRenderTargetChanges;
 		UINT64 numPresents;
@@ -52,6 +55,9 @@ namespace BansheeEngine
 		UINT64 numIndexBufferBinds;
 		UINT64 numGpuParamBufferBinds;
 		UINT64 numGpuProgramBinds; 
+		UINT64 numGpuParamBytesUploaded;
+		UINT64 numPipelineStateChanges;
+		UINT64 numRedundantPipelineStateBinds;
 
 		UINT64 numResourceWrites;
 		UINT64 numResourceReads;
@@ -71,6 +77,15 @@ namespace BansheeEngine
 		/** Increments draw call counter indicating how many times were render system API Draw methods called. */
 		void incNumDrawCalls() { mData.numDrawCalls++; }
 
+		/** 
+		 * Increments instanced draw call counter indicating how many draw calls rendered more than one object in a single
+		 * call.
+		 */
+		void incNumInstancedDrawCalls() { mData.numInstancedDrawCalls++; }
+
+		/** Increments instance counter indicating how many objects were rendered using instanced draw calls. */
+		void addNumInstances(UINT32 count) { mData.numInstances += count; }
+
 		/** Increments compute call counter indicating how many times were compute shaders dispatched. */
 		void incNumComputeCalls() { mData.numComputeCalls++; }
 
@@ -128,6 +143,21 @@ namespace BansheeEngine
 		/** Increments GPU program change counter indicating how many times was a GPU program bound to the pipeline. */
 		void incNumGpuProgramBinds() { mData.numGpuProgramBinds++; }
 
+		/** Increases the counter tracking how many bytes of GPU parameter buffer data were uploaded to the GPU. */
+		void addNumGpuParamBytesUploaded(UINT32 count) { mData.numGpuParamBytesUploaded += count; }
+
+		/** 
+		 * Increments pipeline state change counter indicating how many times was a pipeline state object bound to the
+		 * pipeline.
+		 */
+		void incNumPipelineStateChanges() { mData.numPipelineStateChanges++; }
+
+		/** 
+		 * Increments redundant pipeline state counter indicating how many times was a bind of a pipeline state object
+		 * skipped because the same state was already bound.
+		 */
+		void incNumRedundantPipelineStateBinds() { mData.numRedundantPipelineStateBinds++; }
+
 		/**
 		 * Increments created GPU resource counter. 
 		 *
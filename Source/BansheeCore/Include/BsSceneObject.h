@@ -128,6 +128,23 @@ namespace BansheeEngine
 		/** Assigns a new prefab diff object. Caller must ensure the prefab diff was generated for this object. */
 		void _setPrefabDiff(const SPtr<PrefabDiff>& diff) { mPrefabDiff = diff; }
 
+		/**
+		 * Registers a core object (e.g. a renderable) whose transform and active state mirror this scene object. While at
+		 * least one such object is registered, any change to the transform or active state of this object will queue it
+		 * in the scene manager for an update. The object is queued immediately upon registration so the core object
+		 * receives its initial state.
+		 */
+		void _registerCoreObject();
+
+		/** Unregisters a core object registered through _registerCoreObject(). */
+		void _unregisterCoreObject();
+
+		/** 
+		 * Notifies the object that the scene manager has processed its queued changes, allowing it to be queued again on
+		 * the next change.
+		 */
+		void _clearCoreObjectsDirty() { mCoreObjectsDirty = false; }
+
 		/** @} */
 
 	private:
@@ -351,6 +368,8 @@ namespace BansheeEngine
 
 		mutable UINT32 mDirtyFlags;
 		mutable UINT32 mDirtyHash;
+		UINT32 mNumCoreObjects;
+		mutable bool mCoreObjectsDirty;
 
 		/** 
 		 * Notifies components and child scene object that a transform has been changed.  
@@ -359,6 +378,12 @@ namespace BansheeEngine
 		 */
 		void notifyTransformChanged(TransformChangedFlags flags) const;
 
+		/** 
+		 * Queues the object in the scene manager so that any core objects tied to it can be updated. Does nothing if the
+		 * object has no core objects or is already queued.
+		 */
+		void markCoreObjectsDirty() const;
+
 		/** Updates the local transform. Normally just reconstructs the transform matrix from the position/rotation/scale. */
 		void updateLocalTfrm() const;
 
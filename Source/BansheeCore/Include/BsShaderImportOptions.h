@@ -21,6 +21,17 @@ namespace BansheeEngine
 		/** Returns a modifiable list of defines that will control shader compilation. */
 		const UnorderedMap<String, String>& getDefines() const { return mDefines; }
 
+		/** 
+		 * Returns a modifiable list of additional shader permutations to import, mapping a unique permutation name to a 
+		 * set of defines. Permutation defines are applied on top of the ones returned by getDefines(). Each permutation 
+		 * is imported as a separate sub-resource, named the same as the permutation, and all permutations are compiled 
+		 * together so they can share their GPU programs.
+		 */
+		Map<String, UnorderedMap<String, String>>& getPermutations() { return mPermutations; }
+
+		/** @copydoc getPermutations() */
+		const Map<String, UnorderedMap<String, String>>& getPermutations() const { return mPermutations; }
+
 		/************************************************************************/
 		/* 								SERIALIZATION                      		*/
 		/************************************************************************/
@@ -31,6 +42,7 @@ namespace BansheeEngine
 
 	private:
 		UnorderedMap<String, String> mDefines;
+		Map<String, UnorderedMap<String, String>> mPermutations;
 	};
 
 	/** @} */
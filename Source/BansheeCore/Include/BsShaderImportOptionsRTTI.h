@@ -33,12 +33,25 @@ namespace BansheeEngine
 		UINT32 getNumDefines(ShaderImportOptions* obj) { return (UINT32)obj->getDefines().size(); }
 		void setNumDefines(ShaderImportOptions* obj, UINT32 val) { /* Do nothing */ }
 
+		Map<String, UnorderedMap<String, String>>& getPermutations(ShaderImportOptions* obj) 
+		{ 
+			return obj->mPermutations; 
+		}
+
+		void setPermutations(ShaderImportOptions* obj, Map<String, UnorderedMap<String, String>>& val) 
+		{ 
+			obj->mPermutations = val; 
+		}
+
 	public:
 		ShaderImportOptionsRTTI()
 		{
 			addPlainArrayField("mDefines", 0, &ShaderImportOptionsRTTI::getDefinePair, 
 				&ShaderImportOptionsRTTI::getNumDefines, &ShaderImportOptionsRTTI::setDefinePair, 
 				&ShaderImportOptionsRTTI::setNumDefines);
+
+			addPlainField("mPermutations", 1, &ShaderImportOptionsRTTI::getPermutations, 
+				&ShaderImportOptionsRTTI::setPermutations);
 		}
 
 		/** @copydoc ShaderImportOptionsRTTI::onSerializationStarted */
@@ -0,0 +1,74 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "BsMatrix4.h"
+
+namespace BansheeEngine
+{
+	/** @addtogroup Animation
+	 *  @{
+	 */
+
+	/** Information about a single bone in a skeleton. */
+	struct SkeletonBone
+	{
+		String name; /**< Unique name of the bone, used for matching bones animated by animation clips. */
+		INT32 parent; /**< Index of the parent bone, or -1 if the bone is a root bone. */
+		Matrix4 invBindPose; /**< Transforms a vertex from model space into bone space, in the bind (rest) pose. */
+	};
+
+	/**
+	 * Hierarchy of bones used for deforming a skinned mesh. Converts animated bone transforms into a bone palette, the
+	 * set of matrices that transform vertices from their bind pose into the animated pose.
+	 */
+	class BS_CORE_EXPORT Skeleton
+	{
+	public:
+		/** Returns the number of bones in the skeleton. */
+		UINT32 getNumBones() const { return (UINT32)mBones.size(); }
+
+		/** Returns information about the bone at the specified index. */
+		const SkeletonBone& getBone(UINT32 idx) const { return mBones[idx]; }
+
+		/** Returns the transform of the bone relative to its parent, in the bind pose. */
+		const Matrix4& getLocalBindPose(UINT32 idx) const { return mLocalBindPoses[idx]; }
+
+		/**
+		 * Finds the animation clip bone animating each of the skeleton bones, by matching bone names.
+		 *
+		 * @param[in]	clip	Clip to map the bones of.
+		 * @param[out]	output	Receives an index of a bone in @p clip for each bone in the skeleton, or -1 if the bone
+		 *						is not animated by the clip.
+		 */
+		void mapBones(const AnimationClip& clip, Vector<INT32>& output) const;
+
+		/**
+		 * Calculates a bone palette from a pose.
+		 *
+		 * @param[in]	pose		Transform of each bone relative to its parent, in the same order as bones in the
+		 *							skeleton.
+		 * @param[out]	palette		Receives a matrix for each bone, transforming a vertex from its bind pose position
+		 *							in model space, to its posed position in model space. Must have room for one entry per
+		 *							bone.
+		 */
+		void getPalette(const Matrix4* pose, Matrix4* palette) const;
+
+		/**
+		 * Creates a new skeleton.
+		 *
+		 * @param[in]	bones	Bones of the skeleton. Parent bones must come before their children.
+		 */
+		static SPtr<Skeleton> create(const Vector<SkeletonBone>& bones);
+
+	private:
+		Skeleton(const Vector<SkeletonBone>& bones);
+
+		Vector<SkeletonBone> mBones;
+		Vector<Matrix4> mLocalBindPoses;
+		Vector<Matrix4> mInvBindPoses;
+	};
+
+	/** @} */
+}
@@ -0,0 +1,153 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "BsMeshData.h"
+#include "BsSubMesh.h"
+#include "BsMatrix4.h"
+#include "BsVector3.h"
+#include "BsVector4.h"
+
+namespace BansheeEngine
+{
+	/** @addtogroup Animation
+	 *  @{
+	 */
+
+	/** Offset of a single vertex, applied by a blend shape at full weight. */
+	struct BlendShapeVertex
+	{
+		UINT32 index; /**< Index of the vertex to offset. */
+		Vector3 positionOffset; /**< Offset to apply to the vertex position. */
+		Vector3 normalOffset; /**< Offset to apply to the vertex normal. */
+	};
+
+	/** Set of vertex offsets deforming a mesh into a different shape (also known as a morph target). */
+	struct BlendShape
+	{
+		String name; /**< Name of the blend shape. */
+		Vector<BlendShapeVertex> vertices; /**< Offsets of all the vertices affected by the blend shape. */
+	};
+
+	/**
+	 * Mesh deformed by a skeleton using linear blend skinning, and by blend shapes. Deformed vertices are written into a
+	 * dynamic mesh that can be rendered like any other mesh.
+	 *
+	 * Deformed vertices are prepared in one of two CPU buffers, while the core thread uploads the vertices from the other
+	 * one, so deformation of the next frame never has to wait on the upload of the previous one.
+	 */
+	class BS_CORE_EXPORT SkinnedMesh
+	{
+	public:
+		/** Returns the mesh containing the deformed vertices. */
+		const HMesh& getMesh() const { return mMesh; }
+
+		/** Returns the skeleton deforming the mesh. Null if the mesh is only deformed by blend shapes. */
+		const SPtr<Skeleton>& getSkeleton() const { return mSkeleton; }
+
+		/**
+		 * Returns the bone palette calculated by the last update(). Contains a matrix for each bone in the skeleton,
+		 * transforming a vertex from its bind pose into the current pose.
+		 */
+		const Vector<Matrix4>& getBonePalette() const { return mPalette; }
+
+		/**
+		 * Returns a copy of the vertices written to the mesh by the last update(). The data will be overwritten by the
+		 * update after the next one. Null if the mesh wasn't updated yet.
+		 */
+		SPtr<MeshData> getDeformedData() const;
+
+		/** Returns the number of blend shapes the mesh can be deformed by. */
+		UINT32 getNumBlendShapes() const { return (UINT32)mBlendShapes.size(); }
+
+		/** Returns the name of the blend shape at the specified index. */
+		const String& getBlendShapeName(UINT32 idx) const { return mBlendShapes[idx].name; }
+
+		/** Returns the weight of the blend shape at the specified index. */
+		float getBlendShapeWeight(UINT32 idx) const { return mBlendShapeWeights[idx]; }
+
+		/** Sets the weight of the blend shape at the specified index. Weight of zero means the shape isn't applied. */
+		void setBlendShapeWeight(UINT32 idx, float weight);
+
+		/**
+		 * Poses the skeleton using the bone transforms sampled from an animation clip. Bones are matched by name, and
+		 * bones not animated by the clip are left in their bind pose.
+		 */
+		void setPose(const AnimationClipState& state);
+
+		/**
+		 * Deforms the vertices according to the current pose and blend shape weights, and queues the deformed vertices
+		 * for upload to the mesh. Must be called from the simulation thread.
+		 */
+		void update();
+
+		/**
+		 * Updates multiple skinned meshes at once. Bone palettes of all the meshes are calculated in parallel, after which
+		 * their vertices are split into groups deformed in parallel, if the task scheduler is running. Must be called from
+		 * the simulation thread.
+		 *
+		 * @see		update()
+		 */
+		static void update(SkinnedMesh* const* meshes, UINT32 count);
+
+		/**
+		 * Creates a new skinned mesh.
+		 *
+		 * @param[in]	meshData	Vertices and indices of the mesh in its bind pose. Positions must be in VET_FLOAT3
+		 *							format, normals (optional) in VET_FLOAT3 and tangents (optional) in VET_FLOAT4 format.
+		 *							If a skeleton is provided the mesh must also contain bone weights, with indices in
+		 *							VET_UBYTE4 and weights in VET_FLOAT4 format. All elements must be in the first stream.
+		 * @param[in]	subMeshes	Sub-meshes of the mesh.
+		 * @param[in]	skeleton	Skeleton deforming the mesh. Can be null if the mesh is only deformed by blend shapes.
+		 * @param[in]	blendShapes	Blend shapes that can deform the mesh.
+		 */
+		static SPtr<SkinnedMesh> create(const SPtr<MeshData>& meshData, const Vector<SubMesh>& subMeshes,
+			const SPtr<Skeleton>& skeleton, const Vector<BlendShape>& blendShapes = Vector<BlendShape>());
+
+	private:
+		SkinnedMesh(const SPtr<MeshData>& meshData, const Vector<SubMesh>& subMeshes, const SPtr<Skeleton>& skeleton,
+			const Vector<BlendShape>& blendShapes);
+
+		/** Returns true if the pose changed since the last update, and the bone palette needs to be recalculated. */
+		bool isPaletteDirty() const { return mSkeleton != nullptr && mPoseDirty; }
+
+		/** Calculates the bone palette from the current pose. */
+		void updatePalette();
+
+		/** Prepares a buffer to deform the vertices into. Returns false if no vertices need to be deformed this frame. */
+		bool beginUpdate();
+
+		/** Deforms vertices in range [@p start, @p end) into the buffer prepared by beginUpdate(). */
+		void deform(UINT32 start, UINT32 end) const;
+
+		/** Queues the deformed vertices for upload to the mesh. */
+		void endUpdate();
+
+		SPtr<Skeleton> mSkeleton;
+		HMesh mMesh;
+
+		SPtr<MeshData> mBuffers[2];
+		UINT32 mWriteBuffer;
+		bool mHasDeformedData;
+
+		Vector<Vector3> mPositions;
+		Vector<Vector3> mNormals;
+		Vector<Vector4> mTangents;
+		Vector<BoneWeight> mBoneWeights;
+
+		Vector<BlendShape> mBlendShapes;
+		Vector<float> mBlendShapeWeights;
+		bool mBlendShapesDirty;
+
+		Vector<Matrix4> mPose;
+		Vector<Matrix4> mPalette;
+		Vector<Matrix4> mTransposedPalette;
+		bool mPoseDirty;
+
+		SPtr<AnimationClip> mMappedClip;
+		Vector<INT32> mBoneMapping;
+	};
+
+	/** @} */
+}
@@ -0,0 +1,446 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsAnimationClip.h"
+#include "BsAnimationClipRTTI.h"
+#include "BsResources.h"
+#include "BsTaskScheduler.h"
+#include "BsMath.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define BS_ANIMATION_SSE 1
+#	include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#	define BS_ANIMATION_NEON 1
+#	include <arm_neon.h>
+#endif
+
+namespace BansheeEngine
+{
+	namespace
+	{
+		/** Number of curves animating a single bone: three for position, four for rotation and three for scale. */
+		const UINT32 NUM_CURVES_PER_BONE = 10;
+
+		/** Index of the first bone curve whose default value is one (rotation w, followed by the scale curves). */
+		const UINT32 FIRST_UNIT_CURVE = 6;
+
+		/** Minimum number of animated objects to evaluate in a single task. */
+		const UINT32 MIN_STATES_PER_TASK = 8;
+
+		/** Largest quantized key time or value. */
+		const float MAX_QUANTIZED_UNSIGNED = 65535.0f;
+
+		/** Largest quantized key tangent, by absolute value. */
+		const float MAX_QUANTIZED_SIGNED = 32767.0f;
+
+		static_assert(sizeof(BoneTransform) == NUM_CURVES_PER_BONE * sizeof(float),
+			"Bone transforms are written to directly by curve evaluation, one float per curve.");
+
+		// Minimal set of 4-wide float operations the curve evaluation is written in. Each lane evaluates a different curve.
+#if BS_ANIMATION_SSE
+		typedef __m128 Float4;
+
+		Float4 load4(const float* v) { return _mm_loadu_ps(v); }
+		void store4(float* v, Float4 a) { _mm_storeu_ps(v, a); }
+		Float4 set4(float v) { return _mm_set1_ps(v); }
+		Float4 add4(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+		Float4 sub4(Float4 a, Float4 b) { return _mm_sub_ps(a, b); }
+		Float4 mul4(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+		Float4 div4(Float4 a, Float4 b) { return _mm_div_ps(a, b); }
+		Float4 min4(Float4 a, Float4 b) { return _mm_min_ps(a, b); }
+		Float4 max4(Float4 a, Float4 b) { return _mm_max_ps(a, b); }
+#elif BS_ANIMATION_NEON
+		typedef float32x4_t Float4;
+
+		Float4 load4(const float* v) { return vld1q_f32(v); }
+		void store4(float* v, Float4 a) { vst1q_f32(v, a); }
+		Float4 set4(float v) { return vdupq_n_f32(v); }
+		Float4 add4(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+		Float4 sub4(Float4 a, Float4 b) { return vsubq_f32(a, b); }
+		Float4 mul4(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+		Float4 min4(Float4 a, Float4 b) { return vminq_f32(a, b); }
+		Float4 max4(Float4 a, Float4 b) { return vmaxq_f32(a, b); }
+
+		Float4 div4(Float4 a, Float4 b)
+		{
+#if defined(__aarch64__)
+			return vdivq_f32(a, b);
+#else
+			// No division on ARMv7, refine the reciprocal estimate with two Newton-Raphson steps instead
+			Float4 inv = vrecpeq_f32(b);
+			inv = vmulq_f32(vrecpsq_f32(b, inv), inv);
+			inv = vmulq_f32(vrecpsq_f32(b, inv), inv);
+
+			return vmulq_f32(a, inv);
+#endif
+		}
+#else
+		struct Float4
+		{
+			float v[4];
+		};
+
+		Float4 load4(const float* v) { return { { v[0], v[1], v[2], v[3] } }; }
+		void store4(float* v, Float4 a) { v[0] = a.v[0]; v[1] = a.v[1]; v[2] = a.v[2]; v[3] = a.v[3]; }
+		Float4 set4(float v) { return { { v, v, v, v } }; }
+
+		template<class Op>
+		Float4 apply4(Float4 a, Float4 b, Op op)
+		{
+			return { { op(a.v[0], b.v[0]), op(a.v[1], b.v[1]), op(a.v[2], b.v[2]), op(a.v[3], b.v[3]) } };
+		}
+
+		Float4 add4(Float4 a, Float4 b) { return apply4(a, b, [](float x, float y) { return x + y; }); }
+		Float4 sub4(Float4 a, Float4 b) { return apply4(a, b, [](float x, float y) { return x - y; }); }
+		Float4 mul4(Float4 a, Float4 b) { return apply4(a, b, [](float x, float y) { return x * y; }); }
+		Float4 div4(Float4 a, Float4 b) { return apply4(a, b, [](float x, float y) { return x / y; }); }
+		Float4 min4(Float4 a, Float4 b) { return apply4(a, b, [](float x, float y) { return std::min(x, y); }); }
+		Float4 max4(Float4 a, Float4 b) { return apply4(a, b, [](float x, float y) { return std::max(x, y); }); }
+#endif
+
+		/** Quantizes a value in range [0, MAX_QUANTIZED_UNSIGNED * scale]. */
+		UINT16 quantizeUnsigned(float value, float scale)
+		{
+			if (scale <= 0.0f)
+				return 0;
+
+			return (UINT16)Math::clamp(Math::round(value / scale), 0.0f, MAX_QUANTIZED_UNSIGNED);
+		}
+
+		/** Quantizes a value in range [-MAX_QUANTIZED_SIGNED * scale, MAX_QUANTIZED_SIGNED * scale]. */
+		INT16 quantizeSigned(float value, float scale)
+		{
+			if (scale <= 0.0f || !std::isfinite(value))
+				return 0;
+
+			return (INT16)Math::clamp(Math::round(value / scale), -MAX_QUANTIZED_SIGNED, MAX_QUANTIZED_SIGNED);
+		}
+
+		/**
+		 * Finds the key starting the curve segment containing the provided quantized time. Time must be after the first,
+		 * and before the last key in the curve. The key found by the previous search, and the one following it, are
+		 * tried first as evaluation time usually changes only slightly between evaluations.
+		 */
+		UINT32 findKey(const CompressedKeyframe* keys, UINT32 numKeys, float time, UINT32 cachedKey)
+		{
+			if ((cachedKey + 1) < numKeys && keys[cachedKey].time <= time)
+			{
+				if (time < keys[cachedKey + 1].time)
+					return cachedKey;
+
+				if ((cachedKey + 2) < numKeys && time < keys[cachedKey + 2].time)
+					return cachedKey + 1;
+			}
+
+			auto iterFind = std::upper_bound(keys, keys + numKeys, time,
+				[](float time, const CompressedKeyframe& key) { return time < key.time; });
+
+			return (UINT32)(iterFind - keys) - 1;
+		}
+	}
+
+	AnimationClip::AnimationClip()
+		:Resource(false), mStart(0.0f), mLength(0.0f)
+	{ }
+
+	AnimationClip::AnimationClip(const Vector<BoneAnimationCurves>& bones)
+		:Resource(false), mStart(0.0f), mLength(0.0f)
+	{
+		// Find the range of all keys in the clip, used for quantizing key times
+		float start = std::numeric_limits<float>::infinity();
+		float end = -std::numeric_limits<float>::infinity();
+
+		for (auto& bone : bones)
+		{
+			const AnimationCurve* curves[NUM_CURVES_PER_BONE] =
+			{
+				&bone.position[0], &bone.position[1], &bone.position[2],
+				&bone.rotation[0], &bone.rotation[1], &bone.rotation[2], &bone.rotation[3],
+				&bone.scale[0], &bone.scale[1], &bone.scale[2]
+			};
+
+			for (UINT32 i = 0; i < NUM_CURVES_PER_BONE; i++)
+			{
+				if (curves[i]->getKeyFrames().empty())
+					continue;
+
+				start = std::min(start, curves[i]->getStart());
+				end = std::max(end, curves[i]->getEnd());
+			}
+		}
+
+		if (start <= end)
+		{
+			mStart = start;
+			mLength = end - start;
+		}
+
+		float timeScale = mLength / MAX_QUANTIZED_UNSIGNED;
+
+		mBoneNames.reserve(bones.size());
+		mCurves.reserve(bones.size() * NUM_CURVES_PER_BONE);
+		for (auto& bone : bones)
+		{
+			mBoneNames.push_back(bone.name);
+
+			const AnimationCurve* curves[NUM_CURVES_PER_BONE] =
+			{
+				&bone.position[0], &bone.position[1], &bone.position[2],
+				&bone.rotation[0], &bone.rotation[1], &bone.rotation[2], &bone.rotation[3],
+				&bone.scale[0], &bone.scale[1], &bone.scale[2]
+			};
+
+			for (UINT32 i = 0; i < NUM_CURVES_PER_BONE; i++)
+			{
+				const Vector<Keyframe>& keyframes = curves[i]->getKeyFrames();
+
+				CompressedCurve curve;
+				curve.firstKey = (UINT32)mKeys.size();
+
+				// Curves without keys output a constant default value
+				if (keyframes.empty())
+				{
+					curve.numKeys = 1;
+					curve.valueMin = i >= FIRST_UNIT_CURVE ? 1.0f : 0.0f;
+					curve.valueScale = 0.0f;
+					curve.tangentScale = 0.0f;
+
+					mCurves.push_back(curve);
+					mKeys.push_back({ 0, 0, 0, 0 });
+					continue;
+				}
+
+				float minValue = std::numeric_limits<float>::infinity();
+				float maxValue = -std::numeric_limits<float>::infinity();
+				float maxTangent = 0.0f;
+
+				for (auto& keyframe : keyframes)
+				{
+					minValue = std::min(minValue, keyframe.value);
+					maxValue = std::max(maxValue, keyframe.value);
+
+					if (std::isfinite(keyframe.inTangent))
+						maxTangent = std::max(maxTangent, Math::abs(keyframe.inTangent));
+
+					if (std::isfinite(keyframe.outTangent))
+						maxTangent = std::max(maxTangent, Math::abs(keyframe.outTangent));
+				}
+
+				curve.numKeys = (UINT32)keyframes.size();
+				curve.valueMin = minValue;
+				curve.valueScale = (maxValue - minValue) / MAX_QUANTIZED_UNSIGNED;
+				curve.tangentScale = maxTangent / MAX_QUANTIZED_SIGNED;
+
+				mCurves.push_back(curve);
+
+				for (auto& keyframe : keyframes)
+				{
+					CompressedKeyframe key;
+					key.time = quantizeUnsigned(keyframe.time - mStart, timeScale);
+					key.value = quantizeUnsigned(keyframe.value - curve.valueMin, curve.valueScale);
+					key.inTangent = quantizeSigned(keyframe.inTangent, curve.tangentScale);
+					key.outTangent = quantizeSigned(keyframe.outTangent, curve.tangentScale);
+
+					mKeys.push_back(key);
+				}
+			}
+		}
+	}
+
+	void AnimationClip::evaluateCurves(float time, bool loop, UINT32* keyCache, float* output) const
+	{
+		// Map the time to the quantized time range of the keys
+		float quantizedTime = 0.0f;
+		if (mLength > 0.0f)
+		{
+			time -= mStart;
+
+			if (loop)
+			{
+				time = std::fmod(time, mLength);
+				if (time < 0.0f)
+					time += mLength;
+			}
+
+			quantizedTime = Math::clamp(time, 0.0f, mLength) * (MAX_QUANTIZED_UNSIGNED / mLength);
+		}
+
+		const Float4 time4 = set4(quantizedTime);
+		const Float4 timeScale4 = set4(mLength / MAX_QUANTIZED_UNSIGNED);
+		const Float4 zero4 = set4(0.0f);
+		const Float4 one4 = set4(1.0f);
+		const Float4 two4 = set4(2.0f);
+		const Float4 three4 = set4(3.0f);
+
+		UINT32 numCurves = (UINT32)mCurves.size();
+		for (UINT32 i = 0; i < numCurves; i += 4)
+		{
+			// Find the segment each of the four curves is evaluated in, and gather the keys (still quantized)
+			float lhsTime[4], rhsTime[4];
+			float lhsValue[4], rhsValue[4];
+			float lhsTangent[4], rhsTangent[4];
+			float valueMin[4], valueScale[4], tangentScale[4];
+
+			UINT32 numLanes = std::min(4U, numCurves - i);
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				if (j >= numLanes)
+				{
+					lhsTime[j] = rhsTime[j] = 0.0f;
+					lhsValue[j] = rhsValue[j] = lhsTangent[j] = rhsTangent[j] = 0.0f;
+					valueMin[j] = valueScale[j] = tangentScale[j] = 0.0f;
+					continue;
+				}
+
+				UINT32 curveIdx = i + j;
+				const CompressedCurve& curve = mCurves[curveIdx];
+				const CompressedKeyframe* keys = &mKeys[curve.firstKey];
+
+				// Outside of the key range both ends of the segment are the same key, evaluating to its value
+				UINT32 lhs, rhs;
+				if (quantizedTime <= keys[0].time)
+					lhs = rhs = 0;
+				else if (quantizedTime >= keys[curve.numKeys - 1].time)
+					lhs = rhs = curve.numKeys - 1;
+				else
+				{
+					lhs = findKey(keys, curve.numKeys, quantizedTime, keyCache[curveIdx]);
+					rhs = lhs + 1;
+
+					keyCache[curveIdx] = lhs;
+				}
+
+				// Single key segments are moved to the evaluation time, so they evaluate exactly to the key value
+				if (lhs != rhs)
+				{
+					lhsTime[j] = keys[lhs].time;
+					rhsTime[j] = keys[rhs].time;
+				}
+				else
+					lhsTime[j] = rhsTime[j] = quantizedTime;
+
+				lhsValue[j] = keys[lhs].value;
+				rhsValue[j] = keys[rhs].value;
+				lhsTangent[j] = keys[lhs].outTangent;
+				rhsTangent[j] = keys[rhs].inTangent;
+				valueMin[j] = curve.valueMin;
+				valueScale[j] = curve.valueScale;
+				tangentScale[j] = curve.tangentScale;
+			}
+
+			// Dequantize the keys and evaluate the cubic hermite segments
+			Float4 start = load4(lhsTime);
+			Float4 length = sub4(load4(rhsTime), start);
+			Float4 t = div4(sub4(time4, start), max4(length, one4));
+			t = min4(max4(t, zero4), one4);
+
+			Float4 t2 = mul4(t, t);
+			Float4 t3 = mul4(t2, t);
+
+			Float4 h01 = sub4(mul4(three4, t2), mul4(two4, t3));
+			Float4 h00 = sub4(one4, h01);
+			Float4 h11 = sub4(t3, t2);
+			Float4 h10 = add4(sub4(h11, t2), t);
+
+			Float4 min = load4(valueMin);
+			Float4 scale = load4(valueScale);
+			Float4 lhsVal = add4(min, mul4(load4(lhsValue), scale));
+			Float4 rhsVal = add4(min, mul4(load4(rhsValue), scale));
+
+			// Tangents are in units per second, scale them to the length of the segment
+			Float4 tangentToSegment = mul4(load4(tangentScale), mul4(length, timeScale4));
+			Float4 lhsTan = mul4(load4(lhsTangent), tangentToSegment);
+			Float4 rhsTan = mul4(load4(rhsTangent), tangentToSegment);
+
+			Float4 result = add4(add4(mul4(h00, lhsVal), mul4(h10, lhsTan)), add4(mul4(h01, rhsVal), mul4(h11, rhsTan)));
+
+			if (numLanes == 4)
+				store4(output + i, result);
+			else
+			{
+				float values[4];
+				store4(values, result);
+
+				for (UINT32 j = 0; j < numLanes; j++)
+					output[i + j] = values[j];
+			}
+		}
+	}
+
+	void AnimationClip::evaluate(AnimationClipState& state)
+	{
+		if (state.clip == nullptr)
+			return;
+
+		const AnimationClip& clip = *state.clip;
+
+		UINT32 numBones = clip.getNumBones();
+		UINT32 numCurves = (UINT32)clip.mCurves.size();
+
+		if (state.bones.size() != numBones)
+			state.bones.resize(numBones);
+
+		if (state.keyCache.size() != numCurves)
+			state.keyCache.assign(numCurves, 0);
+
+		if (numBones == 0)
+			return;
+
+		clip.evaluateCurves(state.time, state.loop, state.keyCache.data(), (float*)state.bones.data());
+
+		// Interpolated quaternions are no longer unit length
+		for (auto& bone : state.bones)
+		{
+			if (bone.rotation.dot(bone.rotation) > 0.0f)
+				bone.rotation.normalize();
+			else
+				bone.rotation = Quaternion::IDENTITY;
+		}
+	}
+
+	void AnimationClip::evaluate(AnimationClipState* states, UINT32 count)
+	{
+		UINT32 numTasks = TaskScheduler::getNumTasks(count, MIN_STATES_PER_TASK);
+		TaskScheduler::runParallel("AnimationEvaluation", count, numTasks, [states](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i++)
+				evaluate(states[i]);
+		});
+	}
+
+	HAnimationClip AnimationClip::create(const Vector<BoneAnimationCurves>& bones)
+	{
+		return static_resource_cast<AnimationClip>(gResources()._createResourceHandle(_createPtr(bones)));
+	}
+
+	SPtr<AnimationClip> AnimationClip::_createPtr(const Vector<BoneAnimationCurves>& bones)
+	{
+		AnimationClip* rawPtr = new (bs_alloc<AnimationClip>()) AnimationClip(bones);
+
+		SPtr<AnimationClip> newClip = bs_core_ptr<AnimationClip>(rawPtr);
+		newClip->_setThisPtr(newClip);
+		newClip->initialize();
+
+		return newClip;
+	}
+
+	SPtr<AnimationClip> AnimationClip::createEmpty()
+	{
+		AnimationClip* rawPtr = new (bs_alloc<AnimationClip>()) AnimationClip();
+
+		SPtr<AnimationClip> newClip = bs_core_ptr<AnimationClip>(rawPtr);
+		newClip->_setThisPtr(newClip);
+
+		return newClip;
+	}
+
+	RTTITypeBase* AnimationClip::getRTTIStatic()
+	{
+		return AnimationClipRTTI::instance();
+	}
+
+	RTTITypeBase* AnimationClip::getRTTI() const
+	{
+		return getRTTIStatic();
+	}
+}
@@ -0,0 +1,72 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsAnimationCurve.h"
+#include "BsMath.h"
+
+namespace BansheeEngine
+{
+	AnimationCurve::AnimationCurve(const Vector<Keyframe>& keyframes)
+		:mKeyframes(keyframes)
+	{
+#if BS_DEBUG_MODE
+		for (UINT32 i = 1; i < (UINT32)mKeyframes.size(); i++)
+			assert(mKeyframes[i - 1].time <= mKeyframes[i].time);
+#endif
+
+		if (!mKeyframes.empty())
+		{
+			mStart = mKeyframes.front().time;
+			mEnd = mKeyframes.back().time;
+		}
+	}
+
+	float AnimationCurve::evaluate(float time, bool loop) const
+	{
+		if (mKeyframes.empty())
+			return 0.0f;
+
+		float length = mEnd - mStart;
+		if (loop && length > 0.0f)
+		{
+			time = std::fmod(time - mStart, length);
+			if (time < 0.0f)
+				time += length;
+
+			time += mStart;
+		}
+
+		if (time <= mStart)
+			return mKeyframes.front().value;
+
+		if (time >= mEnd)
+			return mKeyframes.back().value;
+
+		// Find the first key past the evaluation time
+		auto iterFind = std::upper_bound(mKeyframes.begin(), mKeyframes.end(), time,
+			[](float time, const Keyframe& key) { return time < key.time; });
+
+		const Keyframe& rhs = *iterFind;
+		const Keyframe& lhs = *(iterFind - 1);
+
+		return evaluate(lhs, rhs, time);
+	}
+
+	float AnimationCurve::evaluate(const Keyframe& lhs, const Keyframe& rhs, float time)
+	{
+		float delta = rhs.time - lhs.time;
+		if (delta <= 0.0f)
+			return rhs.value;
+
+		float t = (time - lhs.time) / delta;
+		float t2 = t * t;
+		float t3 = t2 * t;
+
+		// Tangents are in units per second, scale them to the length of the segment
+		float x0 = (2 * t3 - 3 * t2 + 1) * lhs.value;
+		float x1 = (t3 - 2 * t2 + t) * lhs.outTangent * delta;
+		float x2 = (-2 * t3 + 3 * t2) * rhs.value;
+		float x3 = (t3 - t2) * rhs.inTangent * delta;
+
+		return x0 + x1 + x2 + x3;
+	}
+}
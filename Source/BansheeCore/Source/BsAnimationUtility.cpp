@@ -0,0 +1,117 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsAnimationUtility.h"
+#include "BsQuaternion.h"
+
+namespace BansheeEngine
+{
+	void AnimationUtility::eulerToQuaternionCurves(const AnimationCurve(&eulerCurves)[3], AnimationCurve(&quatCurves)[4])
+	{
+		// Position of the extra samples within each segment, used for approximating tangents
+		const float FIT_TIME = 0.33f;
+
+		const Vector<Keyframe>& eulerKeys = eulerCurves[0].getKeyFrames();
+		UINT32 numKeys = (UINT32)eulerKeys.size();
+
+		if (numKeys != (UINT32)eulerCurves[1].getKeyFrames().size() || 
+			numKeys != (UINT32)eulerCurves[2].getKeyFrames().size())
+			return;
+
+		auto eulerToQuaternion = [&](float time, const Quaternion* lastQuat)
+		{
+			Degree x(eulerCurves[0].evaluate(time, false));
+			Degree y(eulerCurves[1].evaluate(time, false));
+			Degree z(eulerCurves[2].evaluate(time, false));
+
+			Quaternion quat(x, y, z);
+
+			// Flip quaternion in case rotation is over 180 degrees
+			if (lastQuat != nullptr && quat.dot(*lastQuat) < 0.0f)
+				quat = -quat;
+
+			return quat;
+		};
+
+		struct FitKeyframe
+		{
+			float time;
+			Quaternion value;
+		};
+
+		// Each segment between two keys is sampled twice, at the start and the end fit time. Every sample is compared
+		// against the one immediately before it, so the sign stays consistent across the entire curve.
+		Vector<Quaternion> keyQuats(numKeys);
+		Vector<FitKeyframe> fitQuats(numKeys > 0 ? (numKeys - 1) * 2 : 0);
+
+		const Quaternion* lastQuat = nullptr;
+		for (UINT32 i = 0; i < numKeys; i++)
+		{
+			float time = eulerKeys[i].time;
+			keyQuats[i] = eulerToQuaternion(time, lastQuat);
+			lastQuat = &keyQuats[i];
+
+			if ((i + 1) < numKeys)
+			{
+				float dt = eulerKeys[i + 1].time - time;
+
+				FitKeyframe& fitStart = fitQuats[i * 2 + 0];
+				FitKeyframe& fitEnd = fitQuats[i * 2 + 1];
+
+				fitStart.time = time + dt * FIT_TIME;
+				fitStart.value = eulerToQuaternion(fitStart.time, lastQuat);
+
+				fitEnd.time = time + dt * (1.0f - FIT_TIME);
+				fitEnd.value = eulerToQuaternion(fitEnd.time, &fitStart.value);
+
+				lastQuat = &fitEnd.value;
+			}
+		}
+
+		// TODO - There must be an analytical way to convert euler angle tangents to quaternion tangents. Instead the 
+		// tangents are approximated from the extra samples around each key.
+		auto getSlope = [](float time0, float value0, float time1, float value1)
+		{
+			float dt = time1 - time0;
+			if (dt <= 0.0f)
+				return 0.0f;
+
+			return (value1 - value0) / dt;
+		};
+
+		for (UINT32 j = 0; j < 4; j++)
+		{
+			Vector<Keyframe> keyframes(numKeys);
+			for (UINT32 i = 0; i < numKeys; i++)
+			{
+				Keyframe& keyframe = keyframes[i];
+				keyframe.time = eulerKeys[i].time;
+				keyframe.value = keyQuats[i][j];
+
+				float slope = 0.0f;
+				UINT32 numSlopes = 0;
+
+				if (i > 0)
+				{
+					const FitKeyframe& fitPrev = fitQuats[i * 2 - 1];
+					slope += getSlope(fitPrev.time, fitPrev.value[j], keyframe.time, keyframe.value);
+					numSlopes++;
+				}
+
+				if ((i + 1) < numKeys)
+				{
+					const FitKeyframe& fitNext = fitQuats[i * 2];
+					slope += getSlope(keyframe.time, keyframe.value, fitNext.time, fitNext.value[j]);
+					numSlopes++;
+				}
+
+				if (numSlopes > 0)
+					slope /= (float)numSlopes;
+
+				keyframe.inTangent = slope;
+				keyframe.outTangent = slope;
+			}
+
+			quatCurves[j] = AnimationCurve(keyframes);
+		}
+	}
+}
@@ -12,7 +12,7 @@ namespace BansheeEngine
 		:mMyThreadId(threadId), mMaxDebugIdx(0)
 	{
 		mAsyncOpSyncData = bs_shared_ptr_new<AsyncOpSyncData>();
-		mCommands = bs_new<BansheeEngine::Queue<QueuedCommand>>();
+		mCommands = bs_new<QueuedCommandList, CoreThreadAlloc>();
 
 		{
 			Lock lock(CommandQueueBreakpointMutex);
@@ -25,63 +25,66 @@ namespace BansheeEngine
 		:mMyThreadId(threadId)
 	{
 		mAsyncOpSyncData = bs_shared_ptr_new<AsyncOpSyncData>();
-		mCommands = bs_new<BansheeEngine::Queue<QueuedCommand>>();
+		mCommands = bs_new<QueuedCommandList, CoreThreadAlloc>();
 	}
 #endif
 
 	CommandQueueBase::~CommandQueueBase()
 	{
 		if(mCommands != nullptr)
-			bs_delete(mCommands);
+			bs_delete<QueuedCommandList, CoreThreadAlloc>(mCommands);
 
 		while(!mEmptyCommandQueues.empty())
 		{
-			bs_delete(mEmptyCommandQueues.top());
+			bs_delete<QueuedCommandList, CoreThreadAlloc>(mEmptyCommandQueues.top());
 			mEmptyCommandQueues.pop();
 		}
 	}
 
-	AsyncOp CommandQueueBase::queueReturn(std::function<void(AsyncOp&)> commandCallback, bool _notifyWhenComplete, UINT32 _callbackId)
+	AsyncOp CommandQueueBase::queueReturn(CommandCallback<void(AsyncOp&)> commandCallback, bool _notifyWhenComplete, 
+		UINT32 _callbackId)
 	{
 #if BS_DEBUG_MODE
 		breakIfNeeded(mCommandQueueIdx, mMaxDebugIdx);
 
-		QueuedCommand newCommand(commandCallback, mMaxDebugIdx++, mAsyncOpSyncData, _notifyWhenComplete, _callbackId);
+		QueuedCommand newCommand(std::move(commandCallback), mMaxDebugIdx++, mAsyncOpSyncData, _notifyWhenComplete, 
+			_callbackId);
 #else
-		QueuedCommand newCommand(commandCallback, mAsyncOpSyncData, _notifyWhenComplete, _callbackId);
+		QueuedCommand newCommand(std::move(commandCallback), mAsyncOpSyncData, _notifyWhenComplete, _callbackId);
 #endif
 
-		mCommands->push(newCommand);
+		AsyncOp asyncOp = newCommand.asyncOp;
+		mCommands->push(std::move(newCommand));
 
 #if BS_FORCE_SINGLETHREADED_RENDERING
-		Queue<QueuedCommand>* commands = flush();
+		QueuedCommandList* commands = flush();
 		playback(commands);
 #endif
 
-		return newCommand.asyncOp;
+		return asyncOp;
 	}
 
-	void CommandQueueBase::queue(std::function<void()> commandCallback, bool _notifyWhenComplete, UINT32 _callbackId)
+	void CommandQueueBase::queue(CommandCallback<void()> commandCallback, bool _notifyWhenComplete, UINT32 _callbackId)
 	{
 #if BS_DEBUG_MODE
 		breakIfNeeded(mCommandQueueIdx, mMaxDebugIdx);
 
-		QueuedCommand newCommand(commandCallback, mMaxDebugIdx++, _notifyWhenComplete, _callbackId);
+		QueuedCommand newCommand(std::move(commandCallback), mMaxDebugIdx++, _notifyWhenComplete, _callbackId);
 #else
-		QueuedCommand newCommand(commandCallback, _notifyWhenComplete, _callbackId);
+		QueuedCommand newCommand(std::move(commandCallback), _notifyWhenComplete, _callbackId);
 #endif
 
-		mCommands->push(newCommand);
+		mCommands->push(std::move(newCommand));
 
 #if BS_FORCE_SINGLETHREADED_RENDERING
-		Queue<QueuedCommand>* commands = flush();
+		QueuedCommandList* commands = flush();
 		playback(commands);
 #endif
 	}
 
-	BansheeEngine::Queue<QueuedCommand>* CommandQueueBase::flush()
+	QueuedCommandList* CommandQueueBase::flush()
 	{
-		BansheeEngine::Queue<QueuedCommand>* oldCommands = mCommands;
+		QueuedCommandList* oldCommands = mCommands;
 
 		if(!mEmptyCommandQueues.empty())
 		{
@@ -90,13 +93,13 @@ namespace BansheeEngine
 		}
 		else
 		{
-			mCommands = bs_new<BansheeEngine::Queue<QueuedCommand>>();
+			mCommands = bs_new<QueuedCommandList, CoreThreadAlloc>();
 		}
 
 		return oldCommands;
 	}
 
-	void CommandQueueBase::playbackWithNotify(BansheeEngine::Queue<QueuedCommand>* commands, std::function<void(UINT32)> notifyCallback)
+	void CommandQueueBase::playbackWithNotify(QueuedCommandList* commands, std::function<void(UINT32)> notifyCallback)
 	{
 		THROW_IF_NOT_CORE_THREAD;
 
@@ -135,14 +138,14 @@ namespace BansheeEngine
 		mEmptyCommandQueues.push(commands);
 	}
 
-	void CommandQueueBase::playback(BansheeEngine::Queue<QueuedCommand>* commands)
+	void CommandQueueBase::playback(QueuedCommandList* commands)
 	{
 		playbackWithNotify(commands, std::function<void(UINT32)>());
 	}
 
 	void CommandQueueBase::cancelAll()
 	{
-		BansheeEngine::Queue<QueuedCommand>* commands = flush();
+		QueuedCommandList* commands = flush();
 
 		while(!commands->empty())
 			commands->pop();
@@ -49,8 +49,10 @@
 namespace BansheeEngine
 {
 	CoreApplication::CoreApplication(START_UP_DESC desc)
-		: mPrimaryWindow(nullptr), mStartUpDesc(desc), mFrameStep(16666), mLastFrameTime(0), mRendererPlugin(nullptr)
-		, mIsFrameRenderingFinished(true), mSimThreadId(BS_THREAD_CURRENT_ID), mRunMainLoop(false)
+		: mPrimaryWindow(nullptr), mStartUpDesc(desc), mFrameStep(16666), mLastFrameTime(0)
+		, mFrameLimiterSpinTime(0), mRenderingEnabled(true), mRendererPlugin(nullptr)
+		, mNumFramesInFlight(0), mMaxFramesInFlight(1), mSimThreadId(BS_THREAD_CURRENT_ID), mAdaptiveFrameStart(false)
+		, mFrameStartDelay(0), mLastFrameStartTime(0), mCoreFrameStartTime(0), mRunMainLoop(false)
 	{ }
 
 	CoreApplication::~CoreApplication()
@@ -172,31 +174,17 @@ namespace BansheeEngine
 			// Limit FPS if needed
 			if (mFrameStep > 0)
 			{
-				UINT64 currentTime = gTime().getTimePrecise();
 				UINT64 nextFrameTime = mLastFrameTime + mFrameStep;
-				while (nextFrameTime > currentTime)
-				{
-					UINT32 waitTime = (UINT32)(nextFrameTime - currentTime);
-
-					// If waiting for longer, sleep
-					if (waitTime >= 2000)
-					{
-						Platform::sleep(waitTime / 1000);
-						currentTime = gTime().getTimePrecise();
-					}
-					else
-					{
-						// Otherwise we just spin, sleep timer granularity is too low and we might end up wasting a 
-						// millisecond otherwise. 
-						// Note: For mobiles where power might be more important than input latency, consider using sleep.
-						while(nextFrameTime > currentTime)
-							currentTime = gTime().getTimePrecise();
-					}
-				}
-
-				mLastFrameTime = currentTime;
+				mLastFrameTime = waitUntil(nextFrameTime);
 			}
 
+			// Delay the frame so the simulation finishes right as the core thread is ready to accept it. This results in
+			// input being sampled as late as possible.
+			if (mFrameStartDelay > 0)
+				waitUntil(gTime().getTimePrecise() + mFrameStartDelay);
+
+			UINT64 frameStartTime = gTime().getTimePrecise();
+
 			gProfilerCPU().beginThread("Sim");
 
 			Platform::_update();
@@ -213,6 +201,13 @@ namespace BansheeEngine
 
 			preUpdate();
 
+			// Fixed updates run at a constant rate independent of the frame rate, zero or more times per frame
+			UINT32 numFixedUpdates = gTime()._getNumFixedUpdates();
+			for (UINT32 i = 0; i < numFixedUpdates; i++)
+			{
+				PROFILE_CALL(gCoreSceneManager()._fixedUpdate(), "SceneManager (fixed)");
+			}
+
 			PROFILE_CALL(gCoreSceneManager()._update(), "SceneManager");
 			gPhysics().update();
 
@@ -226,32 +221,41 @@ namespace BansheeEngine
 			ResourceListenerManager::instance().update();
 
 			gCoreSceneManager()._updateCoreObjectTransforms();
-			PROFILE_CALL(RendererManager::instance().getActive()->renderAll(), "Render");
 
-			// Core and sim thread run in lockstep. This will result in a larger input latency than if I was 
-			// running just a single thread. Latency becomes worse if the core thread takes longer than sim 
-			// thread, in which case sim thread needs to wait. Optimal solution would be to get an average 
-			// difference between sim/core thread and start the sim thread a bit later so they finish at nearly the same time.
+			if (mRenderingEnabled)
+			{
+				PROFILE_CALL(RendererManager::instance().getActive()->renderAll(), "Render");
+			}
+
+			UINT64 simEndTime = gTime().getTimePrecise();
+
+			// Sim thread is allowed to run ahead of the core thread by a limited number of frames. With a single frame 
+			// in flight this results in lower input latency, but the sim thread needs to wait if the core thread takes 
+			// longer. Adaptive frame start reduces this latency further, while allowing more frames in flight improves
+			// throughput.
 			{
 				Lock lock(mFrameRenderingFinishedMutex);
 
-				while(!mIsFrameRenderingFinished)
+				while(mNumFramesInFlight >= mMaxFramesInFlight)
 				{
 					TaskScheduler::instance().addWorker();
 					mFrameRenderingFinishedCondition.wait(lock);
 					TaskScheduler::instance().removeWorker();
 				}
 
-				mIsFrameRenderingFinished = false;
+				mNumFramesInFlight++;
 			}
 
+			UINT64 waitEndTime = gTime().getTimePrecise();
+			updateFrameTiming(frameStartTime, simEndTime, waitEndTime);
+
 			gCoreThread().queueCommand(std::bind(&CoreApplication::beginCoreProfiling, this));
 			gCoreThread().queueCommand(&Platform::_coreUpdate);
 
 			gCoreThread().update(); 
 			gCoreThread().submitAccessors(); 
 
-			gCoreThread().queueCommand(std::bind(&CoreApplication::frameRenderingFinishedCallback, this));
+			gCoreThread().queueCommand(std::bind(&CoreApplication::frameRenderingFinishedCallback, this, frameStartTime));
 
 			gCoreThread().queueCommand(std::bind(&RenderWindowCoreManager::_update, RenderWindowCoreManager::instancePtr()));
 			gCoreThread().queueCommand(std::bind(&QueryManager::_update, QueryManager::instancePtr()));
@@ -265,7 +269,7 @@ namespace BansheeEngine
 		{
 			Lock lock(mFrameRenderingFinishedMutex);
 
-			while (!mIsFrameRenderingFinished)
+			while (mNumFramesInFlight > 0)
 			{
 				TaskScheduler::instance().addWorker();
 				mFrameRenderingFinishedCondition.wait(lock);
@@ -274,6 +278,81 @@ namespace BansheeEngine
 		}
 	}
 
+	UINT64 CoreApplication::waitUntil(UINT64 time)
+	{
+		UINT64 currentTime = gTime().getTimePrecise();
+		while (time > currentTime)
+		{
+			UINT64 waitTime = time - currentTime;
+
+			// Sleep for as much of the wait as possible. High resolution waits are precise enough that there's normally 
+			// no need to spin, which wastes power (important on laptops, mobiles and servers running many instances).
+			if (waitTime > mFrameLimiterSpinTime)
+			{
+				Platform::sleepPrecise(waitTime - mFrameLimiterSpinTime);
+				currentTime = gTime().getTimePrecise();
+			}
+			else
+			{
+				// Spin for the remainder, if allowed, to make up for the OS timer imprecision
+				while(time > currentTime)
+					currentTime = gTime().getTimePrecise();
+			}
+		}
+
+		return currentTime;
+	}
+
+	void CoreApplication::updateFrameTiming(UINT64 frameStartTime, UINT64 simEndTime, UINT64 waitEndTime)
+	{
+		// Time the sim thread should still be left waiting, to account for variance in frame times
+		static const INT64 FRAME_START_MARGIN = 1000;
+
+		// Maximum delay, to ensure we don't stall the application due to some outlier frames
+		static const INT64 MAX_FRAME_START_DELAY = 50000;
+
+		static const float SMOOTHING = 0.1f;
+
+		UINT64 waitTime = waitEndTime - simEndTime;
+		if (mAdaptiveFrameStart && mMaxFramesInFlight == 1)
+		{
+			// Converge towards a delay which leaves the sim thread waiting just for the margin amount
+			INT64 error = (INT64)waitTime - FRAME_START_MARGIN;
+			INT64 delay = (INT64)mFrameStartDelay + error / 2;
+
+			mFrameStartDelay = (UINT64)std::min(std::max(delay, (INT64)0), MAX_FRAME_START_DELAY);
+		}
+		else
+			mFrameStartDelay = 0;
+
+		float frameInterval = 0.0f;
+		if (mLastFrameStartTime > 0)
+			frameInterval = (frameStartTime - mLastFrameStartTime) / 1000.0f;
+
+		mLastFrameStartTime = frameStartTime;
+
+		Lock lock(mFrameTimingMutex);
+		FrameTimingStats& stats = mFrameTimingStats;
+
+		stats.simFrameTime += ((simEndTime - frameStartTime) / 1000.0f - stats.simFrameTime) * SMOOTHING;
+		stats.simWaitTime += (waitTime / 1000.0f - stats.simWaitTime) * SMOOTHING;
+		stats.frameStartDelay = mFrameStartDelay / 1000.0f;
+
+		if (frameInterval > 0.0f)
+		{
+			float deviation = fabs(frameInterval - stats.frameInterval);
+
+			stats.frameInterval += (frameInterval - stats.frameInterval) * SMOOTHING;
+			stats.frameIntervalDeviation += (deviation - stats.frameIntervalDeviation) * SMOOTHING;
+		}
+	}
+
+	FrameTimingStats CoreApplication::getFrameTimingStats() const
+	{
+		Lock lock(mFrameTimingMutex);
+		return mFrameTimingStats;
+	}
+
 	void CoreApplication::preUpdate()
 	{
 		// Do nothing
@@ -300,11 +379,28 @@ namespace BansheeEngine
 		mFrameStep = (UINT64)1000000 / limit;
 	}
 
-	void CoreApplication::frameRenderingFinishedCallback()
+	void CoreApplication::setMaxFramesInFlight(UINT32 count)
 	{
 		Lock lock(mFrameRenderingFinishedMutex);
+		mMaxFramesInFlight = std::min(std::max(count, 1U), MAX_FRAMES_IN_FLIGHT);
+	}
 
-		mIsFrameRenderingFinished = true;
+	void CoreApplication::frameRenderingFinishedCallback(UINT64 frameStartTime)
+	{
+		static const float SMOOTHING = 0.1f;
+
+		UINT64 currentTime = gTime().getTimePrecise();
+		{
+			Lock lock(mFrameTimingMutex);
+			FrameTimingStats& stats = mFrameTimingStats;
+
+			stats.coreFrameTime += ((currentTime - mCoreFrameStartTime) / 1000.0f - stats.coreFrameTime) * SMOOTHING;
+			stats.inputLatency += ((currentTime - frameStartTime) / 1000.0f - stats.inputLatency) * SMOOTHING;
+		}
+
+		Lock lock(mFrameRenderingFinishedMutex);
+
+		mNumFramesInFlight--;
 		mFrameRenderingFinishedCondition.notify_one();
 	}
 
@@ -315,6 +411,8 @@ namespace BansheeEngine
 
 	void CoreApplication::beginCoreProfiling()
 	{
+		mCoreFrameStartTime = gTime().getTimePrecise();
+
 		gProfilerCPU().beginThread("Core");
 		ProfilerGPU::instance().beginFrame();
 	}
@@ -97,6 +97,28 @@ namespace BansheeEngine
 		GameObjectManager::instance().destroyQueuedObjects();
 	}
 
+	void CoreSceneManager::_fixedUpdate()
+	{
+		Stack<HSceneObject> todo;
+		todo.push(mRootNode);
+
+		while(!todo.empty())
+		{
+			HSceneObject currentGO = todo.top();
+			todo.pop();
+
+			if (!currentGO->getActive(true))
+				continue;
+
+			const Vector<HComponent>& components = currentGO->getComponents();
+			for(auto iter = components.begin(); iter != components.end(); ++iter)
+				(*iter)->fixedUpdate();
+
+			for(UINT32 i = 0; i < currentGO->getNumChildren(); i++)
+				todo.push(currentGO->getChild(i));
+		}
+	}
+
 	void CoreSceneManager::registerNewSO(const HSceneObject& node) 
 	{ 
 		if(mRootNode)
@@ -98,7 +98,7 @@ namespace BansheeEngine
 		while(true)
 		{
 			// Wait until we get some ready commands
-			Queue<QueuedCommand>* commands = nullptr;
+			QueuedCommandList* commands = nullptr;
 			{
 				Lock lock(mCommandQueueMutex);
 
@@ -192,7 +192,7 @@ namespace BansheeEngine
 		mSyncedCoreAccessor->submitToCoreThread(blockUntilComplete);
 	}
 
-	AsyncOp CoreThread::queueReturnCommand(std::function<void(AsyncOp&)> commandCallback, bool blockUntilComplete)
+	AsyncOp CoreThread::queueReturnCommand(CommandCallback<void(AsyncOp&)> commandCallback, bool blockUntilComplete)
 	{
 		assert(BS_THREAD_CURRENT_ID != getCoreThreadId() && "Cannot queue commands on the core thread for the core thread");
 
@@ -204,10 +204,10 @@ namespace BansheeEngine
 			if(blockUntilComplete)
 			{
 				commandId = mMaxCommandNotifyId++;
-				op = mCommandQueue->queueReturn(commandCallback, true, commandId);
+				op = mCommandQueue->queueReturn(std::move(commandCallback), true, commandId);
 			}
 			else
-				op = mCommandQueue->queueReturn(commandCallback);
+				op = mCommandQueue->queueReturn(std::move(commandCallback));
 		}
 
 		mCommandReadyCondition.notify_all();
@@ -218,7 +218,7 @@ namespace BansheeEngine
 		return op;
 	}
 
-	void CoreThread::queueCommand(std::function<void()> commandCallback, bool blockUntilComplete)
+	void CoreThread::queueCommand(CommandCallback<void()> commandCallback, bool blockUntilComplete)
 	{
 		assert(BS_THREAD_CURRENT_ID != getCoreThreadId() && "Cannot queue commands on the core thread for the core thread");
 
@@ -229,10 +229,10 @@ namespace BansheeEngine
 			if(blockUntilComplete)
 			{
 				commandId = mMaxCommandNotifyId++;
-				mCommandQueue->queue(commandCallback, true, commandId);
+				mCommandQueue->queue(std::move(commandCallback), true, commandId);
 			}
 			else
-				mCommandQueue->queue(commandCallback);
+				mCommandQueue->queue(std::move(commandCallback));
 		}
 
 		mCommandReadyCondition.notify_all();
@@ -246,7 +246,7 @@ namespace BansheeEngine
 		for (UINT32 i = 0; i < NUM_FRAME_ALLOCS; i++)
 			mFrameAllocs[i]->setOwnerThread(mCoreThreadId);
 
-		mActiveFrameAlloc = (mActiveFrameAlloc + 1) % 2;
+		mActiveFrameAlloc = (mActiveFrameAlloc + 1) % NUM_FRAME_ALLOCS;
 		mFrameAllocs[mActiveFrameAlloc]->setOwnerThread(BS_THREAD_CURRENT_ID); // Sim thread
 		mFrameAllocs[mActiveFrameAlloc]->clear();
 	}
@@ -28,19 +28,19 @@ namespace BansheeEngine
 		bs_delete(mCommandQueue);
 	}
 
-	AsyncOp CoreThreadAccessorBase::queueReturnCommand(std::function<void(AsyncOp&)> commandCallback)
+	AsyncOp CoreThreadAccessorBase::queueReturnCommand(CommandCallback<void(AsyncOp&)> commandCallback)
 	{
-		return mCommandQueue->queueReturn(commandCallback);
+		return mCommandQueue->queueReturn(std::move(commandCallback));
 	}
 
-	void CoreThreadAccessorBase::queueCommand(std::function<void()> commandCallback)
+	void CoreThreadAccessorBase::queueCommand(CommandCallback<void()> commandCallback)
 	{
-		mCommandQueue->queue(commandCallback);
+		mCommandQueue->queue(std::move(commandCallback));
 	}
 
 	void CoreThreadAccessorBase::submitToCoreThread(bool blockUntilComplete)
 	{
-		Queue<QueuedCommand>* commands = mCommandQueue->flush();
+		QueuedCommandList* commands = mCommandQueue->flush();
 
 		gCoreThread().queueCommand(std::bind(&CommandQueueBase::playback, mCommandQueue, commands), blockUntilComplete);
 	}
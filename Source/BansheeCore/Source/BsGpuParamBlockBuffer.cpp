@@ -3,15 +3,17 @@
 #include "BsGpuParamBlockBuffer.h"
 #include "BsHardwareBufferManager.h"
 #include "BsFrameAlloc.h"
+#include "BsRenderStats.h"
 
 namespace BansheeEngine
 {
 	GpuParamBlockBufferCore::GpuParamBlockBufferCore(UINT32 size, GpuParamBlockUsage usage)
-		:mUsage(usage), mSize(size), mCachedData(nullptr), mGPUBufferDirty(false)
+		:mUsage(usage), mSize(size), mCachedData(nullptr), mDirtyStart(0), mDirtyEnd(size)
 	{
 		if (mSize > 0)
 			mCachedData = (UINT8*)bs_alloc(mSize);
 
+		// Note: Entire buffer starts dirty, so the initial contents get uploaded even if never explicitly written to
 		memset(mCachedData, 0, mSize);
 	}
 
@@ -32,8 +34,12 @@ namespace BansheeEngine
 		}
 #endif
 
+		// Skip redundant writes so unchanged blocks don't get re-uploaded
+		if (memcmp(mCachedData + offset, data, size) == 0)
+			return;
+
 		memcpy(mCachedData + offset, data, size);
-		mGPUBufferDirty = true;
+		markDirty(offset, size);
 	}
 
 	void GpuParamBlockBufferCore::read(UINT32 offset, void* data, UINT32 size)
@@ -62,15 +68,31 @@ namespace BansheeEngine
 #endif
 
 		memset(mCachedData + offset, 0, size);
-		mGPUBufferDirty = true;
+		markDirty(offset, size);
 	}
 
 	void GpuParamBlockBufferCore::flushToGPU()
 	{
-		if (mGPUBufferDirty)
+		if (mDirtyStart < mDirtyEnd)
 		{
-			writeToGPU(mCachedData);
-			mGPUBufferDirty = false;
+			writeRangeToGPU(mCachedData, mDirtyStart, mDirtyEnd - mDirtyStart);
+
+			mDirtyStart = 0;
+			mDirtyEnd = 0;
+		}
+	}
+
+	void GpuParamBlockBufferCore::markDirty(UINT32 offset, UINT32 size)
+	{
+		if (mDirtyStart < mDirtyEnd)
+		{
+			mDirtyStart = std::min(mDirtyStart, offset);
+			mDirtyEnd = std::max(mDirtyEnd, offset + size);
+		}
+		else
+		{
+			mDirtyStart = offset;
+			mDirtyEnd = offset + size;
 		}
 	}
 
@@ -181,6 +203,15 @@ namespace BansheeEngine
 	void GenericGpuParamBlockBufferCore::writeToGPU(const UINT8* data)
 	{
 		memcpy(mData, data, mSize);
+
+		BS_ADD_RENDER_STAT(NumGpuParamBytesUploaded, mSize);
+	}
+
+	void GenericGpuParamBlockBufferCore::writeRangeToGPU(const UINT8* data, UINT32 offset, UINT32 size)
+	{
+		memcpy(mData + offset, data + offset, size);
+
+		BS_ADD_RENDER_STAT(NumGpuParamBytesUploaded, size);
 	}
 
 	void GenericGpuParamBlockBufferCore::readFromGPU(UINT8* data) const
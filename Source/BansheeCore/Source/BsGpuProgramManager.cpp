@@ -2,6 +2,10 @@
 //**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
 #include "BsGpuProgramManager.h"
 #include "BsRenderAPI.h"
+#include "BsFileSystem.h"
+#include "BsDataStream.h"
+#include "BsTimer.h"
+#include "BsDebug.h"
 
 namespace BansheeEngine 
 {
@@ -56,6 +60,9 @@ namespace BansheeEngine
 		}
 	};
 
+	const UINT32 GpuProgramCoreManager::CACHE_FILE_MAGIC = 0x43504742; // "BGPC"
+	const UINT32 GpuProgramCoreManager::CACHE_FILE_VERSION = 1;
+
 	SPtr<GpuProgram> GpuProgramManager::create(const String& source, const String& entryPoint, const String& language,
 		GpuProgramType gptype, GpuProgramProfile profile,
 		bool requiresAdjacencyInformation)
@@ -136,4 +143,310 @@ namespace BansheeEngine
 
 		return ret;
 	}
+
+	void GpuProgramCoreManager::setCacheFolder(const Path& folder)
+	{
+		Lock lock(mCacheMutex);
+		mCacheFolder = folder;
+	}
+
+	Path GpuProgramCoreManager::getCacheFolder() const
+	{
+		Lock lock(mCacheMutex);
+		return mCacheFolder;
+	}
+
+	void GpuProgramCoreManager::clearCache()
+	{
+		Path cacheFolder = getCacheFolder();
+		if (cacheFolder.isEmpty() || !FileSystem::exists(cacheFolder))
+			return;
+
+		Vector<Path> files;
+		Vector<Path> directories;
+		FileSystem::getChildren(cacheFolder, files, directories);
+
+		for (auto& file : files)
+			FileSystem::remove(file);
+	}
+
+	GpuProgramCacheStats GpuProgramCoreManager::getCacheStats() const
+	{
+		Lock lock(mCacheMutex);
+		return mCacheStats;
+	}
+
+	bool GpuProgramCoreManager::precompile(const String& source, const String& entryPoint, const String& language,
+		GpuProgramType gptype, GpuProgramProfile profile, bool requiresAdjacency)
+	{
+		UINT64 sourceHash = 0;
+		UINT64 key = getCacheKey(language, source, entryPoint, gptype, profile, requiresAdjacency, sourceHash);
+		if (key == 0)
+			return false;
+
+		{
+			Lock lock(mCacheMutex);
+
+			auto iterFind = mPrecompiledBinaries.find(key);
+			if (iterFind != mPrecompiledBinaries.end())
+			{
+				iterFind->second.refCount++;
+				return true;
+			}
+		}
+
+		// Already compiled during some previous run
+		Path path = getCachePath(key);
+		if (!path.isEmpty())
+		{
+			Vector<UINT8> binary;
+			if (readCacheFile(path, sourceHash, (UINT32)source.size(), binary))
+				return true;
+		}
+
+		Timer timer;
+
+		Vector<UINT8> binary;
+		bool compiled = getFactory(language)->compileBinary(source, entryPoint, gptype, profile, requiresAdjacency, 
+			binary) && !binary.empty();
+
+		UINT64 compileTime = timer.getMicroseconds();
+
+		if (compiled && !path.isEmpty())
+			writeCacheFile(path, sourceHash, (UINT32)source.size(), binary.data(), (UINT32)binary.size());
+
+		Lock lock(mCacheMutex);
+
+		// Program itself is counted once it gets created from the binary
+		mCacheStats.compileTimeUs += compileTime;
+
+		// Let the program report the error when it gets created
+		if (!compiled)
+			return false;
+
+		PrecompiledBinary& entry = mPrecompiledBinaries[key];
+		entry.refCount++;
+
+		if (entry.data.empty())
+			entry.data = std::move(binary);
+
+		return true;
+	}
+
+	void GpuProgramCoreManager::releasePrecompiled(const String& source, const String& entryPoint, 
+		const String& language, GpuProgramType gptype, GpuProgramProfile profile, bool requiresAdjacency)
+	{
+		UINT64 sourceHash = 0;
+		UINT64 key = getCacheKey(language, source, entryPoint, gptype, profile, requiresAdjacency, sourceHash);
+		if (key == 0)
+			return;
+
+		Lock lock(mCacheMutex);
+
+		auto iterFind = mPrecompiledBinaries.find(key);
+		if (iterFind == mPrecompiledBinaries.end())
+			return;
+
+		if (iterFind->second.refCount > 1)
+			iterFind->second.refCount--;
+		else
+			mPrecompiledBinaries.erase(iterFind);
+	}
+
+	bool GpuProgramCoreManager::_findCachedBinary(const String& language, const GpuProgramCore& program, 
+		Vector<UINT8>& output, bool& compiled)
+	{
+		compiled = false;
+
+		const GpuProgramProperties& props = program.getProperties();
+
+		UINT64 sourceHash = 0;
+		UINT64 key = getCacheKey(language, props.getSource(), props.getEntryPoint(), props.getType(), props.getProfile(),
+			program.isAdjacencyInfoRequired(), sourceHash);
+
+		if (key == 0)
+			return false;
+
+		{
+			Lock lock(mCacheMutex);
+
+			// Binary stays around until released by whoever precompiled it, as multiple programs might share it
+			auto iterFind = mPrecompiledBinaries.find(key);
+			if (iterFind != mPrecompiledBinaries.end())
+			{
+				PrecompiledBinary& entry = iterFind->second;
+				output = entry.data;
+
+				compiled = !entry.isCounted;
+				entry.isCounted = true;
+
+				return true;
+			}
+		}
+
+		Path path = getCachePath(key);
+		if (path.isEmpty())
+			return false;
+
+		return readCacheFile(path, sourceHash, (UINT32)props.getSource().size(), output);
+	}
+
+	void GpuProgramCoreManager::_cacheBinary(const String& language, const GpuProgramCore& program, const UINT8* data, 
+		UINT32 size)
+	{
+		if (data == nullptr || size == 0)
+			return;
+
+		const GpuProgramProperties& props = program.getProperties();
+
+		UINT64 sourceHash = 0;
+		UINT64 key = getCacheKey(language, props.getSource(), props.getEntryPoint(), props.getType(), props.getProfile(),
+			program.isAdjacencyInfoRequired(), sourceHash);
+
+		if (key == 0)
+			return;
+
+		Path path = getCachePath(key);
+		if (path.isEmpty())
+			return;
+
+		writeCacheFile(path, sourceHash, (UINT32)props.getSource().size(), data, size);
+	}
+
+	void GpuProgramCoreManager::_notifyProgramCreated(UINT64 time, bool fromCache)
+	{
+		Lock lock(mCacheMutex);
+
+		if (fromCache)
+		{
+			mCacheStats.numHits++;
+			mCacheStats.loadTimeUs += time;
+		}
+		else
+		{
+			mCacheStats.numMisses++;
+			mCacheStats.compileTimeUs += time;
+		}
+	}
+
+	UINT64 GpuProgramCoreManager::getCacheKey(const String& language, const String& source, const String& entryPoint,
+		GpuProgramType gptype, GpuProgramProfile profile, bool requiresAdjacency, UINT64& sourceHash)
+	{
+		String binaryVersion = getFactory(language)->getBinaryVersion();
+		if (binaryVersion.empty())
+			return 0;
+
+		UINT32 type = (UINT32)gptype;
+		UINT32 profileIdx = (UINT32)profile;
+		UINT32 adjacency = requiresAdjacency ? 1 : 0;
+
+		// Source is expected to already have its defines applied (e.g. by the BSL compiler), so it covers those as well
+		sourceHash = hash(source.data(), (UINT32)source.size(), 0xcbf29ce484222325ULL);
+
+		UINT64 key = sourceHash;
+		key = hash(entryPoint.data(), (UINT32)entryPoint.size(), key);
+		key = hash(language.data(), (UINT32)language.size(), key);
+		key = hash(binaryVersion.data(), (UINT32)binaryVersion.size(), key);
+		key = hash(&type, sizeof(type), key);
+		key = hash(&profileIdx, sizeof(profileIdx), key);
+		key = hash(&adjacency, sizeof(adjacency), key);
+
+		// Zero is reserved for programs that can't be cached
+		if (key == 0)
+			key = 1;
+
+		return key;
+	}
+
+	Path GpuProgramCoreManager::getCachePath(UINT64 key) const
+	{
+		Path cacheFolder = getCacheFolder();
+		if (cacheFolder.isEmpty())
+			return Path::BLANK;
+
+		Path path = cacheFolder;
+		path.setFilename(toString(key, 16, '0', std::ios::hex) + ".gpuprog");
+
+		return path;
+	}
+
+	bool GpuProgramCoreManager::readCacheFile(const Path& path, UINT64 sourceHash, UINT32 sourceSize, 
+		Vector<UINT8>& output)
+	{
+		if (!FileSystem::isFile(path))
+			return false;
+
+		SPtr<DataStream> stream = FileSystem::openFile(path);
+		if (stream == nullptr)
+			return false;
+
+		// Header: magic, file version, source hash, source size and binary size
+		UINT32 magic = 0;
+		UINT32 version = 0;
+		UINT64 storedSourceHash = 0;
+		UINT32 storedSourceSize = 0;
+		UINT32 binarySize = 0;
+
+		stream->read(&magic, sizeof(magic));
+		stream->read(&version, sizeof(version));
+		stream->read(&storedSourceHash, sizeof(storedSourceHash));
+		stream->read(&storedSourceSize, sizeof(storedSourceSize));
+		stream->read(&binarySize, sizeof(binarySize));
+
+		// File names are hashes too, so make sure this is the program we're looking for, and not just a collision or a
+		// partially written file
+		bool isValid = magic == CACHE_FILE_MAGIC && version == CACHE_FILE_VERSION && storedSourceHash == sourceHash &&
+			storedSourceSize == sourceSize && binarySize > 0;
+
+		if (isValid)
+		{
+			output.resize(binarySize);
+			isValid = stream->read(output.data(), binarySize) == binarySize;
+		}
+
+		stream->close();
+
+		if (!isValid)
+		{
+			output.clear();
+			return false;
+		}
+
+		return true;
+	}
+
+	void GpuProgramCoreManager::writeCacheFile(const Path& path, UINT64 sourceHash, UINT32 sourceSize, 
+		const UINT8* data, UINT32 size)
+	{
+		Path folder = path.getDirectory();
+		if (!FileSystem::exists(folder))
+			FileSystem::createDir(folder);
+
+		SPtr<DataStream> stream = FileSystem::createAndOpenFile(path);
+		if (stream == nullptr)
+		{
+			LOGWRN("Unable to write GPU program cache file: " + path.toString());
+			return;
+		}
+
+		stream->write(&CACHE_FILE_MAGIC, sizeof(CACHE_FILE_MAGIC));
+		stream->write(&CACHE_FILE_VERSION, sizeof(CACHE_FILE_VERSION));
+		stream->write(&sourceHash, sizeof(sourceHash));
+		stream->write(&sourceSize, sizeof(sourceSize));
+		stream->write(&size, sizeof(size));
+		stream->write(data, size);
+		stream->close();
+	}
+
+	UINT64 GpuProgramCoreManager::hash(const void* data, UINT32 size, UINT64 hash)
+	{
+		const UINT8* bytes = (const UINT8*)data;
+		for (UINT32 i = 0; i < size; i++)
+		{
+			hash ^= bytes[i];
+			hash *= 0x100000001b3ULL;
+		}
+
+		return hash;
+	}
 }
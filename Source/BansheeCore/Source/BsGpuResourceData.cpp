@@ -64,7 +64,7 @@ namespace BansheeEngine
 
 		freeInternalBuffer();
 
-		mData = (UINT8*)bs_alloc(size);
+		mData = allocateBuffer(size);
 		mOwnsData = true;
 	}
 
@@ -81,7 +81,7 @@ namespace BansheeEngine
 		}
 #endif
 
-		bs_free(mData);
+		freeBuffer(mData);
 		mData = nullptr;
 	}
 
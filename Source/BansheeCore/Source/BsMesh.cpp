@@ -39,7 +39,7 @@ namespace BansheeEngine
 		mIndexBuffer = HardwareBufferCoreManager::instance().createIndexBuffer(mIndexType,
 			mProperties.mNumIndices, isDynamic ? GBU_DYNAMIC : GBU_STATIC);
 
-		mVertexData = SPtr<VertexData>(bs_new<VertexData>());
+		mVertexData = bs_shared_ptr_new<VertexData>();
 
 		mVertexData->vertexCount = mProperties.mNumVertices;
 		mVertexData->vertexDeclaration = HardwareBufferCoreManager::instance().createVertexDeclaration(mVertexDesc);
@@ -336,7 +336,7 @@ namespace BansheeEngine
 	Mesh::Mesh(UINT32 numVertices, UINT32 numIndices, const SPtr<VertexDataDesc>& vertexDesc, 
 		int usage, DrawOperationType drawOp, IndexType indexType)
 		:MeshBase(numVertices, numIndices, drawOp), mVertexDesc(vertexDesc), mUsage(usage),
-		mIndexType(indexType)
+		mIndexType(indexType), mContentVersion(0)
 	{
 
 	}
@@ -344,7 +344,7 @@ namespace BansheeEngine
 	Mesh::Mesh(UINT32 numVertices, UINT32 numIndices, const SPtr<VertexDataDesc>& vertexDesc,
 		const Vector<SubMesh>& subMeshes, int usage, IndexType indexType)
 		:MeshBase(numVertices, numIndices, subMeshes), mVertexDesc(vertexDesc), mUsage(usage), 
-		mIndexType(indexType)
+		mIndexType(indexType), mContentVersion(0)
 	{
 
 	}
@@ -352,7 +352,7 @@ namespace BansheeEngine
 	Mesh::Mesh(const SPtr<MeshData>& initialMeshData, int usage, DrawOperationType drawOp)
 		:MeshBase(initialMeshData->getNumVertices(), initialMeshData->getNumIndices(), drawOp), 
 		mCPUData(initialMeshData), mVertexDesc(initialMeshData->getVertexDesc()),
-		mUsage(usage), mIndexType(initialMeshData->getIndexType())
+		mUsage(usage), mIndexType(initialMeshData->getIndexType()), mContentVersion(0)
 	{
 
 	}
@@ -360,13 +360,13 @@ namespace BansheeEngine
 	Mesh::Mesh(const SPtr<MeshData>& initialMeshData, const Vector<SubMesh>& subMeshes, int usage)
 		:MeshBase(initialMeshData->getNumVertices(), initialMeshData->getNumIndices(), subMeshes),
 		mCPUData(initialMeshData), mVertexDesc(initialMeshData->getVertexDesc()), 
-		mUsage(usage), mIndexType(initialMeshData->getIndexType())
+		mUsage(usage), mIndexType(initialMeshData->getIndexType()), mContentVersion(0)
 	{
 
 	}
 
 	Mesh::Mesh()
-		:MeshBase(0, 0, DOT_TRIANGLE_LIST), mUsage(MU_STATIC), mIndexType(IT_32BIT)
+		:MeshBase(0, 0, DOT_TRIANGLE_LIST), mUsage(MU_STATIC), mIndexType(IT_32BIT), mContentVersion(0)
 	{
 
 	}
@@ -380,6 +380,7 @@ namespace BansheeEngine
 	{
 		updateBounds(*data);
 		updateCPUBuffer(subresourceIdx, *data);
+		mContentVersion++;
 
 		data->_lock();
 
@@ -25,7 +25,9 @@ namespace BansheeEngine
 	{ }
 
 	MeshData::~MeshData()
-	{ }
+	{
+		freeInternalBuffer();
+	}
 
 	UINT32 MeshData::getNumIndices() const
 	{
@@ -292,7 +292,7 @@ namespace BansheeEngine
 	void MeshHeapCore::growVertexBuffer(UINT32 numVertices)
 	{
 		mNumVertices = numVertices;
-		mVertexData = SPtr<VertexData>(bs_new<VertexData>());
+		mVertexData = bs_shared_ptr_new<VertexData>();
 
 		mVertexData->vertexCount = mNumVertices;
 		mVertexData->vertexDeclaration = HardwareBufferCoreManager::instance().createVertexDeclaration(mVertexDesc);
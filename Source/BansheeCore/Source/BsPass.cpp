@@ -10,6 +10,7 @@
 #include "BsFrameAlloc.h"
 #include "BsGpuProgram.h"
 #include "BsException.h"
+#include "BsPipelineState.h"
 
 namespace BansheeEngine
 {
@@ -81,6 +82,29 @@ namespace BansheeEngine
 
 		mData = *desc;
 		desc->~PASS_DESC_CORE();
+
+		mPipelineState = nullptr;
+	}
+
+	const SPtr<PipelineStateCore>& PassCore::getPipelineState() const
+	{
+		if (mPipelineState == nullptr)
+		{
+			PIPELINE_STATE_CORE_DESC desc;
+			desc.blendState = mData.blendState;
+			desc.rasterizerState = mData.rasterizerState;
+			desc.depthStencilState = mData.depthStencilState;
+			desc.stencilRefValue = mData.stencilRefValue;
+			desc.vertexProgram = mData.vertexProgram;
+			desc.fragmentProgram = mData.fragmentProgram;
+			desc.geometryProgram = mData.geometryProgram;
+			desc.hullProgram = mData.hullProgram;
+			desc.domainProgram = mData.domainProgram;
+
+			mPipelineState = PipelineStateCore::create(desc);
+		}
+
+		return mPipelineState;
 	}
 
 	SPtr<PassCore> PassCore::create(const PASS_DESC_CORE& desc)
@@ -0,0 +1,54 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsPipelineState.h"
+#include "BsRenderStateManager.h"
+#include "BsBlendState.h"
+#include "BsRasterizerState.h"
+#include "BsDepthStencilState.h"
+#include "BsGpuProgram.h"
+
+namespace BansheeEngine
+{
+	bool PIPELINE_STATE_CORE_DESC::operator==(const PIPELINE_STATE_CORE_DESC& rhs) const
+	{
+		return blendState == rhs.blendState && rasterizerState == rhs.rasterizerState &&
+			depthStencilState == rhs.depthStencilState && stencilRefValue == rhs.stencilRefValue &&
+			vertexProgram == rhs.vertexProgram && fragmentProgram == rhs.fragmentProgram &&
+			geometryProgram == rhs.geometryProgram && hullProgram == rhs.hullProgram &&
+			domainProgram == rhs.domainProgram;
+	}
+
+	PipelineStateCore::PipelineStateCore(const PIPELINE_STATE_CORE_DESC& desc, UINT64 hash, UINT64 id)
+		:mData(desc), mHash(hash), mId(id)
+	{ }
+
+	SPtr<PipelineStateCore> PipelineStateCore::create(const PIPELINE_STATE_CORE_DESC& desc)
+	{
+		return RenderStateCoreManager::instance().createPipelineState(desc);
+	}
+
+	UINT64 PipelineStateCore::generateHash(const PIPELINE_STATE_CORE_DESC& desc)
+	{
+		// Render states already have compact unique identifiers, so pack them into the low bits directly and use the
+		// rest of the hash for the (much more varied) GPU programs
+		UINT64 stateBits = 0;
+		if (desc.blendState != nullptr)
+			stateBits |= (UINT64)(desc.blendState->getId() & 0x3FF);
+
+		if (desc.rasterizerState != nullptr)
+			stateBits |= (UINT64)(desc.rasterizerState->getId() & 0x3FF) << 10;
+
+		if (desc.depthStencilState != nullptr)
+			stateBits |= (UINT64)(desc.depthStencilState->getId() & 0x3FF) << 20;
+
+		size_t programHash = 0;
+		hash_combine(programHash, desc.stencilRefValue);
+		hash_combine(programHash, desc.vertexProgram.get());
+		hash_combine(programHash, desc.fragmentProgram.get());
+		hash_combine(programHash, desc.geometryProgram.get());
+		hash_combine(programHash, desc.hullProgram.get());
+		hash_combine(programHash, desc.domainProgram.get());
+
+		return stateBits ^ ((UINT64)programHash << 30) ^ ((UINT64)programHash >> 34);
+	}
+}
@@ -5,8 +5,15 @@
 #include "BsColor.h"
 #include "BsMath.h"
 #include "BsException.h"
+#include "BsTaskScheduler.h"
+#include "BsVector3.h"
 #include "nvtt/nvtt.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define BS_PIXEL_UTIL_SSE 1
+#	include <emmintrin.h>
+#endif
+
 namespace BansheeEngine 
 {
 	/**
@@ -956,6 +963,22 @@ namespace BansheeEngine
 		return nvtt::WrapMode_Mirror;
 	}
 
+	nvtt::MipmapFilter toNVTTMipmapFilter(MipMapFilter filter)
+	{
+		switch (filter)
+		{
+		case MipMapFilter::Box:
+			return nvtt::MipmapFilter_Box;
+		case MipMapFilter::Triangle:
+			return nvtt::MipmapFilter_Triangle;
+		case MipMapFilter::Kaiser:
+			return nvtt::MipmapFilter_Kaiser;
+		}
+
+		// Unknown filter
+		return nvtt::MipmapFilter_Box;
+	}
+
     UINT32 PixelUtil::getNumElemBytes(PixelFormat format)
     {
         return getDescriptionFor(format).elemBytes;
@@ -1359,6 +1382,494 @@ namespace BansheeEngine
         }
     }
 
+	namespace
+	{
+		/** Minimum number of pixels to assign to a single task when converting large images on multiple threads. */
+		const UINT32 MIN_PIXELS_PER_TASK = 128 * 1024;
+
+		/** Number of pixels converted at once by converters that go through an intermediate format. */
+		const UINT32 CONVERSION_CHUNK_SIZE = 256;
+
+		/** Converts a row of @p count consecutive pixels from @p src to @p dst. */
+		typedef std::function<void(const UINT8* src, UINT8* dst, UINT32 count)> PixelRowConverter;
+
+		/**
+		 * Calls the converter for every row of the provided volumes. Large volumes are split between worker threads. 
+		 * Source and destination may be the same object, for in-place operations.
+		 */
+		void convertPixelRows(const PixelData& src, const PixelData& dst, const PixelRowConverter& converter)
+		{
+			const UINT32 srcPixelSize = PixelUtil::getNumElemBytes(src.getFormat());
+			const UINT32 dstPixelSize = PixelUtil::getNumElemBytes(dst.getFormat());
+
+			const UINT32 width = src.getWidth();
+			const UINT32 height = src.getHeight();
+			const UINT32 numRows = height * src.getDepth();
+
+			UINT32 numTasks = TaskScheduler::getNumTasks(width * numRows, MIN_PIXELS_PER_TASK);
+			TaskScheduler::runParallel("PixelConversion", numRows, numTasks, [&](UINT32 start, UINT32 end)
+			{
+				for (UINT32 i = start; i < end; i++)
+				{
+					UINT32 y = i % height;
+					UINT32 z = i / height;
+
+					const UINT8* srcRow = src.getData() + (src.getLeft() + (src.getTop() + y) * src.getRowPitch() +
+						(src.getFront() + z) * src.getSlicePitch()) * srcPixelSize;
+					UINT8* dstRow = dst.getData() + (dst.getLeft() + (dst.getTop() + y) * dst.getRowPitch() +
+						(dst.getFront() + z) * dst.getSlicePitch()) * dstPixelSize;
+
+					converter(srcRow, dstRow, width);
+				}
+			});
+		}
+
+		/** Describes a format that stores each of its channels in a single byte. */
+		struct ByteFormatLayout
+		{
+			UINT32 pixelSize;
+			INT32 offsets[4]; /**< Offsets of the red, green, blue and alpha bytes, or -1 if the channel isn't stored. */
+		};
+
+		/** Layout of the format all byte formats are converted through when converting to or from other formats. */
+		const ByteFormatLayout RGBA8_LAYOUT = { 4, { 0, 1, 2, 3 } };
+
+		/** 
+		 * Retrieves the layout of a format storing each channel in a single byte. Returns false if the format isn't such a
+		 * format. Formats with an unused (X) channel are not included, as their conversions don't map to byte copies.
+		 */
+		bool getByteFormatLayout(PixelFormat format, ByteFormatLayout& layout)
+		{
+			switch (format)
+			{
+			case PF_R8: layout = { 1, { 0, -1, -1, -1 } }; return true;
+			case PF_R8G8: layout = { 2, { 0, 1, -1, -1 } }; return true;
+			case PF_R8G8B8: layout = { 3, { 0, 1, 2, -1 } }; return true;
+			case PF_B8G8R8: layout = { 3, { 2, 1, 0, -1 } }; return true;
+			case PF_A8R8G8B8: layout = { 4, { 1, 2, 3, 0 } }; return true;
+			case PF_A8B8G8R8: layout = { 4, { 3, 2, 1, 0 } }; return true;
+			case PF_B8G8R8A8: layout = { 4, { 2, 1, 0, 3 } }; return true;
+			case PF_R8G8B8A8: layout = { 4, { 0, 1, 2, 3 } }; return true;
+			default: return false;
+			}
+		}
+
+		/** 
+		 * Describes how to build a pixel of one byte format from a pixel of another. Each destination byte is either
+		 * copied from a source byte or set to a constant, as missing color channels default to zero and missing alpha to 
+		 * full, same as with unpackColor().
+		 */
+		struct ByteSwizzle
+		{
+			UINT32 srcPixelSize;
+			UINT32 dstPixelSize;
+			INT32 sources[4]; /**< Source byte to copy each destination byte from, or -1 to use the constant. */
+			UINT8 constants[4];
+			bool isIdentity;
+		};
+
+		ByteSwizzle createByteSwizzle(const ByteFormatLayout& src, const ByteFormatLayout& dst)
+		{
+			ByteSwizzle swizzle;
+			swizzle.srcPixelSize = src.pixelSize;
+			swizzle.dstPixelSize = dst.pixelSize;
+			swizzle.isIdentity = src.pixelSize == dst.pixelSize;
+
+			for (UINT32 i = 0; i < 4; i++)
+			{
+				swizzle.sources[i] = -1;
+				swizzle.constants[i] = 0;
+			}
+
+			for (UINT32 channel = 0; channel < 4; channel++)
+			{
+				INT32 dstOffset = dst.offsets[channel];
+				if (dstOffset < 0)
+					continue;
+
+				swizzle.sources[dstOffset] = src.offsets[channel];
+				swizzle.constants[dstOffset] = channel == 3 ? 255 : 0;
+
+				if (src.offsets[channel] != dstOffset)
+					swizzle.isIdentity = false;
+			}
+
+			return swizzle;
+		}
+
+		/** Swizzles pixels between two byte formats with sizes known at compile time. */
+		template<UINT32 SRC_SIZE, UINT32 DST_SIZE>
+		void swizzlePixels(const ByteSwizzle& swizzle, const UINT8* src, UINT8* dst, UINT32 count)
+		{
+			for (UINT32 i = 0; i < count; i++)
+			{
+				for (UINT32 j = 0; j < DST_SIZE; j++)
+				{
+					INT32 source = swizzle.sources[j];
+					dst[j] = source >= 0 ? src[source] : swizzle.constants[j];
+				}
+
+				src += SRC_SIZE;
+				dst += DST_SIZE;
+			}
+		}
+
+		/** Swizzles pixels between two four byte formats, treating each pixel as a 32-bit integer. */
+		void swizzlePixels32(const ByteSwizzle& swizzle, const UINT8* src, UINT8* dst, UINT32 count)
+		{
+			// Every output byte is a masked source byte shifted to its new position, or a constant
+			UINT32 masks[4];
+			INT32 shifts[4];
+			UINT32 constants = 0;
+			for (UINT32 i = 0; i < 4; i++)
+			{
+				INT32 source = swizzle.sources[i];
+				if (source >= 0)
+				{
+					masks[i] = 0xFFu << (source * 8);
+					shifts[i] = ((INT32)i - source) * 8;
+				}
+				else
+				{
+					masks[i] = 0;
+					shifts[i] = 0;
+					constants |= (UINT32)swizzle.constants[i] << (i * 8);
+				}
+			}
+
+			UINT32 i = 0;
+#if BS_PIXEL_UTIL_SSE
+			__m128i maskVec[4];
+			__m128i leftShifts[4];
+			__m128i rightShifts[4];
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				maskVec[j] = _mm_set1_epi32((INT32)masks[j]);
+				leftShifts[j] = _mm_cvtsi32_si128(shifts[j] > 0 ? shifts[j] : 0);
+				rightShifts[j] = _mm_cvtsi32_si128(shifts[j] < 0 ? -shifts[j] : 0);
+			}
+
+			__m128i constantVec = _mm_set1_epi32((INT32)constants);
+			for (; (i + 4) <= count; i += 4)
+			{
+				__m128i pixels = _mm_loadu_si128((const __m128i*)(src + i * 4));
+				__m128i output = constantVec;
+
+				for (UINT32 j = 0; j < 4; j++)
+				{
+					__m128i channel = _mm_and_si128(pixels, maskVec[j]);
+					channel = _mm_sll_epi32(_mm_srl_epi32(channel, rightShifts[j]), leftShifts[j]);
+
+					output = _mm_or_si128(output, channel);
+				}
+
+				_mm_storeu_si128((__m128i*)(dst + i * 4), output);
+			}
+#endif
+
+			for (; i < count; i++)
+			{
+				UINT32 pixel;
+				memcpy(&pixel, src + i * 4, sizeof(pixel));
+
+				UINT32 output = constants;
+				for (UINT32 j = 0; j < 4; j++)
+				{
+					UINT32 channel = pixel & masks[j];
+					output |= shifts[j] >= 0 ? channel << shifts[j] : channel >> -shifts[j];
+				}
+
+				memcpy(dst + i * 4, &output, sizeof(output));
+			}
+		}
+
+		/** Swizzles pixels between two byte formats. */
+		void swizzleBytes(const ByteSwizzle& swizzle, const UINT8* src, UINT8* dst, UINT32 count)
+		{
+			typedef void(*SwizzleFunc)(const ByteSwizzle&, const UINT8*, UINT8*, UINT32);
+			static const SwizzleFunc funcs[4][4] =
+			{
+				{ &swizzlePixels<1, 1>, &swizzlePixels<1, 2>, &swizzlePixels<1, 3>, &swizzlePixels<1, 4> },
+				{ &swizzlePixels<2, 1>, &swizzlePixels<2, 2>, &swizzlePixels<2, 3>, &swizzlePixels<2, 4> },
+				{ &swizzlePixels<3, 1>, &swizzlePixels<3, 2>, &swizzlePixels<3, 3>, &swizzlePixels<3, 4> },
+				{ &swizzlePixels<4, 1>, &swizzlePixels<4, 2>, &swizzlePixels<4, 3>, &swizzlePixels32 }
+			};
+
+			if (swizzle.isIdentity)
+				memcpy(dst, src, count * swizzle.srcPixelSize);
+			else
+				funcs[swizzle.srcPixelSize - 1][swizzle.dstPixelSize - 1](swizzle, src, dst, count);
+		}
+
+		/** Converts RGBA pixels with one byte per channel into RGBA pixels with a 32-bit float per channel. */
+		void convertRGBA8ToFloat32(const UINT8* src, float* dst, UINT32 count)
+		{
+			UINT32 numValues = count * 4;
+			UINT32 i = 0;
+
+#if BS_PIXEL_UTIL_SSE
+			__m128i zero = _mm_setzero_si128();
+			__m128 scale = _mm_set1_ps(255.0f);
+			for (; (i + 16) <= numValues; i += 16)
+			{
+				__m128i bytes = _mm_loadu_si128((const __m128i*)(src + i));
+				__m128i low = _mm_unpacklo_epi8(bytes, zero);
+				__m128i high = _mm_unpackhi_epi8(bytes, zero);
+
+				// Divide rather than multiply by reciprocal, so results exactly match Bitwise::fixedToFloat
+				_mm_storeu_ps(dst + i + 0, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero)), scale));
+				_mm_storeu_ps(dst + i + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero)), scale));
+				_mm_storeu_ps(dst + i + 8, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero)), scale));
+				_mm_storeu_ps(dst + i + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero)), scale));
+			}
+#endif
+
+			for (; i < numValues; i++)
+				dst[i] = Bitwise::fixedToFloat(src[i], 8);
+		}
+
+		/** Converts RGBA pixels with a 32-bit float per channel into RGBA pixels with one byte per channel. */
+		void convertFloat32ToRGBA8(const float* src, UINT8* dst, UINT32 count)
+		{
+			UINT32 numValues = count * 4;
+			UINT32 i = 0;
+
+#if BS_PIXEL_UTIL_SSE
+			// Same as Bitwise::floatToFixed: clamp to [0, 1], scale by 256 and truncate, saturating 256 to 255
+			__m128 zero = _mm_setzero_ps();
+			__m128 one = _mm_set1_ps(1.0f);
+			__m128 scale = _mm_set1_ps(256.0f);
+			for (; (i + 16) <= numValues; i += 16)
+			{
+				__m128i values[4];
+				for (UINT32 j = 0; j < 4; j++)
+				{
+					__m128 value = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + j * 4), zero), one);
+					values[j] = _mm_cvttps_epi32(_mm_mul_ps(value, scale));
+				}
+
+				__m128i low = _mm_packs_epi32(values[0], values[1]);
+				__m128i high = _mm_packs_epi32(values[2], values[3]);
+				_mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(low, high));
+			}
+#endif
+
+			for (; i < numValues; i++)
+				dst[i] = (UINT8)Bitwise::floatToFixed(src[i], 8);
+		}
+
+		/** Returns a table containing the half float value for each possible byte channel value. */
+		const UINT16* getByteToHalfTable()
+		{
+			struct Table
+			{
+				Table()
+				{
+					for (UINT32 i = 0; i < 256; i++)
+						values[i] = Bitwise::floatToHalf(Bitwise::fixedToFloat(i, 8));
+				}
+
+				UINT16 values[256];
+			};
+
+			static const Table table;
+			return table.values;
+		}
+
+		/** Returns a table containing the byte channel value for each possible half float value. */
+		const UINT8* getHalfToByteTable()
+		{
+			struct Table
+			{
+				Table()
+				{
+					for (UINT32 i = 0; i < 65536; i++)
+						values[i] = (UINT8)Bitwise::floatToFixed(Bitwise::halfToFloat((UINT16)i), 8);
+				}
+
+				UINT8 values[65536];
+			};
+
+			static const Table table;
+			return table.values;
+		}
+
+		/** Returns a table converting sRGB (gamma) byte channel values into linear space. */
+		const UINT8* getSRGBToLinearTable()
+		{
+			struct Table
+			{
+				Table()
+				{
+					for (UINT32 i = 0; i < 256; i++)
+						values[i] = (UINT8)Bitwise::floatToFixed(PixelUtil::SRGBToLinear(Bitwise::fixedToFloat(i, 8)), 8);
+				}
+
+				UINT8 values[256];
+			};
+
+			static const Table table;
+			return table.values;
+		}
+
+		/** Returns a table converting linear byte channel values into sRGB (gamma) space. */
+		const UINT8* getLinearToSRGBTable()
+		{
+			struct Table
+			{
+				Table()
+				{
+					for (UINT32 i = 0; i < 256; i++)
+						values[i] = (UINT8)Bitwise::floatToFixed(PixelUtil::linearToSRGB(Bitwise::fixedToFloat(i, 8)), 8);
+				}
+
+				UINT8 values[256];
+			};
+
+			static const Table table;
+			return table.values;
+		}
+
+		/** 
+		 * Creates a converter specialized for the provided pair of formats. Returns null if there is no specialized
+		 * converter for the pair, in which case the generic per-pixel path should be used.
+		 */
+		PixelRowConverter createFastConverter(PixelFormat srcFormat, PixelFormat dstFormat)
+		{
+			ByteFormatLayout srcLayout, dstLayout;
+			bool srcIsBytes = getByteFormatLayout(srcFormat, srcLayout);
+			bool dstIsBytes = getByteFormatLayout(dstFormat, dstLayout);
+
+			// Byte formats to byte formats, by shuffling the bytes around
+			if (srcIsBytes && dstIsBytes)
+			{
+				ByteSwizzle swizzle = createByteSwizzle(srcLayout, dstLayout);
+				return [swizzle](const UINT8* src, UINT8* dst, UINT32 count)
+				{
+					swizzleBytes(swizzle, src, dst, count);
+				};
+			}
+
+			// Byte formats to float formats, going through RGBA8
+			if (srcIsBytes && (dstFormat == PF_FLOAT32_RGBA || dstFormat == PF_FLOAT16_RGBA))
+			{
+				ByteSwizzle swizzle = createByteSwizzle(srcLayout, RGBA8_LAYOUT);
+				bool isHalf = dstFormat == PF_FLOAT16_RGBA;
+
+				return [swizzle, isHalf](const UINT8* src, UINT8* dst, UINT32 count)
+				{
+					UINT8 rgba[CONVERSION_CHUNK_SIZE * 4];
+					const UINT16* halfTable = isHalf ? getByteToHalfTable() : nullptr;
+
+					for (UINT32 i = 0; i < count; i += CONVERSION_CHUNK_SIZE)
+					{
+						UINT32 numPixels = std::min(count - i, CONVERSION_CHUNK_SIZE);
+
+						const UINT8* rgbaSrc = src + i * swizzle.srcPixelSize;
+						if (!swizzle.isIdentity)
+						{
+							swizzleBytes(swizzle, rgbaSrc, rgba, numPixels);
+							rgbaSrc = rgba;
+						}
+
+						if (isHalf)
+						{
+							UINT16* halfDst = (UINT16*)dst + i * 4;
+							for (UINT32 j = 0; j < numPixels * 4; j++)
+								halfDst[j] = halfTable[rgbaSrc[j]];
+						}
+						else
+							convertRGBA8ToFloat32(rgbaSrc, (float*)dst + i * 4, numPixels);
+					}
+				};
+			}
+
+			// Float formats to byte formats, going through RGBA8
+			if ((srcFormat == PF_FLOAT32_RGBA || srcFormat == PF_FLOAT16_RGBA) && dstIsBytes)
+			{
+				ByteSwizzle swizzle = createByteSwizzle(RGBA8_LAYOUT, dstLayout);
+				bool isHalf = srcFormat == PF_FLOAT16_RGBA;
+
+				return [swizzle, isHalf](const UINT8* src, UINT8* dst, UINT32 count)
+				{
+					UINT8 rgba[CONVERSION_CHUNK_SIZE * 4];
+					const UINT8* halfTable = isHalf ? getHalfToByteTable() : nullptr;
+
+					for (UINT32 i = 0; i < count; i += CONVERSION_CHUNK_SIZE)
+					{
+						UINT32 numPixels = std::min(count - i, CONVERSION_CHUNK_SIZE);
+
+						UINT8* rgbaDst = swizzle.isIdentity ? dst + i * 4 : rgba;
+						if (isHalf)
+						{
+							const UINT16* halfSrc = (const UINT16*)src + i * 4;
+							for (UINT32 j = 0; j < numPixels * 4; j++)
+								rgbaDst[j] = halfTable[halfSrc[j]];
+						}
+						else
+							convertFloat32ToRGBA8((const float*)src + i * 4, rgbaDst, numPixels);
+
+						if (!swizzle.isIdentity)
+							swizzleBytes(swizzle, rgba, dst + i * swizzle.dstPixelSize, numPixels);
+					}
+				};
+			}
+
+			return nullptr;
+		}
+
+		/** 
+		 * Applies a transformation to the color (non-alpha) channels of the provided pixels, in place. Byte formats use
+		 * the provided lookup table, while other formats call the provided function for every channel.
+		 */
+		void transformColorChannels(PixelData& data, const UINT8* byteTable, float(*func)(float))
+		{
+			PixelFormat format = data.getFormat();
+			if (PixelUtil::isCompressed(format) || PixelUtil::isDepth(format))
+			{
+				BS_EXCEPT(InvalidParametersException, "Color space conversion is not supported for format: " + 
+					PixelUtil::getFormatName(format));
+			}
+
+			ByteFormatLayout layout;
+			if (getByteFormatLayout(format, layout))
+			{
+				convertPixelRows(data, data, [layout, byteTable](const UINT8* src, UINT8* dst, UINT32 count)
+				{
+					for (UINT32 i = 0; i < count; i++)
+					{
+						for (UINT32 channel = 0; channel < 3; channel++)
+						{
+							INT32 offset = layout.offsets[channel];
+							if (offset >= 0)
+								dst[offset] = byteTable[src[offset]];
+						}
+
+						src += layout.pixelSize;
+						dst += layout.pixelSize;
+					}
+				});
+			}
+			else
+			{
+				UINT32 pixelSize = PixelUtil::getNumElemBytes(format);
+				convertPixelRows(data, data, [format, pixelSize, func](const UINT8* src, UINT8* dst, UINT32 count)
+				{
+					float r, g, b, a;
+					for (UINT32 i = 0; i < count; i++)
+					{
+						PixelUtil::unpackColor(&r, &g, &b, &a, format, src);
+						PixelUtil::packColor(func(r), func(g), func(b), a, format, dst);
+
+						src += pixelSize;
+						dst += pixelSize;
+					}
+				});
+			}
+		}
+	}
+
+
     void PixelUtil::bulkPixelConversion(const PixelData &src, PixelData &dst)
     {
         assert(src.getWidth() == dst.getWidth() &&
@@ -1440,6 +1951,14 @@ namespace BansheeEngine
             return;
         }
 
+		// Common format pairs have specialized converters
+		PixelRowConverter fastConverter = createFastConverter(src.getFormat(), dst.getFormat());
+		if (fastConverter != nullptr)
+		{
+			convertPixelRows(src, dst, fastConverter);
+			return;
+		}
+
 		// Converting to PF_X8R8G8B8 is exactly the same as converting to
 		// PF_A8R8G8B8. (same with PF_X8B8G8R8 and PF_A8B8G8R8)
 		if(dst.getFormat() == PF_X8R8G8B8 || dst.getFormat() == PF_X8B8G8R8)
@@ -1465,41 +1984,24 @@ namespace BansheeEngine
 			return;
 		}
 
-		const UINT32 srcPixelSize = PixelUtil::getNumElemBytes(src.getFormat());
-		const UINT32 dstPixelSize = PixelUtil::getNumElemBytes(dst.getFormat());
-        UINT8 *srcptr = static_cast<UINT8*>(src.getData())
-            + (src.getLeft() + src.getTop() * src.getRowPitch() + src.getFront() * src.getSlicePitch()) * srcPixelSize;
-        UINT8 *dstptr = static_cast<UINT8*>(dst.getData())
-            + (dst.getLeft() + dst.getTop() * dst.getRowPitch() + dst.getFront() * dst.getSlicePitch()) * dstPixelSize;
-		
-        // Calculate pitches+skips in bytes
-		const UINT32 srcRowSkipBytes = src.getRowSkip()*srcPixelSize;
-		const UINT32 srcSliceSkipBytes = src.getSliceSkip()*srcPixelSize;
-		const UINT32 dstRowSkipBytes = dst.getRowSkip()*dstPixelSize;
-		const UINT32 dstSliceSkipBytes = dst.getSliceSkip()*dstPixelSize;
-
         // The brute force fallback
-        float r,g,b,a;
-		for (UINT32 z = src.getFront(); z<src.getBack(); z++)
-		{
-			for (UINT32 y = src.getTop(); y < src.getBottom(); y++)
-            {
-				for (UINT32 x = src.getLeft(); x<src.getRight(); x++)
-                {
-                    unpackColor(&r, &g, &b, &a, src.getFormat(), srcptr);
-                    packColor(r, g, b, a, dst.getFormat(), dstptr);
-
-                    srcptr += srcPixelSize;
-                    dstptr += dstPixelSize;
-                }
+		const PixelFormat srcFormat = src.getFormat();
+		const PixelFormat dstFormat = dst.getFormat();
+		const UINT32 srcPixelSize = PixelUtil::getNumElemBytes(srcFormat);
+		const UINT32 dstPixelSize = PixelUtil::getNumElemBytes(dstFormat);
 
-                srcptr += srcRowSkipBytes;
-                dstptr += dstRowSkipBytes;
-            }
+		convertPixelRows(src, dst, [=](const UINT8* srcptr, UINT8* dstptr, UINT32 count)
+		{
+			float r, g, b, a;
+			for (UINT32 x = 0; x < count; x++)
+			{
+				unpackColor(&r, &g, &b, &a, srcFormat, srcptr);
+				packColor(r, g, b, a, dstFormat, dstptr);
 
-            srcptr += srcSliceSkipBytes;
-            dstptr += dstSliceSkipBytes;
-        }
+				srcptr += srcPixelSize;
+				dstptr += dstPixelSize;
+			}
+		});
     }
 
 	void PixelUtil::scale(const PixelData& src, PixelData& scaled, Filter filter)
@@ -1646,129 +2148,582 @@ namespace BansheeEngine
 		}
 	}
 
-	void PixelUtil::compress(const PixelData& src, PixelData& dst, const CompressionOptions& options)
+	float PixelUtil::SRGBToLinear(float value)
 	{
-		if (!isCompressed(options.format))
-			BS_EXCEPT(InvalidParametersException, "Wanted format is not a compressed format.");
+		if (value <= 0.04045f)
+			return value / 12.92f;
+		else
+			return Math::pow((value + 0.055f) / 1.055f, 2.4f);
+	}
 
-		// Note: NVTT site has implementations for these two formats for when I decide to add them
-		if (options.format == PF_BC6H || options.format == PF_BC7)
-			BS_EXCEPT(InvalidParametersException, "Specified formats are not yet supported.");
+	float PixelUtil::linearToSRGB(float value)
+	{
+		if (value <= 0.0031308f)
+			return value * 12.92f;
+		else
+			return 1.055f * Math::pow(value, 1.0f / 2.4f) - 0.055f;
+	}
 
-		if (src.getDepth() != 1)
-			BS_EXCEPT(InvalidParametersException, "3D textures are not supported.");
+	void PixelUtil::SRGBToLinear(PixelData& data)
+	{
+		float(*func)(float) = &PixelUtil::SRGBToLinear;
+		transformColorChannels(data, getSRGBToLinearTable(), func);
+	}
 
-		if (isCompressed(src.getFormat()))
-			BS_EXCEPT(InvalidParametersException, "Source data cannot be compressed.");
+	void PixelUtil::linearToSRGB(PixelData& data)
+	{
+		float(*func)(float) = &PixelUtil::linearToSRGB;
+		transformColorChannels(data, getLinearToSRGBTable(), func);
+	}
 
-		PixelData bgraData(src.getWidth(), src.getHeight(), 1, PF_B8G8R8A8);
-		bgraData.allocateInternalBuffer();
-		bulkPixelConversion(src, bgraData);
+	namespace
+	{
+		/** Minimum number of pixels to assign to a single task when compressing large images on multiple threads. */
+		const UINT32 MIN_PIXELS_PER_COMPRESSION_TASK = 32 * 1024;
 
-		nvtt::InputOptions io;
-		io.setTextureLayout(nvtt::TextureType_2D, src.getWidth(), src.getHeight());
-		io.setMipmapData(bgraData.getData(), src.getWidth(), src.getHeight());
-		io.setMipmapGeneration(false);
-		io.setAlphaMode(toNVTTAlphaMode(options.alphaMode));
-		io.setNormalMap(options.isNormalMap);
+		/** Minimum number of pixels to assign to a single task when downsampling large images on multiple threads. */
+		const UINT32 MIN_PIXELS_PER_DOWNSAMPLE_TASK = 64 * 1024;
 
-		if (options.isSRGB)
-			io.setGamma(2.2f, 2.2f);
-		else
-			io.setGamma(1.0f, 1.0f);
-
-		nvtt::CompressionOptions co;
-		co.setFormat(toNVTTFormat(options.format));
-		co.setQuality(toNVTTQuality(options.quality));
-		
-		NVTTCompressOutputHandler outputHandler(dst.getData(), dst.getConsecutiveSize());
-
-		nvtt::OutputOptions oo;
-		oo.setOutputHeader(false);
-		oo.setOutputHandler(&outputHandler);
-		
-		nvtt::Compressor compressor;
-		if (!compressor.process(io, co, oo))
-			BS_EXCEPT(InternalErrorException, "Compressing failed.");
-	}
+		/** Radius of the Kaiser filter in destination pixels, and its window shape. Matches NVTT defaults. */
+		const float KAISER_WIDTH = 3.0f;
+		const float KAISER_ALPHA = 4.0f;
 
-	Vector<SPtr<PixelData>> PixelUtil::genMipmaps(const PixelData& src, const MipMapGenOptions& options)
-	{
-		if (src.getDepth() != 1)
-			BS_EXCEPT(InvalidParametersException, "3D textures are not supported.");
-
-		// Note: Add support for floating point mips, no reason they shouldn't be supported other than
-		// nvtt doesn't support them natively
-		if (isCompressed(src.getFormat()) || isFloatingPoint(src.getFormat()))
-			BS_EXCEPT(InvalidParametersException, "Source data cannot be compressed or in floating point format.");
-
-		if (!Math::isPow2(src.getWidth()) || !Math::isPow2(src.getHeight()))
-			BS_EXCEPT(InvalidParametersException, "Texture width & height must be powers of 2.");
-
-		PixelData argbData(src.getWidth(), src.getHeight(), 1, PF_A8R8G8B8);
-		argbData.allocateInternalBuffer();
-		bulkPixelConversion(src, argbData);
-
-		nvtt::InputOptions io;
-		io.setTextureLayout(nvtt::TextureType_2D, src.getWidth(), src.getHeight());
-		io.setMipmapData(argbData.getData(), src.getWidth(), src.getHeight());
-		io.setMipmapGeneration(true);
-		io.setNormalMap(options.isNormalMap);
-		io.setNormalizeMipmaps(options.normalizeMipmaps);
-		io.setWrapMode(toNVTTWrapMode(options.wrapMode));
-
-		nvtt::CompressionOptions co;
-		co.setFormat(nvtt::Format_RGBA);
-		
-		UINT32 numMips = getMaxMipmaps(src.getWidth(), src.getHeight(), 1, src.getFormat());
-
-		Vector<SPtr<PixelData>> argbMipBuffers;
-
-		// Note: This can be done more effectively without creating so many temp buffers
-		// and working with the original formats directly, but it would complicate the code
-		// too much at the moment.
-		UINT32 curWidth = src.getWidth();
-		UINT32 curHeight = src.getHeight();
-		for (UINT32 i = 0; i < numMips; i++)
+		/** Evaluates the zeroth order modified Bessel function of the first kind. */
+		float bessel0(float x)
+		{
+			float sum = 1.0f;
+			float term = 1.0f;
+			for (UINT32 i = 1; i < 32; i++)
+			{
+				float halfX = x / (2.0f * i);
+				term *= halfX * halfX;
+				sum += term;
+
+				if (term < sum * 1e-8f)
+					break;
+			}
+
+			return sum;
+		}
+
+		/** Evaluates the provided filter at distance @p x from its center, in destination pixels. */
+		float evaluateFilter(MipMapFilter filter, float x)
+		{
+			x = Math::abs(x);
+
+			switch (filter)
+			{
+			case MipMapFilter::Triangle:
+				return std::max(0.0f, 1.0f - x);
+			case MipMapFilter::Kaiser:
+			{
+				if (x >= KAISER_WIDTH)
+					return 0.0f;
+
+				float sinc = x < 1e-5f ? 1.0f : Math::sin(Math::PI * x) / (Math::PI * x);
+				float t = x / KAISER_WIDTH;
+
+				return sinc * bessel0(KAISER_ALPHA * Math::sqrt(1.0f - t * t)) / bessel0(KAISER_ALPHA);
+			}
+			default:
+				return x <= 0.5f ? 1.0f : 0.0f;
+			}
+		}
+
+		/** Maps a coordinate that might lie outside of an image of the provided size, into the image. */
+		UINT32 wrapCoordinate(INT32 coord, UINT32 size, MipMapWrapMode wrapMode)
+		{
+			INT32 signedSize = (INT32)size;
+
+			switch (wrapMode)
+			{
+			case MipMapWrapMode::Clamp:
+				return (UINT32)Math::clamp(coord, 0, signedSize - 1);
+			case MipMapWrapMode::Repeat:
+				return (UINT32)(((coord % signedSize) + signedSize) % signedSize);
+			default:
+			{
+				// Mirror, without repeating the edge pixel
+				if (signedSize == 1)
+					return 0;
+
+				INT32 period = signedSize * 2 - 2;
+				coord = std::abs(coord) % period;
+
+				return (UINT32)(coord < signedSize ? coord : period - coord);
+			}
+			}
+		}
+
+		/** Source pixels and their weights contributing to each destination pixel, along a single axis. */
+		struct DownsampleKernel
+		{
+			UINT32 numTaps;
+			Vector<UINT32> indices; /**< @p numTaps entries for each destination pixel. */
+			Vector<float> weights; /**< @p numTaps entries for each destination pixel. */
+		};
+
+		/** Creates a kernel for downsampling an image axis of size @p srcSize to @p dstSize. */
+		DownsampleKernel createDownsampleKernel(UINT32 srcSize, UINT32 dstSize, MipMapFilter filter, 
+			MipMapWrapMode wrapMode)
+		{
+			float scale = srcSize / (float)dstSize;
+
+			float radius;
+			switch (filter)
+			{
+			case MipMapFilter::Triangle:
+				radius = 1.0f;
+				break;
+			case MipMapFilter::Kaiser:
+				radius = KAISER_WIDTH;
+				break;
+			default:
+				radius = 0.5f;
+				break;
+			}
+
+			float srcRadius = radius * scale;
+			UINT32 maxTaps = (UINT32)Math::ceilToInt(srcRadius * 2.0f) + 1;
+
+			Vector<INT32> coords(maxTaps * dstSize);
+			Vector<float> weights(maxTaps * dstSize);
+			UINT32 numTaps = 0;
+			for (UINT32 i = 0; i < dstSize; i++)
+			{
+				float center = (i + 0.5f) * scale;
+				INT32 first = Math::floorToInt(center - srcRadius);
+
+				float totalWeight = 0.0f;
+				for (UINT32 j = 0; j < maxTaps; j++)
+				{
+					INT32 coord = first + (INT32)j;
+
+					// Box filter weights source pixels by how much of them the destination pixel covers, which handles
+					// non power of two sizes gracefully
+					float weight;
+					if (filter == MipMapFilter::Box)
+					{
+						weight = std::min(coord + 1.0f, center + srcRadius) - std::max((float)coord, center - srcRadius);
+						weight = std::max(0.0f, weight);
+					}
+					else
+						weight = evaluateFilter(filter, (coord + 0.5f - center) / scale);
+
+					coords[i * maxTaps + j] = coord;
+					weights[i * maxTaps + j] = weight;
+					totalWeight += weight;
+
+					if (weight != 0.0f)
+						numTaps = std::max(numTaps, j + 1);
+				}
+
+				for (UINT32 j = 0; j < maxTaps; j++)
+					weights[i * maxTaps + j] /= totalWeight;
+			}
+
+			// Trailing taps with no weight for any pixel are dropped
+			DownsampleKernel kernel;
+			kernel.numTaps = numTaps;
+			kernel.indices.resize(numTaps * dstSize);
+			kernel.weights.resize(numTaps * dstSize);
+
+			for (UINT32 i = 0; i < dstSize; i++)
+			{
+				for (UINT32 j = 0; j < numTaps; j++)
+				{
+					kernel.indices[i * numTaps + j] = wrapCoordinate(coords[i * maxTaps + j], srcSize, wrapMode);
+					kernel.weights[i * numTaps + j] = weights[i * maxTaps + j];
+				}
+			}
+
+			return kernel;
+		}
+
+		/** Outputs a single pixel as a weighted sum of pixels from a row of PF_FLOAT32_RGBA pixels. */
+		void filterPixel(const float* row, const UINT32* indices, const float* weights, UINT32 numTaps, float* output)
+		{
+#if BS_PIXEL_UTIL_SSE
+			__m128 sum = _mm_setzero_ps();
+			for (UINT32 i = 0; i < numTaps; i++)
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(row + indices[i] * 4), _mm_set1_ps(weights[i])));
+
+			_mm_storeu_ps(output, sum);
+#else
+			float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			for (UINT32 i = 0; i < numTaps; i++)
+			{
+				const float* pixel = row + indices[i] * 4;
+				for (UINT32 j = 0; j < 4; j++)
+					sum[j] += pixel[j] * weights[i];
+			}
+
+			memcpy(output, sum, sizeof(sum));
+#endif
+		}
+
+		/** Adds a row of values multiplied by @p weight to the output row. */
+		void addWeightedRow(const float* row, float weight, UINT32 count, float* output)
+		{
+			UINT32 i = 0;
+#if BS_PIXEL_UTIL_SSE
+			__m128 weightVec = _mm_set1_ps(weight);
+			for (; (i + 4) <= count; i += 4)
+			{
+				__m128 value = _mm_mul_ps(_mm_loadu_ps(row + i), weightVec);
+				_mm_storeu_ps(output + i, _mm_add_ps(_mm_loadu_ps(output + i), value));
+			}
+#endif
+
+			for (; i < count; i++)
+				output[i] += row[i] * weight;
+		}
+
+		/** Re-normalizes normals encoded in [0, 1] range in a row of PF_FLOAT32_RGBA pixels. */
+		void normalizeRow(float* row, UINT32 count)
+		{
+			for (UINT32 i = 0; i < count; i++)
+			{
+				float* pixel = row + i * 4;
+
+				Vector3 normal(pixel[0] * 2.0f - 1.0f, pixel[1] * 2.0f - 1.0f, pixel[2] * 2.0f - 1.0f);
+				normal.normalize();
+
+				pixel[0] = normal.x * 0.5f + 0.5f;
+				pixel[1] = normal.y * 0.5f + 0.5f;
+				pixel[2] = normal.z * 0.5f + 0.5f;
+			}
+		}
+
+		/** 
+		 * Downsamples an image into a smaller one, using a separable filter. Both images must be in PF_FLOAT32_RGBA 
+		 * format with consecutive rows. Large images are processed on multiple threads.
+		 */
+		void downsample(const PixelData& src, PixelData& dst, const MipMapGenOptions& options)
+		{
+			UINT32 srcWidth = src.getWidth();
+			UINT32 srcHeight = src.getHeight();
+			UINT32 dstWidth = dst.getWidth();
+			UINT32 dstHeight = dst.getHeight();
+
+			DownsampleKernel horzKernel = createDownsampleKernel(srcWidth, dstWidth, options.filter, options.wrapMode);
+			DownsampleKernel vertKernel = createDownsampleKernel(srcHeight, dstHeight, options.filter, options.wrapMode);
+
+			bool normalize = options.isNormalMap && options.normalizeMipmaps;
+
+			// Horizontal pass, into an image of destination width and source height
+			Vector<float> temp(dstWidth * srcHeight * 4);
+			const float* srcData = (const float*)src.getData();
+
+			UINT32 numTasks = TaskScheduler::getNumTasks(srcWidth * srcHeight, MIN_PIXELS_PER_DOWNSAMPLE_TASK);
+			TaskScheduler::runParallel("Downsample", srcHeight, numTasks, [&](UINT32 start, UINT32 end)
+			{
+				UINT32 numTaps = horzKernel.numTaps;
+				for (UINT32 y = start; y < end; y++)
+				{
+					const float* srcRow = srcData + y * srcWidth * 4;
+					float* tempRow = &temp[y * dstWidth * 4];
+
+					for (UINT32 x = 0; x < dstWidth; x++)
+					{
+						filterPixel(srcRow, &horzKernel.indices[x * numTaps], &horzKernel.weights[x * numTaps], numTaps,
+							tempRow + x * 4);
+					}
+				}
+			});
+
+			// Vertical pass, one destination row at a time
+			float* dstData = (float*)dst.getData();
+			TaskScheduler::runParallel("Downsample", dstHeight, numTasks, [&](UINT32 start, UINT32 end)
+			{
+				UINT32 numTaps = vertKernel.numTaps;
+				UINT32 rowSize = dstWidth * 4;
+
+				for (UINT32 y = start; y < end; y++)
+				{
+					float* dstRow = dstData + y * rowSize;
+					memset(dstRow, 0, rowSize * sizeof(float));
+
+					for (UINT32 i = 0; i < numTaps; i++)
+					{
+						UINT32 srcY = vertKernel.indices[y * numTaps + i];
+						float weight = vertKernel.weights[y * numTaps + i];
+
+						if (weight != 0.0f)
+							addWeightedRow(&temp[srcY * rowSize], weight, rowSize, dstRow);
+					}
+
+					if (normalize)
+						normalizeRow(dstRow, dstWidth);
+				}
+			});
+		}
+
+		/** 
+		 * Generates a mip-map chain by filtering the image in floating point, without NVTT. Supports all uncompressed 
+		 * formats and sizes.
+		 */
+		Vector<SPtr<PixelData>> genMipmapsNative(const PixelData& src, const MipMapGenOptions& options)
+		{
+			Vector<SPtr<PixelData>> output;
+
+			// Top level is just copied
+			SPtr<PixelData> topLevel = bs_shared_ptr_new<PixelData>(src.getWidth(), src.getHeight(), 1, src.getFormat());
+			topLevel->allocateInternalBuffer();
+			PixelUtil::bulkPixelConversion(src, *topLevel);
+
+			output.push_back(topLevel);
+
+			SPtr<PixelData> level = bs_shared_ptr_new<PixelData>(src.getWidth(), src.getHeight(), 1, PF_FLOAT32_RGBA);
+			level->allocateInternalBuffer();
+			PixelUtil::bulkPixelConversion(src, *level);
+
+			// Each level is filtered from the previous one
+			UINT32 numMips = PixelUtil::getMaxMipmaps(src.getWidth(), src.getHeight(), 1, src.getFormat());
+			for (UINT32 i = 0; i < numMips; i++)
+			{
+				UINT32 width = std::max(1U, level->getWidth() / 2);
+				UINT32 height = std::max(1U, level->getHeight() / 2);
+
+				SPtr<PixelData> nextLevel = bs_shared_ptr_new<PixelData>(width, height, 1, PF_FLOAT32_RGBA);
+				nextLevel->allocateInternalBuffer();
+
+				downsample(*level, *nextLevel, options);
+				level = nextLevel;
+
+				SPtr<PixelData> outputLevel = bs_shared_ptr_new<PixelData>(width, height, 1, src.getFormat());
+				outputLevel->allocateInternalBuffer();
+				PixelUtil::bulkPixelConversion(*level, *outputLevel);
+
+				output.push_back(outputLevel);
+			}
+
+			return output;
+		}
+
+		/** Generates a mip-map chain using NVTT. Only supports non floating point images with power of two sizes. */
+		bool genMipmapsNVTT(const PixelData& src, const MipMapGenOptions& options, Vector<SPtr<PixelData>>& output)
 		{
+			PixelData argbData(src.getWidth(), src.getHeight(), 1, PF_A8R8G8B8);
+			argbData.allocateInternalBuffer();
+			PixelUtil::bulkPixelConversion(src, argbData);
+
+			nvtt::InputOptions io;
+			io.setTextureLayout(nvtt::TextureType_2D, src.getWidth(), src.getHeight());
+			io.setMipmapData(argbData.getData(), src.getWidth(), src.getHeight());
+			io.setMipmapGeneration(true);
+			io.setMipmapFilter(toNVTTMipmapFilter(options.filter));
+			io.setNormalMap(options.isNormalMap);
+			io.setNormalizeMipmaps(options.normalizeMipmaps);
+			io.setWrapMode(toNVTTWrapMode(options.wrapMode));
+
+			nvtt::CompressionOptions co;
+			co.setFormat(nvtt::Format_RGBA);
+
+			UINT32 numMips = PixelUtil::getMaxMipmaps(src.getWidth(), src.getHeight(), 1, src.getFormat());
+
+			Vector<SPtr<PixelData>> argbMipBuffers;
+
+			// Note: This can be done more effectively without creating so many temp buffers
+			// and working with the original formats directly, but it would complicate the code
+			// too much at the moment.
+			UINT32 curWidth = src.getWidth();
+			UINT32 curHeight = src.getHeight();
+			for (UINT32 i = 0; i < numMips; i++)
+			{
+				argbMipBuffers.push_back(bs_shared_ptr_new<PixelData>(curWidth, curHeight, 1, PF_A8R8G8B8));
+				argbMipBuffers.back()->allocateInternalBuffer();
+
+				if (curWidth > 1) 
+					curWidth = curWidth / 2;
+
+				if (curHeight > 1)
+					curHeight = curHeight / 2;
+			}
+
 			argbMipBuffers.push_back(bs_shared_ptr_new<PixelData>(curWidth, curHeight, 1, PF_A8R8G8B8));
 			argbMipBuffers.back()->allocateInternalBuffer();
 
-			if (curWidth > 1) 
-				curWidth = curWidth / 2;
+			NVTTMipmapOutputHandler outputHandler(argbMipBuffers);
+
+			nvtt::OutputOptions oo;
+			oo.setOutputHeader(false);
+			oo.setOutputHandler(&outputHandler);
+
+			nvtt::Compressor compressor;
+			if (!compressor.process(io, co, oo))
+				return false;
+
+			argbData.freeInternalBuffer();
+
+			for (UINT32 i = 0; i < (UINT32)argbMipBuffers.size(); i++)
+			{
+				SPtr<PixelData> argbBuffer = argbMipBuffers[i];
+				SPtr<PixelData> outputBuffer = bs_shared_ptr_new<PixelData>(argbBuffer->getWidth(), 
+					argbBuffer->getHeight(), 1, src.getFormat());
+				outputBuffer->allocateInternalBuffer();
+
+				PixelUtil::bulkPixelConversion(*argbBuffer, *outputBuffer);
+				argbBuffer->freeInternalBuffer();
+
+				output.push_back(outputBuffer);
+			}
+
+			return true;
+		}
+
+		/** Generates a mip-map chain, picking NVTT or our own filtering depending on the image. */
+		bool genMipmapsInternal(const PixelData& src, const MipMapGenOptions& options, Vector<SPtr<PixelData>>& output)
+		{
+			// NVTT doesn't support floating point or non power of two images, but our own filtering handles those
+			bool useNVTT = !PixelUtil::isFloatingPoint(src.getFormat()) && Math::isPow2(src.getWidth()) &&
+				Math::isPow2(src.getHeight());
+
+			if (useNVTT)
+				return genMipmapsNVTT(src, options, output);
 
-			if (curHeight > 1)
-				curHeight = curHeight / 2;
+			output = genMipmapsNative(src, options);
+			return true;
 		}
 
-		argbMipBuffers.push_back(bs_shared_ptr_new<PixelData>(curWidth, curHeight, 1, PF_A8R8G8B8));
-		argbMipBuffers.back()->allocateInternalBuffer();
+		/** Checks if the provided image can have its mip-maps generated, and throws an exception if not. */
+		void validateMipmapSource(const PixelData& src)
+		{
+			if (src.getDepth() != 1)
+				BS_EXCEPT(InvalidParametersException, "3D textures are not supported.");
 
-		NVTTMipmapOutputHandler outputHandler(argbMipBuffers);
+			if (PixelUtil::isCompressed(src.getFormat()))
+				BS_EXCEPT(InvalidParametersException, "Source data cannot be compressed.");
+		}
 
-		nvtt::OutputOptions oo;
-		oo.setOutputHeader(false);
-		oo.setOutputHandler(&outputHandler);
+		/** 
+		 * Compresses a range of rows of an image in PF_B8G8R8A8 format, using NVTT. Number of rows must be a multiple of
+		 * four, unless the range ends at the bottom of the image.
+		 */
+		bool compressRows(const UINT8* bgraData, UINT32 width, UINT32 numRows, UINT8* output, UINT32 outputSize, 
+			const CompressionOptions& options)
+		{
+			nvtt::InputOptions io;
+			io.setTextureLayout(nvtt::TextureType_2D, width, numRows);
+			io.setMipmapData(bgraData, width, numRows);
+			io.setMipmapGeneration(false);
+			io.setAlphaMode(toNVTTAlphaMode(options.alphaMode));
+			io.setNormalMap(options.isNormalMap);
+
+			if (options.isSRGB)
+				io.setGamma(2.2f, 2.2f);
+			else
+				io.setGamma(1.0f, 1.0f);
 
-		nvtt::Compressor compressor;
-		if (!compressor.process(io, co, oo))
-			BS_EXCEPT(InternalErrorException, "Mipmap generation failed.");
+			nvtt::CompressionOptions co;
+			co.setFormat(toNVTTFormat(options.format));
+			co.setQuality(toNVTTQuality(options.quality));
 
-		argbData.freeInternalBuffer();
+			NVTTCompressOutputHandler outputHandler(output, outputSize);
+
+			nvtt::OutputOptions oo;
+			oo.setOutputHeader(false);
+			oo.setOutputHandler(&outputHandler);
+
+			nvtt::Compressor compressor;
+			return compressor.process(io, co, oo);
+		}
+
+		/** Compresses a single image. Large images are split into bands compressed on multiple threads. */
+		bool compressInternal(const PixelData& src, PixelData& dst, const CompressionOptions& options)
+		{
+			UINT32 width = src.getWidth();
+			UINT32 height = src.getHeight();
+
+			PixelData bgraData(width, height, 1, PF_B8G8R8A8);
+			bgraData.allocateInternalBuffer();
+			PixelUtil::bulkPixelConversion(src, bgraData);
+
+			// Each 4x4 block is compressed independently, so bands of block rows can be compressed separately without 
+			// affecting the output
+			UINT32 numBlockRows = (height + 3) / 4;
+			UINT32 numTasks = TaskScheduler::getNumTasks(width * height, MIN_PIXELS_PER_COMPRESSION_TASK);
+
+			std::atomic<bool> failed(false);
+			TaskScheduler::runParallel("TextureCompression", numBlockRows, numTasks, [&](UINT32 start, UINT32 end)
+			{
+				UINT32 startRow = start * 4;
+				UINT32 numRows = std::min(end * 4, height) - startRow;
+
+				UINT32 dstOffset = PixelUtil::getMemorySize(width, startRow, 1, options.format);
+				UINT32 dstSize = PixelUtil::getMemorySize(width, numRows, 1, options.format);
+
+				if (!compressRows(bgraData.getData() + startRow * width * 4, width, numRows, dst.getData() + dstOffset, 
+					dstSize, options))
+				{
+					failed = true;
+				}
+			});
+
+			return !failed;
+		}
 
-		Vector<SPtr<PixelData>> outputMipBuffers;
-		for (UINT32 i = 0; i < (UINT32)argbMipBuffers.size(); i++)
+		/** Checks if the provided image can be compressed using the provided options, and throws an exception if not. */
+		void validateCompressionSource(const PixelData& src, const CompressionOptions& options)
 		{
-			SPtr<PixelData> argbBuffer = argbMipBuffers[i];
-			SPtr<PixelData> outputBuffer = bs_shared_ptr_new<PixelData>(argbBuffer->getWidth(), argbBuffer->getHeight(), 1, src.getFormat());
-			outputBuffer->allocateInternalBuffer();
+			if (!PixelUtil::isCompressed(options.format))
+				BS_EXCEPT(InvalidParametersException, "Wanted format is not a compressed format.");
 
-			bulkPixelConversion(*argbBuffer, *outputBuffer);
-			argbBuffer->freeInternalBuffer();
+			// Note: NVTT site has implementations for these two formats for when I decide to add them
+			if (options.format == PF_BC6H || options.format == PF_BC7)
+				BS_EXCEPT(InvalidParametersException, "Specified formats are not yet supported.");
 
-			outputMipBuffers.push_back(outputBuffer);
+			if (src.getDepth() != 1)
+				BS_EXCEPT(InvalidParametersException, "3D textures are not supported.");
+
+			if (PixelUtil::isCompressed(src.getFormat()))
+				BS_EXCEPT(InvalidParametersException, "Source data cannot be compressed.");
 		}
+	}
+
+	void PixelUtil::compress(const PixelData& src, PixelData& dst, const CompressionOptions& options)
+	{
+		validateCompressionSource(src, options);
+
+		if (!compressInternal(src, dst, options))
+			BS_EXCEPT(InternalErrorException, "Compressing failed.");
+	}
+
+	void PixelUtil::compress(const Vector<SPtr<PixelData>>& src, const Vector<SPtr<PixelData>>& dst, 
+		const CompressionOptions& options)
+	{
+		if (src.size() != dst.size())
+			BS_EXCEPT(InvalidParametersException, "Number of source and destination images must match.");
+
+		for (auto& entry : src)
+			validateCompressionSource(*entry, options);
+
+		UINT32 numImages = (UINT32)src.size();
+
+		UINT32 numTasks = TaskScheduler::getNumTasks(numImages, 1);
+
+		std::atomic<bool> failed(false);
+		TaskScheduler::runParallel("TextureCompression", numImages, numTasks, [&](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i++)
+			{
+				if (!compressInternal(*src[i], *dst[i], options))
+					failed = true;
+			}
+		});
+
+		if (failed)
+			BS_EXCEPT(InternalErrorException, "Compressing failed.");
+	}
+
+	Vector<SPtr<PixelData>> PixelUtil::genMipmaps(const PixelData& src, const MipMapGenOptions& options)
+	{
+		validateMipmapSource(src);
+
+		Vector<SPtr<PixelData>> output;
+		if (!genMipmapsInternal(src, options, output))
+			BS_EXCEPT(InternalErrorException, "Mipmap generation failed.");
 
-		return outputMipBuffers;
+		return output;
 	}
 }
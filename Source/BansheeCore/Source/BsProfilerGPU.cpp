@@ -139,6 +139,8 @@ namespace BansheeEngine
 		reportSample.numDrawnSamples = sample.activeOcclusionQuery->getNumSamples();
 
 		reportSample.numDrawCalls = (UINT32)(sample.endStats.numDrawCalls - sample.startStats.numDrawCalls);
+		reportSample.numInstancedDrawCalls = (UINT32)(sample.endStats.numInstancedDrawCalls - sample.startStats.numInstancedDrawCalls);
+		reportSample.numInstances = (UINT32)(sample.endStats.numInstances - sample.startStats.numInstances);
 		reportSample.numRenderTargetChanges = (UINT32)(sample.endStats.numRenderTargetChanges - sample.startStats.numRenderTargetChanges);
 		reportSample.numPresents = (UINT32)(sample.endStats.numPresents - sample.startStats.numPresents);
 		reportSample.numClears = (UINT32)(sample.endStats.numClears - sample.startStats.numClears);
@@ -156,6 +158,9 @@ namespace BansheeEngine
 		reportSample.numIndexBufferBinds = (UINT32)(sample.endStats.numIndexBufferBinds - sample.startStats.numIndexBufferBinds);
 		reportSample.numGpuParamBufferBinds = (UINT32)(sample.endStats.numGpuParamBufferBinds - sample.startStats.numGpuParamBufferBinds);
 		reportSample.numGpuProgramBinds = (UINT32)(sample.endStats.numGpuProgramBinds - sample.startStats.numGpuProgramBinds);
+		reportSample.numGpuParamBytesUploaded = (UINT32)(sample.endStats.numGpuParamBytesUploaded - sample.startStats.numGpuParamBytesUploaded);
+		reportSample.numPipelineStateChanges = (UINT32)(sample.endStats.numPipelineStateChanges - sample.startStats.numPipelineStateChanges);
+		reportSample.numRedundantPipelineStateBinds = (UINT32)(sample.endStats.numRedundantPipelineStateBinds - sample.startStats.numRedundantPipelineStateBinds);
 
 		reportSample.numResourceWrites = (UINT32)(sample.endStats.numResourceWrites - sample.startStats.numResourceWrites);
 		reportSample.numResourceReads = (UINT32)(sample.endStats.numResourceReads - sample.startStats.numResourceReads);
@@ -2,6 +2,9 @@
 //**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
 #include "BsProfilingManager.h"
 #include "BsMath.h"
+#include "BsFileSystem.h"
+#include "BsDataStream.h"
+#include "BsDebug.h"
 
 namespace BansheeEngine
 {
@@ -28,6 +31,7 @@ namespace BansheeEngine
 	{
 #if BS_PROFILING_ENABLED
 		mSavedSimReports[mNextSimReportIdx].cpuReport = gProfilerCPU().generateReport();
+		getMemoryReport(mSavedSimReports[mNextSimReportIdx].memoryReport);
 
 		gProfilerCPU().reset();
 
@@ -69,6 +73,96 @@ namespace BansheeEngine
 		}
 	}
 
+	void ProfilingManager::saveMemoryReport(const Path& path) const
+	{
+		ProfilerVector<MemoryCategoryStats> categories;
+		getMemoryReport(categories);
+
+		// Sort so the categories using the most memory are at the top
+		std::sort(categories.begin(), categories.end(), 
+			[](const MemoryCategoryStats& a, const MemoryCategoryStats& b) { return a.liveBytes > b.liveBytes; });
+
+		StringStream stream;
+		stream << "Memory categories:" << std::endl;
+
+		for (auto& entry : categories)
+		{
+			stream << StringUtil::format("{0}: {1} live bytes, {2} peak bytes, {3} allocations, {4} frees", entry.name,
+				entry.liveBytes, entry.peakBytes, entry.numAllocs, entry.numFrees) << std::endl;
+		}
+
+		// Allocations can be made or freed between the two calls, in which case only the first ones are retrieved
+		UINT32 numSamples = MemoryCounter::getSampledAllocations(nullptr, 0);
+		ProfilerVector<SampledAllocation> samples(numSamples);
+		numSamples = std::min(numSamples, MemoryCounter::getSampledAllocations(samples.data(), numSamples));
+		samples.resize(numSamples);
+
+		// Group allocations with the same callstack and category
+		auto isLess = [](const SampledAllocation& a, const SampledAllocation& b)
+		{
+			if (a.categoryIdx != b.categoryIdx)
+				return a.categoryIdx < b.categoryIdx;
+
+			if (a.numFrames != b.numFrames)
+				return a.numFrames < b.numFrames;
+
+			return memcmp(a.frames, b.frames, sizeof(UINT64) * a.numFrames) < 0;
+		};
+
+		std::sort(samples.begin(), samples.end(), isLess);
+
+		struct AllocationGroup
+		{
+			UINT32 sampleIdx;
+			UINT32 numAllocations;
+			UINT64 bytes;
+		};
+
+		ProfilerVector<AllocationGroup> groups;
+		for (UINT32 i = 0; i < numSamples; i++)
+		{
+			if (groups.empty() || isLess(samples[groups.back().sampleIdx], samples[i]))
+				groups.push_back({ i, 0, 0 });
+
+			groups.back().numAllocations++;
+			groups.back().bytes += samples[i].bytes;
+		}
+
+		std::sort(groups.begin(), groups.end(), 
+			[](const AllocationGroup& a, const AllocationGroup& b) { return a.bytes > b.bytes; });
+
+		stream << std::endl << StringUtil::format("Sampled allocations that weren't freed: {0}", numSamples) << std::endl;
+
+		for (auto& entry : groups)
+		{
+			const SampledAllocation& sample = samples[entry.sampleIdx];
+			MemoryCategoryStats category = MemoryCounter::getCategoryStats(sample.categoryIdx);
+
+			stream << std::endl << StringUtil::format("{0} bytes in {1} allocations, category {2}:", entry.bytes,
+				entry.numAllocations, category.name) << std::endl;
+			stream << CrashHandler::getStackTrace(sample.frames, sample.numFrames) << std::endl;
+		}
+
+		SPtr<DataStream> fileStream = FileSystem::createAndOpenFile(path);
+		if (fileStream == nullptr)
+		{
+			LOGWRN("Unable to write memory report file: " + path.toString());
+			return;
+		}
+
+		fileStream->writeString(stream.str());
+		fileStream->close();
+	}
+
+	void ProfilingManager::getMemoryReport(ProfilerVector<MemoryCategoryStats>& output)
+	{
+		UINT32 numCategories = MemoryCounter::getNumCategories();
+
+		output.resize(numCategories);
+		for (UINT32 i = 0; i < numCategories; i++)
+			output[i] = MemoryCounter::getCategoryStats(i);
+	}
+
 	ProfilingManager& gProfiler()
 	{
 		return ProfilingManager::instance();
@@ -13,6 +13,8 @@
 #include "BsBlendState.h"
 #include "BsDepthStencilState.h"
 #include "BsRasterizerState.h"
+#include "BsPipelineState.h"
+#include "BsGpuProgram.h"
 #include "BsGpuParamDesc.h"
 #include "BsShader.h"
 
@@ -209,6 +211,7 @@ namespace BansheeEngine
 		, mDomainProgramBound(false)
 		, mHullProgramBound(false)
 		, mComputeProgramBound(false)
+		, mActivePipelineStateId(0)
 		, mClipPlanesDirty(true)
 		, mCurrentCapabilities(nullptr)
     {
@@ -311,10 +314,58 @@ namespace BansheeEngine
 		}
 	}
 
+	void RenderAPICore::setPipelineState(const SPtr<PipelineStateCore>& pipelineState)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (pipelineState->getId() == mActivePipelineStateId)
+		{
+			BS_INC_RENDER_STAT(NumRedundantPipelineStateBinds);
+			return;
+		}
+
+		struct StageData
+		{
+			GpuProgramType type;
+			const SPtr<GpuProgramCore>& program;
+		};
+
+		const UINT32 numStages = 5;
+		StageData stages[numStages] =
+		{
+			{ GPT_VERTEX_PROGRAM, pipelineState->getVertexProgram() },
+			{ GPT_FRAGMENT_PROGRAM, pipelineState->getFragmentProgram() },
+			{ GPT_GEOMETRY_PROGRAM, pipelineState->getGeometryProgram() },
+			{ GPT_HULL_PROGRAM, pipelineState->getHullProgram() },
+			{ GPT_DOMAIN_PROGRAM, pipelineState->getDomainProgram() }
+		};
+
+		for (UINT32 i = 0; i < numStages; i++)
+		{
+			const StageData& stage = stages[i];
+
+			if (stage.program != nullptr)
+				bindGpuProgram(stage.program);
+			else
+				unbindGpuProgram(stage.type);
+		}
+
+		setBlendState(pipelineState->getBlendState());
+		setDepthStencilState(pipelineState->getDepthStencilState(), pipelineState->getStencilRefValue());
+		setRasterizerState(pipelineState->getRasterizerState());
+
+		// Individual binds above reset the active state, so this must be assigned last
+		mActivePipelineStateId = pipelineState->getId();
+		BS_INC_RENDER_STAT(NumPipelineStateChanges);
+	}
+
 	void RenderAPICore::bindGpuProgram(const SPtr<GpuProgramCore>& prg)
 	{
 		THROW_IF_NOT_CORE_THREAD;
 
+		if (prg->getProperties().getType() != GPT_COMPUTE_PROGRAM)
+			mActivePipelineStateId = 0;
+
 		switch(prg->getProperties().getType())
 		{
 		case GPT_VERTEX_PROGRAM:
@@ -345,6 +396,9 @@ namespace BansheeEngine
 	{
 		THROW_IF_NOT_CORE_THREAD;
 
+		if (gptype != GPT_COMPUTE_PROGRAM)
+			mActivePipelineStateId = 0;
+
 		switch(gptype)
 		{
 		case GPT_VERTEX_PROGRAM:
@@ -105,7 +105,7 @@ namespace BansheeEngine
 	}
 
 	RenderStateCoreManager::RenderStateCoreManager()
-		:mNextBlendStateId(0), mNextRasterizerStateId(0), mNextDepthStencilStateId(0)
+		:mNextBlendStateId(0), mNextRasterizerStateId(0), mNextDepthStencilStateId(0), mNextPipelineStateId(1)
 	{
 		
 	}
@@ -178,6 +178,47 @@ namespace BansheeEngine
 		return state;
 	}
 
+	SPtr<PipelineStateCore> RenderStateCoreManager::createPipelineState(const PIPELINE_STATE_CORE_DESC& desc) const
+	{
+		PIPELINE_STATE_CORE_DESC fullDesc = desc;
+		if (fullDesc.blendState == nullptr)
+			fullDesc.blendState = getDefaultBlendState();
+
+		if (fullDesc.rasterizerState == nullptr)
+			fullDesc.rasterizerState = getDefaultRasterizerState();
+
+		if (fullDesc.depthStencilState == nullptr)
+			fullDesc.depthStencilState = getDefaultDepthStencilState();
+
+		UINT64 hash = PipelineStateCore::generateHash(fullDesc);
+
+		Lock lock(mMutex);
+
+		bool cacheNew = true;
+		auto iterFind = mCachedPipelineStates.find(hash);
+		if (iterFind != mCachedPipelineStates.end())
+		{
+			SPtr<PipelineStateCore> state = iterFind->second.lock();
+			if (state != nullptr)
+			{
+				if (state->mData == fullDesc)
+					return state;
+
+				// Hash collision, keep the existing entry and hand out an uncached state
+				cacheNew = false;
+			}
+		}
+
+		UINT64 id = mNextPipelineStateId++;
+		SPtr<PipelineStateCore> state = bs_shared_ptr<PipelineStateCore>(
+			new (bs_alloc<PipelineStateCore>()) PipelineStateCore(fullDesc, hash, id));
+
+		if (cacheNew)
+			mCachedPipelineStates[hash] = state;
+
+		return state;
+	}
+
 	SPtr<SamplerStateCore> RenderStateCoreManager::_createSamplerState(const SAMPLER_STATE_DESC& desc) const
 	{
 		SPtr<SamplerStateCore> state = findCachedState(desc);
@@ -244,6 +285,8 @@ namespace BansheeEngine
 
 	void RenderStateCoreManager::onShutDown()
 	{
+		mCachedPipelineStates.clear();
+
 		mDefaultBlendState = nullptr;
 		mDefaultDepthStencilState = nullptr;
 		mDefaultRasterizerState = nullptr;
@@ -208,7 +208,7 @@ namespace BansheeEngine
 		BoneWeight* weightDst = buffer;
 		for (UINT32 i = 0; i < numElements; i++)
 		{
-			int* indices = (int*)indexPtr;
+			UINT8* indices = indexPtr;
 			float* weights = (float*)weightPtr;
 
 			weightDst->index0 = indices[0];
@@ -246,13 +246,13 @@ namespace BansheeEngine
 		BoneWeight* weightSrc = buffer;
 		for (UINT32 i = 0; i < numElements; i++)
 		{
-			int* indices = (int*)indexPtr;
+			UINT8* indices = indexPtr;
 			float* weights = (float*)weightPtr;
 
-			indices[0] = weightSrc->index0;
-			indices[1] = weightSrc->index1;
-			indices[2] = weightSrc->index2;
-			indices[3] = weightSrc->index3;
+			indices[0] = (UINT8)weightSrc->index0;
+			indices[1] = (UINT8)weightSrc->index1;
+			indices[2] = (UINT8)weightSrc->index2;
+			indices[3] = (UINT8)weightSrc->index3;
 
 			weights[0] = weightSrc->weight0;
 			weights[1] = weightSrc->weight1;
@@ -18,7 +18,8 @@ namespace BansheeEngine
 		: GameObject(), mPrefabHash(0), mFlags(flags), mPosition(Vector3::ZERO), mRotation(Quaternion::IDENTITY)
 		, mScale(Vector3::ONE), mWorldPosition(Vector3::ZERO), mWorldRotation(Quaternion::IDENTITY)
 		, mWorldScale(Vector3::ONE), mCachedLocalTfrm(Matrix4::IDENTITY), mCachedWorldTfrm(Matrix4::IDENTITY)
-		, mDirtyFlags(0xFFFFFFFF), mDirtyHash(0), mActiveSelf(true), mActiveHierarchy(true)
+		, mDirtyFlags(0xFFFFFFFF), mDirtyHash(0), mNumCoreObjects(0), mCoreObjectsDirty(false), mActiveSelf(true)
+		, mActiveHierarchy(true)
 	{
 		setName(name);
 	}
@@ -438,6 +439,8 @@ namespace BansheeEngine
 		mDirtyFlags |= DirtyFlags::LocalTfrmDirty | DirtyFlags::WorldTfrmDirty;
 		mDirtyHash++;
 
+		markCoreObjectsDirty();
+
 		for(auto& entry : mComponents)
 		{
 			if (entry->supportsNotify(flags))
@@ -448,6 +451,27 @@ namespace BansheeEngine
 			entry->notifyTransformChanged(flags);
 	}
 
+	void SceneObject::markCoreObjectsDirty() const
+	{
+		if (mNumCoreObjects == 0 || mCoreObjectsDirty)
+			return;
+
+		mCoreObjectsDirty = true;
+		gCoreSceneManager()._notifyCoreObjectsDirty(mThisHandle);
+	}
+
+	void SceneObject::_registerCoreObject()
+	{
+		mNumCoreObjects++;
+		markCoreObjectsDirty();
+	}
+
+	void SceneObject::_unregisterCoreObject()
+	{
+		assert(mNumCoreObjects > 0);
+		mNumCoreObjects--;
+	}
+
 	void SceneObject::updateWorldTfrm() const
 	{
 		if(mParent != nullptr)
@@ -651,6 +675,7 @@ namespace BansheeEngine
 		if (mActiveHierarchy != activeHierarchy)
 		{
 			mActiveHierarchy = activeHierarchy;
+			markCoreObjectsDirty();
 
 			if (triggerEvents)
 			{
@@ -0,0 +1,70 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsSkeleton.h"
+#include "BsAnimationClip.h"
+#include "BsBatchMath.h"
+#include "BsException.h"
+
+namespace BansheeEngine
+{
+	Skeleton::Skeleton(const Vector<SkeletonBone>& bones)
+		:mBones(bones)
+	{
+		UINT32 numBones = (UINT32)mBones.size();
+		mInvBindPoses.resize(numBones);
+		mLocalBindPoses.resize(numBones);
+
+		for (UINT32 i = 0; i < numBones; i++)
+		{
+			INT32 parent = mBones[i].parent;
+			if (parent >= (INT32)i)
+				BS_EXCEPT(InvalidParametersException, "Parent bones must come before their children.");
+
+			mInvBindPoses[i] = mBones[i].invBindPose;
+
+			// Transforms from bone space to model space, and then from model space to parent bone space
+			Matrix4 bindPose = mBones[i].invBindPose.inverseAffine();
+			if (parent >= 0)
+				mLocalBindPoses[i] = mBones[parent].invBindPose.concatenateAffine(bindPose);
+			else
+				mLocalBindPoses[i] = bindPose;
+		}
+	}
+
+	void Skeleton::mapBones(const AnimationClip& clip, Vector<INT32>& output) const
+	{
+		UnorderedMap<String, INT32> clipBones;
+		for (UINT32 i = 0; i < clip.getNumBones(); i++)
+			clipBones[clip.getBoneName(i)] = (INT32)i;
+
+		output.resize(mBones.size());
+		for (UINT32 i = 0; i < (UINT32)mBones.size(); i++)
+		{
+			auto iterFind = clipBones.find(mBones[i].name);
+			output[i] = iterFind != clipBones.end() ? iterFind->second : -1;
+		}
+	}
+
+	void Skeleton::getPalette(const Matrix4* pose, Matrix4* palette) const
+	{
+		// Parents always come before children, so a single pass is enough to move all bones into model space
+		UINT32 numBones = (UINT32)mBones.size();
+		for (UINT32 i = 0; i < numBones; i++)
+		{
+			INT32 parent = mBones[i].parent;
+			if (parent >= 0)
+				palette[i] = palette[parent].concatenateAffine(pose[i]);
+			else
+				palette[i] = pose[i];
+		}
+
+		BatchMath::multiplyAffine(palette, mInvBindPoses.data(), palette, numBones);
+	}
+
+	SPtr<Skeleton> Skeleton::create(const Vector<SkeletonBone>& bones)
+	{
+		Skeleton* rawPtr = new (bs_alloc<Skeleton>()) Skeleton(bones);
+
+		return bs_shared_ptr<Skeleton>(rawPtr);
+	}
+}
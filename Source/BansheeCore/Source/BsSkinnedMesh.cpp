@@ -0,0 +1,610 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsSkinnedMesh.h"
+#include "BsSkeleton.h"
+#include "BsAnimationClip.h"
+#include "BsMesh.h"
+#include "BsVertexDataDesc.h"
+#include "BsCoreThread.h"
+#include "BsTaskScheduler.h"
+#include "BsException.h"
+#include "BsMath.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define BS_SKINNING_SSE 1
+#	include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#	define BS_SKINNING_NEON 1
+#	include <arm_neon.h>
+#endif
+
+namespace BansheeEngine
+{
+	namespace
+	{
+		/** Number of vertices processed at once, determining the size of the temporary buffers for blend shapes. */
+		const UINT32 VERTICES_PER_BLOCK = 256;
+
+		/** Number of vertices each mesh is split into, when deforming vertices of multiple meshes in parallel. */
+		const UINT32 VERTICES_PER_GROUP = 1024;
+
+		/** Minimum number of vertices worth deforming in a separate task. */
+		const UINT32 MIN_VERTICES_PER_TASK = 4096;
+
+		/** Minimum number of bones worth calculating the palette for in a separate task. */
+		const UINT32 MIN_BONES_PER_TASK = 512;
+
+		// Minimal set of 4-wide float operations the skinning kernel is written in. Unlike the batch math kernels each
+		// register holds a single matrix column or vector.
+#if BS_SKINNING_SSE
+		typedef __m128 Float4;
+
+		Float4 load4(const float* v) { return _mm_loadu_ps(v); }
+		Float4 load4(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+		void store4(float* v, Float4 a) { _mm_storeu_ps(v, a); }
+		Float4 set4(float v) { return _mm_set1_ps(v); }
+		Float4 add4(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+		Float4 mul4(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+#elif BS_SKINNING_NEON
+		typedef float32x4_t Float4;
+
+		Float4 load4(const float* v) { return vld1q_f32(v); }
+		void store4(float* v, Float4 a) { vst1q_f32(v, a); }
+		Float4 set4(float v) { return vdupq_n_f32(v); }
+		Float4 add4(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+		Float4 mul4(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+
+		Float4 load4(float x, float y, float z, float w)
+		{
+			float v[4] = { x, y, z, w };
+			return vld1q_f32(v);
+		}
+#else
+		struct Float4
+		{
+			float v[4];
+		};
+
+		Float4 load4(const float* v) { return { { v[0], v[1], v[2], v[3] } }; }
+		Float4 load4(float x, float y, float z, float w) { return { { x, y, z, w } }; }
+		void store4(float* v, Float4 a) { v[0] = a.v[0]; v[1] = a.v[1]; v[2] = a.v[2]; v[3] = a.v[3]; }
+		Float4 set4(float v) { return { { v, v, v, v } }; }
+
+		Float4 add4(Float4 a, Float4 b) { return { { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } }; }
+		Float4 mul4(Float4 a, Float4 b) { return { { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] } }; }
+#endif
+
+		/** Returns a * b + c. */
+		Float4 madd4(Float4 a, Float4 b, Float4 c)
+		{
+			return add4(mul4(a, b), c);
+		}
+
+		/** Columns of an affine matrix. Only the first three lanes of each column are used. */
+		struct AffineColumns
+		{
+			Float4 c[4];
+		};
+
+		/** Adds the columns of a transposed matrix, scaled by @p weight, to @p output. */
+		void addWeighted(const Matrix4& transposed, float weight, AffineColumns& output)
+		{
+			Float4 w = set4(weight);
+			output.c[0] = madd4(load4(transposed[0]), w, output.c[0]);
+			output.c[1] = madd4(load4(transposed[1]), w, output.c[1]);
+			output.c[2] = madd4(load4(transposed[2]), w, output.c[2]);
+			output.c[3] = madd4(load4(transposed[3]), w, output.c[3]);
+		}
+
+		/** Transforms a point by an affine matrix. Outputs the result in the first three lanes. */
+		Float4 transformPoint(const AffineColumns& matrix, const Vector3& v)
+		{
+			Float4 output = madd4(matrix.c[0], set4(v.x), matrix.c[3]);
+			output = madd4(matrix.c[1], set4(v.y), output);
+			return madd4(matrix.c[2], set4(v.z), output);
+		}
+
+		/** Transforms a direction by an affine matrix. Outputs the result in the first three lanes. */
+		Float4 transformDirection(const AffineColumns& matrix, float x, float y, float z)
+		{
+			Float4 output = mul4(matrix.c[0], set4(x));
+			output = madd4(matrix.c[1], set4(y), output);
+			return madd4(matrix.c[2], set4(z), output);
+		}
+
+		/** Writes the first three lanes of a register into vertex data. */
+		void storeVector(UINT8* dst, Float4 v)
+		{
+			float values[4];
+			store4(values, v);
+
+			memcpy(dst, values, sizeof(float) * 3);
+		}
+
+		/** Writes the first three lanes of a register into vertex data, normalized. */
+		void storeDirection(UINT8* dst, Float4 v)
+		{
+			float values[4];
+			store4(values, v);
+
+			float length = Math::sqrt(values[0] * values[0] + values[1] * values[1] + values[2] * values[2]);
+			if (length > 1e-08f)
+			{
+				float invLength = 1.0f / length;
+				values[0] *= invLength;
+				values[1] *= invLength;
+				values[2] *= invLength;
+			}
+
+			memcpy(dst, values, sizeof(float) * 3);
+		}
+
+		/**
+		 * Deforms vertices using linear blend skinning. Normal and tangent outputs are optional. Fourth component of the
+		 * tangent, holding the bitangent sign, is left as is.
+		 *
+		 * @param[in]	palette		Transposed bone palette, so the columns of each matrix can be loaded directly.
+		 */
+		void skinVertices(const Matrix4* palette, const BoneWeight* weights, const Vector3* positions,
+			const Vector3* normals, const Vector4* tangents, UINT32 count, UINT8* outPositions, UINT8* outNormals,
+			UINT8* outTangents, UINT32 stride)
+		{
+			for (UINT32 i = 0; i < count; i++)
+			{
+				const BoneWeight& weight = weights[i];
+
+				AffineColumns matrix;
+				Float4 weight0 = set4(weight.weight0);
+				const Matrix4& bone0 = palette[weight.index0];
+				matrix.c[0] = mul4(load4(bone0[0]), weight0);
+				matrix.c[1] = mul4(load4(bone0[1]), weight0);
+				matrix.c[2] = mul4(load4(bone0[2]), weight0);
+				matrix.c[3] = mul4(load4(bone0[3]), weight0);
+
+				// Most vertices are influenced by fewer than four bones
+				if (weight.weight1 != 0.0f)
+					addWeighted(palette[weight.index1], weight.weight1, matrix);
+
+				if (weight.weight2 != 0.0f)
+					addWeighted(palette[weight.index2], weight.weight2, matrix);
+
+				if (weight.weight3 != 0.0f)
+					addWeighted(palette[weight.index3], weight.weight3, matrix);
+
+				storeVector(outPositions, transformPoint(matrix, positions[i]));
+				outPositions += stride;
+
+				if (outNormals != nullptr)
+				{
+					const Vector3& normal = normals[i];
+					storeDirection(outNormals, transformDirection(matrix, normal.x, normal.y, normal.z));
+					outNormals += stride;
+				}
+
+				if (outTangents != nullptr)
+				{
+					const Vector4& tangent = tangents[i];
+					storeDirection(outTangents, transformDirection(matrix, tangent.x, tangent.y, tangent.z));
+					memcpy(outTangents + sizeof(float) * 3, &tangent.w, sizeof(float));
+					outTangents += stride;
+				}
+			}
+		}
+
+		/** Writes vertices into vertex data as is. Normal and tangent outputs are optional. */
+		void copyVertices(const Vector3* positions, const Vector3* normals, const Vector4* tangents, UINT32 count,
+			UINT8* outPositions, UINT8* outNormals, UINT8* outTangents, UINT32 stride)
+		{
+			for (UINT32 i = 0; i < count; i++)
+			{
+				memcpy(outPositions, &positions[i], sizeof(Vector3));
+				outPositions += stride;
+
+				if (outNormals != nullptr)
+				{
+					// Blend shapes don't keep the normals unit length
+					const Vector3& normal = normals[i];
+					storeDirection(outNormals, load4(normal.x, normal.y, normal.z, 0.0f));
+					outNormals += stride;
+				}
+
+				if (outTangents != nullptr)
+				{
+					memcpy(outTangents, &tangents[i], sizeof(Vector4));
+					outTangents += stride;
+				}
+			}
+		}
+
+		/**
+		 * Applies blend shapes to vertices in range [@p start, @p start + @p count). Outputs the blended vertices in
+		 * @p outPositions and @p outNormals, and returns true, unless none of the vertices is affected by the shapes.
+		 */
+		bool applyBlendShapes(const Vector<BlendShape>& shapes, const Vector<float>& weights, const Vector3* positions,
+			const Vector3* normals, UINT32 start, UINT32 count, Vector3* outPositions, Vector3* outNormals)
+		{
+			bool modified = false;
+			UINT32 end = start + count;
+
+			for (UINT32 i = 0; i < (UINT32)shapes.size(); i++)
+			{
+				float weight = weights[i];
+				if (weight == 0.0f)
+					continue;
+
+				// Shape vertices are sorted by index
+				const Vector<BlendShapeVertex>& vertices = shapes[i].vertices;
+				auto iter = std::lower_bound(vertices.begin(), vertices.end(), start,
+					[](const BlendShapeVertex& vertex, UINT32 index) { return vertex.index < index; });
+
+				if (iter == vertices.end() || iter->index >= end)
+					continue;
+
+				if (!modified)
+				{
+					memcpy(outPositions, positions, count * sizeof(Vector3));
+
+					if (normals != nullptr)
+						memcpy(outNormals, normals, count * sizeof(Vector3));
+
+					modified = true;
+				}
+
+				for (; iter != vertices.end() && iter->index < end; ++iter)
+				{
+					UINT32 idx = iter->index - start;
+					outPositions[idx] += iter->positionOffset * weight;
+
+					if (normals != nullptr)
+						outNormals[idx] += iter->normalOffset * weight;
+				}
+			}
+
+			return modified;
+		}
+
+		/**
+		 * Checks if the vertex description contains the specified element, and that it's of the expected type. Throws an
+		 * exception if the element is of a different type, or if it's required but missing.
+		 */
+		bool checkElement(const VertexDataDesc& desc, VertexElementSemantic semantic, VertexElementType type,
+			bool required, const char* name)
+		{
+			for (UINT32 i = 0; i < desc.getNumElements(); i++)
+			{
+				const VertexElement& element = desc.getElement(i);
+				if (element.getSemantic() != semantic || element.getSemanticIdx() != 0)
+					continue;
+
+				if (element.getStreamIdx() != 0)
+					BS_EXCEPT(InvalidParametersException, "Skinned mesh " + String(name) + " must be in the first stream.");
+
+				if (element.getType() != type)
+					BS_EXCEPT(InvalidParametersException, "Unsupported format of skinned mesh " + String(name) + ".");
+
+				return true;
+			}
+
+			if (required)
+				BS_EXCEPT(InvalidParametersException, "Skinned mesh is missing " + String(name) + ".");
+
+			return false;
+		}
+	}
+
+	SkinnedMesh::SkinnedMesh(const SPtr<MeshData>& meshData, const Vector<SubMesh>& subMeshes,
+		const SPtr<Skeleton>& skeleton, const Vector<BlendShape>& blendShapes)
+		:mSkeleton(skeleton), mWriteBuffer(0), mHasDeformedData(false), mBlendShapes(blendShapes)
+		, mBlendShapesDirty(false), mPoseDirty(true)
+	{
+		const VertexDataDesc& desc = *meshData->getVertexDesc();
+		UINT32 numVertices = meshData->getNumVertices();
+		UINT32 stride = desc.getVertexStride(0);
+
+		checkElement(desc, VES_POSITION, VET_FLOAT3, true, "positions");
+		mPositions.resize(numVertices);
+
+		UINT8* positionData = meshData->getElementData(VES_POSITION);
+		for (UINT32 i = 0; i < numVertices; i++)
+			memcpy(&mPositions[i], positionData + i * stride, sizeof(Vector3));
+
+		if (checkElement(desc, VES_NORMAL, VET_FLOAT3, false, "normals"))
+		{
+			mNormals.resize(numVertices);
+
+			UINT8* normalData = meshData->getElementData(VES_NORMAL);
+			for (UINT32 i = 0; i < numVertices; i++)
+				memcpy(&mNormals[i], normalData + i * stride, sizeof(Vector3));
+		}
+
+		if (checkElement(desc, VES_TANGENT, VET_FLOAT4, false, "tangents"))
+		{
+			mTangents.resize(numVertices);
+
+			UINT8* tangentData = meshData->getElementData(VES_TANGENT);
+			for (UINT32 i = 0; i < numVertices; i++)
+				memcpy(&mTangents[i], tangentData + i * stride, sizeof(Vector4));
+		}
+
+		if (mSkeleton != nullptr)
+		{
+			checkElement(desc, VES_BLEND_INDICES, VET_UBYTE4, true, "bone indices");
+			checkElement(desc, VES_BLEND_WEIGHTS, VET_FLOAT4, true, "bone weights");
+
+			UINT32 numBones = mSkeleton->getNumBones();
+			mBoneWeights.resize(numVertices);
+
+			UINT8* indexData = meshData->getElementData(VES_BLEND_INDICES);
+			UINT8* weightData = meshData->getElementData(VES_BLEND_WEIGHTS);
+			for (UINT32 i = 0; i < numVertices; i++)
+			{
+				const UINT8* indices = indexData + i * stride;
+				float weights[4];
+				memcpy(weights, weightData + i * stride, sizeof(weights));
+
+				if (indices[0] >= numBones || indices[1] >= numBones || indices[2] >= numBones || indices[3] >= numBones)
+					BS_EXCEPT(InvalidParametersException, "Skinned mesh references a bone not in the skeleton.");
+
+				BoneWeight& weight = mBoneWeights[i];
+				weight.index0 = indices[0];
+				weight.index1 = indices[1];
+				weight.index2 = indices[2];
+				weight.index3 = indices[3];
+				weight.weight0 = weights[0];
+				weight.weight1 = weights[1];
+				weight.weight2 = weights[2];
+				weight.weight3 = weights[3];
+			}
+
+			mPose.resize(numBones);
+			mPalette.resize(numBones);
+			mTransposedPalette.resize(numBones);
+
+			for (UINT32 i = 0; i < numBones; i++)
+				mPose[i] = mSkeleton->getLocalBindPose(i);
+		}
+
+		for (auto& shape : mBlendShapes)
+		{
+			std::sort(shape.vertices.begin(), shape.vertices.end(),
+				[](const BlendShapeVertex& a, const BlendShapeVertex& b) { return a.index < b.index; });
+
+			if (!shape.vertices.empty() && shape.vertices.back().index >= numVertices)
+				BS_EXCEPT(InvalidParametersException, "Blend shape \"" + shape.name + "\" references a vertex not in the mesh.");
+		}
+
+		mBlendShapeWeights.resize(mBlendShapes.size(), 0.0f);
+
+		// Vertex data other than positions, normals and tangents is never modified, so copy it once
+		for (UINT32 i = 0; i < 2; i++)
+		{
+			mBuffers[i] = MeshData::create(numVertices, meshData->getNumIndices(), meshData->getVertexDesc(),
+				meshData->getIndexType());
+			memcpy(mBuffers[i]->getData(), meshData->getData(), meshData->getSize());
+		}
+
+		mMesh = Mesh::create(meshData, subMeshes, MU_DYNAMIC);
+	}
+
+	SPtr<MeshData> SkinnedMesh::getDeformedData() const
+	{
+		if (!mHasDeformedData)
+			return nullptr;
+
+		return mBuffers[mWriteBuffer ^ 1];
+	}
+
+	void SkinnedMesh::setBlendShapeWeight(UINT32 idx, float weight)
+	{
+		if (mBlendShapeWeights[idx] == weight)
+			return;
+
+		mBlendShapeWeights[idx] = weight;
+		mBlendShapesDirty = true;
+	}
+
+	void SkinnedMesh::setPose(const AnimationClipState& state)
+	{
+		if (mSkeleton == nullptr || state.clip == nullptr || state.bones.empty())
+			return;
+
+		if (mMappedClip != state.clip)
+		{
+			mSkeleton->mapBones(*state.clip, mBoneMapping);
+			mMappedClip = state.clip;
+		}
+
+		UINT32 numBones = mSkeleton->getNumBones();
+		for (UINT32 i = 0; i < numBones; i++)
+		{
+			INT32 clipBone = mBoneMapping[i];
+			if (clipBone < 0)
+			{
+				mPose[i] = mSkeleton->getLocalBindPose(i);
+				continue;
+			}
+
+			const BoneTransform& transform = state.bones[clipBone];
+			mPose[i] = Matrix4::TRS(transform.position, transform.rotation, transform.scale);
+		}
+
+		mPoseDirty = true;
+	}
+
+	void SkinnedMesh::updatePalette()
+	{
+		mSkeleton->getPalette(mPose.data(), mPalette.data());
+
+		for (UINT32 i = 0; i < (UINT32)mPalette.size(); i++)
+			mTransposedPalette[i] = mPalette[i].transpose();
+	}
+
+	bool SkinnedMesh::beginUpdate()
+	{
+		bool deform = mBlendShapesDirty || isPaletteDirty();
+
+		mPoseDirty = false;
+		mBlendShapesDirty = false;
+
+		if (!deform)
+			return false;
+
+		// Core thread hasn't yet uploaded the buffer queued two updates ago, use a new one instead of waiting on it
+		SPtr<MeshData>& buffer = mBuffers[mWriteBuffer];
+		if (buffer->isLocked())
+		{
+			const SPtr<MeshData>& other = mBuffers[mWriteBuffer ^ 1];
+
+			buffer = MeshData::create(other->getNumVertices(), other->getNumIndices(), other->getVertexDesc(),
+				other->getIndexType());
+			memcpy(buffer->getData(), other->getData(), other->getSize());
+		}
+
+		return true;
+	}
+
+	void SkinnedMesh::deform(UINT32 start, UINT32 end) const
+	{
+		MeshData& output = *mBuffers[mWriteBuffer];
+		UINT32 stride = output.getVertexDesc()->getVertexStride(0);
+
+		UINT8* outPositions = output.getElementData(VES_POSITION) + start * stride;
+		UINT8* outNormals = nullptr;
+		UINT8* outTangents = nullptr;
+
+		if (!mNormals.empty())
+			outNormals = output.getElementData(VES_NORMAL) + start * stride;
+
+		bool skin = mSkeleton != nullptr;
+
+		// Tangents are only changed by skinning
+		if (!mTangents.empty() && skin)
+			outTangents = output.getElementData(VES_TANGENT) + start * stride;
+
+		Vector3 blendedPositions[VERTICES_PER_BLOCK];
+		Vector3 blendedNormals[VERTICES_PER_BLOCK];
+
+		for (UINT32 blockStart = start; blockStart < end; blockStart += VERTICES_PER_BLOCK)
+		{
+			UINT32 count = std::min(VERTICES_PER_BLOCK, end - blockStart);
+
+			const Vector3* positions = &mPositions[blockStart];
+			const Vector3* normals = mNormals.empty() ? nullptr : &mNormals[blockStart];
+			const Vector4* tangents = mTangents.empty() ? nullptr : &mTangents[blockStart];
+
+			if (applyBlendShapes(mBlendShapes, mBlendShapeWeights, positions, normals, blockStart, count,
+				blendedPositions, blendedNormals))
+			{
+				positions = blendedPositions;
+
+				if (normals != nullptr)
+					normals = blendedNormals;
+			}
+
+			if (skin)
+			{
+				skinVertices(mTransposedPalette.data(), &mBoneWeights[blockStart], positions, normals, tangents, count,
+					outPositions, outNormals, outTangents, stride);
+			}
+			else
+				copyVertices(positions, normals, tangents, count, outPositions, outNormals, outTangents, stride);
+
+			outPositions += count * stride;
+
+			if (outNormals != nullptr)
+				outNormals += count * stride;
+
+			if (outTangents != nullptr)
+				outTangents += count * stride;
+		}
+	}
+
+	void SkinnedMesh::endUpdate()
+	{
+		mMesh->writeSubresource(gCoreAccessor(), 0, mBuffers[mWriteBuffer], true);
+
+		mWriteBuffer ^= 1;
+		mHasDeformedData = true;
+	}
+
+	void SkinnedMesh::update()
+	{
+		SkinnedMesh* mesh = this;
+		update(&mesh, 1);
+	}
+
+	void SkinnedMesh::update(SkinnedMesh* const* meshes, UINT32 count)
+	{
+		struct VertexGroup
+		{
+			const SkinnedMesh* mesh;
+			UINT32 start;
+			UINT32 end;
+		};
+
+		// Palettes of different meshes don't depend on each other, so calculate them all in parallel first
+		Vector<SkinnedMesh*> posedMeshes;
+		UINT32 numBones = 0;
+
+		for (UINT32 i = 0; i < count; i++)
+		{
+			SkinnedMesh* mesh = meshes[i];
+			if (!mesh->isPaletteDirty())
+				continue;
+
+			posedMeshes.push_back(mesh);
+			numBones += mesh->mSkeleton->getNumBones();
+		}
+
+		UINT32 numPosedMeshes = (UINT32)posedMeshes.size();
+		SkinnedMesh* const* posedMeshData = posedMeshes.data();
+
+		// Work is split by bones, but never into more tasks than there are meshes
+		UINT32 numPaletteTasks = TaskScheduler::getNumTasks(numBones, MIN_BONES_PER_TASK);
+		TaskScheduler::runParallel("SkinningPalette", numPosedMeshes, numPaletteTasks,
+			[posedMeshData](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i++)
+				posedMeshData[i]->updatePalette();
+		});
+
+		Vector<SkinnedMesh*> updatedMeshes;
+		Vector<VertexGroup> groups;
+		UINT32 numVertices = 0;
+
+		for (UINT32 i = 0; i < count; i++)
+		{
+			SkinnedMesh* mesh = meshes[i];
+			if (!mesh->beginUpdate())
+				continue;
+
+			UINT32 meshVertices = (UINT32)mesh->mPositions.size();
+			for (UINT32 j = 0; j < meshVertices; j += VERTICES_PER_GROUP)
+				groups.push_back({ mesh, j, std::min(j + VERTICES_PER_GROUP, meshVertices) });
+
+			updatedMeshes.push_back(mesh);
+			numVertices += meshVertices;
+		}
+
+		UINT32 numGroups = (UINT32)groups.size();
+		const VertexGroup* groupData = groups.data();
+
+		UINT32 numSkinningTasks = TaskScheduler::getNumTasks(numVertices, MIN_VERTICES_PER_TASK);
+		TaskScheduler::runParallel("Skinning", numGroups, numSkinningTasks, [groupData](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i++)
+				groupData[i].mesh->deform(groupData[i].start, groupData[i].end);
+		});
+
+		for (auto& mesh : updatedMeshes)
+			mesh->endUpdate();
+	}
+
+	SPtr<SkinnedMesh> SkinnedMesh::create(const SPtr<MeshData>& meshData, const Vector<SubMesh>& subMeshes,
+		const SPtr<Skeleton>& skeleton, const Vector<BlendShape>& blendShapes)
+	{
+		SkinnedMesh* rawPtr = new (bs_alloc<SkinnedMesh>()) SkinnedMesh(meshData, subMeshes, skeleton, blendShapes);
+
+		return bs_shared_ptr<SkinnedMesh>(rawPtr);
+	}
+}
@@ -27,6 +27,40 @@ namespace BansheeEngine
 
 	Platform::Pimpl* Platform::mData = bs_new<Platform::Pimpl>();
 
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+	/** Waitable timer used by sleepPrecise(). Created once per thread and closed when the thread exits. */
+	struct ThreadWaitableTimer
+	{
+		ThreadWaitableTimer()
+		{
+			// High resolution timers are only supported on Windows 10 (1803) and newer, fall back to a normal waitable 
+			// timer (whose resolution depends on the system timer granularity) otherwise
+			handle = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+			highResolution = handle != nullptr;
+
+			if (handle == nullptr)
+				handle = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+		}
+
+		~ThreadWaitableTimer()
+		{
+			if (handle != nullptr)
+				CloseHandle(handle);
+		}
+
+		HANDLE handle;
+		bool highResolution;
+	};
+
+	/** 
+	 * Time (in microseconds) at the end of a precise sleep that is busy-waited when no high resolution timer is 
+	 * available. Covers the 1 millisecond system timer granularity set on start up, plus the scheduling delay.
+	 */
+	const UINT64 LOW_RES_TIMER_SPIN_TIME = 2000;
+
 	Platform::~Platform()
 	{
 		bs_delete(mData);
@@ -245,6 +279,49 @@ namespace BansheeEngine
 		Sleep((DWORD)duration);
 	}
 
+	void Platform::sleepPrecise(UINT64 duration)
+	{
+		static thread_local ThreadWaitableTimer timer;
+
+		if (timer.handle == nullptr)
+		{
+			Sleep((DWORD)(duration / 1000));
+			return;
+		}
+
+		LARGE_INTEGER frequency;
+		LARGE_INTEGER startTime;
+		QueryPerformanceFrequency(&frequency);
+		QueryPerformanceCounter(&startTime);
+
+		// Low resolution timers can wake up late by up to the system timer granularity, so wake up early and spin
+		// for the rest of the wait instead
+		UINT64 sleepDuration = duration;
+		if (!timer.highResolution)
+			sleepDuration = duration > LOW_RES_TIMER_SPIN_TIME ? duration - LOW_RES_TIMER_SPIN_TIME : 0;
+
+		if (sleepDuration > 0)
+		{
+			// Negative values represent relative time, in 100 nanosecond intervals
+			LARGE_INTEGER dueTime;
+			dueTime.QuadPart = -(LONGLONG)(sleepDuration * 10);
+
+			if (SetWaitableTimer(timer.handle, &dueTime, 0, nullptr, nullptr, FALSE))
+				WaitForSingleObject(timer.handle, INFINITE);
+		}
+
+		if (!timer.highResolution)
+		{
+			LONGLONG endTime = startTime.QuadPart + (LONGLONG)(duration * frequency.QuadPart / 1000000);
+
+			LARGE_INTEGER currentTime;
+			do
+			{
+				QueryPerformanceCounter(&currentTime);
+			} while (currentTime.QuadPart < endTime);
+		}
+	}
+
 	OSDropTarget& Platform::createDropTarget(const RenderWindow* window, int x, int y, unsigned int width, unsigned int height)
 	{
 		Win32DropTarget* win32DropTarget = nullptr;
@@ -23,6 +23,14 @@ namespace BansheeEngine
 		/**	Returns unique GPU program ID. */
 		UINT32 getProgramId() const { return mProgramId; }
 
+		/**
+		 * Compiles HLSL source into microcode. Returns null and outputs an error message if compilation fails.
+		 *
+		 * @note	Thread safe.
+		 */
+		static ID3DBlob* compileMicrocode(const String& source, const String& entryPoint, const String& profile,
+			bool backwardsCompatibility, String& errorMessage);
+
 	protected:
 		D3D11GpuProgramCore(const String& source, const String& entryPoint, GpuProgramType gptype,
 			GpuProgramProfile profile, bool isAdjacencyInfoRequired);
@@ -36,6 +44,14 @@ namespace BansheeEngine
 		/**	Compiles the shader from source and generates the microcode. */
 		ID3DBlob* compileMicrocode(const String& profile);
 
+		/** 
+		 * Attempts to load previously compiled microcode from the program cache. Returns null if not found. 
+		 *
+		 * @param[out]	compiled	True if the microcode was compiled for this program by 
+		 *							GpuProgramCoreManager::precompile(), rather than loaded from an existing binary.
+		 */
+		ID3DBlob* loadCachedMicrocode(bool& compiled);
+
 		/**
 		 * Reflects the microcode and extracts input/output parameters, and constant buffer structures used by the program.
 		 */
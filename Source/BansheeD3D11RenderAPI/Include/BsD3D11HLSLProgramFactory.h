@@ -28,7 +28,16 @@ namespace BansheeEngine
 		/** @copydoc GpuProgramFactory::create(GpuProgramType) */
 		SPtr<GpuProgramCore> create(GpuProgramType type) override;
 
+		/** @copydoc GpuProgramFactory::getBinaryVersion */
+		String getBinaryVersion() const override;
+
+		/** @copydoc GpuProgramFactory::compileBinary */
+		bool compileBinary(const String& source, const String& entryPoint, GpuProgramType gptype,
+			GpuProgramProfile profile, bool requiresAdjacency, Vector<UINT8>& output) override;
+
 	protected:
+		friend class D3D11GpuProgramCore;
+
 		static const String LANGUAGE_NAME;
 	};
 
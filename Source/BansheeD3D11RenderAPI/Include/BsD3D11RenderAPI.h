@@ -43,6 +43,9 @@ namespace BansheeEngine
 		void setLoadStoreTexture(GpuProgramType gptype, UINT16 texUnit, bool enabled, const SPtr<TextureCore>& texPtr,
 			const TextureSurface& surface) override;
 
+		/** @copydoc RenderAPICore::setBuffer */
+		void setBuffer(GpuProgramType gptype, UINT16 unit, const SPtr<GpuBufferCore>& buffer, bool loadStore = false) override;
+
 		/** @copydoc RenderAPICore::disableTextureUnit */
 		void disableTextureUnit(GpuProgramType gptype, UINT16 texUnit) override;
 
@@ -159,6 +162,12 @@ namespace BansheeEngine
 		 */
 		void applyViewport();
 
+		/**
+		 * Binds the unordered access views used by fragment programs. Render targets and unordered access views share
+		 * the same output slots, so only views in slots after the last bound render target can be bound.
+		 */
+		void applyFragmentUAVs();
+
 		/** Creates and populates a set of render system capabilities describing which functionality is available. */
 		RenderAPICapabilities* createRenderSystemCapabilities() const;
 
@@ -175,6 +184,10 @@ namespace BansheeEngine
 		D3D11InputLayoutManager* mIAManager;
 
 		std::pair<SPtr<TextureCore>, SPtr<TextureView>> mBoundUAVs[D3D11_PS_CS_UAV_REGISTER_COUNT];
+		UnorderedMap<UINT32, GpuBufferView*> mBoundBuffers;
+
+		ID3D11UnorderedAccessView* mFragmentUAVs[D3D11_PS_CS_UAV_REGISTER_COUNT];
+		UINT32 mNumBoundRenderTargets;
 
 		UINT32 mStencilRef;
 		Rect2 mViewportNorm;
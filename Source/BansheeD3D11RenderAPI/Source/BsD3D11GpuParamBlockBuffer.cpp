@@ -50,6 +50,7 @@ namespace BansheeEngine
 		mBuffer->writeData(0, mSize, data, BufferWriteType::Discard);
 
 		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_GpuParamBuffer);
+		BS_ADD_RENDER_STAT(NumGpuParamBytesUploaded, mSize);
 	}
 
 	void D3D11GpuParamBlockBufferCore::readFromGPU(UINT8* data) const
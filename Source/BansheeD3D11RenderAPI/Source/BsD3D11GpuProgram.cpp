@@ -10,6 +10,8 @@
 #include "BsHardwareBufferManager.h"
 #include "BsD3D11HLSLParamParser.h"
 #include "BsRenderStats.h"
+#include "BsD3D11HLSLProgramFactory.h"
+#include "BsTimer.h"
 
 namespace BansheeEngine
 {
@@ -45,10 +47,29 @@ namespace BansheeEngine
 		D3D11RenderAPI* rs = static_cast<D3D11RenderAPI*>(RenderAPICore::instancePtr());
 		String hlslProfile = rs->getCapabilities()->gpuProgProfileToRSSpecificProfile(mProperties.getProfile());
 
-		ID3DBlob* microcode = compileMicrocode(hlslProfile);
+		GpuProgramCoreManager& programManager = GpuProgramCoreManager::instance();
+		Timer timer;
+
+		// Backwards compatible programs are compiled with different flags, so don't bother caching them
+		ID3DBlob* microcode = nullptr;
+		bool precompiled = false;
+		if (!mEnableBackwardsCompatibility)
+			microcode = loadCachedMicrocode(precompiled);
+
+		bool fromCache = microcode != nullptr;
+		if (!fromCache)
+			microcode = compileMicrocode(hlslProfile);
+
+		programManager._notifyProgramCreated(timer.getMicroseconds(), fromCache && !precompiled);
 
 		if (microcode != nullptr)
 		{
+			if (!fromCache && !mEnableBackwardsCompatibility)
+			{
+				programManager._cacheBinary(D3D11HLSLProgramFactory::LANGUAGE_NAME, *this, 
+					(UINT8*)microcode->GetBufferPointer(), (UINT32)microcode->GetBufferSize());
+			}
+
 			mMicrocode.resize(microcode->GetBufferSize());
 			memcpy(&mMicrocode[0], microcode->GetBufferPointer(), microcode->GetBufferSize());
 
@@ -66,6 +87,16 @@ namespace BansheeEngine
 	}
 
 	ID3DBlob* D3D11GpuProgramCore::compileMicrocode(const String& profile)
+	{
+		ID3DBlob* microCode = compileMicrocode(mProperties.getSource(), mProperties.getEntryPoint(), profile, 
+			mEnableBackwardsCompatibility, mCompileError);
+
+		mIsCompiled = microCode != nullptr;
+		return microCode;
+	}
+
+	ID3DBlob* D3D11GpuProgramCore::compileMicrocode(const String& source, const String& entryPoint, 
+		const String& profile, bool backwardsCompatibility, String& errorMessage)
 	{
 		// TODO - Preprocessor defines aren't supported
 
@@ -77,15 +108,12 @@ namespace BansheeEngine
 
 		compileFlags |= D3DCOMPILE_PACK_MATRIX_ROW_MAJOR;
 
-		if (mEnableBackwardsCompatibility)
+		if (backwardsCompatibility)
 			compileFlags |= D3DCOMPILE_ENABLE_BACKWARDS_COMPATIBILITY;
 
 		ID3DBlob* microCode = nullptr;
 		ID3DBlob* errors = nullptr;
 
-		const String& source = mProperties.getSource();
-		const String& entryPoint = mProperties.getEntryPoint();
-
 		HRESULT hr = D3DCompile(
 			source.c_str(),		// [in] Pointer to the shader in memory. 
 			source.size(),		// [in] Size of the shader in memory.  
@@ -102,8 +130,7 @@ namespace BansheeEngine
 
 		if (FAILED(hr))
 		{
-			mIsCompiled = false;
-			mCompileError = "Cannot compile D3D11 high-level shader. Errors:\n" +
+			errorMessage = "Cannot compile D3D11 high-level shader. Errors:\n" +
 				String(static_cast<const char*>(errors->GetBufferPointer()));
 
 			SAFE_RELEASE(microCode);
@@ -112,14 +139,35 @@ namespace BansheeEngine
 		}
 		else
 		{
-			mIsCompiled = true;
-			mCompileError = "";
+			errorMessage = "";
 
 			SAFE_RELEASE(errors);
 			return microCode;
 		}
 	}
 
+	ID3DBlob* D3D11GpuProgramCore::loadCachedMicrocode(bool& compiled)
+	{
+		Vector<UINT8> binary;
+		if (!GpuProgramCoreManager::instance()._findCachedBinary(D3D11HLSLProgramFactory::LANGUAGE_NAME, *this, binary,
+			compiled))
+		{
+			return nullptr;
+		}
+
+		ID3DBlob* microcode = nullptr;
+		HRESULT hr = D3DCreateBlob(binary.size(), &microcode);
+		if (FAILED(hr))
+			return nullptr;
+
+		memcpy(microcode->GetBufferPointer(), binary.data(), binary.size());
+
+		mIsCompiled = true;
+		mCompileError = "";
+
+		return microcode;
+	}
+
 	void D3D11GpuProgramCore::populateParametersAndConstants(ID3DBlob* microcode)
 	{
 		assert(microcode != nullptr);
@@ -2,6 +2,7 @@
 //**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
 #include "BsD3D11HLSLProgramFactory.h"
 #include "BsD3D11GpuProgram.h"
+#include "BsRenderAPI.h"
 
 namespace BansheeEngine
 {
@@ -96,4 +97,32 @@ namespace BansheeEngine
 
 		return gpuProg;
 	}
-}
\ No newline at end of file
+
+	String D3D11HLSLProgramFactory::getBinaryVersion() const
+	{
+		// Programs are compiled with different flags in debug mode
+#if defined(BS_DEBUG_MODE)
+		return "D3D11_" + toString(D3D_COMPILER_VERSION) + "_Debug";
+#else
+		return "D3D11_" + toString(D3D_COMPILER_VERSION);
+#endif
+	}
+
+	bool D3D11HLSLProgramFactory::compileBinary(const String& source, const String& entryPoint, GpuProgramType gptype,
+		GpuProgramProfile profile, bool requiresAdjacency, Vector<UINT8>& output)
+	{
+		RenderAPICore* rapi = RenderAPICore::instancePtr();
+		String hlslProfile = rapi->getCapabilities()->gpuProgProfileToRSSpecificProfile(profile);
+
+		String errorMessage;
+		ID3DBlob* microcode = D3D11GpuProgramCore::compileMicrocode(source, entryPoint, hlslProfile, false, errorMessage);
+		if (microcode == nullptr)
+			return false;
+
+		output.resize(microcode->GetBufferSize());
+		memcpy(output.data(), microcode->GetBufferPointer(), microcode->GetBufferSize());
+
+		SAFE_RELEASE(microcode);
+		return true;
+	}
+}
@@ -21,6 +21,8 @@
 #include "BsD3D11GpuParamBlockBuffer.h"
 #include "BsD3D11InputLayoutManager.h"
 #include "BsD3D11TextureView.h"
+#include "BsD3D11GpuBuffer.h"
+#include "BsD3D11GpuBufferView.h"
 #include "BsD3D11RenderUtility.h"
 #include "BsGpuParams.h"
 #include "BsCoreThread.h"
@@ -36,10 +38,11 @@ namespace BansheeEngine
 		: mDXGIFactory(nullptr), mDevice(nullptr), mDriverList(nullptr)
 		, mActiveD3DDriver(nullptr), mFeatureLevel(D3D_FEATURE_LEVEL_11_0)
 		, mHLSLFactory(nullptr), mIAManager(nullptr)
-		, mStencilRef(0), mActiveDrawOp(DOT_TRIANGLE_LIST)
+		, mNumBoundRenderTargets(0), mStencilRef(0), mActiveDrawOp(DOT_TRIANGLE_LIST)
 		, mViewportNorm(0.0f, 0.0f, 1.0f, 1.0f)
 	{
 		mClipPlanesDirty = false; // DX11 handles clip planes through shaders
+		memset(mFragmentUAVs, 0, sizeof(mFragmentUAVs));
 	}
 
 	D3D11RenderAPI::~D3D11RenderAPI()
@@ -156,6 +159,11 @@ namespace BansheeEngine
 				boundUAV.first->releaseView(boundUAV.second);
 		}
 
+		for (auto& boundBuffer : mBoundBuffers)
+			GpuBufferCore::releaseView(boundBuffer.second);
+
+		mBoundBuffers.clear();
+
 		QueryManager::shutDown();
 		D3D11RenderUtility::shutDown();
 
@@ -244,6 +252,8 @@ namespace BansheeEngine
 	{
 		THROW_IF_NOT_CORE_THREAD;
 
+		mActivePipelineStateId = 0;
+
 		D3D11BlendStateCore* d3d11BlendState = static_cast<D3D11BlendStateCore*>(const_cast<BlendStateCore*>(blendState.get()));
 		mDevice->getImmediateContext()->OMSetBlendState(d3d11BlendState->getInternal(), nullptr, 0xFFFFFFFF);
 
@@ -254,6 +264,8 @@ namespace BansheeEngine
 	{
 		THROW_IF_NOT_CORE_THREAD;
 
+		mActivePipelineStateId = 0;
+
 		D3D11RasterizerStateCore* d3d11RasterizerState = static_cast<D3D11RasterizerStateCore*>(const_cast<RasterizerStateCore*>(rasterizerState.get()));
 		mDevice->getImmediateContext()->RSSetState(d3d11RasterizerState->getInternal());
 
@@ -264,6 +276,8 @@ namespace BansheeEngine
 	{
 		THROW_IF_NOT_CORE_THREAD;
 
+		mActivePipelineStateId = 0;
+
 		D3D11DepthStencilStateCore* d3d11RasterizerState = static_cast<D3D11DepthStencilStateCore*>(const_cast<DepthStencilStateCore*>(depthStencilState.get()));
 		mDevice->getImmediateContext()->OMSetDepthStencilState(d3d11RasterizerState->getInternal(), stencilRefValue);
 
@@ -345,8 +359,8 @@ namespace BansheeEngine
 
 		if (gptype == GPT_FRAGMENT_PROGRAM)
 		{
-			mDevice->getImmediateContext()->OMSetRenderTargetsAndUnorderedAccessViews(
-				D3D11_KEEP_RENDER_TARGETS_AND_DEPTH_STENCIL, nullptr, nullptr, unit, 1, viewArray, nullptr);
+			mFragmentUAVs[unit] = viewArray[0];
+			applyFragmentUAVs();
 		}
 		else if (gptype == GPT_COMPUTE_PROGRAM)
 		{
@@ -358,6 +372,99 @@ namespace BansheeEngine
 		BS_INC_RENDER_STAT(NumTextureBinds);
 	}
 
+	void D3D11RenderAPI::setBuffer(GpuProgramType gptype, UINT16 unit, const SPtr<GpuBufferCore>& buffer, bool loadStore)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		UINT32 bindKey = (UINT32)gptype * D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT + unit;
+		if (loadStore)
+			bindKey |= 0x80000000;
+
+		// Release the view of the previously bound buffer, if any
+		auto iterFind = mBoundBuffers.find(bindKey);
+		if (iterFind != mBoundBuffers.end())
+		{
+			GpuBufferCore::releaseView(iterFind->second);
+			mBoundBuffers.erase(iterFind);
+		}
+
+		if (loadStore)
+		{
+			ID3D11UnorderedAccessView* viewArray[1];
+			if (buffer != nullptr)
+			{
+				const GpuBufferProperties& props = buffer->getProperties();
+
+				GpuBufferView* view = GpuBufferCore::requestView(buffer, 0, props.getElementSize(), props.getElementCount(),
+					false, GVU_RANDOMWRITE);
+
+				D3D11GpuBufferView* d3d11View = static_cast<D3D11GpuBufferView*>(view);
+				viewArray[0] = d3d11View->getUAV();
+
+				mBoundBuffers[bindKey] = view;
+			}
+			else
+				viewArray[0] = nullptr;
+
+			if (gptype == GPT_FRAGMENT_PROGRAM)
+			{
+				mFragmentUAVs[unit] = viewArray[0];
+				applyFragmentUAVs();
+			}
+			else if (gptype == GPT_COMPUTE_PROGRAM)
+			{
+				mDevice->getImmediateContext()->CSSetUnorderedAccessViews(unit, 1, viewArray, nullptr);
+			}
+			else
+				BS_EXCEPT(InvalidParametersException, "Unsupported gpu program type: " + toString(gptype));
+
+			BS_INC_RENDER_STAT(NumTextureBinds);
+			return;
+		}
+
+		ID3D11ShaderResourceView* viewArray[1];
+		if (buffer != nullptr)
+		{
+			const GpuBufferProperties& props = buffer->getProperties();
+
+			GpuBufferView* view = GpuBufferCore::requestView(buffer, 0, props.getElementSize(), props.getElementCount(), 
+				false, GVU_DEFAULT);
+
+			D3D11GpuBufferView* d3d11View = static_cast<D3D11GpuBufferView*>(view);
+			viewArray[0] = d3d11View->getSRV();
+
+			mBoundBuffers[bindKey] = view;
+		}
+		else
+			viewArray[0] = nullptr;
+
+		switch (gptype)
+		{
+		case GPT_VERTEX_PROGRAM:
+			mDevice->getImmediateContext()->VSSetShaderResources(unit, 1, viewArray);
+			break;
+		case GPT_FRAGMENT_PROGRAM:
+			mDevice->getImmediateContext()->PSSetShaderResources(unit, 1, viewArray);
+			break;
+		case GPT_GEOMETRY_PROGRAM:
+			mDevice->getImmediateContext()->GSSetShaderResources(unit, 1, viewArray);
+			break;
+		case GPT_DOMAIN_PROGRAM:
+			mDevice->getImmediateContext()->DSSetShaderResources(unit, 1, viewArray);
+			break;
+		case GPT_HULL_PROGRAM:
+			mDevice->getImmediateContext()->HSSetShaderResources(unit, 1, viewArray);
+			break;
+		case GPT_COMPUTE_PROGRAM:
+			mDevice->getImmediateContext()->CSSetShaderResources(unit, 1, viewArray);
+			break;
+		default:
+			BS_EXCEPT(InvalidParametersException, "Unsupported gpu program type: " + toString(gptype));
+		}
+
+		BS_INC_RENDER_STAT(NumTextureBinds);
+	}
+
 	void D3D11RenderAPI::disableTextureUnit(GpuProgramType gptype, UINT16 texUnit)
 	{
 		THROW_IF_NOT_CORE_THREAD;
@@ -473,6 +580,9 @@ namespace BansheeEngine
 	{
 		THROW_IF_NOT_CORE_THREAD;
 
+		if (prg->getProperties().getType() != GPT_COMPUTE_PROGRAM)
+			mActivePipelineStateId = 0;
+
 		switch(prg->getProperties().getType())
 		{
 		case GPT_VERTEX_PROGRAM:
@@ -526,6 +636,9 @@ namespace BansheeEngine
 	{
 		THROW_IF_NOT_CORE_THREAD;
 
+		if (gptype != GPT_COMPUTE_PROGRAM)
+			mActivePipelineStateId = 0;
+
 		switch(gptype)
 		{
 		case GPT_VERTEX_PROGRAM:
@@ -694,6 +807,10 @@ namespace BansheeEngine
 		{
 			// TODO - Ignoring targetMask here
 			D3D11RenderUtility::instance().drawClearQuad(buffers, color, depth, stencil);
+
+			// Clear quad binds its own states and programs directly
+			mActivePipelineStateId = 0;
+
 			BS_INC_RENDER_STAT(NumClears);
 		}
 		else
@@ -759,6 +876,26 @@ namespace BansheeEngine
 		BS_INC_RENDER_STAT(NumClears);
 	}
 
+	void D3D11RenderAPI::applyFragmentUAVs()
+	{
+		for (UINT32 i = 0; i < mNumBoundRenderTargets; i++)
+		{
+			if (mFragmentUAVs[i] != nullptr)
+			{
+				LOGWRN("Unordered access view bound to fragment program slot " + toString(i) + " overlaps with a bound "
+					"render target and will be ignored.");
+			}
+		}
+
+		if (mNumBoundRenderTargets >= D3D11_PS_CS_UAV_REGISTER_COUNT)
+			return;
+
+		UINT32 numUAVs = D3D11_PS_CS_UAV_REGISTER_COUNT - mNumBoundRenderTargets;
+		mDevice->getImmediateContext()->OMSetRenderTargetsAndUnorderedAccessViews(
+			D3D11_KEEP_RENDER_TARGETS_AND_DEPTH_STENCIL, nullptr, nullptr, mNumBoundRenderTargets, numUAVs, 
+			&mFragmentUAVs[mNumBoundRenderTargets], nullptr);
+	}
+
 	void D3D11RenderAPI::setRenderTarget(const SPtr<RenderTargetCore>& target, bool readOnlyDepthStencil)
 	{
 		THROW_IF_NOT_CORE_THREAD;
@@ -781,12 +918,25 @@ namespace BansheeEngine
 				target->getCustomAttribute("DSV", &depthStencilView);
 		}
 
+		// Only bind up to the last used render target, so the remaining output slots can be used by unordered access views
+		UINT32 numRenderTargets = maxRenderTargets;
+		while (numRenderTargets > 0 && views[numRenderTargets - 1] == nullptr)
+			numRenderTargets--;
+
 		// Bind render targets
-		mDevice->getImmediateContext()->OMSetRenderTargets(maxRenderTargets, views, depthStencilView);
+		mDevice->getImmediateContext()->OMSetRenderTargets(numRenderTargets, views, depthStencilView);
 		if (mDevice->hasError())
 			BS_EXCEPT(RenderingAPIException, "Failed to setRenderTarget : " + mDevice->getErrorDescription());
 
 		bs_deleteN(views, maxRenderTargets);
+
+		// Unordered access views might now overlap (or no longer overlap) with the bound render targets
+		if (numRenderTargets != mNumBoundRenderTargets)
+		{
+			mNumBoundRenderTargets = numRenderTargets;
+			applyFragmentUAVs();
+		}
+
 		applyViewport();
 
 		BS_INC_RENDER_STAT(NumRenderTargetChanges);
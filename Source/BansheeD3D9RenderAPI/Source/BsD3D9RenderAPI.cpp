@@ -486,6 +486,13 @@ namespace BansheeEngine
 		LOGWRN("Texture random load/store not supported on DX9.");
 	}
 
+	void D3D9RenderAPI::setBuffer(GpuProgramType gptype, UINT16 unit, const SPtr<GpuBufferCore>& buffer, bool loadStore)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		LOGWRN("Generic buffers not supported on DX9.");
+	}
+
 	void D3D9RenderAPI::setSamplerState(GpuProgramType gptype, UINT16 unit, const SPtr<SamplerStateCore>& state)
 	{
 		THROW_IF_NOT_CORE_THREAD;
@@ -529,6 +536,8 @@ namespace BansheeEngine
 	{
 		THROW_IF_NOT_CORE_THREAD;
 
+		mActivePipelineStateId = 0;
+
 		const BlendProperties& stateProps = blendState->getProperties();
 
 		// Alpha to coverage
@@ -557,6 +566,8 @@ namespace BansheeEngine
 	{
 		THROW_IF_NOT_CORE_THREAD;
 
+		mActivePipelineStateId = 0;
+
 		const RasterizerProperties& stateProps = rasterizerState->getProperties();
 
 		setDepthBias(stateProps.getDepthBias(), stateProps.getSlopeScaledDepthBias());
@@ -578,6 +589,8 @@ namespace BansheeEngine
 	{
 		THROW_IF_NOT_CORE_THREAD;
 
+		mActivePipelineStateId = 0;
+
 		const DepthStencilProperties& stateProps = depthStencilState->getProperties();
 
 		// Set stencil buffer options
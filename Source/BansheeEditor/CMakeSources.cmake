@@ -38,6 +38,7 @@ set(BS_BANSHEEEDITOR_INC_SCENE
 	"Include/BsScenePicking.h"
 	"Include/BsSelection.h"
 	"Include/BsSelectionRenderer.h"
+	"Include/BsPickingBVH.h"
 )
 
 set(BS_BANSHEEEDITOR_SRC_GUI
@@ -115,6 +116,7 @@ set(BS_BANSHEEEDITOR_INC_UNDOREDO
 	"Include/BsCmdInstantiateSO.h"
 	"Include/BsCmdBreakPrefab.h"
 	"Include/BsUndoRedo.h"
+	"Include/BsUndoStateStorage.h"
 )
 
 set(BS_BANSHEEEDITOR_INC_RTTI
@@ -140,6 +142,7 @@ set(BS_BANSHEEEDITOR_SRC_SCENEVIEW
 	"Source/BsSelection.cpp"
 	"Source/BsScenePicking.cpp"
 	"Source/BsSceneGrid.cpp"
+	"Source/BsPickingBVH.cpp"
 )
 
 set(BS_BANSHEEEDITOR_INC_NOFILTER
@@ -184,6 +187,7 @@ set(BS_BANSHEEEDITOR_INC_UTILITY
 
 set(BS_BANSHEEEDITOR_SRC_TESTING
 	"Source/BsEditorTestSuite.cpp"
+	"Source/BsEditorBenchmarkSuite.cpp"
 )
 
 set(BS_BANSHEEEDITOR_SRC_SETTINGS
@@ -203,6 +207,7 @@ set(BS_BANSHEEEDITOR_SRC_UNDOREDO
 	"Source/BsCmdInstantiateSO.cpp"
 	"Source/BsCmdBreakPrefab.cpp"
 	"Source/BsUndoRedo.cpp"
+	"Source/BsUndoStateStorage.cpp"
 )
 
 set(BS_BANSHEEEDITOR_INC_CODEEDITOR
@@ -233,6 +238,7 @@ set(BS_BANSHEEEDITOR_SRC_HANDLES
 
 set(BS_BANSHEEEDITOR_INC_TESTING
 	"Include/BsEditorTestSuite.h"
+	"Include/BsEditorBenchmarkSuite.h"
 )
 
 source_group("Header Files\\Settings" FILES ${BS_BANSHEEEDITOR_INC_SETTINGS})
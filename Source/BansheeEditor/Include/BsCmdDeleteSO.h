@@ -51,8 +51,7 @@ namespace BansheeEngine
 		HSceneObject mSceneObject;
 		CmdUtility::SceneObjProxy mSceneObjectProxy;
 
-		UINT8* mSerializedObject;
-		UINT32 mSerializedObjectSize;
+		SPtr<UndoState> mSerializedObject;
 		UINT64 mSerializedObjectParentId;
 	};
 
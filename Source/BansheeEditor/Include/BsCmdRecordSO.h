@@ -57,8 +57,7 @@ namespace BansheeEngine
 		CmdUtility::SceneObjProxy mSceneObjectProxy;
 		bool mRecordHierarchy;
 
-		UINT8* mSerializedObject;
-		UINT32 mSerializedObjectSize;
+		SPtr<UndoState> mSerializedObject;
 	};
 
 	/** @} */
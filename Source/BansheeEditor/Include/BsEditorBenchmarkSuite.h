@@ -0,0 +1,51 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsEditorPrerequisites.h"
+#include "BsTestSuite.h"
+
+/** Set to 1 to run the benchmark suite together with the editor test suite on editor start-up. */
+#ifndef BS_EDITOR_RUN_BENCHMARKS
+#define BS_EDITOR_RUN_BENCHMARKS 0
+#endif
+
+namespace BansheeEngine
+{
+	/** @addtogroup Testing-Editor
+	 *  @{
+	 */
+	/** @cond TEST */
+
+	/**
+	 * Contains benchmarks comparing optimized code paths against their reference implementations. Each benchmark reports
+	 * its timings to the debug log, and tests that both implementations produce the same results.
+	 */
+	class EditorBenchmarkSuite : public TestSuite
+	{
+	public:
+		EditorBenchmarkSuite();
+
+	private:
+		/** Compares compressed batch evaluation of animation clips against evaluating uncompressed curves. */
+		void BenchmarkAnimationClip();
+
+		/** 
+		 * Compares bulk pixel conversion split over worker threads, against converting on a single thread and against
+		 * converting pixel by pixel.
+		 */
+		void BenchmarkPixelConversion();
+
+		/** 
+		 * Compares ray picking against mesh triangles using a bounding volume hierarchy, against testing every triangle.
+		 * Also reports the time needed to build the hierarchy.
+		 */
+		void BenchmarkPicking();
+
+		/** Compares batch math operations against performing the same operations one object at a time. */
+		void BenchmarkBatchMath();
+	};
+
+	/** @endcond */
+	/** @} */
+}
@@ -154,6 +154,8 @@ namespace BansheeEngine
 	class GUIResourceTreeView;
 	class GUITreeViewEditBox;
 	class EditorCommand;
+	class UndoState;
+	class UndoStateStorage;
 	class ProjectFileMeta;
 	class ProjectResourceMeta;
 	class SceneGrid;
@@ -169,6 +171,7 @@ namespace BansheeEngine
 	class SelectionRenderer;
 	class DropDownWindow;
 	class ProjectSettings;
+	class MeshPickingData;
 
 	static const char* EDITOR_ASSEMBLY = "MBansheeEditor";
 	static const char* SCRIPT_EDITOR_ASSEMBLY = "MScriptEditor";
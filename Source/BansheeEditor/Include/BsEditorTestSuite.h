@@ -67,6 +67,34 @@ namespace BansheeEngine
 		TestComponentB() {} // Serialization only
 	};
 
+	/** 
+	 * Linear congruential generator used for generating test data. Unlike std::rand() it produces the same sequence on
+	 * every platform, so test and benchmark runs are reproducible.
+	 */
+	class TestRandom
+	{
+	public:
+		TestRandom(UINT32 seed)
+			:mSeed(seed)
+		{ }
+
+		/** Returns the next random number, in range [0, 2^24). */
+		UINT32 next()
+		{
+			mSeed = mSeed * 1664525 + 1013904223;
+			return mSeed >> 8;
+		}
+
+		/** Returns the next random number, in range [min, max). */
+		float range(float min, float max)
+		{
+			return min + next() / (float)(1 << 24) * (max - min);
+		}
+
+	private:
+		UINT32 mSeed;
+	};
+
 	/** @endcond */
 
 	/**	Contains a set of unit tests for the editor. */
@@ -82,6 +110,9 @@ namespace BansheeEngine
 		/**	Tests SceneObject delete undo/redo operation. */
 		void SceneObjectDelete_UndoRedo();
 
+		/** Tests storing and retrieving undo states using deltas and compression. */
+		void TestUndoStateStorage();
+
 		/** Tests native diff by modifiying an object, generating a diff and re-applying the modifications. */
 		void BinaryDiff();
 
@@ -90,6 +121,54 @@ namespace BansheeEngine
 
 		/**	Tests the frame allocator. */
 		void TestFrameAlloc();
+
+		/** Tests that the frame allocator frees its memory blocks the same way they were allocated. */
+		void TestFrameAllocBlocks();
+
+		/** Tests CPU picking by comparing mesh BVH queries against testing every triangle. */
+		void TestPickingBVH();
+
+		/** Tests batch math operations by comparing them against their per-object equivalents. */
+		void TestBatchMath();
+
+		/** Tests pixel format conversions by comparing specialized converters against per-pixel conversion. */
+		void TestPixelConversion();
+
+		/** Tests mip-map generation using the built-in filters. */
+		void TestMipmapGeneration();
+
+		/** Tests evaluation of compressed animation clips against their source curves. */
+		void TestAnimationClip();
+
+		/** Tests skeleton bone palette calculation, CPU skinning and blend shapes against reference math. */
+		void TestSkinning();
+
+		/** Tests finding GUI elements under a point using the element grid, against testing each element directly. */
+		void TestGUIElementGrid();
+
+		/** Tests caching of layout size ranges and deferred layout of clipped GUI elements. */
+		void TestGUILayoutCache();
+
+		/** Tests that a tree view only assigns GUI elements to elements in its visible area, and reuses them on scroll. */
+		void TestGUITreeViewVirtualization();
+
+		/** Tests allocation, cross-thread frees and statistics of the small object allocator. */
+		void TestSmallObjectAlloc();
+
+		/** Tests counting allocations in memory categories provided by the allocator and by scoped tags. */
+		void TestMemoryTagging();
+
+		/** Tests that a pipeline state is bound again after a partial viewport clear binds its own states. */
+		void TestPipelineStateAfterClear();
+
+		/** Tests conversion of euler angle rotation curves into quaternion curves, including quaternion sign flips. */
+		void TestEulerToQuaternionCurves();
+
+		/** Tests that the instanced diffuse shader exposes per-object data in a way the renderer can draw instanced. */
+		void TestInstancedShader();
+
+		/** Tests unregistering core objects from the scene manager after their scene object was destroyed. */
+		void TestSceneManagerUnregister();
 	};
 
 	/** @} */
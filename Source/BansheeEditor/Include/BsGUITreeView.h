@@ -6,6 +6,7 @@
 #include "BsGUIElementContainer.h"
 #include "BsVirtualInput.h"
 #include "BsEvent.h"
+#include "BsVector2I.h"
 
 namespace BansheeEngine
 {
@@ -19,6 +20,10 @@ namespace BansheeEngine
 	 *
 	 * Elements may be selected, renamed, dragged and re-parented.
 	 *
+	 * GUI elements are only created for elements in (or near) the visible area of the tree view, and are reused as the
+	 * tree view is scrolled. All elements share the same height, so only elements that come into view need to be
+	 * measured, and large hierarchies cost no more to display than small ones.
+	 *
 	 * This class is abstract and meant to be extended by an implementation specific to some content type (for example scene
 	 * object hierarchy). 
 	 */
@@ -37,7 +42,7 @@ namespace BansheeEngine
 
 		/**
 		 * Contains data about a single piece of content and all its children. This element may be visible and represented
-		 * by a GUI element, but might not (for example its parent is collapsed).
+		 * by a GUI element, but might not (for example its parent is collapsed, or it is scrolled out of view).
 		 */
 		struct TreeElement
 		{
@@ -49,10 +54,13 @@ namespace BansheeEngine
 
 			GUIToggle* mFoldoutBtn;
 			GUILabel* mElement;
+			INT32 mElementWidth;
+			HEvent mFoldoutToggledConn;
 
 			String mName;
 
 			UINT32 mSortedIdx;
+			UINT32 mRowIdx;
 			bool mIsExpanded;
 			bool mIsSelected;
 			bool mIsHighlighted;
@@ -70,8 +78,8 @@ namespace BansheeEngine
 		 */
 		struct InteractableElement
 		{
-			InteractableElement(TreeElement* parent, UINT32 index, const Rect2I& bounds)
-				:parent(parent), index(index), bounds(bounds)
+			InteractableElement(TreeElement* parent, UINT32 index, INT32 y, UINT32 height)
+				:parent(parent), index(index), y(y), height(height)
 			{ }
 
 			bool isTreeElement() const { return index % 2 == 1; }
@@ -79,7 +87,19 @@ namespace BansheeEngine
 
 			TreeElement* parent;
 			UINT32 index;
-			Rect2I bounds;
+			INT32 y; /**< Offset from the top of the tree view. */
+			UINT32 height;
+		};
+
+		/** Visible TreeElement displayed on a single row of the tree view, and its depth in the hierarchy. */
+		struct TreeRow
+		{
+			TreeRow(TreeElement* element, UINT32 indent)
+				:element(element), indent(indent)
+			{ }
+
+			TreeElement* element;
+			UINT32 indent;
 		};
 
 		/**	Contains data about one of the currently selected tree elements. */
@@ -144,6 +164,9 @@ namespace BansheeEngine
 		/** @copydoc GUIElement::_updateLayoutInternal */
 		virtual void _updateLayoutInternal(const GUILayoutData& data) override;
 
+		/** @copydoc GUIElementBase::_updateOptimalLayoutSizes */
+		void _updateOptimalLayoutSizes() override;
+
 		/** @copydoc GUIElement::_mouseEvent */
 		virtual bool _mouseEvent(const GUIMouseEvent& ev) override;
 
@@ -157,6 +180,24 @@ namespace BansheeEngine
 		 */
 		const GUITreeView::InteractableElement* findElementUnderCoord(const Vector2I& coord) const;
 
+		/**
+		 * Finds the interactable element representing the provided tree element. Returns the end of the visible element
+		 * list if the tree element isn't visible.
+		 */
+		Vector<InteractableElement>::const_iterator findInteractableElement(const TreeElement* element) const;
+
+		/** Returns the bounds of an interactable element, relative to the parent GUI widget. */
+		Rect2I getElementBounds(const InteractableElement& element) const;
+
+		/** Returns the range of rows in (or near) the visible area of the provided layout. Last row is exclusive. */
+		void getRowsInView(const GUILayoutData& data, INT32& firstRow, INT32& lastRow) const;
+
+		/**
+		 * Calculates the width of rows in the provided range that weren't measured yet. Returns true if the widest row
+		 * changed.
+		 */
+		bool measureRows(INT32 firstRow, INT32 lastRow);
+
 		/**	Returns the top-most selected tree element if selection is active, null otherwise. */
 		TreeElement* getTopMostSelectedElement() const;
 
@@ -234,9 +275,39 @@ namespace BansheeEngine
 		/**	Collapses the provided TreeElement making its children hidden and not interactable. */
 		void collapseElement(TreeElement* element);
 
-		/**	Rebuilds the needed GUI elements for the provided TreeElement. */
+		/**
+		 * Updates the contents of the GUI elements of the provided TreeElement, if it has any, and schedules it to be
+		 * measured once it's in view. Must be called whenever the element is shown, hidden or modified.
+		 */
 		void updateElementGUI(TreeElement* element);
 
+		/**
+		 * Rebuilds the list of visible rows and interactable elements, if any elements were shown, hidden or modified
+		 * since the last call. Doesn't measure any elements.
+		 */
+		void updateRows() const;
+
+		/**
+		 * Assigns GUI elements to the provided TreeElement, if it doesn't have them already. Elements are taken from the
+		 * pool of unused elements if possible.
+		 */
+		void assignElementGUI(TreeElement* element);
+
+		/**	Returns the GUI elements of the provided TreeElement (if any) to the pool of unused elements. */
+		void releaseElementGUI(TreeElement* element);
+
+		/** Updates contents of the GUI elements assigned to the provided TreeElement, so they match the element's state. */
+		void refreshElementGUI(TreeElement* element);
+
+		/** Calculates the optimal size of the GUI element displaying the provided text. */
+		Vector2I calcElementSize(const String& name) const;
+
+		/** Returns the width of a row displaying the provided TreeElement. The element must have been measured. */
+		INT32 getRowWidth(const TreeElement* element, UINT32 indent) const;
+
+		/**	Returns the style used by the GUI elements displaying the TreeElement%s. */
+		const GUIElementStyle* getElementStyle() const;
+
 		/**	Close any elements that were temporarily expanded due to a drag operation hovering over them. */
 		void closeTemporarilyExpandedElements();
 
@@ -283,7 +354,17 @@ namespace BansheeEngine
 
 		GUITexture* mBackgroundImage;
 
-		Vector<InteractableElement> mVisibleElements;
+		mutable Vector<TreeRow> mRows;
+		mutable Vector<InteractableElement> mVisibleElements;
+		mutable Vector<TreeElement*> mElementsInView;
+		mutable INT32 mMaxRowWidth;
+		mutable bool mRowsDirty;
+		bool mRowWidthChanged;
+
+		Vector<GUILabel*> mUnusedElements;
+		Vector<GUIToggle*> mUnusedFoldoutBtns;
+		const GUIElementStyle* mElementStyle;
+		INT32 mElementHeight;
 
 		bool mIsElementSelected;
 		Vector<SelectedElement> mSelectedElements;
@@ -310,6 +391,7 @@ namespace BansheeEngine
 		float mMouseOverDragElementTime;
 
 		static const UINT32 ELEMENT_EXTRA_SPACING;
+		static const UINT32 VISIBLE_AREA_MARGIN;
 		static const UINT32 INDENT_SIZE;
 		static const UINT32 INITIAL_INDENT_OFFSET;
 		static const UINT32 DRAG_MIN_DISTANCE;
@@ -245,6 +245,33 @@ namespace BansheeEngine
 		 */
 		void renderForPicking(const SPtr<Camera>& camera, std::function<Color(UINT32)> idxToColorCallback);
 
+		/**
+		 * Finds all pickable gizmos intersected by the provided ray. Unlike renderForPicking() this doesn't render 
+		 * anything and returns the results immediately.
+		 *
+		 * @param[in]	camera		Camera the gizmos are viewed from. Used for determining the size of icons and the
+		 *							picking tolerance of lines.
+		 * @param[in]	ray			Ray in world space.
+		 * @param[out]	output		Indices of the intersected gizmos (as accepted by getSceneObject()), paired with the
+		 *							distance to the intersection along the ray.
+		 *
+		 * @note	Internal method.
+		 */
+		void pickGizmos(const SPtr<Camera>& camera, const Ray& ray, Vector<std::pair<UINT32, float>>& output);
+
+		/**
+		 * Finds all pickable gizmos intersecting the provided volume. Unlike renderForPicking() this doesn't render 
+		 * anything and returns the results immediately.
+		 *
+		 * @param[in]	camera		Camera the gizmos are viewed from. Used for determining the size of icons.
+		 * @param[in]	volume		Volume in world space.
+		 * @param[out]	output		Indices of the intersected gizmos (as accepted by getSceneObject()), paired with their
+		 *							distance from the camera.
+		 *
+		 * @note	Internal method.
+		 */
+		void pickGizmos(const SPtr<Camera>& camera, const ConvexVolume& volume, Vector<std::pair<UINT32, float>>& output);
+
 		/** @} */
 
 	private:
@@ -390,6 +417,29 @@ namespace BansheeEngine
 		 */
 		SPtr<TransientMesh> buildIconMesh(const SPtr<Camera>& camera, const Vector<IconData>& iconData, bool forPicking, IconRenderDataVecPtr& renderData);
 
+		/**
+		 * Records all pickable gizmos into the picking draw helper and outputs all pickable icons.
+		 *
+		 * @param[in]	idxToColorCallback	Callback that assigns a unique color to each gizmo index.
+		 * @param[out]	iconData			Pickable icons, with their colors assigned by the callback.
+		 */
+		void recordPickingGizmos(std::function<Color(UINT32)> idxToColorCallback, Vector<IconData>& iconData);
+
+		/** 
+		 * Tests all pickable gizmos against a ray or a volume on the CPU. Exactly one of @p ray and @p volume must be
+		 * provided. 
+		 *
+		 * @see		pickGizmos
+		 */
+		void findPickedGizmos(const SPtr<Camera>& camera, const Ray* ray, const ConvexVolume* volume, 
+			Vector<std::pair<UINT32, float>>& output);
+
+		/** Returns the world space size of a single pixel, at the provided distance from the camera. */
+		static float getWorldPixelSize(const SPtr<Camera>& camera, float distance);
+
+		/** Calculates a hash from all the parameters that affect the mesh generated by buildIconMesh(). */
+		size_t calculateIconHash(const SPtr<Camera>& camera, const Vector<IconData>& iconData) const;
+
 		/**	Resizes the icon width/height so it is always scaled to optimal size (with preserved aspect). */
 		void limitIconSize(UINT32& width, UINT32& height);
 
@@ -420,6 +470,7 @@ namespace BansheeEngine
 		static const float MAX_ICON_RANGE;
 		static const UINT32 OPTIMAL_ICON_SIZE;
 		static const float ICON_TEXEL_WORLD_SIZE;
+		static const float PICKING_LINE_TOLERANCE;
 
 		typedef Set<IconData, std::function<bool(const IconData&, const IconData&)>> IconSet;
 
@@ -454,6 +505,8 @@ namespace BansheeEngine
 
 		SPtr<MeshHeap> mIconMeshHeap;
 		SPtr<TransientMesh> mIconMesh;
+		IconRenderDataVecPtr mIconRenderData;
+		size_t mIconMeshHash;
 
 		std::atomic<GizmoManagerCore*> mCore;
 
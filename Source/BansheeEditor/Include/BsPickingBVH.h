@@ -0,0 +1,270 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsEditorPrerequisites.h"
+#include "BsAABox.h"
+#include "BsRay.h"
+#include "BsConvexVolume.h"
+#include "BsSubMesh.h"
+#include "BsVector4.h"
+
+namespace BansheeEngine
+{
+	/** @addtogroup Scene-Editor-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Bounding volume hierarchy built over a set of axis aligned boxes. Used for quickly finding primitives (triangles,
+	 * objects) intersecting a ray or a convex volume without testing all of them.
+	 */
+	class BS_ED_EXPORT PickingBVH
+	{
+	public:
+		/** Single node in the hierarchy. Nodes are stored depth first so the first child of a node follows it directly. */
+		struct Node
+		{
+			Vector3 min;
+			Vector3 max;
+			UINT32 start; /**< Index of the first primitive in a leaf, or the index of the second child otherwise. */
+			UINT32 count; /**< Number of primitives in a leaf, or zero if not a leaf. */
+		};
+
+		/**
+		 * Builds the hierarchy from the provided primitive bounds. Primitives are referred to by their index in the
+		 * @p bounds array.
+		 */
+		void build(const Vector<AABox>& bounds);
+
+		/** Checks does the hierarchy contain any primitives. */
+		bool isEmpty() const { return mNodes.empty(); }
+
+		/**
+		 * Calls @p visitor for every primitive whose bounds are intersected by the ray, closer than @p closest. Nodes
+		 * are visited front to back and the visitor is expected to lower @p closest when it finds a closer intersection,
+		 * allowing the remaining nodes further away to be skipped.
+		 *
+		 * @param[in]		ray			Ray to test, in the same space as the primitive bounds.
+		 * @param[in, out]	closest		Distance along the ray past which nodes are ignored.
+		 * @param[in]		visitor		Callable with signature void(UINT32 primitiveIdx, float& closest).
+		 */
+		template<class T>
+		void intersects(const Ray& ray, float& closest, T visitor) const
+		{
+			if (mNodes.empty())
+				return;
+
+			const Vector3& origin = ray.getOrigin();
+			const Vector3& dir = ray.getDirection();
+			Vector3 invDir(1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z);
+
+			UINT32 stack[MAX_DEPTH];
+			UINT32 stackSize = 0;
+			stack[stackSize++] = 0;
+
+			while (stackSize > 0)
+			{
+				const Node& node = mNodes[stack[--stackSize]];
+
+				float nodeDist;
+				if (!intersects(node, origin, invDir, nodeDist) || nodeDist > closest)
+					continue;
+
+				if (node.count > 0)
+				{
+					for (UINT32 i = 0; i < node.count; i++)
+						visitor(mIndices[node.start + i], closest);
+
+					continue;
+				}
+
+				UINT32 firstIdx = (UINT32)(&node - mNodes.data()) + 1;
+				UINT32 secondIdx = node.start;
+
+				float firstDist, secondDist;
+				bool firstHit = intersects(mNodes[firstIdx], origin, invDir, firstDist);
+				bool secondHit = intersects(mNodes[secondIdx], origin, invDir, secondDist);
+
+				// Push the further node first so the nearer one is visited first
+				if (firstHit && secondHit)
+				{
+					if (firstDist < secondDist)
+						std::swap(firstIdx, secondIdx);
+
+					stack[stackSize++] = firstIdx;
+					stack[stackSize++] = secondIdx;
+				}
+				else if (firstHit)
+					stack[stackSize++] = firstIdx;
+				else if (secondHit)
+					stack[stackSize++] = secondIdx;
+			}
+		}
+
+		/**
+		 * Calls @p visitor for every primitive whose bounds intersect the provided volume.
+		 *
+		 * @param[in]	volume		Volume to test, in the same space as the primitive bounds.
+		 * @param[in]	visitor		Callable with signature bool(UINT32 primitiveIdx). Return true to stop the search.
+		 * @return					True if the search was stopped by the visitor.
+		 */
+		template<class T>
+		bool intersects(const ConvexVolume& volume, T visitor) const
+		{
+			if (mNodes.empty())
+				return false;
+
+			UINT32 stack[MAX_DEPTH];
+			UINT32 stackSize = 0;
+			stack[stackSize++] = 0;
+
+			while (stackSize > 0)
+			{
+				UINT32 nodeIdx = stack[--stackSize];
+				const Node& node = mNodes[nodeIdx];
+
+				if (!volume.intersects(AABox(node.min, node.max)))
+					continue;
+
+				if (node.count > 0)
+				{
+					for (UINT32 i = 0; i < node.count; i++)
+					{
+						if (visitor(mIndices[node.start + i]))
+							return true;
+					}
+
+					continue;
+				}
+
+				stack[stackSize++] = node.start;
+				stack[stackSize++] = nodeIdx + 1;
+			}
+
+			return false;
+		}
+
+	private:
+		static const UINT32 MAX_LEAF_SIZE;
+		static const UINT32 MAX_DEPTH = 64;
+
+		/** 
+		 * Builds a node (and its children) from a range of primitives in the index array. Returns the index of the 
+		 * created node.
+		 */
+		UINT32 buildNode(const Vector<AABox>& bounds, const Vector<Vector3>& centers, UINT32 start, UINT32 count);
+
+		/** Performs a ray/node intersection using the slab method. Outputs the distance to the entry point. */
+		static bool intersects(const Node& node, const Vector3& origin, const Vector3& invDir, float& distance)
+		{
+			float tmin = 0.0f;
+			float tmax = std::numeric_limits<float>::max();
+
+			for (UINT32 i = 0; i < 3; i++)
+			{
+				float t0 = (node.min[i] - origin[i]) * invDir[i];
+				float t1 = (node.max[i] - origin[i]) * invDir[i];
+
+				if (t0 > t1)
+					std::swap(t0, t1);
+
+				tmin = t0 > tmin ? t0 : tmin;
+				tmax = t1 < tmax ? t1 : tmax;
+
+				if (tmin > tmax)
+					return false;
+			}
+
+			distance = tmin;
+			return true;
+		}
+
+		Vector<Node> mNodes;
+		Vector<UINT32> mIndices;
+	};
+
+	/**
+	 * Triangles of a mesh, organized in a bounding volume hierarchy so they can be quickly tested for intersection. All
+	 * queries are performed in mesh local space.
+	 */
+	class BS_ED_EXPORT MeshPickingData
+	{
+	public:
+		/**
+		 * Prepares picking data for a mesh. Triangles are not extracted until build() is called.
+		 *
+		 * @param[in]	meshData	Mesh vertex and index data.
+		 * @param[in]	subMeshes	Sub-meshes to extract triangles from. Sub-meshes that aren't triangle lists or strips
+		 *							are ignored.
+		 */
+		MeshPickingData(const SPtr<MeshData>& meshData, const Vector<SubMesh>& subMeshes);
+
+		/**
+		 * Extracts the triangles from the mesh data and builds the hierarchy. Must be called before performing any
+		 * queries.
+		 *
+		 * @note	Thread safe as long as no other thread is accessing the same object.
+		 */
+		void build();
+
+		/** Checks has build() been called. */
+		bool isBuilt() const { return mIsBuilt; }
+
+		/** Returns the number of triangles in the mesh. Only valid after build(). */
+		UINT32 getNumTriangles() const { return (UINT32)mVertices.size() / 3; }
+
+		/**
+		 * Finds the nearest triangle intersected by the ray. Both sides of the triangles are tested. Returns true if the
+		 * ray hit a triangle, as well as the distance to the hit.
+		 */
+		bool intersects(const Ray& ray, float& distance) const;
+
+		/**
+		 * Finds the nearest triangle intersected by the ray, ignoring triangles that would be culled when viewed along
+		 * the ray. Returns true if the ray hit a triangle, as well as the distance to the hit.
+		 *
+		 * @param[in]	ray			Ray to test, in mesh local space.
+		 * @param[in]	cullModes	Culling mode for each sub-mesh, in the order the sub-meshes were provided. Sub-meshes
+		 *							without an entry are not culled.
+		 * @param[out]	distance	Distance along the ray to the nearest hit.
+		 */
+		bool intersects(const Ray& ray, const Vector<CullingMode>& cullModes, float& distance) const;
+
+		/**
+		 * Checks does any triangle intersect the provided volume. The test is conservative and can report an
+		 * intersection for large triangles that pass near the corners of the volume without entering it.
+		 */
+		bool intersects(const ConvexVolume& volume) const;
+
+		/**
+		 * Checks does any triangle intersect the provided volume, ignoring triangles that would be culled when viewed
+		 * from the provided view point. The test is conservative in the same way as intersects(const ConvexVolume&).
+		 *
+		 * @param[in]	volume		Volume to test, in mesh local space.
+		 * @param[in]	cullModes	Culling mode for each sub-mesh, in the order the sub-meshes were provided. Sub-meshes
+		 *							without an entry are not culled.
+		 * @param[in]	viewPoint	Position of the viewer in mesh local space, in homogeneous coordinates. Use a w of 0 
+		 *							for orthographic views, in which case xyz is the direction towards the viewer.
+		 */
+		bool intersects(const ConvexVolume& volume, const Vector<CullingMode>& cullModes, 
+			const Vector4& viewPoint) const;
+
+	private:
+		/** 
+		 * Checks would a triangle be culled. @p facing must be positive when the triangle's normal (using the 
+		 * right-hand rule) points towards the viewer, and negative when it points away.
+		 */
+		static bool isCulled(const Vector<CullingMode>& cullModes, UINT32 subMeshIdx, float facing);
+
+		SPtr<MeshData> mMeshData;
+		Vector<SubMesh> mSubMeshes;
+		bool mIsBuilt;
+
+		Vector<Vector3> mVertices;
+		Vector<UINT32> mTriangleSubMeshes;
+		PickingBVH mBVH;
+	};
+
+	/** @} */
+}
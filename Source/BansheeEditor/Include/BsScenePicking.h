@@ -6,6 +6,7 @@
 #include "BsModule.h"
 #include "BsMatrix4.h"
 #include "BsGpuParam.h"
+#include "BsAABox.h"
 
 namespace BansheeEngine
 {
@@ -15,6 +16,22 @@ namespace BansheeEngine
 
 	class ScenePickingCore;
 
+	/** Determines how does ScenePicking find objects under the pointer. */
+	enum class ScenePickingMode
+	{
+		/**
+		 * Pickable objects are rendered into the camera's render target, which is then read back. Pixel accurate and
+		 * respects alpha cutoff and occlusion, but requires a full GPU round trip for each pick.
+		 */
+		GPU,
+		/**
+		 * Pickable objects are tested against a ray or a volume on the CPU, using bounding volume hierarchies built from
+		 * mesh data. Avoids stalling on the GPU, but ignores alpha cutoff, and objects occluded by other objects are
+		 * also returned when picking an area.
+		 */
+		CPU
+	};
+
 	/**	Handles picking of scene objects with a pointer in scene view. */
 	class BS_ED_EXPORT ScenePicking : public Module<ScenePicking>
 	{
@@ -56,18 +73,99 @@ namespace BansheeEngine
 		 */
 		Vector<HSceneObject> pickObjects(const SPtr<Camera>& cam, const Vector2I& position, const Vector2I& area);
 
+		/**
+		 * Finds all scene objects intersected by the provided ray. Always performed on the CPU, regardless of the active
+		 * picking mode.
+		 *
+		 * @param[in]	cam		Camera the scene is viewed from. Used for determining the size of gizmos.
+		 * @param[in]	ray		Ray in world space.
+		 * @return				A list of SceneObject%s intersected by the ray, sorted from nearest to furthest.
+		 */
+		Vector<HSceneObject> pickObjects(const SPtr<Camera>& cam, const Ray& ray);
+
+		/**
+		 * Finds all scene objects intersecting the provided volume (e.g. a frustum). Always performed on the CPU,
+		 * regardless of the active picking mode.
+		 *
+		 * @param[in]	cam		Camera the scene is viewed from. Used for determining the size of gizmos.
+		 * @param[in]	volume	Volume in world space.
+		 * @return				A list of SceneObject%s intersecting the volume, sorted from nearest to furthest from 
+		 *						the camera.
+		 */
+		Vector<HSceneObject> pickObjects(const SPtr<Camera>& cam, const ConvexVolume& volume);
+
+		/** Determines how are objects found when picking with the pointer. */
+		void setMode(ScenePickingMode mode) { mMode = mode; }
+
+		/** Returns how are objects found when picking with the pointer. */
+		ScenePickingMode getMode() const { return mMode; }
+
+		/**
+		 * Releases all cached mesh data used for CPU picking. Cached data for a mesh is built the first time the mesh is
+		 * picked on the CPU, and rebuilt if the mesh is modified through Mesh::writeSubresource(). This should be
+		 * called if contents of a mesh are modified directly on the core thread.
+		 */
+		void clearCache();
+
 	private:
 		friend class ScenePickingCore;
 
+		/** Picking data for a single mesh, used for CPU picking. */
+		struct MeshCacheEntry
+		{
+			std::weak_ptr<Mesh> mesh;
+			SPtr<MeshPickingData> data;
+			UINT32 contentVersion;
+		};
+
+		/** Renderable that passed the broad phase of CPU picking. */
+		struct PickCandidate
+		{
+			HSceneObject sceneObject;
+			Matrix4 worldTransform;
+			AABox worldBounds;
+			Vector<CullingMode> cullModes;
+			SPtr<MeshPickingData> data;
+			float distance;
+		};
+
 		typedef Set<RenderablePickData, std::function<bool(const RenderablePickData&, const RenderablePickData&)>> RenderableSet;
 
+		/** Returns the culling mode a renderable is drawn with when using the provided material. */
+		static CullingMode getCullMode(const HMaterial& material);
+
 		/**	Encodes a pickable object identifier to a unique color. */
 		static Color encodeIndex(UINT32 index);
 
 		/** Decodes a color into a unique object identifier. Color should have initially been encoded with encodeIndex(). */
 		static UINT32 decodeIndex(Color color);
 
+		/** Picks objects by rendering them and reading back the render target. */
+		Vector<HSceneObject> pickObjectsGPU(const SPtr<Camera>& cam, const Vector2I& position, const Vector2I& area);
+
+		/**
+		 * Picks objects by testing them against a ray or a volume on the CPU. Exactly one of @p ray and @p volume must
+		 * be provided.
+		 */
+		Vector<HSceneObject> pickObjectsCPU(const SPtr<Camera>& cam, const Ray* ray, const ConvexVolume* volume);
+
+		/**
+		 * Returns picking data for the provided meshes, creating it if it doesn't exist. All newly created data is built
+		 * in parallel on worker threads.
+		 */
+		Vector<SPtr<MeshPickingData>> getMeshPickingData(const Vector<HMesh>& meshes);
+
+		/** Creates a volume covering the provided screen area, extending from the camera's near to its far plane. */
+		static ConvexVolume getPickVolume(const SPtr<Camera>& cam, const Vector2I& position, const Vector2I& area);
+
+		/** Transforms a world space volume into the local space of an object with the provided world transform. */
+		static ConvexVolume toLocalVolume(const ConvexVolume& volume, const Matrix4& worldTransform);
+
+		static const UINT32 MIN_ITEMS_PER_TASK;
+
 		ScenePickingCore* mCore;
+		ScenePickingMode mMode;
+		UnorderedMap<UINT64, MeshCacheEntry> mMeshCache;
 	};
 
 	/** @} */
@@ -4,6 +4,7 @@
 
 #include "BsEditorPrerequisites.h"
 #include "BsModule.h"
+#include "BsUndoStateStorage.h"
 
 namespace BansheeEngine
 {
@@ -68,6 +69,18 @@ namespace BansheeEngine
 		/**	Resets the undo/redo stacks. */
 		void clear();
 
+		/** Returns storage that commands should use for storing serialized object states. */
+		UndoStateStorage& getStateStorage() { return mStateStorage; }
+
+		/**
+		 * Sets the maximum amount of memory (in bytes) that serialized object states stored by commands are allowed to
+		 * use. When exceeded the oldest commands are removed from the undo stack. Zero means unlimited (default).
+		 */
+		void setMemoryBudget(UINT64 budget);
+
+		/** Returns the maximum amount of memory serialized object states are allowed to use. Zero means unlimited. */
+		UINT64 getMemoryBudget() const { return mMemoryBudget; }
+
 	private:
 		/**	Removes the last undo command from the undo stack, and returns it. */
 		EditorCommand* removeLastFromUndoStack();
@@ -81,6 +94,9 @@ namespace BansheeEngine
 		/**	Removes all entries from the redo stack. */
 		void clearRedoStack();
 
+		/** Removes the oldest entries from the undo stack until the memory used by stored states fits the budget. */
+		void enforceMemoryBudget();
+
 		static const UINT32 MAX_STACK_ELEMENTS;
 
 		EditorCommand** mUndoStack;
@@ -95,6 +111,9 @@ namespace BansheeEngine
 		UINT32 mNextCommandId;
 
 		Stack<GroupData> mGroups;
+
+		UndoStateStorage mStateStorage;
+		UINT64 mMemoryBudget;
 	};
 
 	/** @} */
@@ -0,0 +1,150 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsEditorPrerequisites.h"
+
+namespace BansheeEngine
+{
+	/** @addtogroup UndoRedo
+	 *  @{
+	 */
+
+	/** Determines how UndoStateStorage stores serialized object states. */
+	enum class UndoStorageMode
+	{
+		/** Every state is stored as a complete copy of the serialized data. */
+		Full,
+		/**
+		 * States are stored as a delta against a baseline shared with other states recorded for the same object. A new
+		 * baseline is created only when the delta would be too large.
+		 */
+		Delta
+	};
+
+	/** Serialized data shared between multiple states stored by UndoStateStorage. */
+	struct BS_ED_EXPORT UndoStateBaseline
+	{
+		~UndoStateBaseline();
+
+		UndoStateStorage* storage;
+		UINT8* data;
+		UINT32 dataSize;
+		UINT32 size;
+		bool compressed;
+	};
+
+	/**
+	 * Serialized object state stored by UndoStateStorage. Use UndoStateStorage::load() to retrieve the original serialized
+	 * data.
+	 */
+	class BS_ED_EXPORT UndoState
+	{
+	public:
+		~UndoState();
+
+		/** Returns the size of the serialized data this state represents, in bytes. */
+		UINT32 getSize() const { return mSize; }
+
+		/** Returns the number of bytes this state occupies in memory, excluding any shared baseline. */
+		UINT32 getMemoryUsage() const { return mDataSize; }
+
+	private:
+		friend class UndoStateStorage;
+
+		UndoState(UndoStateStorage* storage);
+
+		UndoStateStorage* mStorage;
+		SPtr<UndoStateBaseline> mBaseline;
+
+		UINT8* mData;
+		UINT32 mDataSize;
+		UINT32 mDeltaSize;
+		UINT32 mSize;
+		bool mCompressed;
+	};
+
+	/**
+	 * Stores serialized object states recorded by undo/redo commands. Consecutive states recorded for the same object tend
+	 * to differ only slightly, so they can be stored as deltas against a shared baseline, and optionally compressed,
+	 * greatly reducing the memory cost of each recorded state.
+	 */
+	class BS_ED_EXPORT UndoStateStorage
+	{
+	public:
+		UndoStateStorage();
+		~UndoStateStorage();
+
+		/**
+		 * Stores serialized data of an object.
+		 *
+		 * @param[in]	key		Identifier of the object the data was generated from (e.g. its instance ID). Deltas are only
+		 *						generated between states with the same key.
+		 * @param[in]	data	Serialized data, allocated with bs_alloc. Storage takes ownership of the data.
+		 * @param[in]	size	Size of the serialized data in bytes.
+		 * @return				State that may be used for retrieving the data later.
+		 */
+		SPtr<UndoState> store(UINT64 key, UINT8* data, UINT32 size);
+
+		/**
+		 * Retrieves serialized data of a previously stored state. Returned buffer is allocated with bs_alloc and must be
+		 * freed by the caller using bs_free.
+		 */
+		UINT8* load(const SPtr<UndoState>& state, UINT32& size) const;
+
+		/** Changes how new states are stored. Previously stored states are unaffected. */
+		void setMode(UndoStorageMode mode) { mMode = mode; }
+
+		/** Returns how new states are stored. */
+		UndoStorageMode getMode() const { return mMode; }
+
+		/** Determines should stored states be compressed. Saves memory at the cost of slower storing and loading. */
+		void setCompressionEnabled(bool enabled) { mCompressionEnabled = enabled; }
+
+		/** Checks are stored states being compressed. */
+		bool isCompressionEnabled() const { return mCompressionEnabled; }
+
+		/** Returns the total number of bytes occupied by all currently stored states, including their baselines. */
+		UINT64 getMemoryUsage() const { return mMemoryUsage; }
+
+		/** Forgets all baselines. Existing states remain valid, but new states won't generate deltas against old data. */
+		void clear();
+
+		/**
+		 * Compresses the provided data. Returns null if the data cannot be compressed to less than its original size.
+		 * Returned buffer is allocated with bs_alloc.
+		 */
+		static UINT8* compress(const UINT8* data, UINT32 size, UINT32& compressedSize);
+
+		/** Decompresses data compressed with compress() into the provided buffer of @p size bytes. */
+		static void decompress(const UINT8* data, UINT32 dataSize, UINT8* output, UINT32 size);
+
+	private:
+		friend class UndoState;
+		friend struct UndoStateBaseline;
+
+		/**
+		 * Generates a delta that transforms @p orgData into @p newData. Returns null if the delta is larger than
+		 * @p maxSize bytes. Returned buffer is allocated with bs_alloc.
+		 */
+		static UINT8* generateDelta(const UINT8* orgData, UINT32 orgSize, const UINT8* newData, UINT32 newSize,
+			UINT32 maxSize, UINT32& deltaSize);
+
+		/** Applies a delta generated by generateDelta() to @p orgData, outputting the new data into @p output. */
+		static void applyDelta(const UINT8* orgData, const UINT8* delta, UINT32 deltaSize, UINT8* output);
+
+		/** Creates a new baseline from the provided data, taking ownership of it. */
+		SPtr<UndoStateBaseline> createBaseline(UINT8* data, UINT32 size);
+
+		/** Outputs uncompressed baseline data. @p buffer is set if the data had to be decompressed and must be freed. */
+		static const UINT8* getBaselineData(const UndoStateBaseline& baseline, UINT8*& buffer);
+
+		UndoStorageMode mMode;
+		bool mCompressionEnabled;
+		UINT64 mMemoryUsage;
+
+		UnorderedMap<UINT64, std::weak_ptr<UndoStateBaseline>> mBaselines;
+	};
+
+	/** @} */
+}
@@ -8,8 +8,7 @@
 namespace BansheeEngine
 {
 	CmdDeleteSO::CmdDeleteSO(const WString& description, const HSceneObject& sceneObject)
-		: EditorCommand(description), mSceneObject(sceneObject), mSerializedObject(nullptr), mSerializedObjectSize(0)
-		, mSerializedObjectParentId(0)
+		: EditorCommand(description), mSceneObject(sceneObject), mSerializedObjectParentId(0)
 	{
 
 	}
@@ -22,14 +21,8 @@ namespace BansheeEngine
 
 	void CmdDeleteSO::clear()
 	{
-		mSerializedObjectSize = 0;
+		mSerializedObject = nullptr;
 		mSerializedObjectParentId = 0;
-
-		if (mSerializedObject != nullptr)
-		{
-			bs_free(mSerializedObject);
-			mSerializedObject = nullptr;
-		}
 	}
 
 	void CmdDeleteSO::execute(const HSceneObject& sceneObject, const WString& description)
@@ -67,8 +60,12 @@ namespace BansheeEngine
 		if (!mSceneObject.isDestroyed())
 			mSceneObject->destroy(true);
 
+		UINT32 serializedObjectSize = 0;
+		UINT8* serializedObject = UndoRedo::instance().getStateStorage().load(mSerializedObject, serializedObjectSize);
+
 		MemorySerializer serializer;
-		SPtr<SceneObject> restored = std::static_pointer_cast<SceneObject>(serializer.decode(mSerializedObject, mSerializedObjectSize));
+		SPtr<SceneObject> restored = std::static_pointer_cast<SceneObject>(serializer.decode(serializedObject, serializedObjectSize));
+		bs_free(serializedObject);
 
 		CmdUtility::restoreIds(restored->getHandle(), mSceneObjectProxy);
 		restored->setParent(parent);
@@ -77,7 +74,11 @@ namespace BansheeEngine
 	void CmdDeleteSO::recordSO(const HSceneObject& sceneObject)
 	{
 		MemorySerializer serializer;
-		mSerializedObject = serializer.encode(mSceneObject.get(), mSerializedObjectSize);
+		UINT32 serializedObjectSize = 0;
+		UINT8* serializedObject = serializer.encode(mSceneObject.get(), serializedObjectSize);
+
+		UndoStateStorage& storage = UndoRedo::instance().getStateStorage();
+		mSerializedObject = storage.store(mSceneObject->getInstanceId(), serializedObject, serializedObjectSize);
 
 		HSceneObject parent = mSceneObject->getParent();
 		if (parent != nullptr)
@@ -9,7 +9,6 @@ namespace BansheeEngine
 {
 	CmdRecordSO::CmdRecordSO(const WString& description, const HSceneObject& sceneObject, bool recordHierarchy)
 		: EditorCommand(description), mSceneObject(sceneObject), mRecordHierarchy(recordHierarchy)
-		, mSerializedObject(nullptr), mSerializedObjectSize(0)
 	{
 
 	}
@@ -22,13 +21,7 @@ namespace BansheeEngine
 
 	void CmdRecordSO::clear()
 	{
-		mSerializedObjectSize = 0;
-
-		if (mSerializedObject != nullptr)
-		{
-			bs_free(mSerializedObject);
-			mSerializedObject = nullptr;
-		}
+		mSerializedObject = nullptr;
 	}
 
 	void CmdRecordSO::execute(const HSceneObject& sceneObject, bool recordHierarchy, const WString& description)
@@ -74,8 +67,12 @@ namespace BansheeEngine
 
 		GameObjectManager::instance().setDeserializationMode(GODM_RestoreExternal | GODM_UseNewIds);
 
+		UINT32 serializedObjectSize = 0;
+		UINT8* serializedObject = UndoRedo::instance().getStateStorage().load(mSerializedObject, serializedObjectSize);
+
 		MemorySerializer serializer;
-		SPtr<SceneObject> restored = std::static_pointer_cast<SceneObject>(serializer.decode(mSerializedObject, mSerializedObjectSize));
+		SPtr<SceneObject> restored = std::static_pointer_cast<SceneObject>(serializer.decode(serializedObject, serializedObjectSize));
+		bs_free(serializedObject);
 
 		CmdUtility::restoreIds(restored->getHandle(), mSceneObjectProxy);
 		restored->setParent(parent);
@@ -107,7 +104,11 @@ namespace BansheeEngine
 		}
 
 		MemorySerializer serializer;
-		mSerializedObject = serializer.encode(mSceneObject.get(), mSerializedObjectSize);
+		UINT32 serializedObjectSize = 0;
+		UINT8* serializedObject = serializer.encode(mSceneObject.get(), serializedObjectSize);
+
+		UndoStateStorage& storage = UndoRedo::instance().getStateStorage();
+		mSerializedObject = storage.store(mSceneObject->getInstanceId(), serializedObject, serializedObjectSize);
 
 		mSceneObjectProxy = CmdUtility::createProxy(mSceneObject);
 
@@ -0,0 +1,551 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsEditorBenchmarkSuite.h"
+#include "BsEditorTestSuite.h"
+#include "BsTimer.h"
+#include "BsDebug.h"
+#include "BsMath.h"
+#include "BsAnimationClip.h"
+#include "BsPixelData.h"
+#include "BsPixelUtil.h"
+#include "BsTaskScheduler.h"
+#include "BsPickingBVH.h"
+#include "BsMeshData.h"
+#include "BsVertexDataDesc.h"
+#include "BsBatchMath.h"
+
+namespace BansheeEngine
+{
+	EditorBenchmarkSuite::EditorBenchmarkSuite()
+	{
+		BS_ADD_TEST(EditorBenchmarkSuite::BenchmarkAnimationClip)
+		BS_ADD_TEST(EditorBenchmarkSuite::BenchmarkPixelConversion)
+		BS_ADD_TEST(EditorBenchmarkSuite::BenchmarkPicking)
+		BS_ADD_TEST(EditorBenchmarkSuite::BenchmarkBatchMath)
+	}
+
+	void EditorBenchmarkSuite::BenchmarkAnimationClip()
+	{
+		static const UINT32 NUM_CLIPS = 4;
+		static const UINT32 NUM_BONES = 60;
+		static const UINT32 NUM_OBJECTS = 1000;
+		static const UINT32 NUM_FRAMES = 60;
+		static const UINT32 NUM_KEYS = 31;
+		static const float FRAME_STEP = 1.0f / 60.0f;
+
+		auto createCurve = [](float length, float offset, float amplitude, float frequency, float phase)
+		{
+			Vector<Keyframe> keyframes(NUM_KEYS);
+			for (UINT32 i = 0; i < NUM_KEYS; i++)
+			{
+				float time = length * i / (float)(NUM_KEYS - 1);
+
+				keyframes[i].time = time;
+				keyframes[i].value = offset + amplitude * std::sin(frequency * time + phase);
+				keyframes[i].inTangent = amplitude * frequency * std::cos(frequency * time + phase);
+				keyframes[i].outTangent = keyframes[i].inTangent;
+			}
+
+			return AnimationCurve(keyframes);
+		};
+
+		Vector<Vector<BoneAnimationCurves>> curves(NUM_CLIPS);
+		Vector<SPtr<AnimationClip>> clips(NUM_CLIPS);
+		for (UINT32 i = 0; i < NUM_CLIPS; i++)
+		{
+			float length = 1.0f + i * 0.25f;
+
+			curves[i].resize(NUM_BONES);
+			for (UINT32 j = 0; j < NUM_BONES; j++)
+			{
+				BoneAnimationCurves& bone = curves[i][j];
+				for (UINT32 k = 0; k < 3; k++)
+				{
+					bone.position[k] = createCurve(length, (float)k, 0.5f, 6.0f, (float)(j + k));
+					bone.scale[k] = createCurve(length, 1.0f, 0.1f, 3.0f, (float)k);
+				}
+
+				for (UINT32 k = 0; k < 4; k++)
+					bone.rotation[k] = createCurve(length, 0.5f, 0.3f, 4.0f, j * 0.3f + k);
+			}
+
+			clips[i] = AnimationClip::_createPtr(curves[i]);
+		}
+
+		Vector<AnimationClipState> states(NUM_OBJECTS);
+		for (UINT32 i = 0; i < NUM_OBJECTS; i++)
+		{
+			states[i].clip = clips[i % NUM_CLIPS];
+			states[i].time = i * 0.013f;
+		}
+
+		// Compressed clips, evaluated in a batch
+		Timer timer;
+		for (UINT32 i = 0; i < NUM_FRAMES; i++)
+		{
+			for (auto& state : states)
+				state.time += FRAME_STEP;
+
+			AnimationClip::evaluate(states.data(), NUM_OBJECTS);
+		}
+
+		UINT64 compressedTime = timer.getMicroseconds();
+
+		// Uncompressed curves, evaluated one by one
+		Vector<BoneTransform> transforms(NUM_OBJECTS * NUM_BONES);
+		Vector<float> times(NUM_OBJECTS);
+		for (UINT32 i = 0; i < NUM_OBJECTS; i++)
+			times[i] = i * 0.013f;
+
+		timer.reset();
+		for (UINT32 i = 0; i < NUM_FRAMES; i++)
+		{
+			for (UINT32 j = 0; j < NUM_OBJECTS; j++)
+			{
+				times[j] += FRAME_STEP;
+
+				const Vector<BoneAnimationCurves>& clipCurves = curves[j % NUM_CLIPS];
+				for (UINT32 k = 0; k < NUM_BONES; k++)
+				{
+					const BoneAnimationCurves& bone = clipCurves[k];
+					BoneTransform& transform = transforms[j * NUM_BONES + k];
+
+					for (UINT32 l = 0; l < 3; l++)
+					{
+						transform.position[l] = bone.position[l].evaluate(times[j]);
+						transform.scale[l] = bone.scale[l].evaluate(times[j]);
+					}
+
+					for (UINT32 l = 0; l < 4; l++)
+						transform.rotation[l] = bone.rotation[l].evaluate(times[j]);
+
+					transform.rotation.normalize();
+				}
+			}
+		}
+
+		UINT64 uncompressedTime = timer.getMicroseconds();
+
+		float maxError = 0.0f;
+		for (UINT32 i = 0; i < NUM_OBJECTS; i++)
+		{
+			for (UINT32 j = 0; j < NUM_BONES; j++)
+			{
+				const BoneTransform& compressed = states[i].bones[j];
+				const BoneTransform& uncompressed = transforms[i * NUM_BONES + j];
+
+				for (UINT32 k = 0; k < 3; k++)
+				{
+					maxError = std::max(maxError, Math::abs(compressed.position[k] - uncompressed.position[k]));
+					maxError = std::max(maxError, Math::abs(compressed.scale[k] - uncompressed.scale[k]));
+				}
+
+				for (UINT32 k = 0; k < 4; k++)
+					maxError = std::max(maxError, Math::abs(compressed.rotation[k] - uncompressed.rotation[k]));
+			}
+		}
+
+		BS_TEST_ASSERT(maxError < 0.001f);
+
+		LOGDBG("Animation clip evaluation, " + toString(NUM_OBJECTS) + " objects with " + toString(NUM_BONES) + 
+			" bones: compressed " + toString(compressedTime / (float)(NUM_FRAMES * 1000)) + " ms/frame, uncompressed " + 
+			toString(uncompressedTime / (float)(NUM_FRAMES * 1000)) + " ms/frame, max error " + toString(maxError));
+	}
+
+	void EditorBenchmarkSuite::BenchmarkPixelConversion()
+	{
+		static const UINT32 WIDTH = 2048;
+		static const UINT32 HEIGHT = 2048;
+		static const UINT32 NUM_ITERATIONS = 5;
+
+		// Small enough for bulk conversion to run on the calling thread
+		static const UINT32 ROWS_PER_BAND = 32;
+
+		static const PixelFormat DST_FORMATS[] = { PF_B8G8R8A8, PF_R8G8B8, PF_FLOAT32_RGBA };
+
+		PixelData src(WIDTH, HEIGHT, 1, PF_R8G8B8A8);
+		src.allocateInternalBuffer();
+
+		UINT8* srcData = src.getData();
+		for (UINT32 i = 0; i < WIDTH * HEIGHT * 4; i++)
+			srcData[i] = (UINT8)(i * 31 + (i >> 13));
+
+		for (auto dstFormat : DST_FORMATS)
+		{
+			UINT32 dstPixelSize = PixelUtil::getNumElemBytes(dstFormat);
+
+			// Bulk conversion, split over worker threads
+			PixelData dst(WIDTH, HEIGHT, 1, dstFormat);
+			dst.allocateInternalBuffer();
+
+			Timer timer;
+			for (UINT32 i = 0; i < NUM_ITERATIONS; i++)
+				PixelUtil::bulkPixelConversion(src, dst);
+
+			UINT64 parallelTime = timer.getMicroseconds();
+
+			// Bulk conversion on a single thread, one band of rows at a time
+			PixelData singleThreadDst(WIDTH, HEIGHT, 1, dstFormat);
+			singleThreadDst.allocateInternalBuffer();
+
+			timer.reset();
+			for (UINT32 i = 0; i < NUM_ITERATIONS; i++)
+			{
+				for (UINT32 j = 0; j < HEIGHT; j += ROWS_PER_BAND)
+				{
+					PixelVolume band(0, 0, WIDTH, ROWS_PER_BAND);
+
+					PixelData srcBand(band, PF_R8G8B8A8);
+					srcBand.setExternalBuffer(srcData + j * WIDTH * 4);
+
+					PixelData dstBand(band, dstFormat);
+					dstBand.setExternalBuffer(singleThreadDst.getData() + j * WIDTH * dstPixelSize);
+
+					PixelUtil::bulkPixelConversion(srcBand, dstBand);
+				}
+			}
+
+			UINT64 singleThreadTime = timer.getMicroseconds();
+
+			// Pixel by pixel, through floating point
+			PixelData referenceDst(WIDTH, HEIGHT, 1, dstFormat);
+			referenceDst.allocateInternalBuffer();
+
+			UINT8* referenceData = referenceDst.getData();
+
+			timer.reset();
+			for (UINT32 i = 0; i < NUM_ITERATIONS; i++)
+			{
+				for (UINT32 j = 0; j < WIDTH * HEIGHT; j++)
+				{
+					float r, g, b, a;
+					PixelUtil::unpackColor(&r, &g, &b, &a, PF_R8G8B8A8, srcData + j * 4);
+					PixelUtil::packColor(r, g, b, a, dstFormat, referenceData + j * dstPixelSize);
+				}
+			}
+
+			UINT64 referenceTime = timer.getMicroseconds();
+
+			UINT32 dstSize = WIDTH * HEIGHT * dstPixelSize;
+			BS_TEST_ASSERT(memcmp(dst.getData(), referenceData, dstSize) == 0);
+			BS_TEST_ASSERT(memcmp(singleThreadDst.getData(), referenceData, dstSize) == 0);
+
+			float toMs = 1.0f / (NUM_ITERATIONS * 1000);
+			LOGDBG("Pixel conversion, " + toString(WIDTH) + "x" + toString(HEIGHT) + " " + 
+				PixelUtil::getFormatName(PF_R8G8B8A8) + " to " + PixelUtil::getFormatName(dstFormat) + ": parallel " + 
+				toString(parallelTime * toMs) + " ms, single thread " + toString(singleThreadTime * toMs) + 
+				" ms, per pixel " + toString(referenceTime * toMs) + " ms");
+		}
+	}
+
+	void EditorBenchmarkSuite::BenchmarkPicking()
+	{
+		static const UINT32 GRID_SIZE = 128;
+		static const UINT32 NUM_LAYERS = 4;
+		static const UINT32 NUM_RAYS = 500;
+
+		TestRandom random(12345);
+
+		// Stacked bumpy grids, so most rays hit several layers of triangles
+		UINT32 numVertices = (GRID_SIZE + 1) * (GRID_SIZE + 1) * NUM_LAYERS;
+		UINT32 numTriangles = GRID_SIZE * GRID_SIZE * 2 * NUM_LAYERS;
+
+		SPtr<VertexDataDesc> vertexDesc = bs_shared_ptr_new<VertexDataDesc>();
+		vertexDesc->addVertElem(VET_FLOAT3, VES_POSITION);
+
+		SPtr<MeshData> meshData = bs_shared_ptr_new<MeshData>(numVertices, numTriangles * 3, vertexDesc);
+
+		Vector<Vector3> positions;
+		auto positionIter = meshData->getVec3DataIter(VES_POSITION);
+		for (UINT32 i = 0; i < NUM_LAYERS; i++)
+		{
+			for (UINT32 y = 0; y <= GRID_SIZE; y++)
+			{
+				for (UINT32 x = 0; x <= GRID_SIZE; x++)
+				{
+					Vector3 position((float)x, (float)y, i * 5.0f + random.range(-1.0f, 1.0f));
+
+					positions.push_back(position);
+					positionIter.addValue(position);
+				}
+			}
+		}
+
+		UINT32* indices = meshData->getIndices32();
+		UINT32 numIndices = 0;
+		for (UINT32 i = 0; i < NUM_LAYERS; i++)
+		{
+			UINT32 layerStart = i * (GRID_SIZE + 1) * (GRID_SIZE + 1);
+			for (UINT32 y = 0; y < GRID_SIZE; y++)
+			{
+				for (UINT32 x = 0; x < GRID_SIZE; x++)
+				{
+					UINT32 corner = layerStart + y * (GRID_SIZE + 1) + x;
+
+					indices[numIndices++] = corner;
+					indices[numIndices++] = corner + 1;
+					indices[numIndices++] = corner + GRID_SIZE + 1;
+
+					indices[numIndices++] = corner + 1;
+					indices[numIndices++] = corner + GRID_SIZE + 2;
+					indices[numIndices++] = corner + GRID_SIZE + 1;
+				}
+			}
+		}
+
+		Vector<Ray> rays(NUM_RAYS);
+		for (UINT32 i = 0; i < NUM_RAYS; i++)
+		{
+			Vector3 origin(random.range(0.0f, (float)GRID_SIZE), random.range(0.0f, (float)GRID_SIZE), -20.0f);
+			Vector3 target(random.range(0.0f, (float)GRID_SIZE), random.range(0.0f, (float)GRID_SIZE), 0.0f);
+
+			rays[i] = Ray(origin, Vector3::normalize(target - origin));
+		}
+
+		// Hierarchy
+		Timer timer;
+		MeshPickingData pickingData(meshData, { SubMesh(0, numTriangles * 3, DOT_TRIANGLE_LIST) });
+		pickingData.build();
+
+		UINT64 buildTime = timer.getMicroseconds();
+
+		Vector<float> bvhDistances(NUM_RAYS, std::numeric_limits<float>::max());
+
+		timer.reset();
+		for (UINT32 i = 0; i < NUM_RAYS; i++)
+		{
+			float distance;
+			if (pickingData.intersects(rays[i], distance))
+				bvhDistances[i] = distance;
+		}
+
+		UINT64 bvhTime = timer.getMicroseconds();
+
+		// Every triangle
+		Vector<float> bruteForceDistances(NUM_RAYS, std::numeric_limits<float>::max());
+
+		timer.reset();
+		for (UINT32 i = 0; i < NUM_RAYS; i++)
+		{
+			for (UINT32 j = 0; j < numTriangles; j++)
+			{
+				const Vector3& a = positions[indices[j * 3 + 0]];
+				const Vector3& b = positions[indices[j * 3 + 1]];
+				const Vector3& c = positions[indices[j * 3 + 2]];
+
+				auto result = rays[i].intersects(a, b, c, (b - a).cross(c - a));
+				if (result.first && result.second < bruteForceDistances[i])
+					bruteForceDistances[i] = result.second;
+			}
+		}
+
+		UINT64 bruteForceTime = timer.getMicroseconds();
+
+		UINT32 numHits = 0;
+		for (UINT32 i = 0; i < NUM_RAYS; i++)
+		{
+			bool bvhHit = bvhDistances[i] != std::numeric_limits<float>::max();
+			bool bruteForceHit = bruteForceDistances[i] != std::numeric_limits<float>::max();
+
+			BS_TEST_ASSERT(bvhHit == bruteForceHit);
+			if (bvhHit && bruteForceHit)
+			{
+				BS_TEST_ASSERT(Math::abs(bvhDistances[i] - bruteForceDistances[i]) < 0.01f);
+				numHits++;
+			}
+		}
+
+		LOGDBG("Picking, " + toString(NUM_RAYS) + " rays against " + toString(numTriangles) + " triangles (" + 
+			toString(numHits) + " hits): hierarchy build " + toString(buildTime / 1000.0f) + " ms, hierarchy " + 
+			toString(bvhTime / 1000.0f) + " ms, every triangle " + toString(bruteForceTime / 1000.0f) + " ms");
+	}
+
+	void EditorBenchmarkSuite::BenchmarkBatchMath()
+	{
+		static const UINT32 COUNT = 10000;
+		static const UINT32 NUM_ITERATIONS = 100;
+
+		TestRandom random(54321);
+		auto randomVector = [&](float min, float max)
+		{
+			Vector3 output;
+			for (UINT32 i = 0; i < 3; i++)
+				output[i] = random.range(min, max);
+
+			return output;
+		};
+
+		auto randomRotation = [&]()
+		{
+			Quaternion output;
+			for (UINT32 i = 0; i < 4; i++)
+				output[i] = random.range(-1.0f, 1.0f);
+
+			output.normalize();
+			return output;
+		};
+
+		Vector<Vector3> translations(COUNT);
+		Vector<Quaternion> rotations(COUNT);
+		Vector<Vector3> scales(COUNT);
+		Vector<Matrix4> otherMatrices(COUNT);
+		Vector<Vector3> points(COUNT);
+		Vector<AABox> boxes(COUNT);
+		for (UINT32 i = 0; i < COUNT; i++)
+		{
+			translations[i] = randomVector(-100.0f, 100.0f);
+			rotations[i] = randomRotation();
+			scales[i] = randomVector(0.1f, 5.0f);
+
+			otherMatrices[i] = Matrix4::TRS(randomVector(-100.0f, 100.0f), randomRotation(), randomVector(0.1f, 5.0f));
+			points[i] = randomVector(-100.0f, 100.0f);
+
+			Vector3 min = randomVector(-10.0f, 10.0f);
+			boxes[i] = AABox(min, min + randomVector(0.0f, 10.0f));
+		}
+
+		Vector<Matrix4> batchMatrices(COUNT);
+		Vector<Matrix4> scalarMatrices(COUNT);
+		Vector<Vector3> batchPoints(COUNT);
+		Vector<Vector3> scalarPoints(COUNT);
+		Vector<AABox> batchBoxes(COUNT);
+		Vector<AABox> scalarBoxes(COUNT);
+
+		float maxError = 0.0f;
+		auto updateError = [&](const Matrix4& a, const Matrix4& b)
+		{
+			for (UINT32 row = 0; row < 4; row++)
+			{
+				for (UINT32 col = 0; col < 4; col++)
+					maxError = std::max(maxError, Math::abs(a[row][col] - b[row][col]));
+			}
+		};
+
+		auto toMs = [](UINT64 time) { return time / (float)(NUM_ITERATIONS * 1000); };
+		String report = "Batch math, " + toString(COUNT) + " objects:";
+
+		// TRS
+		Timer timer;
+		for (UINT32 i = 0; i < NUM_ITERATIONS; i++)
+			BatchMath::TRS(translations.data(), rotations.data(), scales.data(), batchMatrices.data(), COUNT);
+
+		UINT64 batchTime = timer.getMicroseconds();
+
+		timer.reset();
+		for (UINT32 i = 0; i < NUM_ITERATIONS; i++)
+		{
+			for (UINT32 j = 0; j < COUNT; j++)
+				scalarMatrices[j] = Matrix4::TRS(translations[j], rotations[j], scales[j]);
+		}
+
+		UINT64 scalarTime = timer.getMicroseconds();
+
+		for (UINT32 i = 0; i < COUNT; i++)
+			updateError(batchMatrices[i], scalarMatrices[i]);
+
+		report += " TRS " + toString(toMs(batchTime)) + "/" + toString(toMs(scalarTime)) + " ms,";
+
+		// Inverse
+		Vector<Matrix4> matrices = scalarMatrices;
+
+		timer.reset();
+		for (UINT32 i = 0; i < NUM_ITERATIONS; i++)
+			BatchMath::inverseAffine(matrices.data(), batchMatrices.data(), COUNT);
+
+		batchTime = timer.getMicroseconds();
+
+		timer.reset();
+		for (UINT32 i = 0; i < NUM_ITERATIONS; i++)
+		{
+			for (UINT32 j = 0; j < COUNT; j++)
+				scalarMatrices[j] = matrices[j].inverseAffine();
+		}
+
+		scalarTime = timer.getMicroseconds();
+
+		for (UINT32 i = 0; i < COUNT; i++)
+			updateError(batchMatrices[i], scalarMatrices[i]);
+
+		report += " inverse " + toString(toMs(batchTime)) + "/" + toString(toMs(scalarTime)) + " ms,";
+
+		// Multiply
+		timer.reset();
+		for (UINT32 i = 0; i < NUM_ITERATIONS; i++)
+			BatchMath::multiplyAffine(matrices.data(), otherMatrices.data(), batchMatrices.data(), COUNT);
+
+		batchTime = timer.getMicroseconds();
+
+		timer.reset();
+		for (UINT32 i = 0; i < NUM_ITERATIONS; i++)
+		{
+			for (UINT32 j = 0; j < COUNT; j++)
+				scalarMatrices[j] = matrices[j].concatenateAffine(otherMatrices[j]);
+		}
+
+		scalarTime = timer.getMicroseconds();
+
+		for (UINT32 i = 0; i < COUNT; i++)
+			updateError(batchMatrices[i], scalarMatrices[i]);
+
+		report += " multiply " + toString(toMs(batchTime)) + "/" + toString(toMs(scalarTime)) + " ms,";
+
+		// Points
+		timer.reset();
+		for (UINT32 i = 0; i < NUM_ITERATIONS; i++)
+			BatchMath::transformPoints(matrices[0], points.data(), batchPoints.data(), COUNT);
+
+		batchTime = timer.getMicroseconds();
+
+		timer.reset();
+		for (UINT32 i = 0; i < NUM_ITERATIONS; i++)
+		{
+			for (UINT32 j = 0; j < COUNT; j++)
+				scalarPoints[j] = matrices[0].multiplyAffine(points[j]);
+		}
+
+		scalarTime = timer.getMicroseconds();
+
+		for (UINT32 i = 0; i < COUNT; i++)
+		{
+			for (UINT32 j = 0; j < 3; j++)
+				maxError = std::max(maxError, Math::abs(batchPoints[i][j] - scalarPoints[i][j]));
+		}
+
+		report += " points " + toString(toMs(batchTime)) + "/" + toString(toMs(scalarTime)) + " ms,";
+
+		// Bounds
+		timer.reset();
+		for (UINT32 i = 0; i < NUM_ITERATIONS; i++)
+			BatchMath::transformAffine(matrices.data(), boxes.data(), batchBoxes.data(), COUNT);
+
+		batchTime = timer.getMicroseconds();
+
+		timer.reset();
+		for (UINT32 i = 0; i < NUM_ITERATIONS; i++)
+		{
+			for (UINT32 j = 0; j < COUNT; j++)
+			{
+				scalarBoxes[j] = boxes[j];
+				scalarBoxes[j].transformAffine(matrices[j]);
+			}
+		}
+
+		scalarTime = timer.getMicroseconds();
+
+		for (UINT32 i = 0; i < COUNT; i++)
+		{
+			for (UINT32 j = 0; j < 3; j++)
+			{
+				maxError = std::max(maxError, Math::abs(batchBoxes[i].getMin()[j] - scalarBoxes[i].getMin()[j]));
+				maxError = std::max(maxError, Math::abs(batchBoxes[i].getMax()[j] - scalarBoxes[i].getMax()[j]));
+			}
+		}
+
+		report += " bounds " + toString(toMs(batchTime)) + "/" + toString(toMs(scalarTime)) + " ms";
+
+		// Values reach a few thousand, so only compare within float precision at that magnitude
+		BS_TEST_ASSERT(maxError < 0.01f);
+
+		LOGDBG(report + " (batch/per object), max error " + toString(maxError));
+	}
+}
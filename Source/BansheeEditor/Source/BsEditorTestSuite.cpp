@@ -5,6 +5,7 @@
 #include "BsCmdRecordSO.h"
 #include "BsCmdDeleteSO.h"
 #include "BsUndoRedo.h"
+#include "BsUndoStateStorage.h"
 #include "BsRTTIType.h"
 #include "BsGameObjectRTTI.h"
 #include "BsBinarySerializer.h"
@@ -15,6 +16,38 @@
 #include "BsPrefabDiff.h"
 #include "BsFrameAlloc.h"
 #include "BsFileSystem.h"
+#include "BsPickingBVH.h"
+#include "BsBatchMath.h"
+#include "BsMeshData.h"
+#include "BsVertexDataDesc.h"
+#include "BsPlane.h"
+#include "BsPixelUtil.h"
+#include "BsAnimationClip.h"
+#include "BsAnimationUtility.h"
+#include "BsSkeleton.h"
+#include "BsSkinnedMesh.h"
+#include "BsRendererMeshData.h"
+#include "BsGUIElementGrid.h"
+#include "BsGUILabel.h"
+#include "BsGUILayoutY.h"
+#include "BsGUISpace.h"
+#include "BsGUITreeView.h"
+#include "BsRenderAPI.h"
+#include "BsRenderTexture.h"
+#include "BsPipelineState.h"
+#include "BsRenderStats.h"
+#include "BsCoreThread.h"
+#include "BsBuiltinResources.h"
+#include "BsShader.h"
+#include "BsMaterial.h"
+#include "BsPass.h"
+#include "BsGpuProgram.h"
+#include "BsGpuParamDesc.h"
+#include "BsCoreRenderer.h"
+#include "BsSceneManager.h"
+#include "BsRenderable.h"
+#include "BsCamera.h"
+#include "BsLight.h"
 
 namespace BansheeEngine
 {
@@ -405,13 +438,99 @@ namespace BansheeEngine
 		return TestComponentD::getRTTIStatic();
 	}
 
+	/** Memory category used for testing allocations served by SmallObjectAlloc. */
+	class SmallObjectTestAlloc
+	{ };
+
+	template<>
+	struct MemoryCategoryTraits<SmallObjectTestAlloc>
+	{
+		static const char* getName() { return "TestSmallObject"; }
+		static const MemoryBackend Backend = MemoryBackend::SmallObject;
+	};
+
+	/** Tree view displaying a flat list of elements, used for testing GUITreeView. */
+	class TestTreeView : public GUITreeView
+	{
+	public:
+		TestTreeView(UINT32 numElements)
+			:GUITreeView(StringUtil::BLANK, StringUtil::BLANK, StringUtil::BLANK, StringUtil::BLANK, StringUtil::BLANK,
+			StringUtil::BLANK, StringUtil::BLANK, StringUtil::BLANK, GUIDimensions::create())
+		{
+			mRootElement.mIsExpanded = true;
+
+			for (UINT32 i = 0; i < numElements; i++)
+			{
+				TreeElement* element = bs_new<TreeElement>();
+				element->mParent = &mRootElement;
+				element->mSortedIdx = i;
+				element->mName = toString(i);
+
+				mRootElement.mChildren.push_back(element);
+				updateElementGUI(element);
+			}
+		}
+
+		using GUITreeView::_getOptimalSize;
+		using GUITreeView::_updateOptimalLayoutSizes;
+		using GUITreeView::_updateLayoutInternal;
+
+		/** Checks if the element at the specified index currently has a GUI element assigned. */
+		bool hasElementGUI(UINT32 idx) const { return mRootElement.mChildren[idx]->mElement != nullptr; }
+
+		/** Checks if the size of the element at the specified index has been calculated. */
+		bool isElementMeasured(UINT32 idx) const { return mRootElement.mChildren[idx]->mElementWidth >= 0; }
+
+		/** Returns the number of elements that currently have a GUI element assigned. */
+		UINT32 getNumElementsWithGUI() const
+		{
+			UINT32 count = 0;
+			for (auto& child : mRootElement.mChildren)
+			{
+				if (child->mElement != nullptr)
+					count++;
+			}
+
+			return count;
+		}
+
+	protected:
+		TreeElement& getRootElement() override { return mRootElement; }
+		const TreeElement& getRootElementConst() const override { return mRootElement; }
+		void updateTreeElementHierarchy() override { }
+		void renameTreeElement(TreeElement* element, const WString& name) override { }
+		void deleteTreeElement(TreeElement* element) override { }
+		bool acceptDragAndDrop() const override { return false; }
+		void dragAndDropStart(const Vector<TreeElement*>& elements) override { }
+		void dragAndDropEnded(TreeElement* overTreeElement) override { }
+
+		TreeElement mRootElement;
+	};
+
 	EditorTestSuite::EditorTestSuite()
 	{
 		BS_ADD_TEST(EditorTestSuite::SceneObjectRecord_UndoRedo);
 		BS_ADD_TEST(EditorTestSuite::SceneObjectDelete_UndoRedo);
+		BS_ADD_TEST(EditorTestSuite::TestUndoStateStorage);
 		BS_ADD_TEST(EditorTestSuite::BinaryDiff);
 		BS_ADD_TEST(EditorTestSuite::TestPrefabDiff);
 		BS_ADD_TEST(EditorTestSuite::TestFrameAlloc)
+		BS_ADD_TEST(EditorTestSuite::TestFrameAllocBlocks)
+		BS_ADD_TEST(EditorTestSuite::TestPickingBVH)
+		BS_ADD_TEST(EditorTestSuite::TestBatchMath)
+		BS_ADD_TEST(EditorTestSuite::TestPixelConversion)
+		BS_ADD_TEST(EditorTestSuite::TestMipmapGeneration)
+		BS_ADD_TEST(EditorTestSuite::TestAnimationClip)
+		BS_ADD_TEST(EditorTestSuite::TestSkinning)
+		BS_ADD_TEST(EditorTestSuite::TestGUIElementGrid)
+		BS_ADD_TEST(EditorTestSuite::TestGUILayoutCache)
+		BS_ADD_TEST(EditorTestSuite::TestGUITreeViewVirtualization)
+		BS_ADD_TEST(EditorTestSuite::TestSmallObjectAlloc)
+		BS_ADD_TEST(EditorTestSuite::TestMemoryTagging)
+		BS_ADD_TEST(EditorTestSuite::TestPipelineStateAfterClear)
+		BS_ADD_TEST(EditorTestSuite::TestEulerToQuaternionCurves)
+		BS_ADD_TEST(EditorTestSuite::TestInstancedShader)
+		BS_ADD_TEST(EditorTestSuite::TestSceneManagerUnregister)
 	}
 
 	void EditorTestSuite::SceneObjectRecord_UndoRedo()
@@ -505,6 +624,75 @@ namespace BansheeEngine
 		soExternal->destroy();
 	}
 
+	void EditorTestSuite::TestUndoStateStorage()
+	{
+		static const UINT32 DATA_SIZE = 4096;
+
+		auto createData = [](UINT32 size, UINT32 seed)
+		{
+			UINT8* data = (UINT8*)bs_alloc(size);
+			for (UINT32 i = 0; i < size; i++)
+				data[i] = (UINT8)((i / 64) * 7 + seed);
+
+			return data;
+		};
+
+		auto checkState = [](UndoStateStorage& storage, const SPtr<UndoState>& state, const UINT8* expected, UINT32 size)
+		{
+			UINT32 loadedSize = 0;
+			UINT8* loaded = storage.load(state, loadedSize);
+
+			bool equal = loadedSize == size && memcmp(loaded, expected, size) == 0;
+			bs_free(loaded);
+
+			return equal;
+		};
+
+		for (UINT32 i = 0; i < 2; i++)
+		{
+			UndoStateStorage storage;
+			storage.setCompressionEnabled(i == 1);
+
+			// Baseline
+			UINT8* data0 = createData(DATA_SIZE, 0);
+			UINT8* expected0 = createData(DATA_SIZE, 0);
+			SPtr<UndoState> state0 = storage.store(0, data0, DATA_SIZE);
+
+			// Same size with a few modified bytes
+			UINT8* data1 = createData(DATA_SIZE, 0);
+			data1[10] = 0xFF;
+			data1[2000] = 0xFE;
+			UINT8* expected1 = (UINT8*)bs_alloc(DATA_SIZE);
+			memcpy(expected1, data1, DATA_SIZE);
+			SPtr<UndoState> state1 = storage.store(0, data1, DATA_SIZE);
+
+			// Inserted bytes
+			UINT8* data2 = createData(DATA_SIZE + 4, 0);
+			memcpy(data2 + 104, expected0 + 100, DATA_SIZE - 100);
+			UINT8* expected2 = (UINT8*)bs_alloc(DATA_SIZE + 4);
+			memcpy(expected2, data2, DATA_SIZE + 4);
+			SPtr<UndoState> state2 = storage.store(0, data2, DATA_SIZE + 4);
+
+			BS_TEST_ASSERT(state1->getMemoryUsage() < DATA_SIZE / 2);
+			BS_TEST_ASSERT(state2->getMemoryUsage() < DATA_SIZE / 2);
+			BS_TEST_ASSERT(checkState(storage, state0, expected0, DATA_SIZE));
+			BS_TEST_ASSERT(checkState(storage, state1, expected1, DATA_SIZE));
+			BS_TEST_ASSERT(checkState(storage, state2, expected2, DATA_SIZE + 4));
+
+			if (i == 1)
+				BS_TEST_ASSERT(storage.getMemoryUsage() < DATA_SIZE);
+
+			state0 = nullptr;
+			state1 = nullptr;
+			state2 = nullptr;
+			BS_TEST_ASSERT(storage.getMemoryUsage() == 0);
+
+			bs_free(expected0);
+			bs_free(expected1);
+			bs_free(expected2);
+		}
+	}
+
 	void EditorTestSuite::BinaryDiff()
 	{
 		SPtr<TestObjectA> orgObj = bs_shared_ptr_new<TestObjectA>();
@@ -732,4 +920,1293 @@ namespace BansheeEngine
 		alloc.dealloc(a13);
 		alloc.clear();
 	}
+
+	void EditorTestSuite::TestFrameAllocBlocks()
+	{
+		static const UINT32 BLOCK_SIZE = 128;
+		static const UINT32 NUM_ALLOCS = 8;
+
+		// With profiling enabled aligned allocations have a header, so blocks freed in a different way than they were
+		// allocated corrupt the heap
+		FrameAlloc* alloc = bs_new<FrameAlloc>(BLOCK_SIZE);
+		for (UINT32 frame = 0; frame < 3; frame++)
+		{
+			alloc->markFrame();
+
+			// Each allocation is larger than a block, so a new block is allocated for every one of them
+			UINT8* allocs[NUM_ALLOCS];
+			for (UINT32 i = 0; i < NUM_ALLOCS; i++)
+			{
+				UINT32 size = BLOCK_SIZE * (i + 1) + 1;
+
+				allocs[i] = alloc->alloc(size);
+				memset(allocs[i], i, size);
+			}
+
+			bool isValid = true;
+			for (UINT32 i = 0; i < NUM_ALLOCS; i++)
+				isValid &= allocs[i][BLOCK_SIZE * (i + 1)] == i;
+
+			BS_TEST_ASSERT(isValid);
+
+			for (UINT32 i = 0; i < NUM_ALLOCS; i++)
+				alloc->dealloc(allocs[i]);
+
+			// Frees the blocks allocated during the frame, and merges them into one
+			alloc->clear();
+		}
+
+		alloc->clear();
+
+		// Frees the remaining block
+		bs_delete(alloc);
+
+		// Aligned allocations and frees of the general category, as used by the frame allocator
+		for (UINT32 i = 0; i < NUM_ALLOCS; i++)
+		{
+			void* data = bs_alloc_aligned16(BLOCK_SIZE * (i + 1));
+			BS_TEST_ASSERT(((UINT64)data & 15) == 0);
+
+			bs_free_aligned16(data);
+		}
+	}
+
+	void EditorTestSuite::TestPickingBVH()
+	{
+		static const UINT32 NUM_TRIANGLES = 1000;
+		static const UINT32 NUM_RAYS = 200;
+
+		TestRandom random(12345);
+
+		SPtr<VertexDataDesc> vertexDesc = bs_shared_ptr_new<VertexDataDesc>();
+		vertexDesc->addVertElem(VET_FLOAT3, VES_POSITION);
+
+		SPtr<MeshData> meshData = bs_shared_ptr_new<MeshData>(NUM_TRIANGLES * 3, NUM_TRIANGLES * 3, vertexDesc);
+		Vector<Vector3> triangles(NUM_TRIANGLES * 3);
+
+		auto positionIter = meshData->getVec3DataIter(VES_POSITION);
+		UINT32* indices = meshData->getIndices32();
+		for (UINT32 i = 0; i < NUM_TRIANGLES; i++)
+		{
+			Vector3 center(random.range(-50.0f, 50.0f), random.range(-50.0f, 50.0f), random.range(-50.0f, 50.0f));
+			for (UINT32 j = 0; j < 3; j++)
+			{
+				Vector3 vertex = center + 
+					Vector3(random.range(-2.0f, 2.0f), random.range(-2.0f, 2.0f), random.range(-2.0f, 2.0f));
+
+				triangles[i * 3 + j] = vertex;
+				positionIter.addValue(vertex);
+				indices[i * 3 + j] = i * 3 + j;
+			}
+		}
+
+		MeshPickingData pickingData(meshData, { SubMesh(0, NUM_TRIANGLES * 3, DOT_TRIANGLE_LIST) });
+		pickingData.build();
+
+		BS_TEST_ASSERT(pickingData.getNumTriangles() == NUM_TRIANGLES);
+
+		// Ray queries must find the same nearest triangle as testing all of them
+		UINT32 numHits = 0;
+		for (UINT32 i = 0; i < NUM_RAYS; i++)
+		{
+			Vector3 origin(random.range(-60.0f, 60.0f), random.range(-60.0f, 60.0f), -100.0f);
+			Vector3 target(random.range(-50.0f, 50.0f), random.range(-50.0f, 50.0f), random.range(-50.0f, 50.0f));
+			Ray ray(origin, Vector3::normalize(target - origin));
+
+			bool expectedHit = false;
+			float expectedDistance = std::numeric_limits<float>::max();
+			for (UINT32 j = 0; j < NUM_TRIANGLES; j++)
+			{
+				const Vector3& a = triangles[j * 3 + 0];
+				const Vector3& b = triangles[j * 3 + 1];
+				const Vector3& c = triangles[j * 3 + 2];
+
+				auto result = ray.intersects(a, b, c, (b - a).cross(c - a));
+				if (result.first && result.second < expectedDistance)
+				{
+					expectedHit = true;
+					expectedDistance = result.second;
+				}
+			}
+
+			float distance = 0.0f;
+			bool hit = pickingData.intersects(ray, distance);
+
+			BS_TEST_ASSERT(hit == expectedHit);
+			if (hit && expectedHit)
+			{
+				BS_TEST_ASSERT(Math::abs(distance - expectedDistance) < 0.01f);
+				numHits++;
+			}
+		}
+
+		BS_TEST_ASSERT(numHits > 0);
+
+		// Volume queries, using a box-shaped volume
+		for (UINT32 i = 0; i < NUM_RAYS; i++)
+		{
+			Vector3 min(random.range(-60.0f, 50.0f), random.range(-60.0f, 50.0f), random.range(-60.0f, 50.0f));
+			Vector3 max = min + Vector3(random.range(0.1f, 10.0f), random.range(0.1f, 10.0f), random.range(0.1f, 10.0f));
+
+			Vector<Plane> planes =
+			{
+				Plane(1.0f, 0.0f, 0.0f, min.x), Plane(-1.0f, 0.0f, 0.0f, -max.x),
+				Plane(0.0f, 1.0f, 0.0f, min.y), Plane(0.0f, -1.0f, 0.0f, -max.y),
+				Plane(0.0f, 0.0f, 1.0f, min.z), Plane(0.0f, 0.0f, -1.0f, -max.z)
+			};
+
+			bool expectedHit = false;
+			for (UINT32 j = 0; j < NUM_TRIANGLES && !expectedHit; j++)
+			{
+				bool outside = false;
+				for (auto& plane : planes)
+				{
+					outside = true;
+					for (UINT32 k = 0; k < 3; k++)
+						outside &= triangles[j * 3 + k].dot(plane.normal) < plane.d;
+
+					if (outside)
+						break;
+				}
+
+				expectedHit = !outside;
+			}
+
+			BS_TEST_ASSERT(pickingData.intersects(ConvexVolume(planes)) == expectedHit);
+		}
+
+		// Culling, using a single triangle that appears counter-clockwise when viewed from positive Z
+		SPtr<MeshData> triangleData = bs_shared_ptr_new<MeshData>(3, 3, vertexDesc);
+
+		auto trianglePositionIter = triangleData->getVec3DataIter(VES_POSITION);
+		trianglePositionIter.addValue(Vector3(-1.0f, -1.0f, 0.0f));
+		trianglePositionIter.addValue(Vector3(1.0f, -1.0f, 0.0f));
+		trianglePositionIter.addValue(Vector3(0.0f, 1.0f, 0.0f));
+
+		UINT32* triangleIndices = triangleData->getIndices32();
+		for (UINT32 i = 0; i < 3; i++)
+			triangleIndices[i] = i;
+
+		MeshPickingData trianglePickingData(triangleData, { SubMesh(0, 3, DOT_TRIANGLE_LIST) });
+		trianglePickingData.build();
+
+		Ray frontRay(Vector3(0.0f, 0.0f, 10.0f), -Vector3::UNIT_Z);
+		Ray backRay(Vector3(0.0f, 0.0f, -10.0f), Vector3::UNIT_Z);
+
+		Vector<CullingMode> noCull = { CULL_NONE };
+		Vector<CullingMode> cullCW = { CULL_CLOCKWISE };
+		Vector<CullingMode> cullCCW = { CULL_COUNTERCLOCKWISE };
+
+		float distance = 0.0f;
+		BS_TEST_ASSERT(trianglePickingData.intersects(frontRay, noCull, distance));
+		BS_TEST_ASSERT(trianglePickingData.intersects(backRay, noCull, distance));
+		BS_TEST_ASSERT(trianglePickingData.intersects(frontRay, cullCW, distance));
+		BS_TEST_ASSERT(!trianglePickingData.intersects(backRay, cullCW, distance));
+		BS_TEST_ASSERT(!trianglePickingData.intersects(frontRay, cullCCW, distance));
+		BS_TEST_ASSERT(trianglePickingData.intersects(backRay, cullCCW, distance));
+
+		Vector<Plane> boxPlanes =
+		{
+			Plane(1.0f, 0.0f, 0.0f, -0.5f), Plane(-1.0f, 0.0f, 0.0f, -0.5f),
+			Plane(0.0f, 1.0f, 0.0f, -0.5f), Plane(0.0f, -1.0f, 0.0f, -0.5f),
+			Plane(0.0f, 0.0f, 1.0f, -0.5f), Plane(0.0f, 0.0f, -1.0f, -0.5f)
+		};
+
+		ConvexVolume box(boxPlanes);
+		Vector4 frontPerspective(0.0f, 0.0f, 10.0f, 1.0f);
+		Vector4 backOrthographic(0.0f, 0.0f, -1.0f, 0.0f);
+
+		BS_TEST_ASSERT(trianglePickingData.intersects(box, noCull, backOrthographic));
+		BS_TEST_ASSERT(trianglePickingData.intersects(box, cullCW, frontPerspective));
+		BS_TEST_ASSERT(!trianglePickingData.intersects(box, cullCW, backOrthographic));
+		BS_TEST_ASSERT(!trianglePickingData.intersects(box, cullCCW, frontPerspective));
+		BS_TEST_ASSERT(trianglePickingData.intersects(box, cullCCW, backOrthographic));
+	}
+
+	void EditorTestSuite::TestBatchMath()
+	{
+		// Not a multiple of the SIMD width, so the remainder path is tested as well
+		static const UINT32 COUNT = 39;
+
+		TestRandom random(54321);
+
+		auto randomVector = [&](float min, float max)
+		{
+			return Vector3(random.range(min, max), random.range(min, max), random.range(min, max));
+		};
+
+		auto equals = [](const Matrix4& a, const Matrix4& b)
+		{
+			for (UINT32 row = 0; row < 4; row++)
+			{
+				for (UINT32 col = 0; col < 4; col++)
+				{
+					if (!Math::approxEquals(a[row][col], b[row][col], 0.001f))
+						return false;
+				}
+			}
+
+			return true;
+		};
+
+		Vector<Vector3> translations(COUNT);
+		Vector<Quaternion> rotations(COUNT);
+		Vector<Vector3> scales(COUNT);
+		Vector<Matrix4> matrices(COUNT);
+		Vector<Matrix4> otherMatrices(COUNT);
+		Vector<Vector3> points(COUNT);
+		Vector<AABox> boxes(COUNT);
+		for (UINT32 i = 0; i < COUNT; i++)
+		{
+			translations[i] = randomVector(-100.0f, 100.0f);
+			rotations[i] = Quaternion(random.range(-1.0f, 1.0f), random.range(-1.0f, 1.0f), random.range(-1.0f, 1.0f), 
+				random.range(-1.0f, 1.0f));
+			rotations[i].normalize();
+			scales[i] = randomVector(0.1f, 5.0f);
+
+			matrices[i] = Matrix4::TRS(translations[i], rotations[i], scales[i]);
+
+			Quaternion otherRotation(random.range(-1.0f, 1.0f), random.range(-1.0f, 1.0f), random.range(-1.0f, 1.0f), 
+				random.range(-1.0f, 1.0f));
+			otherRotation.normalize();
+			otherMatrices[i] = Matrix4::TRS(randomVector(-100.0f, 100.0f), otherRotation, randomVector(0.1f, 5.0f));
+
+			points[i] = randomVector(-100.0f, 100.0f);
+
+			Vector3 min = randomVector(-10.0f, 10.0f);
+			boxes[i] = AABox(min, min + randomVector(0.0f, 10.0f));
+		}
+
+		// Every batch operation must match its per-object equivalent
+		Vector<Matrix4> outMatrices(COUNT);
+		BatchMath::TRS(translations.data(), rotations.data(), scales.data(), outMatrices.data(), COUNT);
+		for (UINT32 i = 0; i < COUNT; i++)
+			BS_TEST_ASSERT(equals(outMatrices[i], matrices[i]));
+
+		BatchMath::inverseAffine(matrices.data(), outMatrices.data(), COUNT);
+		for (UINT32 i = 0; i < COUNT; i++)
+			BS_TEST_ASSERT(equals(outMatrices[i], matrices[i].inverseAffine()));
+
+		BatchMath::multiplyAffine(matrices.data(), otherMatrices.data(), outMatrices.data(), COUNT);
+		for (UINT32 i = 0; i < COUNT; i++)
+			BS_TEST_ASSERT(equals(outMatrices[i], matrices[i].concatenateAffine(otherMatrices[i])));
+
+		Vector<Vector3> outPoints(COUNT);
+		BatchMath::transformPoints(matrices[0], points.data(), outPoints.data(), COUNT);
+		for (UINT32 i = 0; i < COUNT; i++)
+			BS_TEST_ASSERT(Math::approxEquals(outPoints[i], matrices[0].multiplyAffine(points[i]), 0.001f));
+
+		Vector<AABox> outBoxes(COUNT);
+		BatchMath::transformAffine(matrices.data(), boxes.data(), outBoxes.data(), COUNT);
+		for (UINT32 i = 0; i < COUNT; i++)
+		{
+			AABox expected = boxes[i];
+			expected.transformAffine(matrices[i]);
+
+			BS_TEST_ASSERT(Math::approxEquals(outBoxes[i].getMin(), expected.getMin(), 0.001f));
+			BS_TEST_ASSERT(Math::approxEquals(outBoxes[i].getMax(), expected.getMax(), 0.001f));
+		}
+
+		// Input and output may be the same array
+		outMatrices = matrices;
+		BatchMath::inverseAffine(outMatrices.data(), outMatrices.data(), COUNT);
+		for (UINT32 i = 0; i < COUNT; i++)
+			BS_TEST_ASSERT(equals(outMatrices[i], matrices[i].inverseAffine()));
+	}
+
+	void EditorTestSuite::TestPixelConversion()
+	{
+		// Width not a multiple of the SIMD width, so the remainder path is tested as well
+		static const UINT32 WIDTH = 37;
+		static const UINT32 HEIGHT = 5;
+
+		static const PixelFormat FORMATS[] = 
+		{ 
+			PF_R8, PF_R8G8, PF_R8G8B8, PF_B8G8R8, PF_A8R8G8B8, PF_A8B8G8R8, PF_B8G8R8A8, PF_R8G8B8A8, PF_FLOAT32_RGBA, 
+			PF_FLOAT16_RGBA 
+		};
+
+		TestRandom random(12345);
+
+		// Specialized converters must output exactly the same values as converting pixel by pixel
+		for (auto srcFormat : FORMATS)
+		{
+			PixelData src(WIDTH, HEIGHT, 1, srcFormat);
+			src.allocateInternalBuffer();
+
+			UINT32 srcPixelSize = PixelUtil::getNumElemBytes(srcFormat);
+			UINT8* srcData = src.getData();
+			for (UINT32 i = 0; i < WIDTH * HEIGHT; i++)
+			{
+				if (srcFormat == PF_FLOAT32_RGBA)
+				{
+					// Includes values out of [0, 1] range, to test clamping
+					float* values = (float*)(srcData + i * srcPixelSize);
+					for (UINT32 j = 0; j < 4; j++)
+						values[j] = (random.next() % 2000) / 1000.0f - 0.5f;
+				}
+				else
+				{
+					for (UINT32 j = 0; j < srcPixelSize; j++)
+						srcData[i * srcPixelSize + j] = (UINT8)random.next();
+				}
+			}
+
+			for (auto dstFormat : FORMATS)
+			{
+				PixelData dst(WIDTH, HEIGHT, 1, dstFormat);
+				dst.allocateInternalBuffer();
+
+				PixelUtil::bulkPixelConversion(src, dst);
+
+				UINT32 dstPixelSize = PixelUtil::getNumElemBytes(dstFormat);
+				UINT8 expected[16];
+				for (UINT32 i = 0; i < WIDTH * HEIGHT; i++)
+				{
+					float r, g, b, a;
+					PixelUtil::unpackColor(&r, &g, &b, &a, srcFormat, srcData + i * srcPixelSize);
+					PixelUtil::packColor(r, g, b, a, dstFormat, expected);
+
+					BS_TEST_ASSERT(memcmp(dst.getData() + i * dstPixelSize, expected, dstPixelSize) == 0);
+				}
+			}
+		}
+
+		// Color space conversions must match their per-value equivalents
+		PixelData srgb(WIDTH, HEIGHT, 1, PF_R8G8B8A8);
+		srgb.allocateInternalBuffer();
+		for (UINT32 i = 0; i < WIDTH * HEIGHT * 4; i++)
+			srgb.getData()[i] = (UINT8)i;
+
+		PixelData linear(WIDTH, HEIGHT, 1, PF_FLOAT32_RGBA);
+		linear.allocateInternalBuffer();
+		PixelUtil::bulkPixelConversion(srgb, linear);
+
+		PixelUtil::SRGBToLinear(srgb);
+		PixelUtil::SRGBToLinear(linear);
+
+		PixelData expected(WIDTH, HEIGHT, 1, PF_R8G8B8A8);
+		expected.allocateInternalBuffer();
+		PixelUtil::bulkPixelConversion(linear, expected);
+
+		BS_TEST_ASSERT(memcmp(srgb.getData(), expected.getData(), WIDTH * HEIGHT * 4) == 0);
+	}
+
+	void EditorTestSuite::TestMipmapGeneration()
+	{
+		// Box filtered levels must be averages of the pixels in the level above
+		PixelData source(4, 4, 1, PF_FLOAT32_RGBA);
+		source.allocateInternalBuffer();
+
+		float* sourceData = (float*)source.getData();
+		for (UINT32 i = 0; i < 4 * 4 * 4; i++)
+			sourceData[i] = (float)i;
+
+		Vector<SPtr<PixelData>> mips = PixelUtil::genMipmaps(source, MipMapGenOptions());
+		BS_TEST_ASSERT(mips.size() == 3);
+
+		for (UINT32 i = 1; i < (UINT32)mips.size(); i++)
+		{
+			const PixelData& parent = *mips[i - 1];
+			const PixelData& mip = *mips[i];
+
+			BS_TEST_ASSERT(mip.getWidth() == parent.getWidth() / 2 && mip.getHeight() == parent.getHeight() / 2);
+
+			const float* parentData = (const float*)parent.getData();
+			const float* mipData = (const float*)mip.getData();
+			for (UINT32 y = 0; y < mip.getHeight(); y++)
+			{
+				for (UINT32 x = 0; x < mip.getWidth(); x++)
+				{
+					for (UINT32 channel = 0; channel < 4; channel++)
+					{
+						auto getParent = [&](UINT32 parentX, UINT32 parentY)
+						{
+							return parentData[(parentY * parent.getWidth() + parentX) * 4 + channel];
+						};
+
+						float expected = (getParent(x * 2, y * 2) + getParent(x * 2 + 1, y * 2) + 
+							getParent(x * 2, y * 2 + 1) + getParent(x * 2 + 1, y * 2 + 1)) * 0.25f;
+
+						float actual = mipData[(y * mip.getWidth() + x) * 4 + channel];
+						BS_TEST_ASSERT(Math::approxEquals(actual, expected, 0.001f));
+					}
+				}
+			}
+		}
+
+		// Filtering a single color must output the same color, for any filter, wrap mode and image size
+		static const MipMapFilter FILTERS[] = { MipMapFilter::Box, MipMapFilter::Triangle, MipMapFilter::Kaiser };
+		static const MipMapWrapMode WRAP_MODES[] = { MipMapWrapMode::Clamp, MipMapWrapMode::Mirror, MipMapWrapMode::Repeat };
+
+		PixelData colorSource(37, 13, 1, PF_FLOAT32_RGBA);
+		colorSource.allocateInternalBuffer();
+
+		float* colorSourceData = (float*)colorSource.getData();
+		for (UINT32 i = 0; i < 37 * 13; i++)
+		{
+			colorSourceData[i * 4 + 0] = 0.25f;
+			colorSourceData[i * 4 + 1] = 0.5f;
+			colorSourceData[i * 4 + 2] = 0.75f;
+			colorSourceData[i * 4 + 3] = 1.0f;
+		}
+
+		for (auto filter : FILTERS)
+		{
+			for (auto wrapMode : WRAP_MODES)
+			{
+				MipMapGenOptions options;
+				options.filter = filter;
+				options.wrapMode = wrapMode;
+
+				mips = PixelUtil::genMipmaps(colorSource, options);
+				BS_TEST_ASSERT(mips.size() == 6);
+				BS_TEST_ASSERT(mips.back()->getWidth() == 1 && mips.back()->getHeight() == 1);
+
+				for (auto& mip : mips)
+				{
+					const float* mipData = (const float*)mip->getData();
+					for (UINT32 i = 0; i < mip->getWidth() * mip->getHeight() * 4; i++)
+						BS_TEST_ASSERT(Math::approxEquals(mipData[i], colorSourceData[i % 4], 0.001f));
+				}
+			}
+		}
+	}
+
+	void EditorTestSuite::TestAnimationClip()
+	{
+		auto createCurve = [](UINT32 numKeys, float length, float offset, float amplitude)
+		{
+			Vector<Keyframe> keyframes(numKeys);
+			for (UINT32 i = 0; i < numKeys; i++)
+			{
+				float time = length * i / (float)(numKeys - 1);
+
+				keyframes[i].time = time;
+				keyframes[i].value = offset + amplitude * std::sin(time * 5.0f);
+				keyframes[i].inTangent = amplitude * 5.0f * std::cos(time * 5.0f);
+				keyframes[i].outTangent = keyframes[i].inTangent;
+			}
+
+			return AnimationCurve(keyframes);
+		};
+
+		// First bone has all curves animated with different key counts, second bone has no animation at all
+		Vector<BoneAnimationCurves> bones(2);
+		bones[0].name = "Animated";
+		bones[1].name = "Static";
+
+		for (UINT32 i = 0; i < 3; i++)
+		{
+			bones[0].position[i] = createCurve(5 + i * 7, 2.0f, (float)i, 3.0f);
+			bones[0].scale[i] = createCurve(2 + i, 2.0f, 1.0f, 0.5f);
+		}
+
+		for (UINT32 i = 0; i < 4; i++)
+			bones[0].rotation[i] = createCurve(9, 2.0f, 0.5f, 0.25f);
+
+		SPtr<AnimationClip> clip = AnimationClip::_createPtr(bones);
+		BS_TEST_ASSERT(clip->getNumBones() == 2);
+		BS_TEST_ASSERT(clip->getBoneName(1) == "Static");
+		BS_TEST_ASSERT(Math::approxEquals(clip->getLength(), 2.0f));
+
+		// Compressed evaluation must match the uncompressed curves, for sequential and random evaluation times, in and
+		// out of the clip range
+		static const float TIMES[] = { 0.0f, 0.1f, 0.2f, 0.25f, 0.9f, 1.99f, 2.0f, 2.5f, 0.5f, -0.3f, -5.1f, 0.7f };
+
+		AnimationClipState state;
+		state.clip = clip;
+
+		for (auto loop : { true, false })
+		{
+			for (auto time : TIMES)
+			{
+				state.time = time;
+				state.loop = loop;
+				AnimationClip::evaluate(state);
+
+				BS_TEST_ASSERT(state.bones.size() == 2);
+
+				const BoneTransform& animated = state.bones[0];
+				for (UINT32 i = 0; i < 3; i++)
+				{
+					BS_TEST_ASSERT(Math::approxEquals(animated.position[i], bones[0].position[i].evaluate(time, loop), 0.001f));
+					BS_TEST_ASSERT(Math::approxEquals(animated.scale[i], bones[0].scale[i].evaluate(time, loop), 0.001f));
+				}
+
+				Quaternion rotation;
+				for (UINT32 i = 0; i < 4; i++)
+					rotation[i] = bones[0].rotation[i].evaluate(time, loop);
+
+				rotation.normalize();
+				for (UINT32 i = 0; i < 4; i++)
+					BS_TEST_ASSERT(Math::approxEquals(animated.rotation[i], rotation[i], 0.001f));
+
+				const BoneTransform& unanimated = state.bones[1];
+				BS_TEST_ASSERT(unanimated.position == Vector3::ZERO);
+				BS_TEST_ASSERT(unanimated.rotation == Quaternion::IDENTITY);
+				BS_TEST_ASSERT(unanimated.scale == Vector3::ONE);
+			}
+		}
+
+		// Batch evaluation must match evaluating each state individually
+		Vector<AnimationClipState> states(20);
+		for (UINT32 i = 0; i < (UINT32)states.size(); i++)
+		{
+			states[i].clip = clip;
+			states[i].time = i * 0.13f;
+		}
+
+		AnimationClip::evaluate(states.data(), (UINT32)states.size());
+
+		for (auto& entry : states)
+		{
+			state.time = entry.time;
+			state.loop = entry.loop;
+			AnimationClip::evaluate(state);
+
+			BS_TEST_ASSERT(entry.bones.size() == state.bones.size());
+			for (UINT32 i = 0; i < (UINT32)entry.bones.size(); i++)
+			{
+				BS_TEST_ASSERT(entry.bones[i].position == state.bones[i].position);
+				BS_TEST_ASSERT(entry.bones[i].rotation == state.bones[i].rotation);
+				BS_TEST_ASSERT(entry.bones[i].scale == state.bones[i].scale);
+			}
+		}
+	}
+
+	void EditorTestSuite::TestSkinning()
+	{
+		// Two bone chain, with the child bone one unit above the root
+		Vector<SkeletonBone> skeletonBones(2);
+		skeletonBones[0] = { "Root", -1, Matrix4::IDENTITY };
+		skeletonBones[1] = { "Child", 0, Matrix4::translation(Vector3(0.0f, -1.0f, 0.0f)) };
+
+		SPtr<Skeleton> skeleton = Skeleton::create(skeletonBones);
+		BS_TEST_ASSERT(skeleton->getLocalBindPose(1) == Matrix4::translation(Vector3(0.0f, 1.0f, 0.0f)));
+
+		// Vertices fully influenced by the root, by the child, and by both
+		static const UINT32 NUM_VERTICES = 3;
+		Vector3 positions[NUM_VERTICES] = { Vector3(1.0f, 0.0f, 0.0f), Vector3(1.0f, 1.0f, 0.0f), Vector3(1.0f, 1.0f, 0.0f) };
+		Vector3 normals[NUM_VERTICES] = { Vector3::UNIT_X, Vector3::UNIT_X, Vector3::UNIT_Y };
+		BoneWeight weights[NUM_VERTICES] = 
+		{
+			{ 0, 0, 0, 0, 1.0f, 0.0f, 0.0f, 0.0f },
+			{ 1, 0, 0, 0, 1.0f, 0.0f, 0.0f, 0.0f },
+			{ 0, 1, 0, 0, 0.5f, 0.5f, 0.0f, 0.0f }
+		};
+		UINT32 indices[NUM_VERTICES] = { 0, 1, 2 };
+
+		VertexLayout layout = (VertexLayout)((INT32)VertexLayout::Position | (INT32)VertexLayout::Normal | 
+			(INT32)VertexLayout::BoneWeights);
+
+		SPtr<RendererMeshData> meshData = RendererMeshData::create(NUM_VERTICES, NUM_VERTICES, layout);
+		meshData->setPositions(positions, sizeof(positions));
+		meshData->setNormals(normals, sizeof(normals));
+		meshData->setBoneWeights(weights, sizeof(weights));
+		meshData->setIndices(indices, sizeof(indices));
+
+		BoneWeight readWeights[NUM_VERTICES];
+		meshData->getBoneWeights(readWeights, sizeof(readWeights));
+		BS_TEST_ASSERT(readWeights[2].index1 == 1 && readWeights[2].weight1 == 0.5f);
+
+		// Blend shape moving the first vertex forward
+		Vector<BlendShape> blendShapes(1);
+		blendShapes[0].name = "Forward";
+		blendShapes[0].vertices.push_back({ 0, Vector3(0.0f, 0.0f, 1.0f), Vector3::ZERO });
+
+		Vector<SubMesh> subMeshes = { SubMesh(0, NUM_VERTICES, DOT_TRIANGLE_LIST) };
+		SPtr<SkinnedMesh> skinnedMesh = SkinnedMesh::create(meshData->getData(), subMeshes, skeleton, blendShapes);
+
+		// Clip rotates the child bone by 90 degrees around Z and leaves the root bone in its bind pose
+		auto constantCurve = [](float value) { return AnimationCurve({ { value, 0.0f, 0.0f, 0.0f } }); };
+		Quaternion rotation(Vector3::UNIT_Z, Degree(90.0f));
+
+		Vector<BoneAnimationCurves> clipBones(1);
+		clipBones[0].name = "Child";
+		for (UINT32 i = 0; i < 3; i++)
+		{
+			clipBones[0].position[i] = constantCurve(i == 1 ? 1.0f : 0.0f);
+			clipBones[0].scale[i] = constantCurve(1.0f);
+		}
+
+		for (UINT32 i = 0; i < 4; i++)
+			clipBones[0].rotation[i] = constantCurve(rotation[i]);
+
+		AnimationClipState state;
+		state.clip = AnimationClip::_createPtr(clipBones);
+		AnimationClip::evaluate(state);
+
+		skinnedMesh->setPose(state);
+		skinnedMesh->setBlendShapeWeight(0, 0.5f);
+		skinnedMesh->update();
+
+		// Palette must match the bone's model space transform, applied to a vertex in bone space
+		const Vector<Matrix4>& palette = skinnedMesh->getBonePalette();
+		Matrix4 expectedPalette = Matrix4::TRS(Vector3(0.0f, 1.0f, 0.0f), rotation, Vector3::ONE) * 
+			skeletonBones[1].invBindPose;
+
+		BS_TEST_ASSERT(palette[0] == Matrix4::IDENTITY);
+		for (UINT32 i = 0; i < 4; i++)
+		{
+			for (UINT32 j = 0; j < 4; j++)
+				BS_TEST_ASSERT(Math::approxEquals(palette[1][i][j], expectedPalette[i][j], 0.0001f));
+		}
+
+		static const Vector3 EXPECTED_POSITIONS[NUM_VERTICES] = 
+			{ Vector3(1.0f, 0.0f, 0.5f), Vector3(0.0f, 2.0f, 0.0f), Vector3(0.5f, 1.5f, 0.0f) };
+
+		SPtr<MeshData> deformedData = skinnedMesh->getDeformedData();
+		BS_TEST_ASSERT(deformedData != nullptr);
+
+		auto positionIter = deformedData->getVec3DataIter(VES_POSITION);
+		auto normalIter = deformedData->getVec3DataIter(VES_NORMAL);
+		for (UINT32 i = 0; i < NUM_VERTICES; i++)
+		{
+			const Vector3& position = positionIter.getValue();
+			BS_TEST_ASSERT(Math::approxEquals(position.x, EXPECTED_POSITIONS[i].x, 0.0001f));
+			BS_TEST_ASSERT(Math::approxEquals(position.y, EXPECTED_POSITIONS[i].y, 0.0001f));
+			BS_TEST_ASSERT(Math::approxEquals(position.z, EXPECTED_POSITIONS[i].z, 0.0001f));
+
+			Vector3 expectedNormal = Vector3::ZERO;
+			expectedNormal += palette[weights[i].index0].multiplyDirection(normals[i]) * weights[i].weight0;
+			expectedNormal += palette[weights[i].index1].multiplyDirection(normals[i]) * weights[i].weight1;
+			expectedNormal.normalize();
+
+			const Vector3& normal = normalIter.getValue();
+			BS_TEST_ASSERT(Math::approxEquals(normal.x, expectedNormal.x, 0.0001f));
+			BS_TEST_ASSERT(Math::approxEquals(normal.y, expectedNormal.y, 0.0001f));
+			BS_TEST_ASSERT(Math::approxEquals(normal.z, expectedNormal.z, 0.0001f));
+
+			positionIter.moveNext();
+			normalIter.moveNext();
+		}
+	}
+
+	void EditorTestSuite::TestGUIElementGrid()
+	{
+		auto setBounds = [](GUIElement* element, const Rect2I& bounds)
+		{
+			GUILayoutData layoutData;
+			layoutData.area = bounds;
+			layoutData.clipRect = bounds;
+
+			element->_setLayoutData(layoutData);
+		};
+
+		auto contains = [](const Vector<GUIElement*>& elements, GUIElement* element)
+		{
+			return std::find(elements.begin(), elements.end(), element) != elements.end();
+		};
+
+		// Small element, element too large to be stored in cells, element at negative coordinates and a hidden element
+		GUILabel* small = GUILabel::create(HString(L"Small"));
+		GUILabel* large = GUILabel::create(HString(L"Large"));
+		GUILabel* negative = GUILabel::create(HString(L"Negative"));
+		GUILabel* hidden = GUILabel::create(HString(L"Hidden"));
+
+		setBounds(small, Rect2I(10, 10, 20, 20));
+		setBounds(large, Rect2I(0, 0, 2000, 2000));
+		setBounds(negative, Rect2I(-100, -100, 50, 50));
+		setBounds(hidden, Rect2I(10, 10, 20, 20));
+		hidden->setVisible(false);
+
+		GUIElementGrid grid;
+		grid.markDirty(small);
+		grid.markDirty(large);
+		grid.markDirty(negative);
+		grid.markDirty(hidden);
+
+		Vector<GUIElement*> found;
+		grid.find(Vector2I(15, 15), found);
+		BS_TEST_ASSERT(found.size() == 2 && contains(found, small) && contains(found, large));
+
+		found.clear();
+		grid.find(Vector2I(-60, -60), found);
+		BS_TEST_ASSERT(found.size() == 1 && contains(found, negative));
+
+		found.clear();
+		grid.find(Vector2I(-40, -40), found);
+		BS_TEST_ASSERT(found.empty());
+
+		// Elements must be found at their new position once their bounds change
+		setBounds(small, Rect2I(500, 500, 100, 10));
+		grid.markDirty(small);
+
+		found.clear();
+		grid.find(Vector2I(15, 15), found);
+		BS_TEST_ASSERT(found.size() == 1 && contains(found, large));
+
+		found.clear();
+		grid.find(Vector2I(590, 505), found);
+		BS_TEST_ASSERT(found.size() == 2 && contains(found, small) && contains(found, large));
+
+		grid.remove(small);
+
+		found.clear();
+		grid.find(Vector2I(590, 505), found);
+		BS_TEST_ASSERT(found.size() == 1 && contains(found, large));
+
+		// Results must match testing every element individually
+		Vector<GUILabel*> labels = { small, large, negative, hidden };
+		for (UINT32 i = 0; i < 200; i++)
+		{
+			GUILabel* label = GUILabel::create(HString(L"Row"));
+			setBounds(label, Rect2I(-300 + (i % 7) * 90, -300 + i * 15, 80 + (i % 3) * 40, 15));
+
+			grid.markDirty(label);
+			labels.push_back(label);
+		}
+
+		grid.markDirty(small);
+		for (INT32 y = -350; y < 3000; y += 37)
+		{
+			for (INT32 x = -350; x < 700; x += 23)
+			{
+				Vector2I position(x, y);
+
+				found.clear();
+				grid.find(position, found);
+
+				UINT32 numExpected = 0;
+				for (auto& label : labels)
+				{
+					if (label->_isVisible() && label->_isInBounds(position))
+					{
+						BS_TEST_ASSERT(contains(found, label));
+						numExpected++;
+					}
+				}
+
+				BS_TEST_ASSERT(found.size() == numExpected);
+			}
+		}
+
+		grid.clear();
+		for (auto& label : labels)
+			GUIElement::destroy(label);
+	}
+
+	void EditorTestSuite::TestGUILayoutCache()
+	{
+		static const UINT32 NUM_ROWS = 100;
+		static const UINT32 ROW_HEIGHT = 20;
+		static const UINT32 HEADER_HEIGHT = 10;
+
+		// Rows of a scroll area-like layout, where each row has a child that is only positioned if the row is visible
+		GUILayoutY* content = GUILayoutY::create();
+		Vector<GUILayoutY*> rows(NUM_ROWS);
+		Vector<GUIFixedSpace*> rowSpaces(NUM_ROWS);
+		Vector<GUILayoutY*> rowContents(NUM_ROWS);
+
+		for (UINT32 i = 0; i < NUM_ROWS; i++)
+		{
+			rows[i] = content->addNewElement<GUILayoutY>();
+			rowSpaces[i] = rows[i]->addNewElement<GUIFixedSpace>(HEADER_HEIGHT);
+			rowContents[i] = rows[i]->addNewElement<GUILayoutY>();
+			rowContents[i]->addNewElement<GUIFixedSpace>(ROW_HEIGHT - HEADER_HEIGHT);
+		}
+
+		auto updateLayout = [&](INT32 scrollOffset)
+		{
+			GUILayoutData layoutData;
+			layoutData.area = Rect2I(0, -scrollOffset, 100, NUM_ROWS * ROW_HEIGHT);
+			layoutData.clipRect = Rect2I(0, 0, 100, 5 * ROW_HEIGHT);
+
+			content->_setLayoutData(layoutData);
+			content->_updateLayout(layoutData);
+		};
+
+		updateLayout(0);
+		BS_TEST_ASSERT(content->_getOptimalSize().y == NUM_ROWS * ROW_HEIGHT);
+
+		// Only rows in the visible area have their children positioned
+		BS_TEST_ASSERT(!rows[0]->_isLayoutDeferred());
+		BS_TEST_ASSERT(!rows[4]->_isLayoutDeferred());
+		BS_TEST_ASSERT(rows[5]->_isLayoutDeferred());
+		BS_TEST_ASSERT(rows[50]->_isLayoutDeferred());
+		BS_TEST_ASSERT(rowContents[2]->_getLayoutData().area.y == 2 * ROW_HEIGHT + HEADER_HEIGHT);
+		BS_TEST_ASSERT(rows[50]->_getLayoutData().area.y == 50 * ROW_HEIGHT);
+
+		// Requesting bounds of a child of a deferred row resolves its layout
+		BS_TEST_ASSERT(rowContents[50]->getGlobalBounds().y == 50 * ROW_HEIGHT + HEADER_HEIGHT);
+		BS_TEST_ASSERT(!rows[50]->_isLayoutDeferred());
+		BS_TEST_ASSERT(rowContents[50]->_getLayoutData().clipRect.height == 0);
+
+		// Scroll so rows in the middle become visible
+		updateLayout(60 * ROW_HEIGHT);
+		BS_TEST_ASSERT(!rows[62]->_isLayoutDeferred());
+		BS_TEST_ASSERT(rowContents[62]->_getLayoutData().area.y == 2 * ROW_HEIGHT + HEADER_HEIGHT);
+		BS_TEST_ASSERT(rowContents[62]->_getLayoutData().clipRect.height > 0);
+
+		// Rows that just went out of view are clipped normally, and deferred only on the next update
+		BS_TEST_ASSERT(!rows[0]->_isLayoutDeferred());
+		BS_TEST_ASSERT(rowContents[0]->_getLayoutData().clipRect.height == 0);
+
+		updateLayout(60 * ROW_HEIGHT);
+		BS_TEST_ASSERT(rows[0]->_isLayoutDeferred());
+		BS_TEST_ASSERT(rowContents[0]->getGlobalBounds().y == -60 * (INT32)ROW_HEIGHT + (INT32)HEADER_HEIGHT);
+
+		// Changing a single element invalidates the cached size ranges of its parents only
+		rowSpaces[10]->setSize(HEADER_HEIGHT + ROW_HEIGHT);
+		updateLayout(0);
+		BS_TEST_ASSERT(content->_getOptimalSize().y == NUM_ROWS * ROW_HEIGHT + ROW_HEIGHT);
+		BS_TEST_ASSERT(rows[10]->_getOptimalSize().y == ROW_HEIGHT * 2);
+		BS_TEST_ASSERT(rows[11]->_getLayoutData().area.y == 12 * ROW_HEIGHT);
+
+		// Elements removed from a layout no longer contribute to its size
+		GUILayout::destroy(rows[99]);
+		updateLayout(0);
+		BS_TEST_ASSERT(content->_getOptimalSize().y == NUM_ROWS * ROW_HEIGHT);
+
+		GUILayout::destroy(content);
+	}
+
+	void EditorTestSuite::TestGUITreeViewVirtualization()
+	{
+		static const UINT32 NUM_ELEMENTS = 10000;
+		static const UINT32 VISIBLE_HEIGHT = 200;
+
+		TestTreeView* treeView = new (bs_alloc<TestTreeView>()) TestTreeView(NUM_ELEMENTS);
+
+		INT32 totalHeight = treeView->_getOptimalSize().y;
+		INT32 elementHeight = totalHeight / NUM_ELEMENTS;
+		BS_TEST_ASSERT(elementHeight > 0);
+
+		// Size of the tree view is known without measuring any elements
+		BS_TEST_ASSERT(!treeView->isElementMeasured(0));
+
+		auto updateLayout = [&](INT32 scrollOffset)
+		{
+			// Tree view is fully expanded within a scroll area, and only a part of it is visible
+			GUILayoutData layoutData;
+			layoutData.area = Rect2I(0, -scrollOffset, 200, totalHeight);
+			layoutData.clipRect = Rect2I(0, 0, 200, VISIBLE_HEIGHT);
+
+			// Parent layouts calculate the size of their children before assigning them their layout data
+			treeView->_updateOptimalLayoutSizes();
+			treeView->_setLayoutData(layoutData);
+			treeView->_updateLayoutInternal(layoutData);
+		};
+
+		// Only elements in (or near) the visible area have GUI elements assigned
+		updateLayout(0);
+
+		UINT32 maxElementsWithGUI = (VISIBLE_HEIGHT + 2 * 100) / elementHeight + 2;
+
+		BS_TEST_ASSERT(treeView->hasElementGUI(0));
+		BS_TEST_ASSERT(!treeView->hasElementGUI(NUM_ELEMENTS / 2));
+		BS_TEST_ASSERT(treeView->getNumElementsWithGUI() <= maxElementsWithGUI);
+
+		// Only elements that were in view are measured
+		BS_TEST_ASSERT(treeView->isElementMeasured(0));
+		BS_TEST_ASSERT(!treeView->isElementMeasured(NUM_ELEMENTS / 2));
+
+		// Elements that came into view were measured during the layout update, after the parent layout requested the
+		// size. Parent widget marks the tree view as clean after the layout update, so the tree view requests another
+		// layout update with its new width on its next update.
+		BS_TEST_ASSERT(treeView->_getOptimalSize().x > 0);
+
+		treeView->_markAsClean();
+		treeView->_update();
+		BS_TEST_ASSERT(treeView->_isDirty());
+
+		// Elements that went out of view have their GUI elements re-assigned to elements that came into view
+		updateLayout((NUM_ELEMENTS / 2) * elementHeight);
+
+		BS_TEST_ASSERT(!treeView->hasElementGUI(0));
+		BS_TEST_ASSERT(treeView->hasElementGUI(NUM_ELEMENTS / 2));
+		BS_TEST_ASSERT(treeView->getNumElementsWithGUI() <= maxElementsWithGUI);
+
+		// Scrolling back and forth doesn't create new GUI elements
+		UINT32 numChildren = treeView->_getNumChildren();
+
+		updateLayout(0);
+		updateLayout((NUM_ELEMENTS - 100) * elementHeight);
+		updateLayout((NUM_ELEMENTS / 2) * elementHeight);
+
+		BS_TEST_ASSERT(treeView->_getNumChildren() == numChildren);
+
+		// Layout doesn't change the size of the tree view
+		BS_TEST_ASSERT(treeView->_getOptimalSize().y == totalHeight);
+
+		GUIElement::destroy(treeView);
+	}
+
+	void EditorTestSuite::TestSmallObjectAlloc()
+	{
+		static const UINT32 NUM_ALLOCS = 10000;
+		typedef MemoryAllocator<SmallObjectTestAlloc> TestAllocator;
+
+		auto findStats = [](const char* name)
+		{
+			for (UINT32 i = 0; i < MemoryCounter::getNumCategories(); i++)
+			{
+				MemoryCategoryStats stats = MemoryCounter::getCategoryStats(i);
+				if (strcmp(stats.name, name) == 0)
+					return stats;
+			}
+
+			return MemoryCategoryStats();
+		};
+
+		MemoryCategoryStats startStats = findStats("TestSmallObject");
+
+		// Allocations of all sizes, including ones too large for the small object allocator
+		Vector<UINT8*> allocs(NUM_ALLOCS);
+		for (UINT32 i = 0; i < NUM_ALLOCS; i++)
+		{
+			UINT32 size = i % (SmallObjectAlloc::MAX_ALLOC_SIZE * 2) + 1;
+
+			allocs[i] = (UINT8*)TestAllocator::allocate(size);
+			BS_TEST_ASSERT(((UINT64)allocs[i] & 15) == 0);
+
+			if (size <= SmallObjectAlloc::MAX_ALLOC_SIZE)
+				BS_TEST_ASSERT(SmallObjectAlloc::getAllocSize(allocs[i]) >= size);
+
+			memset(allocs[i], i & 0xFF, size);
+		}
+
+		MemoryCategoryStats stats = findStats("TestSmallObject");
+		BS_TEST_ASSERT(stats.numAllocs - startStats.numAllocs == NUM_ALLOCS);
+		BS_TEST_ASSERT(stats.liveBytes > startStats.liveBytes);
+
+		// Allocations don't overlap
+		bool isValid = true;
+		for (UINT32 i = 0; i < NUM_ALLOCS; i++)
+		{
+			UINT32 size = i % (SmallObjectAlloc::MAX_ALLOC_SIZE * 2) + 1;
+			for (UINT32 j = 0; j < size; j++)
+				isValid &= allocs[i][j] == (i & 0xFF);
+		}
+
+		BS_TEST_ASSERT(isValid);
+
+		// Free half of the allocations on a different thread
+		Thread thread([&]()
+		{
+			for (UINT32 i = 0; i < NUM_ALLOCS; i += 2)
+				TestAllocator::free(allocs[i]);
+
+			SmallObjectAlloc::endThread();
+			MemoryCounter::endThread();
+		});
+
+		thread.join();
+
+		for (UINT32 i = 1; i < NUM_ALLOCS; i += 2)
+			TestAllocator::free(allocs[i]);
+
+		stats = findStats("TestSmallObject");
+		BS_TEST_ASSERT(stats.numFrees - startStats.numFrees == NUM_ALLOCS);
+		BS_TEST_ASSERT(stats.liveBytes == startStats.liveBytes);
+
+		UINT64 reservedBytes = 0;
+		for (UINT32 i = 0; i < SmallObjectAlloc::getNumSizeClasses(); i++)
+		{
+			SmallObjectAllocStats allocStats = SmallObjectAlloc::getStats(i);
+			BS_TEST_ASSERT(allocStats.getUsedBytes() <= allocStats.getReservedBytes());
+
+			reservedBytes += allocStats.getReservedBytes();
+		}
+
+		BS_TEST_ASSERT(reservedBytes > 0);
+	}
+
+	void EditorTestSuite::TestMemoryTagging()
+	{
+		static const UINT32 NUM_ALLOCS = 1000;
+
+		auto findStats = [](const char* name)
+		{
+			for (UINT32 i = 0; i < MemoryCounter::getNumCategories(); i++)
+			{
+				MemoryCategoryStats stats = MemoryCounter::getCategoryStats(i);
+				if (strcmp(stats.name, name) == 0)
+					return stats;
+			}
+
+			return MemoryCategoryStats();
+		};
+
+		// Category provided as the allocator parameter
+		MemoryCategoryStats startStats = findStats("Textures");
+
+		void* textureData = bs_alloc<TextureAlloc>(1024 * 1024);
+		MemoryCategoryStats stats = findStats("Textures");
+		BS_TEST_ASSERT(stats.liveBytes - startStats.liveBytes >= 1024 * 1024);
+
+		bs_free<TextureAlloc>(textureData);
+		stats = findStats("Textures");
+		BS_TEST_ASSERT(stats.liveBytes == startStats.liveBytes);
+		BS_TEST_ASSERT(stats.peakBytes - startStats.liveBytes >= 1024 * 1024);
+
+		// Category provided by a scoped tag, freed outside of the scope. Counted without allocation tracking.
+		bool wasTrackingEnabled = MemoryCounter::isTrackingEnabled();
+		MemoryCounter::setTrackingEnabled(false);
+
+		startStats = findStats("Serialization");
+
+		Vector<void*> allocs(NUM_ALLOCS);
+		{
+			ScopedMemoryTag memoryTag(getMemoryCategoryIdx<SerializationAlloc>());
+			for (UINT32 i = 0; i < NUM_ALLOCS; i++)
+				allocs[i] = bs_alloc(64);
+		}
+
+		stats = findStats("Serialization");
+		BS_TEST_ASSERT(stats.numAllocs - startStats.numAllocs == NUM_ALLOCS);
+		BS_TEST_ASSERT(stats.liveBytes - startStats.liveBytes >= NUM_ALLOCS * 64);
+
+		for (UINT32 i = 0; i < NUM_ALLOCS; i++)
+			bs_free(allocs[i]);
+
+		stats = findStats("Serialization");
+		BS_TEST_ASSERT(stats.numFrees - startStats.numFrees == NUM_ALLOCS);
+		BS_TEST_ASSERT(stats.liveBytes == startStats.liveBytes);
+
+		// Same as above, with callstack sampling
+		MemoryCounter::setTrackingEnabled(true);
+		MemoryCounter::setCallstackSampleRate(1);
+
+		startStats = findStats("Serialization");
+		{
+			ScopedMemoryTag memoryTag(getMemoryCategoryIdx<SerializationAlloc>());
+			for (UINT32 i = 0; i < NUM_ALLOCS; i++)
+				allocs[i] = bs_alloc(64);
+		}
+
+		stats = findStats("Serialization");
+		BS_TEST_ASSERT(stats.numAllocs - startStats.numAllocs == NUM_ALLOCS);
+		BS_TEST_ASSERT(MemoryCounter::getSampledAllocations(nullptr, 0) >= NUM_ALLOCS);
+
+		MemoryCounter::setCallstackSampleRate(0);
+		MemoryCounter::setTrackingEnabled(wasTrackingEnabled);
+
+		for (UINT32 i = 0; i < NUM_ALLOCS; i++)
+			bs_free(allocs[i]);
+
+		stats = findStats("Serialization");
+		BS_TEST_ASSERT(stats.numFrees - startStats.numFrees == NUM_ALLOCS);
+		BS_TEST_ASSERT(stats.liveBytes == startStats.liveBytes);
+	}
+
+	void EditorTestSuite::TestPipelineStateAfterClear()
+	{
+#if BS_PROFILING_ENABLED
+		SPtr<RenderTexture> renderTexture = RenderTexture::create(TEX_TYPE_2D, 64, 64);
+
+		bool reboundAfterClear = false;
+		bool redundantBindSkipped = false;
+		auto testPipelineState = [&]()
+		{
+			RenderAPICore& rapi = RenderAPICore::instance();
+			RenderStatsData& stats = RenderStats::instance().getData();
+
+			SPtr<PipelineStateCore> pipelineState = PipelineStateCore::create(PIPELINE_STATE_CORE_DESC());
+
+			rapi.setRenderTarget(renderTexture->getCore());
+			rapi.setViewport(Rect2(0.25f, 0.25f, 0.5f, 0.5f));
+			rapi.setPipelineState(pipelineState);
+
+			UINT64 numRedundantBinds = stats.numRedundantPipelineStateBinds;
+			rapi.setPipelineState(pipelineState);
+			redundantBindSkipped = stats.numRedundantPipelineStateBinds == numRedundantBinds + 1;
+
+			// Clearing a partial viewport draws a quad using its own states, so the same pipeline state must be
+			// bound again afterwards
+			rapi.clearViewport(FBT_COLOR | FBT_DEPTH);
+
+			UINT64 numStateChanges = stats.numPipelineStateChanges;
+			rapi.setPipelineState(pipelineState);
+			reboundAfterClear = stats.numPipelineStateChanges == numStateChanges + 1;
+
+			rapi.setViewport(Rect2(0.0f, 0.0f, 1.0f, 1.0f));
+		};
+
+		gCoreThread().queueCommand(testPipelineState, true);
+
+		BS_TEST_ASSERT(redundantBindSkipped);
+		BS_TEST_ASSERT(reboundAfterClear);
+#endif
+	}
+
+	void EditorTestSuite::TestEulerToQuaternionCurves()
+	{
+		auto testConversion = [&](const Vector<Keyframe>(&eulerKeys)[3])
+		{
+			AnimationCurve eulerCurves[3];
+			for (UINT32 i = 0; i < 3; i++)
+				eulerCurves[i] = AnimationCurve(eulerKeys[i]);
+
+			AnimationCurve quatCurves[4];
+			AnimationUtility::eulerToQuaternionCurves(eulerCurves, quatCurves);
+
+			auto evaluateRotation = [&](float time)
+			{
+				Quaternion rotation;
+				for (UINT32 i = 0; i < 4; i++)
+					rotation[i] = quatCurves[i].evaluate(time, false);
+
+				return rotation;
+			};
+
+			// Keys must represent the same rotation as the euler angles, with either sign
+			for (auto& key : eulerKeys[0])
+			{
+				Quaternion expected(
+					Degree(eulerCurves[0].evaluate(key.time, false)),
+					Degree(eulerCurves[1].evaluate(key.time, false)),
+					Degree(eulerCurves[2].evaluate(key.time, false)));
+
+				Quaternion rotation = evaluateRotation(key.time);
+				BS_TEST_ASSERT(Math::approxEquals(std::abs(rotation.dot(expected)), 1.0f, 0.001f));
+			}
+
+			// Curves must not switch between the two equivalent quaternions in-between keys
+			float start = eulerCurves[0].getStart();
+			float length = eulerCurves[0].getLength();
+
+			static const UINT32 NUM_SAMPLES = 40;
+			Quaternion lastRotation = evaluateRotation(start);
+			for (UINT32 i = 1; i <= NUM_SAMPLES; i++)
+			{
+				Quaternion rotation = evaluateRotation(start + length * i / (float)NUM_SAMPLES);
+				BS_TEST_ASSERT(rotation.dot(lastRotation) > 0.0f);
+
+				lastRotation = rotation;
+			}
+		};
+
+		// Rotates more than 360 degrees around a single axis between two keys, requiring the quaternion sign to flip
+		Vector<Keyframe> singleAxisKeys[3] =
+		{
+			{ { 0.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f } },
+			{ { 0.0f, 600.0f, 600.0f, 0.0f }, { 600.0f, 600.0f, 600.0f, 1.0f } },
+			{ { 0.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f } }
+		};
+
+		testConversion(singleAxisKeys);
+
+		// Rotation around multiple axes, with a key in the middle
+		Vector<Keyframe> multiAxisKeys[3] =
+		{
+			{ { 0.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f }, { 30.0f, 0.0f, 0.0f, 2.0f } },
+			{ { 0.0f, 600.0f, 600.0f, 0.0f }, { 600.0f, 400.0f, 400.0f, 1.0f }, { 900.0f, 200.0f, 200.0f, 2.0f } },
+			{ { 45.0f, -90.0f, -90.0f, 0.0f }, { -45.0f, 0.0f, 0.0f, 1.0f }, { -45.0f, 0.0f, 0.0f, 2.0f } }
+		};
+
+		testConversion(multiAxisKeys);
+	}
+
+	void EditorTestSuite::TestInstancedShader()
+	{
+		HShader shader = BuiltinResources::instance().getDiffuseInstancedShader();
+		BS_TEST_ASSERT(shader.isLoaded());
+
+		// The renderer only draws materials instanced if their shader declares a buffer with the instance data semantic
+		Vector<String> instanceBufferNames;
+		for (auto& entry : shader->getBufferParams())
+		{
+			if (entry.second.rendererSemantic == RPS_InstanceData)
+				instanceBufferNames = entry.second.gpuVariableNames;
+		}
+
+		BS_TEST_ASSERT(!instanceBufferNames.empty());
+
+		// No technique for DX9, as it doesn't support generic buffers
+		HMaterial material = Material::create(shader);
+		if (material->getNumPasses() == 0)
+			return;
+
+		SPtr<GpuProgram> vertexProgram = material->getPass(0)->getVertexProgram();
+		vertexProgram->blockUntilCoreInitialized();
+
+		SPtr<GpuParamDesc> paramDesc = vertexProgram->getParamDesc();
+
+		bool readsInstanceBuffer = false;
+		for (auto& name : instanceBufferNames)
+			readsInstanceBuffer |= paramDesc->buffers.find(name) != paramDesc->buffers.end();
+
+		// Only the DX11 technique reads the instance buffer, others read per-object data from the param block
+		if (vertexProgram->getProperties().getProfile() == GPP_VS_5_0)
+		{
+			BS_TEST_ASSERT(readsInstanceBuffer);
+		}
+		else
+		{
+			BS_TEST_ASSERT(!readsInstanceBuffer);
+			BS_TEST_ASSERT(paramDesc->paramBlocks.find("PerObject") != paramDesc->paramBlocks.end());
+		}
+	}
+
+	void EditorTestSuite::TestSceneManagerUnregister()
+	{
+		static const UINT32 NUM_OBJECTS = 100;
+
+		SceneManager& sceneManager = gSceneManager();
+
+		// Scripts can unregister their core objects after the scene object was already destroyed
+		SPtr<Renderable> oldRenderable = Renderable::create();
+		SPtr<Camera> oldCamera = Camera::create();
+		SPtr<Light> oldLight = Light::create();
+
+		HSceneObject oldSO = SceneObject::create("oldSO");
+		sceneManager._registerRenderable(oldRenderable, oldSO);
+		sceneManager._registerCamera(oldCamera, oldSO);
+		sceneManager._registerLight(oldLight, oldSO);
+
+		oldSO->destroy(true);
+
+		sceneManager._unregisterRenderable(oldRenderable);
+		sceneManager._unregisterCamera(oldCamera);
+		sceneManager._unregisterLight(oldLight);
+
+		const Map<Renderable*, SceneRenderableData>& renderables = sceneManager.getAllRenderables();
+		const Map<Camera*, SceneCameraData>& cameras = sceneManager.getAllCameras();
+
+		BS_TEST_ASSERT(renderables.find(oldRenderable.get()) == renderables.end());
+		BS_TEST_ASSERT(cameras.find(oldCamera.get()) == cameras.end());
+
+		UINT32 oldRenderableHash = oldRenderable->_getLastModifiedHash();
+		UINT32 oldCameraHash = oldCamera->_getLastModifiedHash();
+		UINT32 oldLightHash = oldLight->_getLastModifiedHash();
+
+		// New scene objects may be allocated at the address of the destroyed one, and must not update the unregistered
+		// core objects
+		Vector<HSceneObject> newSOs(NUM_OBJECTS);
+		Vector<SPtr<Renderable>> newRenderables(NUM_OBJECTS);
+		for (UINT32 i = 0; i < NUM_OBJECTS; i++)
+		{
+			newSOs[i] = SceneObject::create("newSO");
+			newSOs[i]->setPosition(Vector3((float)i, 0.0f, 0.0f));
+
+			newRenderables[i] = Renderable::create();
+			sceneManager._registerRenderable(newRenderables[i], newSOs[i]);
+		}
+
+		sceneManager._updateCoreObjectTransforms();
+
+		bool allUpdated = true;
+		for (UINT32 i = 0; i < NUM_OBJECTS; i++)
+			allUpdated &= newRenderables[i]->_getLastModifiedHash() == newSOs[i]->getTransformHash();
+
+		BS_TEST_ASSERT(allUpdated);
+		BS_TEST_ASSERT(oldRenderable->_getLastModifiedHash() == oldRenderableHash);
+		BS_TEST_ASSERT(oldCamera->_getLastModifiedHash() == oldCameraHash);
+		BS_TEST_ASSERT(oldLight->_getLastModifiedHash() == oldLightHash);
+
+		for (UINT32 i = 0; i < NUM_OBJECTS; i++)
+		{
+			sceneManager._unregisterRenderable(newRenderables[i]);
+			newSOs[i]->destroy(true);
+		}
+
+		oldRenderable->destroy();
+		oldCamera->destroy();
+		oldLight->destroy();
+
+		for (auto& renderable : newRenderables)
+			renderable->destroy();
+	}
 }
\ No newline at end of file
@@ -16,12 +16,14 @@
 #include "BsGUIScrollArea.h"
 #include "BsDragAndDropManager.h"
 #include "BsTime.h"
+#include "BsGUIHelper.h"
 
 using namespace std::placeholders;
 
 namespace BansheeEngine
 {
 	const UINT32 GUITreeView::ELEMENT_EXTRA_SPACING = 3;
+	const UINT32 GUITreeView::VISIBLE_AREA_MARGIN = 100;
 	const UINT32 GUITreeView::INDENT_SIZE = 10;
 	const UINT32 GUITreeView::INITIAL_INDENT_OFFSET = 16;
 	const UINT32 GUITreeView::DRAG_MIN_DISTANCE = 3;
@@ -32,8 +34,9 @@ namespace BansheeEngine
 	const Color GUITreeView::DISABLED_COLOR = Color(1.0f, 1.0f, 1.0f, 0.6f);
 
 	GUITreeView::TreeElement::TreeElement()
-		: mParent(nullptr), mFoldoutBtn(nullptr), mElement(nullptr), mSortedIdx(0), mIsExpanded(false), mIsSelected(false)
-		, mIsHighlighted(false), mIsVisible(true), mIsCut(false), mIsDisabled(false)
+		: mParent(nullptr), mFoldoutBtn(nullptr), mElement(nullptr), mElementWidth(-1), mSortedIdx(0), mRowIdx(0)
+		, mIsExpanded(false), mIsSelected(false), mIsHighlighted(false), mIsVisible(true), mIsCut(false)
+		, mIsDisabled(false)
 	{ }
 
 	GUITreeView::TreeElement::~TreeElement()
@@ -89,7 +92,8 @@ namespace BansheeEngine
 		, mDragHighlightStyle(dragHighlightStyle), mDragSepHighlightStyle(dragSepHighlightStyle), mIsElementSelected(false)
 		, mIsElementHighlighted(false), mEditElement(nullptr), mNameEditBox(nullptr), mDragInProgress(false)
 		, mDragHighlight(nullptr), mDragSepHighlight(nullptr), mScrollState(ScrollState::None), mLastScrollTime(0.0f)
-		, mMouseOverDragElement(nullptr), mMouseOverDragElementTime(0.0f)
+		, mMouseOverDragElement(nullptr), mMouseOverDragElementTime(0.0f), mMaxRowWidth(0), mRowsDirty(true)
+		, mRowWidthChanged(false), mElementStyle(&GUISkin::DefaultStyle), mElementHeight(0)
 	{
 		if(mBackgroundStyle == StringUtil::BLANK)
 			mBackgroundStyle = "TreeViewBackground";
@@ -126,6 +130,8 @@ namespace BansheeEngine
 		mDragHighlight = GUITexture::create(mDragHighlightStyle);
 		mDragSepHighlight = GUITexture::create(mDragSepHighlightStyle);
 
+		mElementHeight = calcElementSize("A").y;
+
 		mDragHighlight->setVisible(false);
 		mDragSepHighlight->setVisible(false);
 
@@ -158,6 +164,13 @@ namespace BansheeEngine
 
 		updateTreeElementHierarchy();
 
+		// Rows measured during the last layout update might have made the tree view wider
+		if(mRowWidthChanged)
+		{
+			mRowWidthChanged = false;
+			_markLayoutAsDirty();
+		}
+
 		// Attempt to scroll if needed
 		if(mScrollState != ScrollState::None)
 		{
@@ -241,23 +254,10 @@ namespace BansheeEngine
 								TreeElement* selectionRoot = mSelectedElements[0].element;
 								unselectAll();
 
-								auto iterStartFind = std::find_if(mVisibleElements.begin(), mVisibleElements.end(),
-									[&](const InteractableElement& x) { return x.parent == selectionRoot->mParent; });
+								auto iterStartFind = findInteractableElement(selectionRoot);
 
-								bool foundStart = false;
+								bool foundStart = iterStartFind != mVisibleElements.end();
 								bool foundEnd = false;
-								for (; iterStartFind != mVisibleElements.end(); ++iterStartFind)
-								{
-									if (!iterStartFind->isTreeElement())
-										continue;
-
-									TreeElement* curElem = iterStartFind->getTreeElement();
-									if (curElem == selectionRoot)
-									{
-										foundStart = true;
-										break;
-									}
-								}
 
 								auto iterEndFind = std::find_if(mVisibleElements.begin(), mVisibleElements.end(),
 									[&](const InteractableElement& x) { return &x == element; });
@@ -446,8 +446,10 @@ namespace BansheeEngine
 		if(ev.getType() == GUICommandEventType::MoveUp || ev.getType() == GUICommandEventType::SelectUp)
 		{
 			TreeElement* topMostElement = getTopMostSelectedElement();
-			auto topMostIter = std::find_if(mVisibleElements.begin(), mVisibleElements.end(), 
-				[&] (const InteractableElement& x) { return x.getTreeElement() == topMostElement; });
+
+			auto topMostIter = mVisibleElements.cbegin();
+			if (topMostElement != nullptr)
+				topMostIter = findInteractableElement(topMostElement);
 
 			if(topMostIter != mVisibleElements.end() && topMostIter != mVisibleElements.begin())
 			{
@@ -470,8 +472,10 @@ namespace BansheeEngine
 		else if(ev.getType() == GUICommandEventType::MoveDown || ev.getType() == GUICommandEventType::SelectDown)
 		{
 			TreeElement* bottoMostElement = getBottomMostSelectedElement();
-			auto bottomMostIter = std::find_if(mVisibleElements.begin(), mVisibleElements.end(), 
-				[&] (const InteractableElement& x) { return x.getTreeElement() == bottoMostElement; });
+
+			auto bottomMostIter = mVisibleElements.cbegin();
+			if (bottoMostElement != nullptr)
+				bottomMostIter = findInteractableElement(bottoMostElement);
 
 			if(bottomMostIter != mVisibleElements.end())
 			{
@@ -751,73 +755,217 @@ namespace BansheeEngine
 
 		if(element->mIsVisible)
 		{
-			HString name(toWString(element->mName));
-			if(element->mElement == nullptr)
-			{
-				element->mElement = GUILabel::create(name, mElementBtnStyle);
-				_registerChildElement(element->mElement);
-			}
+			// GUI elements are assigned and the element measured during layout, once we know if the element is in view
+			element->mElementWidth = -1;
 
-			if (element->mIsCut)
-			{
-				Color cutTint = element->mTint;
-				cutTint.a = CUT_COLOR.a;
+			if(element->mElement != nullptr)
+				refreshElementGUI(element);
+		}
+		else
+		{
+			releaseElementGUI(element);
 
-				element->mElement->setTint(cutTint);
-			}
-			else if(element->mIsDisabled)
+			if(element->mIsSelected && element->mIsExpanded)
+				unselectElement(element);
+		}
+
+		mRowsDirty = true;
+		_markLayoutAsDirty();
+	}
+
+	void GUITreeView::updateRows() const
+	{
+		if(!mRowsDirty)
+			return;
+
+		struct UpdateTreeElement
+		{
+			UpdateTreeElement(TreeElement* element, UINT32 indent)
+				:element(element), indent(indent)
+			{ }
+
+			TreeElement* element;
+			UINT32 indent;
+		};
+
+		mRows.clear();
+		mVisibleElements.clear();
+		mElementsInView.clear();
+		mMaxRowWidth = 0;
+
+		INT32 rowHeight = ELEMENT_EXTRA_SPACING + mElementHeight;
+
+		Stack<UpdateTreeElement> todo;
+		Vector<TreeElement*> tempOrderedElements;
+
+		// Children are pushed in reverse order, so they are processed in the order they are displayed in
+		auto pushChildren = [&](const TreeElement* element, UINT32 indent)
+		{
+			tempOrderedElements.clear();
+			tempOrderedElements.resize(element->mChildren.size(), nullptr);
+			for(auto& child : element->mChildren)
+				tempOrderedElements[child->mSortedIdx] = child;
+
+			for(auto iter = tempOrderedElements.rbegin(); iter != tempOrderedElements.rend(); ++iter)
 			{
-				Color disabledTint = element->mTint;
-				disabledTint.a = DISABLED_COLOR.a;
+				TreeElement* child = *iter;
+
+				if(!child->mIsVisible)
+					continue;
 
-				element->mElement->setTint(disabledTint);
+				todo.push(UpdateTreeElement(child, indent));
 			}
-			else
-				element->mElement->setTint(element->mTint);
+		};
+
+		pushChildren(&getRootElementConst(), 1);
+		while(!todo.empty())
+		{
+			UpdateTreeElement currentUpdateElement = todo.top();
+			TreeElement* current = currentUpdateElement.element;
+			UINT32 indent = currentUpdateElement.indent;
+			todo.pop();
+
+			current->mRowIdx = (UINT32)mRows.size();
+			mRows.push_back(TreeRow(current, indent));
+
+			INT32 offset = current->mRowIdx * rowHeight;
+			mVisibleElements.push_back(InteractableElement(current->mParent, current->mSortedIdx * 2 + 0, offset,
+				ELEMENT_EXTRA_SPACING));
+			mVisibleElements.push_back(InteractableElement(current->mParent, current->mSortedIdx * 2 + 1,
+				offset + ELEMENT_EXTRA_SPACING, mElementHeight));
 
-			if(element->mChildren.size() > 0)
+			if(current->mElementWidth >= 0)
+				mMaxRowWidth = std::max(mMaxRowWidth, getRowWidth(current, indent));
+
+			if(current->mElement != nullptr)
+				mElementsInView.push_back(current);
+
+			pushChildren(current, indent + 1);
+		}
+
+		mRowsDirty = false;
+	}
+
+	void GUITreeView::assignElementGUI(TreeElement* element)
+	{
+		if(element->mElement != nullptr)
+			return;
+
+		if(!mUnusedElements.empty())
+		{
+			element->mElement = mUnusedElements.back();
+			mUnusedElements.pop_back();
+		}
+		else
+		{
+			element->mElement = GUILabel::create(HString(L""), mElementBtnStyle);
+			_registerChildElement(element->mElement);
+		}
+
+		element->mElement->setVisible(element != mEditElement);
+		refreshElementGUI(element);
+	}
+
+	void GUITreeView::releaseElementGUI(TreeElement* element)
+	{
+		if(element->mElement != nullptr)
+		{
+			element->mElement->setVisible(false);
+
+			mUnusedElements.push_back(element->mElement);
+			element->mElement = nullptr;
+		}
+
+		if(element->mFoldoutBtn != nullptr)
+		{
+			element->mFoldoutToggledConn.disconnect();
+			element->mFoldoutBtn->setVisible(false);
+
+			mUnusedFoldoutBtns.push_back(element->mFoldoutBtn);
+			element->mFoldoutBtn = nullptr;
+		}
+	}
+
+	void GUITreeView::refreshElementGUI(TreeElement* element)
+	{
+		if (element->mIsCut)
+		{
+			Color cutTint = element->mTint;
+			cutTint.a = CUT_COLOR.a;
+
+			element->mElement->setTint(cutTint);
+		}
+		else if(element->mIsDisabled)
+		{
+			Color disabledTint = element->mTint;
+			disabledTint.a = DISABLED_COLOR.a;
+
+			element->mElement->setTint(disabledTint);
+		}
+		else
+			element->mElement->setTint(element->mTint);
+
+		if(element->mChildren.size() > 0)
+		{
+			if(element->mFoldoutBtn == nullptr)
 			{
-				if(element->mFoldoutBtn == nullptr)
+				if(!mUnusedFoldoutBtns.empty())
 				{
-					element->mFoldoutBtn = GUIToggle::create(GUIContent(HString(L"")), mFoldoutBtnStyle);
-					_registerChildElement(element->mFoldoutBtn);
-
-					element->mFoldoutBtn->onToggled.connect(std::bind(&GUITreeView::elementToggled, this, element, _1));
+					element->mFoldoutBtn = mUnusedFoldoutBtns.back();
+					mUnusedFoldoutBtns.pop_back();
 
-					if(element->mIsExpanded)
-						element->mFoldoutBtn->toggleOn();
+					element->mFoldoutBtn->setVisible(true);
 				}
-			}
-			else
-			{
-				if(element->mFoldoutBtn != nullptr)
+				else
 				{
-					GUIElement::destroy(element->mFoldoutBtn);
-					element->mFoldoutBtn = nullptr;
+					element->mFoldoutBtn = GUIToggle::create(GUIContent(HString(L"")), mFoldoutBtnStyle);
+					_registerChildElement(element->mFoldoutBtn);
 				}
-			}
 
-			element->mElement->setContent(GUIContent(name));
+				// Set the state before connecting, so the button doesn't report it as a toggle
+				if(element->mIsExpanded)
+					element->mFoldoutBtn->toggleOn();
+				else
+					element->mFoldoutBtn->toggleOff();
+
+				element->mFoldoutToggledConn = element->mFoldoutBtn->onToggled.connect(
+					std::bind(&GUITreeView::elementToggled, this, element, _1));
+			}
 		}
 		else
 		{
-			if(element->mElement != nullptr)
-			{
-				GUIElement::destroy(element->mElement);
-				element->mElement = nullptr;
-			}
-
 			if(element->mFoldoutBtn != nullptr)
 			{
-				GUIElement::destroy(element->mFoldoutBtn);
+				element->mFoldoutToggledConn.disconnect();
+				element->mFoldoutBtn->setVisible(false);
+
+				mUnusedFoldoutBtns.push_back(element->mFoldoutBtn);
 				element->mFoldoutBtn = nullptr;
 			}
-
-			if(element->mIsSelected && element->mIsExpanded)
-				unselectElement(element);
 		}
 
-		_markLayoutAsDirty();
+		element->mElement->setContent(GUIContent(HString(toWString(element->mName))));
+	}
+
+	Vector2I GUITreeView::calcElementSize(const String& name) const
+	{
+		GUIDimensions dimensions = GUIDimensions::create();
+		dimensions.updateWithStyle(mElementStyle);
+
+		return GUIHelper::calcOptimalContentsSize(toWString(name), *mElementStyle, dimensions);
+	}
+
+	INT32 GUITreeView::getRowWidth(const TreeElement* element, UINT32 indent) const
+	{
+		return (INT32)(INITIAL_INDENT_OFFSET + indent * INDENT_SIZE) + element->mElementWidth;
+	}
+
+	const GUIElementStyle* GUITreeView::getElementStyle() const
+	{
+		if(_getParentWidget() != nullptr)
+			return _getParentWidget()->getSkin().getStyle(mElementBtnStyle);
+
+		return &GUISkin::DefaultStyle;
 	}
 
 	void GUITreeView::elementToggled(TreeElement* element, bool toggled)
@@ -886,16 +1034,6 @@ namespace BansheeEngine
 
 	Vector2I GUITreeView::_getOptimalSize() const
 	{
-		struct UpdateTreeElement
-		{
-			UpdateTreeElement(const TreeElement* element, UINT32 indent)
-				:element(element), indent(indent)
-			{ }
-
-			const TreeElement* element;
-			UINT32 indent;
-		};
-
 		Vector2I optimalSize;
 
 		if (_getDimensions().fixedWidth() && _getDimensions().fixedHeight())
@@ -905,34 +1043,12 @@ namespace BansheeEngine
 		}
 		else
 		{
-			Stack<UpdateTreeElement> todo;
-			todo.push(UpdateTreeElement(&getRootElementConst(), 0));
+			// All rows are of the same height, but only rows that were in view have been measured, so the width grows
+			// as the user scrolls through the tree view
+			updateRows();
 
-			while(!todo.empty())
-			{
-				UpdateTreeElement currentUpdateElement = todo.top();
-				const TreeElement* current = currentUpdateElement.element;
-				todo.pop();
-
-				INT32 yOffset = 0;
-				if(current->mElement != nullptr)
-				{
-					Vector2I curOptimalSize = current->mElement->_getOptimalSize();
-					optimalSize.x = std::max(optimalSize.x, 
-						(INT32)(INITIAL_INDENT_OFFSET + curOptimalSize.x + currentUpdateElement.indent * INDENT_SIZE));
-					yOffset = curOptimalSize.y + ELEMENT_EXTRA_SPACING;
-				}
-
-				optimalSize.y += yOffset;
-
-				for(auto& child : current->mChildren)
-				{
-					if(!child->mIsVisible)
-						continue;
-
-					todo.push(UpdateTreeElement(child, currentUpdateElement.indent + 1));
-				}
-			}
+			optimalSize.x = mMaxRowWidth;
+			optimalSize.y = (INT32)mRows.size() * (ELEMENT_EXTRA_SPACING + mElementHeight);
 
 			if(_getDimensions().fixedWidth())
 				optimalSize.x = _getDimensions().minWidth;
@@ -960,6 +1076,34 @@ namespace BansheeEngine
 		return optimalSize;
 	}
 
+	void GUITreeView::_updateOptimalLayoutSizes()
+	{
+		// Element sizes are cached, so they need to be re-calculated if the skin changes
+		const GUIElementStyle* elementStyle = getElementStyle();
+		if(elementStyle != mElementStyle)
+		{
+			mElementStyle = elementStyle;
+			mElementHeight = calcElementSize("A").y;
+
+			// Hidden elements are measured when they are shown
+			updateRows();
+			for(auto& row : mRows)
+				row.element->mElementWidth = -1;
+
+			mRowsDirty = true;
+		}
+
+		// Measure rows that came into view before the parent layout requests our size, assuming the visible area didn't
+		// change since the last layout update
+		updateRows();
+
+		INT32 firstRow, lastRow;
+		getRowsInView(mLayoutData, firstRow, lastRow);
+		measureRows(firstRow, lastRow);
+
+		GUIElementContainer::_updateOptimalLayoutSizes();
+	}
+
 	void GUITreeView::updateClippedBounds()
 	{
 		mClippedBounds = mLayoutData.area;
@@ -968,58 +1112,47 @@ namespace BansheeEngine
 
 	void GUITreeView::_updateLayoutInternal(const GUILayoutData& data)
 	{
-		struct UpdateTreeElement
-		{
-			UpdateTreeElement(TreeElement* element, UINT32 indent)
-				:element(element), indent(indent)
-			{ }
-
-			TreeElement* element;
-			UINT32 indent;
-		};
+		updateRows();
 
-		mVisibleElements.clear();
+		INT32 rowHeight = ELEMENT_EXTRA_SPACING + mElementHeight;
+		INT32 numRows = (INT32)mRows.size();
 
-		Stack<UpdateTreeElement> todo;
-		todo.push(UpdateTreeElement(&getRootElement(), 0));
+		// Only rows in (or near) the visible area get GUI elements assigned
+		INT32 firstRow, lastRow;
+		getRowsInView(data, firstRow, lastRow);
 
-		// NOTE - Instead of iterating through all elements, try to find those within the clip rect
-		// and only iterate through those. Others should somehow be marked in-active (similar to GUIElement::isDisabled()?)
+		// Layout can't be marked as dirty during the layout update, as the parent widget marks the updated elements as
+		// clean afterwards, so parent layouts are notified of the new width on the next update instead
+		if(measureRows(firstRow, lastRow))
+			mRowWidthChanged = true;
 
-		Vector<TreeElement*> tempOrderedElements;
-
-		Vector2I offset(data.area.x, data.area.y);
-
-		while(!todo.empty())
+		for(auto& element : mElementsInView)
 		{
-			UpdateTreeElement currentUpdateElement = todo.top();
-			TreeElement* current = currentUpdateElement.element;
-			UINT32 indent = currentUpdateElement.indent;
-			todo.pop();
+			if((INT32)element->mRowIdx < firstRow || (INT32)element->mRowIdx >= lastRow)
+				releaseElementGUI(element);
+		}
 
-			INT32 btnHeight = 0;
-			INT32 yOffset = 0;
-			if(current->mElement != nullptr)
-			{
-				Vector2I elementSize = current->mElement->_getOptimalSize();
-				btnHeight = elementSize.y;
+		mElementsInView.clear();
 
-				mVisibleElements.push_back(InteractableElement(current->mParent, current->mSortedIdx * 2 + 0, Rect2I(data.area.x, offset.y, data.area.width, ELEMENT_EXTRA_SPACING)));
-				mVisibleElements.push_back(InteractableElement(current->mParent, current->mSortedIdx * 2 + 1, Rect2I(data.area.x, offset.y + ELEMENT_EXTRA_SPACING, data.area.width, btnHeight)));
+		for(INT32 i = firstRow; i < lastRow; i++)
+		{
+			TreeElement* current = mRows[i].element;
+			UINT32 indent = mRows[i].indent;
 
-				offset.x = data.area.x + INITIAL_INDENT_OFFSET + indent * INDENT_SIZE;
-				offset.y += ELEMENT_EXTRA_SPACING;
+			assignElementGUI(current);
+			mElementsInView.push_back(current);
 
-				GUILayoutData childData = data;
-				childData.area.x = offset.x;
-				childData.area.y = offset.y;
-				childData.area.width = elementSize.x;
-				childData.area.height = elementSize.y;
+			Vector2I offset;
+			offset.x = data.area.x + INITIAL_INDENT_OFFSET + indent * INDENT_SIZE;
+			offset.y = data.area.y + i * rowHeight + ELEMENT_EXTRA_SPACING;
 
-				current->mElement->_setLayoutData(childData);
+			GUILayoutData childData = data;
+			childData.area.x = offset.x;
+			childData.area.y = offset.y;
+			childData.area.width = current->mElementWidth;
+			childData.area.height = mElementHeight;
 
-				yOffset = btnHeight;
-			}
+			current->mElement->_setLayoutData(childData);
 
 			if(current->mFoldoutBtn != nullptr)
 			{
@@ -1030,55 +1163,47 @@ namespace BansheeEngine
 				Vector2I myOffset = offset;
 				myOffset.y += 1;
 
-				if(elementSize.y > btnHeight)
+				if(elementSize.y > mElementHeight)
 				{
-					UINT32 diff = elementSize.y - btnHeight;
+					UINT32 diff = elementSize.y - mElementHeight;
 					float half = diff * 0.5f;
 					myOffset.y -= Math::floorToInt(half);
 				}
 
-				GUILayoutData childData = data;
-				childData.area.x = myOffset.x;
-				childData.area.y = myOffset.y;
-				childData.area.width = elementSize.x;
-				childData.area.height = elementSize.y;
-
-				current->mFoldoutBtn->_setLayoutData(childData);
-			}
-
-			offset.y += yOffset;
+				GUILayoutData foldoutData = data;
+				foldoutData.area.x = myOffset.x;
+				foldoutData.area.y = myOffset.y;
+				foldoutData.area.width = elementSize.x;
+				foldoutData.area.height = elementSize.y;
 
-			tempOrderedElements.resize(current->mChildren.size(), nullptr);
-			for(auto& child : current->mChildren)
-			{
-				tempOrderedElements[child->mSortedIdx] = child;
-			}
-
-			for(auto iter = tempOrderedElements.rbegin(); iter != tempOrderedElements.rend(); ++iter)
-			{
-				TreeElement* child = *iter;
-
-				if(!child->mIsVisible)
-					continue;
-
-				todo.push(UpdateTreeElement(child, indent + 1));
+				current->mFoldoutBtn->_setLayoutData(foldoutData);
 			}
 		}
 
-		UINT32 remainingHeight = (UINT32)std::max(0, (INT32)data.area.height - (offset.y - data.area.y));
+		// Separator below the last row covers the rest of the tree view, so its size depends on layout
+		mVisibleElements.resize(numRows * 2, InteractableElement(nullptr, 0, 0, 0));
+
+		INT32 contentHeight = numRows * rowHeight;
+		UINT32 remainingHeight = (UINT32)std::max(0, (INT32)data.area.height - contentHeight);
 
 		if(remainingHeight > 0)
-			mVisibleElements.push_back(InteractableElement(&getRootElement(), (UINT32)getRootElement().mChildren.size() * 2, Rect2I(data.area.x, offset.y, data.area.width, remainingHeight)));
+		{
+			mVisibleElements.push_back(InteractableElement(&getRootElement(),
+				(UINT32)getRootElement().mChildren.size() * 2, contentHeight, remainingHeight));
+		}
 
 		for(auto selectedElem : mSelectedElements)
 		{
 			GUILabel* targetElement = selectedElem.element->mElement;
-			if (targetElement == nullptr)
-				continue;
 
 			GUILayoutData childData = data;
-			childData.area.y = targetElement->_getLayoutData().area.y;
-			childData.area.height = targetElement->_getLayoutData().area.height;
+			if (targetElement != nullptr)
+			{
+				childData.area.y = targetElement->_getLayoutData().area.y;
+				childData.area.height = targetElement->_getLayoutData().area.height;
+			}
+			else // Element is out of view
+				childData.clipRect = Rect2I();
 
 			selectedElem.background->_setLayoutData(childData);
 		}
@@ -1086,29 +1211,36 @@ namespace BansheeEngine
 		if (mIsElementHighlighted)
 		{
 			GUILabel* targetElement = mHighlightedElement.element->mElement;
+
+			GUILayoutData childData = data;
 			if (targetElement != nullptr)
 			{
-				GUILayoutData childData = data;
 				childData.area.y = targetElement->_getLayoutData().area.y;
 				childData.area.height = targetElement->_getLayoutData().area.height;
-
-				mHighlightedElement.background->_setLayoutData(childData);
 			}
+			else // Element is out of view
+				childData.clipRect = Rect2I();
+
+			mHighlightedElement.background->_setLayoutData(childData);
 		}
 
 		if(mEditElement != nullptr)
 		{
 			GUILabel* targetElement = mEditElement->mElement;
+
+			GUILayoutData childData = data;
 			if (targetElement != nullptr)
 			{
-				UINT32 remainingWidth = (UINT32)std::max(0, (((INT32)data.area.width) - (offset.x - data.area.x)));
-
-				GUILayoutData childData = data;
 				childData.area = targetElement->_getLayoutData().area;
-				childData.area.width = remainingWidth;
 
-				mNameEditBox->_setLayoutData(childData);
+				INT32 offsetX = childData.area.x - data.area.x;
+				UINT32 remainingWidth = (UINT32)std::max(0, ((INT32)data.area.width) - offsetX);
+				childData.area.width = remainingWidth;
 			}
+			else // Element is out of view
+				childData.clipRect = Rect2I();
+
+			mNameEditBox->_setLayoutData(childData);
 		}
 
 		if(mDragInProgress)
@@ -1128,7 +1260,7 @@ namespace BansheeEngine
 					mDragHighlight->setVisible(true);
 
 					GUILayoutData childData = data;
-					childData.area = interactableElement->bounds;
+					childData.area = getElementBounds(*interactableElement);
 
 					mDragHighlight->_setLayoutData(childData);
 				}
@@ -1138,7 +1270,7 @@ namespace BansheeEngine
 					mDragSepHighlight->setVisible(true);
 
 					GUILayoutData childData = data;
-					childData.area = interactableElement->bounds;
+					childData.area = getElementBounds(*interactableElement);
 
 					mDragSepHighlight->_setLayoutData(childData);
 				}
@@ -1164,27 +1296,91 @@ namespace BansheeEngine
 		mBottomScrollBounds.height = scrollHeight;
 	}
 
-	const GUITreeView::InteractableElement* GUITreeView::findElementUnderCoord(const Vector2I& coord) const
+	void GUITreeView::getRowsInView(const GUILayoutData& data, INT32& firstRow, INT32& lastRow) const
+	{
+		INT32 rowHeight = ELEMENT_EXTRA_SPACING + mElementHeight;
+		INT32 numRows = (INT32)mRows.size();
+
+		firstRow = 0;
+		lastRow = 0;
+
+		if(data.clipRect.width == 0 || data.clipRect.height == 0 || rowHeight <= 0)
+			return;
+
+		INT32 visibleTop = data.clipRect.y - (INT32)VISIBLE_AREA_MARGIN - data.area.y;
+		INT32 visibleBottom = visibleTop + (INT32)(data.clipRect.height + VISIBLE_AREA_MARGIN * 2);
+
+		firstRow = Math::clamp(Math::floorToInt(visibleTop / (float)rowHeight), 0, numRows);
+		lastRow = Math::clamp(Math::ceilToInt(visibleBottom / (float)rowHeight), firstRow, numRows);
+	}
+
+	bool GUITreeView::measureRows(INT32 firstRow, INT32 lastRow)
 	{
-		for(auto& element : mVisibleElements)
+		bool widthChanged = false;
+		for(INT32 i = firstRow; i < lastRow; i++)
 		{
-			if(element.bounds.contains(coord))
+			TreeElement* current = mRows[i].element;
+			if(current->mElementWidth >= 0)
+				continue;
+
+			current->mElementWidth = calcElementSize(current->mName).x;
+
+			INT32 rowWidth = getRowWidth(current, mRows[i].indent);
+			if(rowWidth > mMaxRowWidth)
 			{
-				return &element;
+				mMaxRowWidth = rowWidth;
+				widthChanged = true;
 			}
 		}
 
+		return widthChanged;
+	}
+
+	const GUITreeView::InteractableElement* GUITreeView::findElementUnderCoord(const Vector2I& coord) const
+	{
+		// Elements are stored in order from top to bottom, without overlapping
+		auto iterFind = std::upper_bound(mVisibleElements.begin(), mVisibleElements.end(), coord.y - mLayoutData.area.y,
+			[](INT32 y, const InteractableElement& x) { return y < x.y; });
+
+		if(iterFind == mVisibleElements.begin())
+			return nullptr;
+
+		--iterFind;
+		if(getElementBounds(*iterFind).contains(coord))
+			return &(*iterFind);
+
 		return nullptr;
 	}
 
+	Vector<GUITreeView::InteractableElement>::const_iterator GUITreeView::findInteractableElement(
+		const TreeElement* element) const
+	{
+		updateRows();
+
+		// Each row is preceded by a separator
+		UINT32 visibleIdx = element->mRowIdx * 2 + 1;
+		if(!element->mIsVisible || element == &getRootElementConst() || visibleIdx >= (UINT32)mVisibleElements.size())
+			return mVisibleElements.end();
+
+		auto iterFind = mVisibleElements.begin() + visibleIdx;
+		if(iterFind->parent != element->mParent || iterFind->index != element->mSortedIdx * 2 + 1)
+			return mVisibleElements.end();
+
+		return iterFind;
+	}
+
+	Rect2I GUITreeView::getElementBounds(const InteractableElement& element) const
+	{
+		return Rect2I(mLayoutData.area.x, mLayoutData.area.y + element.y, mLayoutData.area.width, element.height);
+	}
+
 	GUITreeView::TreeElement* GUITreeView::getTopMostSelectedElement() const
 	{
-		auto topMostElement = mVisibleElements.end();
+		auto topMostElement = mVisibleElements.cend();
 
 		for(auto& selectedElement : mSelectedElements)
 		{
-			auto iterFind = std::find_if(mVisibleElements.begin(), mVisibleElements.end(), 
-				[&] (const InteractableElement& x) { return x.getTreeElement() == selectedElement.element; });
+			auto iterFind = findInteractableElement(selectedElement.element);
 
 			if(iterFind != mVisibleElements.end())
 			{
@@ -1192,7 +1388,7 @@ namespace BansheeEngine
 					topMostElement = iterFind;
 				else
 				{
-					if(iterFind->bounds.y < topMostElement->bounds.y)
+					if(iterFind->y < topMostElement->y)
 						topMostElement = iterFind;
 				}
 			}
@@ -1206,12 +1402,11 @@ namespace BansheeEngine
 
 	GUITreeView::TreeElement* GUITreeView::getBottomMostSelectedElement() const
 	{
-		auto botMostElement = mVisibleElements.end();
+		auto botMostElement = mVisibleElements.cend();
 
 		for(auto& selectedElement : mSelectedElements)
 		{
-			auto iterFind = std::find_if(mVisibleElements.begin(), mVisibleElements.end(), 
-				[&] (const InteractableElement& x) { return x.getTreeElement() == selectedElement.element; });
+			auto iterFind = findInteractableElement(selectedElement.element);
 
 			if(iterFind != mVisibleElements.end())
 			{
@@ -1219,7 +1414,7 @@ namespace BansheeEngine
 					botMostElement = iterFind;
 				else
 				{
-					if((iterFind->bounds.y + iterFind->bounds.height) > (botMostElement->bounds.y + botMostElement->bounds.height))
+					if((iterFind->y + (INT32)iterFind->height) > (botMostElement->y + (INT32)botMostElement->height))
 						botMostElement = iterFind;
 				}
 			}
@@ -1292,18 +1487,24 @@ namespace BansheeEngine
 
 	void GUITreeView::scrollToElement(TreeElement* element, bool center)
 	{
-		if(element->mElement == nullptr)
-			return;
-
 		GUIScrollArea* scrollArea = findParentScrollArea();
 		if(scrollArea == nullptr)
 			return;
 
+		// Make sure element positions are up to date, as the element might not have a GUI element assigned
+		getGlobalBounds();
+
+		auto iterFind = findInteractableElement(element);
+		if(iterFind == mVisibleElements.end())
+			return;
+
+		Rect2I elemBounds = getElementBounds(*iterFind);
+
 		if(center)
 		{
 			Rect2I myBounds = _getClippedBounds();
 			INT32 clipVertCenter = myBounds.y + (INT32)Math::roundToInt(myBounds.height * 0.5f);
-			INT32 elemVertCenter = element->mElement->_getLayoutData().area.y + (INT32)Math::roundToInt(element->mElement->_getLayoutData().area.height * 0.5f);
+			INT32 elemVertCenter = elemBounds.y + (INT32)Math::roundToInt(elemBounds.height * 0.5f);
 
 			if(elemVertCenter > clipVertCenter)
 				scrollArea->scrollDownPx(elemVertCenter - clipVertCenter);
@@ -1313,8 +1514,8 @@ namespace BansheeEngine
 		else
 		{
 			Rect2I myBounds = _getClippedBounds();
-			INT32 elemVertTop = element->mElement->_getLayoutData().area.y;
-			INT32 elemVertBottom = element->mElement->_getLayoutData().area.y + element->mElement->_getLayoutData().area.height;
+			INT32 elemVertTop = elemBounds.y;
+			INT32 elemVertBottom = elemBounds.y + elemBounds.height;
 
 			INT32 top = myBounds.y;
 			INT32 bottom = myBounds.y + myBounds.height;
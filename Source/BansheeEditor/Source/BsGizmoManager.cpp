@@ -19,6 +19,9 @@
 #include "BsTransientMesh.h"
 #include "BsRendererManager.h"
 #include "BsDrawHelper.h"
+#include "BsRay.h"
+#include "BsConvexVolume.h"
+#include "BsPlane.h"
 
 using namespace std::placeholders;
 
@@ -31,10 +34,11 @@ namespace BansheeEngine
 	const float GizmoManager::MAX_ICON_RANGE = 500.0f;
 	const UINT32 GizmoManager::OPTIMAL_ICON_SIZE = 64;
 	const float GizmoManager::ICON_TEXEL_WORLD_SIZE = 0.05f;
+	const float GizmoManager::PICKING_LINE_TOLERANCE = 3.0f;
 
 	GizmoManager::GizmoManager()
 		: mPickable(false), mCurrentIdx(0), mTransformDirty(false), mColorDirty(false), mDrawHelper(nullptr)
-		, mPickingDrawHelper(nullptr), mCore(nullptr)
+		, mPickingDrawHelper(nullptr), mIconMeshHash(0), mCore(nullptr)
 		
 	{
 		mTransform = Matrix4::IDENTITY;
@@ -423,16 +427,25 @@ namespace BansheeEngine
 
 	void GizmoManager::update(const SPtr<Camera>& camera)
 	{
-		mDrawHelper->clearMeshes(mActiveMeshes);
-		mActiveMeshes.clear();
-
-		if (mIconMesh != nullptr)
-			mIconMeshHeap->dealloc(mIconMesh);
+		// Gizmos are re-recorded every frame but rarely change, so only regenerate the meshes if something did. If only
+		// the camera moved, only the meshes that need to be re-sorted or re-oriented are regenerated.
+		Vector3 cameraPosition = camera->getPosition();
+		if (!mDrawHelper->canReuseMeshes(DrawHelper::SortType::BackToFront, cameraPosition))
+		{
+			if (mDrawHelper->canReuseStaticMeshes(DrawHelper::SortType::BackToFront))
+			{
+				mDrawHelper->rebuildViewDependentMeshes(cameraPosition);
+			}
+			else
+			{
+				mDrawHelper->clearMeshes(mActiveMeshes);
+				mActiveMeshes.clear();
 
-		IconRenderDataVecPtr iconRenderData;
+				mDrawHelper->buildMeshes(DrawHelper::SortType::BackToFront, cameraPosition);
+			}
 
-		mDrawHelper->buildMeshes(DrawHelper::SortType::BackToFront, camera->getPosition());
-		mActiveMeshes = mDrawHelper->getMeshes();
+			mActiveMeshes = mDrawHelper->getMeshes();
+		}
 
 		Vector<GizmoManagerCore::MeshData> proxyData;
 		for (auto& meshData : mActiveMeshes)
@@ -463,13 +476,22 @@ namespace BansheeEngine
 			}
 		}
 
-		mIconMesh = buildIconMesh(camera, mIconData, false, iconRenderData);
+		size_t iconHash = calculateIconHash(camera, mIconData);
+		if (mIconMesh == nullptr || iconHash != mIconMeshHash)
+		{
+			if (mIconMesh != nullptr)
+				mIconMeshHeap->dealloc(mIconMesh);
+
+			mIconMesh = buildIconMesh(camera, mIconData, false, mIconRenderData);
+			mIconMeshHash = iconHash;
+		}
+
 		SPtr<MeshCoreBase> iconMesh = mIconMesh->getCore();
 
 		GizmoManagerCore* core = mCore.load(std::memory_order_relaxed);
 
 		gCoreAccessor().queueCommand(std::bind(&GizmoManagerCore::updateData, core, camera->getCore(),
-			proxyData, iconMesh, iconRenderData));
+			proxyData, iconMesh, mIconRenderData));
 	}
 
 	void GizmoManager::renderForPicking(const SPtr<Camera>& camera, std::function<Color(UINT32)> idxToColorCallback)
@@ -477,6 +499,49 @@ namespace BansheeEngine
 		Vector<IconData> iconData;
 		IconRenderDataVecPtr iconRenderData;
 
+		recordPickingGizmos(idxToColorCallback, iconData);
+
+		mPickingDrawHelper->buildMeshes(DrawHelper::SortType::BackToFront, camera->getPosition());
+		const Vector<DrawHelper::ShapeMeshData>& meshes = mPickingDrawHelper->getMeshes();
+
+		SPtr<TransientMesh> iconMesh = buildIconMesh(camera, iconData, true, iconRenderData);
+
+		// Note: This must be rendered while Scene view is being rendered
+		Matrix4 viewMat = camera->getViewMatrix();
+		Matrix4 projMat = camera->getProjectionMatrixRS();
+		SPtr<Viewport> viewport = camera->getViewport();
+
+		GizmoManagerCore* core = mCore.load(std::memory_order_relaxed);
+
+		for (auto& meshData : meshes)
+		{
+			SPtr<TextureCore> tex;
+			if (meshData.texture.isLoaded())
+				tex = meshData.texture->getCore();
+
+			if(meshData.type == DrawHelper::MeshType::Text)
+			{
+				gCoreAccessor().queueCommand(std::bind(&GizmoManagerCore::renderGizmos, core, viewMat, projMat,
+					camera->getForward(), meshData.mesh->getCore(), tex, GizmoMaterial::PickingAlpha));
+			}
+			else
+			{
+				gCoreAccessor().queueCommand(std::bind(&GizmoManagerCore::renderGizmos, core, viewMat, projMat,
+					camera->getForward(), meshData.mesh->getCore(), tex, GizmoMaterial::Picking));
+			}
+		}
+
+		Rect2I screenArea = camera->getViewport()->getArea();
+
+		gCoreAccessor().queueCommand(std::bind(&GizmoManagerCore::renderIconGizmos,
+			core, screenArea, iconMesh->getCore(), iconRenderData, true));
+
+		mPickingDrawHelper->clearMeshes(meshes);
+		mIconMeshHeap->dealloc(iconMesh);
+	}
+
+	void GizmoManager::recordPickingGizmos(std::function<Color(UINT32)> idxToColorCallback, Vector<IconData>& iconData)
+	{
 		mPickingDrawHelper->clear();
 
 		for (auto& cubeDataEntry : mSolidCubeData)
@@ -635,44 +700,257 @@ namespace BansheeEngine
 			iconData.push_back(iconDataEntry);
 			iconData.back().color = idxToColorCallback(iconDataEntry.idx);
 		}
+	}
 
-		mPickingDrawHelper->buildMeshes(DrawHelper::SortType::BackToFront, camera->getPosition());
-		const Vector<DrawHelper::ShapeMeshData>& meshes = mPickingDrawHelper->getMeshes();
+	void GizmoManager::pickGizmos(const SPtr<Camera>& camera, const Ray& ray, Vector<std::pair<UINT32, float>>& output)
+	{
+		findPickedGizmos(camera, &ray, nullptr, output);
+	}
 
-		SPtr<TransientMesh> iconMesh = buildIconMesh(camera, iconData, true, iconRenderData);
+	void GizmoManager::pickGizmos(const SPtr<Camera>& camera, const ConvexVolume& volume, 
+		Vector<std::pair<UINT32, float>>& output)
+	{
+		findPickedGizmos(camera, nullptr, &volume, output);
+	}
 
-		// Note: This must be rendered while Scene view is being rendered
-		Matrix4 viewMat = camera->getViewMatrix();
-		Matrix4 projMat = camera->getProjectionMatrixRS();
-		SPtr<Viewport> viewport = camera->getViewport();
+	void GizmoManager::findPickedGizmos(const SPtr<Camera>& camera, const Ray* ray, const ConvexVolume* volume,
+		Vector<std::pair<UINT32, float>>& output)
+	{
+		// Gizmo index is encoded in the vertex color. Offset by half a step so it survives conversion to 8-bit.
+		auto idxToColor = [](UINT32 idx)
+		{
+			return Color(((idx & 0xFF) + 0.5f) / 255.0f, (((idx >> 8) & 0xFF) + 0.5f) / 255.0f,
+				(((idx >> 16) & 0xFF) + 0.5f) / 255.0f, 1.0f);
+		};
 
-		GizmoManagerCore* core = mCore.load(std::memory_order_relaxed);
+		Vector<IconData> iconData;
+		recordPickingGizmos(idxToColor, iconData);
 
-		for (auto& meshData : meshes)
+		Vector<DrawHelper::ShapeMeshRawData> meshes;
+		mPickingDrawHelper->buildMeshData(DrawHelper::SortType::None, camera->getPosition(), 0xFFFFFFFFFFFFFFFF, meshes);
+
+		Vector3 cameraPos = camera->getPosition();
+		Vector<Plane> planes;
+		if (volume != nullptr)
+			planes = volume->getPlanes();
+
+		UnorderedMap<UINT32, float> hits;
+		auto addHit = [&](UINT32 idx, float distance)
 		{
-			SPtr<TextureCore> tex;
-			if (meshData.texture.isLoaded())
-				tex = meshData.texture->getCore();
+			auto iterFind = hits.find(idx);
+			if (iterFind == hits.end())
+				hits[idx] = distance;
+			else if (distance < iterFind->second)
+				iterFind->second = distance;
+		};
+
+		auto testTriangle = [&](const Vector3& a, const Vector3& b, const Vector3& c, float& distance)
+		{
+			if (ray != nullptr)
+			{
+				Vector3 normal = (b - a).cross(c - a);
+				auto result = ray->intersects(a, b, c, normal);
 
-			if(meshData.type == DrawHelper::MeshType::Text)
+				distance = result.second;
+				return result.first;
+			}
+
+			for (auto& plane : planes)
 			{
-				gCoreAccessor().queueCommand(std::bind(&GizmoManagerCore::renderGizmos, core, viewMat, projMat,
-					camera->getForward(), meshData.mesh->getCore(), tex, GizmoMaterial::PickingAlpha));
+				if (a.dot(plane.normal) < plane.d && b.dot(plane.normal) < plane.d && c.dot(plane.normal) < plane.d)
+					return false;
 			}
+
+			distance = std::min(std::min(a.distance(cameraPos), b.distance(cameraPos)), c.distance(cameraPos));
+			return true;
+		};
+
+		auto testLine = [&](const Vector3& a, const Vector3& b, float& distance)
+		{
+			if (ray != nullptr)
+			{
+				// Find the closest points between the ray and the line segment
+				const Vector3& origin = ray->getOrigin();
+				const Vector3& direction = ray->getDirection();
+
+				Vector3 lineDir = b - a;
+				Vector3 diff = origin - a;
+
+				float lineLengthSqrd = lineDir.dot(lineDir);
+				float dirDot = direction.dot(lineDir);
+				float diffDotDir = direction.dot(diff);
+				float diffDotLine = lineDir.dot(diff);
+
+				float s = 0.0f;
+				float denom = lineLengthSqrd - dirDot * dirDot;
+				if (denom > 1e-8f)
+					s = Math::clamp01((diffDotLine - dirDot * diffDotDir) / denom);
+
+				float t = s * dirDot - diffDotDir;
+				if (t < 0.0f)
+				{
+					t = 0.0f;
+
+					if (lineLengthSqrd > 1e-8f)
+						s = Math::clamp01(diffDotLine / lineLengthSqrd);
+				}
+
+				Vector3 linePoint = a + lineDir * s;
+				Vector3 rayPoint = ray->getPoint(t);
+
+				float tolerance = PICKING_LINE_TOLERANCE * getWorldPixelSize(camera, linePoint.distance(cameraPos));
+				if (linePoint.distance(rayPoint) > tolerance)
+					return false;
+
+				distance = t;
+				return true;
+			}
+
+			// Clip the line segment by all planes of the volume
+			float start = 0.0f;
+			float end = 1.0f;
+			for (auto& plane : planes)
+			{
+				float distA = a.dot(plane.normal) - plane.d;
+				float distB = b.dot(plane.normal) - plane.d;
+
+				if (distA < 0.0f && distB < 0.0f)
+					return false;
+
+				if (distA < 0.0f)
+					start = std::max(start, distA / (distA - distB));
+				else if (distB < 0.0f)
+					end = std::min(end, distA / (distA - distB));
+
+				if (start > end)
+					return false;
+			}
+
+			Vector3 clippedA = a + (b - a) * start;
+			Vector3 clippedB = a + (b - a) * end;
+
+			distance = std::min(clippedA.distance(cameraPos), clippedB.distance(cameraPos));
+			return true;
+		};
+
+		for (auto& mesh : meshes)
+		{
+			const SPtr<MeshData>& meshData = mesh.meshData;
+
+			UINT32 numVertices = meshData->getNumVertices();
+			Vector<Vector3> positions(numVertices);
+			Vector<UINT32> gizmoIndices(numVertices);
+
+			auto positionIter = meshData->getVec3DataIter(VES_POSITION);
+			auto colorIter = meshData->getDWORDDataIter(VES_COLOR);
+			for (UINT32 i = 0; i < numVertices; i++)
+			{
+				positions[i] = positionIter.getValue();
+				gizmoIndices[i] = colorIter.getValue() & 0x00FFFFFF;
+
+				positionIter.moveNext();
+				colorIter.moveNext();
+			}
+
+			UINT32 numIndices = meshData->getNumIndices();
+			UINT32* indexData = meshData->getIndices32();
+
+			float distance;
+			if (mesh.type == DrawHelper::MeshType::Line)
+			{
+				for (UINT32 i = 0; (i + 1) < numIndices; i += 2)
+				{
+					UINT32 a = indexData[i];
+					UINT32 b = indexData[i + 1];
+
+					if (testLine(positions[a], positions[b], distance))
+						addHit(gizmoIndices[a], distance);
+				}
+			}
+			else if (mesh.type == DrawHelper::MeshType::Wire)
+			{
+				// Wire meshes are rendered as wireframe, so only their edges are visible
+				for (UINT32 i = 0; (i + 2) < numIndices; i += 3)
+				{
+					for (UINT32 j = 0; j < 3; j++)
+					{
+						UINT32 a = indexData[i + j];
+						UINT32 b = indexData[i + (j + 1) % 3];
+
+						if (a >= numVertices || b >= numVertices)
+							continue;
+
+						if (testLine(positions[a], positions[b], distance))
+							addHit(gizmoIndices[a], distance);
+					}
+				}
+			}
+			else // Solid or text
+			{
+				for (UINT32 i = 0; (i + 2) < numIndices; i += 3)
+				{
+					UINT32 a = indexData[i];
+					UINT32 b = indexData[i + 1];
+					UINT32 c = indexData[i + 2];
+
+					if (testTriangle(positions[a], positions[b], positions[c], distance))
+						addHit(gizmoIndices[a], distance);
+				}
+			}
+		}
+
+		// Icons always face the camera, so approximate them with spheres
+		for (auto& iconEntry : iconData)
+		{
+			if (!iconEntry.texture.isLoaded())
+				continue;
+
+			Vector3 viewPoint = camera->worldToViewPoint(iconEntry.position);
+
+			float viewDistance = -viewPoint.z;
+			if (viewDistance < camera->getNearClipDistance() || viewDistance > MAX_ICON_RANGE)
+				continue;
+
+			UINT32 iconWidth = iconEntry.texture->getWidth();
+			UINT32 iconHeight = iconEntry.texture->getHeight();
+			limitIconSize(iconWidth, iconHeight);
+
+			float radius = std::max(iconWidth, iconHeight) * 0.5f;
+			if (iconEntry.fixedScale)
+				radius *= getWorldPixelSize(camera, viewDistance);
 			else
+				radius *= ICON_TEXEL_WORLD_SIZE;
+
+			Sphere sphere(iconEntry.position, radius);
+			if (ray != nullptr)
 			{
-				gCoreAccessor().queueCommand(std::bind(&GizmoManagerCore::renderGizmos, core, viewMat, projMat,
-					camera->getForward(), meshData.mesh->getCore(), tex, GizmoMaterial::Picking));
+				auto result = ray->intersects(sphere);
+				if (result.first)
+					addHit(iconEntry.idx, result.second);
+			}
+			else
+			{
+				if (volume->intersects(sphere))
+					addHit(iconEntry.idx, iconEntry.position.distance(cameraPos));
 			}
 		}
 
-		Rect2I screenArea = camera->getViewport()->getArea();
+		mPickingDrawHelper->clear();
 
-		gCoreAccessor().queueCommand(std::bind(&GizmoManagerCore::renderIconGizmos,
-			core, screenArea, iconMesh->getCore(), iconRenderData, true));
+		for (auto& hit : hits)
+			output.push_back(hit);
+	}
 
-		mPickingDrawHelper->clearMeshes(meshes);
-		mIconMeshHeap->dealloc(iconMesh);
+	float GizmoManager::getWorldPixelSize(const SPtr<Camera>& camera, float distance)
+	{
+		// Note: Must match the camera scale used when building the icon mesh
+		if (camera->getProjectionType() == PT_ORTHOGRAPHIC)
+			return camera->getOrthoWindowHeight() / camera->getViewport()->getHeight();
+
+		Radian vertFOV(Math::tan(camera->getHorzFOV() * 0.5f));
+		float cameraScale = (camera->getViewport()->getHeight() * 0.5f) / vertFOV.valueRadians();
+
+		return distance / cameraScale;
 	}
 
 	void GizmoManager::clearGizmos()
@@ -707,6 +985,8 @@ namespace BansheeEngine
 			mIconMeshHeap->dealloc(mIconMesh);
 
 		mIconMesh = nullptr;
+		mIconRenderData = nullptr;
+		mIconMeshHash = 0;
 
 		GizmoManagerCore* core = mCore.load(std::memory_order_relaxed);
 		IconRenderDataVecPtr iconRenderData = bs_shared_ptr_new<IconRenderDataVec>();
@@ -715,6 +995,42 @@ namespace BansheeEngine
 			nullptr, Vector<GizmoManagerCore::MeshData>(), nullptr, iconRenderData));
 	}
 
+	size_t GizmoManager::calculateIconHash(const SPtr<Camera>& camera, const Vector<IconData>& iconData) const
+	{
+		size_t hash = 0;
+
+		const Matrix4& view = camera->getViewMatrix();
+		const Matrix4& proj = camera->getProjectionMatrixRS();
+		for (UINT32 i = 0; i < 4; i++)
+		{
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				hash_combine(hash, view[i][j]);
+				hash_combine(hash, proj[i][j]);
+			}
+		}
+
+		Rect2I viewportArea = camera->getViewport()->getArea();
+		hash_combine(hash, viewportArea.x);
+		hash_combine(hash, viewportArea.y);
+		hash_combine(hash, viewportArea.width);
+		hash_combine(hash, viewportArea.height);
+
+		hash_combine(hash, iconData.size());
+		for (auto& iconEntry : iconData)
+		{
+			hash_combine(hash, iconEntry.position.x);
+			hash_combine(hash, iconEntry.position.y);
+			hash_combine(hash, iconEntry.position.z);
+			hash_combine(hash, iconEntry.color);
+			hash_combine(hash, iconEntry.fixedScale);
+			hash_combine(hash, iconEntry.texture.getHandleData().get());
+			hash_combine(hash, iconEntry.texture.isLoaded());
+		}
+
+		return hash;
+	}
+
 	SPtr<TransientMesh> GizmoManager::buildIconMesh(const SPtr<Camera>& camera, const Vector<IconData>& iconData,
 		bool forPicking, GizmoManager::IconRenderDataVecPtr& iconRenderData)
 	{
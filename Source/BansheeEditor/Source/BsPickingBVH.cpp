@@ -0,0 +1,284 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsPickingBVH.h"
+#include "BsMeshData.h"
+#include "BsPlane.h"
+#include "BsMath.h"
+
+namespace BansheeEngine
+{
+	const UINT32 PickingBVH::MAX_LEAF_SIZE = 4;
+
+	void PickingBVH::build(const Vector<AABox>& bounds)
+	{
+		mNodes.clear();
+		mIndices.clear();
+
+		UINT32 numPrimitives = (UINT32)bounds.size();
+		if (numPrimitives == 0)
+			return;
+
+		Vector<Vector3> centers(numPrimitives);
+		mIndices.resize(numPrimitives);
+		for (UINT32 i = 0; i < numPrimitives; i++)
+		{
+			centers[i] = bounds[i].getCenter();
+			mIndices[i] = i;
+		}
+
+		mNodes.reserve((numPrimitives / MAX_LEAF_SIZE + 1) * 2);
+		buildNode(bounds, centers, 0, numPrimitives);
+	}
+
+	UINT32 PickingBVH::buildNode(const Vector<AABox>& bounds, const Vector<Vector3>& centers, UINT32 start, UINT32 count)
+	{
+		Vector3 min = bounds[mIndices[start]].getMin();
+		Vector3 max = bounds[mIndices[start]].getMax();
+		Vector3 centerMin = centers[mIndices[start]];
+		Vector3 centerMax = centerMin;
+
+		for (UINT32 i = start + 1; i < start + count; i++)
+		{
+			const AABox& primBounds = bounds[mIndices[i]];
+			min = Vector3::min(min, primBounds.getMin());
+			max = Vector3::max(max, primBounds.getMax());
+
+			centerMin = Vector3::min(centerMin, centers[mIndices[i]]);
+			centerMax = Vector3::max(centerMax, centers[mIndices[i]]);
+		}
+
+		UINT32 nodeIdx = (UINT32)mNodes.size();
+		mNodes.push_back(Node());
+		mNodes[nodeIdx].min = min;
+		mNodes[nodeIdx].max = max;
+
+		if (count <= MAX_LEAF_SIZE)
+		{
+			mNodes[nodeIdx].start = start;
+			mNodes[nodeIdx].count = count;
+
+			return nodeIdx;
+		}
+
+		// Split at the median along the axis where the primitive centers are spread the most. Median split keeps the
+		// tree balanced, so its depth is bounded by log2 of the primitive count.
+		Vector3 extent = centerMax - centerMin;
+		UINT32 axis = 0;
+		if (extent.y > extent.x)
+			axis = 1;
+
+		if (extent.z > extent[axis])
+			axis = 2;
+
+		UINT32 half = count / 2;
+		auto begin = mIndices.begin() + start;
+		std::nth_element(begin, begin + half, begin + count,
+			[&](UINT32 a, UINT32 b) { return centers[a][axis] < centers[b][axis]; });
+
+		buildNode(bounds, centers, start, half);
+		UINT32 secondChildIdx = buildNode(bounds, centers, start + half, count - half);
+
+		mNodes[nodeIdx].start = secondChildIdx;
+		mNodes[nodeIdx].count = 0;
+
+		return nodeIdx;
+	}
+
+	MeshPickingData::MeshPickingData(const SPtr<MeshData>& meshData, const Vector<SubMesh>& subMeshes)
+		:mMeshData(meshData), mSubMeshes(subMeshes), mIsBuilt(false)
+	{ }
+
+	void MeshPickingData::build()
+	{
+		if (mIsBuilt)
+			return;
+
+		UINT32 numVertices = mMeshData->getNumVertices();
+		Vector<Vector3> positions(numVertices);
+
+		auto positionIter = mMeshData->getVec3DataIter(VES_POSITION);
+		for (UINT32 i = 0; i < numVertices; i++)
+		{
+			positions[i] = positionIter.getValue();
+			positionIter.moveNext();
+		}
+
+		UINT32* indices32 = nullptr;
+		UINT16* indices16 = nullptr;
+		if (mMeshData->getIndexType() == IT_32BIT)
+			indices32 = mMeshData->getIndices32();
+		else
+			indices16 = mMeshData->getIndices16();
+
+		UINT32 numIndices = mMeshData->getNumIndices();
+		auto getIndex = [&](UINT32 idx)
+		{
+			return indices32 != nullptr ? indices32[idx] : (UINT32)indices16[idx];
+		};
+
+		UINT32 subMeshIdx = 0;
+		auto addTriangle = [&](UINT32 a, UINT32 b, UINT32 c)
+		{
+			if (a >= numVertices || b >= numVertices || c >= numVertices)
+				return;
+
+			mVertices.push_back(positions[a]);
+			mVertices.push_back(positions[b]);
+			mVertices.push_back(positions[c]);
+			mTriangleSubMeshes.push_back(subMeshIdx);
+		};
+
+		for (; subMeshIdx < (UINT32)mSubMeshes.size(); subMeshIdx++)
+		{
+			const SubMesh& subMesh = mSubMeshes[subMeshIdx];
+
+			UINT32 start = subMesh.indexOffset;
+			UINT32 end = std::min(subMesh.indexOffset + subMesh.indexCount, numIndices);
+
+			switch (subMesh.drawOp)
+			{
+			case DOT_TRIANGLE_LIST:
+				for (UINT32 i = start; (i + 2) < end; i += 3)
+					addTriangle(getIndex(i), getIndex(i + 1), getIndex(i + 2));
+				break;
+			case DOT_TRIANGLE_STRIP:
+				for (UINT32 i = start + 2; i < end; i++)
+					addTriangle(getIndex(i - 2), getIndex(i - 1), getIndex(i));
+				break;
+			case DOT_TRIANGLE_FAN:
+				for (UINT32 i = start + 2; i < end; i++)
+					addTriangle(getIndex(start), getIndex(i - 1), getIndex(i));
+				break;
+			default:
+				break;
+			}
+		}
+
+		UINT32 numTriangles = getNumTriangles();
+		Vector<AABox> bounds(numTriangles);
+		for (UINT32 i = 0; i < numTriangles; i++)
+		{
+			const Vector3* triangle = &mVertices[i * 3];
+
+			Vector3 min = Vector3::min(Vector3::min(triangle[0], triangle[1]), triangle[2]);
+			Vector3 max = Vector3::max(Vector3::max(triangle[0], triangle[1]), triangle[2]);
+			bounds[i] = AABox(min, max);
+		}
+
+		mBVH.build(bounds);
+
+		// Triangles are all we need from now on
+		mMeshData = nullptr;
+		mIsBuilt = true;
+	}
+
+	bool MeshPickingData::intersects(const Ray& ray, float& distance) const
+	{
+		return intersects(ray, Vector<CullingMode>(), distance);
+	}
+
+	bool MeshPickingData::intersects(const Ray& ray, const Vector<CullingMode>& cullModes, float& distance) const
+	{
+		const Vector3& origin = ray.getOrigin();
+		const Vector3& direction = ray.getDirection();
+
+		bool hit = false;
+		float closest = std::numeric_limits<float>::max();
+
+		mBVH.intersects(ray, closest, [&](UINT32 triangleIdx, float& curClosest)
+		{
+			// Moller-Trumbore
+			const Vector3* triangle = &mVertices[triangleIdx * 3];
+
+			Vector3 edge1 = triangle[1] - triangle[0];
+			Vector3 edge2 = triangle[2] - triangle[0];
+
+			Vector3 p = direction.cross(edge2);
+			float det = edge1.dot(p);
+			if (Math::abs(det) < 1e-12f)
+				return;
+
+			// Determinant is the negated dot product of the ray direction and the triangle normal
+			if (isCulled(cullModes, mTriangleSubMeshes[triangleIdx], det))
+				return;
+
+			float invDet = 1.0f / det;
+			Vector3 s = origin - triangle[0];
+
+			float u = s.dot(p) * invDet;
+			if (u < 0.0f || u > 1.0f)
+				return;
+
+			Vector3 q = s.cross(edge1);
+			float v = direction.dot(q) * invDet;
+			if (v < 0.0f || (u + v) > 1.0f)
+				return;
+
+			float t = edge2.dot(q) * invDet;
+			if (t >= 0.0f && t < curClosest)
+			{
+				curClosest = t;
+				hit = true;
+			}
+		});
+
+		if (hit)
+			distance = closest;
+
+		return hit;
+	}
+
+	bool MeshPickingData::intersects(const ConvexVolume& volume) const
+	{
+		return intersects(volume, Vector<CullingMode>(), Vector4::ZERO);
+	}
+
+	bool MeshPickingData::intersects(const ConvexVolume& volume, const Vector<CullingMode>& cullModes, 
+		const Vector4& viewPoint) const
+	{
+		Vector<Plane> planes = volume.getPlanes();
+		Vector3 viewPos(viewPoint.x, viewPoint.y, viewPoint.z);
+
+		return mBVH.intersects(volume, [&](UINT32 triangleIdx)
+		{
+			const Vector3* triangle = &mVertices[triangleIdx * 3];
+
+			// Triangle is outside if all of its vertices are behind any single plane
+			for (auto& plane : planes)
+			{
+				if (triangle[0].dot(plane.normal) < plane.d &&
+					triangle[1].dot(plane.normal) < plane.d &&
+					triangle[2].dot(plane.normal) < plane.d)
+					return false;
+			}
+
+			if (!cullModes.empty())
+			{
+				Vector3 normal = (triangle[1] - triangle[0]).cross(triangle[2] - triangle[0]);
+				Vector3 toViewer = viewPos - triangle[0] * viewPoint.w;
+
+				if (isCulled(cullModes, mTriangleSubMeshes[triangleIdx], normal.dot(toViewer)))
+					return false;
+			}
+
+			return true;
+		});
+	}
+
+	bool MeshPickingData::isCulled(const Vector<CullingMode>& cullModes, UINT32 subMeshIdx, float facing)
+	{
+		if (subMeshIdx >= (UINT32)cullModes.size())
+			return false;
+
+		// Triangles facing the viewer appear counter-clockwise
+		switch (cullModes[subMeshIdx])
+		{
+		case CULL_CLOCKWISE:
+			return facing < 0.0f;
+		case CULL_COUNTERCLOCKWISE:
+			return facing > 0.0f;
+		default:
+			return false;
+		}
+	}
+}
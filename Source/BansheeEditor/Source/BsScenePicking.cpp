@@ -26,14 +26,21 @@
 #include "BsCoreRenderer.h"
 #include "BsGizmoManager.h"
 #include "BsRendererUtility.h"
+#include "BsPickingBVH.h"
+#include "BsMeshData.h"
+#include "BsTaskScheduler.h"
+#include "BsRay.h"
+#include "BsPlane.h"
 
 using namespace std::placeholders;
 
 namespace BansheeEngine
 {
 	const float ScenePickingCore::ALPHA_CUTOFF = 0.5f;
+	const UINT32 ScenePicking::MIN_ITEMS_PER_TASK = 8;
 
 	ScenePicking::ScenePicking()
+		:mMode(ScenePickingMode::GPU)
 	{
 		mCore = bs_new<ScenePickingCore>();
 
@@ -64,6 +71,369 @@ namespace BansheeEngine
 	}
 
 	Vector<HSceneObject> ScenePicking::pickObjects(const SPtr<Camera>& cam, const Vector2I& position, const Vector2I& area)
+	{
+		if (mMode == ScenePickingMode::GPU)
+			return pickObjectsGPU(cam, position, area);
+
+		if (area.x <= 1 && area.y <= 1)
+		{
+			Ray ray = cam->screenPointToRay(position);
+			return pickObjectsCPU(cam, &ray, nullptr);
+		}
+
+		ConvexVolume volume = getPickVolume(cam, position, area);
+		return pickObjectsCPU(cam, nullptr, &volume);
+	}
+
+	Vector<HSceneObject> ScenePicking::pickObjects(const SPtr<Camera>& cam, const Ray& ray)
+	{
+		return pickObjectsCPU(cam, &ray, nullptr);
+	}
+
+	Vector<HSceneObject> ScenePicking::pickObjects(const SPtr<Camera>& cam, const ConvexVolume& volume)
+	{
+		return pickObjectsCPU(cam, nullptr, &volume);
+	}
+
+	void ScenePicking::clearCache()
+	{
+		mMeshCache.clear();
+	}
+
+	Vector<HSceneObject> ScenePicking::pickObjectsCPU(const SPtr<Camera>& cam, const Ray* ray, const ConvexVolume* volume)
+	{
+		const Map<Renderable*, SceneRenderableData>& renderables = SceneManager::instance().getAllRenderables();
+		UINT64 cameraLayers = cam->getLayers();
+
+		Vector<PickCandidate> objects;
+		Vector<HMesh> objectMeshes;
+		Vector<AABox> objectBounds;
+		for (auto& renderableData : renderables)
+		{
+			SPtr<Renderable> renderable = renderableData.second.renderable;
+			HSceneObject so = renderableData.second.sceneObject;
+
+			if (!so->getActive() || (renderable->getLayer() & cameraLayers) == 0)
+				continue;
+
+			HMesh mesh = renderable->getMesh();
+			if (!mesh.isLoaded())
+				continue;
+
+			Matrix4 worldTransform = so->getWorldTfrm();
+			Bounds worldBounds = mesh->getProperties().getBounds();
+			worldBounds.transformAffine(worldTransform);
+
+			objects.push_back(PickCandidate());
+			PickCandidate& object = objects.back();
+			object.sceneObject = so;
+			object.worldTransform = worldTransform;
+			object.worldBounds = worldBounds.getBox();
+			object.distance = std::numeric_limits<float>::max();
+
+			// Mirroring transforms reverse the winding order the triangles are rasterized with
+			bool mirrored = worldTransform.determinant3x3() < 0.0f;
+
+			UINT32 numSubMeshes = mesh->getProperties().getNumSubMeshes();
+			object.cullModes.resize(numSubMeshes);
+			for (UINT32 i = 0; i < numSubMeshes; i++)
+			{
+				CullingMode cullMode = getCullMode(renderable->getMaterial(i));
+				if (mirrored && cullMode != CULL_NONE)
+					cullMode = cullMode == CULL_CLOCKWISE ? CULL_COUNTERCLOCKWISE : CULL_CLOCKWISE;
+
+				object.cullModes[i] = cullMode;
+			}
+
+			objectMeshes.push_back(mesh);
+			objectBounds.push_back(worldBounds.getBox());
+		}
+
+		// Broad phase, find all objects whose bounds pass the test
+		PickingBVH sceneBVH;
+		sceneBVH.build(objectBounds);
+
+		Vector<UINT32> candidateIndices;
+		if (ray != nullptr)
+		{
+			float closest = std::numeric_limits<float>::max();
+			sceneBVH.intersects(*ray, closest, [&](UINT32 idx, float& curClosest)
+			{
+				// Don't lower the closest distance since we want all the objects along the ray
+				if (objects[idx].worldBounds.intersects(*ray).first)
+					candidateIndices.push_back(idx);
+			});
+		}
+		else
+		{
+			sceneBVH.intersects(*volume, [&](UINT32 idx)
+			{
+				if (volume->intersects(objects[idx].worldBounds))
+					candidateIndices.push_back(idx);
+
+				return false;
+			});
+		}
+
+		Vector<HMesh> candidateMeshes(candidateIndices.size());
+		for (UINT32 i = 0; i < (UINT32)candidateIndices.size(); i++)
+			candidateMeshes[i] = objectMeshes[candidateIndices[i]];
+
+		Vector<SPtr<MeshPickingData>> candidateData = getMeshPickingData(candidateMeshes);
+
+		// Narrow phase, test the actual mesh triangles in parallel
+		Vector<PickCandidate> candidates(candidateIndices.size());
+		for (UINT32 i = 0; i < (UINT32)candidateIndices.size(); i++)
+		{
+			candidates[i] = objects[candidateIndices[i]];
+			candidates[i].data = candidateData[i];
+		}
+
+		Vector3 cameraPos = cam->getPosition();
+
+		// Homogeneous view point used for culling area picks, orthographic cameras view from infinitely far away
+		Vector4 viewPoint;
+		if (cam->getProjectionType() == PT_ORTHOGRAPHIC)
+		{
+			Vector3 toViewer = -cam->getForward();
+			viewPoint = Vector4(toViewer.x, toViewer.y, toViewer.z, 0.0f);
+		}
+		else
+			viewPoint = Vector4(cameraPos.x, cameraPos.y, cameraPos.z, 1.0f);
+
+		UINT32 numCandidates = (UINT32)candidates.size();
+		UINT32 numTasks = TaskScheduler::getNumTasks(numCandidates, MIN_ITEMS_PER_TASK);
+		TaskScheduler::runParallel("ScenePicking", numCandidates, numTasks, [&](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i++)
+			{
+				PickCandidate& candidate = candidates[i];
+				if (candidate.data == nullptr)
+					continue;
+
+				Matrix4 invWorldTransform = candidate.worldTransform.inverseAffine();
+				if (ray != nullptr)
+				{
+					Ray localRay = *ray;
+					localRay.transformAffine(invWorldTransform);
+
+					float localDistance;
+					if (candidate.data->intersects(localRay, candidate.cullModes, localDistance))
+					{
+						Vector3 hitPoint = candidate.worldTransform.multiplyAffine(localRay.getPoint(localDistance));
+						candidate.distance = hitPoint.distance(ray->getOrigin());
+					}
+				}
+				else
+				{
+					ConvexVolume localVolume = toLocalVolume(*volume, candidate.worldTransform);
+					Vector4 localViewPoint = invWorldTransform.multiplyAffine(viewPoint);
+
+					if (candidate.data->intersects(localVolume, candidate.cullModes, localViewPoint))
+						candidate.distance = candidate.worldBounds.getCenter().distance(cameraPos);
+				}
+			}
+		});
+
+		struct PickResult
+		{
+			HSceneObject sceneObject;
+			float distance;
+		};
+
+		Vector<PickResult> hits;
+		for (auto& candidate : candidates)
+		{
+			if (candidate.distance != std::numeric_limits<float>::max())
+				hits.push_back({ candidate.sceneObject, candidate.distance });
+		}
+
+		Vector<std::pair<UINT32, float>> gizmoHits;
+		if (ray != nullptr)
+			GizmoManager::instance().pickGizmos(cam, *ray, gizmoHits);
+		else
+			GizmoManager::instance().pickGizmos(cam, *volume, gizmoHits);
+
+		for (auto& gizmoHit : gizmoHits)
+		{
+			HSceneObject so = GizmoManager::instance().getSceneObject(gizmoHit.first);
+			if (so)
+				hits.push_back({ so, gizmoHit.second });
+		}
+
+		std::sort(hits.begin(), hits.end(), 
+			[](const PickResult& a, const PickResult& b) { return a.distance < b.distance; });
+
+		Vector<HSceneObject> results;
+		UnorderedSet<UINT64> foundObjects;
+		for (auto& hit : hits)
+		{
+			if (foundObjects.insert(hit.sceneObject->getInstanceId()).second)
+				results.push_back(hit.sceneObject);
+		}
+
+		return results;
+	}
+
+	CullingMode ScenePicking::getCullMode(const HMaterial& material)
+	{
+		// Note: We only ever check the first pass, same as when rendering for picking
+		if (material == nullptr || material->getNumPasses() == 0)
+			return RasterizerState::getDefault()->getProperties().getCullMode();
+
+		SPtr<RasterizerState> rasterizerState = material->getPass(0)->getRasterizerState();
+		if (rasterizerState == nullptr)
+			rasterizerState = RasterizerState::getDefault();
+
+		return rasterizerState->getProperties().getCullMode();
+	}
+
+	Vector<SPtr<MeshPickingData>> ScenePicking::getMeshPickingData(const Vector<HMesh>& meshes)
+	{
+		// Forget data for meshes that no longer exist
+		for (auto iter = mMeshCache.begin(); iter != mMeshCache.end();)
+		{
+			if (iter->second.mesh.expired())
+				iter = mMeshCache.erase(iter);
+			else
+				++iter;
+		}
+
+		Vector<SPtr<MeshPickingData>> output(meshes.size());
+		Vector<SPtr<MeshPickingData>> newData;
+		bool readFromGPU = false;
+
+		for (UINT32 i = 0; i < (UINT32)meshes.size(); i++)
+		{
+			const HMesh& mesh = meshes[i];
+			UINT64 meshId = mesh->getInternalID();
+
+			// Data is rebuilt if the mesh contents changed since it was built
+			auto iterFind = mMeshCache.find(meshId);
+			if (iterFind != mMeshCache.end() && iterFind->second.contentVersion == mesh->getContentVersion())
+			{
+				output[i] = iterFind->second.data;
+				continue;
+			}
+
+			const MeshProperties& props = mesh->getProperties();
+
+			Vector<SubMesh> subMeshes(props.getNumSubMeshes());
+			for (UINT32 j = 0; j < props.getNumSubMeshes(); j++)
+				subMeshes[j] = props.getSubMesh(j);
+
+			SPtr<MeshData> meshData = mesh->allocateSubresourceBuffer(0);
+			if ((mesh->getUsage() & MU_CPUCACHED) != 0)
+				mesh->readData(*meshData);
+			else
+			{
+				// Only happens once per mesh contents as the result is cached
+				mesh->readSubresource(gCoreAccessor(), 0, meshData);
+				readFromGPU = true;
+			}
+
+			SPtr<MeshPickingData> data = bs_shared_ptr_new<MeshPickingData>(meshData, subMeshes);
+
+			MeshCacheEntry& entry = mMeshCache[meshId];
+			entry.mesh = mesh.getInternalPtr();
+			entry.data = data;
+			entry.contentVersion = mesh->getContentVersion();
+
+			output[i] = data;
+			newData.push_back(data);
+		}
+
+		if (readFromGPU)
+			gCoreAccessor().submitToCoreThread(true);
+
+		UINT32 numNewData = (UINT32)newData.size();
+		UINT32 numTasks = TaskScheduler::getNumTasks(numNewData, MIN_ITEMS_PER_TASK);
+		TaskScheduler::runParallel("ScenePicking", numNewData, numTasks, [&](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i++)
+				newData[i]->build();
+		});
+
+		return output;
+	}
+
+	ConvexVolume ScenePicking::getPickVolume(const SPtr<Camera>& cam, const Vector2I& position, const Vector2I& area)
+	{
+		Vector2I screenCorners[4] = 
+		{
+			Vector2I(position.x, position.y),
+			Vector2I(position.x + area.x, position.y),
+			Vector2I(position.x + area.x, position.y + area.y),
+			Vector2I(position.x, position.y + area.y)
+		};
+
+		float nearDist = cam->getNearClipDistance();
+		float farDist = cam->getFarClipDistance();
+
+		Vector3 nearCorners[4];
+		Vector3 farCorners[4];
+		Vector3 center = Vector3::ZERO;
+		for (UINT32 i = 0; i < 4; i++)
+		{
+			Vector2 ndcPoint = cam->screenToNdcPoint(screenCorners[i]);
+
+			nearCorners[i] = cam->ndcToWorldPoint(ndcPoint, nearDist);
+			farCorners[i] = cam->ndcToWorldPoint(ndcPoint, farDist);
+
+			center += nearCorners[i] + farCorners[i];
+		}
+
+		center /= 8.0f;
+
+		// Planes are oriented so the volume is on their positive side
+		auto createPlane = [&](const Vector3& a, const Vector3& b, const Vector3& c)
+		{
+			Vector3 normal = Vector3::normalize((b - a).cross(c - a));
+			float d = normal.dot(a);
+
+			if (normal.dot(center) < d)
+			{
+				normal = -normal;
+				d = -d;
+			}
+
+			return Plane(normal.x, normal.y, normal.z, d);
+		};
+
+		Vector<Plane> planes;
+		for (UINT32 i = 0; i < 4; i++)
+			planes.push_back(createPlane(nearCorners[i], nearCorners[(i + 1) % 4], farCorners[i]));
+
+		planes.push_back(createPlane(nearCorners[0], nearCorners[1], nearCorners[2]));
+		planes.push_back(createPlane(farCorners[0], farCorners[1], farCorners[2]));
+
+		return ConvexVolume(planes);
+	}
+
+	ConvexVolume ScenePicking::toLocalVolume(const ConvexVolume& volume, const Matrix4& worldTransform)
+	{
+		// For a point transformed by an affine matrix (A, t): n.(A * p + t) - d = (A^T * n).p - (d - n.t)
+		Vector3 translation(worldTransform[0][3], worldTransform[1][3], worldTransform[2][3]);
+
+		Vector<Plane> planes = volume.getPlanes();
+		for (auto& plane : planes)
+		{
+			Vector3 normal;
+			for (UINT32 i = 0; i < 3; i++)
+			{
+				normal[i] = worldTransform[0][i] * plane.normal.x + worldTransform[1][i] * plane.normal.y + 
+					worldTransform[2][i] * plane.normal.z;
+			}
+
+			plane.d -= plane.normal.dot(translation);
+			plane.normal = normal;
+		}
+
+		return ConvexVolume(planes);
+	}
+
+	Vector<HSceneObject> ScenePicking::pickObjectsGPU(const SPtr<Camera>& cam, const Vector2I& position, 
+		const Vector2I& area)
 	{
 		auto comparePickElement = [&] (const ScenePicking::RenderablePickData& a, const ScenePicking::RenderablePickData& b)
 		{
@@ -84,13 +454,14 @@ namespace BansheeEngine
 		const Map<Renderable*, SceneRenderableData>& renderables = SceneManager::instance().getAllRenderables();
 		RenderableSet pickData(comparePickElement);
 		Map<UINT32, HSceneObject> idxToRenderable;
+		UINT64 cameraLayers = cam->getLayers();
 
 		for (auto& renderableData : renderables)
 		{
 			SPtr<Renderable> renderable = renderableData.second.renderable;
 			HSceneObject so = renderableData.second.sceneObject;
 
-			if (!so->getActive())
+			if (!so->getActive() || (renderable->getLayer() & cameraLayers) == 0)
 				continue;
 
 			HMesh mesh = renderable->getMesh();
@@ -114,23 +485,15 @@ namespace BansheeEngine
 						UINT32 idx = (UINT32)pickData.size();
 
 						bool useAlphaShader = false;
-						SPtr<RasterizerState> rasterizerState;
 
 						HMaterial originalMat = renderable->getMaterial(i);
 						if (originalMat != nullptr && originalMat->getNumPasses() > 0)
 						{
 							SPtr<Pass> firstPass = originalMat->getPass(0); // Note: We only ever check the first pass, problem?
 							useAlphaShader = firstPass->hasBlending();
-
-							if (firstPass->getRasterizerState() == nullptr)
-								rasterizerState = RasterizerState::getDefault();
-							else
-								rasterizerState = firstPass->getRasterizerState();
 						}
-						else
-							rasterizerState = RasterizerState::getDefault();
 
-						CullingMode cullMode = rasterizerState->getProperties().getCullMode();
+						CullingMode cullMode = getCullMode(originalMat);
 
 						HTexture mainTexture;
 						if (useAlphaShader)
@@ -9,7 +9,7 @@ namespace BansheeEngine
 
 	UndoRedo::UndoRedo()
 		: mUndoStack(nullptr), mRedoStack(nullptr), mUndoStackPtr(0), mUndoNumElements(0), mRedoStackPtr(0)
-		, mRedoNumElements(0), mNextCommandId(0)
+		, mRedoNumElements(0), mNextCommandId(0), mMemoryBudget(0)
 	{
 		mUndoStack = bs_newN<EditorCommand*>(MAX_STACK_ELEMENTS);
 		mRedoStack = bs_newN<EditorCommand*>(MAX_STACK_ELEMENTS);
@@ -90,6 +90,7 @@ namespace BansheeEngine
 		addToUndoStack(command);
 
 		clearRedoStack();
+		enforceMemoryBudget();
 	}
 
 	UINT32 UndoRedo::getTopCommandId() const
@@ -149,6 +150,14 @@ namespace BansheeEngine
 	{
 		clearUndoStack();
 		clearRedoStack();
+
+		mStateStorage.clear();
+	}
+
+	void UndoRedo::setMemoryBudget(UINT64 budget)
+	{
+		mMemoryBudget = budget;
+		enforceMemoryBudget();
 	}
 
 	EditorCommand* UndoRedo::removeLastFromUndoStack()
@@ -212,4 +221,21 @@ namespace BansheeEngine
 			EditorCommand::destroy(command);
 		}
 	}
+
+	void UndoRedo::enforceMemoryBudget()
+	{
+		// Groups track the number of their most recent entries, so don't touch the stack while they're active
+		if (mMemoryBudget == 0 || !mGroups.empty())
+			return;
+
+		// Always keep the most recent command, even if it alone exceeds the budget
+		while (mStateStorage.getMemoryUsage() > mMemoryBudget && mUndoNumElements > 1)
+		{
+			UINT32 oldestPtr = (mUndoStackPtr + MAX_STACK_ELEMENTS + 1 - mUndoNumElements) % MAX_STACK_ELEMENTS;
+			EditorCommand* command = mUndoStack[oldestPtr];
+			mUndoNumElements--;
+
+			EditorCommand::destroy(command);
+		}
+	}
 }
\ No newline at end of file
@@ -0,0 +1,434 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsUndoStateStorage.h"
+
+namespace BansheeEngine
+{
+	/** Delta operation that copies a range of bytes from the original data. */
+	static const UINT8 DELTA_OP_COPY = 0;
+
+	/** Delta operation that inserts a range of bytes stored in the delta itself. */
+	static const UINT8 DELTA_OP_INSERT = 1;
+
+	/** Size of a delta operation header: operation type, followed by offset (copy) or unused (insert), and length. */
+	static const UINT32 DELTA_OP_SIZE = sizeof(UINT8) + sizeof(UINT32) * 2;
+
+	/** Minimum number of equal bytes required before they are copied from the original instead of being inserted. */
+	static const UINT32 DELTA_MIN_COPY = 16;
+
+	static const UINT32 COMPRESS_MIN_MATCH = 4;
+	static const UINT32 COMPRESS_MAX_MATCH = 0x7F + COMPRESS_MIN_MATCH;
+	static const UINT32 COMPRESS_MAX_LITERALS = 0x80;
+	static const UINT32 COMPRESS_MAX_DISTANCE = 0xFFFF;
+	static const UINT32 COMPRESS_HASH_BITS = 14;
+
+	UndoStateBaseline::~UndoStateBaseline()
+	{
+		storage->mMemoryUsage -= dataSize;
+		bs_free(data);
+	}
+
+	UndoState::UndoState(UndoStateStorage* storage)
+		:mStorage(storage), mData(nullptr), mDataSize(0), mDeltaSize(0), mSize(0), mCompressed(false)
+	{ }
+
+	UndoState::~UndoState()
+	{
+		if (mData != nullptr)
+		{
+			mStorage->mMemoryUsage -= mDataSize;
+			bs_free(mData);
+		}
+	}
+
+	UndoStateStorage::UndoStateStorage()
+		:mMode(UndoStorageMode::Delta), mCompressionEnabled(false), mMemoryUsage(0)
+	{ }
+
+	UndoStateStorage::~UndoStateStorage()
+	{
+		clear();
+	}
+
+	SPtr<UndoState> UndoStateStorage::store(UINT64 key, UINT8* data, UINT32 size)
+	{
+		SPtr<UndoState> state = bs_shared_ptr<UndoState>(new (bs_alloc<UndoState>()) UndoState(this));
+		state->mSize = size;
+
+		if (mMode == UndoStorageMode::Full)
+		{
+			state->mBaseline = createBaseline(data, size);
+			return state;
+		}
+
+		SPtr<UndoStateBaseline> baseline;
+
+		auto iterFind = mBaselines.find(key);
+		if (iterFind != mBaselines.end())
+		{
+			baseline = iterFind->second.lock();
+			if (baseline == nullptr)
+				mBaselines.erase(iterFind);
+		}
+
+		if (baseline != nullptr)
+		{
+			UINT8* baselineBuffer = nullptr;
+			const UINT8* baselineData = getBaselineData(*baseline, baselineBuffer);
+
+			// Only worth keeping the delta if it's considerably smaller than the data, otherwise start a new baseline
+			UINT32 deltaSize = 0;
+			UINT8* delta = generateDelta(baselineData, baseline->size, data, size, size / 2, deltaSize);
+
+			if (baselineBuffer != nullptr)
+				bs_free(baselineBuffer);
+
+			if (delta != nullptr)
+			{
+				bs_free(data);
+
+				state->mBaseline = baseline;
+				state->mDeltaSize = deltaSize;
+
+				UINT32 compressedSize = 0;
+				UINT8* compressed = mCompressionEnabled ? compress(delta, deltaSize, compressedSize) : nullptr;
+				if (compressed != nullptr)
+				{
+					bs_free(delta);
+
+					state->mData = compressed;
+					state->mDataSize = compressedSize;
+					state->mCompressed = true;
+				}
+				else
+				{
+					state->mData = delta;
+					state->mDataSize = deltaSize;
+				}
+
+				mMemoryUsage += state->mDataSize;
+				return state;
+			}
+		}
+
+		baseline = createBaseline(data, size);
+		mBaselines[key] = baseline;
+
+		state->mBaseline = baseline;
+		return state;
+	}
+
+	UINT8* UndoStateStorage::load(const SPtr<UndoState>& state, UINT32& size) const
+	{
+		size = state->mSize;
+		UINT8* output = (UINT8*)bs_alloc(size);
+
+		UINT8* baselineBuffer = nullptr;
+		const UINT8* baselineData = getBaselineData(*state->mBaseline, baselineBuffer);
+
+		if (state->mData == nullptr)
+			memcpy(output, baselineData, size);
+		else
+		{
+			if (state->mCompressed)
+			{
+				UINT8* delta = (UINT8*)bs_alloc(state->mDeltaSize);
+				decompress(state->mData, state->mDataSize, delta, state->mDeltaSize);
+				applyDelta(baselineData, delta, state->mDeltaSize, output);
+
+				bs_free(delta);
+			}
+			else
+				applyDelta(baselineData, state->mData, state->mDeltaSize, output);
+		}
+
+		if (baselineBuffer != nullptr)
+			bs_free(baselineBuffer);
+
+		return output;
+	}
+
+	void UndoStateStorage::clear()
+	{
+		mBaselines.clear();
+	}
+
+	SPtr<UndoStateBaseline> UndoStateStorage::createBaseline(UINT8* data, UINT32 size)
+	{
+		SPtr<UndoStateBaseline> baseline = bs_shared_ptr_new<UndoStateBaseline>();
+		baseline->storage = this;
+		baseline->size = size;
+
+		UINT32 compressedSize = 0;
+		UINT8* compressed = mCompressionEnabled ? compress(data, size, compressedSize) : nullptr;
+		if (compressed != nullptr)
+		{
+			bs_free(data);
+
+			baseline->data = compressed;
+			baseline->dataSize = compressedSize;
+			baseline->compressed = true;
+		}
+		else
+		{
+			baseline->data = data;
+			baseline->dataSize = size;
+			baseline->compressed = false;
+		}
+
+		mMemoryUsage += baseline->dataSize;
+		return baseline;
+	}
+
+	const UINT8* UndoStateStorage::getBaselineData(const UndoStateBaseline& baseline, UINT8*& buffer)
+	{
+		if (!baseline.compressed)
+		{
+			buffer = nullptr;
+			return baseline.data;
+		}
+
+		buffer = (UINT8*)bs_alloc(baseline.size);
+		decompress(baseline.data, baseline.dataSize, buffer, baseline.size);
+
+		return buffer;
+	}
+
+	UINT8* UndoStateStorage::generateDelta(const UINT8* orgData, UINT32 orgSize, const UINT8* newData, UINT32 newSize,
+		UINT32 maxSize, UINT32& deltaSize)
+	{
+		struct DeltaOp
+		{
+			UINT8 type;
+			UINT32 offset;
+			UINT32 length;
+		};
+
+		Vector<DeltaOp> ops;
+		if (orgSize == newSize)
+		{
+			// Data most likely has the same layout (e.g. only some values changed), compare byte by byte and record the
+			// modified ranges. Short ranges of unmodified bytes are merged into the modified ranges as copying them would
+			// cost more than storing them directly.
+			UINT32 i = 0;
+			while (i < newSize)
+			{
+				UINT32 start = i;
+				while (i < newSize && orgData[i] == newData[i])
+					i++;
+
+				if (i > start)
+					ops.push_back({ DELTA_OP_COPY, start, i - start });
+
+				start = i;
+				while (i < newSize)
+				{
+					if (orgData[i] != newData[i])
+					{
+						i++;
+						continue;
+					}
+
+					UINT32 end = i;
+					while (end < newSize && (end - i) < DELTA_MIN_COPY && orgData[end] == newData[end])
+						end++;
+
+					if ((end - i) >= DELTA_MIN_COPY || end == newSize)
+						break;
+
+					i = end;
+				}
+
+				if (i > start)
+					ops.push_back({ DELTA_OP_INSERT, start, i - start });
+			}
+		}
+		else
+		{
+			// Data layout changed, store everything between the common prefix and suffix
+			UINT32 minSize = std::min(orgSize, newSize);
+
+			UINT32 prefix = 0;
+			while (prefix < minSize && orgData[prefix] == newData[prefix])
+				prefix++;
+
+			UINT32 suffix = 0;
+			while (suffix < (minSize - prefix) && orgData[orgSize - suffix - 1] == newData[newSize - suffix - 1])
+				suffix++;
+
+			if (prefix > 0)
+				ops.push_back({ DELTA_OP_COPY, 0, prefix });
+
+			if (newSize > (prefix + suffix))
+				ops.push_back({ DELTA_OP_INSERT, prefix, newSize - prefix - suffix });
+
+			if (suffix > 0)
+				ops.push_back({ DELTA_OP_COPY, orgSize - suffix, suffix });
+		}
+
+		deltaSize = 0;
+		for (auto& op : ops)
+		{
+			deltaSize += DELTA_OP_SIZE;
+
+			if (op.type == DELTA_OP_INSERT)
+				deltaSize += op.length;
+		}
+
+		if (deltaSize > maxSize)
+			return nullptr;
+
+		UINT8* delta = (UINT8*)bs_alloc(std::max(deltaSize, 1U));
+		UINT8* dst = delta;
+		for (auto& op : ops)
+		{
+			// Insert operations take their data from the new buffer, so the offset is irrelevant when applying
+			*dst = op.type;
+			memcpy(dst + 1, &op.offset, sizeof(op.offset));
+			memcpy(dst + 1 + sizeof(op.offset), &op.length, sizeof(op.length));
+			dst += DELTA_OP_SIZE;
+
+			if (op.type == DELTA_OP_INSERT)
+			{
+				memcpy(dst, newData + op.offset, op.length);
+				dst += op.length;
+			}
+		}
+
+		return delta;
+	}
+
+	void UndoStateStorage::applyDelta(const UINT8* orgData, const UINT8* delta, UINT32 deltaSize, UINT8* output)
+	{
+		const UINT8* src = delta;
+		const UINT8* srcEnd = delta + deltaSize;
+		while (src < srcEnd)
+		{
+			UINT8 type = *src;
+
+			UINT32 offset;
+			UINT32 length;
+			memcpy(&offset, src + 1, sizeof(offset));
+			memcpy(&length, src + 1 + sizeof(offset), sizeof(length));
+			src += DELTA_OP_SIZE;
+
+			if (type == DELTA_OP_COPY)
+				memcpy(output, orgData + offset, length);
+			else
+			{
+				memcpy(output, src, length);
+				src += length;
+			}
+
+			output += length;
+		}
+	}
+
+	UINT8* UndoStateStorage::compress(const UINT8* data, UINT32 size, UINT32& compressedSize)
+	{
+		// Simple LZ77 style compressor. Output consists of literal runs (control byte < 0x80, followed by up to 128
+		// bytes) and back-references (control byte >= 0x80 encoding the length, followed by a 16-bit distance).
+		if (size < COMPRESS_MIN_MATCH)
+			return nullptr;
+
+		UINT8* output = (UINT8*)bs_alloc(size);
+		UINT32 outPos = 0;
+
+		Vector<UINT32> hashTable(1 << COMPRESS_HASH_BITS, (UINT32)-1);
+
+		auto writeLiterals = [&](UINT32 start, UINT32 end)
+		{
+			while (start < end)
+			{
+				UINT32 count = std::min(end - start, COMPRESS_MAX_LITERALS);
+				if ((outPos + 1 + count) > size)
+					return false;
+
+				output[outPos++] = (UINT8)(count - 1);
+				memcpy(output + outPos, data + start, count);
+
+				outPos += count;
+				start += count;
+			}
+
+			return true;
+		};
+
+		UINT32 literalStart = 0;
+		UINT32 i = 0;
+		while ((i + COMPRESS_MIN_MATCH) <= size)
+		{
+			UINT32 sequence;
+			memcpy(&sequence, data + i, sizeof(sequence));
+
+			UINT32 hash = (sequence * 2654435761U) >> (32 - COMPRESS_HASH_BITS);
+			UINT32 candidate = hashTable[hash];
+			hashTable[hash] = i;
+
+			if (candidate == (UINT32)-1 || (i - candidate) > COMPRESS_MAX_DISTANCE ||
+				memcmp(data + candidate, data + i, COMPRESS_MIN_MATCH) != 0)
+			{
+				i++;
+				continue;
+			}
+
+			UINT32 length = COMPRESS_MIN_MATCH;
+			while (length < COMPRESS_MAX_MATCH && (i + length) < size && data[candidate + length] == data[i + length])
+				length++;
+
+			if (!writeLiterals(literalStart, i) || (outPos + 3) > size)
+			{
+				bs_free(output);
+				return nullptr;
+			}
+
+			UINT32 distance = i - candidate;
+			output[outPos++] = (UINT8)(0x80 | (length - COMPRESS_MIN_MATCH));
+			output[outPos++] = (UINT8)(distance & 0xFF);
+			output[outPos++] = (UINT8)(distance >> 8);
+
+			i += length;
+			literalStart = i;
+		}
+
+		if (!writeLiterals(literalStart, size) || outPos >= size)
+		{
+			bs_free(output);
+			return nullptr;
+		}
+
+		compressedSize = outPos;
+		return output;
+	}
+
+	void UndoStateStorage::decompress(const UINT8* data, UINT32 dataSize, UINT8* output, UINT32 size)
+	{
+		UINT32 inPos = 0;
+		UINT32 outPos = 0;
+		while (inPos < dataSize && outPos < size)
+		{
+			UINT8 control = data[inPos++];
+			if (control < 0x80)
+			{
+				UINT32 count = control + 1;
+				memcpy(output + outPos, data + inPos, count);
+
+				inPos += count;
+				outPos += count;
+			}
+			else
+			{
+				UINT32 length = (control & 0x7F) + COMPRESS_MIN_MATCH;
+				UINT32 distance = data[inPos] | (data[inPos + 1] << 8);
+				inPos += 2;
+
+				// Source and destination may overlap, so copy byte by byte
+				const UINT8* src = output + outPos - distance;
+				for (UINT32 i = 0; i < length; i++)
+					output[outPos + i] = src[i];
+
+				outPos += length;
+			}
+		}
+	}
+}
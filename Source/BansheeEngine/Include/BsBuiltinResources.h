@@ -84,6 +84,12 @@ namespace BansheeEngine
 		/**	Returns a shader used for rendering only a diffuse texture. */
 		HShader getDiffuseShader() const { return mShaderDiffuse; }
 
+		/**	
+		 * Returns a shader used for rendering only a diffuse texture, that allows objects sharing a mesh and a material 
+		 * to be rendered using a single instanced draw call, on render APIs that support it.
+		 */
+		HShader getDiffuseInstancedShader() const { return mShaderDiffuseInstanced; }
+
 		/**	Creates material used for textual sprite rendering (for example text in GUI). */
 		HMaterial createSpriteTextMaterial() const;
 
@@ -166,6 +172,7 @@ namespace BansheeEngine
 		HShader mShaderSpriteImage;
 		HShader mShaderSpriteNonAlphaImage;
 		HShader mShaderDiffuse;
+		HShader mShaderDiffuseInstanced;
 
 		SPtr<ResourceManifest> mResourceManifest;
 
@@ -293,6 +300,7 @@ namespace BansheeEngine
 		static const WString ShaderSpriteImageAlphaFile;
 		static const WString ShaderSpriteImageNoAlphaFile;
 		static const WString ShaderDiffuseFile;
+		static const WString ShaderDiffuseInstancedFile;
 
 		static const WString MeshSphereFile;
 		static const WString MeshBoxFile;
@@ -41,6 +41,14 @@ namespace BansheeEngine
 			HTexture texture;
 		};
 
+		/**	Container for CPU-side geometry of a specific type output by the DrawHelper. */
+		struct ShapeMeshRawData
+		{
+			SPtr<MeshData> meshData;
+			MeshType type;
+			HTexture texture;
+		};
+
 		DrawHelper();
 		~DrawHelper();
 
@@ -134,6 +142,45 @@ namespace BansheeEngine
 		void buildMeshes(SortType sorting = SortType::None, const Vector3& reference = Vector3::ZERO, 
 			UINT64 layers = 0xFFFFFFFFFFFFFFFF);
 
+		/**
+		 * Generates geometry for all the recorded solid and wireframe shapes, same as buildMeshes(), but doesn't create
+		 * any GPU meshes. Useful when the geometry needs to be processed on the CPU (e.g. for picking).
+		 *
+		 * @param	sorting		Determines how (and if) should elements be sorted based on their distance from the 
+		 *						reference point.
+		 * @param	reference	Reference point to use for determining distance when sorting.
+		 * @param	layers		Layers bitfield that can be used for controlling which shapes will be included in the 
+		 *						output. This bitfield will be ANDed with the layer specified when recording the shape.
+		 * @param	output		Output list of generated geometry, one entry per batch.
+		 */
+		void buildMeshData(SortType sorting, const Vector3& reference, UINT64 layers, Vector<ShapeMeshRawData>& output);
+
+		/**
+		 * Checks would a call to buildMeshes() with the provided parameters generate the same meshes as the last call, 
+		 * which is the case if the same shapes were recorded since, and either the reference point didn't change or none
+		 * of the meshes depend on it. If so the caller can keep using the previously built meshes instead of clearing and
+		 * rebuilding them.
+		 *
+		 * @see		buildMeshes
+		 */
+		bool canReuseMeshes(SortType sorting = SortType::None, const Vector3& reference = Vector3::ZERO, 
+			UINT64 layers = 0xFFFFFFFFFFFFFFFF) const;
+
+		/**
+		 * Checks would a call to buildMeshes() with the provided parameters generate the same meshes as the last call,
+		 * ignoring the meshes that depend on the reference point (transparent shapes that need to be sorted, and text 
+		 * which always faces the reference point). If so only those meshes need to be regenerated, using 
+		 * rebuildViewDependentMeshes().
+		 */
+		bool canReuseStaticMeshes(SortType sorting = SortType::None, UINT64 layers = 0xFFFFFFFFFFFFFFFF) const;
+
+		/**
+		 * Regenerates the meshes built by the last call to buildMeshes() that depend on the reference point, using a new 
+		 * reference point. Other meshes are kept as is. The replaced meshes are deallocated and the new set of meshes can
+		 * be retrieved through getMeshes().
+		 */
+		void rebuildViewDependentMeshes(const Vector3& reference);
+
 		/** Returns a set of meshes that were built using the last call to buildMeshes(). */
 		const Vector<ShapeMeshData>& getMeshes() const { return mMeshes; }
 
@@ -228,6 +275,59 @@ namespace BansheeEngine
 			SPtr<MeshData> meshData;
 		};
 
+		/** Types of shapes whose geometry is generated from a shared canonical mesh. */
+		enum class ShapeTemplateType
+		{
+			SolidCube, WireCube, SolidSphere, WireSphere
+		};
+
+		/** Types of recorded shapes. */
+		enum class ShapeType
+		{
+			Cube, Sphere, WireCube, WireSphere, WireCone, Line, LineList, Frustum, 
+			Cone, Disc, WireDisc, Arc, WireArc, Rectangle, Text, WireMesh
+		};
+
+		/** Determines which of the recorded shapes to generate the geometry for. */
+		enum class ShapeGroup
+		{
+			All, /**< All shapes. */
+			Static, /**< Shapes whose geometry and order don't depend on the reference point. */
+			ViewDependent /**< Transparent shapes that need to be sorted, and text which faces the reference point. */
+		};
+
+		/** 
+		 * Same as buildMeshData(SortType, const Vector3&, UINT64, Vector<ShapeMeshRawData>&), except it only generates 
+		 * geometry for the specified group of shapes.
+		 */
+		void buildMeshData(SortType sorting, const Vector3& reference, UINT64 layers, ShapeGroup group, 
+			Vector<ShapeMeshRawData>& output);
+
+		/** Allocates meshes for the provided geometry and appends them to the list of built meshes. */
+		void allocateMeshes(const Vector<ShapeMeshRawData>& rawMeshes);
+
+		/** Releases the provided meshes back to their mesh heaps. */
+		void freeMeshes(const Vector<ShapeMeshData>& meshes);
+
+		/** Combines the type of a newly recorded shape and its common properties into the hash of recorded shapes. */
+		void hashCommon(ShapeType type, const CommonData& data);
+
+		/** Combines a vector into the hash of recorded shapes. */
+		void hashVector(const Vector3& value);
+
+		/**
+		 * Returns a canonical mesh of the specified shape, centered at origin and with unit radius/extents. Canonical 
+		 * meshes are generated on first use and shared by all shapes of the same type and quality.
+		 */
+		const SPtr<MeshData>& getShapeTemplate(ShapeTemplateType type, UINT32 quality);
+
+		/**
+		 * Writes the geometry of a shape into the provided mesh data by scaling and offsetting its canonical mesh, 
+		 * avoiding the cost of generating the shape from scratch.
+		 */
+		void writeShapeTemplate(ShapeTemplateType type, UINT32 quality, const Vector3& position, const Vector3& scale,
+			const SPtr<MeshData>& meshData, UINT32 vertexOffset, UINT32 indexOffset);
+
 		static const UINT32 VERTEX_BUFFER_GROWTH;
 		static const UINT32 INDEX_BUFFER_GROWTH;
 
@@ -252,8 +352,18 @@ namespace BansheeEngine
 		Vector<Text2DData> mText2DData;
 		Vector<WireMeshData> mWireMeshData;
 
+		size_t mShapesHash;
+
 		Vector<ShapeMeshData> mMeshes;
 		UINT32 mNumActiveMeshes;
+		UINT32 mNumStaticMeshes;
+		size_t mMeshesHash;
+		SortType mMeshesSorting;
+		UINT64 mMeshesLayers;
+		Vector3 mMeshesReference;
+		bool mMeshesValid;
+
+		UnorderedMap<UINT32, SPtr<MeshData>> mShapeTemplates;
 
 		SPtr<MeshHeap> mSolidMeshHeap;
 		SPtr<MeshHeap> mWireMeshHeap;
@@ -39,7 +39,9 @@ namespace BansheeEngine
 			GUIElem_HiddenSelf = 0x08,
 			GUIElem_InactiveSelf = 0x10,
 			GUIElem_Disabled = 0x20,
-			GUIElem_DisabledSelf = 0x40
+			GUIElem_DisabledSelf = 0x40,
+			GUIElem_SizeRangeDirty = 0x80,
+			GUIElem_LayoutDeferred = 0x100
 		};
 
 	public:
@@ -141,7 +143,10 @@ namespace BansheeEngine
 		 */
 		virtual void _updateLayout(const GUILayoutData& data);
 
-		/** Calculates optimal sizes of all child elements, as determined by their style and layout options. */
+		/**
+		 * Calculates optimal sizes of all child elements, as determined by their style and layout options. Only elements
+		 * whose size ranges were invalidated since the last call are recalculated.
+		 */
 		virtual void _updateOptimalLayoutSizes();
 
 		/** @copydoc _updateLayout */
@@ -282,6 +287,18 @@ namespace BansheeEngine
 		/**	Returns true if elements contents have changed since last update. */
 		bool _isDirty() const { return (mFlags & GUIElem_Dirty) != 0; }
 
+		/**
+		 * Returns true if the element was entirely clipped during the last layout update, and layout of its children was
+		 * skipped because of it.
+		 */
+		bool _isLayoutDeferred() const { return (mFlags & GUIElem_LayoutDeferred) != 0; }
+
+		/**
+		 * Marks the layout of the element's children as deferred or not. Deferred layout will be updated when the
+		 * element's children bounds are requested, or during the next layout update where the element is not clipped.
+		 */
+		void _setLayoutDeferred(bool deferred);
+
 		/**	Marks the element contents to be up to date (meaning it's processed by the GUI system). */
 		void _markAsClean();
 
@@ -294,6 +311,15 @@ namespace BansheeEngine
 		/**	Refreshes update parents of all child elements. */
 		void refreshChildUpdateParents();
 
+		/**
+		 * Marks the cached size range of this element, and of all of its parents, as dirty, so they are recalculated on
+		 * the next call to _updateOptimalLayoutSizes().
+		 */
+		void markSizeRangeDirty();
+
+		/** Updates the layout of any parent whose child layout was deferred, so this element's layout data is up to date. */
+		void updateDeferredLayout();
+
 		/**
 		 * Finds the first parent element whose size doesn't depend on child sizes.
 		 *			
@@ -321,7 +347,7 @@ namespace BansheeEngine
 		GUIElementBase* mParentElement;
 
 		Vector<GUIElementBase*> mChildren;	
-		UINT8 mFlags;
+		UINT16 mFlags;
 
 		GUIDimensions mDimensions;
 		GUILayoutData mLayoutData;
@@ -0,0 +1,78 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsPrerequisites.h"
+#include "BsVector2I.h"
+
+namespace BansheeEngine
+{
+	/** @addtogroup GUI-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Uniform grid of GUI element bounds, used for quickly finding the elements under a point without testing every
+	 * element in a widget. Elements are only re-inserted into the grid when their bounds change.
+	 */
+	class BS_EXPORT GUIElementGrid
+	{
+	public:
+		/**
+		 * Queues the element to be inserted into the grid, or to have its position in the grid updated. Must be called
+		 * whenever the clipped bounds of the element change.
+		 */
+		void markDirty(GUIElement* element);
+
+		/** Removes the element from the grid. */
+		void remove(GUIElement* element);
+
+		/** Removes all elements from the grid. */
+		void clear();
+
+		/**
+		 * Finds all visible elements under the provided position.
+		 *
+		 * @param[in]	position	Position relative to the parent widget.
+		 * @param[out]	output		List the found elements will be appended to, in no particular order.
+		 */
+		void find(const Vector2I& position, Vector<GUIElement*>& output);
+
+	private:
+		/** Range of cells occupied by an element, inclusive. */
+		struct CellRange
+		{
+			INT32 minX, minY;
+			INT32 maxX, maxY;
+			bool isLarge; /**< True if the element is too large to be stored in cells. */
+		};
+
+		/** Size of a single grid cell, in pixels. */
+		static const INT32 CELL_SIZE = 64;
+
+		/**
+		 * Maximum number of cells an element can occupy. Larger elements (e.g. backgrounds and containers) are kept in a
+		 * separate list and tested for every query, rather than being inserted into a large number of cells.
+		 */
+		static const INT32 MAX_CELLS_PER_ELEMENT = 32;
+
+		/** Inserts all elements queued by markDirty() into the grid, using their current bounds. */
+		void update();
+
+		/** Removes the element from all cells in the provided range. */
+		void removeFromCells(GUIElement* element, const CellRange& range);
+
+		/** Returns the index of the cell containing the provided coordinate. */
+		static INT32 getCell(INT32 coord);
+
+		/** Returns a key identifying the cell with the specified index. */
+		static UINT64 getCellKey(INT32 x, INT32 y) { return ((UINT64)(UINT32)x << 32) | (UINT32)y; }
+
+		UnorderedMap<UINT64, Vector<GUIElement*>> mCells;
+		UnorderedMap<GUIElement*, CellRange> mElements;
+		Vector<GUIElement*> mLargeElements;
+		UnorderedSet<GUIElement*> mDirtyElements;
+	};
+
+	/** @} */
+}
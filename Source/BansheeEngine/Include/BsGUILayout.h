@@ -85,6 +85,17 @@ namespace BansheeEngine
 		/** @copydoc GUIElementBase::_getType */
 		virtual Type _getType() const override { return GUIElementBase::Type::Layout; }
 
+		/**
+		 * Assigns the specified layout information to a child element and updates the layout of its children. If the
+		 * child is entirely clipped by this layout, and was clipped during the last update as well, layout of its
+		 * children is deferred until the child becomes visible.
+		 *
+		 * @param[in]	element		Child element to update.
+		 * @param[in]	data		Layout data to assign. Clip rectangle is expected to be the clip rectangle of this
+		 *							layout, and is clipped to the child area before being assigned.
+		 */
+		void _updateChildLayout(GUIElementBase* element, const GUILayoutData& data);
+
 		/** @} */
 
 	protected:
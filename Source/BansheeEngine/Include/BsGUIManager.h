@@ -351,6 +351,7 @@ namespace BansheeEngine
 		// Element and widget pointer is currently over
 		Vector<ElementInfoUnderPointer> mElementsUnderPointer;
 		Vector<ElementInfoUnderPointer> mNewElementsUnderPointer;
+		Vector<GUIElement*> mElementsAtPointer;
 
 		// Element and widget that's being clicked on
 		GUIMouseButton mActiveMouseButton;
@@ -99,9 +99,6 @@ namespace BansheeEngine
 		 */
 		LayoutSizeRange _getElementSizeRange(const GUIElementBase* element) const;
 
-		/** Assigns the specified layout information to a child element of a GUI panel. */
-		void _updateChildLayout(GUIElementBase* element, const GUILayoutData& data);
-
 		/** @copydoc GUIElementBase::_updateLayoutInternal */
 		void _updateLayoutInternal(const GUILayoutData& data) override;
 
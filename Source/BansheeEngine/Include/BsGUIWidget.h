@@ -8,6 +8,7 @@
 #include "BsQuaternion.h"
 #include "BsMatrix4.h"
 #include "BsEvent.h"
+#include "BsGUIElementGrid.h"
 
 namespace BansheeEngine
 {
@@ -125,6 +126,17 @@ namespace BansheeEngine
 		 */
 		void _markContentDirty(GUIElementBase* elem);
 
+		/** Notifies the widget that the clipped bounds of one of its elements changed. */
+		void _markBoundsDirty(GUIElementBase* elem);
+
+		/**
+		 * Finds all visible elements under the provided position.
+		 *
+		 * @param[in]	position	Position relative to the widget.
+		 * @param[out]	output		List the found elements will be appended to, in no particular order.
+		 */
+		void _findElements(const Vector2I& position, Vector<GUIElement*>& output);
+
 		/**	Updates the layout of all child elements, repositioning and resizing them as needed. */
 		void _updateLayout();
 
@@ -193,6 +205,7 @@ namespace BansheeEngine
 		HEvent mOwnerTargetResizedConn;
 
 		Set<GUIElement*> mDirtyContents;
+		GUIElementGrid mElementGrid;
 
 		mutable UINT64 mCachedRTId;
 		mutable bool mWidgetIsDirty;
@@ -149,6 +149,14 @@ namespace BansheeEngine
 	 *  @{
 	 */
 
+	/** Transform of a single renderable, sent to the core thread as part of a batched transform update. */
+	struct RenderableTransformUpdate
+	{
+		SPtr<RenderableCore> renderable;
+		Matrix4 transform;
+		Matrix4 transformNoScale;
+	};
+
 	/** @copydoc TRenderable */
 	class BS_EXPORT RenderableCore : public CoreObjectCore, public TRenderable<true>
 	{
@@ -167,6 +175,9 @@ namespace BansheeEngine
 		/**	Retrieves an ID that can be used for uniquely identifying this handler by the renderer. */
 		UINT32 getRendererId() const { return mRendererId; }
 
+		/** Applies a batch of transform updates queued by Renderable::_syncTransforms(). */
+		static void _updateTransforms(const SPtr<Vector<RenderableTransformUpdate>>& updates);
+
 	protected:
 		friend class Renderable;
 
@@ -197,6 +208,20 @@ namespace BansheeEngine
 		/**	Sets the hash value that can be used to identify if the internal data needs an update. */
 		void _setLastModifiedHash(UINT32 hash) { mLastUpdateHash = hash; }
 
+		/**
+		 * Sets the transform matrix that is applied to the object when its being rendered. Unlike setTransform() this
+		 * doesn't mark the object for a full core thread sync, and instead appends the transform to the provided batch.
+		 * The batch must then be sent to the core thread by calling _syncTransforms().
+		 */
+		void _setTransform(const Matrix4& transform, const Matrix4& transformNoScale, 
+			Vector<RenderableTransformUpdate>& batch);
+
+		/** 
+		 * Sends all transforms in the provided batch to the core thread as a single command, and clears the batch. 
+		 * Should be called before the dirty core objects are synced for the frame.
+		 */
+		static void _syncTransforms(Vector<RenderableTransformUpdate>& batch);
+
 		/**	Creates a new renderable handler instance. */
 		static SPtr<Renderable> create();
 
@@ -11,6 +11,15 @@ namespace BansheeEngine
 	 *  @{
 	 */
 
+	/** New world transform of a single renderable, as provided to Renderer::notifyRenderableTransformsUpdated(). */
+	struct RenderableTransform
+	{
+		RenderableCore* renderable;
+		UINT32 rendererId;
+		Matrix4 transform;
+		Matrix4 transformNoScale;
+	};
+
 	/** @copydoc CoreRenderer */
 	class BS_EXPORT Renderer : public CoreRenderer
 	{
@@ -31,6 +40,15 @@ namespace BansheeEngine
 		 */
 		virtual void notifyRenderableUpdated(RenderableCore* renderable) { }
 
+		/**
+		 * Called whenever transforms of one or multiple renderables are updated, and nothing else about them changed. 
+		 * Transforms are provided in a contiguous array so the renderer may process them in a single pass. Default 
+		 * implementation calls notifyRenderableUpdated() for each entry.
+		 *
+		 * @note	Core thread.
+		 */
+		virtual void notifyRenderableTransformsUpdated(const Vector<RenderableTransform>& transforms);
+
 		/**
 		 * Called whenever a renderable is destroyed.
 		 *
@@ -4,6 +4,7 @@
 
 #include "BsPrerequisites.h"
 #include "BsCoreSceneManager.h"
+#include "BsRenderable.h"
 
 namespace BansheeEngine
 {
@@ -14,40 +15,49 @@ namespace BansheeEngine
 	/**	Contains information about a camera managed by the scene manager. */
 	struct SceneCameraData
 	{
-		SceneCameraData() { }
+		SceneCameraData()
+			:sceneObjectPtr(nullptr)
+		{ }
 
 		SceneCameraData(const SPtr<Camera>& camera, const HSceneObject& sceneObject)
-			:camera(camera), sceneObject(sceneObject)
+			:camera(camera), sceneObject(sceneObject), sceneObjectPtr(sceneObject.get())
 		{ }
 
 		SPtr<Camera> camera;
 		HSceneObject sceneObject;
+		SceneObject* sceneObjectPtr; /**< Lookup key only, as the scene object might have been destroyed. */
 	};
 
 	/**	Contains information about a renderable managed by the scene manager. */
 	struct SceneRenderableData
 	{
-		SceneRenderableData() { }
+		SceneRenderableData()
+			:sceneObjectPtr(nullptr)
+		{ }
 
 		SceneRenderableData(const SPtr<Renderable>& renderable, const HSceneObject& sceneObject)
-			:renderable(renderable), sceneObject(sceneObject)
+			:renderable(renderable), sceneObject(sceneObject), sceneObjectPtr(sceneObject.get())
 		{ }
 
 		SPtr<Renderable> renderable;
 		HSceneObject sceneObject;
+		SceneObject* sceneObjectPtr; /**< Lookup key only, as the scene object might have been destroyed. */
 	};
 
 	/**	Contains information about a light managed by the scene manager. */
 	struct SceneLightData
 	{
-		SceneLightData() { }
+		SceneLightData()
+			:sceneObjectPtr(nullptr)
+		{ }
 
 		SceneLightData(const SPtr<Light>& light, const HSceneObject& sceneObject)
-			:light(light), sceneObject(sceneObject)
+			:light(light), sceneObject(sceneObject), sceneObjectPtr(sceneObject.get())
 		{ }
 
 		SPtr<Light> light;
 		HSceneObject sceneObject;
+		SceneObject* sceneObjectPtr; /**< Lookup key only, as the scene object might have been destroyed. */
 	};
 
 	/** Manages active SceneObjects and provides ways for querying and updating them or their components. */
@@ -127,6 +137,12 @@ namespace BansheeEngine
 		Map<Renderable*, SceneRenderableData> mRenderables;
 		Map<Light*, SceneLightData> mLights;
 		Vector<SceneCameraData> mMainCameras;
+
+		UnorderedMultimap<SceneObject*, Renderable*> mRenderablesBySO;
+		UnorderedMultimap<SceneObject*, Camera*> mCamerasBySO;
+		UnorderedMultimap<SceneObject*, Light*> mLightsBySO;
+		Vector<RenderableTransformUpdate> mTransformBatch;
+
 		SPtr<RenderTarget> mMainRT;
 
 		HEvent mMainRTResizedConn;
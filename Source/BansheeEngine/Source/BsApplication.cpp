@@ -19,6 +19,7 @@
 #include "BsRendererMaterialManager.h"
 #include "BsPlatform.h"
 #include "BsEngineShaderIncludeHandler.h"
+#include "BsGpuProgramManager.h"
 
 namespace BansheeEngine
 {
@@ -68,6 +69,9 @@ namespace BansheeEngine
 		PlainTextImporter* importer = bs_new<PlainTextImporter>();
 		Importer::instance()._registerAssetImporter(importer);
 
+		// Keep compiled GPU programs between runs, so builtin and user shaders don't need to be recompiled every time
+		GpuProgramCoreManager::instance().setCacheFolder(Paths::getRuntimeDataPath() + "Cache\\GpuPrograms\\");
+
 		VirtualInput::startUp();
 		BuiltinResources::startUp();
 		RendererMaterialManager::startUp();
@@ -160,6 +160,7 @@ namespace BansheeEngine
 	const WString BuiltinResources::ShaderSpriteImageAlphaFile = L"SpriteImageAlpha.bsl";
 	const WString BuiltinResources::ShaderSpriteImageNoAlphaFile = L"SpriteImageNoAlpha.bsl";
 	const WString BuiltinResources::ShaderDiffuseFile = L"Diffuse.bsl";
+	const WString BuiltinResources::ShaderDiffuseInstancedFile = L"DiffuseInstanced.bsl";
 
 	/************************************************************************/
 	/* 								MESHES							  		*/
@@ -249,6 +250,7 @@ namespace BansheeEngine
 		mShaderSpriteImage = getShader(ShaderSpriteImageAlphaFile);
 		mShaderSpriteNonAlphaImage = getShader(ShaderSpriteImageNoAlphaFile);
 		mShaderDiffuse = getShader(ShaderDiffuseFile);
+		mShaderDiffuseInstanced = getShader(ShaderDiffuseInstancedFile);
 
 		SPtr<PixelData> dummyPixelData = PixelData::create(2, 2, 1, PF_R8G8B8A8);
 
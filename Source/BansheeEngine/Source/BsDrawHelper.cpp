@@ -17,7 +17,8 @@ namespace BansheeEngine
 	const UINT32 DrawHelper::INDEX_BUFFER_GROWTH = 4096 * 2;
 
 	DrawHelper::DrawHelper()
-		:mLayer(1), mNumActiveMeshes(0)
+		:mLayer(1), mShapesHash(0), mNumActiveMeshes(0), mNumStaticMeshes(0), mMeshesHash(0), 
+		mMeshesSorting(SortType::None), mMeshesLayers(0), mMeshesValid(false)
 	{
 		mTransform = Matrix4::IDENTITY;
 
@@ -76,6 +77,10 @@ namespace BansheeEngine
 		cubeData.transform = mTransform;
 		cubeData.layer = mLayer;
 		cubeData.center = mTransform.multiplyAffine(position);
+
+		hashCommon(ShapeType::Cube, cubeData);
+		hashVector(position);
+		hashVector(extents);
 	}
 
 	void DrawHelper::sphere(const Vector3& position, float radius, UINT32 quality)
@@ -90,6 +95,11 @@ namespace BansheeEngine
 		sphereData.transform = mTransform;
 		sphereData.layer = mLayer;
 		sphereData.center = mTransform.multiplyAffine(position);
+
+		hashCommon(ShapeType::Sphere, sphereData);
+		hashVector(position);
+		hash_combine(mShapesHash, radius);
+		hash_combine(mShapesHash, quality);
 	}
 
 	void DrawHelper::wireCube(const Vector3& position, const Vector3& extents)
@@ -103,6 +113,10 @@ namespace BansheeEngine
 		cubeData.transform = mTransform;
 		cubeData.layer = mLayer;
 		cubeData.center = mTransform.multiplyAffine(position);
+
+		hashCommon(ShapeType::WireCube, cubeData);
+		hashVector(position);
+		hashVector(extents);
 	}
 
 	void DrawHelper::wireSphere(const Vector3& position, float radius, UINT32 quality)
@@ -117,6 +131,11 @@ namespace BansheeEngine
 		sphereData.transform = mTransform;
 		sphereData.layer = mLayer;
 		sphereData.center = mTransform.multiplyAffine(position);
+
+		hashCommon(ShapeType::WireSphere, sphereData);
+		hashVector(position);
+		hash_combine(mShapesHash, radius);
+		hash_combine(mShapesHash, quality);
 	}
 
 	void DrawHelper::line(const Vector3& start, const Vector3& end)
@@ -130,6 +149,10 @@ namespace BansheeEngine
 		lineData.transform = mTransform;
 		lineData.layer = mLayer;
 		lineData.center = mTransform.multiplyAffine((start + end) * 0.5f);
+
+		hashCommon(ShapeType::Line, lineData);
+		hashVector(start);
+		hashVector(end);
 	}
 
 	void DrawHelper::lineList(const Vector<Vector3>& lines)
@@ -149,6 +172,11 @@ namespace BansheeEngine
 		lineListData.transform = mTransform;
 		lineListData.layer = mLayer;
 		lineListData.center = center / (float)lines.size();;
+
+		hashCommon(ShapeType::LineList, lineListData);
+		hash_combine(mShapesHash, lines.size());
+		for (auto& point : lines)
+			hashVector(point);
 	}
 
 	void DrawHelper::frustum(const Vector3& position, float aspect, Degree FOV, float near, float far)
@@ -165,6 +193,13 @@ namespace BansheeEngine
 		frustumData.transform = mTransform;
 		frustumData.layer = mLayer;
 		frustumData.center = mTransform.multiplyAffine(position);
+
+		hashCommon(ShapeType::Frustum, frustumData);
+		hashVector(position);
+		hash_combine(mShapesHash, aspect);
+		hash_combine(mShapesHash, FOV.valueDegrees());
+		hash_combine(mShapesHash, near);
+		hash_combine(mShapesHash, far);
 	}
 
 	void DrawHelper::cone(const Vector3& base, const Vector3& normal, float height, float radius, const Vector2& scale, 
@@ -183,6 +218,15 @@ namespace BansheeEngine
 		coneData.transform = mTransform;
 		coneData.layer = mLayer;
 		coneData.center = mTransform.multiplyAffine(base + normal * height * 0.5f);
+
+		hashCommon(ShapeType::Cone, coneData);
+		hashVector(base);
+		hashVector(normal);
+		hash_combine(mShapesHash, height);
+		hash_combine(mShapesHash, radius);
+		hash_combine(mShapesHash, scale.x);
+		hash_combine(mShapesHash, scale.y);
+		hash_combine(mShapesHash, quality);
 	}
 
 	void DrawHelper::wireCone(const Vector3& base, const Vector3& normal, float height, float radius, const Vector2& scale,
@@ -201,6 +245,15 @@ namespace BansheeEngine
 		coneData.transform = mTransform;
 		coneData.layer = mLayer;
 		coneData.center = mTransform.multiplyAffine(base + normal * height * 0.5f);
+
+		hashCommon(ShapeType::WireCone, coneData);
+		hashVector(base);
+		hashVector(normal);
+		hash_combine(mShapesHash, height);
+		hash_combine(mShapesHash, radius);
+		hash_combine(mShapesHash, scale.x);
+		hash_combine(mShapesHash, scale.y);
+		hash_combine(mShapesHash, quality);
 	}
 
 	void DrawHelper::disc(const Vector3& position, const Vector3& normal, float radius, UINT32 quality)
@@ -216,6 +269,12 @@ namespace BansheeEngine
 		discData.transform = mTransform;
 		discData.layer = mLayer;
 		discData.center = mTransform.multiplyAffine(position);
+
+		hashCommon(ShapeType::Disc, discData);
+		hashVector(position);
+		hashVector(normal);
+		hash_combine(mShapesHash, radius);
+		hash_combine(mShapesHash, quality);
 	}
 
 	void DrawHelper::wireDisc(const Vector3& position, const Vector3& normal, float radius, UINT32 quality)
@@ -231,6 +290,12 @@ namespace BansheeEngine
 		discData.transform = mTransform;
 		discData.layer = mLayer;
 		discData.center = mTransform.multiplyAffine(position);
+
+		hashCommon(ShapeType::WireDisc, discData);
+		hashVector(position);
+		hashVector(normal);
+		hash_combine(mShapesHash, radius);
+		hash_combine(mShapesHash, quality);
 	}
 
 	void DrawHelper::arc(const Vector3& position, const Vector3& normal, float radius, 
@@ -249,6 +314,14 @@ namespace BansheeEngine
 		arcData.transform = mTransform;
 		arcData.layer = mLayer;
 		arcData.center = mTransform.multiplyAffine(position);
+
+		hashCommon(ShapeType::Arc, arcData);
+		hashVector(position);
+		hashVector(normal);
+		hash_combine(mShapesHash, radius);
+		hash_combine(mShapesHash, startAngle.valueDegrees());
+		hash_combine(mShapesHash, amountAngle.valueDegrees());
+		hash_combine(mShapesHash, quality);
 	}
 
 	void DrawHelper::wireArc(const Vector3& position, const Vector3& normal, float radius, 
@@ -267,6 +340,14 @@ namespace BansheeEngine
 		arcData.transform = mTransform;
 		arcData.layer = mLayer;
 		arcData.center = mTransform.multiplyAffine(position);
+
+		hashCommon(ShapeType::WireArc, arcData);
+		hashVector(position);
+		hashVector(normal);
+		hash_combine(mShapesHash, radius);
+		hash_combine(mShapesHash, startAngle.valueDegrees());
+		hash_combine(mShapesHash, amountAngle.valueDegrees());
+		hash_combine(mShapesHash, quality);
 	}
 
 	void DrawHelper::rectangle(const Rect3& area)
@@ -279,6 +360,13 @@ namespace BansheeEngine
 		rectData.transform = mTransform;
 		rectData.layer = mLayer;
 		rectData.center = mTransform.multiplyAffine(area.getCenter());
+
+		hashCommon(ShapeType::Rectangle, rectData);
+		hashVector(area.getCenter());
+		hashVector(area.getAxisHorz());
+		hashVector(area.getAxisVert());
+		hash_combine(mShapesHash, area.getExtentHorz());
+		hash_combine(mShapesHash, area.getExtentVertical());
 	}
 
 	void DrawHelper::text(const Vector3& position, const WString& text, const HFont& font, UINT32 size)
@@ -297,6 +385,12 @@ namespace BansheeEngine
 		textData.text = text;
 		textData.font = font;
 		textData.size = size;
+
+		hashCommon(ShapeType::Text, textData);
+		hashVector(position);
+		hash_combine(mShapesHash, text);
+		hash_combine(mShapesHash, font.getHandleData().get());
+		hash_combine(mShapesHash, size);
 	}
 
 	void DrawHelper::wireMesh(const SPtr<MeshData>& meshData)
@@ -312,6 +406,14 @@ namespace BansheeEngine
 		wireMeshData.transform = mTransform;
 		wireMeshData.layer = mLayer;
 		wireMeshData.center = mTransform.multiplyAffine(Vector3::ZERO);
+
+		hashCommon(ShapeType::WireMesh, wireMeshData);
+
+		// Mesh data might be modified without its address changing, so hash its contents
+		const UINT32* data = (const UINT32*)meshData->getData();
+		UINT32 numWords = meshData->getSize() / sizeof(UINT32);
+		for (UINT32 i = 0; i < numWords; i++)
+			hash_combine(mShapesHash, data[i]);
 	}
 
 	void DrawHelper::clear()
@@ -333,18 +435,96 @@ namespace BansheeEngine
 		mWireConeData.clear();
 		mText2DData.clear();
 		mWireMeshData.clear();
+
+		mShapesHash = 0;
+	}
+
+	bool DrawHelper::canReuseMeshes(SortType sorting, const Vector3& reference, UINT64 layers) const
+	{
+		if (!canReuseStaticMeshes(sorting, layers))
+			return false;
+
+		bool hasViewDependentMeshes = mMeshes.size() > mNumStaticMeshes;
+		return !hasViewDependentMeshes || reference == mMeshesReference;
+	}
+
+	bool DrawHelper::canReuseStaticMeshes(SortType sorting, UINT64 layers) const
+	{
+		if (!mMeshesValid)
+			return false;
+
+		return mMeshesHash == mShapesHash && mMeshesSorting == sorting && mMeshesLayers == layers;
 	}
 
 	void DrawHelper::buildMeshes(SortType sorting, const Vector3& reference, UINT64 layers)
 	{
 		mMeshes.clear();
+		mMeshesHash = mShapesHash;
+		mMeshesSorting = sorting;
+		mMeshesLayers = layers;
+		mMeshesReference = reference;
+		mMeshesValid = true;
+
+		// Static meshes go first, so the view dependent ones can be rebuilt without touching them
+		Vector<ShapeMeshRawData> rawMeshes;
+		buildMeshData(sorting, reference, layers, ShapeGroup::Static, rawMeshes);
+		mNumStaticMeshes = (UINT32)rawMeshes.size();
+
+		buildMeshData(sorting, reference, layers, ShapeGroup::ViewDependent, rawMeshes);
+		allocateMeshes(rawMeshes);
+	}
 
-		enum class ShapeType
+	void DrawHelper::rebuildViewDependentMeshes(const Vector3& reference)
+	{
+		Vector<ShapeMeshData> oldMeshes(mMeshes.begin() + mNumStaticMeshes, mMeshes.end());
+		freeMeshes(oldMeshes);
+
+		mMeshes.resize(mNumStaticMeshes);
+		mMeshesReference = reference;
+
+		Vector<ShapeMeshRawData> rawMeshes;
+		buildMeshData(mMeshesSorting, reference, mMeshesLayers, ShapeGroup::ViewDependent, rawMeshes);
+		allocateMeshes(rawMeshes);
+	}
+
+	void DrawHelper::allocateMeshes(const Vector<ShapeMeshRawData>& rawMeshes)
+	{
+		for (auto& rawMesh : rawMeshes)
 		{
-			Cube, Sphere, WireCube, WireSphere, WireCone, Line, LineList, Frustum, 
-			Cone, Disc, WireDisc, Arc, WireArc, Rectangle, Text, WireMesh
-		};
+			mMeshes.push_back(ShapeMeshData());
+			ShapeMeshData& newMesh = mMeshes.back();
+			newMesh.type = rawMesh.type;
+			newMesh.texture = rawMesh.texture;
+
+			switch (rawMesh.type)
+			{
+			case MeshType::Solid:
+				newMesh.mesh = mSolidMeshHeap->alloc(rawMesh.meshData, DOT_TRIANGLE_LIST);
+				break;
+			case MeshType::Wire:
+				newMesh.mesh = mWireMeshHeap->alloc(rawMesh.meshData, DOT_TRIANGLE_LIST);
+				break;
+			case MeshType::Line:
+				newMesh.mesh = mLineMeshHeap->alloc(rawMesh.meshData, DOT_LINE_LIST);
+				break;
+			case MeshType::Text:
+				newMesh.mesh = mTextMeshHeap->alloc(rawMesh.meshData, DOT_TRIANGLE_LIST);
+				break;
+			}
+		}
 
+		mNumActiveMeshes += (UINT32)rawMeshes.size();
+	}
+
+	void DrawHelper::buildMeshData(SortType sorting, const Vector3& reference, UINT64 layers, 
+		Vector<ShapeMeshRawData>& output)
+	{
+		buildMeshData(sorting, reference, layers, ShapeGroup::All, output);
+	}
+
+	void DrawHelper::buildMeshData(SortType sorting, const Vector3& reference, UINT64 layers, ShapeGroup group,
+		Vector<ShapeMeshRawData>& output)
+	{
 		struct RawData
 		{
 			ShapeType shapeType;
@@ -360,13 +540,26 @@ namespace BansheeEngine
 		/* 			Sort everything according to specified sorting rule         */
 		/************************************************************************/
 
+		// Transparent shapes need to be re-sorted whenever the reference point moves, and text always faces it
+		auto isIncluded = [&](const CommonData& data, bool isText)
+		{
+			if ((data.layer & layers) == 0)
+				return false;
+
+			if (group == ShapeGroup::All)
+				return true;
+
+			bool isViewDependent = isText || (sorting != SortType::None && data.color.a < 1.0f);
+			return isViewDependent == (group == ShapeGroup::ViewDependent);
+		};
+
 		UINT32 idx = 0;
 		Vector<RawData> allShapes;
 
 		UINT32 localIdx = 0;
 		for (auto& shapeData : mSolidCubeData)
 		{
-			if ((shapeData.layer & layers) == 0)
+			if (!isIncluded(shapeData, false))
 			{
 				localIdx++;
 				continue;
@@ -387,7 +580,7 @@ namespace BansheeEngine
 		localIdx = 0;
 		for (auto& shapeData : mSolidSphereData)
 		{
-			if ((shapeData.layer & layers) == 0)
+			if (!isIncluded(shapeData, false))
 			{
 				localIdx++;
 				continue;
@@ -409,7 +602,7 @@ namespace BansheeEngine
 		localIdx = 0;
 		for (auto& shapeData : mConeData)
 		{
-			if ((shapeData.layer & layers) == 0)
+			if (!isIncluded(shapeData, false))
 			{
 				localIdx++;
 				continue;
@@ -431,7 +624,7 @@ namespace BansheeEngine
 		localIdx = 0;
 		for (auto& shapeData : mDiscData)
 		{
-			if ((shapeData.layer & layers) == 0)
+			if (!isIncluded(shapeData, false))
 			{
 				localIdx++;
 				continue;
@@ -453,7 +646,7 @@ namespace BansheeEngine
 		localIdx = 0;
 		for (auto& shapeData : mArcData)
 		{
-			if ((shapeData.layer & layers) == 0)
+			if (!isIncluded(shapeData, false))
 			{
 				localIdx++;
 				continue;
@@ -475,7 +668,7 @@ namespace BansheeEngine
 		localIdx = 0;
 		for (auto& shapeData : mRect3Data)
 		{
-			if ((shapeData.layer & layers) == 0)
+			if (!isIncluded(shapeData, false))
 			{
 				localIdx++;
 				continue;
@@ -496,7 +689,7 @@ namespace BansheeEngine
 		localIdx = 0;
 		for (auto& shapeData : mWireCubeData)
 		{
-			if ((shapeData.layer & layers) == 0)
+			if (!isIncluded(shapeData, false))
 			{
 				localIdx++;
 				continue;
@@ -517,7 +710,7 @@ namespace BansheeEngine
 		localIdx = 0;
 		for (auto& shapeData : mWireSphereData)
 		{
-			if ((shapeData.layer & layers) == 0)
+			if (!isIncluded(shapeData, false))
 			{
 				localIdx++;
 				continue;
@@ -539,7 +732,7 @@ namespace BansheeEngine
 		localIdx = 0;
 		for (auto& shapeData : mWireConeData)
 		{
-			if ((shapeData.layer & layers) == 0)
+			if (!isIncluded(shapeData, false))
 			{
 				localIdx++;
 				continue;
@@ -561,7 +754,7 @@ namespace BansheeEngine
 		localIdx = 0;
 		for (auto& shapeData : mLineData)
 		{
-			if ((shapeData.layer & layers) == 0)
+			if (!isIncluded(shapeData, false))
 			{
 				localIdx++;
 				continue;
@@ -582,7 +775,7 @@ namespace BansheeEngine
 		localIdx = 0;
 		for (auto& shapeData : mLineListData)
 		{
-			if ((shapeData.layer & layers) == 0)
+			if (!isIncluded(shapeData, false))
 			{
 				localIdx++;
 				continue;
@@ -604,7 +797,7 @@ namespace BansheeEngine
 		localIdx = 0;
 		for (auto& shapeData : mFrustumData)
 		{
-			if ((shapeData.layer & layers) == 0)
+			if (!isIncluded(shapeData, false))
 			{
 				localIdx++;
 				continue;
@@ -625,7 +818,7 @@ namespace BansheeEngine
 		localIdx = 0;
 		for (auto& shapeData : mWireDiscData)
 		{
-			if ((shapeData.layer & layers) == 0)
+			if (!isIncluded(shapeData, false))
 			{
 				localIdx++;
 				continue;
@@ -647,7 +840,7 @@ namespace BansheeEngine
 		localIdx = 0;
 		for (auto& shapeData : mWireArcData)
 		{
-			if ((shapeData.layer & layers) == 0)
+			if (!isIncluded(shapeData, false))
 			{
 				localIdx++;
 				continue;
@@ -669,7 +862,7 @@ namespace BansheeEngine
 		localIdx = 0;
 		for (auto& shapeData : mWireMeshData)
 		{
-			if ((shapeData.layer & layers) == 0)
+			if (!isIncluded(shapeData, false))
 			{
 				localIdx++;
 				continue;
@@ -699,7 +892,7 @@ namespace BansheeEngine
 		localIdx = 0;
 		for (auto& shapeData : mText2DData)
 		{
-			if ((shapeData.layer & layers) == 0)
+			if (!isIncluded(shapeData, true))
 			{
 				localIdx++;
 				continue;
@@ -852,8 +1045,8 @@ namespace BansheeEngine
 					case ShapeType::Cube:
 					{
 						CubeData& cubeData = mSolidCubeData[shapeData.idx];
-						AABox box(cubeData.position - cubeData.extents, cubeData.position + cubeData.extents);
-						ShapeMeshes3D::solidAABox(box, meshData, curVertexOffset, curIndexOffet);
+						writeShapeTemplate(ShapeTemplateType::SolidCube, 0, cubeData.position, cubeData.extents, 
+							meshData, curVertexOffset, curIndexOffet);
 
 						transform = &cubeData.transform;
 						color = cubeData.color.getAsRGBA();
@@ -862,8 +1055,9 @@ namespace BansheeEngine
 					case ShapeType::Sphere:
 					{
 						SphereData& sphereData = mSolidSphereData[shapeData.idx];
-						Sphere sphere(sphereData.position, sphereData.radius);
-						ShapeMeshes3D::solidSphere(sphere, meshData, curVertexOffset, curIndexOffet, sphereData.quality);
+						writeShapeTemplate(ShapeTemplateType::SolidSphere, sphereData.quality, sphereData.position, 
+							Vector3(sphereData.radius, sphereData.radius, sphereData.radius), meshData, curVertexOffset, 
+							curIndexOffet);
 
 						transform = &sphereData.transform;
 						color = sphereData.color.getAsRGBA();
@@ -927,9 +1121,9 @@ namespace BansheeEngine
 					curIndexOffet += shapeData.numIndices;
 				}
 
-				mMeshes.push_back(ShapeMeshData());
-				ShapeMeshData& newMesh = mMeshes.back();
-				newMesh.mesh = mSolidMeshHeap->alloc(meshData, DOT_TRIANGLE_LIST);
+				output.push_back(ShapeMeshRawData());
+				ShapeMeshRawData& newMesh = output.back();
+				newMesh.meshData = meshData;
 				newMesh.type = MeshType::Solid;
 			}
 			else if (batch.type == MeshType::Wire)
@@ -979,9 +1173,9 @@ namespace BansheeEngine
 						break;
 					}
 
-					mMeshes.push_back(ShapeMeshData());
-					ShapeMeshData& newMesh = mMeshes.back();
-					newMesh.mesh = mWireMeshHeap->alloc(meshData, DOT_TRIANGLE_LIST);
+					output.push_back(ShapeMeshRawData());
+					ShapeMeshRawData& newMesh = output.back();
+					newMesh.meshData = meshData;
 					newMesh.type = MeshType::Wire;
 				}
 			}
@@ -1009,8 +1203,8 @@ namespace BansheeEngine
 					{
 						CubeData& cubeData = mWireCubeData[shapeData.idx];
 
-						AABox box(cubeData.position - cubeData.extents, cubeData.position + cubeData.extents);
-						ShapeMeshes3D::wireAABox(box, meshData, curVertexOffset, curIndexOffet);
+						writeShapeTemplate(ShapeTemplateType::WireCube, 0, cubeData.position, cubeData.extents,
+							meshData, curVertexOffset, curIndexOffet);
 
 						transform = &cubeData.transform;
 						color = cubeData.color.getAsRGBA();
@@ -1020,8 +1214,9 @@ namespace BansheeEngine
 					{
 						SphereData& sphereData = mWireSphereData[shapeData.idx];
 
-						Sphere sphere(sphereData.position, sphereData.radius);
-						ShapeMeshes3D::wireSphere(sphere, meshData, curVertexOffset, curIndexOffet, sphereData.quality);
+						writeShapeTemplate(ShapeTemplateType::WireSphere, sphereData.quality, sphereData.position,
+							Vector3(sphereData.radius, sphereData.radius, sphereData.radius), meshData, curVertexOffset, 
+							curIndexOffet);
 
 						transform = &sphereData.transform;
 						color = sphereData.color.getAsRGBA();
@@ -1106,9 +1301,9 @@ namespace BansheeEngine
 					curIndexOffet += shapeData.numIndices;
 				}
 
-				mMeshes.push_back(ShapeMeshData());
-				ShapeMeshData& newMesh = mMeshes.back();
-				newMesh.mesh = mLineMeshHeap->alloc(meshData, DOT_LINE_LIST);
+				output.push_back(ShapeMeshRawData());
+				ShapeMeshRawData& newMesh = output.back();
+				newMesh.meshData = meshData;
 				newMesh.type = MeshType::Line;
 			}
 			else // Text
@@ -1185,18 +1380,24 @@ namespace BansheeEngine
 					curIndexOffet += shapeData.numIndices;
 				}
 
-				mMeshes.push_back(ShapeMeshData());
-				ShapeMeshData& newMesh = mMeshes.back();
-				newMesh.mesh = mTextMeshHeap->alloc(meshData, DOT_TRIANGLE_LIST);
+				output.push_back(ShapeMeshRawData());
+				ShapeMeshRawData& newMesh = output.back();
+				newMesh.meshData = meshData;
 				newMesh.type = MeshType::Text;
 				newMesh.texture = batch.texture;
 			}
 		}
-
-		mNumActiveMeshes += (UINT32)mMeshes.size();
 	}
 
 	void DrawHelper::clearMeshes(const Vector<ShapeMeshData>& meshes)
+	{
+		freeMeshes(meshes);
+
+		if (!meshes.empty())
+			mMeshesValid = false;
+	}
+
+	void DrawHelper::freeMeshes(const Vector<ShapeMeshData>& meshes)
 	{
 		for (auto meshData : meshes)
 		{
@@ -1212,4 +1413,111 @@ namespace BansheeEngine
 
 		mNumActiveMeshes -= (UINT32)meshes.size();
 	}
+
+	void DrawHelper::hashCommon(ShapeType type, const CommonData& data)
+	{
+		hash_combine(mShapesHash, (UINT32)type);
+		hash_combine(mShapesHash, data.color);
+		hash_combine(mShapesHash, data.layer);
+
+		for (UINT32 i = 0; i < 4; i++)
+		{
+			for (UINT32 j = 0; j < 4; j++)
+				hash_combine(mShapesHash, data.transform[i][j]);
+		}
+	}
+
+	void DrawHelper::hashVector(const Vector3& value)
+	{
+		hash_combine(mShapesHash, value.x);
+		hash_combine(mShapesHash, value.y);
+		hash_combine(mShapesHash, value.z);
+	}
+
+	const SPtr<MeshData>& DrawHelper::getShapeTemplate(ShapeTemplateType type, UINT32 quality)
+	{
+		UINT32 key = ((UINT32)type << 24) | (quality & 0xFFFFFF);
+
+		auto iterFind = mShapeTemplates.find(key);
+		if (iterFind != mShapeTemplates.end())
+			return iterFind->second;
+
+		UINT32 numVertices = 0;
+		UINT32 numIndices = 0;
+		SPtr<MeshData> meshData;
+		switch (type)
+		{
+		case ShapeTemplateType::SolidCube:
+			ShapeMeshes3D::getNumElementsAABox(numVertices, numIndices);
+			meshData = bs_shared_ptr_new<MeshData>(numVertices, numIndices, mSolidVertexDesc);
+			ShapeMeshes3D::solidAABox(AABox(-Vector3::ONE, Vector3::ONE), meshData, 0, 0);
+			break;
+		case ShapeTemplateType::WireCube:
+			ShapeMeshes3D::getNumElementsWireAABox(numVertices, numIndices);
+			meshData = bs_shared_ptr_new<MeshData>(numVertices, numIndices, mLineVertexDesc);
+			ShapeMeshes3D::wireAABox(AABox(-Vector3::ONE, Vector3::ONE), meshData, 0, 0);
+			break;
+		case ShapeTemplateType::SolidSphere:
+			ShapeMeshes3D::getNumElementsSphere(quality, numVertices, numIndices);
+			meshData = bs_shared_ptr_new<MeshData>(numVertices, numIndices, mSolidVertexDesc);
+			ShapeMeshes3D::solidSphere(Sphere(Vector3::ZERO, 1.0f), meshData, 0, 0, quality);
+			break;
+		case ShapeTemplateType::WireSphere:
+			ShapeMeshes3D::getNumElementsWireSphere(quality, numVertices, numIndices);
+			meshData = bs_shared_ptr_new<MeshData>(numVertices, numIndices, mLineVertexDesc);
+			ShapeMeshes3D::wireSphere(Sphere(Vector3::ZERO, 1.0f), meshData, 0, 0, quality);
+			break;
+		}
+
+		return mShapeTemplates.insert(std::make_pair(key, meshData)).first->second;
+	}
+
+	void DrawHelper::writeShapeTemplate(ShapeTemplateType type, UINT32 quality, const Vector3& position, 
+		const Vector3& scale, const SPtr<MeshData>& meshData, UINT32 vertexOffset, UINT32 indexOffset)
+	{
+		const SPtr<MeshData>& shapeTemplate = getShapeTemplate(type, quality);
+
+		UINT32 numVertices = shapeTemplate->getNumVertices();
+		UINT32 numIndices = shapeTemplate->getNumIndices();
+
+		assert((vertexOffset + numVertices) <= meshData->getNumVertices());
+		assert((indexOffset + numIndices) <= meshData->getNumIndices());
+
+		// Templates use the same vertex layout as the meshes they're written to
+		UINT32 stride = meshData->getVertexDesc()->getVertexStride();
+		assert(stride == shapeTemplate->getVertexDesc()->getVertexStride());
+
+		UINT8* srcPositions = shapeTemplate->getElementData(VES_POSITION);
+		UINT8* dstPositions = meshData->getElementData(VES_POSITION) + vertexOffset * stride;
+		for (UINT32 i = 0; i < numVertices; i++)
+		{
+			Vector3 vertex;
+			memcpy(&vertex, srcPositions, sizeof(vertex));
+
+			vertex = position + vertex * scale;
+			memcpy(dstPositions, &vertex, sizeof(vertex));
+
+			srcPositions += stride;
+			dstPositions += stride;
+		}
+
+		// Scale and offset don't affect normal directions
+		if (shapeTemplate->getVertexDesc()->hasElement(VES_NORMAL))
+		{
+			UINT8* srcNormals = shapeTemplate->getElementData(VES_NORMAL);
+			UINT8* dstNormals = meshData->getElementData(VES_NORMAL) + vertexOffset * stride;
+			for (UINT32 i = 0; i < numVertices; i++)
+			{
+				memcpy(dstNormals, srcNormals, sizeof(Vector3));
+
+				srcNormals += stride;
+				dstNormals += stride;
+			}
+		}
+
+		UINT32* srcIndices = shapeTemplate->getIndices32();
+		UINT32* dstIndices = meshData->getIndices32() + indexOffset;
+		for (UINT32 i = 0; i < numIndices; i++)
+			dstIndices[i] = srcIndices[i] + vertexOffset;
+	}
 }
\ No newline at end of file
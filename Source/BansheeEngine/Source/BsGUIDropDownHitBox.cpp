@@ -2,6 +2,7 @@
 //**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
 #include "BsGUIDropDownHitBox.h"
 #include "BsGUICommandEvent.h"
+#include "BsGUIWidget.h"
 #include "BsGUIMouseEvent.h"
 
 namespace BansheeEngine
@@ -38,6 +39,9 @@ namespace BansheeEngine
 		mBounds.push_back(bounds);
 
 		updateClippedBounds();
+
+		if (mParentWidget != nullptr)
+			mParentWidget->_markBoundsDirty(this);
 	}
 
 	void GUIDropDownHitBox::setBounds(const Vector<Rect2I>& bounds)
@@ -45,6 +49,9 @@ namespace BansheeEngine
 		mBounds = bounds;
 
 		updateClippedBounds();
+
+		if (mParentWidget != nullptr)
+			mParentWidget->_markBoundsDirty(this);
 	}
 
 	void GUIDropDownHitBox::updateClippedBounds()
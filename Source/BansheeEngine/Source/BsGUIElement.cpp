@@ -24,7 +24,12 @@ namespace BansheeEngine
 
 	void GUIElement::_updateRenderElements()
 	{
+		Rect2I oldClippedBounds = mClippedBounds;
 		updateRenderElementsInternal();
+
+		// Some elements calculate their bounds from their contents, which can change without a layout update
+		if (mParentWidget != nullptr && mClippedBounds != oldClippedBounds)
+			mParentWidget->_markBoundsDirty(this);
 	}
 
 	void GUIElement::updateRenderElementsInternal()
@@ -102,6 +107,9 @@ namespace BansheeEngine
 		_setElementDepth(elemDepth);
 
 		updateClippedBounds();
+
+		if (mParentWidget != nullptr)
+			mParentWidget->_markBoundsDirty(this);
 	}
 
 	void GUIElement::_changeParentWidget(GUIWidget* widget)
@@ -12,14 +12,14 @@ namespace BansheeEngine
 {
 	GUIElementBase::GUIElementBase()
 		: mParentWidget(nullptr), mAnchorParent(nullptr), mUpdateParent(nullptr), mParentElement(nullptr)
-		, mFlags(GUIElem_Dirty)
+		, mFlags(GUIElem_Dirty | GUIElem_SizeRangeDirty)
 	{
 
 	}
 
 	GUIElementBase::GUIElementBase(const GUIDimensions& dimensions)
 		: mParentWidget(nullptr), mAnchorParent(nullptr), mUpdateParent(nullptr), mParentElement(nullptr)
-		, mFlags(GUIElem_Dirty), mDimensions(dimensions)
+		, mFlags(GUIElem_Dirty | GUIElem_SizeRangeDirty), mDimensions(dimensions)
 	{
 
 	}
@@ -57,6 +57,8 @@ namespace BansheeEngine
 		mDimensions.x = x;
 		mDimensions.y = y;
 
+		// Position doesn't require a layout update, but it does affect the size of a parent GUI panel
+		markSizeRangeDirty();
 		_markMeshAsDirty();
 	}
 
@@ -156,6 +158,8 @@ namespace BansheeEngine
 		if (mUpdateParent != nullptr && mUpdateParent->_isDirty() && mParentWidget != nullptr)
 			mParentWidget->_updateLayout(mUpdateParent);
 
+		updateDeferredLayout();
+
 		Rect2I bounds = mLayoutData.area;
 		bounds.x -= anchorBounds.x;
 		bounds.y -= anchorBounds.y;
@@ -175,6 +179,8 @@ namespace BansheeEngine
 		if (mUpdateParent != nullptr && mUpdateParent->_isDirty() && mParentWidget != nullptr)
 			mParentWidget->_updateLayout(mUpdateParent);
 
+		updateDeferredLayout();
+
 		return mLayoutData.area;
 	}
 
@@ -190,6 +196,9 @@ namespace BansheeEngine
 
 	void GUIElementBase::_markLayoutAsDirty() 
 	{ 
+		// Size ranges are tracked even for hidden elements, as they still take up space in their parent layout
+		markSizeRangeDirty();
+
 		if(!_isVisible())
 			return;
 
@@ -199,6 +208,49 @@ namespace BansheeEngine
 			mFlags |= GUIElem_Dirty;
 	}
 
+	void GUIElementBase::_setLayoutDeferred(bool deferred)
+	{
+		if (deferred)
+			mFlags |= GUIElem_LayoutDeferred;
+		else
+			mFlags &= ~GUIElem_LayoutDeferred;
+	}
+
+	void GUIElementBase::markSizeRangeDirty()
+	{
+		mFlags |= GUIElem_SizeRangeDirty;
+
+		// If a parent is already dirty, so are all of its parents
+		GUIElementBase* parent = mParentElement;
+		while (parent != nullptr && (parent->mFlags & GUIElem_SizeRangeDirty) == 0)
+		{
+			parent->mFlags |= GUIElem_SizeRangeDirty;
+			parent = parent->mParentElement;
+		}
+	}
+
+	void GUIElementBase::updateDeferredLayout()
+	{
+		// Find the top-most deferred parent, as its children layout data is out of date, including all deferred parents
+		// below it
+		GUIElementBase* deferredParent = nullptr;
+		GUIElementBase* parent = mParentElement;
+		while (parent != nullptr)
+		{
+			if (parent->_isLayoutDeferred())
+				deferredParent = parent;
+
+			parent = parent->mParentElement;
+		}
+
+		if (deferredParent == nullptr)
+			return;
+
+		// Parent is clipped, so none of the children will get deferred again
+		deferredParent->_setLayoutDeferred(false);
+		deferredParent->_updateLayoutInternal(deferredParent->mLayoutData);
+	}
+
 	void GUIElementBase::_markContentAsDirty()
 	{
 		if (!_isVisible())
@@ -388,10 +440,15 @@ namespace BansheeEngine
 
 	void GUIElementBase::_updateOptimalLayoutSizes()
 	{
+		if ((mFlags & GUIElem_SizeRangeDirty) == 0)
+			return;
+
 		for(auto& child : mChildren)
 		{
 			child->_updateOptimalLayoutSizes();
 		}
+
+		mFlags &= ~GUIElem_SizeRangeDirty;
 	}
 
 	void GUIElementBase::_updateLayoutInternal(const GUILayoutData& data)
@@ -424,6 +481,7 @@ namespace BansheeEngine
 		if(mParentElement != parent)
 		{
 			mParentElement = parent; 
+			_setLayoutDeferred(false);
 			_updateAUParents();
 
 			if (parent != nullptr)
@@ -0,0 +1,138 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsGUIElementGrid.h"
+#include "BsGUIElement.h"
+
+namespace BansheeEngine
+{
+	void GUIElementGrid::markDirty(GUIElement* element)
+	{
+		mDirtyElements.insert(element);
+	}
+
+	void GUIElementGrid::remove(GUIElement* element)
+	{
+		mDirtyElements.erase(element);
+
+		auto iterFind = mElements.find(element);
+		if (iterFind == mElements.end())
+			return;
+
+		removeFromCells(element, iterFind->second);
+		mElements.erase(iterFind);
+	}
+
+	void GUIElementGrid::clear()
+	{
+		mCells.clear();
+		mElements.clear();
+		mLargeElements.clear();
+		mDirtyElements.clear();
+	}
+
+	void GUIElementGrid::find(const Vector2I& position, Vector<GUIElement*>& output)
+	{
+		update();
+
+		for (auto& element : mLargeElements)
+		{
+			if (element->_isVisible() && element->_isInBounds(position))
+				output.push_back(element);
+		}
+
+		auto iterFind = mCells.find(getCellKey(getCell(position.x), getCell(position.y)));
+		if (iterFind == mCells.end())
+			return;
+
+		for (auto& element : iterFind->second)
+		{
+			if (element->_isVisible() && element->_isInBounds(position))
+				output.push_back(element);
+		}
+	}
+
+	void GUIElementGrid::update()
+	{
+		for (auto& element : mDirtyElements)
+		{
+			auto iterFind = mElements.find(element);
+			if (iterFind != mElements.end())
+			{
+				removeFromCells(element, iterFind->second);
+				mElements.erase(iterFind);
+			}
+
+			// Elements can't be hit outside of their clipped bounds, so they don't need to be stored if they're empty
+			const Rect2I& bounds = element->_getClippedBounds();
+			if (bounds.width == 0 || bounds.height == 0)
+				continue;
+
+			CellRange range;
+			range.minX = getCell(bounds.x);
+			range.minY = getCell(bounds.y);
+			range.maxX = getCell(bounds.x + (INT32)bounds.width - 1);
+			range.maxY = getCell(bounds.y + (INT32)bounds.height - 1);
+
+			INT64 numCells = (INT64)(range.maxX - range.minX + 1) * (range.maxY - range.minY + 1);
+			range.isLarge = numCells > MAX_CELLS_PER_ELEMENT;
+
+			if (range.isLarge)
+				mLargeElements.push_back(element);
+			else
+			{
+				for (INT32 y = range.minY; y <= range.maxY; y++)
+				{
+					for (INT32 x = range.minX; x <= range.maxX; x++)
+						mCells[getCellKey(x, y)].push_back(element);
+				}
+			}
+
+			mElements[element] = range;
+		}
+
+		mDirtyElements.clear();
+	}
+
+	void GUIElementGrid::removeFromCells(GUIElement* element, const CellRange& range)
+	{
+		auto removeFromList = [&](Vector<GUIElement*>& elements)
+		{
+			auto iterFind = std::find(elements.begin(), elements.end(), element);
+			if (iterFind == elements.end())
+				return;
+
+			// Order of elements doesn't matter, so avoid shifting the remaining elements
+			*iterFind = elements.back();
+			elements.pop_back();
+		};
+
+		if (range.isLarge)
+		{
+			removeFromList(mLargeElements);
+			return;
+		}
+
+		for (INT32 y = range.minY; y <= range.maxY; y++)
+		{
+			for (INT32 x = range.minX; x <= range.maxX; x++)
+			{
+				auto iterFind = mCells.find(getCellKey(x, y));
+				if (iterFind == mCells.end())
+					continue;
+
+				removeFromList(iterFind->second);
+				if (iterFind->second.empty())
+					mCells.erase(iterFind);
+			}
+		}
+	}
+
+	INT32 GUIElementGrid::getCell(INT32 coord)
+	{
+		// Round towards negative infinity, so cells are of equal size on both sides of the origin
+		if (coord >= 0)
+			return coord / CELL_SIZE;
+
+		return -((-coord + CELL_SIZE - 1) / CELL_SIZE);
+	}
+}
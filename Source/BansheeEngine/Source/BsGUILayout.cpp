@@ -70,6 +70,32 @@ namespace BansheeEngine
 		_markLayoutAsDirty();
 	}
 
+	void GUILayout::_updateChildLayout(GUIElementBase* element, const GUILayoutData& data)
+	{
+		GUILayoutData childData = data;
+
+		childData.clipRect = data.area;
+		childData.clipRect.clip(data.clipRect);
+
+		// If the element is outside of the visible area, and already was during the last update, its children are
+		// already clipped and don't need to be positioned until it becomes visible (e.g. rows scrolled out of a scroll
+		// area). Only do this if this layout is visible, so deferred layout can be resolved by updating the parent.
+		bool isClipped = childData.clipRect.width == 0 || childData.clipRect.height == 0;
+		bool wasClipped = element->_getLayoutData().clipRect.width == 0 || element->_getLayoutData().clipRect.height == 0;
+		bool isParentClipped = data.clipRect.width == 0 || data.clipRect.height == 0;
+
+		element->_setLayoutData(childData);
+
+		if (isClipped && wasClipped && !isParentClipped && element->_getNumChildren() > 0)
+		{
+			element->_setLayoutDeferred(true);
+			return;
+		}
+
+		element->_setLayoutDeferred(false);
+		element->_updateLayoutInternal(childData);
+	}
+
 	const RectOffset& GUILayout::_getPadding() const
 	{
 		static RectOffset padding;
@@ -46,6 +46,10 @@ namespace BansheeEngine
 
 	void GUILayoutX::_updateOptimalLayoutSizes()
 	{
+		// Cached size ranges are still valid if nothing in this element's hierarchy changed
+		if ((mFlags & GUIElem_SizeRangeDirty) == 0)
+			return;
+
 		// Update all children first, otherwise we can't determine our own optimal size
 		GUIElementBase::_updateOptimalLayoutSizes();
 
@@ -410,11 +414,8 @@ namespace BansheeEngine
 			if (child->_isActive())
 			{
 				childData.area = elementAreas[childIdx];
-				childData.clipRect = childData.area;
-				childData.clipRect.clip(data.clipRect);
 
-				child->_setLayoutData(childData);
-				child->_updateLayoutInternal(childData);
+				_updateChildLayout(child, childData);
 			}
 
 			childIdx++;
@@ -233,6 +233,8 @@ namespace BansheeEngine
 
 	void GUIManager::update()
 	{
+		ScopedMemoryTag memoryTag(getMemoryCategoryIdx<GUIAlloc>());
+
 		DragAndDropManager::instance()._update();
 
 		// Show tooltip if needed
@@ -1260,29 +1262,27 @@ namespace BansheeEngine
 				if(widgetWindows[widgetIdx] == windowUnderPointer 
 					&& widget->inBounds(windowToBridgedCoords(widget->getTarget()->getTarget(), windowPos)))
 				{
-					const Vector<GUIElement*>& elements = widget->getElements();
 					Vector2I localPos = getWidgetRelativePos(widget, pointerScreenPos);
 
-					// Elements with lowest depth (most to the front) get handled first
-					for(auto iter = elements.begin(); iter != elements.end(); ++iter)
-					{
-						GUIElement* element = *iter;
-
-						if(element->_isVisible() && element->_isInBounds(localPos))
-						{
-							ElementInfoUnderPointer elementInfo(element, widget);
+					// Only elements whose bounds overlap the pointer are returned, so this doesn't scale with the
+					// number of elements in the widget
+					mElementsAtPointer.clear();
+					widget->_findElements(localPos, mElementsAtPointer);
 
-							auto iterFind = std::find_if(mElementsUnderPointer.begin(), mElementsUnderPointer.end(),
-								[=](const ElementInfoUnderPointer& x) { return x.element == element; });
+					for(auto& element : mElementsAtPointer)
+					{
+						ElementInfoUnderPointer elementInfo(element, widget);
 
-							if (iterFind != mElementsUnderPointer.end())
-							{
-								elementInfo.usesMouseOver = iterFind->usesMouseOver;
-								elementInfo.receivedMouseOver = iterFind->receivedMouseOver;
-							}
+						auto iterFind = std::find_if(mElementsUnderPointer.begin(), mElementsUnderPointer.end(),
+							[=](const ElementInfoUnderPointer& x) { return x.element == element; });
 
-							mNewElementsUnderPointer.push_back(elementInfo);
+						if (iterFind != mElementsUnderPointer.end())
+						{
+							elementInfo.usesMouseOver = iterFind->usesMouseOver;
+							elementInfo.receivedMouseOver = iterFind->receivedMouseOver;
 						}
+
+						mNewElementsUnderPointer.push_back(elementInfo);
 					}
 				}
 
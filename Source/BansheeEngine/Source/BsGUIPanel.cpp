@@ -82,6 +82,10 @@ namespace BansheeEngine
 
 	void GUIPanel::_updateOptimalLayoutSizes()
 	{
+		// Cached size ranges are still valid if nothing in this element's hierarchy changed
+		if ((mFlags & GUIElem_SizeRangeDirty) == 0)
+			return;
+
 		// Update all children first, otherwise we can't determine our own optimal size
 		GUIElementBase::_updateOptimalLayoutSizes();
 
@@ -251,17 +255,6 @@ namespace BansheeEngine
 			bs_stack_free(elementAreas);
 	}
 
-	void GUIPanel::_updateChildLayout(GUIElementBase* element, const GUILayoutData& data)
-	{
-		GUILayoutData childData = data;
-
-		childData.clipRect = data.area;
-		childData.clipRect.clip(data.clipRect);
-
-		element->_setLayoutData(childData);
-		element->_updateLayoutInternal(childData);
-	}
-
 	GUIPanel* GUIPanel::create(INT16 depth, UINT16 depthRangeMin, UINT16 depthRangeMax)
 	{
 		return bs_new<GUIPanel>(depth, depthRangeMin, depthRangeMax, GUIDimensions::create());
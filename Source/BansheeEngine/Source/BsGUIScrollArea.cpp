@@ -78,6 +78,10 @@ namespace BansheeEngine
 
 	void GUIScrollArea::_updateOptimalLayoutSizes()
 	{
+		// Cached size ranges are still valid if nothing in this element's hierarchy changed
+		if ((mFlags & GUIElem_SizeRangeDirty) == 0)
+			return;
+
 		// Update all children first, otherwise we can't determine our own optimal size
 		GUIElementBase::_updateOptimalLayoutSizes();
 
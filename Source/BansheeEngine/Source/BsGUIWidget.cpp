@@ -81,6 +81,7 @@ namespace BansheeEngine
 
 		mElements.clear();
 		mDirtyContents.clear();
+		mElementGrid.clear();
 	}
 
 	void GUIWidget::setDepth(UINT8 depth)
@@ -240,6 +241,10 @@ namespace BansheeEngine
 
 				currentElem->_markAsClean();
 
+				// Children with deferred layout weren't touched by the update
+				if (currentElem->_isLayoutDeferred())
+					continue;
+
 				UINT32 numChildren = currentElem->_getNumChildren();
 				for (UINT32 i = 0; i < numChildren; i++)
 					todo.push(currentElem->_getChild(i));
@@ -255,6 +260,7 @@ namespace BansheeEngine
 		if (elem->_getType() == GUIElementBase::Type::Element)
 		{
 			mElements.push_back(static_cast<GUIElement*>(elem));
+			mElementGrid.markDirty(static_cast<GUIElement*>(elem));
 			mWidgetIsDirty = true;
 		}
 	}
@@ -272,7 +278,10 @@ namespace BansheeEngine
 		}
 
 		if (elem->_getType() == GUIElementBase::Type::Element)
+		{
 			mDirtyContents.erase(static_cast<GUIElement*>(elem));
+			mElementGrid.remove(static_cast<GUIElement*>(elem));
+		}
 	}
 
 	void GUIWidget::_markMeshDirty(GUIElementBase* elem)
@@ -286,6 +295,17 @@ namespace BansheeEngine
 			mDirtyContents.insert(static_cast<GUIElement*>(elem));
 	}
 
+	void GUIWidget::_markBoundsDirty(GUIElementBase* elem)
+	{
+		if (elem->_getType() == GUIElementBase::Type::Element)
+			mElementGrid.markDirty(static_cast<GUIElement*>(elem));
+	}
+
+	void GUIWidget::_findElements(const Vector2I& position, Vector<GUIElement*>& output)
+	{
+		mElementGrid.find(position, output);
+	}
+
 	void GUIWidget::setSkin(const HGUISkin& skin)
 	{
 		mSkin = skin;
@@ -11,6 +11,7 @@
 #include "BsRenderer.h"
 #include "BsFrameAlloc.h"
 #include "BsDebug.h"
+#include "BsCoreThread.h"
 
 namespace BansheeEngine
 {
@@ -216,6 +217,35 @@ namespace BansheeEngine
 		}
 	}
 
+	void RenderableCore::_updateTransforms(const SPtr<Vector<RenderableTransformUpdate>>& updates)
+	{
+		Vector<RenderableTransform> transforms;
+		transforms.reserve(updates->size());
+
+		for (auto& entry : *updates)
+		{
+			RenderableCore* renderable = entry.renderable.get();
+			renderable->mTransform = entry.transform;
+			renderable->mTransformNoScale = entry.transformNoScale;
+			renderable->mPosition = entry.transform.getTranslation();
+
+			// Uninitialized objects will pick up the new transform when they get registered with the renderer
+			if (!renderable->isInitialized() || !renderable->mIsActive)
+				continue;
+
+			RenderableTransform transform;
+			transform.renderable = renderable;
+			transform.rendererId = renderable->mRendererId;
+			transform.transform = entry.transform;
+			transform.transformNoScale = entry.transformNoScale;
+
+			transforms.push_back(transform);
+		}
+
+		if (!transforms.empty())
+			gRenderer()->notifyRenderableTransformsUpdated(transforms);
+	}
+
 	Renderable::Renderable()
 		:mLastUpdateHash(0)
 	{
@@ -351,6 +381,32 @@ namespace BansheeEngine
 		markCoreDirty();
 	}
 
+	void Renderable::_setTransform(const Matrix4& transform, const Matrix4& transformNoScale,
+		Vector<RenderableTransformUpdate>& batch)
+	{
+		mTransform = transform;
+		mTransformNoScale = transformNoScale;
+		mPosition = mTransform.getTranslation();
+
+		RenderableTransformUpdate update;
+		update.renderable = getCore();
+		update.transform = transform;
+		update.transformNoScale = transformNoScale;
+
+		batch.push_back(update);
+	}
+
+	void Renderable::_syncTransforms(Vector<RenderableTransformUpdate>& batch)
+	{
+		if (batch.empty())
+			return;
+
+		SPtr<Vector<RenderableTransformUpdate>> updates = bs_shared_ptr_new<Vector<RenderableTransformUpdate>>();
+		updates->swap(batch);
+
+		gCoreAccessor().queueCommand(std::bind(&RenderableCore::_updateTransforms, updates));
+	}
+
 	SPtr<Renderable> Renderable::create()
 	{
 		SPtr<Renderable> handlerPtr = createEmpty();
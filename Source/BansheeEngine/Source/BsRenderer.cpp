@@ -5,6 +5,12 @@
 
 namespace BansheeEngine
 {
+	void Renderer::notifyRenderableTransformsUpdated(const Vector<RenderableTransform>& transforms)
+	{
+		for (auto& entry : transforms)
+			notifyRenderableUpdated(entry.renderable);
+	}
+
 	SPtr<Renderer> gRenderer()
 	{
 		return std::static_pointer_cast<Renderer>(RendererManager::instance().getActive());
@@ -11,24 +11,69 @@ namespace BansheeEngine
 {
 	volatile SceneManager::InitOnStart SceneManager::DoInitOnStart;
 
+	/**
+	 * Removes the entry mapping the provided scene object to the provided core object, from the lookup map. The scene
+	 * object might have been destroyed, in which case a new scene object could be allocated at the same address, so the
+	 * entry must be removed regardless.
+	 */
+	template<class T>
+	void removeSOEntry(UnorderedMultimap<SceneObject*, T*>& map, SceneObject* so, T* object)
+	{
+		auto range = map.equal_range(so);
+		for (auto iter = range.first; iter != range.second; ++iter)
+		{
+			if (iter->second == object)
+			{
+				map.erase(iter);
+				break;
+			}
+		}
+	}
+
 	void SceneManager::_registerRenderable(const SPtr<Renderable>& renderable, const HSceneObject& so)
 	{
 		mRenderables[renderable.get()] = SceneRenderableData(renderable, so);
+		mRenderablesBySO.insert(std::make_pair(so.get(), renderable.get()));
+
+		so->_registerCoreObject();
 	}
 
 	void SceneManager::_unregisterRenderable(const SPtr<Renderable>& renderable)
 	{
-		mRenderables.erase(renderable.get());
+		auto iterFind = mRenderables.find(renderable.get());
+		if (iterFind == mRenderables.end())
+			return;
+
+		removeSOEntry(mRenderablesBySO, iterFind->second.sceneObjectPtr, renderable.get());
+
+		const HSceneObject& so = iterFind->second.sceneObject;
+		if (!so.isDestroyed())
+			so->_unregisterCoreObject();
+
+		mRenderables.erase(iterFind);
 	}
 
 	void SceneManager::_registerCamera(const SPtr<Camera>& camera, const HSceneObject& so)
 	{
 		mCameras[camera.get()] = SceneCameraData(camera, so);
+		mCamerasBySO.insert(std::make_pair(so.get(), camera.get()));
+
+		so->_registerCoreObject();
 	}
 
 	void SceneManager::_unregisterCamera(const SPtr<Camera>& camera)
 	{
-		mCameras.erase(camera.get());
+		auto iterFindCamera = mCameras.find(camera.get());
+		if (iterFindCamera != mCameras.end())
+		{
+			removeSOEntry(mCamerasBySO, iterFindCamera->second.sceneObjectPtr, camera.get());
+
+			const HSceneObject& so = iterFindCamera->second.sceneObject;
+			if (!so.isDestroyed())
+				so->_unregisterCoreObject();
+
+			mCameras.erase(iterFindCamera);
+		}
 
 		auto iterFind = std::find_if(mMainCameras.begin(), mMainCameras.end(), 
 			[&](const SceneCameraData& x)
@@ -69,74 +114,101 @@ namespace BansheeEngine
 	void SceneManager::_registerLight(const SPtr<Light>& light, const HSceneObject& so)
 	{
 		mLights[light.get()] = SceneLightData(light, so);
+		mLightsBySO.insert(std::make_pair(so.get(), light.get()));
+
+		so->_registerCoreObject();
 	}
 
 	void SceneManager::_unregisterLight(const SPtr<Light>& light)
 	{
-		mLights.erase(light.get());
+		auto iterFind = mLights.find(light.get());
+		if (iterFind == mLights.end())
+			return;
+
+		removeSOEntry(mLightsBySO, iterFind->second.sceneObjectPtr, light.get());
+
+		const HSceneObject& so = iterFind->second.sceneObject;
+		if (!so.isDestroyed())
+			so->_unregisterCoreObject();
+
+		mLights.erase(iterFind);
 	}
 
 	void SceneManager::_updateCoreObjectTransforms()
 	{
-		for (auto& renderablePair : mRenderables)
+		// Only scene objects whose transform or active state changed since last frame are processed, so the cost scales
+		// with the number of moving objects rather than the total number of objects
+		for (auto& so : mDirtySceneObjects)
 		{
-			SPtr<Renderable> handler = renderablePair.second.renderable;
-			HSceneObject so = renderablePair.second.sceneObject;
+			if (so.isDestroyed(true))
+				continue;
 
-			UINT32 curHash = so->getTransformHash();
-			if (curHash != handler->_getLastModifiedHash())
-			{
-				Matrix4 transformNoScale = Matrix4::TRS(so->getWorldPosition(), so->getWorldRotation(), Vector3::ONE);
+			so->_clearCoreObjectsDirty();
 
-				handler->setTransform(so->getWorldTfrm(), transformNoScale);
-				handler->_setLastModifiedHash(curHash);
-			}
+			SceneObject* soPtr = so.get();
+			UINT32 curHash = so->getTransformHash();
+			bool active = so->getActive();
 
-			if (so->getActive() != handler->getIsActive())
+			auto renderables = mRenderablesBySO.equal_range(soPtr);
+			for (auto iter = renderables.first; iter != renderables.second; ++iter)
 			{
-				handler->setIsActive(so->getActive());
-			}
-		}
+				Renderable* handler = iter->second;
 
-		for (auto& cameraPair : mCameras)
-		{
-			SPtr<Camera> handler = cameraPair.second.camera;
-			HSceneObject so = cameraPair.second.sceneObject;
+				if (curHash != handler->_getLastModifiedHash())
+				{
+					Matrix4 transformNoScale = Matrix4::TRS(so->getWorldPosition(), so->getWorldRotation(), Vector3::ONE);
 
-			UINT32 curHash = so->getTransformHash();
-			if (curHash != handler->_getLastModifiedHash())
-			{
-				handler->setPosition(so->getWorldPosition());
-				handler->setRotation(so->getWorldRotation());
+					// Active state changes require a full sync anyway, so only batch transform-only changes
+					if (active != handler->getIsActive())
+						handler->setTransform(so->getWorldTfrm(), transformNoScale);
+					else
+						handler->_setTransform(so->getWorldTfrm(), transformNoScale, mTransformBatch);
+
+					handler->_setLastModifiedHash(curHash);
+				}
 
-				handler->_setLastModifiedHash(curHash);
+				if (active != handler->getIsActive())
+					handler->setIsActive(active);
 			}
 
-			if (so->getActive() != handler->getIsActive())
+			auto cameras = mCamerasBySO.equal_range(soPtr);
+			for (auto iter = cameras.first; iter != cameras.second; ++iter)
 			{
-				handler->setIsActive(so->getActive());
-			}
-		}
+				Camera* handler = iter->second;
 
-		for (auto& lightPair : mLights)
-		{
-			SPtr<Light> handler = lightPair.second.light;
-			HSceneObject so = lightPair.second.sceneObject;
+				if (curHash != handler->_getLastModifiedHash())
+				{
+					handler->setPosition(so->getWorldPosition());
+					handler->setRotation(so->getWorldRotation());
 
-			UINT32 curHash = so->getTransformHash();
-			if (curHash != handler->_getLastModifiedHash())
-			{
-				handler->setPosition(so->getWorldPosition());
-				handler->setRotation(so->getWorldRotation());
+					handler->_setLastModifiedHash(curHash);
+				}
 
-				handler->_setLastModifiedHash(curHash);
+				if (active != handler->getIsActive())
+					handler->setIsActive(active);
 			}
 
-			if (so->getActive() != handler->getIsActive())
+			auto lights = mLightsBySO.equal_range(soPtr);
+			for (auto iter = lights.first; iter != lights.second; ++iter)
 			{
-				handler->setIsActive(so->getActive());
+				Light* handler = iter->second;
+
+				if (curHash != handler->_getLastModifiedHash())
+				{
+					handler->setPosition(so->getWorldPosition());
+					handler->setRotation(so->getWorldRotation());
+
+					handler->_setLastModifiedHash(curHash);
+				}
+
+				if (active != handler->getIsActive())
+					handler->setIsActive(active);
 			}
 		}
+
+		mDirtySceneObjects.clear();
+
+		Renderable::_syncTransforms(mTransformBatch);
 	}
 
 	SceneCameraData SceneManager::getMainCamera() const
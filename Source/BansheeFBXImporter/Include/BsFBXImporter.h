@@ -47,10 +47,11 @@ namespace BansheeEngine
 		void shutDownSdk();
 
 		/** 
-		 * Reads the FBX file and outputs mesh data from the read file. Sub-mesh information will be output in @p subMeshes.
+		 * Reads the FBX file and outputs mesh data from the read file. Sub-mesh information will be output in @p subMeshes,
+		 * and any animation clips in @p animationClips.
 		 */
 		SPtr<RendererMeshData> importMeshData(const Path& filePath, SPtr<const ImportOptions> importOptions, 
-			Vector<SubMesh>& subMeshes);
+			Vector<SubMesh>& subMeshes, Vector<SPtr<AnimationClip>>& animationClips);
 
 		/**
 		 * Loads the data from the file at the provided path into the provided FBX scene. Returns false if the file
@@ -101,6 +102,9 @@ namespace BansheeEngine
 		/**	Converts a set of curves containing rotation in euler angles into a set of curves using	quaternion rotation. */
 		void eulerToQuaternionCurves(FBXAnimationCurve(&eulerCurves)[3], FBXAnimationCurve(&quatCurves)[4]);
 
+		/**	Converts the imported animation clips into animation clip resources. Bone animations only. */
+		void convertAnimations(const Vector<FBXAnimationClip>& clips, Vector<SPtr<AnimationClip>>& output);
+
 		/**
 		 * Converts all the meshes from per-index attributes to per-vertex attributes.
 		 *
@@ -18,6 +18,8 @@
 #include "BsMeshImportOptions.h"
 #include "BsPhysicsMesh.h"
 #include "BsPhysics.h"
+#include "BsAnimationClip.h"
+#include "BsAnimationUtility.h"
 
 namespace BansheeEngine
 {
@@ -113,7 +115,8 @@ namespace BansheeEngine
 	SPtr<Resource> FBXImporter::import(const Path& filePath, SPtr<const ImportOptions> importOptions)
 	{
 		Vector<SubMesh> subMeshes;
-		SPtr<RendererMeshData> rendererMeshData = importMeshData(filePath, importOptions, subMeshes);
+		Vector<SPtr<AnimationClip>> animationClips;
+		SPtr<RendererMeshData> rendererMeshData = importMeshData(filePath, importOptions, subMeshes, animationClips);
 
 		const MeshImportOptions* meshImportOptions = static_cast<const MeshImportOptions*>(importOptions.get());
 
@@ -132,7 +135,8 @@ namespace BansheeEngine
 	Vector<SubResourceRaw> FBXImporter::importAll(const Path& filePath, SPtr<const ImportOptions> importOptions)
 	{
 		Vector<SubMesh> subMeshes;
-		SPtr<RendererMeshData> rendererMeshData = importMeshData(filePath, importOptions, subMeshes);
+		Vector<SPtr<AnimationClip>> animationClips;
+		SPtr<RendererMeshData> rendererMeshData = importMeshData(filePath, importOptions, subMeshes, animationClips);
 
 		const MeshImportOptions* meshImportOptions = static_cast<const MeshImportOptions*>(importOptions.get());
 
@@ -168,13 +172,16 @@ namespace BansheeEngine
 				}
 
 			}
+
+			for (auto& clip : animationClips)
+				output.push_back({ clip->getName(), clip });
 		}
 
 		return output;
 	}
 
 	SPtr<RendererMeshData> FBXImporter::importMeshData(const Path& filePath, SPtr<const ImportOptions> importOptions, 
-		Vector<SubMesh>& subMeshes)
+		Vector<SubMesh>& subMeshes, Vector<SPtr<AnimationClip>>& animationClips)
 	{
 		FbxScene* fbxScene = nullptr;
 
@@ -203,8 +210,13 @@ namespace BansheeEngine
 			importSkin(importedScene);
 
 		if (fbxImportOptions.importAnimation)
+		{
 			importAnimations(fbxScene, fbxImportOptions, importedScene);
 
+			// Bone names are read from FBX nodes, so this needs to happen before the SDK is shut down
+			convertAnimations(importedScene.clips, animationClips);
+		}
+
 		splitMeshVertices(importedScene);
 		generateMissingTangentSpace(importedScene, fbxImportOptions);
 
@@ -1300,141 +1312,88 @@ namespace BansheeEngine
 
 	void FBXImporter::eulerToQuaternionCurves(FBXAnimationCurve(&eulerCurves)[3], FBXAnimationCurve(&quatCurves)[4])
 	{
-		const float FIT_TIME = 0.33f;
-
-		INT32 numKeys = (INT32)eulerCurves[0].keyframes.size();
-
-		if (numKeys != (INT32)eulerCurves[1].keyframes.size() || numKeys != (INT32)eulerCurves[2].keyframes.size())
-			return;
-
-		auto eulerToQuaternion = [&](INT32 keyIdx, float time, const Quaternion& lastQuat)
+		AnimationCurve engineEulerCurves[3];
+		for (UINT32 i = 0; i < 3; i++)
 		{
-			Degree x = (Degree)eulerCurves[0].evaluate(time);
-			Degree y = (Degree)eulerCurves[1].evaluate(time);
-			Degree z = (Degree)eulerCurves[2].evaluate(time);
-
-			Quaternion quat(x, y, z);
+			const Vector<FBXKeyFrame>& fbxKeyframes = eulerCurves[i].keyframes;
 
-			// Flip quaternion in case rotation is over 180 degrees
-			if (keyIdx > 0)
+			Vector<Keyframe> keyframes(fbxKeyframes.size());
+			for (UINT32 j = 0; j < (UINT32)fbxKeyframes.size(); j++)
 			{
-				float dot = quat.dot(lastQuat);
-				if (dot < 0.0f)
-					quat = Quaternion(-quat.x, -quat.y, -quat.z, -quat.w);
+				keyframes[j].time = fbxKeyframes[j].time;
+				keyframes[j].value = fbxKeyframes[j].value;
+				keyframes[j].inTangent = fbxKeyframes[j].inTangent;
+				keyframes[j].outTangent = fbxKeyframes[j].outTangent;
 			}
 
-			return quat;
-		};
-
-		struct FitKeyframe
-		{
-			float time;
-			Quaternion value;
-		};
+			engineEulerCurves[i] = AnimationCurve(keyframes);
+		}
 
-		Vector<FitKeyframe> fitQuaternions(numKeys * 2);
+		AnimationCurve engineQuatCurves[4];
+		AnimationUtility::eulerToQuaternionCurves(engineEulerCurves, engineQuatCurves);
 
-		Quaternion lastQuat;
-		for (INT32 i = 0; i < numKeys; i++)
+		for (UINT32 i = 0; i < 4; i++)
 		{
-			float time = eulerCurves[0].keyframes[i].time;
-			Quaternion quat = eulerToQuaternion(i, time, lastQuat);
+			const Vector<Keyframe>& keyframes = engineQuatCurves[i].getKeyFrames();
 
-			// Calculate extra values between keys so we can better approximate tangents
-			if ((i + 1) < numKeys)
+			quatCurves[i].keyframes.resize(keyframes.size());
+			for (UINT32 j = 0; j < (UINT32)keyframes.size(); j++)
 			{
-				float nextTime = eulerCurves[0].keyframes[i + 1].time;
-				float dt = nextTime - time;
-
-				FitKeyframe& fitStart = fitQuaternions[i * 2 + 0];
-				FitKeyframe& fitEnd = fitQuaternions[i * 2 + 1];
-
-				fitStart.time = time + dt * FIT_TIME;
-				fitEnd.time = time + dt * (1.0f - FIT_TIME);
-
-				fitStart.value = eulerToQuaternion(i, fitStart.time, quat);
-				fitEnd.value = eulerToQuaternion(i, fitEnd.time, fitStart.value);
-
-				lastQuat = fitStart.value;
+				FBXKeyFrame& fbxKeyframe = quatCurves[i].keyframes[j];
+				fbxKeyframe.time = keyframes[j].time;
+				fbxKeyframe.value = keyframes[j].value;
+				fbxKeyframe.inTangent = keyframes[j].inTangent;
+				fbxKeyframe.outTangent = keyframes[j].outTangent;
 			}
+		}
+	}
 
-			// TODO - If animation is looping I should also compare last and first for continuity
-
-			for (INT32 j = 0; j < 4; j++)
+	void FBXImporter::convertAnimations(const Vector<FBXAnimationClip>& clips, Vector<SPtr<AnimationClip>>& output)
+	{
+		auto convertCurve = [](const FBXAnimationCurve& curve, float start)
+		{
+			Vector<Keyframe> keyframes(curve.keyframes.size());
+			for (UINT32 i = 0; i < (UINT32)curve.keyframes.size(); i++)
 			{
-				quatCurves[j].keyframes.push_back(FBXKeyFrame());
-				FBXKeyFrame& keyFrame = quatCurves[j].keyframes.back();
-				keyFrame.time = time;
-				keyFrame.value = quat[j];
+				const FBXKeyFrame& fbxKeyframe = curve.keyframes[i];
 
-				keyFrame.inTangent = 0;
-				keyFrame.outTangent = 0;
+				keyframes[i].time = fbxKeyframe.time - start;
+				keyframes[i].value = fbxKeyframe.value;
+				keyframes[i].inTangent = fbxKeyframe.inTangent;
+				keyframes[i].outTangent = fbxKeyframe.outTangent;
 			}
-		}
 
-		// Recalculate tangents for quaternion curves
+			return AnimationCurve(keyframes);
+		};
 
-		// TODO - There must be an analytical way to convert euler angle tangents
-		//        to quaternion tangents, but I don't want to bother figuring it out
-		//        until I have a test-bed for animation.
-		if (numKeys > 1)
+		for (auto& clip : clips)
 		{
-			// TODO - I could check per-key curve interpolation originally assigned in FBX
-			//        and use that to generate linear/constant slopes. Currently I assume 
-			//        its all cubic.
+			if (clip.boneAnimations.empty())
+				continue;
 
-			// First key
+			Vector<BoneAnimationCurves> bones(clip.boneAnimations.size());
+			for (UINT32 i = 0; i < (UINT32)clip.boneAnimations.size(); i++)
 			{
-				const FitKeyframe& fitKeyFrame = fitQuaternions[0];
-
-				for (INT32 j = 0; j < 4; j++)
-				{
-					FBXKeyFrame& keyFrame = quatCurves[j].keyframes[0];
+				const FBXBoneAnimation& boneAnim = clip.boneAnimations[i];
+				BoneAnimationCurves& bone = bones[i];
 
-					float dt = fitKeyFrame.time - keyFrame.time;
+				if (boneAnim.node != nullptr && boneAnim.node->fbxNode != nullptr)
+					bone.name = boneAnim.node->fbxNode->GetName();
 
-					keyFrame.inTangent = (fitKeyFrame.value[j] - keyFrame.value) / dt;
-					keyFrame.outTangent = keyFrame.inTangent;
-				}
-			}
-
-			// In-between keys
-			{
-				for (INT32 i = 1; i < (numKeys - 1); i++)
+				for (UINT32 j = 0; j < 3; j++)
 				{
-					const FitKeyframe& fitPointStart = fitQuaternions[i * 2 - 1];
-					const FitKeyframe& fitPointEnd = fitQuaternions[i * 2 + 0];
-
-					for (INT32 j = 0; j < 4; j++)
-					{
-						FBXKeyFrame& keyFrame = quatCurves[j].keyframes[i];
-
-						float dt0 = fitPointEnd.time - keyFrame.time;
-						float dt1 = keyFrame.time - fitPointStart.time;
-
-						float t0 = fitPointEnd.value[j] - keyFrame.value;
-						float t1 = keyFrame.value - fitPointStart.value[j];
-
-						keyFrame.inTangent = t0 / (0.5f * dt0) + t1 / (0.5f * dt1);
-						keyFrame.outTangent = keyFrame.inTangent;
-					}
+					bone.position[j] = convertCurve(boneAnim.translation[j], clip.start);
+					bone.scale[j] = convertCurve(boneAnim.scale[j], clip.start);
 				}
-			}
 
-			// Last key
-			{
-				const FitKeyframe& fitKeyFrame = fitQuaternions[(numKeys - 2) * 2];
-
-				for (INT32 j = 0; j < 4; j++)
-				{
-					FBXKeyFrame& keyFrame = quatCurves[j].keyframes[numKeys - 2];
+				for (UINT32 j = 0; j < 4; j++)
+					bone.rotation[j] = convertCurve(boneAnim.rotation[j], clip.start);
+			}
 
-					float dt = keyFrame.time - fitKeyFrame.time;
+			SPtr<AnimationClip> animClip = AnimationClip::_createPtr(bones);
+			animClip->setName(toWString(clip.name));
 
-					keyFrame.inTangent = (keyFrame.value - fitKeyFrame.value[j]) / dt;
-					keyFrame.outTangent = keyFrame.inTangent;
-				}
-			}
+			output.push_back(animClip);
 		}
 	}
 
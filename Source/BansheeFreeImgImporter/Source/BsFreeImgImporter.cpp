@@ -165,14 +165,33 @@ namespace BansheeEngine
 		else
 			mipLevels.insert(mipLevels.begin(), imgData);
 
-		for (UINT32 mip = 0; mip < (UINT32)mipLevels.size(); ++mip)
+		UINT32 numLevels = (UINT32)mipLevels.size();
+		Vector<SPtr<PixelData>> dstLevels(numLevels);
+		for (UINT32 mip = 0; mip < numLevels; ++mip)
 		{
 			UINT32 subresourceIdx = newTexture->getProperties().mapToSubresourceIdx(0, mip);
-			SPtr<PixelData> dst = newTexture->getProperties().allocateSubresourceBuffer(subresourceIdx);
+			dstLevels[mip] = newTexture->getProperties().allocateSubresourceBuffer(subresourceIdx);
+		}
 
-			PixelUtil::bulkPixelConversion(*mipLevels[mip], *dst);
+		// Compress all the mip levels at once so they can be processed in parallel, instead of one by one
+		PixelFormat dstFormat = newTexture->getProperties().getFormat();
+		if (PixelUtil::isCompressed(dstFormat) && !PixelUtil::isCompressed(imgData->getFormat()))
+		{
+			CompressionOptions compressionOptions;
+			compressionOptions.format = dstFormat;
 
-			newTexture->writeSubresource(gCoreAccessor(), subresourceIdx, dst, false);
+			PixelUtil::compress(mipLevels, dstLevels, compressionOptions);
+		}
+		else
+		{
+			for (UINT32 mip = 0; mip < numLevels; ++mip)
+				PixelUtil::bulkPixelConversion(*mipLevels[mip], *dstLevels[mip]);
+		}
+
+		for (UINT32 mip = 0; mip < numLevels; ++mip)
+		{
+			UINT32 subresourceIdx = newTexture->getProperties().mapToSubresourceIdx(0, mip);
+			newTexture->writeSubresource(gCoreAccessor(), subresourceIdx, dstLevels[mip], false);
 		}
 
 		fileData->close();
@@ -21,6 +21,9 @@ namespace BansheeEngine
 		/** @copydoc GpuParamBlockBufferCore::writeToGPU */
 		void writeToGPU(const UINT8* data) override;
 
+		/** @copydoc GpuParamBlockBufferCore::writeRangeToGPU */
+		void writeRangeToGPU(const UINT8* data, UINT32 offset, UINT32 size) override;
+
 		/** @copydoc GpuParamBlockBufferCore::readFromGPU */
 		void readFromGPU(UINT8* data) const override;
 
@@ -42,6 +42,17 @@ namespace BansheeEngine
 		glBindBuffer(GL_UNIFORM_BUFFER, 0);
 
 		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_GpuParamBuffer);
+		BS_ADD_RENDER_STAT(NumGpuParamBytesUploaded, mSize);
+	}
+
+	void GLGpuParamBlockBufferCore::writeRangeToGPU(const UINT8* data, UINT32 offset, UINT32 size)
+	{
+		glBindBuffer(GL_UNIFORM_BUFFER, mGLHandle);
+		glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data + offset);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_GpuParamBuffer);
+		BS_ADD_RENDER_STAT(NumGpuParamBytesUploaded, size);
 	}
 
 	void GLGpuParamBlockBufferCore::readFromGPU(UINT8* data) const
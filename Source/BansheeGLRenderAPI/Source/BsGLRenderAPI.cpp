@@ -460,10 +460,19 @@ namespace BansheeEngine
 		BS_INC_RENDER_STAT(NumTextureBinds);
 	}
 
+	void GLRenderAPI::setBuffer(GpuProgramType gptype, UINT16 unit, const SPtr<GpuBufferCore>& buffer, bool loadStore)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		LOGWRN("Generic buffers are not supported in OpenGL.");
+	}
+
 	void GLRenderAPI::setBlendState(const SPtr<BlendStateCore>& blendState)
 	{
 		THROW_IF_NOT_CORE_THREAD;
 
+		mActivePipelineStateId = 0;
+
 		const BlendProperties& stateProps = blendState->getProperties();
 
 		// Alpha to coverage
@@ -492,6 +501,8 @@ namespace BansheeEngine
 	{
 		THROW_IF_NOT_CORE_THREAD;
 
+		mActivePipelineStateId = 0;
+
 		const RasterizerProperties& stateProps = rasterizerState->getProperties();
 
 		setDepthBias(stateProps.getDepthBias(), stateProps.getSlopeScaledDepthBias());
@@ -515,6 +526,8 @@ namespace BansheeEngine
 	{
 		THROW_IF_NOT_CORE_THREAD;
 
+		mActivePipelineStateId = 0;
+
 		const DepthStencilProperties& stateProps = depthStencilState->getProperties();
 
 		// Set stencil buffer options
@@ -7,6 +7,8 @@
 #include "BsHardwareBufferManager.h"
 #include "BsRenderStats.h"
 #include "BsGpuParams.h"
+#include "BsGpuProgramManager.h"
+#include "BsTimer.h"
 
 namespace BansheeEngine 
 {
@@ -177,7 +179,10 @@ namespace BansheeEngine
 				lineLength = 0;
 			}
 
+			// GLSL programs don't support the program cache, they're always compiled from source
+			Timer timer;
 			mGLHandle = glCreateShaderProgramv(shaderType, (GLsizei)lines.size(), (const GLchar**)lines.data());
+			GpuProgramCoreManager::instance()._notifyProgramCreated(timer.getMicroseconds(), false);
 
 			for (auto iter = lines.rbegin(); iter != lines.rend(); ++iter)
 			{
@@ -122,10 +122,15 @@ namespace BansheeEngine
 		/**	Throws a native exception if the provided object is a valid managed exception. */
 		static void throwIfException(MonoObject* exception);
 
-		/** Invokes a thunk retrieved from MonoMethod::getThunk const and automatically handles exceptions. */
+		/** 
+		 * Invokes a thunk retrieved from MonoMethod::getThunk const and automatically handles exceptions. Native 
+		 * allocations made by the invoked method are counted in the scripting memory category.
+		 */
 		template<class T, class... Args>
 		static void invokeThunk(T* thunk, Args... args)
 		{
+			ScopedMemoryTag memoryTag(getMemoryCategoryIdx<ScriptAlloc>());
+
 			MonoException* exception = nullptr;
 			thunk(std::forward<Args>(args)..., &exception);
 
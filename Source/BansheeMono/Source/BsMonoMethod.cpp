@@ -24,6 +24,8 @@ namespace BansheeEngine
 
 	MonoObject* MonoMethod::invoke(MonoObject* instance, void** params)
 	{
+		ScopedMemoryTag memoryTag(getMemoryCategoryIdx<ScriptAlloc>());
+
 		MonoObject* exception = nullptr;
 		MonoObject* retVal = mono_runtime_invoke(mMethod, instance, params, &exception);
 
@@ -34,6 +36,7 @@ namespace BansheeEngine
 	MonoObject* MonoMethod::invokeVirtual(MonoObject* instance, void** params)
 	{
 		::MonoMethod* virtualMethod = mono_object_get_virtual_method(instance, mMethod);
+		ScopedMemoryTag memoryTag(getMemoryCategoryIdx<ScriptAlloc>());
 
 		MonoObject* exception = nullptr;
 		MonoObject* retVal = mono_runtime_invoke(virtualMethod, instance, params, &exception);
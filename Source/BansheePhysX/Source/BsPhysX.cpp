@@ -33,14 +33,14 @@ namespace BansheeEngine
 	public:
 		void* allocate(size_t size, const char*, const char*, int) override
 		{
-			void* ptr = bs_alloc_aligned16((UINT32)size);
+			void* ptr = MemoryAllocator<PhysicsAlloc>::allocateAligned16(size);
 			PX_ASSERT((reinterpret_cast<size_t>(ptr) & 15) == 0);
 			return ptr;
 		}
 
 		void deallocate(void* ptr) override
 		{
-			bs_free_aligned16(ptr);
+			MemoryAllocator<PhysicsAlloc>::freeAligned16(ptr);
 		}
 	};
 
@@ -3,10 +3,21 @@
 #ifndef __MMALLOC_H__
 #define __MMALLOC_H__
 
+/** 
+ * Memory context used by the parser. Small allocations are made from large arena blocks and are only released when
+ * the context is freed, while large allocations (e.g. include file buffers) are released as soon as they're freed.
+ * Contexts are independent from each other, so separate contexts can be used on separate threads.
+ */
 void* mmalloc_new_context();
 void mmalloc_free_context(void* context);
 void* mmalloc(void* context, int size);
 void mmfree(void* ptr);
 char* mmalloc_strdup(void* context, const char* input);
 
+/** 
+ * Returns a copy of the provided string owned by the context. The same copy is returned for all equal strings 
+ * interned in the same context, so the returned string must not be modified.
+ */
+const char* mmalloc_intern(void* context, const char* input);
+
 #endif
\ No newline at end of file
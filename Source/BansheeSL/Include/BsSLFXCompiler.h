@@ -29,6 +29,18 @@ namespace BansheeEngine
 		String errorFile; /**< File in which the error occurred. Empty if root file. */
 	};
 
+	/** Contains a breakdown of time spent in different stages of BSLFXCompiler::compile(). Times are in microseconds. */
+	struct BSLFXCompileStats
+	{
+		UINT64 parseTime = 0; /**< Time spent lexing and parsing the source into an abstract syntax tree. */
+		UINT64 shaderTime = 0; /**< Time spent converting the syntax trees into shaders, techniques and passes. */
+		UINT64 programCompileTime = 0; /**< Time spent waiting on GPU programs to compile on worker threads. */
+		UINT64 programCreateTime = 0; /**< Time spent waiting on GPU programs to be created on the core thread. */
+		UINT32 numPermutations = 0; /**< Number of permutations with unique defines that had to be parsed. */
+		UINT32 numPrograms = 0; /**< Number of GPU programs referenced by all the passes of all permutations. */
+		UINT32 numUniquePrograms = 0; /**< Number of GPU programs left after programs with identical source are merged. */
+	};
+
 	/**	Transforms a source file written in BSL FX syntax into a Shader object. */
 	class BSLFXCompiler
 	{
@@ -71,9 +83,50 @@ namespace BansheeEngine
 			Vector<PassData> passes;
 		};
 
+		/** Temporary data describing a shader after its syntax tree has been parsed. */
+		struct ShaderData
+		{
+			SHADER_DESC desc;
+			Vector<TechniqueData> techniques;
+			Vector<String> includes;
+		};
+
+		/** GPU program used by one or multiple passes. */
+		struct ProgramData
+		{
+			String source;
+			String language;
+			GpuProgramType type = GPT_VERTEX_PROGRAM;
+			GpuProgramProfile profile = GPP_NONE;
+			bool isPrecompiled = false;
+
+			SPtr<GpuProgram> program;
+		};
+
 	public:
-		/**	Transforms a source file written in BSL FX syntax into a Shader object. */
-		static BSLFXCompileResult compile(const String& source, const UnorderedMap<String, String>& defines);
+		/**
+		 * Transforms a source file written in BSL FX syntax into a Shader object.
+		 *
+		 * @param[in]	source		BSL FX source code.
+		 * @param[in]	defines		Preprocessor defines to apply to the source, as name/value pairs.
+		 * @param[out]	stats		Optional object that will receive the time spent in each compilation stage.
+		 */
+		static BSLFXCompileResult compile(const String& source, const UnorderedMap<String, String>& defines,
+			BSLFXCompileStats* stats = nullptr);
+
+		/**
+		 * Transforms a source file written in BSL FX syntax into multiple Shader objects, one for each provided set of
+		 * defines. Permutations with identical defines are only parsed once, and GPU programs with identical source are
+		 * shared between all the permutations. GPU programs are compiled in parallel using the task scheduler.
+		 *
+		 * @param[in]	source			BSL FX source code.
+		 * @param[in]	permutations	A set of preprocessor defines for each shader permutation to generate.
+		 * @param[out]	stats			Optional object that will receive the time spent in each compilation stage, for
+		 *								all permutations.
+		 * @return						One result for each entry in @p permutations, in the same order.
+		 */
+		static Vector<BSLFXCompileResult> compile(const String& source, 
+			const Vector<UnorderedMap<String, String>>& permutations, BSLFXCompileStats* stats = nullptr);
 
 	private:
 		/** Converts the provided source into an abstract syntax tree using the lexer & parser for BSL FX syntax. */
@@ -230,15 +283,36 @@ namespace BansheeEngine
 		static void parseBlocks(SHADER_DESC& desc, ASTFXNode* blocksNode);
 
 		/**
-		 * Parses the AST node hierarchy and generates a shader object.
+		 * Parses the AST node hierarchy and outputs the shader's techniques, passes and parameters. Parse state is 
+		 * deleted once done.
+		 *
+		 * @param[in, out]	parseState		Parser state object that has previously been initialized with the AST using 
+		 *									parseFX().
+		 * @param[in]		codeBlocks		GPU program source code.
+		 * @param[out]		shaderData		Parsed shader data.
+		 * @param[out]		errorMessage	Error message, in case parsing failed.
+		 * @return							True if parsing was successful.
+		 */
+		static bool parseShader(ParseState* parseState, const Vector<String>& codeBlocks, ShaderData& shaderData, 
+			String& errorMessage);
+
+		/**
+		 * Generates a shader object from the parsed shader data.
 		 *
 		 * @param[in]		name		Optional name for the shader.
-		 * @param[in, out]	parseState	Parser state object that has previously been initialized with the AST using 
-		 *								parseFX().
-		 * @param	codeBlocks			GPU program source code.
-		 * @return						A result object containing the shader if successful, or error message if not.
+		 * @param[in]		shaderData	Shader data output by parseShader().
+		 * @param[in, out]	programs	GPU programs used by the shader, keyed by getProgramKey(). Programs that weren't
+		 *								created yet will be created, and programs are reused otherwise.
 		 */
-		static BSLFXCompileResult parseShader(const String& name, ParseState* parseState, Vector<String>& codeBlocks);
+		static SPtr<Shader> createShader(const String& name, const ShaderData& shaderData, 
+			UnorderedMap<String, ProgramData>& programs);
+
+		/** Returns the code for the GPU program of the specified type in the pass, excluding the common code. */
+		static const String& getProgramCode(const PassData& passData, GpuProgramType type);
+
+		/** Returns a key uniquely identifying a GPU program. */
+		static String getProgramKey(const String& source, const String& language, GpuProgramType type, 
+			GpuProgramProfile profile);
 
 		/**
 		 * Converts a null-terminated string into a standard string, and eliminates quotes that are assumed to be at the 
@@ -251,6 +325,8 @@ namespace BansheeEngine
 
 		/** Returns one of the builtin textures based on their name. */
 		static HTexture getBuiltinTexture(const String& name);
+
+		static const GpuProgramType PROGRAM_TYPES[6];
 	};
 
 	/** @} */
@@ -30,8 +30,23 @@ namespace BansheeEngine
 		/** @copydoc SpecificImporter::import */
 		virtual SPtr<Resource> import(const Path& filePath, SPtr<const ImportOptions> importOptions) override;
 
+		/** 
+		 * @copydoc SpecificImporter::importAll 
+		 *
+		 * Returns the primary shader, followed by a shader for each permutation specified in ShaderImportOptions.
+		 */
+		virtual Vector<SubResourceRaw> importAll(const Path& filePath, SPtr<const ImportOptions> importOptions) override;
+
 		/** @copydoc SpecificImporter::createImportOptions */
 		virtual SPtr<ImportOptions> createImportOptions() const override;
+
+	private:
+		/** 
+		 * Compiles the primary shader, and optionally all its permutations, in a single pass. Returns an empty list if 
+		 * the primary shader fails to compile. Permutations that fail to compile are skipped.
+		 */
+		Vector<SubResourceRaw> importShaders(const Path& filePath, SPtr<const ImportOptions> importOptions, 
+			bool includePermutations);
 	};
 
 	/** @} */
@@ -4,61 +4,146 @@
 #include <stdlib.h>
 #include <string.h>
 
-typedef struct tagMMAllocHeader MMAllocHeader;
+// Size of a single arena block small allocations are carved out of
+#define MMALLOC_BLOCK_SIZE 16384
 
-struct tagMMAllocHeader
+// Allocations larger than this are allocated separately, so they can be freed before the context is freed
+#define MMALLOC_LARGE_SIZE 1024
+
+#define MMALLOC_NUM_INTERN_BUCKETS 256
+
+typedef struct tagMMAllocBlock MMAllocBlock;
+typedef struct tagMMAllocLarge MMAllocLarge;
+typedef struct tagMMAllocIntern MMAllocIntern;
+typedef struct tagMMAllocContext MMAllocContext;
+
+// Precedes every allocation. Points to the large allocation info, or null if allocated from an arena block.
+typedef union tagMMAllocHeader
+{
+	MMAllocLarge* large;
+	double alignment;
+} MMAllocHeader;
+
+#define MMALLOC_ALIGN(x) (((x) + sizeof(MMAllocHeader) - 1) & ~(sizeof(MMAllocHeader) - 1))
+
+struct tagMMAllocBlock
+{
+	MMAllocBlock* next;
+	int size;
+	int used;
+};
+
+struct tagMMAllocLarge
+{
+	MMAllocLarge* next;
+	MMAllocLarge* prev;
+};
+
+struct tagMMAllocIntern
+{
+	MMAllocIntern* next;
+	unsigned int hash;
+	const char* value;
+};
+
+struct tagMMAllocContext
 {
-	MMAllocHeader* next;
-	MMAllocHeader* prev;
+	MMAllocBlock* blocks;
+	MMAllocLarge large;
+	MMAllocIntern* internBuckets[MMALLOC_NUM_INTERN_BUCKETS];
 };
 
 void* mmalloc_new_context()
 {
-	MMAllocHeader* header = (MMAllocHeader*)malloc(sizeof(MMAllocHeader));
-	header->next = 0;
-	header->prev = 0;
+	MMAllocContext* context = (MMAllocContext*)malloc(sizeof(MMAllocContext));
+	memset(context, 0, sizeof(MMAllocContext));
 
-	return header;
+	return context;
 }
 
 void mmalloc_free_context(void* context)
 {
-	MMAllocHeader* header = (MMAllocHeader*)context;
-	while (header->next != 0)
-		mmfree((char*)header->next + sizeof(MMAllocHeader));
+	MMAllocContext* ctx = (MMAllocContext*)context;
+	MMAllocBlock* block = ctx->blocks;
+	MMAllocLarge* large = ctx->large.next;
 
-	free(header);
+	while (block != 0)
+	{
+		MMAllocBlock* next = block->next;
+		free(block);
+
+		block = next;
+	}
+
+	while (large != 0)
+	{
+		MMAllocLarge* next = large->next;
+		free(large);
+
+		large = next;
+	}
+
+	free(ctx);
 }
 
 void* mmalloc(void* context, int size)
 {
-	void* buffer = malloc(size + sizeof(MMAllocHeader));
+	MMAllocContext* ctx = (MMAllocContext*)context;
+	MMAllocBlock* block = ctx->blocks;
+	MMAllocHeader* header = 0;
+	int blockHeaderSize = (int)MMALLOC_ALIGN(sizeof(MMAllocBlock));
+	int totalSize = (int)(MMALLOC_ALIGN(size) + sizeof(MMAllocHeader));
+
+	if (size > MMALLOC_LARGE_SIZE)
+	{
+		MMAllocLarge* large = (MMAllocLarge*)malloc(MMALLOC_ALIGN(sizeof(MMAllocLarge)) + totalSize);
+
+		large->next = ctx->large.next;
+		if (ctx->large.next)
+			ctx->large.next->prev = large;
+
+		large->prev = &ctx->large;
+		ctx->large.next = large;
 
-	MMAllocHeader* header = (MMAllocHeader*)buffer;
-	MMAllocHeader* parent = (MMAllocHeader*)context;
+		header = (MMAllocHeader*)((char*)large + MMALLOC_ALIGN(sizeof(MMAllocLarge)));
+		header->large = large;
 
-	header->next = parent->next;
-	if (parent->next)
-		parent->next->prev = header;
+		return header + 1;
+	}
 
-	header->prev = parent;
-	parent->next = header;
+	if (block == 0 || (block->used + totalSize) > block->size)
+	{
+		block = (MMAllocBlock*)malloc(blockHeaderSize + MMALLOC_BLOCK_SIZE);
+		block->size = MMALLOC_BLOCK_SIZE;
+		block->used = 0;
+		block->next = ctx->blocks;
 
-	return (char*)buffer + sizeof(MMAllocHeader);
+		ctx->blocks = block;
+	}
+
+	header = (MMAllocHeader*)((char*)block + blockHeaderSize + block->used);
+	header->large = 0;
+
+	block->used += totalSize;
+	return header + 1;
 }
 
 void mmfree(void* ptr)
 {
-	void* buffer = (char*)ptr - sizeof(MMAllocHeader);
-	MMAllocHeader* header = (MMAllocHeader*)buffer;
+	MMAllocHeader* header = (MMAllocHeader*)ptr - 1;
+	MMAllocLarge* large = header->large;
 
-	if (header->prev)
-		header->prev->next = header->next;
+	// Memory allocated from arena blocks is only released along with the context
+	if (large == 0)
+		return;
 
-	if (header->next)
-		header->next->prev = header->prev;
+	if (large->prev)
+		large->prev->next = large->next;
 
-	free(buffer);
+	if (large->next)
+		large->next->prev = large->prev;
+
+	free(large);
 }
 
 char* mmalloc_strdup(void* context, const char* input)
@@ -70,4 +155,37 @@ char* mmalloc_strdup(void* context, const char* input)
 	output[length] = '\0';
 
 	return output;
-}
\ No newline at end of file
+}
+
+const char* mmalloc_intern(void* context, const char* input)
+{
+	MMAllocContext* ctx = (MMAllocContext*)context;
+	MMAllocIntern* entry = 0;
+	unsigned int hash = 2166136261u;
+	const char* iter = input;
+
+	while (*iter != '\0')
+	{
+		hash ^= (unsigned char)*iter;
+		hash *= 16777619u;
+
+		iter++;
+	}
+
+	entry = ctx->internBuckets[hash % MMALLOC_NUM_INTERN_BUCKETS];
+	while (entry != 0)
+	{
+		if (entry->hash == hash && strcmp(entry->value, input) == 0)
+			return entry->value;
+
+		entry = entry->next;
+	}
+
+	entry = (MMAllocIntern*)mmalloc(context, sizeof(MMAllocIntern));
+	entry->hash = hash;
+	entry->value = mmalloc_strdup(context, input);
+	entry->next = ctx->internBuckets[hash % MMALLOC_NUM_INTERN_BUCKETS];
+
+	ctx->internBuckets[hash % MMALLOC_NUM_INTERN_BUCKETS] = entry;
+	return entry->value;
+}
@@ -97,7 +97,7 @@ void nodeOptionDelete(NodeOption* option)
 	}
 	else if (OPTION_LOOKUP[(int)option->type].dataType == ODT_String)
 	{
-		mmfree((void*)option->value.strValue);
+		// Strings are interned and shared between options, they get released along with the memory context
 		option->value.strValue = 0;
 	}
 }
@@ -402,10 +402,7 @@ ParseState* parseStateCreate()
 
 void parseStateDelete(ParseState* parseState)
 {
-	while (parseState->nodeStack != 0)
-		nodePop(parseState);
-
-	nodeDelete(parseState->rootNode);
+	// All nodes are allocated from the memory context, so there's no need to delete them individually
 	mmalloc_free_context(parseState->memContext);
 
 	free(parseState);
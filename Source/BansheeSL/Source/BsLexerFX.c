@@ -1457,7 +1457,7 @@ YY_RULE_SETUP
 case 5:
 YY_RULE_SETUP
 #line 44 "../../../Source/BansheeSL/BsLexerFX.l"
-{ yylval->strValue = mmalloc_strdup(yyextra->memContext, yytext); return TOKEN_STRING; }
+{ yylval->strValue = mmalloc_intern(yyextra->memContext, yytext); return TOKEN_STRING; }
 	YY_BREAK
 case 6:
 YY_RULE_SETUP
@@ -2685,7 +2685,7 @@ YY_RULE_SETUP
 case 230:
 YY_RULE_SETUP
 #line 393 "../../../Source/BansheeSL/BsLexerFX.l"
-{ yylval->strValue = mmalloc_strdup(yyextra->memContext, yytext); return TOKEN_IDENTIFIER; }
+{ yylval->strValue = mmalloc_intern(yyextra->memContext, yytext); return TOKEN_IDENTIFIER; }
 	YY_BREAK
 case 231:
 YY_RULE_SETUP
@@ -13,6 +13,9 @@
 #include "BsShaderInclude.h"
 #include "BsMatrix4.h"
 #include "BsBuiltinResources.h"
+#include "BsGpuProgramManager.h"
+#include "BsTaskScheduler.h"
+#include "BsTimer.h"
 
 extern "C" {
 #include "BsMMAlloc.h"
@@ -24,6 +27,12 @@ using namespace std;
 
 namespace BansheeEngine
 {
+	const GpuProgramType BSLFXCompiler::PROGRAM_TYPES[] = 
+	{
+		GPT_VERTEX_PROGRAM, GPT_FRAGMENT_PROGRAM, GPT_GEOMETRY_PROGRAM, GPT_HULL_PROGRAM, GPT_DOMAIN_PROGRAM, 
+		GPT_COMPUTE_PROGRAM
+	};
+
 	// Print out the FX AST, only for debug purposes
 	void SLFXDebugPrint(ASTFXNode* node, String indent)
 	{
@@ -68,42 +77,93 @@ namespace BansheeEngine
 		}
 	}
 
-	BSLFXCompileResult BSLFXCompiler::compile(const String& source, const UnorderedMap<String, String>& defines)
+	BSLFXCompileResult BSLFXCompiler::compile(const String& source, const UnorderedMap<String, String>& defines,
+		BSLFXCompileStats* stats)
+	{
+		Vector<UnorderedMap<String, String>> permutations = { defines };
+		return compile(source, permutations, stats)[0];
+	}
+
+	Vector<BSLFXCompileResult> BSLFXCompiler::compile(const String& source, 
+		const Vector<UnorderedMap<String, String>>& permutations, BSLFXCompileStats* stats)
 	{
-		BSLFXCompileResult output;
+		BSLFXCompileStats localStats;
+		if (stats == nullptr)
+			stats = &localStats;
 
-		String parsedSource = source;
+		*stats = BSLFXCompileStats();
 
-		ParseState* parseState = parseStateCreate();
-		for(auto& define : defines)
+		// Defines are applied by the lexer, so the syntax tree depends on them. Only permutations with identical defines 
+		// can share the tree.
+		Vector<UINT32> permutationToUnique(permutations.size());
+		Vector<const UnorderedMap<String, String>*> uniqueDefines;
+		Map<Map<String, String>, UINT32> uniqueLookup;
+
+		for (UINT32 i = 0; i < (UINT32)permutations.size(); i++)
 		{
-			if (define.first.size() == 0)
-				continue;
+			Map<String, String> sortedDefines(permutations[i].begin(), permutations[i].end());
 
-			addDefine(parseState, define.first.c_str());
+			auto iterFind = uniqueLookup.find(sortedDefines);
+			if (iterFind != uniqueLookup.end())
+			{
+				permutationToUnique[i] = iterFind->second;
+				continue;
+			}
 
-			if(define.second.size() > 0)
-				addDefineExpr(parseState, define.second.c_str());
+			UINT32 uniqueIdx = (UINT32)uniqueDefines.size();
+			uniqueLookup[sortedDefines] = uniqueIdx;
+			uniqueDefines.push_back(&permutations[i]);
+			permutationToUnique[i] = uniqueIdx;
 		}
 
-		parseFX(parseState, parsedSource.c_str());
+		UINT32 numUnique = (UINT32)uniqueDefines.size();
+		stats->numPermutations = numUnique;
+
+		Vector<BSLFXCompileResult> uniqueOutput(numUnique);
+		Vector<ShaderData> shaderData(numUnique);
+		Vector<bool> isParsed(numUnique, false);
 
-		if (parseState->hasError > 0)
+		// Parse. Include files are looked up through the importer and the resources system while parsing, which isn't 
+		// thread safe, so this part stays on the calling thread.
+		Timer timer;
+		for (UINT32 i = 0; i < numUnique; i++)
 		{
-			output.errorMessage = parseState->errorMessage;
-			output.errorLine = parseState->errorLine;
-			output.errorColumn = parseState->errorColumn;
+			timer.reset();
 
-			if(parseState->errorFile != nullptr)
-				output.errorFile = parseState->errorFile;
+			ParseState* parseState = parseStateCreate();
+			for (auto& define : *uniqueDefines[i])
+			{
+				if (define.first.size() == 0)
+					continue;
+
+				addDefine(parseState, define.first.c_str());
+
+				if (define.second.size() > 0)
+					addDefineExpr(parseState, define.second.c_str());
+			}
+
+			parseFX(parseState, source.c_str());
+			stats->parseTime += timer.getMicroseconds();
+
+			BSLFXCompileResult& output = uniqueOutput[i];
+			if (parseState->hasError > 0)
+			{
+				output.errorMessage = parseState->errorMessage;
+				output.errorLine = parseState->errorLine;
+				output.errorColumn = parseState->errorColumn;
+
+				if (parseState->errorFile != nullptr)
+					output.errorFile = parseState->errorFile;
+
+				parseStateDelete(parseState);
+				continue;
+			}
 
-			parseStateDelete(parseState);
-		}
-		else
-		{
 			// Only enable for debug purposes
 			//SLFXDebugPrint(parseState->rootNode, "");
 
+			timer.reset();
+
 			Vector<String> codeBlocks;
 			CodeString* codeString = parseState->codeStrings;
 			while(codeString != nullptr)
@@ -115,43 +175,143 @@ namespace BansheeEngine
 				codeString = codeString->next;
 			}
 
-			output = parseShader("Shader", parseState, codeBlocks);
+			isParsed[i] = parseShader(parseState, codeBlocks, shaderData[i], output.errorMessage);
+			stats->shaderTime += timer.getMicroseconds();
+		}
+
+		// Find all GPU programs used by the parsed shaders. Programs with identical source are shared between passes,
+		// techniques and permutations.
+		UnorderedMap<String, ProgramData> programs;
+		for (UINT32 i = 0; i < numUnique; i++)
+		{
+			if (!isParsed[i])
+				continue;
+
+			for (auto& techniqueData : shaderData[i].techniques)
+			{
+				for (auto& passData : techniqueData.passes)
+				{
+					for (auto& type : PROGRAM_TYPES)
+					{
+						const String& code = getProgramCode(passData, type);
+						if (code.empty())
+							continue;
+
+						stats->numPrograms++;
+
+						String programSource = passData.commonCode + code;
+						GpuProgramProfile profile = getProfile(techniqueData.renderAPI, type);
+						String key = getProgramKey(programSource, techniqueData.language, type, profile);
+
+						if (programs.find(key) != programs.end())
+							continue;
+
+						ProgramData& programData = programs[key];
+						programData.source = programSource;
+						programData.language = techniqueData.language;
+						programData.type = type;
+						programData.profile = profile;
+					}
+				}
+			}
+		}
+
+		stats->numUniquePrograms = (UINT32)programs.size();
+
+		// Compile the programs on worker threads. Programs are still created on the core thread, but that will now only
+		// need to load the compiled binaries. Render APIs that can't create programs from binaries will skip this step 
+		// and compile the programs on the core thread instead.
+		timer.reset();
+
+		Vector<ProgramData*> programsToCompile;
+		for (auto& entry : programs)
+			programsToCompile.push_back(&entry.second);
+
+		UINT32 numPrograms = (UINT32)programsToCompile.size();
+		UINT32 numTasks = TaskScheduler::getNumTasks(numPrograms, 1);
+		TaskScheduler::runParallel("BSLProgramCompile", numPrograms, numTasks, [&](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i++)
+			{
+				ProgramData* programData = programsToCompile[i];
+				programData->isPrecompiled = GpuProgramCoreManager::instance().precompile(programData->source, "main", 
+					programData->language, programData->type, programData->profile);
+			}
+		});
+
+		stats->programCompileTime = timer.getMicroseconds();
+
+		// Create the shaders
+		for (UINT32 i = 0; i < numUnique; i++)
+		{
+			if (!isParsed[i])
+				continue;
+
+			timer.reset();
+
+			uniqueOutput[i].shader = createShader("Shader", shaderData[i], programs);
+			stats->shaderTime += timer.getMicroseconds();
+		}
+
+		timer.reset();
+
+		for (auto& entry : programs)
+		{
+			if (entry.second.program != nullptr)
+				entry.second.program->blockUntilCoreInitialized();
+		}
+
+		stats->programCreateTime = timer.getMicroseconds();
+
+		// Created programs have their own copies of the binaries by now. This also frees binaries of programs that 
+		// never got created (e.g. if creating their shader failed).
+		for (auto& entry : programs)
+		{
+			const ProgramData& programData = entry.second;
+			if (!programData.isPrecompiled)
+				continue;
+
+			GpuProgramCoreManager::instance().releasePrecompiled(programData.source, "main", programData.language, 
+				programData.type, programData.profile);
+		}
+
+		for (auto& output : uniqueOutput)
+		{
+			if (output.shader == nullptr)
+				continue;
 
 			StringStream gpuProgError;
 			bool hasError = false;
-			if (output.shader != nullptr)
+
+			SPtr<Technique> bestTechnique = output.shader->getBestTechnique();
+			if (bestTechnique != nullptr)
 			{
-				SPtr<Technique> bestTechnique = output.shader->getBestTechnique();
+				UINT32 numPasses = bestTechnique->getNumPasses();
 
-				if (bestTechnique != nullptr)
+				for (UINT32 i = 0; i < numPasses; i++)
 				{
-					UINT32 numPasses = bestTechnique->getNumPasses();
+					SPtr<Pass> pass = bestTechnique->getPass(i);
 
-					for (UINT32 i = 0; i < numPasses; i++)
+					auto checkCompileStatus = [&](const String& prefix, const SPtr<GpuProgram>& prog)
 					{
-						SPtr<Pass> pass = bestTechnique->getPass(i);
-
-						auto checkCompileStatus = [&](const String& prefix, const SPtr<GpuProgram>& prog)
+						if (prog != nullptr)
 						{
-							if (prog != nullptr)
-							{
-								prog->blockUntilCoreInitialized();
+							prog->blockUntilCoreInitialized();
 
-								if (!prog->isCompiled())
-								{
-									hasError = true;
-									gpuProgError << prefix <<": " << prog->getCompileErrorMessage() << std::endl;
-								}
+							if (!prog->isCompiled())
+							{
+								hasError = true;
+								gpuProgError << prefix <<": " << prog->getCompileErrorMessage() << std::endl;
 							}
-						};
-
-						checkCompileStatus("Vertex program", pass->getVertexProgram());
-						checkCompileStatus("Fragment program", pass->getFragmentProgram());
-						checkCompileStatus("Geometry program", pass->getGeometryProgram());
-						checkCompileStatus("Hull program", pass->getHullProgram());
-						checkCompileStatus("Domain program", pass->getDomainProgram());
-						checkCompileStatus("Compute program", pass->getComputeProgram());
-					}
+						}
+					};
+
+					checkCompileStatus("Vertex program", pass->getVertexProgram());
+					checkCompileStatus("Fragment program", pass->getFragmentProgram());
+					checkCompileStatus("Geometry program", pass->getGeometryProgram());
+					checkCompileStatus("Hull program", pass->getHullProgram());
+					checkCompileStatus("Domain program", pass->getDomainProgram());
+					checkCompileStatus("Compute program", pass->getComputeProgram());
 				}
 			}
 
@@ -164,6 +324,10 @@ namespace BansheeEngine
 			}
 		}
 
+		Vector<BSLFXCompileResult> output(permutations.size());
+		for (UINT32 i = 0; i < (UINT32)permutations.size(); i++)
+			output[i] = uniqueOutput[permutationToUnique[i]];
+
 		return output;
 	}
 
@@ -1211,17 +1375,18 @@ namespace BansheeEngine
 		}
 	}
 
-	BSLFXCompileResult BSLFXCompiler::parseShader(const String& name, ParseState* parseState, Vector<String>& codeBlocks)
+	bool BSLFXCompiler::parseShader(ParseState* parseState, const Vector<String>& codeBlocks, ShaderData& shaderData,
+		String& errorMessage)
 	{
-		BSLFXCompileResult output;
-
 		if (parseState->rootNode == nullptr || parseState->rootNode->type != NT_Shader)
 		{
-			output.errorMessage = "Root not is null or not a shader.";
-			return output;
+			errorMessage = "Root not is null or not a shader.";
+			parseStateDelete(parseState);
+
+			return false;
 		}
 
-		SHADER_DESC shaderDesc;
+		SHADER_DESC& shaderDesc = shaderData.desc;
 		Vector<pair<ASTFXNode*, TechniqueData>> techniqueData;
 
 		// Go in reverse because options are added in reverse order during parsing
@@ -1274,13 +1439,49 @@ namespace BansheeEngine
 			}
 		}
 
-		Vector<SPtr<Technique>> techniques;
-		for(auto& entry : techniqueData)
+		for (auto& entry : techniqueData)
+			shaderData.techniques.push_back(entry.second);
+
+		IncludeLink* includeLink = parseState->includes;
+		while(includeLink != nullptr)
 		{
-			const TechniqueData& techniqueData = entry.second;
+			String includeFilename = includeLink->data->filename;
+
+			auto iterFind = std::find(shaderData.includes.begin(), shaderData.includes.end(), includeFilename);
+			if (iterFind == shaderData.includes.end())
+				shaderData.includes.push_back(includeFilename);
+
+			includeLink = includeLink->next;
+		}
+
+		parseStateDelete(parseState);
+		return true;
+	}
 
+	SPtr<Shader> BSLFXCompiler::createShader(const String& name, const ShaderData& shaderData, 
+		UnorderedMap<String, ProgramData>& programs)
+	{
+		auto getProgram = [&](const TechniqueData& techniqueData, const PassData& passData, GpuProgramType type)
+		{
+			const String& code = getProgramCode(passData, type);
+			if (code.empty())
+				return SPtr<GpuProgram>();
+
+			String source = passData.commonCode + code;
+			GpuProgramProfile profile = getProfile(techniqueData.renderAPI, type);
+
+			ProgramData& programData = programs[getProgramKey(source, techniqueData.language, type, profile)];
+			if (programData.program == nullptr)
+				programData.program = GpuProgram::create(source, "main", techniqueData.language, type, profile);
+
+			return programData.program;
+		};
+
+		Vector<SPtr<Technique>> techniques;
+		for(auto& techniqueData : shaderData.techniques)
+		{
 			Map<UINT32, SPtr<Pass>, std::greater<UINT32>> passes;
-			for (auto& passData : entry.second.passes)
+			for (auto& passData : techniqueData.passes)
 			{
 				PASS_DESC passDesc;
 
@@ -1293,41 +1494,12 @@ namespace BansheeEngine
 				if (!passData.depthStencilIsDefault)
 					passDesc.depthStencilState = DepthStencilState::create(passData.depthStencilDesc);
 
-				if (!passData.vertexCode.empty())
-				{
-					passDesc.vertexProgram = GpuProgram::create(passData.commonCode + passData.vertexCode, "main", 
-						techniqueData.language, GPT_VERTEX_PROGRAM, getProfile(techniqueData.renderAPI, GPT_VERTEX_PROGRAM));
-				}
-
-				if (!passData.fragmentCode.empty())
-				{
-					passDesc.fragmentProgram = GpuProgram::create(passData.commonCode + passData.fragmentCode, "main", 
-						techniqueData.language, GPT_FRAGMENT_PROGRAM, getProfile(techniqueData.renderAPI, GPT_FRAGMENT_PROGRAM));
-				}
-
-				if (!passData.geometryCode.empty())
-				{
-					passDesc.geometryProgram = GpuProgram::create(passData.commonCode + passData.geometryCode, "main", 
-						techniqueData.language, GPT_GEOMETRY_PROGRAM, getProfile(techniqueData.renderAPI, GPT_GEOMETRY_PROGRAM));
-				}
-
-				if (!passData.hullCode.empty())
-				{
-					passDesc.hullProgram = GpuProgram::create(passData.commonCode + passData.hullCode, "main", 
-						techniqueData.language, GPT_HULL_PROGRAM, getProfile(techniqueData.renderAPI, GPT_HULL_PROGRAM));
-				}
-
-				if (!passData.domainCode.empty())
-				{
-					passDesc.domainProgram = GpuProgram::create(passData.commonCode + passData.domainCode, "main", 
-						techniqueData.language, GPT_DOMAIN_PROGRAM, getProfile(techniqueData.renderAPI, GPT_DOMAIN_PROGRAM));
-				}
-
-				if (!passData.computeCode.empty())
-				{
-					passDesc.computeProgram = GpuProgram::create(passData.commonCode + passData.computeCode, "main", 
-						techniqueData.language, GPT_COMPUTE_PROGRAM, getProfile(techniqueData.renderAPI, GPT_COMPUTE_PROGRAM));
-				}
+				passDesc.vertexProgram = getProgram(techniqueData, passData, GPT_VERTEX_PROGRAM);
+				passDesc.fragmentProgram = getProgram(techniqueData, passData, GPT_FRAGMENT_PROGRAM);
+				passDesc.geometryProgram = getProgram(techniqueData, passData, GPT_GEOMETRY_PROGRAM);
+				passDesc.hullProgram = getProgram(techniqueData, passData, GPT_HULL_PROGRAM);
+				passDesc.domainProgram = getProgram(techniqueData, passData, GPT_DOMAIN_PROGRAM);
+				passDesc.computeProgram = getProgram(techniqueData, passData, GPT_COMPUTE_PROGRAM);
 
 				passDesc.stencilRefValue = passData.stencilRefValue;
 
@@ -1347,25 +1519,35 @@ namespace BansheeEngine
 			}
 		}
 
-		Vector<String> includes;
-		IncludeLink* includeLink = parseState->includes;
-		while(includeLink != nullptr)
-		{
-			String includeFilename = includeLink->data->filename;
+		SPtr<Shader> shader = Shader::_createPtr(name, shaderData.desc, techniques);
+		shader->setIncludeFiles(shaderData.includes);
 
-			auto iterFind = std::find(includes.begin(), includes.end(), includeFilename);
-			if (iterFind == includes.end())
-				includes.push_back(includeFilename);
+		return shader;
+	}
 
-			includeLink = includeLink->next;
+	const String& BSLFXCompiler::getProgramCode(const PassData& passData, GpuProgramType type)
+	{
+		switch (type)
+		{
+		case GPT_VERTEX_PROGRAM:
+			return passData.vertexCode;
+		case GPT_FRAGMENT_PROGRAM:
+			return passData.fragmentCode;
+		case GPT_GEOMETRY_PROGRAM:
+			return passData.geometryCode;
+		case GPT_HULL_PROGRAM:
+			return passData.hullCode;
+		case GPT_DOMAIN_PROGRAM:
+			return passData.domainCode;
+		default:
+			return passData.computeCode;
 		}
+	}
 
-		parseStateDelete(parseState);
-
-		output.shader = Shader::_createPtr(name, shaderDesc, techniques);
-		output.shader->setIncludeFiles(includes);
-
-		return output;
+	String BSLFXCompiler::getProgramKey(const String& source, const String& language, GpuProgramType type, 
+		GpuProgramProfile profile)
+	{
+		return language + ":" + toString((UINT32)type) + ":" + toString((UINT32)profile) + ":" + source;
 	}
 
 	String BSLFXCompiler::removeQuotes(const char* input)
@@ -33,28 +33,97 @@ namespace BansheeEngine
 	}
 
 	SPtr<Resource> SLImporter::import(const Path& filePath, SPtr<const ImportOptions> importOptions)
+	{
+		Vector<SubResourceRaw> shaders = importShaders(filePath, importOptions, false);
+		if (shaders.empty())
+			return nullptr;
+
+		return shaders[0].value;
+	}
+
+	Vector<SubResourceRaw> SLImporter::importAll(const Path& filePath, SPtr<const ImportOptions> importOptions)
+	{
+		return importShaders(filePath, importOptions, true);
+	}
+
+	Vector<SubResourceRaw> SLImporter::importShaders(const Path& filePath, SPtr<const ImportOptions> importOptions, 
+		bool includePermutations)
 	{
 		SPtr<DataStream> stream = FileSystem::openFile(filePath);
 		String source = stream->getAsString();
 
 		SPtr<const ShaderImportOptions> io = std::static_pointer_cast<const ShaderImportOptions>(importOptions);
-		BSLFXCompileResult result = BSLFXCompiler::compile(source, io->getDefines());
 
-		if (result.shader != nullptr)
-			result.shader->setName(filePath.getWFilename(false));
-		else
+		// Primary shader is compiled together with the permutations, so they can share parsing and GPU program work
+		Vector<String> names = { "primary" };
+		Vector<UnorderedMap<String, String>> permutations = { io->getDefines() };
+		if (includePermutations)
+		{
+			for (auto& entry : io->getPermutations())
+			{
+				if (entry.first == names[0])
+				{
+					LOGWRN("Shader permutation name \"" + entry.first + "\" is reserved for the primary shader. "
+						"Skipping.");
+					continue;
+				}
+
+				UnorderedMap<String, String> defines = io->getDefines();
+				for (auto& define : entry.second)
+					defines[define.first] = define.second;
+
+				names.push_back(entry.first);
+				permutations.push_back(defines);
+			}
+		}
+
+		BSLFXCompileStats stats;
+		Vector<BSLFXCompileResult> results = BSLFXCompiler::compile(source, permutations, &stats);
+
+		LOGDBG("Compiled shader \"" + filePath.toString() + "\" (" + toString(stats.numPermutations) + 
+			" permutation(s), " + toString(stats.numUniquePrograms) + "/" + toString(stats.numPrograms) + 
+			" unique GPU programs). Parse: " + toString(stats.parseTime) + "us, shaders: " + 
+			toString(stats.shaderTime) + "us, program compile: " + toString(stats.programCompileTime) + 
+			"us, program create: " + toString(stats.programCreateTime) + "us.");
+
+		WString fileName = filePath.getWFilename(false);
+
+		Vector<SubResourceRaw> output;
+		for (UINT32 i = 0; i < (UINT32)results.size(); i++)
 		{
-			String file;
-			if (result.errorFile.empty())
-				file = filePath.toString();
+			BSLFXCompileResult& result = results[i];
+			if (result.shader == nullptr)
+			{
+				String file;
+				if (result.errorFile.empty())
+					file = filePath.toString();
+				else
+					file = result.errorFile;
+
+				String permutation;
+				if (i > 0)
+					permutation = " (permutation \"" + names[i] + "\")";
+
+				LOGERR("Error while parsing shader FX code \"" + file + "\"" + permutation + ":\n" + 
+					result.errorMessage + ". Location: " + toString(result.errorLine) + " (" + 
+					toString(result.errorColumn) + ")");
+
+				// Primary resource must always come first
+				if (i == 0)
+					return Vector<SubResourceRaw>();
+
+				continue;
+			}
+
+			if (i == 0)
+				result.shader->setName(fileName);
 			else
-				file = result.errorFile;
+				result.shader->setName(fileName + L"_" + toWString(names[i]));
 
-			LOGERR("Error while parsing shader FX code \"" + file + "\":\n" + result.errorMessage + ". Location: " +
-				toString(result.errorLine) + " (" + toString(result.errorColumn) + ")");
+			output.push_back({ toWString(names[i]), result.shader });
 		}
 
-		return result.shader;
+		return output;
 	}
 
 	SPtr<ImportOptions> SLImporter::createImportOptions() const
@@ -96,6 +96,7 @@ set(BS_BANSHEEUTILITY_SRC_ALLOCATORS
 	"Source/BsGlobalFrameAlloc.cpp"
 	"Source/BsMemStack.cpp"
 	"Source/BsMemoryAllocator.cpp"
+	"Source/BsSmallObjectAlloc.cpp"
 )
 
 set(BS_BANSHEEUTILITY_SRC_RTTI
@@ -121,6 +122,8 @@ set(BS_BANSHEEUTILITY_INC_ALLOCATORS
 	"Include/BsMemoryAllocator.h"
 	"Include/BsMemStack.h"
 	"Include/BsStaticAlloc.h"
+	"Include/BsSmallObjectAlloc.h"
+	"Include/BsMemoryCategories.h"
 )
 
 set(BS_BANSHEEUTILITY_INC_THIRDPARTY
@@ -155,6 +158,7 @@ set(BS_BANSHEEUTILITY_SRC_MATH
 	"Source/BsRect2I.cpp"
 	"Source/BsLineSegment3.cpp"
 	"Source/BsCapsule.cpp"
+	"Source/BsBatchMath.cpp"
 )
 
 set(BS_BANSHEEUTILITY_INC_TESTING
@@ -201,6 +205,7 @@ set(BS_BANSHEEUTILITY_INC_MATH
 	"Include/BsCapsule.h"
 	"Include/BsMatrixNxM.h"
 	"Include/BsVectorNI.h"
+	"Include/BsBatchMath.h"
 )
 
 set(BS_BANSHEEUTILITY_SRC_ERROR
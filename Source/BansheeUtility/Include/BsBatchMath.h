@@ -0,0 +1,74 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsPrerequisitesUtil.h"
+#include "BsVector3.h"
+#include "BsQuaternion.h"
+#include "BsMatrix4.h"
+#include "BsAABox.h"
+
+namespace BansheeEngine
+{
+	/** @addtogroup Math
+	 *  @{
+	 */
+
+	/**
+	 * Performs common math operations on arrays of values at once. Values are processed four at a time using SIMD
+	 * instructions (SSE on x86, NEON on ARM), falling back to scalar code on other platforms. Results match the
+	 * equivalent per-object methods on Matrix4 and AABox, within floating point precision.
+	 *
+	 * Prefer these over per-object operations whenever many objects are processed together (e.g. updating transforms of
+	 * all renderables in a frame).
+	 *
+	 * @note	Input and output arrays may be the same array, but may not otherwise overlap.
+	 */
+	class BS_UTILITY_EXPORT BatchMath
+	{
+	public:
+		/**
+		 * Transforms an array of points by an affine matrix.
+		 *
+		 * @param[in]	matrix	Affine matrix to transform the points with.
+		 * @param[in]	input	Points to transform.
+		 * @param[out]	output	Transformed points. Must have room for @p count entries.
+		 * @param[in]	count	Number of points to transform.
+		 *
+		 * @see		Matrix4::multiplyAffine(const Vector3&)
+		 */
+		static void transformPoints(const Matrix4& matrix, const Vector3* input, Vector3* output, UINT32 count);
+
+		/**
+		 * Multiplies (concatenates) pairs of affine matrices, outputting lhs[i] * rhs[i] for each pair.
+		 *
+		 * @see		Matrix4::concatenateAffine
+		 */
+		static void multiplyAffine(const Matrix4* lhs, const Matrix4* rhs, Matrix4* output, UINT32 count);
+
+		/**
+		 * Transforms an array of axis aligned boxes, each by its own affine matrix. Outputs boxes encompassing the
+		 * transformed original boxes.
+		 *
+		 * @see		AABox::transformAffine
+		 */
+		static void transformAffine(const Matrix4* matrices, const AABox* input, AABox* output, UINT32 count);
+
+		/**
+		 * Inverts an array of affine matrices.
+		 *
+		 * @see		Matrix4::inverseAffine
+		 */
+		static void inverseAffine(const Matrix4* input, Matrix4* output, UINT32 count);
+
+		/**
+		 * Builds an array of matrices from translation, rotation and scale components.
+		 *
+		 * @see		Matrix4::TRS
+		 */
+		static void TRS(const Vector3* translations, const Quaternion* rotations, const Vector3* scales,
+			Matrix4* output, UINT32 count);
+	};
+
+	/** @} */
+}
@@ -63,8 +63,35 @@ namespace BansheeEngine
 		 * name will be present in the stack trace, otherwise just its address.
 		 * 						
 		 * @return	String containing the call stack with each function on its own line.
+		 *
+		 * @note	Thread safe.
 		 */
 		static String getStackTrace();
+
+		/**
+		 * Returns a string containing a stack trace made of the provided function addresses, as returned by 
+		 * getRawStackTrace(). If function can be found in the symbol table its readable name will be present in the stack
+		 * trace, otherwise just its address.
+		 *
+		 * @param[in]	addresses		Addresses of the functions on the call stack, deepest called function first.
+		 * @param[in]	numAddresses	Number of entries in @p addresses.
+		 * @return						String containing the call stack with each function on its own line.
+		 *
+		 * @note	Thread safe.
+		 */
+		static String getStackTrace(const UINT64* addresses, UINT32 numAddresses);
+
+		/**
+		 * Retrieves addresses of the functions on the current call stack. Doesn't allocate any memory, and is much faster
+		 * than getStackTrace(), so it can be used for capturing call stacks often and resolving them later.
+		 *
+		 * @param[out]	addresses		Buffer to output the function addresses to. First address is the deepest called
+		 *								function and following address is its caller and so on.
+		 * @param[in]	maxAddresses	Maximum number of addresses to write to @p addresses.
+		 * @param[in]	skip			Number of bottom-most call stack entries to skip, in addition to this method.
+		 * @return						Number of addresses written to @p addresses.
+		 */
+		static UINT32 getRawStackTrace(UINT64* addresses, UINT32 maxAddresses, UINT32 skip = 0);
 	private:
 		/** Returns path to the folder into which to store the crash reports. */
 		Path getCrashFolder() const;
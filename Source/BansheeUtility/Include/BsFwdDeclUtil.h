@@ -48,6 +48,7 @@ namespace BansheeEngine
 	class Radian;
 	class Ray;
 	class Capsule;
+	class ConvexVolume;
 	class Sphere;
 	class Vector2;
 	class Vector3;
@@ -7,11 +7,14 @@
 
 #include <atomic>
 #include <utility>
+#include <type_traits>
 
 #if BS_PLATFORM == BS_PLATFORM_LINUX
 #  include <malloc.h>
 #endif
 
+#include "BsSmallObjectAlloc.h"
+
 namespace BansheeEngine
 {
 	class MemoryAllocatorBase;
@@ -94,6 +97,45 @@ namespace BansheeEngine
 	}
 #endif
 
+	/** @} */
+	/** @} */
+
+	/** @addtogroup Memory
+	 *  @{
+	 */
+
+	/** Allocation statistics of a single memory category. */
+	struct MemoryCategoryStats
+	{
+		const char* name; /**< Name of the category. */
+		UINT64 numAllocs; /**< Total number of allocations made in the category. */
+		UINT64 numFrees; /**< Total number of frees made in the category. */
+		INT64 liveBytes; /**< Number of bytes currently allocated in the category, excluding allocations with custom alignment. */
+		INT64 peakBytes; /**< Highest number of bytes allocated in the category at once. */
+	};
+
+	/** Maximum number of callstack entries recorded for a sampled allocation. */
+#define BS_MAX_SAMPLED_CALLSTACK_DEPTH 16
+
+	/** Information about a sampled allocation that wasn't freed yet. */
+	struct SampledAllocation
+	{
+		UINT32 categoryIdx; /**< Index of the memory category the allocation was made in. */
+		UINT32 numFrames; /**< Number of valid entries in @p frames. */
+		UINT64 bytes; /**< Size of the allocation, in bytes. */
+		UINT64 frames[BS_MAX_SAMPLED_CALLSTACK_DEPTH]; /**< Addresses of the functions on the callstack, innermost first. */
+	};
+
+	/** @} */
+
+	/** @addtogroup Internal-Utility
+	 *  @{
+	 */
+
+	/** @addtogroup Memory-Internal
+	 *  @{
+	 */
+
 	/**
 	 * Thread safe class used for storing total number of memory allocations and deallocations, primarily for statistic 
 	 * purposes.
@@ -110,6 +152,62 @@ namespace BansheeEngine
 		{
 			return Frees;
 		}
+
+		/** Returns the number of memory categories that made at least one allocation. */
+		static BS_UTILITY_EXPORT UINT32 getNumCategories();
+
+		/** Returns allocation statistics of the memory category at the specified index. */
+		static BS_UTILITY_EXPORT MemoryCategoryStats getCategoryStats(UINT32 idx);
+
+		/** 
+		 * Returns the index of the memory category with the specified name, registering the category if it doesn't exist.
+		 * Categories are looked up by name so all modules share the same counters.
+		 */
+		static BS_UTILITY_EXPORT UINT32 getCategoryIdx(const char* name);
+
+		/**
+		 * Enables or disables allocation tracking. While enabled allocations have their callstacks sampled as set by 
+		 * setCallstackSampleRate(). Every sampled allocation is recorded until it is freed, making all frees slower, so
+		 * tracking is disabled by default.
+		 */
+		static BS_UTILITY_EXPORT void setTrackingEnabled(bool enabled);
+
+		/** Checks if allocation tracking is enabled. See setTrackingEnabled(). */
+		static BS_UTILITY_EXPORT bool isTrackingEnabled();
+
+		/** 
+		 * Determines how often are allocation callstacks sampled while tracking is enabled. One in every @p rate 
+		 * allocations made by a thread is sampled. Zero disables sampling.
+		 */
+		static BS_UTILITY_EXPORT void setCallstackSampleRate(UINT32 rate);
+
+		/** 
+		 * Retrieves sampled allocations that weren't freed yet. Can be used for finding memory leaks.
+		 *
+		 * @param[out]	output		Buffer to write the allocations to. Can be null if @p maxCount is zero.
+		 * @param[in]	maxCount	Maximum number of allocations to write to @p output.
+		 * @return					Total number of sampled allocations that weren't freed yet. Can be larger than
+		 *							@p maxCount, in which case only the first @p maxCount allocations are written.
+		 */
+		static BS_UTILITY_EXPORT UINT32 getSampledAllocations(SampledAllocation* output, UINT32 maxCount);
+
+		/** 
+		 * Releases the per-thread counters used by the current thread, so they can be reused by another thread. Called
+		 * automatically when a thread exits, but can be called earlier if the thread won't allocate anymore.
+		 */
+		static BS_UTILITY_EXPORT void endThread();
+
+		/** 
+		 * Sets the memory category that general allocations made on the current thread are counted in, and returns the
+		 * previously set category. Use ScopedMemoryTag instead of calling this directly.
+		 */
+		static BS_UTILITY_EXPORT UINT32 _setScopedCategory(UINT32 categoryIdx);
+
+		/** Returns the category set by _setScopedCategory() on the current thread, or INVALID_CATEGORY if none. */
+		static BS_UTILITY_EXPORT UINT32 _getScopedCategory();
+
+		/** Index signifying no memory category. */
+		static const UINT32 INVALID_CATEGORY = (UINT32)-1;
 		
 	private:
 		friend class MemoryAllocatorBase;
@@ -118,6 +216,12 @@ namespace BansheeEngine
 		static BS_UTILITY_EXPORT void incAllocCount() { Allocs++; }
 		static BS_UTILITY_EXPORT void incFreeCount() { Frees++; }
 
+		/** Records an allocation of @p bytes bytes at @p ptr in the category with the specified index. */
+		static BS_UTILITY_EXPORT void notifyAlloc(UINT32 categoryIdx, void* ptr, size_t bytes);
+
+		/** Records a free of @p bytes bytes at @p ptr in the category with the specified index. */
+		static BS_UTILITY_EXPORT void notifyFree(UINT32 categoryIdx, void* ptr, size_t bytes);
+
 		static BS_THREADLOCAL UINT64 Allocs;
 		static BS_THREADLOCAL UINT64 Frees;
 	};
@@ -126,15 +230,109 @@ namespace BansheeEngine
 	class MemoryAllocatorBase
 	{
 	protected:
+		/** 
+		 * Size of the header placed in front of heap allocations while profiling, storing the allocation size and the
+		 * memory category it was counted in. Querying the size from the OS heap instead would need to take the heap 
+		 * lock on every allocation and free. Keeps the allocations aligned to 16 bytes.
+		 */
+		static const size_t SIZE_HEADER_BYTES = 16;
+
+		/** 
+		 * Stores the allocation size and category in the header at the start of @p data, and returns the memory 
+		 * following it.
+		 */
+		static void* writeSizeHeader(void* data, size_t bytes, UINT32 categoryIdx)
+		{
+			if (data == nullptr)
+				return nullptr;
+
+			*(size_t*)data = bytes;
+			*((UINT8*)data + sizeof(size_t)) = (UINT8)categoryIdx;
+			return (UINT8*)data + SIZE_HEADER_BYTES;
+		}
+
+		/** Returns the start of the memory allocated for @p ptr, which was returned by writeSizeHeader(). */
+		static void* getSizeHeader(void* ptr)
+		{
+			return (UINT8*)ptr - SIZE_HEADER_BYTES;
+		}
+
+		/** Returns the size stored in front of @p ptr by writeSizeHeader(). */
+		static size_t readSizeHeader(void* ptr)
+		{
+			return ptr != nullptr ? *(size_t*)getSizeHeader(ptr) : 0;
+		}
+
+		/** 
+		 * Returns the category stored in front of @p ptr by writeSizeHeader(), or @p defaultCategoryIdx if @p ptr is 
+		 * null.
+		 */
+		static UINT32 readCategoryHeader(void* ptr, UINT32 defaultCategoryIdx)
+		{
+			return ptr != nullptr ? *((UINT8*)getSizeHeader(ptr) + sizeof(size_t)) : defaultCategoryIdx;
+		}
+
 		static void incAllocCount() { MemoryCounter::incAllocCount(); }
 		static void incFreeCount() { MemoryCounter::incFreeCount(); }
+
+		static void notifyAlloc(UINT32 categoryIdx, void* ptr, size_t bytes) 
+		{ 
+			MemoryCounter::notifyAlloc(categoryIdx, ptr, bytes);
+		}
+
+		static void notifyFree(UINT32 categoryIdx, void* ptr, size_t bytes) 
+		{ 
+			MemoryCounter::notifyFree(categoryIdx, ptr, bytes); 
+		}
+	};
+
+	class GenAlloc;
+
+	/** Determines which allocator serves the allocations of a memory category. */
+	enum class MemoryBackend
+	{
+		Heap, /**< Allocations are served directly from the OS heap, using malloc/free. */
+		SmallObject /**< Allocations are served from SmallObjectAlloc, which is faster for small allocations. */
 	};
 
+	/**
+	 * Provides information about a memory category, used by the generic MemoryAllocator implementation. Specialize for a
+	 * category to give it a name in memory statistics, or to change the allocator its allocations are served from.
+	 */
+	template<class T>
+	struct MemoryCategoryTraits
+	{
+		/** Returns the name of the category, as displayed in memory statistics. */
+		static const char* getName() { return "Other"; }
+
+		/** Allocator that serves allocations of the category. */
+		static const MemoryBackend Backend = MemoryBackend::Heap;
+	};
+
+	/** Returns the index of the memory category @p Category, as used by MemoryCounter. */
+	template<class Category>
+	UINT32 getMemoryCategoryIdx()
+	{
+		// Constant initialized, so no initialization guard is checked on every call. Registering the category more than
+		// once is harmless, as categories are looked up by name.
+		static std::atomic<UINT32> categoryIdx(MemoryCounter::INVALID_CATEGORY);
+
+		UINT32 idx = categoryIdx.load(std::memory_order_relaxed);
+		if (idx == MemoryCounter::INVALID_CATEGORY)
+		{
+			idx = MemoryCounter::getCategoryIdx(MemoryCategoryTraits<Category>::getName());
+			categoryIdx.store(idx, std::memory_order_relaxed);
+		}
+
+		return idx;
+	}
+
 	/**
 	 * Memory allocator providing a generic implementation. Specialize for specific categories as needed.
 	 * 			
 	 * @note	For example you might implement a pool allocator for specific types in order
-	 * 			to reduce allocation overhead. By default standard malloc/free are used.
+	 * 			to reduce allocation overhead. By default standard malloc/free are used, unless the category selects a
+	 * 			different backend through MemoryCategoryTraits.
 	 */
 	template<class T>
 	class MemoryAllocator : public MemoryAllocatorBase
@@ -144,10 +342,33 @@ namespace BansheeEngine
 		static void* allocate(size_t bytes)
 		{
 #if BS_PROFILING_ENABLED
+			UINT32 categoryIdx = getAllocCategoryIdx();
+
+			// Small allocations have no header, so they can only be counted in the allocator's own category
+			void* ptr;
+			size_t allocSize;
+			if (MemoryCategoryTraits<T>::Backend == MemoryBackend::SmallObject && 
+				categoryIdx == getMemoryCategoryIdx<T>() && bytes <= SmallObjectAlloc::MAX_ALLOC_SIZE)
+			{
+				ptr = SmallObjectAlloc::allocate(bytes);
+				allocSize = SmallObjectAlloc::getAllocSize(ptr);
+			}
+			else
+			{
+				ptr = writeSizeHeader(malloc(bytes + SIZE_HEADER_BYTES), bytes, categoryIdx);
+				allocSize = ptr != nullptr ? bytes : 0;
+			}
+
 			incAllocCount();
-#endif
+			notifyAlloc(categoryIdx, ptr, allocSize);
+
+			return ptr;
+#else
+			if (MemoryCategoryTraits<T>::Backend == MemoryBackend::SmallObject)
+				return SmallObjectAlloc::allocate(bytes);
 
 			return malloc(bytes);
+#endif
 		}
 
 		/** 
@@ -156,21 +377,30 @@ namespace BansheeEngine
 		 */
 		static void* allocateAligned(size_t bytes, size_t alignment)
 		{
+			void* ptr = platformAlignedAlloc(bytes, alignment);
+
 #if BS_PROFILING_ENABLED
 			incAllocCount();
+			notifyAlloc(getMemoryCategoryIdx<T>(), ptr, 0);
 #endif
 
-			return platformAlignedAlloc(bytes, alignment);
+			return ptr;
 		}
 
 		/** Allocates @p bytes and aligns them to a 16 byte boundary. */
 		static void* allocateAligned16(size_t bytes)
 		{
 #if BS_PROFILING_ENABLED
+			UINT32 categoryIdx = getAllocCategoryIdx();
+			void* ptr = writeSizeHeader(platformAlignedAlloc16(bytes + SIZE_HEADER_BYTES), bytes, categoryIdx);
+
 			incAllocCount();
-#endif
+			notifyAlloc(categoryIdx, ptr, ptr != nullptr ? bytes : 0);
 
+			return ptr;
+#else
 			return platformAlignedAlloc16(bytes);
+#endif
 		}
 
 		/** Frees the memory at the specified location. */
@@ -178,9 +408,25 @@ namespace BansheeEngine
 		{
 #if BS_PROFILING_ENABLED
 			incFreeCount();
-#endif
 
-			::free(ptr);
+			if (MemoryCategoryTraits<T>::Backend == MemoryBackend::SmallObject && SmallObjectAlloc::isSmallAlloc(ptr))
+			{
+				notifyFree(getMemoryCategoryIdx<T>(), ptr, SmallObjectAlloc::getAllocSize(ptr));
+				SmallObjectAlloc::free(ptr);
+			}
+			else
+			{
+				notifyFree(readCategoryHeader(ptr, getMemoryCategoryIdx<T>()), ptr, readSizeHeader(ptr));
+
+				if (ptr != nullptr)
+					::free(getSizeHeader(ptr));
+			}
+#else
+			if (MemoryCategoryTraits<T>::Backend == MemoryBackend::SmallObject)
+				SmallObjectAlloc::free(ptr);
+			else
+				::free(ptr);
+#endif
 		}
 
 		/** Frees memory allocated with allocateAligned() */
@@ -188,6 +434,7 @@ namespace BansheeEngine
 		{
 #if BS_PROFILING_ENABLED
 			incFreeCount();
+			notifyFree(getMemoryCategoryIdx<T>(), ptr, 0);
 #endif
 
 			platformAlignedFree(ptr);
@@ -198,10 +445,33 @@ namespace BansheeEngine
 		{
 #if BS_PROFILING_ENABLED
 			incFreeCount();
-#endif
+			notifyFree(readCategoryHeader(ptr, getMemoryCategoryIdx<T>()), ptr, readSizeHeader(ptr));
 
+			if (ptr != nullptr)
+				platformAlignedFree16(getSizeHeader(ptr));
+#else
 			platformAlignedFree16(ptr);
+#endif
+		}
+
+	private:
+#if BS_PROFILING_ENABLED
+		/** 
+		 * Returns the category a new allocation is counted in. Only general allocations can be moved to a different
+		 * category by a scoped tag.
+		 */
+		static UINT32 getAllocCategoryIdx()
+		{
+			if (std::is_same<T, GenAlloc>::value)
+			{
+				UINT32 scopedCategoryIdx = MemoryCounter::_getScopedCategory();
+				if (scopedCategoryIdx != MemoryCounter::INVALID_CATEGORY)
+					return scopedCategoryIdx;
+			}
+
+			return getMemoryCategoryIdx<T>();
 		}
+#endif
 	};
 
 	/**
@@ -211,7 +481,61 @@ namespace BansheeEngine
 	class GenAlloc
 	{ };
 
+	/** Names the general category, and serves its allocations from SmallObjectAlloc if enabled. */
+	template<>
+	struct MemoryCategoryTraits<GenAlloc>
+	{
+		static const char* getName() { return "General"; }
+
+#if BS_SMALL_OBJECT_ALLOC
+		static const MemoryBackend Backend = MemoryBackend::SmallObject;
+#else
+		static const MemoryBackend Backend = MemoryBackend::Heap;
+#endif
+	};
+
+	/** @} */
 	/** @} */
+
+	/** @addtogroup Memory
+	 *  @{
+	 */
+
+	/**
+	 * Counts general allocations made by the current thread in a different memory category, for as long as the object 
+	 * is alive. Scopes can be nested. Allocations keep their category when freed outside of the scope, as the category
+	 * is stored in the allocation's profiling header. Tagged allocations are always served from the OS heap, as small
+	 * object allocations have no header to store the category in.
+	 *
+	 * @code
+	 * ScopedMemoryTag tag(getMemoryCategoryIdx<GUIAlloc>());
+	 * @endcode
+	 */
+	class ScopedMemoryTag
+	{
+	public:
+		explicit ScopedMemoryTag(UINT32 categoryIdx)
+#if BS_PROFILING_ENABLED
+			:mPrevCategoryIdx(MemoryCounter::_setScopedCategory(categoryIdx))
+#endif
+		{ }
+
+		~ScopedMemoryTag()
+		{
+#if BS_PROFILING_ENABLED
+			MemoryCounter::_setScopedCategory(mPrevCategoryIdx);
+#endif
+		}
+
+	private:
+		ScopedMemoryTag(const ScopedMemoryTag&) = delete;
+		ScopedMemoryTag& operator=(const ScopedMemoryTag&) = delete;
+
+#if BS_PROFILING_ENABLED
+		UINT32 mPrevCategoryIdx;
+#endif
+	};
+
 	/** @} */
 
 	/** @addtogroup Memory
@@ -418,3 +742,4 @@ namespace BansheeEngine
 #include "BsMemStack.h"
 #include "BsGlobalFrameAlloc.h"
 #include "BsMemAllocProfiler.h"
+#include "BsMemoryCategories.h"
@@ -0,0 +1,103 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+namespace BansheeEngine
+{
+	/** @addtogroup Memory
+	 *  @{
+	 */
+
+	/**
+	 * Memory category for texture data. Use as the allocator parameter (e.g. bs_alloc<TextureAlloc>) or with a
+	 * ScopedMemoryTag.
+	 */
+	class TextureAlloc
+	{ };
+
+	/** Memory category for mesh data. */
+	class MeshAlloc
+	{ };
+
+	/** Memory category for GUI elements and the data used for rendering them. */
+	class GUIAlloc
+	{ };
+
+	/** Memory category for the native side of the scripting system. */
+	class ScriptAlloc
+	{ };
+
+	/** Memory category for the physics system. */
+	class PhysicsAlloc
+	{ };
+
+	/** Memory category for data used during serialization and deserialization. */
+	class SerializationAlloc
+	{ };
+
+	/** Memory category for commands queued for execution on the core thread, including their callbacks. */
+	class CoreThreadAlloc
+	{ };
+
+	/** @} */
+
+	/** @addtogroup Internal-Utility
+	 *  @{
+	 */
+
+	/** @addtogroup Memory-Internal
+	 *  @{
+	 */
+
+	template<>
+	struct MemoryCategoryTraits<TextureAlloc>
+	{
+		static const char* getName() { return "Textures"; }
+		static const MemoryBackend Backend = MemoryBackend::Heap;
+	};
+
+	template<>
+	struct MemoryCategoryTraits<MeshAlloc>
+	{
+		static const char* getName() { return "Meshes"; }
+		static const MemoryBackend Backend = MemoryBackend::Heap;
+	};
+
+	template<>
+	struct MemoryCategoryTraits<GUIAlloc>
+	{
+		static const char* getName() { return "GUI"; }
+		static const MemoryBackend Backend = MemoryCategoryTraits<GenAlloc>::Backend;
+	};
+
+	template<>
+	struct MemoryCategoryTraits<ScriptAlloc>
+	{
+		static const char* getName() { return "Scripting"; }
+		static const MemoryBackend Backend = MemoryCategoryTraits<GenAlloc>::Backend;
+	};
+
+	template<>
+	struct MemoryCategoryTraits<PhysicsAlloc>
+	{
+		static const char* getName() { return "Physics"; }
+		static const MemoryBackend Backend = MemoryBackend::Heap;
+	};
+
+	template<>
+	struct MemoryCategoryTraits<SerializationAlloc>
+	{
+		static const char* getName() { return "Serialization"; }
+		static const MemoryBackend Backend = MemoryCategoryTraits<GenAlloc>::Backend;
+	};
+
+	template<>
+	struct MemoryCategoryTraits<CoreThreadAlloc>
+	{
+		static const char* getName() { return "CoreThreadQueue"; }
+		static const MemoryBackend Backend = MemoryBackend::Heap;
+	};
+
+	/** @} */
+	/** @} */
+}
@@ -134,6 +134,9 @@
 
 #define BS_PROFILING_ENABLED 1
 
+// If enabled, general purpose allocations (GenAlloc) are served by SmallObjectAlloc instead of directly by malloc
+#define BS_SMALL_OBJECT_ALLOC 1
+
 // Versions
 
 #define BS_VER_DEV 1
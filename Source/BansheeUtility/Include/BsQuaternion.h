@@ -77,14 +77,14 @@ namespace BansheeEngine
 		{
 			assert(i < 4);
 
-			return *(&w+i);
+			return *(&x+i);
 		}
 
 		float& operator[] (const size_t i)
 		{
 			assert(i < 4);
 
-			return *(&w+i);
+			return *(&x+i);
 		}
 
 		/**
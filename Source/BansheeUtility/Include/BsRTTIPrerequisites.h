@@ -402,7 +402,7 @@ namespace BansheeEngine
 		typedef std::unordered_map<Key, Value, std::hash<Key>, std::equal_to<Key>, StdAlloc<std::pair<const Key, Value>>> MapType;
 
 		/** @copydoc RTTIPlainType::toMemory */
-		static void toMemory(MapType& data, char* memory)
+		static void toMemory(const MapType& data, char* memory)
 		{
 			UINT32 size = sizeof(UINT32);
 			char* memoryStart = memory;
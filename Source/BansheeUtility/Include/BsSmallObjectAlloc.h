@@ -0,0 +1,93 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+namespace BansheeEngine
+{
+	/** @addtogroup Internal-Utility
+	 *  @{
+	 */
+
+	/** @addtogroup Memory-Internal
+	 *  @{
+	 */
+
+	/** Information about memory used by a single size class of the small object allocator. */
+	struct SmallObjectAllocStats
+	{
+		UINT32 allocSize; /**< Size of allocations in this size class, in bytes. */
+		UINT32 numPages; /**< Number of pages reserved for allocations in this size class. */
+		UINT64 numAllocated; /**< Number of allocations that are currently in use. */
+		UINT64 numFreeShared; /**< Number of free allocations in the list shared between threads. */
+		UINT64 numFreeCached; /**< Number of free allocations cached by individual threads. */
+
+		/** Returns the number of bytes reserved for allocations in this size class. */
+		UINT64 getReservedBytes() const;
+
+		/** Returns the number of bytes that are currently allocated. */
+		UINT64 getUsedBytes() const { return numAllocated * allocSize; }
+
+		/**
+		 * Returns the portion of reserved memory that isn't allocated, in range [0, 1]. Includes free allocations, as well
+		 * as the space at the end of each page too small to hold an allocation.
+		 */
+		float getFragmentation() const;
+	};
+
+	/**
+	 * Allocator optimized for large numbers of small allocations. Allocations are rounded up to one of a set of size
+	 * classes, and each size class is served from its own set of pages. Each thread keeps a cache of free allocations
+	 * for each size class, so most allocations and frees don't need any synchronization. Allocations larger than
+	 * MAX_ALLOC_SIZE are forwarded to the OS heap.
+	 *
+	 * Memory can be freed on a different thread than the one it was allocated on. Pages are never returned to the OS, and
+	 * are instead reused by later allocations of the same size class.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_UTILITY_EXPORT SmallObjectAlloc
+	{
+	public:
+		/** Allocates @p bytes bytes. Returned memory is aligned to a 16 byte boundary. */
+		static void* allocate(size_t bytes);
+
+		/** Frees memory previously allocated with allocate(). Accepts null. */
+		static void free(void* ptr);
+
+		/** 
+		 * Returns the number of bytes usable by the allocation at the provided location. This is the size of the allocation's
+		 * size class, or the requested size for allocations larger than MAX_ALLOC_SIZE.
+		 */
+		static size_t getAllocSize(void* ptr);
+
+		/** 
+		 * Checks if the allocation at the provided location was served from the allocator's pages, rather than forwarded
+		 * to the OS heap. Returns false for null.
+		 */
+		static bool isSmallAlloc(void* ptr);
+
+		/**
+		 * Returns all allocations cached by the current thread to the shared lists, so they can be used by other threads.
+		 * Called automatically when a thread exits, but can be called earlier if the thread won't allocate anymore.
+		 */
+		static void endThread();
+
+		/** Returns the number of different size classes. */
+		static UINT32 getNumSizeClasses();
+
+		/**
+		 * Returns information about memory used by the size class at the specified index. Counts of allocations cached by
+		 * other threads may be slightly out of date.
+		 */
+		static SmallObjectAllocStats getStats(UINT32 sizeClassIdx);
+
+		/** Size of the largest allocation served by the allocator. Larger allocations are forwarded to the OS heap. */
+		static const UINT32 MAX_ALLOC_SIZE = 256;
+
+		/** Size of a single page of allocations. */
+		static const UINT32 PAGE_SIZE = 64 * 1024;
+	};
+
+	/** @} */
+	/** @} */
+}
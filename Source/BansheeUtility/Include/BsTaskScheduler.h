@@ -108,6 +108,26 @@ namespace BansheeEngine
 
 		/** Returns the maximum available worker threads (maximum number of tasks that can be executed simultaneously). */
 		UINT32 getNumWorkers() const { return mMaxActiveTasks; }
+
+		/** 
+		 * Returns the number of tasks to split @p work units of work into, so each task receives at least 
+		 * @p minWorkPerTask units. Never returns more tasks than there are workers. Returns 1 if the task scheduler isn't
+		 * running.
+		 */
+		static UINT32 getNumTasks(UINT32 work, UINT32 minWorkPerTask);
+
+		/** 
+		 * Splits the range [0, @p count) into @p numTasks parts and calls @p worker with the start and end of each part.
+		 * Parts are executed on worker threads and the method blocks until all of them complete. If only a single task is
+		 * requested, or the task scheduler isn't running, the whole range is processed on the calling thread.
+		 *
+		 * @param[in]	name		Name of the created tasks.
+		 * @param[in]	count		Number of items in the range.
+		 * @param[in]	numTasks	Number of parts to split the range into, usually returned by getNumTasks().
+		 * @param[in]	worker		Method processing the items in range [start, end).
+		 */
+		static void runParallel(const String& name, UINT32 count, UINT32 numTasks, 
+			const std::function<void(UINT32, UINT32)>& worker);
 	protected:
 		friend class Task;
 
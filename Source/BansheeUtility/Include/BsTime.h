@@ -71,6 +71,35 @@ namespace BansheeEngine
 		 */
 		UINT64 getStartTimeMs() const { return mAppStartTime; }
 
+		/**
+		 * Gets the time step at which fixed updates are performed. Fixed updates are performed zero or multiple times per
+		 * frame, so that on average they run at a constant rate regardless of the frame rate.
+		 *
+		 * @return	Time between two fixed updates, in seconds.
+		 */
+		float getFixedFrameDelta() const { return (float)(mFixedStep * MICROSEC_TO_SEC); }
+
+		/** 
+		 * Sets the time step at which fixed updates are performed. 
+		 *
+		 * @param[in]	step	Time between two fixed updates, in seconds. Must be larger than zero.
+		 */
+		void setFixedFrameDelta(float step);
+
+		/**
+		 * Sets the maximum number of fixed updates that may be performed during a single frame. If the frame took longer
+		 * than this many fixed steps the remaining time is discarded, so that a slow frame doesn't cause an ever 
+		 * increasing amount of fixed updates in the following frames.
+		 */
+		void setMaxFixedUpdatesPerFrame(UINT32 count) { mMaxFixedUpdatesPerFrame = std::max(count, 1U); }
+
+		/**
+		 * Returns a value in range [0, 1) that determines how far the current frame is between the last performed fixed 
+		 * update and the next one. Can be used for interpolating state calculated during fixed updates, so that it 
+		 * appears smooth regardless of the rate at which frames are rendered. Only gets updated once per frame.
+		 */
+		float getFixedInterpolation() const { return mFixedInterpolation; }
+
 		/** @name Internal 
 		 *  @{
 		 */
@@ -78,6 +107,12 @@ namespace BansheeEngine
 		/** Called every frame. Should only be called by Application. */
 		void _update();
 
+		/** 
+		 * Returns the number of fixed updates that need to be performed during the current frame, as calculated by the
+		 * last call to _update().
+		 */
+		UINT32 _getNumFixedUpdates() const { return mNumFixedUpdates; }
+
 		/** @} */
 
 		/** Multiply with time in microseconds to get a time in seconds. */
@@ -91,6 +126,12 @@ namespace BansheeEngine
 		UINT64 mLastFrameTime; /**< Time since last runOneFrame call, In microseconds */
 		std::atomic<unsigned long> mCurrentFrame;
 
+		UINT64 mFixedStep; /**< Time between two fixed updates, in microseconds */
+		UINT64 mLastFixedUpdateTime; /**< Time up to which fixed updates have been performed, in microseconds */
+		UINT32 mNumFixedUpdates;
+		UINT32 mMaxFixedUpdatesPerFrame;
+		float mFixedInterpolation;
+
 		Timer* mTimer;
 	};
 
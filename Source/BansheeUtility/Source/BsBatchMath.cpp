@@ -0,0 +1,496 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsBatchMath.h"
+#include "BsMath.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define BS_BATCH_MATH_SSE 1
+#	include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#	define BS_BATCH_MATH_NEON 1
+#	include <arm_neon.h>
+#endif
+
+namespace BansheeEngine
+{
+	namespace
+	{
+		// Minimal set of 4-wide float operations the batch kernels are written in. Each kernel processes four objects at
+		// once, with each lane holding one component of a different object (structure of arrays).
+#if BS_BATCH_MATH_SSE
+		typedef __m128 Float4;
+
+		Float4 load4(const float* v) { return _mm_loadu_ps(v); }
+		void store4(float* v, Float4 a) { _mm_storeu_ps(v, a); }
+		Float4 set4(float v) { return _mm_set1_ps(v); }
+		Float4 add4(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+		Float4 sub4(Float4 a, Float4 b) { return _mm_sub_ps(a, b); }
+		Float4 mul4(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+		Float4 div4(Float4 a, Float4 b) { return _mm_div_ps(a, b); }
+		Float4 abs4(Float4 a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+
+		void transpose4(Float4& a, Float4& b, Float4& c, Float4& d)
+		{
+			_MM_TRANSPOSE4_PS(a, b, c, d);
+		}
+
+		Float4 load3(const Vector3& v)
+		{
+			return _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)&v.x), _mm_load_ss(&v.z));
+		}
+
+		/** Loads four tightly packed 3D vectors, outputting their x, y and z components in separate registers. */
+		void loadVectors(const Vector3* vectors, Float4& x, Float4& y, Float4& z)
+		{
+			// Each load also picks up the start of the next vector, which the transpose discards. The last load is offset
+			// back by one float so it doesn't read past the end of the array.
+			Float4 w = _mm_loadu_ps(&vectors[3].x - 1);
+			w = _mm_shuffle_ps(w, w, _MM_SHUFFLE(0, 3, 2, 1));
+
+			x = _mm_loadu_ps(&vectors[0].x);
+			y = _mm_loadu_ps(&vectors[1].x);
+			z = _mm_loadu_ps(&vectors[2].x);
+
+			transpose4(x, y, z, w);
+		}
+
+		/** Stores four tightly packed 3D vectors from registers containing their x, y and z components. */
+		void storeVectors(Float4 x, Float4 y, Float4 z, Vector3* vectors)
+		{
+			Float4 w = _mm_setzero_ps();
+			transpose4(x, y, z, w);
+
+			// Each store overwrites the start of the next vector, which is then overwritten again by the following store
+			_mm_storeu_ps(&vectors[0].x, x);
+			_mm_storeu_ps(&vectors[1].x, y);
+			_mm_storeu_ps(&vectors[2].x, z);
+
+			Float4 last = _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 0, 2, 2));
+			last = _mm_shuffle_ps(last, w, _MM_SHUFFLE(2, 1, 2, 0));
+			_mm_storeu_ps(&vectors[3].x - 1, last);
+		}
+#elif BS_BATCH_MATH_NEON
+		typedef float32x4_t Float4;
+
+		Float4 load4(const float* v) { return vld1q_f32(v); }
+		void store4(float* v, Float4 a) { vst1q_f32(v, a); }
+		Float4 set4(float v) { return vdupq_n_f32(v); }
+		Float4 add4(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+		Float4 sub4(Float4 a, Float4 b) { return vsubq_f32(a, b); }
+		Float4 mul4(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+		Float4 abs4(Float4 a) { return vabsq_f32(a); }
+
+		Float4 div4(Float4 a, Float4 b)
+		{
+#if defined(__aarch64__)
+			return vdivq_f32(a, b);
+#else
+			// No division on ARMv7, refine the reciprocal estimate with two Newton-Raphson steps instead
+			Float4 inv = vrecpeq_f32(b);
+			inv = vmulq_f32(vrecpsq_f32(b, inv), inv);
+			inv = vmulq_f32(vrecpsq_f32(b, inv), inv);
+
+			return vmulq_f32(a, inv);
+#endif
+		}
+
+		void transpose4(Float4& a, Float4& b, Float4& c, Float4& d)
+		{
+			float32x4x2_t ab = vtrnq_f32(a, b);
+			float32x4x2_t cd = vtrnq_f32(c, d);
+
+			a = vcombine_f32(vget_low_f32(ab.val[0]), vget_low_f32(cd.val[0]));
+			b = vcombine_f32(vget_low_f32(ab.val[1]), vget_low_f32(cd.val[1]));
+			c = vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0]));
+			d = vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1]));
+		}
+
+		Float4 load3(const Vector3& v)
+		{
+			return vcombine_f32(vld1_f32(&v.x), vld1_lane_f32(&v.z, vdup_n_f32(0.0f), 0));
+		}
+
+		/** Loads four tightly packed 3D vectors, outputting their x, y and z components in separate registers. */
+		void loadVectors(const Vector3* vectors, Float4& x, Float4& y, Float4& z)
+		{
+			float32x4x3_t xyz = vld3q_f32(&vectors[0].x);
+
+			x = xyz.val[0];
+			y = xyz.val[1];
+			z = xyz.val[2];
+		}
+
+		/** Stores four tightly packed 3D vectors from registers containing their x, y and z components. */
+		void storeVectors(Float4 x, Float4 y, Float4 z, Vector3* vectors)
+		{
+			float32x4x3_t xyz;
+			xyz.val[0] = x;
+			xyz.val[1] = y;
+			xyz.val[2] = z;
+
+			vst3q_f32(&vectors[0].x, xyz);
+		}
+#else
+		struct Float4
+		{
+			float v[4];
+		};
+
+		Float4 load4(const float* v) { return { { v[0], v[1], v[2], v[3] } }; }
+		void store4(float* v, Float4 a) { v[0] = a.v[0]; v[1] = a.v[1]; v[2] = a.v[2]; v[3] = a.v[3]; }
+		Float4 set4(float v) { return { { v, v, v, v } }; }
+
+		Float4 add4(Float4 a, Float4 b) { return { { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } }; }
+		Float4 sub4(Float4 a, Float4 b) { return { { a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3] } }; }
+		Float4 mul4(Float4 a, Float4 b) { return { { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] } }; }
+		Float4 div4(Float4 a, Float4 b) { return { { a.v[0] / b.v[0], a.v[1] / b.v[1], a.v[2] / b.v[2], a.v[3] / b.v[3] } }; }
+		Float4 abs4(Float4 a) { return { { Math::abs(a.v[0]), Math::abs(a.v[1]), Math::abs(a.v[2]), Math::abs(a.v[3]) } }; }
+
+		void transpose4(Float4& a, Float4& b, Float4& c, Float4& d)
+		{
+			std::swap(a.v[1], b.v[0]);
+			std::swap(a.v[2], c.v[0]);
+			std::swap(a.v[3], d.v[0]);
+			std::swap(b.v[2], c.v[1]);
+			std::swap(b.v[3], d.v[1]);
+			std::swap(c.v[3], d.v[2]);
+		}
+
+		Float4 load3(const Vector3& v) { return { { v.x, v.y, v.z, 0.0f } }; }
+
+		/** Loads four 3D vectors, outputting their x, y and z components in separate registers. */
+		void loadVectors(const Vector3* vectors, Float4& x, Float4& y, Float4& z)
+		{
+			for (UINT32 i = 0; i < 4; i++)
+			{
+				x.v[i] = vectors[i].x;
+				y.v[i] = vectors[i].y;
+				z.v[i] = vectors[i].z;
+			}
+		}
+
+		/** Stores four 3D vectors from registers containing their x, y and z components. */
+		void storeVectors(Float4 x, Float4 y, Float4 z, Vector3* vectors)
+		{
+			for (UINT32 i = 0; i < 4; i++)
+				vectors[i] = Vector3(x.v[i], y.v[i], z.v[i]);
+		}
+#endif
+
+		/** Returns a * b + c. */
+		Float4 madd4(Float4 a, Float4 b, Float4 c)
+		{
+			return add4(mul4(a, b), c);
+		}
+
+		/** Top three rows of four affine matrices, with each lane holding an element of a different matrix. */
+		struct AffineMatrix4
+		{
+			Float4 m[3][4];
+		};
+
+		void loadAffine(const Matrix4* matrices, AffineMatrix4& output)
+		{
+			for (UINT32 row = 0; row < 3; row++)
+			{
+				Float4* out = output.m[row];
+				out[0] = load4(matrices[0][row]);
+				out[1] = load4(matrices[1][row]);
+				out[2] = load4(matrices[2][row]);
+				out[3] = load4(matrices[3][row]);
+
+				transpose4(out[0], out[1], out[2], out[3]);
+			}
+		}
+
+		void storeAffine(const AffineMatrix4& input, Matrix4* matrices)
+		{
+			for (UINT32 row = 0; row < 3; row++)
+			{
+				Float4 a = input.m[row][0];
+				Float4 b = input.m[row][1];
+				Float4 c = input.m[row][2];
+				Float4 d = input.m[row][3];
+
+				transpose4(a, b, c, d);
+
+				store4(matrices[0][row], a);
+				store4(matrices[1][row], b);
+				store4(matrices[2][row], c);
+				store4(matrices[3][row], d);
+			}
+
+			for (UINT32 i = 0; i < 4; i++)
+			{
+				float* lastRow = matrices[i][3];
+				lastRow[0] = 0.0f; lastRow[1] = 0.0f; lastRow[2] = 0.0f; lastRow[3] = 1.0f;
+			}
+		}
+
+		/**
+		 * Runs a kernel processing four elements at a time over @p count elements. Remaining elements are copied into
+		 * a padded temporary block so the kernel never reads or writes outside of the provided arrays.
+		 */
+		template<class In, class Out, class Kernel>
+		void processBlocks(const In* input, Out* output, UINT32 count, Kernel kernel)
+		{
+			UINT32 numFullBlocks = count / 4;
+			for (UINT32 i = 0; i < numFullBlocks; i++)
+				kernel(i * 4, input + i * 4, output + i * 4);
+
+			UINT32 start = numFullBlocks * 4;
+			UINT32 remaining = count - start;
+			if (remaining == 0)
+				return;
+
+			In paddedInput[4];
+			Out paddedOutput[4];
+			for (UINT32 i = 0; i < 4; i++)
+				paddedInput[i] = input[start + std::min(i, remaining - 1)];
+
+			kernel(start, paddedInput, paddedOutput);
+
+			for (UINT32 i = 0; i < remaining; i++)
+				output[start + i] = paddedOutput[i];
+		}
+	}
+
+	void BatchMath::transformPoints(const Matrix4& matrix, const Vector3* input, Vector3* output, UINT32 count)
+	{
+		Float4 m[3][4];
+		for (UINT32 row = 0; row < 3; row++)
+		{
+			for (UINT32 col = 0; col < 4; col++)
+				m[row][col] = set4(matrix[row][col]);
+		}
+
+		processBlocks(input, output, count, [&](UINT32 idx, const Vector3* in, Vector3* out)
+		{
+			Float4 x, y, z;
+			loadVectors(in, x, y, z);
+
+			Float4 rx = madd4(m[0][0], x, madd4(m[0][1], y, madd4(m[0][2], z, m[0][3])));
+			Float4 ry = madd4(m[1][0], x, madd4(m[1][1], y, madd4(m[1][2], z, m[1][3])));
+			Float4 rz = madd4(m[2][0], x, madd4(m[2][1], y, madd4(m[2][2], z, m[2][3])));
+
+			storeVectors(rx, ry, rz, out);
+		});
+	}
+
+	void BatchMath::multiplyAffine(const Matrix4* lhs, const Matrix4* rhs, Matrix4* output, UINT32 count)
+	{
+		processBlocks(lhs, output, count, [&](UINT32 idx, const Matrix4* in, Matrix4* out)
+		{
+			const Matrix4* rhsBlock = rhs + idx;
+
+			Matrix4 paddedRhs[4];
+			if ((idx + 4) > count)
+			{
+				for (UINT32 i = 0; i < 4; i++)
+					paddedRhs[i] = rhs[std::min(idx + i, count - 1)];
+
+				rhsBlock = paddedRhs;
+			}
+
+			AffineMatrix4 a, b, r;
+			loadAffine(in, a);
+			loadAffine(rhsBlock, b);
+
+			for (UINT32 row = 0; row < 3; row++)
+			{
+				for (UINT32 col = 0; col < 4; col++)
+				{
+					Float4 value = mul4(a.m[row][0], b.m[0][col]);
+					value = madd4(a.m[row][1], b.m[1][col], value);
+					value = madd4(a.m[row][2], b.m[2][col], value);
+
+					if (col == 3)
+						value = add4(value, a.m[row][3]);
+
+					r.m[row][col] = value;
+				}
+			}
+
+			storeAffine(r, out);
+		});
+	}
+
+	void BatchMath::transformAffine(const Matrix4* matrices, const AABox* input, AABox* output, UINT32 count)
+	{
+		Float4 half = set4(0.5f);
+
+		processBlocks(input, output, count, [&](UINT32 idx, const AABox* in, AABox* out)
+		{
+			const Matrix4* matrixBlock = matrices + idx;
+
+			Matrix4 paddedMatrices[4];
+			if ((idx + 4) > count)
+			{
+				for (UINT32 i = 0; i < 4; i++)
+					paddedMatrices[i] = matrices[std::min(idx + i, count - 1)];
+
+				matrixBlock = paddedMatrices;
+			}
+
+			AffineMatrix4 m;
+			loadAffine(matrixBlock, m);
+
+			Float4 minX, minY, minZ, w;
+			minX = load3(in[0].getMin());
+			minY = load3(in[1].getMin());
+			minZ = load3(in[2].getMin());
+			w = load3(in[3].getMin());
+			transpose4(minX, minY, minZ, w);
+
+			Float4 maxX, maxY, maxZ;
+			maxX = load3(in[0].getMax());
+			maxY = load3(in[1].getMax());
+			maxZ = load3(in[2].getMax());
+			w = load3(in[3].getMax());
+			transpose4(maxX, maxY, maxZ, w);
+
+			Float4 centerX = mul4(add4(minX, maxX), half);
+			Float4 centerY = mul4(add4(minY, maxY), half);
+			Float4 centerZ = mul4(add4(minZ, maxZ), half);
+
+			Float4 halfX = mul4(sub4(maxX, minX), half);
+			Float4 halfY = mul4(sub4(maxY, minY), half);
+			Float4 halfZ = mul4(sub4(maxZ, minZ), half);
+
+			Float4 newCenter[3];
+			Float4 newHalf[3];
+			for (UINT32 row = 0; row < 3; row++)
+			{
+				const Float4* r = m.m[row];
+
+				newCenter[row] = madd4(r[0], centerX, madd4(r[1], centerY, madd4(r[2], centerZ, r[3])));
+				newHalf[row] = madd4(abs4(r[0]), halfX, madd4(abs4(r[1]), halfY, mul4(abs4(r[2]), halfZ)));
+			}
+
+			Vector3 newMin[4];
+			Vector3 newMax[4];
+			storeVectors(sub4(newCenter[0], newHalf[0]), sub4(newCenter[1], newHalf[1]), sub4(newCenter[2], newHalf[2]), newMin);
+			storeVectors(add4(newCenter[0], newHalf[0]), add4(newCenter[1], newHalf[1]), add4(newCenter[2], newHalf[2]), newMax);
+
+			for (UINT32 i = 0; i < 4; i++)
+				out[i].setExtents(newMin[i], newMax[i]);
+		});
+	}
+
+	void BatchMath::inverseAffine(const Matrix4* input, Matrix4* output, UINT32 count)
+	{
+		// Same algorithm as Matrix4::inverseAffine(), on four matrices at once
+		Float4 one = set4(1.0f);
+		Float4 zero = set4(0.0f);
+
+		processBlocks(input, output, count, [&](UINT32 idx, const Matrix4* in, Matrix4* out)
+		{
+			AffineMatrix4 a;
+			loadAffine(in, a);
+
+			Float4 m00 = a.m[0][0], m01 = a.m[0][1], m02 = a.m[0][2], m03 = a.m[0][3];
+			Float4 m10 = a.m[1][0], m11 = a.m[1][1], m12 = a.m[1][2], m13 = a.m[1][3];
+			Float4 m20 = a.m[2][0], m21 = a.m[2][1], m22 = a.m[2][2], m23 = a.m[2][3];
+
+			Float4 t00 = sub4(mul4(m22, m11), mul4(m21, m12));
+			Float4 t10 = sub4(mul4(m20, m12), mul4(m22, m10));
+			Float4 t20 = sub4(mul4(m21, m10), mul4(m20, m11));
+
+			Float4 invDet = div4(one, madd4(m00, t00, madd4(m01, t10, mul4(m02, t20))));
+
+			t00 = mul4(t00, invDet); t10 = mul4(t10, invDet); t20 = mul4(t20, invDet);
+			m00 = mul4(m00, invDet); m01 = mul4(m01, invDet); m02 = mul4(m02, invDet);
+
+			AffineMatrix4 r;
+			r.m[0][0] = t00;
+			r.m[0][1] = sub4(mul4(m02, m21), mul4(m01, m22));
+			r.m[0][2] = sub4(mul4(m01, m12), mul4(m02, m11));
+
+			r.m[1][0] = t10;
+			r.m[1][1] = sub4(mul4(m00, m22), mul4(m02, m20));
+			r.m[1][2] = sub4(mul4(m02, m10), mul4(m00, m12));
+
+			r.m[2][0] = t20;
+			r.m[2][1] = sub4(mul4(m01, m20), mul4(m00, m21));
+			r.m[2][2] = sub4(mul4(m00, m11), mul4(m01, m10));
+
+			for (UINT32 row = 0; row < 3; row++)
+			{
+				Float4 translation = madd4(r.m[row][0], m03, madd4(r.m[row][1], m13, mul4(r.m[row][2], m23)));
+				r.m[row][3] = sub4(zero, translation);
+			}
+
+			storeAffine(r, out);
+		});
+	}
+
+	void BatchMath::TRS(const Vector3* translations, const Quaternion* rotations, const Vector3* scales,
+		Matrix4* output, UINT32 count)
+	{
+		// Same algorithm as Matrix4::setTRS() and Quaternion::toRotationMatrix(), on four matrices at once
+		Float4 one = set4(1.0f);
+
+		processBlocks(translations, output, count, [&](UINT32 idx, const Vector3* in, Matrix4* out)
+		{
+			const Quaternion* rotationBlock = rotations + idx;
+			const Vector3* scaleBlock = scales + idx;
+
+			Quaternion paddedRotations[4];
+			Vector3 paddedScales[4];
+			if ((idx + 4) > count)
+			{
+				for (UINT32 i = 0; i < 4; i++)
+				{
+					paddedRotations[i] = rotations[std::min(idx + i, count - 1)];
+					paddedScales[i] = scales[std::min(idx + i, count - 1)];
+				}
+
+				rotationBlock = paddedRotations;
+				scaleBlock = paddedScales;
+			}
+
+			Float4 x = load4(&rotationBlock[0].x);
+			Float4 y = load4(&rotationBlock[1].x);
+			Float4 z = load4(&rotationBlock[2].x);
+			Float4 w = load4(&rotationBlock[3].x);
+			transpose4(x, y, z, w);
+
+			Float4 tx = add4(x, x);
+			Float4 ty = add4(y, y);
+			Float4 tz = add4(z, z);
+			Float4 twx = mul4(tx, w);
+			Float4 twy = mul4(ty, w);
+			Float4 twz = mul4(tz, w);
+			Float4 txx = mul4(tx, x);
+			Float4 txy = mul4(ty, x);
+			Float4 txz = mul4(tz, x);
+			Float4 tyy = mul4(ty, y);
+			Float4 tyz = mul4(tz, y);
+			Float4 tzz = mul4(tz, z);
+
+			Float4 sx, sy, sz;
+			loadVectors(scaleBlock, sx, sy, sz);
+
+			Float4 px, py, pz;
+			loadVectors(in, px, py, pz);
+
+			AffineMatrix4 r;
+			r.m[0][0] = mul4(sx, sub4(one, add4(tyy, tzz)));
+			r.m[0][1] = mul4(sy, sub4(txy, twz));
+			r.m[0][2] = mul4(sz, add4(txz, twy));
+			r.m[0][3] = px;
+
+			r.m[1][0] = mul4(sx, add4(txy, twz));
+			r.m[1][1] = mul4(sy, sub4(one, add4(txx, tzz)));
+			r.m[1][2] = mul4(sz, sub4(tyz, twx));
+			r.m[1][3] = py;
+
+			r.m[2][0] = mul4(sx, sub4(txz, twy));
+			r.m[2][1] = mul4(sy, add4(tyz, twx));
+			r.m[2][2] = mul4(sz, sub4(one, add4(txx, tyy)));
+			r.m[2][3] = pz;
+
+			storeAffine(r, out);
+		});
+	}
+}
@@ -48,6 +48,8 @@ namespace BansheeEngine
 	void BinarySerializer::encode(IReflectable* object, UINT8* buffer, UINT32 bufferLength, 
 		UINT32* bytesWritten, std::function<UINT8*(UINT8*, UINT32, UINT32&)> flushBufferCallback, bool shallow)
 	{
+		ScopedMemoryTag memoryTag(getMemoryCategoryIdx<SerializationAlloc>());
+
 		mObjectsToEncode.clear();
 		mObjectAddrToId.clear();
 		mLastUsedObjectId = 1;
@@ -189,6 +191,8 @@ namespace BansheeEngine
 
 	SPtr<SerializedObject> BinarySerializer::_decodeToIntermediate(const SPtr<DataStream>& data, UINT32 dataLength, bool copyData)
 	{
+		ScopedMemoryTag memoryTag(getMemoryCategoryIdx<SerializationAlloc>());
+
 		bool streamDataBlock = false;
 		if (!copyData && data->isFile())
 		{
@@ -100,7 +100,7 @@ namespace BansheeEngine
 			result.write(tempBuffer, numReadBytes);
 		}
 
-		free(tempBuffer);
+		bs_free(tempBuffer);
 		std::string string = result.str();
 
 		UINT32 readBytes = (UINT32)string.size();
@@ -188,7 +188,7 @@ namespace BansheeEngine
 			result.write(tempBuffer, numReadBytes);
 		}
 
-		free(tempBuffer);
+		bs_free(tempBuffer);
 		std::string string = result.str();
 
 		UINT32 readBytes = (UINT32)string.size();
@@ -281,7 +281,7 @@ namespace BansheeEngine
 	void FrameAlloc::deallocBlock(MemBlock* block)
 	{
 		block->~MemBlock();
-		bs_free_aligned(block);
+		bs_free_aligned16(block);
 	}
 
 	void FrameAlloc::setOwnerThread(ThreadId thread)
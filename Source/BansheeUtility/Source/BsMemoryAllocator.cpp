@@ -1,9 +1,455 @@
 //********************************** Banshee Engine (www.banshee3d.com) **************************************************//
 //**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
 #include "BsPrerequisitesUtil.h"
+#include "BsSpinLock.h"
+#include "BsCrashHandler.h"
 
 namespace BansheeEngine
 {
 	UINT64 BS_THREADLOCAL MemoryCounter::Allocs = 0;
 	UINT64 BS_THREADLOCAL MemoryCounter::Frees = 0;
+
+	namespace
+	{
+		/** Maximum number of different memory categories that can be tracked. Any further categories share the last one. */
+		const UINT32 MAX_MEMORY_CATEGORIES = 64;
+
+		static_assert(MAX_MEMORY_CATEGORIES <= 256, "Category indices must fit in a byte of the allocation header.");
+
+		/** Maximum length of a memory category name, including the null terminator. */
+		const UINT32 MAX_CATEGORY_NAME_LENGTH = 32;
+
+		/** 
+		 * Number of bytes a thread can allocate or free in a category before its byte count is added to the category
+		 * total. Determines how precise are the peak byte counts.
+		 */
+		const INT64 LIVE_BYTES_FLUSH_THRESHOLD = 64 * 1024;
+
+		/** Number of separately locked parts of the tracked allocation map. */
+		const UINT32 NUM_TRACKER_SHARDS = 16;
+
+		/** Number of bottom-most callstack entries belonging to the allocator itself, skipped when sampling. */
+		const UINT32 NUM_ALLOCATOR_CALLSTACK_ENTRIES = 3;
+
+		/** Allocation counts of a single category. Only written by the owning thread, but can be read by any thread. */
+		struct CategoryCounts
+		{
+			std::atomic<UINT64> numAllocs;
+			std::atomic<UINT64> numFrees;
+			std::atomic<INT64> pendingBytes; /**< Bytes allocated since the last time they were added to the total. */
+		};
+
+		/** Byte counts of a single category, shared by all threads. */
+		struct CategoryTotals
+		{
+			std::atomic<INT64> liveBytes;
+			std::atomic<INT64> peakBytes;
+		};
+
+		/**
+		 * Allocation counts of all categories, made by a single thread. Counts are kept per thread so allocations on
+		 * different threads don't contend for the same memory. Counters of threads that ended are reused by new
+		 * threads, and keep their previous counts.
+		 */
+		struct ThreadCounters
+		{
+			CategoryCounts categories[MAX_MEMORY_CATEGORIES];
+
+			UINT32 numAllocsSinceSample;
+
+			ThreadCounters* next;
+			bool inUse;
+		};
+
+		/** Allocation sampled while tracking was enabled. */
+		struct TrackedAllocation
+		{
+			UINT32 categoryIdx;
+			UINT32 numFrames;
+			UINT64 bytes;
+			UINT64* frames; /**< Null if the callstack couldn't be retrieved. */
+		};
+
+		typedef UnorderedMap<void*, TrackedAllocation, std::hash<void*>, std::equal_to<void*>, 
+			StdAlloc<std::pair<void* const, TrackedAllocation>, ProfilerAlloc>> TrackedAllocationMap;
+
+		/** Part of the tracked allocation map, chosen by allocation address. */
+		struct TrackerShard
+		{
+			SpinLock lock;
+			TrackedAllocationMap allocations;
+		};
+
+		/** Adds @p amount to a counter only ever written by the current thread. */
+		template<class T>
+		void addToCounter(std::atomic<T>& counter, T amount)
+		{
+			counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+		}
+
+		// Stored in static memory, as categories get registered from within the allocator and can't allocate themselves
+		char gCategoryNames[MAX_MEMORY_CATEGORIES][MAX_CATEGORY_NAME_LENGTH];
+		CategoryTotals gCategoryTotals[MAX_MEMORY_CATEGORIES];
+		std::atomic<UINT32> gNumCategories;
+		SpinLock gCategoryLock;
+
+		std::atomic<bool> gTrackingEnabled;
+		std::atomic<UINT32> gCallstackSampleRate;
+		std::atomic<UINT32> gNumTrackedAllocations;
+
+		BS_THREADLOCAL UINT32 gScopedCategoryIdx = MemoryCounter::INVALID_CATEGORY;
+
+		SpinLock gThreadCountersLock;
+		ThreadCounters* gAllThreadCounters = nullptr;
+
+		BS_THREADLOCAL ThreadCounters* gThreadCounters = nullptr;
+
+		/** 
+		 * Counters shared by all threads that exited and released their own counters, but still allocate or free from
+		 * destructors that run afterwards. Only written while holding gThreadCountersLock.
+		 */
+		ThreadCounters* gExitedThreadCounters = nullptr;
+
+		/** Set once the thread exits and its counters get released. */
+		BS_THREADLOCAL bool gThreadCountersReleased = false;
+
+		/** Releases the counters of the thread it was constructed on, when that thread exits. */
+		struct ThreadCountersReleaser
+		{
+			~ThreadCountersReleaser()
+			{
+				MemoryCounter::endThread();
+				gThreadCountersReleased = true;
+			}
+		};
+
+		/** Returns the counters of the current thread, assigning them if the thread doesn't have any yet. */
+		ThreadCounters* getThreadCounters()
+		{
+			if (gThreadCounters != nullptr)
+				return gThreadCounters;
+
+			// Destructor runs on thread exit, so counters don't need to be released manually
+			static thread_local ThreadCountersReleaser releaser;
+			(void)releaser;
+
+			ScopedSpinLock lock(gThreadCountersLock);
+
+			ThreadCounters* counters = gAllThreadCounters;
+			while (counters != nullptr && counters->inUse)
+				counters = counters->next;
+
+			if (counters == nullptr)
+			{
+				counters = new (::malloc(sizeof(ThreadCounters))) ThreadCounters();
+				counters->next = gAllThreadCounters;
+				gAllThreadCounters = counters;
+			}
+
+			counters->inUse = true;
+			gThreadCounters = counters;
+
+			return counters;
+		}
+
+		/** 
+		 * Provides access to the counters of the current thread while the scope is alive. If the thread already
+		 * released its counters the shared exited thread counters are used instead, locked until the scope ends.
+		 */
+		class ThreadCountersScope
+		{
+		public:
+			ThreadCountersScope()
+				:mCounters(gThreadCounters), mLocked(false)
+			{
+				if (mCounters != nullptr)
+					return;
+
+				if (!gThreadCountersReleased)
+				{
+					mCounters = getThreadCounters();
+					return;
+				}
+
+				gThreadCountersLock.lock();
+				mLocked = true;
+
+				if (gExitedThreadCounters == nullptr)
+				{
+					gExitedThreadCounters = new (::malloc(sizeof(ThreadCounters))) ThreadCounters();
+					gExitedThreadCounters->inUse = true;
+					gExitedThreadCounters->next = gAllThreadCounters;
+					gAllThreadCounters = gExitedThreadCounters;
+				}
+
+				mCounters = gExitedThreadCounters;
+			}
+
+			~ThreadCountersScope()
+			{
+				if (mLocked)
+					gThreadCountersLock.unlock();
+			}
+
+			ThreadCounters* operator->() const { return mCounters; }
+
+		private:
+			ThreadCounters* mCounters;
+			bool mLocked;
+		};
+
+		/** Adds @p bytes to the live bytes of a category, updating the category totals if enough bytes accumulate. */
+		void addLiveBytes(UINT32 categoryIdx, CategoryCounts& counts, INT64 bytes)
+		{
+			INT64 pendingBytes = counts.pendingBytes.load(std::memory_order_relaxed) + bytes;
+			if (pendingBytes < LIVE_BYTES_FLUSH_THRESHOLD && pendingBytes > -LIVE_BYTES_FLUSH_THRESHOLD)
+			{
+				counts.pendingBytes.store(pendingBytes, std::memory_order_relaxed);
+				return;
+			}
+
+			CategoryTotals& totals = gCategoryTotals[categoryIdx];
+			INT64 liveBytes = totals.liveBytes.fetch_add(pendingBytes, std::memory_order_relaxed) + pendingBytes;
+			counts.pendingBytes.store(0, std::memory_order_relaxed);
+
+			INT64 peakBytes = totals.peakBytes.load(std::memory_order_relaxed);
+			while (liveBytes > peakBytes)
+			{
+				if (totals.peakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed))
+					break;
+			}
+		}
+
+		/** 
+		 * Returns the tracked allocation map shards. Never destroyed, as allocations can be freed during static 
+		 * destruction.
+		 */
+		TrackerShard* getTrackerShards()
+		{
+			static TrackerShard* shards = []()
+			{
+				TrackerShard* output = (TrackerShard*)::malloc(sizeof(TrackerShard) * NUM_TRACKER_SHARDS);
+				for (UINT32 i = 0; i < NUM_TRACKER_SHARDS; i++)
+					new (&output[i]) TrackerShard();
+
+				return output;
+			}();
+
+			return shards;
+		}
+
+		/** Returns the shard of the tracked allocation map the allocation at @p ptr belongs to. */
+		TrackerShard& getTrackerShard(void* ptr)
+		{
+			// Low bits are mostly the same due to alignment
+			return getTrackerShards()[(((UINT64)ptr) >> 4) % NUM_TRACKER_SHARDS];
+		}
+
+		/** Records an allocation along with its callstack, until it is freed. */
+		void trackAllocation(void* ptr, UINT32 categoryIdx, size_t bytes)
+		{
+			TrackedAllocation allocation;
+			allocation.categoryIdx = categoryIdx;
+			allocation.numFrames = 0;
+			allocation.bytes = bytes;
+			allocation.frames = nullptr;
+
+			UINT64 frames[BS_MAX_SAMPLED_CALLSTACK_DEPTH];
+			allocation.numFrames = CrashHandler::getRawStackTrace(frames, BS_MAX_SAMPLED_CALLSTACK_DEPTH, 
+				NUM_ALLOCATOR_CALLSTACK_ENTRIES);
+
+			if (allocation.numFrames > 0)
+			{
+				allocation.frames = (UINT64*)::malloc(sizeof(UINT64) * allocation.numFrames);
+				memcpy(allocation.frames, frames, sizeof(UINT64) * allocation.numFrames);
+			}
+
+			TrackerShard& shard = getTrackerShard(ptr);
+			{
+				ScopedSpinLock lock(shard.lock);
+				shard.allocations[ptr] = allocation;
+			}
+
+			gNumTrackedAllocations.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		/** Removes an allocation recorded by trackAllocation(), if it was recorded. */
+		void untrackAllocation(void* ptr)
+		{
+			TrackerShard& shard = getTrackerShard(ptr);
+			UINT64* frames;
+			{
+				ScopedSpinLock lock(shard.lock);
+
+				auto iterFind = shard.allocations.find(ptr);
+				if (iterFind == shard.allocations.end())
+					return;
+
+				frames = iterFind->second.frames;
+
+				shard.allocations.erase(iterFind);
+			}
+
+			gNumTrackedAllocations.fetch_sub(1, std::memory_order_relaxed);
+
+			if (frames != nullptr)
+				::free(frames);
+		}
+	}
+
+	UINT32 MemoryCounter::getNumCategories()
+	{
+		return gNumCategories.load(std::memory_order_acquire);
+	}
+
+	MemoryCategoryStats MemoryCounter::getCategoryStats(UINT32 idx)
+	{
+		MemoryCategoryStats stats;
+		stats.name = gCategoryNames[idx];
+		stats.numAllocs = 0;
+		stats.numFrees = 0;
+		stats.liveBytes = gCategoryTotals[idx].liveBytes.load(std::memory_order_relaxed);
+
+		ScopedSpinLock lock(gThreadCountersLock);
+		for (ThreadCounters* counters = gAllThreadCounters; counters != nullptr; counters = counters->next)
+		{
+			const CategoryCounts& counts = counters->categories[idx];
+
+			stats.numAllocs += counts.numAllocs.load(std::memory_order_relaxed);
+			stats.numFrees += counts.numFrees.load(std::memory_order_relaxed);
+			stats.liveBytes += counts.pendingBytes.load(std::memory_order_relaxed);
+		}
+
+		stats.peakBytes = std::max(stats.liveBytes, gCategoryTotals[idx].peakBytes.load(std::memory_order_relaxed));
+		return stats;
+	}
+
+	void MemoryCounter::setTrackingEnabled(bool enabled)
+	{
+		gTrackingEnabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	bool MemoryCounter::isTrackingEnabled()
+	{
+		return gTrackingEnabled.load(std::memory_order_relaxed);
+	}
+
+	void MemoryCounter::setCallstackSampleRate(UINT32 rate)
+	{
+		gCallstackSampleRate.store(rate, std::memory_order_relaxed);
+	}
+
+	UINT32 MemoryCounter::getSampledAllocations(SampledAllocation* output, UINT32 maxCount)
+	{
+		TrackerShard* shards = getTrackerShards();
+
+		UINT32 numAllocations = 0;
+		for (UINT32 i = 0; i < NUM_TRACKER_SHARDS; i++)
+		{
+			ScopedSpinLock lock(shards[i].lock);
+			for (auto& entry : shards[i].allocations)
+			{
+				const TrackedAllocation& allocation = entry.second;
+				if (allocation.frames == nullptr)
+					continue;
+
+				if (numAllocations < maxCount)
+				{
+					SampledAllocation& sample = output[numAllocations];
+					sample.categoryIdx = allocation.categoryIdx;
+					sample.numFrames = allocation.numFrames;
+					sample.bytes = allocation.bytes;
+					memcpy(sample.frames, allocation.frames, sizeof(UINT64) * allocation.numFrames);
+				}
+
+				numAllocations++;
+			}
+		}
+
+		return numAllocations;
+	}
+
+	void MemoryCounter::endThread()
+	{
+		if (gThreadCounters == nullptr)
+			return;
+
+		ScopedSpinLock lock(gThreadCountersLock);
+		gThreadCounters->inUse = false;
+		gThreadCounters = nullptr;
+	}
+
+	UINT32 MemoryCounter::_setScopedCategory(UINT32 categoryIdx)
+	{
+		UINT32 prevCategoryIdx = gScopedCategoryIdx;
+		gScopedCategoryIdx = categoryIdx;
+
+		return prevCategoryIdx;
+	}
+
+	UINT32 MemoryCounter::_getScopedCategory()
+	{
+		return gScopedCategoryIdx;
+	}
+
+	UINT32 MemoryCounter::getCategoryIdx(const char* name)
+	{
+		ScopedSpinLock lock(gCategoryLock);
+
+		UINT32 numCategories = gNumCategories.load(std::memory_order_relaxed);
+		for (UINT32 i = 0; i < numCategories; i++)
+		{
+			if (strncmp(gCategoryNames[i], name, MAX_CATEGORY_NAME_LENGTH - 1) == 0)
+				return i;
+		}
+
+		if (numCategories == MAX_MEMORY_CATEGORIES)
+			return MAX_MEMORY_CATEGORIES - 1;
+
+		// Names are copied, as the module the name was provided by might get unloaded
+		strncpy(gCategoryNames[numCategories], name, MAX_CATEGORY_NAME_LENGTH - 1);
+
+		gNumCategories.store(numCategories + 1, std::memory_order_release);
+		return numCategories;
+	}
+
+	void MemoryCounter::notifyAlloc(UINT32 categoryIdx, void* ptr, size_t bytes)
+	{
+		bool sampleCallstack = false;
+
+		{
+			ThreadCountersScope counters;
+
+			if (gTrackingEnabled.load(std::memory_order_relaxed) && ptr != nullptr)
+			{
+				UINT32 sampleRate = gCallstackSampleRate.load(std::memory_order_relaxed);
+				if (sampleRate > 0 && ++counters->numAllocsSinceSample >= sampleRate)
+				{
+					counters->numAllocsSinceSample = 0;
+					sampleCallstack = true;
+				}
+			}
+
+			CategoryCounts& counts = counters->categories[categoryIdx];
+
+			addToCounter(counts.numAllocs, (UINT64)1);
+			addLiveBytes(categoryIdx, counts, (INT64)bytes);
+		}
+
+		if (sampleCallstack)
+			trackAllocation(ptr, categoryIdx, bytes);
+	}
+
+	void MemoryCounter::notifyFree(UINT32 categoryIdx, void* ptr, size_t bytes)
+	{
+		// Sampled allocations are removed even if tracking is no longer enabled, so they aren't reported as leaks
+		if (gNumTrackedAllocations.load(std::memory_order_relaxed) > 0 && ptr != nullptr)
+			untrackAllocation(ptr);
+
+		ThreadCountersScope counters;
+		CategoryCounts& counts = counters->categories[categoryIdx];
+
+		addToCounter(counts.numFrees, (UINT64)1);
+		addLiveBytes(categoryIdx, counts, -(INT64)bytes);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,474 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsPrerequisitesUtil.h"
+#include "BsSmallObjectAlloc.h"
+#include "BsSpinLock.h"
+
+namespace BansheeEngine
+{
+	namespace
+	{
+		/** Sizes of allocations in each of the size classes, in bytes. */
+		const UINT32 SIZE_CLASSES[] = { 16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256 };
+		const UINT32 NUM_SIZE_CLASSES = sizeof(SIZE_CLASSES) / sizeof(SIZE_CLASSES[0]);
+
+		/** Maps allocation size, divided by 16 and rounded up, to the index of the smallest size class it fits in. */
+		const UINT8 SIZE_CLASS_LOOKUP[] = { 0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 8, 9, 9, 10, 10, 11, 11 };
+
+		/** Offset of the first allocation from the start of a page. Space before it is used by the page header. */
+		const UINT32 PAGE_HEADER_SIZE = 64;
+
+		/** 
+		 * Size of the header in front of allocations forwarded to the OS heap, storing the allocation size. Keeps the
+		 * allocations aligned to 16 bytes.
+		 */
+		const UINT32 LARGE_ALLOC_HEADER_SIZE = 16;
+
+		/** Number of pages allocated from the OS heap at once. */
+		const UINT32 PAGES_PER_CHUNK = 16;
+
+		/** Number of free allocations moved between a thread cache and the shared list at once. */
+		const UINT32 BATCH_SIZE = 32;
+
+		/** Number of free allocations a thread can cache per size class, before returning a batch to the shared list. */
+		const UINT32 MAX_CACHED = BATCH_SIZE * 2;
+
+		const UINT32 PAGE_SHIFT = 16;
+
+		/** Number of pages covered by a single leaf of the page map. */
+		const UINT32 PAGE_MAP_LEAF_SIZE = 1 << 20;
+
+		/** Number of leaves in the page map. Together with the leaf size this covers 48 bits of address space. */
+		const UINT32 PAGE_MAP_NUM_LEAVES = 1 << 12;
+
+		static_assert((1 << PAGE_SHIFT) == SmallObjectAlloc::PAGE_SIZE, "Page shift doesn't match the page size.");
+
+		/** Header at the start of each page. */
+		struct PageHeader
+		{
+			UINT32 sizeClass;
+		};
+
+		/** Free allocation, linked into a free list. */
+		struct FreeEntry
+		{
+			FreeEntry* next;
+		};
+
+		/** Pages and the shared list of free allocations of a single size class. */
+		struct SizeClassData
+		{
+			SpinLock lock;
+			FreeEntry* freeList;
+			UINT64 numFree;
+			UINT32 numPages;
+		};
+
+		/**
+		 * Lists of free allocations owned by a single thread. Counts are only written by the owning thread, but can be
+		 * read by any thread when gathering statistics.
+		 */
+		struct ThreadCache
+		{
+			FreeEntry* freeLists[NUM_SIZE_CLASSES];
+			std::atomic<UINT32> numFree[NUM_SIZE_CLASSES];
+
+			ThreadCache* next;
+			bool inUse;
+		};
+
+		SizeClassData gSizeClasses[NUM_SIZE_CLASSES];
+
+		SpinLock gPageLock;
+		UINT8* gNextPage = nullptr;
+		UINT32 gNumRemainingPages = 0;
+
+		/**
+		 * Two level bitmap of all pages owned by the allocator, allowing free() to determine if an allocation was made
+		 * by the allocator or by the OS heap. Leaves are allocated on demand and never freed.
+		 */
+		std::atomic<std::atomic<UINT32>*> gPageMap[PAGE_MAP_NUM_LEAVES];
+
+		/** All thread caches ever created. Caches of threads that ended are reused by new threads. */
+		SpinLock gThreadCacheLock;
+		ThreadCache* gThreadCaches = nullptr;
+
+		BS_THREADLOCAL ThreadCache* gThreadCache = nullptr;
+
+		/** Set once the thread exits and its cache gets released. Allocations made after that bypass the cache. */
+		BS_THREADLOCAL bool gThreadCacheReleased = false;
+
+		/** Releases the cache of the thread it was constructed on, when that thread exits. */
+		struct ThreadCacheReleaser
+		{
+			~ThreadCacheReleaser()
+			{
+				SmallObjectAlloc::endThread();
+				gThreadCacheReleased = true;
+			}
+		};
+
+		/** Marks the page starting at the provided address as owned by the allocator. */
+		void registerPage(UINT8* page)
+		{
+			UINT64 pageIdx = (UINT64)(uintptr_t)page >> PAGE_SHIFT;
+			UINT64 leafIdx = pageIdx / PAGE_MAP_LEAF_SIZE;
+			UINT32 bitIdx = (UINT32)(pageIdx % PAGE_MAP_LEAF_SIZE);
+
+			std::atomic<UINT32>* leaf = gPageMap[leafIdx].load(std::memory_order_acquire);
+			if (leaf == nullptr)
+			{
+				std::atomic<UINT32>* newLeaf = (std::atomic<UINT32>*)::calloc(PAGE_MAP_LEAF_SIZE / 32,
+					sizeof(std::atomic<UINT32>));
+
+				if (gPageMap[leafIdx].compare_exchange_strong(leaf, newLeaf, std::memory_order_acq_rel))
+					leaf = newLeaf;
+				else
+					::free(newLeaf);
+			}
+
+			leaf[bitIdx / 32].fetch_or(1U << (bitIdx % 32), std::memory_order_release);
+		}
+
+		/** Returns the header of the page the allocation belongs to, or null if it wasn't made by the allocator. */
+		PageHeader* findPage(void* ptr)
+		{
+			UINT64 pageIdx = (UINT64)(uintptr_t)ptr >> PAGE_SHIFT;
+			UINT64 leafIdx = pageIdx / PAGE_MAP_LEAF_SIZE;
+			if (leafIdx >= PAGE_MAP_NUM_LEAVES)
+				return nullptr;
+
+			std::atomic<UINT32>* leaf = gPageMap[leafIdx].load(std::memory_order_acquire);
+			if (leaf == nullptr)
+				return nullptr;
+
+			UINT32 bitIdx = (UINT32)(pageIdx % PAGE_MAP_LEAF_SIZE);
+			if ((leaf[bitIdx / 32].load(std::memory_order_acquire) & (1U << (bitIdx % 32))) == 0)
+				return nullptr;
+
+			return (PageHeader*)((uintptr_t)ptr & ~((uintptr_t)SmallObjectAlloc::PAGE_SIZE - 1));
+		}
+
+		/** Allocates a new page. Pages are allocated from the OS heap in chunks, and are never freed. */
+		UINT8* allocPage()
+		{
+			ScopedSpinLock lock(gPageLock);
+
+			if (gNumRemainingPages == 0)
+			{
+				// Allocate an extra page so the chunk can be aligned to page size
+				UINT8* chunk = (UINT8*)::malloc(SmallObjectAlloc::PAGE_SIZE * (PAGES_PER_CHUNK + 1));
+				if (chunk == nullptr)
+					return nullptr;
+
+				uintptr_t alignedChunk = ((uintptr_t)chunk + SmallObjectAlloc::PAGE_SIZE - 1) &
+					~((uintptr_t)SmallObjectAlloc::PAGE_SIZE - 1);
+
+				gNextPage = (UINT8*)alignedChunk;
+				gNumRemainingPages = PAGES_PER_CHUNK;
+			}
+
+			UINT8* page = gNextPage;
+			gNextPage += SmallObjectAlloc::PAGE_SIZE;
+			gNumRemainingPages--;
+
+			registerPage(page);
+			return page;
+		}
+
+		/** Returns the number of allocations of the specified size class that fit in a single page. */
+		UINT32 getNumAllocsPerPage(UINT32 sizeClass)
+		{
+			return (SmallObjectAlloc::PAGE_SIZE - PAGE_HEADER_SIZE) / SIZE_CLASSES[sizeClass];
+		}
+
+		/** 
+		 * Returns the cache of the current thread, creating one if the thread doesn't have one yet. Returns null if the
+		 * thread is exiting and its cache was already released.
+		 */
+		ThreadCache* getThreadCache()
+		{
+			if (gThreadCache != nullptr)
+				return gThreadCache;
+
+			if (gThreadCacheReleased)
+				return nullptr;
+
+			// Destructor runs on thread exit, so caches don't need to be released manually
+			static thread_local ThreadCacheReleaser releaser;
+			(void)releaser;
+
+			ScopedSpinLock lock(gThreadCacheLock);
+
+			ThreadCache* cache = gThreadCaches;
+			while (cache != nullptr && cache->inUse)
+				cache = cache->next;
+
+			if (cache == nullptr)
+			{
+				cache = new (::malloc(sizeof(ThreadCache))) ThreadCache();
+				cache->next = gThreadCaches;
+				gThreadCaches = cache;
+			}
+
+			cache->inUse = true;
+			gThreadCache = cache;
+
+			return cache;
+		}
+
+		/** Allocates a new page and adds its allocations to the shared list. Caller must hold the size class lock. */
+		bool addPage(SizeClassData& data, UINT32 sizeClass)
+		{
+			UINT8* page = allocPage();
+			if (page == nullptr)
+				return false;
+
+			((PageHeader*)page)->sizeClass = sizeClass;
+
+			UINT32 allocSize = SIZE_CLASSES[sizeClass];
+			UINT32 numAllocs = getNumAllocsPerPage(sizeClass);
+
+			// Link in reverse so the list starts at the beginning of the page
+			UINT8* first = page + PAGE_HEADER_SIZE;
+			for (UINT32 i = numAllocs; i > 0; i--)
+			{
+				FreeEntry* entry = (FreeEntry*)(first + (i - 1) * allocSize);
+				entry->next = data.freeList;
+				data.freeList = entry;
+			}
+
+			data.numFree += numAllocs;
+			data.numPages++;
+
+			return true;
+		}
+
+		/** Moves a batch of free allocations from the shared list into the thread cache, allocating a new page if needed. */
+		void refillCache(ThreadCache* cache, UINT32 sizeClass)
+		{
+			SizeClassData& data = gSizeClasses[sizeClass];
+			ScopedSpinLock lock(data.lock);
+
+			if (data.freeList == nullptr && !addPage(data, sizeClass))
+				return;
+
+			UINT32 numMoved = 0;
+			FreeEntry* head = cache->freeLists[sizeClass];
+			while (data.freeList != nullptr && numMoved < BATCH_SIZE)
+			{
+				FreeEntry* entry = data.freeList;
+				data.freeList = entry->next;
+
+				entry->next = head;
+				head = entry;
+				numMoved++;
+			}
+
+			data.numFree -= numMoved;
+
+			cache->freeLists[sizeClass] = head;
+			cache->numFree[sizeClass].store(cache->numFree[sizeClass].load(std::memory_order_relaxed) + numMoved,
+				std::memory_order_relaxed);
+		}
+
+		/** Moves up to @p count free allocations from the thread cache into the shared list. */
+		void flushCache(ThreadCache* cache, UINT32 sizeClass, UINT32 count)
+		{
+			FreeEntry* first = cache->freeLists[sizeClass];
+			if (first == nullptr)
+				return;
+
+			UINT32 numMoved = 1;
+			FreeEntry* last = first;
+			while (last->next != nullptr && numMoved < count)
+			{
+				last = last->next;
+				numMoved++;
+			}
+
+			cache->freeLists[sizeClass] = last->next;
+			cache->numFree[sizeClass].store(cache->numFree[sizeClass].load(std::memory_order_relaxed) - numMoved,
+				std::memory_order_relaxed);
+
+			SizeClassData& data = gSizeClasses[sizeClass];
+			ScopedSpinLock lock(data.lock);
+
+			last->next = data.freeList;
+			data.freeList = first;
+			data.numFree += numMoved;
+		}
+
+		/** Takes a single allocation from the shared list. Used by threads that no longer have a cache. */
+		FreeEntry* allocateShared(UINT32 sizeClass)
+		{
+			SizeClassData& data = gSizeClasses[sizeClass];
+			ScopedSpinLock lock(data.lock);
+
+			if (data.freeList == nullptr && !addPage(data, sizeClass))
+				return nullptr;
+
+			FreeEntry* entry = data.freeList;
+			data.freeList = entry->next;
+			data.numFree--;
+
+			return entry;
+		}
+
+		/** Returns a single allocation to the shared list. Used by threads that no longer have a cache. */
+		void freeShared(FreeEntry* entry, UINT32 sizeClass)
+		{
+			SizeClassData& data = gSizeClasses[sizeClass];
+			ScopedSpinLock lock(data.lock);
+
+			entry->next = data.freeList;
+			data.freeList = entry;
+			data.numFree++;
+		}
+	}
+
+	UINT64 SmallObjectAllocStats::getReservedBytes() const
+	{
+		return (UINT64)numPages * SmallObjectAlloc::PAGE_SIZE;
+	}
+
+	float SmallObjectAllocStats::getFragmentation() const
+	{
+		UINT64 reservedBytes = getReservedBytes();
+		if (reservedBytes == 0)
+			return 0.0f;
+
+		return 1.0f - getUsedBytes() / (float)reservedBytes;
+	}
+
+	void* SmallObjectAlloc::allocate(size_t bytes)
+	{
+		if (bytes > MAX_ALLOC_SIZE)
+		{
+			// Size is stored in front of the allocation, as querying it from the OS heap requires taking the heap lock
+			UINT8* data = (UINT8*)::malloc(bytes + LARGE_ALLOC_HEADER_SIZE);
+			if (data == nullptr)
+				return nullptr;
+
+			*(size_t*)data = bytes;
+			return data + LARGE_ALLOC_HEADER_SIZE;
+		}
+
+		UINT32 sizeClass = SIZE_CLASS_LOOKUP[(bytes + 15) / 16];
+		ThreadCache* cache = getThreadCache();
+		if (cache == nullptr)
+			return allocateShared(sizeClass);
+
+		FreeEntry* entry = cache->freeLists[sizeClass];
+		if (entry == nullptr)
+		{
+			refillCache(cache, sizeClass);
+
+			entry = cache->freeLists[sizeClass];
+			if (entry == nullptr)
+				return nullptr;
+		}
+
+		cache->freeLists[sizeClass] = entry->next;
+		cache->numFree[sizeClass].store(cache->numFree[sizeClass].load(std::memory_order_relaxed) - 1,
+			std::memory_order_relaxed);
+
+		return entry;
+	}
+
+	void SmallObjectAlloc::free(void* ptr)
+	{
+		if (ptr == nullptr)
+			return;
+
+		PageHeader* page = findPage(ptr);
+		if (page == nullptr)
+		{
+			::free((UINT8*)ptr - LARGE_ALLOC_HEADER_SIZE);
+			return;
+		}
+
+		UINT32 sizeClass = page->sizeClass;
+		ThreadCache* cache = getThreadCache();
+		if (cache == nullptr)
+		{
+			freeShared((FreeEntry*)ptr, sizeClass);
+			return;
+		}
+
+		FreeEntry* entry = (FreeEntry*)ptr;
+		entry->next = cache->freeLists[sizeClass];
+		cache->freeLists[sizeClass] = entry;
+
+		UINT32 numFree = cache->numFree[sizeClass].load(std::memory_order_relaxed) + 1;
+		cache->numFree[sizeClass].store(numFree, std::memory_order_relaxed);
+
+		if (numFree > MAX_CACHED)
+			flushCache(cache, sizeClass, BATCH_SIZE);
+	}
+
+	size_t SmallObjectAlloc::getAllocSize(void* ptr)
+	{
+		if (ptr == nullptr)
+			return 0;
+
+		PageHeader* page = findPage(ptr);
+		if (page == nullptr)
+			return *(size_t*)((UINT8*)ptr - LARGE_ALLOC_HEADER_SIZE);
+
+		return SIZE_CLASSES[page->sizeClass];
+	}
+
+	bool SmallObjectAlloc::isSmallAlloc(void* ptr)
+	{
+		return ptr != nullptr && findPage(ptr) != nullptr;
+	}
+
+	void SmallObjectAlloc::endThread()
+	{
+		ThreadCache* cache = gThreadCache;
+		if (cache == nullptr)
+			return;
+
+		for (UINT32 i = 0; i < NUM_SIZE_CLASSES; i++)
+			flushCache(cache, i, (UINT32)-1);
+
+		ScopedSpinLock lock(gThreadCacheLock);
+		cache->inUse = false;
+		gThreadCache = nullptr;
+	}
+
+	UINT32 SmallObjectAlloc::getNumSizeClasses()
+	{
+		return NUM_SIZE_CLASSES;
+	}
+
+	SmallObjectAllocStats SmallObjectAlloc::getStats(UINT32 sizeClassIdx)
+	{
+		SmallObjectAllocStats stats;
+		stats.allocSize = SIZE_CLASSES[sizeClassIdx];
+		stats.numFreeCached = 0;
+
+		{
+			SizeClassData& data = gSizeClasses[sizeClassIdx];
+			ScopedSpinLock lock(data.lock);
+
+			stats.numPages = data.numPages;
+			stats.numFreeShared = data.numFree;
+		}
+
+		{
+			ScopedSpinLock lock(gThreadCacheLock);
+
+			for (ThreadCache* cache = gThreadCaches; cache != nullptr; cache = cache->next)
+				stats.numFreeCached += cache->numFree[sizeClassIdx].load(std::memory_order_relaxed);
+		}
+
+		UINT64 numTotal = (UINT64)stats.numPages * getNumAllocsPerPage(sizeClassIdx);
+		UINT64 numFree = stats.numFreeShared + stats.numFreeCached;
+
+		// Thread cache counts are read without synchronization, so make sure a slightly stale value doesn't underflow
+		stats.numAllocated = numTotal > numFree ? numTotal - numFree : 0;
+		return stats;
+	}
+}
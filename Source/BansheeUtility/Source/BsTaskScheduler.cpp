@@ -105,6 +105,44 @@ namespace BansheeEngine
 			mMaxActiveTasks--;
 	}
 
+	UINT32 TaskScheduler::getNumTasks(UINT32 work, UINT32 minWorkPerTask)
+	{
+		if (!isStarted())
+			return 1;
+
+		UINT32 numTasks = work / std::max(minWorkPerTask, 1U);
+		return std::max(1U, std::min(instance().getNumWorkers(), numTasks));
+	}
+
+	void TaskScheduler::runParallel(const String& name, UINT32 count, UINT32 numTasks, 
+		const std::function<void(UINT32, UINT32)>& worker)
+	{
+		if (count == 0)
+			return;
+
+		if (numTasks <= 1 || !isStarted())
+		{
+			worker(0, count);
+			return;
+		}
+
+		UINT32 countPerTask = (count + numTasks - 1) / numTasks;
+
+		Vector<SPtr<Task>> tasks;
+		for (UINT32 start = 0; start < count; start += countPerTask)
+		{
+			UINT32 end = std::min(start + countPerTask, count);
+
+			SPtr<Task> task = Task::create(name, [&worker, start, end]() { worker(start, end); });
+			instance().addTask(task);
+
+			tasks.push_back(task);
+		}
+
+		for (auto& task : tasks)
+			task->wait();
+	}
+
 	void TaskScheduler::runMain()
 	{
 		while(true)
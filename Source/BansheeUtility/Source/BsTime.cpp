@@ -2,6 +2,7 @@
 //**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
 #include "BsTime.h"
 #include "BsTimer.h"
+#include "BsDebug.h"
 
 namespace BansheeEngine
 {
@@ -9,11 +10,13 @@ namespace BansheeEngine
 
 	Time::Time()
 		:mFrameDelta(0.0f), mTimeSinceStart(0.0f), mTimeSinceStartMs(0), mAppStartTime(0), mLastFrameTime(0), 
-		mCurrentFrame(0UL)
+		mCurrentFrame(0UL), mFixedStep(16666), mLastFixedUpdateTime(0), mNumFixedUpdates(0), 
+		mMaxFixedUpdatesPerFrame(4), mFixedInterpolation(0.0f)
 	{
 		mTimer = bs_new<Timer>();
 		mAppStartTime = mTimer->getStartMs();
 		mLastFrameTime = mTimer->getMicroseconds();
+		mLastFixedUpdateTime = mLastFrameTime;
 	}
 
 	Time::~Time()
@@ -31,9 +34,36 @@ namespace BansheeEngine
 
 		mLastFrameTime = currentFrameTime;
 
+		// Accumulate elapsed time and consume it in whole fixed steps. Whatever remains determines how far between two
+		// fixed updates the current frame is.
+		UINT64 accumulatedTime = currentFrameTime - mLastFixedUpdateTime;
+		UINT64 numFixedUpdates = accumulatedTime / mFixedStep;
+
+		if (numFixedUpdates > mMaxFixedUpdatesPerFrame)
+		{
+			numFixedUpdates = mMaxFixedUpdatesPerFrame;
+			mLastFixedUpdateTime = currentFrameTime - numFixedUpdates * mFixedStep;
+		}
+
+		mNumFixedUpdates = (UINT32)numFixedUpdates;
+		mLastFixedUpdateTime += numFixedUpdates * mFixedStep;
+		mFixedInterpolation = (float)(currentFrameTime - mLastFixedUpdateTime) / (float)mFixedStep;
+
 		mCurrentFrame.fetch_add(1, std::memory_order_relaxed);
 	}
 
+	void Time::setFixedFrameDelta(float step)
+	{
+		// Also rejects NaN, as the comparison fails for it
+		if (!(step > 0.0f))
+		{
+			LOGWRN("Fixed frame delta must be larger than zero. Ignoring value: " + toString(step));
+			return;
+		}
+
+		mFixedStep = std::max((UINT64)(step / MICROSEC_TO_SEC), (UINT64)1);
+	}
+
 	UINT64 Time::getTimePrecise() const
 	{
 		return mTimer->getMicroseconds();
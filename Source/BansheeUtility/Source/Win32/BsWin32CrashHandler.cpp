@@ -71,20 +71,16 @@ namespace BansheeEngine
 	}
 
 	/**
-	 * Returns a string containing a stack trace using the provided context. If function can be found in the symbol table
-	 * its readable name will be present in the stack trace, otherwise just its address.
+	 * Returns a string containing a stack trace made of the provided function addresses. If function can be found in the
+	 * symbol table its readable name will be present in the stack trace, otherwise just its address.
 	 * 			
-	 * @param[in]	context		Processor context from which to start the stack trace. 
-	 * @param[in]	skip		Number of bottom-most call stack entries to skip.
-	 * @return					String containing the call stack with each function on its own line.
+	 * @param[in]	rawStackTrace	Function addresses, with the deepest called function first.
+	 * @param[in]	numEntries		Number of entries in @p rawStackTrace.
+	 * @param[in]	skip			Number of bottom-most call stack entries to skip.
+	 * @return						String containing the call stack with each function on its own line.
 	 */
-	String win32_getStackTrace(CONTEXT context, UINT32 skip = 0)
+	String win32_getStackTrace(const UINT64* rawStackTrace, UINT32 numEntries, UINT32 skip = 0)
 	{
-		UINT64 rawStackTrace[BS_MAX_STACKTRACE_DEPTH];
-		UINT32 numEntries = win32_getRawStackTrace(context, rawStackTrace);
-
-		numEntries = std::min((UINT32)BS_MAX_STACKTRACE_DEPTH, numEntries);
-
 		UINT32 bufferSize = sizeof(PIMAGEHLP_SYMBOL64) + BS_MAX_STACKTRACE_NAME_BYTES;
 		UINT8* buffer = (UINT8*)bs_alloc(bufferSize);
 
@@ -143,6 +139,24 @@ namespace BansheeEngine
 		return outputStream.str();
 	}
 
+	/**
+	 * Returns a string containing a stack trace using the provided context. If function can be found in the symbol table
+	 * its readable name will be present in the stack trace, otherwise just its address.
+	 * 			
+	 * @param[in]	context		Processor context from which to start the stack trace. 
+	 * @param[in]	skip		Number of bottom-most call stack entries to skip.
+	 * @return					String containing the call stack with each function on its own line.
+	 */
+	String win32_getStackTrace(CONTEXT context, UINT32 skip = 0)
+	{
+		UINT64 rawStackTrace[BS_MAX_STACKTRACE_DEPTH];
+		UINT32 numEntries = win32_getRawStackTrace(context, rawStackTrace);
+
+		numEntries = std::min((UINT32)BS_MAX_STACKTRACE_DEPTH, numEntries);
+
+		return win32_getStackTrace(rawStackTrace, numEntries, skip);
+	}
+
 	typedef bool(WINAPI *EnumProcessModulesType)(HANDLE hProcess, HMODULE* lphModule, DWORD cb, LPDWORD lpcbNeeded);
 	typedef DWORD(WINAPI *GetModuleBaseNameType)(HANDLE hProcess, HMODULE hModule, LPSTR lpBaseName, DWORD nSize);
 	typedef DWORD(WINAPI *GetModuleFileNameExType)(HANDLE hProcess, HMODULE hModule, LPSTR lpFilename, DWORD nSize);
@@ -181,6 +195,9 @@ namespace BansheeEngine
 
 	static bool gSymbolsLoaded = false;
 
+	/** DbgHelp functions aren't thread safe, so getStackTrace() calls are serialized by this mutex. */
+	static Mutex gDbgHelpMutex;
+
 	/**
 	 * Loads symbols for all modules in the current process. Loaded symbols allow the stack walker to retrieve human
 	 * readable method, file, module names and other information.
@@ -546,11 +563,34 @@ namespace BansheeEngine
 		CONTEXT context;
 		RtlCaptureContext(&context);
 
+		Lock lock(gDbgHelpMutex);
+
 		win32_initPSAPI();
 		win32_loadSymbols();
 		return win32_getStackTrace(context, 2);
 	}
 
+	String CrashHandler::getStackTrace(const UINT64* addresses, UINT32 numAddresses)
+	{
+		Lock lock(gDbgHelpMutex);
+
+		win32_initPSAPI();
+		win32_loadSymbols();
+		return win32_getStackTrace(addresses, numAddresses);
+	}
+
+	UINT32 CrashHandler::getRawStackTrace(UINT64* addresses, UINT32 maxAddresses, UINT32 skip)
+	{
+		void* frames[BS_MAX_STACKTRACE_DEPTH];
+		maxAddresses = std::min(maxAddresses, (UINT32)BS_MAX_STACKTRACE_DEPTH);
+
+		UINT32 numFrames = CaptureStackBackTrace(skip + 1, maxAddresses, frames, nullptr);
+		for (UINT32 i = 0; i < numFrames; i++)
+			addresses[i] = (UINT64)frames[i];
+
+		return numFrames;
+	}
+
 	CrashHandler& gCrashHandler()
 	{
 		return CrashHandler::instance();
@@ -17,6 +17,8 @@ namespace BansheeEngine
     /// at specified occassions:
     /// void OnInitialize() - Called once when the component is instantiated. Only called when the game is playing.
     /// void OnUpdate() - Called every frame while the game is running and the component is enabled.
+    /// void OnFixedUpdate() - Called at a fixed rate (see <see cref="Time.FixedFrameDelta"/>) while the game is running 
+    ///                        and the component is enabled. Called zero or multiple times per frame, before OnUpdate.
     /// void OnEnable() - Called whenever a component is enabled, or instantiated as enabled in which case it is called 
     ///                   after OnInitialize. Only called when the game is playing.
     /// void OnDisable() - Called whenever a component is disabled. This includes destruction where it is called before 
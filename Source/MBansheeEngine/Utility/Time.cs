@@ -40,6 +40,26 @@ namespace BansheeEngine
             get { return Internal_GetFrameDelta(); }
         }
 
+        /// <summary>
+        /// Time step at which <see cref="Component"/> OnFixedUpdate callbacks are triggered, in seconds. Fixed updates
+        /// are triggered zero or multiple times per frame, so that on average they run at a constant rate regardless of
+        /// the frame rate.
+        /// </summary>
+        public static float FixedFrameDelta
+        {
+            get { return Internal_GetFixedFrameDelta(); }
+            set { Internal_SetFixedFrameDelta(value); }
+        }
+
+        /// <summary>
+        /// Value in range [0, 1) that determines how far the current frame is between the last fixed update and the next
+        /// one. Use it for interpolating state calculated in OnFixedUpdate so it appears smooth at any frame rate.
+        /// </summary>
+        public static float FixedInterpolation
+        {
+            get { return Internal_GetFixedInterpolation(); }
+        }
+
         /// <summary>
         /// Returns the sequential index of the current frame. First frame is 0.
         /// </summary>
@@ -81,6 +101,15 @@ namespace BansheeEngine
 
         [MethodImpl(MethodImplOptions.InternalCall)]
         private static extern UInt64 Internal_GetPrecise();
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern float Internal_GetFixedFrameDelta();
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern void Internal_SetFixedFrameDelta(float value);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern float Internal_GetFixedInterpolation();
     }
 
     /** @} */
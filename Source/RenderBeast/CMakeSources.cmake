@@ -9,6 +9,7 @@ set(BS_RENDERBEAST_INC_NOFILTER
 	"Include/BsStaticRenderableHandler.h"
 	"Include/BsLightRendering.h"
 	"Include/BsPostProcessing.h"
+	"Include/BsLightCulling.h"
 )
 
 set(BS_RENDERBEAST_SRC_NOFILTER
@@ -21,6 +22,7 @@ set(BS_RENDERBEAST_SRC_NOFILTER
 	"Source/BsStaticRenderableHandler.cpp"
 	"Source/BsLightRendering.cpp"
 	"Source/BsPostProcessing.cpp"
+	"Source/BsLightCulling.cpp"
 )
 
 source_group("Header Files" FILES ${BS_RENDERBEAST_INC_NOFILTER})
@@ -0,0 +1,203 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsRenderBeastPrerequisites.h"
+#include "BsRendererMaterial.h"
+#include "BsParamBlocks.h"
+#include "BsLightRendering.h"
+#include "BsRect2I.h"
+
+namespace BansheeEngine
+{
+	/** @addtogroup RenderBeast
+	 *  @{
+	 */
+
+	BS_PARAM_BLOCK_BEGIN(TiledLightingParamBuffer)
+		BS_PARAM_BLOCK_ENTRY(Vector2I, gTileCount)
+		BS_PARAM_BLOCK_ENTRY(Vector2I, gViewportSize)
+		BS_PARAM_BLOCK_ENTRY(int, gNumLights)
+		BS_PARAM_BLOCK_ENTRY(int, gMaxLightsPerTile)
+	BS_PARAM_BLOCK_END
+
+	/**
+	 * Contains all GPU program slots that a buffer parameter with a specific renderer semantic is bound to, in the first
+	 * pass of a material. Allows the buffer to be bound directly to the pipeline.
+	 */
+	class RendererBufferParam
+	{
+	public:
+		RendererBufferParam() { }
+
+		/** Finds all slots of buffer parameters with the provided semantic in the first pass of the provided material. */
+		RendererBufferParam(const SPtr<MaterialCore>& material, StringID semantic);
+
+		/**
+		 * Binds the buffer to all slots used by the parameter.
+		 *
+		 * @param[in]	buffer		Buffer to bind, or null to unbind.
+		 * @param[in]	loadStore	Determines should the buffer be bound for random load/store access.
+		 */
+		void bind(const SPtr<GpuBufferCore>& buffer, bool loadStore = false) const;
+
+		/** Checks is the parameter used by any GPU program in the material. */
+		bool isValid() const { return !mSlots.empty(); }
+
+	private:
+		Vector<std::pair<GpuProgramType, UINT32>> mSlots;
+	};
+
+	/**
+	 * Compute shader that builds per-tile light lists on the GPU. Unlike the CPU version it also uses the scene depth
+	 * buffer to determine the depth range of each tile, culling lights that don't intersect it.
+	 */
+	class TiledLightCullingMat : public RendererMaterial<TiledLightCullingMat>
+	{
+		RMAT_DEF("TiledLightCulling.bsl");
+
+	public:
+		TiledLightCullingMat();
+
+		/** Checks can the material be used with the active render API. */
+		bool isSupported() const { return mIsSupported; }
+
+		/**
+		 * Dispatches the compute shader, populating the tile light range and light index buffers.
+		 *
+		 * @param[in]	gbuffer			Render targets containing the scene depth to cull against.
+		 * @param[in]	perCamera		Buffer containing per-camera parameters.
+		 * @param[in]	tiledParams		Buffer containing tile grid parameters.
+		 * @param[in]	lights			Buffer containing information about all lights to cull.
+		 * @param[in]	tileRanges		Buffer to write the offset and number of lights for each tile.
+		 * @param[in]	lightIndices	Buffer to write the indices of lights for each tile.
+		 * @param[in]	numTilesX		Number of tiles in horizontal direction.
+		 * @param[in]	numTilesY		Number of tiles in vertical direction.
+		 */
+		void execute(const SPtr<RenderTargets>& gbuffer, const SPtr<GpuParamBlockBufferCore>& perCamera,
+			const SPtr<GpuParamBlockBufferCore>& tiledParams, const SPtr<GpuBufferCore>& lights,
+			const SPtr<GpuBufferCore>& tileRanges, const SPtr<GpuBufferCore>& lightIndices, UINT32 numTilesX,
+			UINT32 numTilesY);
+
+	private:
+		MaterialParamTextureCore mGBufferDepth;
+		RendererBufferParam mLightsParam;
+		RendererBufferParam mTileRangesParam;
+		RendererBufferParam mLightIndicesParam;
+		bool mIsSupported;
+	};
+
+	/**
+	 * Shader that applies all point (radial & spot) lights in a single full-screen pass during deferred rendering, by
+	 * reading per-tile light lists built by TiledLightCulling.
+	 */
+	class TiledDeferredLightingMat : public RendererMaterial<TiledDeferredLightingMat>
+	{
+		RMAT_DEF("TiledDeferredLighting.bsl");
+
+	public:
+		TiledDeferredLightingMat();
+
+		/** Checks can the material be used with the active render API. */
+		bool isSupported() const { return mIsSupported; }
+
+		/** Updates parameters that are common for all lights. */
+		void setStaticParameters(const SPtr<RenderTargets>& gbuffer, const SPtr<GpuParamBlockBufferCore>& perCamera,
+			const SPtr<GpuParamBlockBufferCore>& tiledParams);
+
+		/** Binds the light and tile buffers to the pipeline. Must be called after the pass and its parameters are set. */
+		void bindBuffers(const SPtr<GpuBufferCore>& lights, const SPtr<GpuBufferCore>& tileRanges,
+			const SPtr<GpuBufferCore>& lightIndices);
+
+	private:
+		MaterialParamTextureCore mGBufferA;
+		MaterialParamTextureCore mGBufferB;
+		MaterialParamTextureCore mGBufferDepth;
+		RendererBufferParam mLightsParam;
+		RendererBufferParam mTileRangesParam;
+		RendererBufferParam mLightIndicesParam;
+		bool mIsSupported;
+	};
+
+	/**
+	 * Splits the viewport into a grid of screen-space tiles and builds a list of point lights affecting each tile. This
+	 * allows all point lights to be applied in a single full-screen pass, instead of rendering light geometry for each
+	 * light. Culling can be performed on the CPU, or on the GPU using a compute shader where supported.
+	 */
+	class TiledLightCulling
+	{
+	public:
+		/** Width and height of a single tile, in pixels. */
+		static const UINT32 TILE_SIZE = 16;
+
+		/** Maximum number of lights the GPU culling is able to assign to a single tile. */
+		static const UINT32 MAX_LIGHTS_PER_TILE = 256;
+
+		TiledLightCulling();
+
+		/**
+		 * Determines which of the provided lights are visible from the camera and uploads their information to the GPU.
+		 * Must be called before culling.
+		 *
+		 * @param[in]	camera		Camera whose frustum and viewport to cull the lights against.
+		 * @param[in]	lights		A set of radial or spot lights.
+		 * @param[in]	width		Width of the area being rendered to, in pixels.
+		 * @param[in]	height		Height of the area being rendered to, in pixels.
+		 */
+		void setLights(const CameraCore& camera, const Vector<const LightCore*>& lights, UINT32 width, UINT32 height);
+
+		/** Builds the per-tile light lists on the CPU and uploads them to the GPU. */
+		void cullCPU(const CameraCore& camera);
+
+		/** Builds the per-tile light lists on the GPU, using the provided compute material. */
+		void cullGPU(TiledLightCullingMat& material, const SPtr<RenderTargets>& gbuffer,
+			const SPtr<GpuParamBlockBufferCore>& perCamera);
+
+		/** Returns the number of lights visible from the camera, as determined by the last call to setLights(). */
+		UINT32 getNumLights() const { return (UINT32)mLightData.size(); }
+
+		/** Returns a buffer containing information about all visible lights. */
+		const SPtr<GpuBufferCore>& getLightBuffer() const { return mLightBuffer; }
+
+		/** Returns a buffer containing a (offset, count) pair into the light index buffer, for each tile. */
+		const SPtr<GpuBufferCore>& getTileRangeBuffer() const { return mTileRangeBuffer; }
+
+		/** Returns a buffer containing indices of lights affecting each tile. */
+		const SPtr<GpuBufferCore>& getLightIndexBuffer() const { return mLightIndexBuffer; }
+
+		/** Returns a parameter buffer containing information about the tile grid. */
+		const SPtr<GpuParamBlockBufferCore>& getParamBuffer() const { return mParams.getBuffer(); }
+
+	private:
+		/**
+		 * Calculates the range of tiles covered by the provided view space sphere. Returns false if the sphere doesn't
+		 * cover any tiles.
+		 */
+		bool getTileRect(const CameraCore& camera, const Vector3& viewCenter, float radius, Rect2I& output) const;
+
+		/**
+		 * Makes sure the tile buffers are large enough to hold the specified number of elements, and that they can be
+		 * written to by the GPU if required.
+		 */
+		void allocateTileBuffers(UINT32 numRanges, UINT32 numIndices, bool gpuWritable);
+
+		TiledLightingParamBuffer mParams;
+
+		Vector<LightShaderData> mLightData;
+		Vector<Sphere> mLightBounds;
+		Vector<UINT32> mTileLightRanges;
+		Vector<UINT32> mTileLightIndices;
+
+		UINT32 mWidth;
+		UINT32 mHeight;
+		UINT32 mNumTilesX;
+		UINT32 mNumTilesY;
+
+		SPtr<GpuBufferCore> mLightBuffer;
+		SPtr<GpuBufferCore> mTileRangeBuffer;
+		SPtr<GpuBufferCore> mLightIndexBuffer;
+		bool mTileBuffersGpuWritable;
+	};
+
+	/** @} */
+}
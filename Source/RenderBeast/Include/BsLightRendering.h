@@ -21,6 +21,18 @@ namespace BansheeEngine
 		BS_PARAM_BLOCK_ENTRY(Matrix4, gMatConeTransform)
 	BS_PARAM_BLOCK_END
 
+	/** 
+	 * Information about a single light, as seen by the lighting shaders. Layout matches the relevant part of the 
+	 * PerLight parameter buffer, and is used directly as the element type of light buffers used for tiled lighting.
+	 */
+	struct LightShaderData
+	{
+		Vector4 positionAndType;
+		Vector4 colorAndIntensity;
+		Vector4 spotAnglesAndSqrdInvRadius;
+		Vector4 direction;
+	};
+
 	/** Manipulates PerLight parameter buffer used in various shaders. */
 	class PerLightParams
 	{
@@ -28,6 +40,9 @@ namespace BansheeEngine
 		/** Updates data in the parameter buffer from the data in the provided light. */
 		void setParameters(const LightCore* light);
 
+		/** Populates the provided structure with information about the light, in the format expected by the shaders. */
+		static void getShaderData(const LightCore* light, LightShaderData& output);
+
 		/** Returns the internal parameter buffer that can be bound to the pipeline. */
 		const SPtr<GpuParamBlockBufferCore>& getBuffer() const;
 	private:
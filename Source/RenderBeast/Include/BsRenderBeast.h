@@ -9,6 +9,7 @@
 #include "BsSamplerOverrides.h"
 #include "BsRendererMaterial.h"
 #include "BsLightRendering.h"
+#include "BsLightCulling.h"
 #include "BsPostProcessing.h"
 
 namespace BansheeEngine
@@ -23,6 +24,9 @@ namespace BansheeEngine
 	static StringID RPS_GBufferA = "GBufferA";
 	static StringID RPS_GBufferB = "GBufferB";
 	static StringID RPS_GBufferDepth = "GBufferDepth";
+	static StringID RPS_LightData = "LightData";
+	static StringID RPS_TileLightRanges = "TileLightRanges";
+	static StringID RPS_TileLightIndices = "TileLightIndices";
 
 	/** Basic shader that is used when no other is available. */
 	class DefaultMaterial : public RendererMaterial<DefaultMaterial> { RMAT_DEF("Default.bsl"); };
@@ -45,6 +49,21 @@ namespace BansheeEngine
 		float worldDeterminantSign;
 	};
 
+	/** 
+	 * Per-object data for a single instance in an instanced draw call. Shaders that support instancing read an array of
+	 * these from a structured buffer with the RPS_InstanceData semantic. Layout mirrors PerObjectParamBuffer.
+	 */
+	struct InstanceShaderData
+	{
+		Matrix4 worldViewProj;
+		Matrix4 world;
+		Matrix4 invWorld;
+		Matrix4 worldNoScale;
+		Matrix4 invWorldNoScale;
+		float worldDeterminantSign;
+		float padding[3];
+	};
+
 	/**	Data bound to the shader when rendering a with a specific camera. */
 	struct CameraShaderData
 	{
@@ -156,6 +175,9 @@ namespace BansheeEngine
 		/** @copydoc Renderer::notifyRenderableUpdated */
 		void notifyRenderableUpdated(RenderableCore* renderable) override;
 
+		/** @copydoc Renderer::notifyRenderableTransformsUpdated */
+		void notifyRenderableTransformsUpdated(const Vector<RenderableTransform>& transforms) override;
+
 		/** @copydoc Renderer::notifyRenderableRemoved */
 		void notifyRenderableRemoved(RenderableCore* renderable) override;
 
@@ -273,11 +295,19 @@ namespace BansheeEngine
 
 		Vector<RenderableData> mRenderables;
 		Vector<RenderableShaderData> mRenderableShaderData;
+		Vector<InstanceShaderData> mInstanceData;
 		Vector<Bounds> mWorldBounds;
+		Vector<Bounds> mLocalBounds;
+
+		// Scratch buffers for bulk transform updates, kept around to avoid reallocating them every frame
+		Vector<Matrix4> mTransformScratch;
+		Vector<Matrix4> mInvTransformScratch;
+		Vector<AABox> mBoundsScratch;
 
 		Vector<LightData> mDirectionalLights;
 		Vector<LightData> mPointLights;
 		Vector<Sphere> mLightWorldBounds;
+		Vector<const LightCore*> mActivePointLights;
 
 		SPtr<RenderBeastOptions> mCoreOptions;
 
@@ -285,6 +315,9 @@ namespace BansheeEngine
 		PointLightInMat* mPointLightInMat;
 		PointLightOutMat* mPointLightOutMat;
 		DirectionalLightMat* mDirLightMat;
+		TiledLightCullingMat* mTiledLightCullingMat;
+		TiledDeferredLightingMat* mTiledLightingMat;
+		TiledLightCulling* mTiledLightCulling;
 
 		// Sim thread only fields
 		StaticRenderableHandler* mStaticHandler;
@@ -39,6 +39,21 @@ namespace BansheeEngine
 		 * changes. Sorting by material can reduce CPU usage but could increase overdraw.
 		 */
 		StateReduction stateReductionMode = StateReduction::Distance;
+
+		/**
+		 * Determines should objects sharing the same mesh and material be rendered using instanced draw calls. Only
+		 * relevant for shaders that read per-object data from a buffer with the RPS_InstanceData semantic, and only on
+		 * render APIs that support generic GPU buffers.
+		 */
+		bool instancing = true;
+
+		/**
+		 * Determines should radial and spot lights be culled into per-tile light lists and applied in a single full-screen
+		 * pass, instead of rendering light geometry for each light. Culling is performed using a compute shader where
+		 * supported, and on the CPU otherwise. Only relevant on render APIs that support generic GPU buffers, and for
+		 * cameras that don't use MSAA.
+		 */
+		bool tiledLighting = true;
 	};
 
 	/** @} */
@@ -30,12 +30,41 @@ namespace BansheeEngine
 
 		RenderTexturePool* mPool;
 		bool mIsFree;
+		size_t mDescHash;
+		UINT64 mLastUsedFrame;
+		UINT32 mMemorySize;
 	};
 
-	/** Contains a pool of render textures meant to accommodate reuse of render textures of the same size and format. */
+	/** Contains information about memory use and texture reuse of a RenderTexturePool. */
+	struct RenderTexturePoolStats
+	{
+		RenderTexturePoolStats()
+			: numTextures(0), numFreeTextures(0), allocatedMemory(0), peakAllocatedMemory(0), numAllocations(0)
+			, numReuses(0), numEvictions(0)
+		{ }
+
+		UINT32 numTextures; /**< Total number of textures currently allocated by the pool, both used and free. */
+		UINT32 numFreeTextures; /**< Number of allocated textures that are currently not in use. */
+		UINT64 allocatedMemory; /**< Estimated amount of GPU memory used by all allocated textures, in bytes. */
+		UINT64 peakAllocatedMemory; /**< Highest value of allocatedMemory since the pool was created, in bytes. */
+
+		UINT32 numAllocations; /**< Number of textures that had to be created during the last frame. */
+		UINT32 numReuses; /**< Number of requests during the last frame that were satisfied by an existing texture. */
+		UINT32 numEvictions; /**< Number of unused textures that were destroyed during the last frame. */
+	};
+
+	/** 
+	 * Contains a pool of render textures meant to accommodate reuse of render textures of the same size and format. 
+	 *
+	 * Free textures are looked up by a hash of their descriptor, which allows passes whose texture lifetimes do not
+	 * overlap to alias the same texture memory (e.g. post-processing targets that are released before the next pass
+	 * requests a texture). Textures that remain unused for a certain number of frames are destroyed, so memory used by
+	 * transient targets (e.g. after a viewport resize) is eventually returned.
+	 */
 	class RenderTexturePool : public Module<RenderTexturePool>
 	{
 	public:
+		RenderTexturePool();
 		~RenderTexturePool();
 
 		/**
@@ -56,6 +85,24 @@ namespace BansheeEngine
 		 */
 		void release(const SPtr<PooledRenderTexture>& texture);
 
+		/**
+		 * Advances the pool to the next frame. Free textures that haven't been used for more than the allowed number of
+		 * frames are destroyed. Should be called once per frame after all rendering is done.
+		 */
+		void update();
+
+		/**
+		 * Sets the number of frames a free texture will be kept alive in the pool for before it is destroyed. Zero
+		 * means free textures are destroyed at the end of the frame they were released in.
+		 */
+		void setMaxUnusedFrames(UINT32 numFrames) { mMaxUnusedFrames = numFrames; }
+
+		/** Returns the number of frames a free texture will be kept alive in the pool for. */
+		UINT32 getMaxUnusedFrames() const { return mMaxUnusedFrames; }
+
+		/** Returns information about memory usage and texture reuse of the pool. */
+		const RenderTexturePoolStats& getStats() const { return mStats; }
+
 	private:
 		friend struct PooledRenderTexture;
 
@@ -73,7 +120,19 @@ namespace BansheeEngine
 		 */
 		static bool matches(const SPtr<TextureCore>& texture, const POOLED_RENDER_TEXTURE_DESC& desc);
 
-		Map<PooledRenderTexture*, std::weak_ptr<PooledRenderTexture>> mTextures;
+		/** Generates a hash value for the provided descriptor. Textures with the same hash are interchangeable. */
+		static size_t getHash(const POOLED_RENDER_TEXTURE_DESC& desc);
+
+		/** Returns an estimate of the amount of GPU memory a texture created from the provided descriptor will use. */
+		static UINT32 getMemorySize(const POOLED_RENDER_TEXTURE_DESC& desc);
+
+		UnorderedMap<PooledRenderTexture*, std::weak_ptr<PooledRenderTexture>> mTextures;
+		UnorderedMap<size_t, Vector<SPtr<PooledRenderTexture>>> mFreeTextures;
+
+		UINT64 mFrameIdx;
+		UINT32 mMaxUnusedFrames;
+		RenderTexturePoolStats mStats;
+		RenderTexturePoolStats mFrameStats;
 	};
 
 	/** Structure used for creating a new pooled render texture. */
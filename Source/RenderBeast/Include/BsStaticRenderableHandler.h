@@ -46,12 +46,34 @@ namespace BansheeEngine
 	class BS_BSRND_EXPORT StaticRenderableHandler : public RenderableHandler
 	{
 	public:
+		/** Contains information about a GPU program slot the instance data buffer is to be bound to. */
+		struct InstanceBufferBindInfo
+		{
+			InstanceBufferBindInfo(UINT32 passIdx, GpuProgramType programType, UINT32 slotIdx)
+				:passIdx(passIdx), programType(programType), slotIdx(slotIdx)
+			{ }
+
+			UINT32 passIdx;
+			GpuProgramType programType;
+			UINT32 slotIdx;
+		};
+
 		/** Contains lit tex renderable data unique for each object. */
 		struct PerObjectData
 		{
+			/** 
+			 * Per-object parameters owned by this object. Each object keeps its own block so that data which didn't
+			 * change since the last frame doesn't need to be uploaded to the GPU again.
+			 */
+			SPtr<PerObjectParamBuffer> perObjectParams;
+
 			Vector<RenderableElement::BufferBindInfo> perObjectBuffers;
+			Vector<InstanceBufferBindInfo> instanceBuffers;
 		};
 
+		/** Maximum number of instances that may be rendered using a single instanced draw call. */
+		static const UINT32 MAX_INSTANCES_PER_DRAW = 512;
+
 		StaticRenderableHandler();
 
 		/** @copydoc RenderableHandler::initializeRenderElem */
@@ -74,6 +96,24 @@ namespace BansheeEngine
 		 */
 		void updatePerObjectBuffers(RenderableElement& element, const RenderableShaderData& data, const Matrix4& wvpMatrix);
 
+		/** 
+		 * Checks does the material of the provided element read per-object data from an instance buffer in the specified
+		 * pass, allowing it to be rendered using instanced draw calls. 
+		 */
+		bool supportsInstancing(const RenderableElement& element, UINT32 passIdx) const;
+
+		/** 
+		 * Updates the buffer containing per-instance data with new values. 
+		 *
+		 * @param[in]	data			Array of per-instance data entries.
+		 * @param[in]	numInstances	Number of entries in the @p data array. Must not be larger than
+		 *								MAX_INSTANCES_PER_DRAW.
+		 */
+		void updateInstanceBuffer(const InstanceShaderData* data, UINT32 numInstances);
+
+		/** Binds the instance buffer to all GPU program slots that require it, for the specified element and pass. */
+		void bindInstanceBuffer(const RenderableElement& element, UINT32 passIdx);
+
 		/** Returns a buffer that stores per-camera parameters. */
 		const PerCameraParamBuffer& getPerCameraParams() const { return mPerCameraParams; }
 
@@ -81,6 +121,8 @@ namespace BansheeEngine
 		PerFrameParamBuffer mPerFrameParams;
 		PerCameraParamBuffer mPerCameraParams;
 		PerObjectParamBuffer mPerObjectParams;
+
+		SPtr<GpuBufferCore> mInstanceBuffer;
 	};
 
 	/** @} */
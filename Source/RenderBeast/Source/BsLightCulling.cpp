@@ -0,0 +1,385 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsLightCulling.h"
+#include "BsMaterial.h"
+#include "BsShader.h"
+#include "BsRenderBeast.h"
+#include "BsRenderTargets.h"
+#include "BsGpuParams.h"
+#include "BsGpuBuffer.h"
+#include "BsHardwareBufferManager.h"
+#include "BsRendererUtility.h"
+#include "BsRenderAPI.h"
+#include "BsCamera.h"
+#include "BsLight.h"
+
+namespace BansheeEngine
+{
+	RendererBufferParam::RendererBufferParam(const SPtr<MaterialCore>& material, StringID semantic)
+	{
+		// Note: Must be in the same order as parameters in PassParametersCore
+		static const GpuProgramType PROGRAM_TYPES[] =
+		{
+			GPT_VERTEX_PROGRAM, GPT_FRAGMENT_PROGRAM, GPT_GEOMETRY_PROGRAM, GPT_HULL_PROGRAM, GPT_DOMAIN_PROGRAM,
+			GPT_COMPUTE_PROGRAM
+		};
+
+		SPtr<ShaderCore> shader = material->getShader();
+		if (shader == nullptr || material->getNumPasses() == 0)
+			return;
+
+		SPtr<PassParametersCore> passParams = material->getPassParameters(0);
+
+		const Map<String, SHADER_OBJECT_PARAM_DESC>& bufferParamDescs = shader->getBufferParams();
+		for (auto& bufferParamDesc : bufferParamDescs)
+		{
+			if (bufferParamDesc.second.rendererSemantic != semantic)
+				continue;
+
+			for (UINT32 i = 0; i < PassParametersCore::NUM_PARAMS; i++)
+			{
+				SPtr<GpuParamsCore> gpuParams = passParams->getParamByIdx(i);
+				if (gpuParams == nullptr)
+					continue;
+
+				const GpuParamDesc& paramsDesc = gpuParams->getParamDesc();
+				for (auto& gpuVariableName : bufferParamDesc.second.gpuVariableNames)
+				{
+					auto findIter = paramsDesc.buffers.find(gpuVariableName);
+					if (findIter != paramsDesc.buffers.end())
+						mSlots.push_back(std::make_pair(PROGRAM_TYPES[i], findIter->second.slot));
+				}
+			}
+		}
+	}
+
+	void RendererBufferParam::bind(const SPtr<GpuBufferCore>& buffer, bool loadStore) const
+	{
+		RenderAPICore& rapi = RenderAPICore::instance();
+		for (auto& slot : mSlots)
+			rapi.setBuffer(slot.first, slot.second, buffer, loadStore);
+	}
+
+	TiledLightCullingMat::TiledLightCullingMat()
+		:mIsSupported(false)
+	{
+		if (mMaterial->getShader() == nullptr)
+			return;
+
+		auto& texParams = mMaterial->getShader()->getTextureParams();
+		for (auto& entry : texParams)
+		{
+			if (entry.second.rendererSemantic == RPS_GBufferDepth)
+				mGBufferDepth = mMaterial->getParamTexture(entry.second.name);
+		}
+
+		mLightsParam = RendererBufferParam(mMaterial, RPS_LightData);
+		mTileRangesParam = RendererBufferParam(mMaterial, RPS_TileLightRanges);
+		mLightIndicesParam = RendererBufferParam(mMaterial, RPS_TileLightIndices);
+
+		const RenderAPICapabilities* caps = RenderAPICore::instance().getCapabilities();
+		mIsSupported = caps->hasCapability(RSC_COMPUTE_PROGRAM) && mLightsParam.isValid() &&
+			mTileRangesParam.isValid() && mLightIndicesParam.isValid();
+	}
+
+	void TiledLightCullingMat::_initDefines(ShaderDefines& defines)
+	{
+		defines.set("TILE_SIZE", TiledLightCulling::TILE_SIZE);
+		defines.set("MAX_LIGHTS_PER_TILE", TiledLightCulling::MAX_LIGHTS_PER_TILE);
+	}
+
+	void TiledLightCullingMat::execute(const SPtr<RenderTargets>& gbuffer, const SPtr<GpuParamBlockBufferCore>& perCamera,
+		const SPtr<GpuParamBlockBufferCore>& tiledParams, const SPtr<GpuBufferCore>& lights,
+		const SPtr<GpuBufferCore>& tileRanges, const SPtr<GpuBufferCore>& lightIndices, UINT32 numTilesX,
+		UINT32 numTilesY)
+	{
+		mGBufferDepth.set(gbuffer->getTextureDepth());
+
+		mMaterial->setParamBlockBuffer("PerCamera", perCamera);
+		mMaterial->setParamBlockBuffer("TiledLighting", tiledParams);
+
+		gRendererUtility().setComputePass(mMaterial);
+
+		mLightsParam.bind(lights);
+		mTileRangesParam.bind(tileRanges, true);
+		mLightIndicesParam.bind(lightIndices, true);
+
+		RenderAPICore& rapi = RenderAPICore::instance();
+		rapi.dispatchCompute(numTilesX, numTilesY);
+
+		// Unbind the outputs so they can be bound for reading by the lighting pass
+		mTileRangesParam.bind(nullptr, true);
+		mLightIndicesParam.bind(nullptr, true);
+	}
+
+	TiledDeferredLightingMat::TiledDeferredLightingMat()
+		:mIsSupported(false)
+	{
+		if (mMaterial->getShader() == nullptr)
+			return;
+
+		auto& texParams = mMaterial->getShader()->getTextureParams();
+		for (auto& entry : texParams)
+		{
+			if (entry.second.rendererSemantic == RPS_GBufferA)
+				mGBufferA = mMaterial->getParamTexture(entry.second.name);
+			else if (entry.second.rendererSemantic == RPS_GBufferB)
+				mGBufferB = mMaterial->getParamTexture(entry.second.name);
+			else if (entry.second.rendererSemantic == RPS_GBufferDepth)
+				mGBufferDepth = mMaterial->getParamTexture(entry.second.name);
+		}
+
+		mLightsParam = RendererBufferParam(mMaterial, RPS_LightData);
+		mTileRangesParam = RendererBufferParam(mMaterial, RPS_TileLightRanges);
+		mLightIndicesParam = RendererBufferParam(mMaterial, RPS_TileLightIndices);
+
+		mIsSupported = mLightsParam.isValid() && mTileRangesParam.isValid() && mLightIndicesParam.isValid();
+	}
+
+	void TiledDeferredLightingMat::_initDefines(ShaderDefines& defines)
+	{
+		defines.set("TILE_SIZE", TiledLightCulling::TILE_SIZE);
+	}
+
+	void TiledDeferredLightingMat::setStaticParameters(const SPtr<RenderTargets>& gbuffer,
+		const SPtr<GpuParamBlockBufferCore>& perCamera, const SPtr<GpuParamBlockBufferCore>& tiledParams)
+	{
+		mGBufferA.set(gbuffer->getTextureA());
+		mGBufferB.set(gbuffer->getTextureB());
+		mGBufferDepth.set(gbuffer->getTextureDepth());
+
+		mMaterial->setParamBlockBuffer("PerCamera", perCamera);
+		mMaterial->setParamBlockBuffer("TiledLighting", tiledParams);
+	}
+
+	void TiledDeferredLightingMat::bindBuffers(const SPtr<GpuBufferCore>& lights, const SPtr<GpuBufferCore>& tileRanges,
+		const SPtr<GpuBufferCore>& lightIndices)
+	{
+		mLightsParam.bind(lights);
+		mTileRangesParam.bind(tileRanges);
+		mLightIndicesParam.bind(lightIndices);
+	}
+
+	TiledLightCulling::TiledLightCulling()
+		:mWidth(0), mHeight(0), mNumTilesX(0), mNumTilesY(0), mTileBuffersGpuWritable(false)
+	{ }
+
+	void TiledLightCulling::setLights(const CameraCore& camera, const Vector<const LightCore*>& lights, UINT32 width,
+		UINT32 height)
+	{
+		mWidth = width;
+		mHeight = height;
+		mNumTilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+		mNumTilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+
+		mLightData.clear();
+		mLightBounds.clear();
+
+		ConvexVolume worldFrustum = camera.getWorldFrustum();
+		for (auto& light : lights)
+		{
+			const Sphere& bounds = light->getBounds();
+			if (!worldFrustum.intersects(bounds))
+				continue;
+
+			mLightData.push_back(LightShaderData());
+			PerLightParams::getShaderData(light, mLightData.back());
+
+			mLightBounds.push_back(bounds);
+		}
+
+		mParams.gTileCount.set(Vector2I((INT32)mNumTilesX, (INT32)mNumTilesY));
+		mParams.gViewportSize.set(Vector2I((INT32)width, (INT32)height));
+		mParams.gNumLights.set((INT32)mLightData.size());
+		mParams.gMaxLightsPerTile.set((INT32)MAX_LIGHTS_PER_TILE);
+
+		UINT32 numLights = std::max((UINT32)mLightData.size(), 1U);
+		if (mLightBuffer == nullptr || mLightBuffer->getProperties().getElementCount() < numLights)
+		{
+			mLightBuffer = HardwareBufferCoreManager::instance().createGpuBuffer(numLights, sizeof(LightShaderData),
+				GBT_STRUCTURED, GBU_DYNAMIC);
+		}
+
+		if (!mLightData.empty())
+		{
+			mLightBuffer->writeData(0, (UINT32)mLightData.size() * sizeof(LightShaderData), mLightData.data(),
+				BufferWriteType::Discard);
+		}
+	}
+
+	void TiledLightCulling::cullCPU(const CameraCore& camera)
+	{
+		UINT32 numTiles = mNumTilesX * mNumTilesY;
+		UINT32 numLights = (UINT32)mLightData.size();
+
+		// Stores (offset, count) pairs per tile
+		mTileLightRanges.assign(numTiles * 2, 0);
+
+		Vector<Rect2I> lightTileRects(numLights);
+		Vector<bool> lightIsVisible(numLights);
+
+		const Matrix4& viewMatrix = camera.getViewMatrix();
+		for (UINT32 i = 0; i < numLights; i++)
+		{
+			Vector3 viewCenter = viewMatrix.multiplyAffine(mLightBounds[i].getCenter());
+			lightIsVisible[i] = getTileRect(camera, viewCenter, mLightBounds[i].getRadius(), lightTileRects[i]);
+		}
+
+		// Count number of lights per tile
+		for (UINT32 i = 0; i < numLights; i++)
+		{
+			if (!lightIsVisible[i])
+				continue;
+
+			const Rect2I& rect = lightTileRects[i];
+			for (INT32 y = rect.y; y < rect.y + rect.height; y++)
+			{
+				for (INT32 x = rect.x; x < rect.x + rect.width; x++)
+					mTileLightRanges[(y * mNumTilesX + x) * 2 + 1]++;
+			}
+		}
+
+		// Calculate offsets into the index list
+		UINT32 numIndices = 0;
+		for (UINT32 i = 0; i < numTiles; i++)
+		{
+			mTileLightRanges[i * 2 + 0] = numIndices;
+			numIndices += mTileLightRanges[i * 2 + 1];
+
+			mTileLightRanges[i * 2 + 1] = 0;
+		}
+
+		// Populate the index list
+		mTileLightIndices.resize(numIndices);
+		for (UINT32 i = 0; i < numLights; i++)
+		{
+			if (!lightIsVisible[i])
+				continue;
+
+			const Rect2I& rect = lightTileRects[i];
+			for (INT32 y = rect.y; y < rect.y + rect.height; y++)
+			{
+				for (INT32 x = rect.x; x < rect.x + rect.width; x++)
+				{
+					UINT32 tileIdx = y * mNumTilesX + x;
+					UINT32& count = mTileLightRanges[tileIdx * 2 + 1];
+
+					mTileLightIndices[mTileLightRanges[tileIdx * 2 + 0] + count] = i;
+					count++;
+				}
+			}
+		}
+
+		allocateTileBuffers(numTiles, numIndices, false);
+
+		if (numTiles > 0)
+		{
+			mTileRangeBuffer->writeData(0, numTiles * 2 * sizeof(UINT32), mTileLightRanges.data(),
+				BufferWriteType::Discard);
+		}
+
+		if (numIndices > 0)
+		{
+			mLightIndexBuffer->writeData(0, numIndices * sizeof(UINT32), mTileLightIndices.data(),
+				BufferWriteType::Discard);
+		}
+	}
+
+	void TiledLightCulling::cullGPU(TiledLightCullingMat& material, const SPtr<RenderTargets>& gbuffer,
+		const SPtr<GpuParamBlockBufferCore>& perCamera)
+	{
+		UINT32 numTiles = mNumTilesX * mNumTilesY;
+		allocateTileBuffers(numTiles, numTiles * MAX_LIGHTS_PER_TILE, true);
+
+		material.execute(gbuffer, perCamera, mParams.getBuffer(), mLightBuffer, mTileRangeBuffer, mLightIndexBuffer,
+			mNumTilesX, mNumTilesY);
+	}
+
+	bool TiledLightCulling::getTileRect(const CameraCore& camera, const Vector3& viewCenter, float radius,
+		Rect2I& output) const
+	{
+		// Camera looks down the negative Z axis
+		float nearDepth = -viewCenter.z - radius;
+
+		float minX, minY, maxX, maxY;
+		if (nearDepth <= camera.getNearClipDistance())
+		{
+			// Sphere intersects the near plane, cannot project it reliably so assume it covers the entire viewport
+			minX = 0.0f;
+			minY = 0.0f;
+			maxX = (float)mWidth;
+			maxY = (float)mHeight;
+		}
+		else
+		{
+			const Matrix4& projMatrix = camera.getProjectionMatrixRS();
+
+			minX = std::numeric_limits<float>::max();
+			minY = std::numeric_limits<float>::max();
+			maxX = -std::numeric_limits<float>::max();
+			maxY = -std::numeric_limits<float>::max();
+
+			// Project corners of the sphere's bounding box, which is conservative but cheap
+			for (UINT32 i = 0; i < 8; i++)
+			{
+				Vector3 corner = viewCenter;
+				corner.x += (i & 1) ? radius : -radius;
+				corner.y += (i & 2) ? radius : -radius;
+				corner.z += (i & 4) ? radius : -radius;
+
+				Vector4 clipPos = projMatrix.multiply(Vector4(corner.x, corner.y, corner.z, 1.0f));
+				float ndcX = clipPos.x / clipPos.w;
+				float ndcY = clipPos.y / clipPos.w;
+
+				float screenX = (ndcX * 0.5f + 0.5f) * mWidth;
+				float screenY = (0.5f - ndcY * 0.5f) * mHeight;
+
+				minX = std::min(minX, screenX);
+				minY = std::min(minY, screenY);
+				maxX = std::max(maxX, screenX);
+				maxY = std::max(maxY, screenY);
+			}
+		}
+
+		INT32 minTileX = Math::clamp(Math::floorToInt(minX / TILE_SIZE), 0, (INT32)mNumTilesX);
+		INT32 minTileY = Math::clamp(Math::floorToInt(minY / TILE_SIZE), 0, (INT32)mNumTilesY);
+		INT32 maxTileX = Math::clamp(Math::ceilToInt(maxX / TILE_SIZE), 0, (INT32)mNumTilesX);
+		INT32 maxTileY = Math::clamp(Math::ceilToInt(maxY / TILE_SIZE), 0, (INT32)mNumTilesY);
+
+		if (minTileX >= maxTileX || minTileY >= maxTileY)
+			return false;
+
+		output.x = minTileX;
+		output.y = minTileY;
+		output.width = maxTileX - minTileX;
+		output.height = maxTileY - minTileY;
+
+		return true;
+	}
+
+	void TiledLightCulling::allocateTileBuffers(UINT32 numRanges, UINT32 numIndices, bool gpuWritable)
+	{
+		HardwareBufferCoreManager& hwbm = HardwareBufferCoreManager::instance();
+
+		// Buffers written by the CPU are dynamic, while buffers written by the GPU must allow random writes. These
+		// requirements are mutually exclusive so the buffers are re-created when switching between the two.
+		GpuBufferUsage usage = gpuWritable ? GBU_STATIC : GBU_DYNAMIC;
+		bool recreate = mTileBuffersGpuWritable != gpuWritable;
+
+		numRanges = std::max(numRanges, 1U);
+		if (recreate || mTileRangeBuffer == nullptr || mTileRangeBuffer->getProperties().getElementCount() < numRanges)
+		{
+			mTileRangeBuffer = hwbm.createGpuBuffer(numRanges, sizeof(UINT32) * 2, GBT_STRUCTURED, usage,
+				gpuWritable);
+		}
+
+		numIndices = std::max(numIndices, 1U);
+		if (recreate || mLightIndexBuffer == nullptr || mLightIndexBuffer->getProperties().getElementCount() < numIndices)
+		{
+			mLightIndexBuffer = hwbm.createGpuBuffer(numIndices, sizeof(UINT32), GBT_STRUCTURED, usage,
+				gpuWritable);
+		}
+
+		mTileBuffersGpuWritable = gpuWritable;
+	}
+}
@@ -15,43 +15,15 @@ namespace BansheeEngine
 		// Note: I could just copy the data directly to the parameter buffer if I ensured the parameter
 		// layout matches
 
-		Vector4 positionAndType = (Vector4)light->getPosition();
+		LightShaderData lightData;
+		getShaderData(light, lightData);
 
-		switch (light->getType())
-		{
-		case LightType::Directional:
-			positionAndType.w = 0;
-			break;
-		case LightType::Point:
-			positionAndType.w = 0.3f;
-			break;
-		case LightType::Spot:
-			positionAndType.w = 0.8f;
-			break;
-		}
-
-		mBuffer.gLightPositionAndType.set(positionAndType);
-			
-		Vector4 colorAndIntensity;
-		colorAndIntensity.x = light->getColor().r;
-		colorAndIntensity.y = light->getColor().g;
-		colorAndIntensity.z = light->getColor().b;
-		colorAndIntensity.w = light->getIntensity();
-
-		mBuffer.gLightColorAndIntensity.set(colorAndIntensity);
+		mBuffer.gLightPositionAndType.set(lightData.positionAndType);
+		mBuffer.gLightColorAndIntensity.set(lightData.colorAndIntensity);
+		mBuffer.gLightSpotAnglesAndSqrdInvRadius.set(lightData.spotAnglesAndSqrdInvRadius);
+		mBuffer.gLightDirection.set((Vector3)lightData.direction);
 
 		Radian spotAngle = Math::clamp(light->getSpotAngle() * 0.5f, Degree(1), Degree(90));
-		Radian spotFalloffAngle = Math::clamp(light->getSpotFalloffAngle() * 0.5f, Degree(1), (Degree)spotAngle);
-
-		Vector4 spotAnglesAndInvSqrdRadius;
-		spotAnglesAndInvSqrdRadius.x = spotAngle.valueRadians();
-		spotAnglesAndInvSqrdRadius.y = Math::cos(spotAnglesAndInvSqrdRadius.x);
-		spotAnglesAndInvSqrdRadius.z = 1.0f / (Math::cos(spotFalloffAngle) - spotAnglesAndInvSqrdRadius.y);
-		spotAnglesAndInvSqrdRadius.w = 1.0f / (light->getBounds().getRadius() * light->getBounds().getRadius());
-
-		mBuffer.gLightSpotAnglesAndSqrdInvRadius.set(spotAnglesAndInvSqrdRadius);
-
-		mBuffer.gLightDirection.set(-light->getRotation().zAxis());
 
 		Vector4 lightGeometry;
 		lightGeometry.x = light->getType() == LightType::Spot ? (float)LightCore::LIGHT_CONE_NUM_SIDES : 0;
@@ -67,6 +39,39 @@ namespace BansheeEngine
 		mBuffer.gMatConeTransform.set(transform);
 	}
 
+	void PerLightParams::getShaderData(const LightCore* light, LightShaderData& output)
+	{
+		output.positionAndType = (Vector4)light->getPosition();
+
+		switch (light->getType())
+		{
+		case LightType::Directional:
+			output.positionAndType.w = 0;
+			break;
+		case LightType::Point:
+			output.positionAndType.w = 0.3f;
+			break;
+		case LightType::Spot:
+			output.positionAndType.w = 0.8f;
+			break;
+		}
+
+		output.colorAndIntensity.x = light->getColor().r;
+		output.colorAndIntensity.y = light->getColor().g;
+		output.colorAndIntensity.z = light->getColor().b;
+		output.colorAndIntensity.w = light->getIntensity();
+
+		Radian spotAngle = Math::clamp(light->getSpotAngle() * 0.5f, Degree(1), Degree(90));
+		Radian spotFalloffAngle = Math::clamp(light->getSpotFalloffAngle() * 0.5f, Degree(1), (Degree)spotAngle);
+
+		output.spotAnglesAndSqrdInvRadius.x = spotAngle.valueRadians();
+		output.spotAnglesAndSqrdInvRadius.y = Math::cos(output.spotAnglesAndSqrdInvRadius.x);
+		output.spotAnglesAndSqrdInvRadius.z = 1.0f / (Math::cos(spotFalloffAngle) - output.spotAnglesAndSqrdInvRadius.y);
+		output.spotAnglesAndSqrdInvRadius.w = 1.0f / (light->getBounds().getRadius() * light->getBounds().getRadius());
+
+		output.direction = (Vector4)(-light->getRotation().zAxis());
+	}
+
 	const SPtr<GpuParamBlockBufferCore>& PerLightParams::getBuffer() const
 	{
 		return mBuffer.getBuffer();
@@ -30,6 +30,8 @@
 #include "BsRenderTargets.h"
 #include "BsRendererUtility.h"
 #include "BsRenderStateManager.h"
+#include "BsRenderStats.h"
+#include "BsBatchMath.h"
 
 using namespace std::placeholders;
 
@@ -37,6 +39,7 @@ namespace BansheeEngine
 {
 	RenderBeast::RenderBeast()
 		: mDefaultMaterial(nullptr), mPointLightInMat(nullptr), mPointLightOutMat(nullptr), mDirLightMat(nullptr)
+		, mTiledLightCullingMat(nullptr), mTiledLightingMat(nullptr), mTiledLightCulling(nullptr)
 		, mStaticHandler(nullptr), mOptions(bs_shared_ptr_new<RenderBeastOptions>()), mOptionsDirty(true)
 	{
 
@@ -74,6 +77,9 @@ namespace BansheeEngine
 		mPointLightInMat = bs_new<PointLightInMat>();
 		mPointLightOutMat = bs_new<PointLightOutMat>();
 		mDirLightMat = bs_new<DirectionalLightMat>();
+		mTiledLightCullingMat = bs_new<TiledLightCullingMat>();
+		mTiledLightingMat = bs_new<TiledDeferredLightingMat>();
+		mTiledLightCulling = bs_new<TiledLightCulling>();
 
 		RenderTexturePool::startUp();
 		PostProcessing::startUp();
@@ -95,6 +101,9 @@ namespace BansheeEngine
 		bs_delete(mPointLightInMat);
 		bs_delete(mPointLightOutMat);
 		bs_delete(mDirLightMat);
+		bs_delete(mTiledLightCullingMat);
+		bs_delete(mTiledLightingMat);
+		bs_delete(mTiledLightCulling);
 
 		RendererUtility::shutDown();
 
@@ -111,6 +120,13 @@ namespace BansheeEngine
 		mRenderableShaderData.push_back(RenderableShaderData());
 		mWorldBounds.push_back(renderable->getBounds());
 
+		// Mesh bounds can only change through a full update, which re-adds the renderable, so they can be cached here
+		// and used for quickly recalculating world bounds on transform-only updates
+		if (renderable->getMesh() != nullptr)
+			mLocalBounds.push_back(renderable->getMesh()->getProperties().getBounds());
+		else
+			mLocalBounds.push_back(Bounds(AABox(Vector3::ZERO, Vector3::ZERO), Sphere(Vector3::ZERO, 0.0f)));
+
 		RenderableData& renderableData = mRenderables.back();
 		renderableData.renderable = renderable;
 
@@ -226,6 +242,7 @@ namespace BansheeEngine
 			// Swap current last element with the one we want to erase
 			std::swap(mRenderables[renderableId], mRenderables[lastRenderableId]);
 			std::swap(mWorldBounds[renderableId], mWorldBounds[lastRenderableId]);
+			std::swap(mLocalBounds[renderableId], mLocalBounds[lastRenderableId]);
 			std::swap(mRenderableShaderData[renderableId], mRenderableShaderData[lastRenderableId]);
 
 			lastRenerable->setRendererId(renderableId);
@@ -237,6 +254,7 @@ namespace BansheeEngine
 		// Last element is the one we want to erase
 		mRenderables.erase(mRenderables.end() - 1);
 		mWorldBounds.erase(mWorldBounds.end() - 1);
+		mLocalBounds.erase(mLocalBounds.end() - 1);
 		mRenderableShaderData.erase(mRenderableShaderData.end() - 1);
 	}
 
@@ -254,6 +272,50 @@ namespace BansheeEngine
 		mWorldBounds[renderableId] = renderable->getBounds();
 	}
 
+	void RenderBeast::notifyRenderableTransformsUpdated(const Vector<RenderableTransform>& transforms)
+	{
+		// Only touches contiguous renderer-side arrays, without needing to access the renderable objects themselves
+		UINT32 numTransforms = (UINT32)transforms.size();
+		if (numTransforms == 0)
+			return;
+
+		// Gather the transforms and bounds so they can be processed in bulk. Full transforms are followed by transforms
+		// without scale, so both can be inverted at once.
+		mTransformScratch.resize(numTransforms * 2);
+		mInvTransformScratch.resize(numTransforms * 2);
+		mBoundsScratch.resize(numTransforms);
+
+		for (UINT32 i = 0; i < numTransforms; i++)
+		{
+			const RenderableTransform& entry = transforms[i];
+
+			mTransformScratch[i] = entry.transform;
+			mTransformScratch[numTransforms + i] = entry.transformNoScale;
+			mBoundsScratch[i] = mLocalBounds[entry.rendererId].getBox();
+		}
+
+		BatchMath::inverseAffine(mTransformScratch.data(), mInvTransformScratch.data(), numTransforms * 2);
+		BatchMath::transformAffine(mTransformScratch.data(), mBoundsScratch.data(), mBoundsScratch.data(), numTransforms);
+
+		for (UINT32 i = 0; i < numTransforms; i++)
+		{
+			const RenderableTransform& entry = transforms[i];
+			UINT32 renderableId = entry.rendererId;
+
+			RenderableShaderData& shaderData = mRenderableShaderData[renderableId];
+			shaderData.worldTransform = entry.transform;
+			shaderData.invWorldTransform = mInvTransformScratch[i];
+			shaderData.worldNoScaleTransform = entry.transformNoScale;
+			shaderData.invWorldNoScaleTransform = mInvTransformScratch[numTransforms + i];
+			shaderData.worldDeterminantSign = entry.transform.determinant3x3() >= 0.0f ? 1.0f : -1.0f;
+
+			Sphere worldSphere = mLocalBounds[renderableId].getSphere();
+			worldSphere.transform(entry.transform);
+
+			mWorldBounds[renderableId].setBounds(mBoundsScratch[i], worldSphere);
+		}
+	}
+
 	void RenderBeast::notifyLightAdded(LightCore* light)
 	{
 		if (light->getType() == LightType::Directional)
@@ -526,6 +588,9 @@ namespace BansheeEngine
 			RenderAPICore::instance().swapBuffers(target);
 		}
 
+		// Free any pooled render targets that haven't been used in a while
+		RenderTexturePool::instance().update();
+
 		gProfilerCPU().endSample("renderAllCore");
 	}
 
@@ -576,12 +641,34 @@ namespace BansheeEngine
 		}
 		
 		// Render base pass
+		gProfilerCPU().beginSample("RenderBasePass");
+
 		const Vector<RenderQueueElement>& opaqueElements = camData.opaqueQueue->getSortedElements();
-		for (auto iter = opaqueElements.begin(); iter != opaqueElements.end(); ++iter)
+		for (auto iter = opaqueElements.begin(); iter != opaqueElements.end();)
 		{
 			BeastRenderableElement* renderElem = static_cast<BeastRenderableElement*>(iter->renderElem);
 			SPtr<MaterialCore> material = renderElem->material;
 
+			// Find consecutive elements that can be rendered using a single instanced draw call. Those are elements using
+			// the same material, pass and sub-mesh, whose shader reads per-object data from the instance buffer.
+			auto batchEnd = iter + 1;
+			bool useInstancing = mCoreOptions->instancing && mStaticHandler->supportsInstancing(*renderElem, iter->passIdx);
+			if (useInstancing)
+			{
+				const SubMesh& subMesh = renderElem->subMesh;
+				while (batchEnd != opaqueElements.end() && 
+					(UINT32)(batchEnd - iter) < StaticRenderableHandler::MAX_INSTANCES_PER_DRAW)
+				{
+					const RenderableElement* otherElem = batchEnd->renderElem;
+					if (otherElem->material != material || otherElem->mesh != renderElem->mesh || 
+						batchEnd->passIdx != iter->passIdx || otherElem->subMesh.indexOffset != subMesh.indexOffset ||
+						otherElem->subMesh.indexCount != subMesh.indexCount || otherElem->subMesh.drawOp != subMesh.drawOp)
+						break;
+
+					++batchEnd;
+				}
+			}
+
 			UINT32 rendererId = renderElem->renderableId;
 			Matrix4 worldViewProjMatrix = cameraShaderData.viewProj * mRenderableShaderData[rendererId].worldTransform;
 
@@ -602,9 +689,41 @@ namespace BansheeEngine
 			else
 				setPassParams(passParams, nullptr);
 
-			gRendererUtility().draw(iter->renderElem->mesh, iter->renderElem->subMesh);
+			if (useInstancing)
+			{
+				UINT32 numInstances = (UINT32)(batchEnd - iter);
+				mInstanceData.resize(numInstances);
+
+				for (UINT32 i = 0; i < numInstances; i++)
+				{
+					const BeastRenderableElement* instanceElem = static_cast<BeastRenderableElement*>(iter[i].renderElem);
+					const RenderableShaderData& shaderData = mRenderableShaderData[instanceElem->renderableId];
+
+					InstanceShaderData& instanceData = mInstanceData[i];
+					instanceData.worldViewProj = cameraShaderData.viewProj * shaderData.worldTransform;
+					instanceData.world = shaderData.worldTransform;
+					instanceData.invWorld = shaderData.invWorldTransform;
+					instanceData.worldNoScale = shaderData.worldNoScaleTransform;
+					instanceData.invWorldNoScale = shaderData.invWorldNoScaleTransform;
+					instanceData.worldDeterminantSign = shaderData.worldDeterminantSign;
+				}
+
+				mStaticHandler->updateInstanceBuffer(mInstanceData.data(), numInstances);
+				mStaticHandler->bindInstanceBuffer(*renderElem, iter->passIdx);
+
+				gRendererUtility().draw(renderElem->mesh, renderElem->subMesh, numInstances);
+
+				BS_INC_RENDER_STAT(NumInstancedDrawCalls);
+				BS_ADD_RENDER_STAT(NumInstances, numInstances);
+			}
+			else
+				gRendererUtility().draw(renderElem->mesh, renderElem->subMesh);
+
+			iter = batchEnd;
 		}
 
+		gProfilerCPU().endSample("RenderBasePass");
+
 		camData.target->bindSceneColor(true);
 
 		// Render light pass
@@ -630,61 +749,102 @@ namespace BansheeEngine
 				gRendererUtility().drawScreenQuad();
 			}
 
-			// Draw point lights which our camera is within
-			SPtr<MaterialCore> pointInsideMaterial = mPointLightInMat->getMaterial();
-			SPtr<PassCore> pointInsidePass = pointInsideMaterial->getPass(0);
+			// Tiled lighting shaders read the GBuffer as non-multisampled textures
+			bool useTiledLighting = mCoreOptions->tiledLighting && mTiledLightingMat->isSupported() && 
+				camData.target->getNumSamples() <= 1;
+			if (useTiledLighting)
+			{
+				// Build per-tile light lists, then apply all point lights in a single full-screen pass
+				gProfilerCPU().beginSample("TiledLightCulling");
 
-			// TODO - Possibly use instanced drawing here as only two meshes are drawn with various properties
-			setPass(pointInsidePass);
-			mPointLightInMat->setStaticParameters(camData.target, perCameraBuffer);
+				mActivePointLights.clear();
+				for (auto& light : mPointLights)
+				{
+					if (light.internal->getIsActive())
+						mActivePointLights.push_back(light.internal);
+				}
 
-			// TODO - Cull lights based on visibility, right now I just iterate over all of them. 
-			for (auto& light : mPointLights)
-			{
-				if (!light.internal->getIsActive())
-					continue;
+				mTiledLightCulling->setLights(*camera, mActivePointLights, (UINT32)viewport->getWidth(), 
+					(UINT32)viewport->getHeight());
 
-				float distToLight = (light.internal->getBounds().getCenter() - camera->getPosition()).squaredLength();
-				float boundRadius = light.internal->getBounds().getRadius() * 1.05f + camera->getNearClipDistance() * 2.0f;
+				if (mTiledLightCullingMat->isSupported())
+					mTiledLightCulling->cullGPU(*mTiledLightCullingMat, camData.target, perCameraBuffer);
+				else
+					mTiledLightCulling->cullCPU(*camera);
 
-				bool cameraInLightGeometry = distToLight < boundRadius * boundRadius;
-				if (!cameraInLightGeometry)
-					continue;
+				gProfilerCPU().endSample("TiledLightCulling");
 
-				mPointLightInMat->setParameters(light.internal);
+				SPtr<MaterialCore> tiledMaterial = mTiledLightingMat->getMaterial();
+				SPtr<PassCore> tiledPass = tiledMaterial->getPass(0);
 
-				// TODO - Bind parameters to the pipeline manually as I don't need to re-bind gbuffer textures for every light
-				//  - I can't think of a good way to do this automatically. Probably best to do it in setParameters()
-				setPassParams(pointInsideMaterial->getPassParameters(0), nullptr);
-				SPtr<MeshCore> mesh = light.internal->getMesh();
-				gRendererUtility().draw(mesh, mesh->getProperties().getSubMesh(0));
+				setPass(tiledPass);
+				mTiledLightingMat->setStaticParameters(camData.target, perCameraBuffer, 
+					mTiledLightCulling->getParamBuffer());
+
+				setPassParams(tiledMaterial->getPassParameters(0), nullptr);
+				mTiledLightingMat->bindBuffers(mTiledLightCulling->getLightBuffer(), 
+					mTiledLightCulling->getTileRangeBuffer(), mTiledLightCulling->getLightIndexBuffer());
+
+				gRendererUtility().drawScreenQuad();
 			}
+			else
+			{
+				// Draw point lights which our camera is within
+				SPtr<MaterialCore> pointInsideMaterial = mPointLightInMat->getMaterial();
+				SPtr<PassCore> pointInsidePass = pointInsideMaterial->getPass(0);
 
-			// Draw other point lights
-			SPtr<MaterialCore> pointOutsideMaterial = mPointLightOutMat->getMaterial();
-			SPtr<PassCore> pointOutsidePass = pointOutsideMaterial->getPass(0);
+				// TODO - Possibly use instanced drawing here as only two meshes are drawn with various properties
+				setPass(pointInsidePass);
+				mPointLightInMat->setStaticParameters(camData.target, perCameraBuffer);
 
-			setPass(pointOutsidePass);
-			mPointLightOutMat->setStaticParameters(camData.target, perCameraBuffer);
+				// TODO - Cull lights based on visibility, right now I just iterate over all of them. 
+				for (auto& light : mPointLights)
+				{
+					if (!light.internal->getIsActive())
+						continue;
 
-			for (auto& light : mPointLights)
-			{
-				if (!light.internal->getIsActive())
-					continue;
+					float distToLight = (light.internal->getBounds().getCenter() - camera->getPosition()).squaredLength();
+					float boundRadius = light.internal->getBounds().getRadius() * 1.05f + camera->getNearClipDistance() * 2.0f;
 
-				float distToLight = (light.internal->getBounds().getCenter() - camera->getPosition()).squaredLength();
-				float boundRadius = light.internal->getBounds().getRadius() * 1.05f + camera->getNearClipDistance() * 2.0f;
+					bool cameraInLightGeometry = distToLight < boundRadius * boundRadius;
+					if (!cameraInLightGeometry)
+						continue;
 
-				bool cameraInLightGeometry = distToLight < boundRadius * boundRadius;
-				if (cameraInLightGeometry)
-					continue;
+					mPointLightInMat->setParameters(light.internal);
 
-				mPointLightOutMat->setParameters(light.internal);
+					// TODO - Bind parameters to the pipeline manually as I don't need to re-bind gbuffer textures for every light
+					//  - I can't think of a good way to do this automatically. Probably best to do it in setParameters()
+					setPassParams(pointInsideMaterial->getPassParameters(0), nullptr);
+					SPtr<MeshCore> mesh = light.internal->getMesh();
+					gRendererUtility().draw(mesh, mesh->getProperties().getSubMesh(0));
+				}
 
-				// TODO - Bind parameters to the pipeline manually as I don't need to re-bind gbuffer textures for every light
-				setPassParams(pointOutsideMaterial->getPassParameters(0), nullptr);
-				SPtr<MeshCore> mesh = light.internal->getMesh();
-				gRendererUtility().draw(mesh, mesh->getProperties().getSubMesh(0));
+				// Draw other point lights
+				SPtr<MaterialCore> pointOutsideMaterial = mPointLightOutMat->getMaterial();
+				SPtr<PassCore> pointOutsidePass = pointOutsideMaterial->getPass(0);
+
+				setPass(pointOutsidePass);
+				mPointLightOutMat->setStaticParameters(camData.target, perCameraBuffer);
+
+				for (auto& light : mPointLights)
+				{
+					if (!light.internal->getIsActive())
+						continue;
+
+					float distToLight = (light.internal->getBounds().getCenter() - camera->getPosition()).squaredLength();
+					float boundRadius = light.internal->getBounds().getRadius() * 1.05f + camera->getNearClipDistance() * 2.0f;
+
+					bool cameraInLightGeometry = distToLight < boundRadius * boundRadius;
+					if (cameraInLightGeometry)
+						continue;
+
+					mPointLightOutMat->setParameters(light.internal);
+
+					// TODO - Bind parameters to the pipeline manually as I don't need to re-bind gbuffer textures for every light
+					setPassParams(pointOutsideMaterial->getPassParameters(0), nullptr);
+					SPtr<MeshCore> mesh = light.internal->getMesh();
+					gRendererUtility().draw(mesh, mesh->getProperties().getSubMesh(0));
+				}
 			}
 		}
 
@@ -1011,49 +1171,14 @@ namespace BansheeEngine
 
 		RenderAPICore& rs = RenderAPICore::instance();
 
-		struct StageData
-		{
-			GpuProgramType type;
-			bool enable;
-			SPtr<GpuProgramCore> program;
-		};
-
-		const UINT32 numStages = 6;
-		StageData stages[numStages] =
-		{
-			{ GPT_VERTEX_PROGRAM, pass->hasVertexProgram(), pass->getVertexProgram() },
-			{ GPT_FRAGMENT_PROGRAM, pass->hasFragmentProgram(), pass->getFragmentProgram() },
-			{ GPT_GEOMETRY_PROGRAM, pass->hasGeometryProgram(), pass->getGeometryProgram() },
-			{ GPT_HULL_PROGRAM, pass->hasHullProgram(), pass->getHullProgram() },
-			{ GPT_DOMAIN_PROGRAM, pass->hasDomainProgram(), pass->getDomainProgram() },
-			{ GPT_COMPUTE_PROGRAM, pass->hasComputeProgram(), pass->getComputeProgram() }
-		};
-
-		for (UINT32 i = 0; i < numStages; i++)
-		{
-			const StageData& stage = stages[i];
-
-			if (stage.enable)
-				rs.bindGpuProgram(stage.program);
-			else
-				rs.unbindGpuProgram(stage.type);
-		}
-
-		// Set up non-texture related pass settings
-		if (pass->getBlendState() != nullptr)
-			rs.setBlendState(pass->getBlendState());
-		else
-			rs.setBlendState(BlendStateCore::getDefault());
-
-		if (pass->getDepthStencilState() != nullptr)
-			rs.setDepthStencilState(pass->getDepthStencilState(), pass->getStencilRefValue());
-		else
-			rs.setDepthStencilState(DepthStencilStateCore::getDefault(), pass->getStencilRefValue());
+		// Graphics programs and states are bound as a single object, allowing redundant binds between consecutive draws
+		// to be skipped entirely
+		rs.setPipelineState(pass->getPipelineState());
 
-		if (pass->getRasterizerState() != nullptr)
-			rs.setRasterizerState(pass->getRasterizerState());
+		if (pass->hasComputeProgram())
+			rs.bindGpuProgram(pass->getComputeProgram());
 		else
-			rs.setRasterizerState(RasterizerStateCore::getDefault());
+			rs.unbindGpuProgram(GPT_COMPUTE_PROGRAM);
 	}
 
 	void RenderBeast::setPassParams(const SPtr<PassParametersCore>& passParams, const PassSamplerOverrides* samplerOverrides)
@@ -8,7 +8,7 @@
 namespace BansheeEngine
 {
 	PooledRenderTexture::PooledRenderTexture(RenderTexturePool* pool)
-		:mPool(pool), mIsFree(false)
+		:mPool(pool), mIsFree(false), mDescHash(0), mLastUsedFrame(0), mMemorySize(0)
 	{ }
 
 	PooledRenderTexture::~PooledRenderTexture()
@@ -17,32 +17,52 @@ namespace BansheeEngine
 			mPool->_unregisterTexture(this);
 	}
 
+	RenderTexturePool::RenderTexturePool()
+		:mFrameIdx(0), mMaxUnusedFrames(30)
+	{ }
+
 	RenderTexturePool::~RenderTexturePool()
 	{
 		for (auto& texture : mTextures)
 			texture.second.lock()->mPool = nullptr;
+
+		mTextures.clear();
+		mFreeTextures.clear();
 	}
 
 	SPtr<PooledRenderTexture> RenderTexturePool::get(const POOLED_RENDER_TEXTURE_DESC& desc)
 	{
-		for (auto& texturePair : mTextures)
+		size_t hash = getHash(desc);
+
+		auto iterFind = mFreeTextures.find(hash);
+		if (iterFind != mFreeTextures.end())
 		{
-			SPtr<PooledRenderTexture> textureData = texturePair.second.lock();
+			Vector<SPtr<PooledRenderTexture>>& freeTextures = iterFind->second;
+			for (auto iter = freeTextures.rbegin(); iter != freeTextures.rend(); ++iter)
+			{
+				SPtr<PooledRenderTexture> textureData = *iter;
 
-			if (!textureData->mIsFree)
-				continue;
+				// Hash collisions are possible, so make sure the texture actually matches
+				if (textureData->texture == nullptr || !matches(textureData->texture, desc))
+					continue;
 
-			if (textureData->texture == nullptr)
-				continue;
+				freeTextures.erase(std::next(iter).base());
 
-			if (matches(textureData->texture, desc))
-			{
 				textureData->mIsFree = false;
+				textureData->mLastUsedFrame = mFrameIdx;
+
+				mStats.numFreeTextures--;
+				mFrameStats.numReuses++;
+
 				return textureData;
 			}
 		}
 
 		SPtr<PooledRenderTexture> newTextureData = bs_shared_ptr_new<PooledRenderTexture>(this);
+		newTextureData->mDescHash = hash;
+		newTextureData->mLastUsedFrame = mFrameIdx;
+		newTextureData->mMemorySize = getMemorySize(desc);
+
 		_registerTexture(newTextureData);
 
 		newTextureData->texture = TextureCoreManager::instance().createTexture(desc.type, desc.width, desc.height, 
@@ -76,8 +96,55 @@ namespace BansheeEngine
 
 	void RenderTexturePool::release(const SPtr<PooledRenderTexture>& texture)
 	{
-		auto iterFind = mTextures.find(texture.get());
-		iterFind->second.lock()->mIsFree = true;
+		if (texture == nullptr || texture->mIsFree)
+			return;
+
+		assert(mTextures.find(texture.get()) != mTextures.end());
+
+		texture->mIsFree = true;
+		texture->mLastUsedFrame = mFrameIdx;
+
+		mFreeTextures[texture->mDescHash].push_back(texture);
+		mStats.numFreeTextures++;
+	}
+
+	void RenderTexturePool::update()
+	{
+		// Keep a reference to the evicted textures until we're done iterating, as their destruction modifies the pool
+		Vector<SPtr<PooledRenderTexture>> evictedTextures;
+		for (auto iterBucket = mFreeTextures.begin(); iterBucket != mFreeTextures.end();)
+		{
+			Vector<SPtr<PooledRenderTexture>>& freeTextures = iterBucket->second;
+			for (auto iter = freeTextures.begin(); iter != freeTextures.end();)
+			{
+				if (((*iter)->mLastUsedFrame + mMaxUnusedFrames) <= mFrameIdx)
+				{
+					evictedTextures.push_back(*iter);
+					iter = freeTextures.erase(iter);
+				}
+				else
+					++iter;
+			}
+
+			if (freeTextures.empty())
+				iterBucket = mFreeTextures.erase(iterBucket);
+			else
+				++iterBucket;
+		}
+
+		mStats.numFreeTextures -= (UINT32)evictedTextures.size();
+		mFrameStats.numEvictions += (UINT32)evictedTextures.size();
+
+		// Textures might still be referenced externally (e.g. by the previous owner), in which case they will be
+		// destroyed once the last reference goes out of scope
+		evictedTextures.clear();
+
+		mStats.numAllocations = mFrameStats.numAllocations;
+		mStats.numReuses = mFrameStats.numReuses;
+		mStats.numEvictions = mFrameStats.numEvictions;
+		mFrameStats = RenderTexturePoolStats();
+
+		mFrameIdx++;
 	}
 
 	bool RenderTexturePool::matches(const SPtr<TextureCore>& texture, const POOLED_RENDER_TEXTURE_DESC& desc)
@@ -102,14 +169,55 @@ namespace BansheeEngine
 		return match;
 	}
 
+	size_t RenderTexturePool::getHash(const POOLED_RENDER_TEXTURE_DESC& desc)
+	{
+		size_t hash = 0;
+		hash_combine(hash, (UINT32)desc.type);
+		hash_combine(hash, (UINT32)desc.format);
+		hash_combine(hash, desc.width);
+		hash_combine(hash, desc.height);
+		hash_combine(hash, (UINT32)desc.flag);
+
+		if (desc.type == TEX_TYPE_2D)
+		{
+			hash_combine(hash, desc.hwGamma);
+			hash_combine(hash, desc.numSamples);
+		}
+		else if (desc.type == TEX_TYPE_3D)
+			hash_combine(hash, desc.depth);
+
+		return hash;
+	}
+
+	UINT32 RenderTexturePool::getMemorySize(const POOLED_RENDER_TEXTURE_DESC& desc)
+	{
+		UINT32 size = PixelUtil::getMemorySize(desc.width, desc.height, desc.depth, desc.format);
+
+		if (desc.type == TEX_TYPE_CUBE_MAP)
+			size *= 6;
+
+		if (desc.numSamples > 1)
+			size *= desc.numSamples;
+
+		return size;
+	}
+
 	void RenderTexturePool::_registerTexture(const SPtr<PooledRenderTexture>& texture)
 	{
 		mTextures.insert(std::make_pair(texture.get(), texture));
+
+		mStats.numTextures++;
+		mStats.allocatedMemory += texture->mMemorySize;
+		mStats.peakAllocatedMemory = std::max(mStats.peakAllocatedMemory, mStats.allocatedMemory);
+		mFrameStats.numAllocations++;
 	}
 
 	void RenderTexturePool::_unregisterTexture(PooledRenderTexture* texture)
 	{
 		mTextures.erase(texture);
+
+		mStats.numTextures--;
+		mStats.allocatedMemory -= texture->mMemorySize;
 	}
 
 	POOLED_RENDER_TEXTURE_DESC POOLED_RENDER_TEXTURE_DESC::create2D(PixelFormat format, UINT32 width, UINT32 height,
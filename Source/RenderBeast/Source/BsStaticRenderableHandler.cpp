@@ -5,6 +5,9 @@
 #include "BsGpuParams.h"
 #include "BsRenderBeast.h"
 #include "BsMaterial.h"
+#include "BsGpuBuffer.h"
+#include "BsHardwareBufferManager.h"
+#include "BsRenderAPI.h"
 
 namespace BansheeEngine
 {
@@ -23,6 +26,24 @@ namespace BansheeEngine
 			return;
 		}
 
+		// Note: Must be in the same order as parameters in PassParametersCore
+		static const GpuProgramType PROGRAM_TYPES[] = 
+		{ 
+			GPT_VERTEX_PROGRAM, GPT_FRAGMENT_PROGRAM, GPT_GEOMETRY_PROGRAM, GPT_HULL_PROGRAM, GPT_DOMAIN_PROGRAM, 
+			GPT_COMPUTE_PROGRAM
+		};
+
+		Vector<String> instanceBufferNames;
+		const Map<String, SHADER_OBJECT_PARAM_DESC>& bufferParamDescs = shader->getBufferParams();
+		for (auto& bufferParamDesc : bufferParamDescs)
+		{
+			if (bufferParamDesc.second.rendererSemantic != RPS_InstanceData)
+				continue;
+
+			for (auto& gpuVariableName : bufferParamDesc.second.gpuVariableNames)
+				instanceBufferNames.push_back(gpuVariableName);
+		}
+
 		const Map<String, SHADER_PARAM_BLOCK_DESC>& paramBlockDescs = shader->getParamBlocks();
 		String perFrameBlockName;
 		String perCameraBlockName;
@@ -86,11 +107,25 @@ namespace BansheeEngine
 					{
 						if (findIter->second.blockSize == mPerObjectParams.getDesc().blockSize)
 						{
+							if (rendererData->perObjectParams == nullptr)
+								rendererData->perObjectParams = bs_shared_ptr_new<PerObjectParamBuffer>();
+
 							UINT32 slotIdx = findIter->second.slot;
-							rendererData->perObjectBuffers.push_back(RenderableElement::BufferBindInfo(i, j, slotIdx, mPerObjectParams.getBuffer()));
+							rendererData->perObjectBuffers.push_back(RenderableElement::BufferBindInfo(i, j, slotIdx, 
+								rendererData->perObjectParams->getBuffer()));
 						}
 					}
 				}
+
+				for (auto& instanceBufferName : instanceBufferNames)
+				{
+					auto findIter = paramsDesc.buffers.find(instanceBufferName);
+					if (findIter != paramsDesc.buffers.end())
+					{
+						UINT32 slotIdx = findIter->second.slot;
+						rendererData->instanceBuffers.push_back(InstanceBufferBindInfo(i, PROGRAM_TYPES[j], slotIdx));
+					}
+				}
 			}
 		}
 	}
@@ -106,6 +141,46 @@ namespace BansheeEngine
 		}
 	}
 
+	bool StaticRenderableHandler::supportsInstancing(const RenderableElement& element, UINT32 passIdx) const
+	{
+		const PerObjectData* rendererData = any_cast_unsafe<PerObjectData>(&element.rendererData);
+		for (auto& instanceBuffer : rendererData->instanceBuffers)
+		{
+			if (instanceBuffer.passIdx == passIdx)
+				return true;
+		}
+
+		return false;
+	}
+
+	void StaticRenderableHandler::updateInstanceBuffer(const InstanceShaderData* data, UINT32 numInstances)
+	{
+		assert(numInstances <= MAX_INSTANCES_PER_DRAW);
+
+		// Created on first use, as not all render APIs support generic buffers
+		if (mInstanceBuffer == nullptr)
+		{
+			mInstanceBuffer = HardwareBufferCoreManager::instance().createGpuBuffer(MAX_INSTANCES_PER_DRAW, 
+				sizeof(InstanceShaderData), GBT_STRUCTURED, GBU_DYNAMIC);
+		}
+
+		mInstanceBuffer->writeData(0, numInstances * sizeof(InstanceShaderData), data, BufferWriteType::Discard);
+	}
+
+	void StaticRenderableHandler::bindInstanceBuffer(const RenderableElement& element, UINT32 passIdx)
+	{
+		RenderAPICore& rapi = RenderAPICore::instance();
+
+		const PerObjectData* rendererData = any_cast_unsafe<PerObjectData>(&element.rendererData);
+		for (auto& instanceBuffer : rendererData->instanceBuffers)
+		{
+			if (instanceBuffer.passIdx != passIdx)
+				continue;
+
+			rapi.setBuffer(instanceBuffer.programType, instanceBuffer.slotIdx, mInstanceBuffer);
+		}
+	}
+
 	void StaticRenderableHandler::updatePerFrameBuffers(float time)
 	{
 		mPerFrameParams.gTime.set(time);
@@ -127,12 +202,18 @@ namespace BansheeEngine
 
 	void StaticRenderableHandler::updatePerObjectBuffers(RenderableElement& element, const RenderableShaderData& data, const Matrix4& wvpMatrix)
 	{
+		PerObjectData* rendererData = any_cast_unsafe<PerObjectData>(&element.rendererData);
+		if (rendererData->perObjectParams == nullptr)
+			return;
+
+		// Note: Values that didn't change since the last update won't be re-uploaded to the GPU
 		// TODO - If I kept all the values in the same structure maybe a simple memcpy directly into the constant buffer would be better (i.e. faster)?
-		mPerObjectParams.gMatWorld.set(data.worldTransform);
-		mPerObjectParams.gMatInvWorld.set(data.invWorldTransform);
-		mPerObjectParams.gMatWorldNoScale.set(data.worldNoScaleTransform);
-		mPerObjectParams.gMatInvWorldNoScale.set(data.invWorldNoScaleTransform);
-		mPerObjectParams.gWorldDeterminantSign.set(data.worldDeterminantSign);
-		mPerObjectParams.gMatWorldViewProj.set(wvpMatrix);
+		PerObjectParamBuffer& perObjectParams = *rendererData->perObjectParams;
+		perObjectParams.gMatWorld.set(data.worldTransform);
+		perObjectParams.gMatInvWorld.set(data.invWorldTransform);
+		perObjectParams.gMatWorldNoScale.set(data.worldNoScaleTransform);
+		perObjectParams.gMatInvWorldNoScale.set(data.invWorldNoScaleTransform);
+		perObjectParams.gWorldDeterminantSign.set(data.worldDeterminantSign);
+		perObjectParams.gMatWorldViewProj.set(wvpMatrix);
 	}
 }
\ No newline at end of file
@@ -105,6 +105,7 @@ namespace BansheeEngine
 
 		OnInitializedThunkDef mOnInitializedThunk;
 		OnUpdateThunkDef mOnUpdateThunk;
+		OnUpdateThunkDef mOnFixedUpdateThunk;
 		OnResetThunkDef mOnResetThunk;
 		OnDestroyedThunkDef mOnDestroyThunk;
 		OnDestroyedThunkDef mOnDisabledThunk;
@@ -144,6 +145,9 @@ namespace BansheeEngine
 		/** @copydoc Component::update */
 		void update() override;
 
+		/** @copydoc Component::fixedUpdate */
+		void fixedUpdate() override;
+
 		/** @copydoc Component::typeEquals */
 		bool typeEquals(const Component& other) override;
 
@@ -28,6 +28,9 @@ namespace BansheeEngine
 		static float internal_getFrameDelta();
 		static UINT64 internal_getFrameNumber();
 		static UINT64 internal_getPrecise();
+		static float internal_getFixedFrameDelta();
+		static void internal_setFixedFrameDelta(float value);
+		static float internal_getFixedInterpolation();
 	};
 
 	/** @} */
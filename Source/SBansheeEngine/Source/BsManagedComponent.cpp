@@ -17,15 +17,15 @@ namespace BansheeEngine
 {
 	ManagedComponent::ManagedComponent()
 		: mManagedInstance(nullptr), mRuntimeType(nullptr), mManagedHandle(0), mRunInEditor(false), mRequiresReset(true)
-		, mMissingType(false), mOnInitializedThunk(nullptr), mOnUpdateThunk(nullptr), mOnResetThunk(nullptr)
-		, mOnDestroyThunk(nullptr), mOnDisabledThunk(nullptr), mOnEnabledThunk(nullptr), mOnTransformChangedThunk(nullptr)
-		, mCalculateBoundsMethod(nullptr)
+		, mMissingType(false), mOnInitializedThunk(nullptr), mOnUpdateThunk(nullptr), mOnFixedUpdateThunk(nullptr)
+		, mOnResetThunk(nullptr), mOnDestroyThunk(nullptr), mOnDisabledThunk(nullptr), mOnEnabledThunk(nullptr)
+		, mOnTransformChangedThunk(nullptr), mCalculateBoundsMethod(nullptr)
 	{ }
 
 	ManagedComponent::ManagedComponent(const HSceneObject& parent, MonoReflectionType* runtimeType)
 		: Component(parent), mManagedInstance(nullptr), mRuntimeType(runtimeType), mManagedHandle(0), mRunInEditor(false)
 		, mRequiresReset(true), mMissingType(false), mOnInitializedThunk(nullptr), mOnUpdateThunk(nullptr)
-		, mOnResetThunk(nullptr), mOnDestroyThunk(nullptr), mOnDisabledThunk(nullptr), mOnEnabledThunk(nullptr)
+		, mOnFixedUpdateThunk(nullptr), mOnResetThunk(nullptr), mOnDestroyThunk(nullptr), mOnDisabledThunk(nullptr), mOnEnabledThunk(nullptr)
 		, mOnTransformChangedThunk(nullptr), mCalculateBoundsMethod(nullptr)
 	{
 		MonoUtil::getClassName(mRuntimeType, mNamespace, mTypeName);
@@ -87,6 +87,7 @@ namespace BansheeEngine
 			mRuntimeType = nullptr;
 			mOnInitializedThunk = nullptr;
 			mOnUpdateThunk = nullptr;
+			mOnFixedUpdateThunk = nullptr;
 			mOnDestroyThunk = nullptr;
 			mOnEnabledThunk = nullptr;
 			mOnDisabledThunk = nullptr;
@@ -145,6 +146,7 @@ namespace BansheeEngine
 
 		mOnInitializedThunk = nullptr;
 		mOnUpdateThunk = nullptr;
+		mOnFixedUpdateThunk = nullptr;
 		mOnResetThunk = nullptr;
 		mOnDestroyThunk = nullptr;
 		mOnDisabledThunk = nullptr;
@@ -168,6 +170,13 @@ namespace BansheeEngine
 					mOnUpdateThunk = (OnUpdateThunkDef)onUpdateMethod->getThunk();
 			}
 
+			if (mOnFixedUpdateThunk == nullptr)
+			{
+				MonoMethod* onFixedUpdateMethod = managedClass->getMethod("OnFixedUpdate", 0);
+				if (onFixedUpdateMethod != nullptr)
+					mOnFixedUpdateThunk = (OnUpdateThunkDef)onFixedUpdateMethod->getThunk();
+			}
+
 			if (mOnResetThunk == nullptr)
 			{
 				MonoMethod* onResetMethod = managedClass->getMethod("OnReset", 0);
@@ -281,6 +290,17 @@ namespace BansheeEngine
 		}
 	}
 
+	void ManagedComponent::fixedUpdate()
+	{
+		if (PlayInEditorManager::instance().getState() != PlayInEditorState::Playing && !mRunInEditor)
+			return;
+
+		assert(mManagedInstance != nullptr);
+
+		if (mOnFixedUpdateThunk != nullptr)
+			MonoUtil::invokeThunk(mOnFixedUpdateThunk, mManagedInstance);
+	}
+
 	void ManagedComponent::triggerOnInitialize()
 	{
 		if (PlayInEditorManager::instance().getState() == PlayInEditorState::Stopped && !mRunInEditor)
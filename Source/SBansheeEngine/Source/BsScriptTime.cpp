@@ -21,6 +21,10 @@ namespace BansheeEngine
 		metaData.scriptClass->addInternalCall("Internal_GetFrameDelta", &ScriptTime::internal_getFrameDelta);
 		metaData.scriptClass->addInternalCall("Internal_GetFrameNumber", &ScriptTime::internal_getFrameNumber);
 		metaData.scriptClass->addInternalCall("Internal_GetPrecise", &ScriptTime::internal_getPrecise);
+		metaData.scriptClass->addInternalCall("Internal_GetFixedFrameDelta", &ScriptTime::internal_getFixedFrameDelta);
+		metaData.scriptClass->addInternalCall("Internal_SetFixedFrameDelta", &ScriptTime::internal_setFixedFrameDelta);
+		metaData.scriptClass->addInternalCall("Internal_GetFixedInterpolation", 
+			&ScriptTime::internal_getFixedInterpolation);
 	}
 
 	float ScriptTime::internal_getRealElapsed()
@@ -47,4 +51,19 @@ namespace BansheeEngine
 	{
 		return gTime().getTimePrecise();
 	}
+
+	float ScriptTime::internal_getFixedFrameDelta()
+	{
+		return gTime().getFixedFrameDelta();
+	}
+
+	void ScriptTime::internal_setFixedFrameDelta(float value)
+	{
+		gTime().setFixedFrameDelta(value);
+	}
+
+	float ScriptTime::internal_getFixedInterpolation()
+	{
+		return gTime().getFixedInterpolation();
+	}
 }
\ No newline at end of file